@@ -20,10 +20,36 @@
 */
 
 #include "mock_icd.h"
+#include "vkmock.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <thread>
 #include <vector>
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#endif
 #include "vk_typemap_helper.h"
 namespace vkmock {
 
@@ -32,21 +58,1999 @@ using std::unordered_map;
 
 static constexpr uint32_t icd_physical_device_count = 1;
 static constexpr uint32_t kSupportedVulkanAPIVersion = VK_API_VERSION_1_1;
-static unordered_map<VkInstance, std::array<VkPhysicalDevice, icd_physical_device_count>> physical_device_map;
 
-// Map device memory handle to any mapped allocations that we'll need to free on unmap
-static unordered_map<VkDeviceMemory, std::vector<void*>> mapped_memory_map;
+// Overrides of entry points installed with vkmock_SetHook. Every entry point but the loader and instance plumbing starts
+// by loading its slot, so one that is not hooked pays a relaxed load and a predictable branch. While a hook runs, entry
+// points called on its thread skip their hooks, which lets a hook delegate to the mock implementation of its entry point.
+static std::atomic<PFN_vkVoidFunction> hook_table[kHookSlotCount];
+static thread_local bool in_hook = false;
+
+class HookScope {
+  public:
+    HookScope() : was_in_hook_(in_hook) { in_hook = true; }
+    ~HookScope() { in_hook = was_in_hook_; }
+
+  private:
+    const bool was_in_hook_;
+};
+
+template <typename PFN>
+static PFN GetHook(uint32_t slot) {
+    const PFN_vkVoidFunction hook = hook_table[slot].load(std::memory_order_relaxed);
+    return hook && !in_hook ? reinterpret_cast<PFN>(hook) : nullptr;
+}
+
+// Calls an entry point on behalf of the mock itself, such as an intercept delegating to another one. Hooks only see the
+// calls of the application, so neither the entry point nor the ones it calls in turn go to a hook.
+template <typename T>
+struct NonDeduced {
+    using type = T;
+};
+template <typename Result, typename... Params>
+static Result CallInternal(Result(VKAPI_PTR* entry_point)(Params...), typename NonDeduced<Params>::type... args) {
+    const HookScope scope;
+    return entry_point(args...);
+}
+
+static bool SetHook(const char* pName, PFN_vkVoidFunction pfnHook) {
+    const auto it = name_to_hook_slot_map.find(pName);
+    if (it == name_to_hook_slot_map.end()) return false;
+    hook_table[it->second].store(pfnHook, std::memory_order_relaxed);
+    return true;
+}
+
+// Size of a device memory allocation, the heap it was allocated from and its contents. The contents live
+// in a host allocation made the first time the memory is mapped or its device address is taken; it never moves, so the
+// host address of the contents is also the device address of the memory. The host allocation comes from the memory's
+// allocation callbacks with object scope, if it has any. Memory exported or imported as a file descriptor keeps its
+// contents in that file instead.
+struct DeviceMemoryState {
+    VkDeviceSize size;
+    uint32_t heap_index;
+    void* allocation;
+    uint8_t* data;
+    int fd;
+    bool has_allocator;
+    VkAllocationCallbacks allocator;
+};
+
+// Device address range taken by the contents of a device memory allocation, keyed by its start address
+struct DeviceAddressRange {
+    VkDeviceAddress end;
+    VkDeviceMemory memory;
+};
+
+// Memory bound to a buffer
+struct BufferBinding {
+    VkDeviceMemory memory;
+    VkDeviceSize offset;
+};
+
+// VK_EXT_memory_budget simulation. Bytes allocated are tracked per heap and an allocation that would exceed the heap's
+// budget fails with VK_ERROR_OUT_OF_DEVICE_MEMORY. The budget starts at VKMOCK_HEAP_BUDGET bytes (default: the heap
+// size) and shrinks by VKMOCK_HEAP_BUDGET_SHRINK_RATE bytes per second down to VKMOCK_HEAP_BUDGET_MIN, imitating other
+// processes claiming device memory over time.
+static constexpr uint32_t icd_memory_heap_count = 2;
+static constexpr VkDeviceSize icd_memory_heap_size = 8000000000;
+
+// Memory types follow a desktop GPU with dedicated memory (heap 1) next to system memory (heap 0): device memory
+// (type 0), write-combined host memory (type 1), cached host memory for readback (type 2) and host visible device memory
+// (type 3). As the specification requires, a type whose properties are a subset of another's comes first, so
+// applications that pick the first type with the properties they need get the plainest one. Optimally tiled images and
+// sparse resources can only live in device memory, linear images not in the readback type.
+static constexpr uint32_t icd_buffer_memory_types = 0xF;
+static constexpr uint32_t icd_linear_image_memory_types = 0xB;
+static constexpr uint32_t icd_device_local_memory_types = 0x9;
+// Buffers and linear images must not share a page of this size with optimally tiled images in the same memory
+static constexpr VkDeviceSize icd_buffer_image_granularity = 1024;
+// Sparse resources are bound in pages of this size, which is also their memory alignment
+static constexpr VkDeviceSize icd_sparse_page_size = 0x10000;
+static std::array<std::atomic<VkDeviceSize>, icd_memory_heap_count> heap_usage;
+static const auto heap_budget_start_time = std::chrono::steady_clock::now();
+
+static VkDeviceSize GetEnvSize(const char* name, VkDeviceSize default_value) {
+    const char* value = getenv(name);
+    return (value && *value) ? strtoull(value, nullptr, 0) : default_value;
+}
+
+static VkDeviceSize GetHeapBudget() {
+    static const VkDeviceSize initial_budget = (std::min)(GetEnvSize("VKMOCK_HEAP_BUDGET", icd_memory_heap_size), icd_memory_heap_size);
+    static const VkDeviceSize min_budget = (std::min)(GetEnvSize("VKMOCK_HEAP_BUDGET_MIN", 0), initial_budget);
+    static const VkDeviceSize shrink_rate = GetEnvSize("VKMOCK_HEAP_BUDGET_SHRINK_RATE", 0);
+    if (shrink_rate == 0) return initial_budget;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - heap_budget_start_time).count();
+    const double shrunk = seconds * static_cast<double>(shrink_rate);
+    if (shrunk >= static_cast<double>(initial_budget - min_budget)) return min_budget;
+    return initial_budget - static_cast<VkDeviceSize>(shrunk);
+}
+
+static uint32_t GetMemoryTypeHeapIndex(uint32_t memory_type_index) {
+    static const VkPhysicalDeviceMemoryProperties memory_properties = [] {
+        VkPhysicalDeviceMemoryProperties props = {};
+        CallInternal(GetPhysicalDeviceMemoryProperties, VK_NULL_HANDLE, &props);
+        return props;
+    }();
+    if (memory_type_index >= memory_properties.memoryTypeCount) return UINT32_MAX;
+    return memory_properties.memoryTypes[memory_type_index].heapIndex;
+}
+
+// VK_KHR_external_memory_fd and VK_KHR_external_semaphore_fd are backed by Linux file descriptors. Shareable device
+// memory lives in a memfd that importers map with MAP_SHARED, so every process sees the same pages. Shareable semaphore
+// payloads are eventfds in semaphore mode: a signal operation adds one and a wait operation blocks until it can take one.
+// Sync fds exported from a semaphore are already signaled, since submitted work completes immediately. Waits poll the
+// payload together with a wake fd, so a queue worker blocked on a payload nobody signals can still be stopped.
+#if defined(__linux__)
+static uint64_t ReadClockNs(clockid_t clock) {
+    timespec time;
+    clock_gettime(clock, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000ULL + static_cast<uint64_t>(time.tv_nsec);
+}
+
+// Time on CLOCK_MONOTONIC, the clock of device timestamps and presentation times
+static uint64_t GetMonotonicTimeNs() { return ReadClockNs(CLOCK_MONOTONIC); }
+static uint64_t GetMonotonicRawTimeNs() { return ReadClockNs(CLOCK_MONOTONIC_RAW); }
+
+static int CreateSharedMemoryFd(const char* name, VkDeviceSize size) {
+    static constexpr unsigned int memfd_cloexec = 0x0001U;  // MFD_CLOEXEC, not declared by older C libraries
+    const int fd = static_cast<int>(syscall(SYS_memfd_create, name, memfd_cloexec));
+    if (fd < 0) return -1;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static VkDeviceSize GetSharedMemoryFdSize(int fd) {
+    struct stat fd_stat;
+    return fstat(fd, &fd_stat) == 0 ? static_cast<VkDeviceSize>(fd_stat.st_size) : 0;
+}
+
+static uint8_t* MapSharedMemory(int fd, VkDeviceSize size) {
+    void* mapping = mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return mapping == MAP_FAILED ? nullptr : static_cast<uint8_t*>(mapping);
+}
+
+static void UnmapSharedMemory(uint8_t* data, VkDeviceSize size) { munmap(data, static_cast<size_t>(size)); }
+
+static int CreateSemaphoreFd(unsigned int initial_value) {
+    return eventfd(initial_value, EFD_CLOEXEC | EFD_NONBLOCK | EFD_SEMAPHORE);
+}
+
+static void SignalSemaphoreFd(int fd) {
+    const uint64_t one = 1;
+    while (write(fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
+
+// Waits until the payload is signaled and takes it, or until wake_fd becomes readable. Returns whether it took the
+// payload. The read does not block, so a payload another process took between the poll and the read restarts the wait.
+static bool WaitSemaphoreFd(int fd, bool sync_fd, int wake_fd) {
+    // Imported payloads may come from an exporter that made a blocking eventfd
+    if (!sync_fd) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    while (true) {
+        pollfd poll_fds[2] = {{fd, POLLIN, 0}, {wake_fd, POLLIN, 0}};
+        if (poll(poll_fds, wake_fd >= 0 ? 2 : 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (poll_fds[1].revents & POLLIN) return false;
+        // Sync files are signaled once and stay signaled, so only wait for them to become readable
+        if (sync_fd) return true;
+        uint64_t value;
+        if (read(fd, &value, sizeof(value)) == sizeof(value)) return true;
+        if (errno != EAGAIN && errno != EINTR) return false;
+    }
+}
+
+static int DuplicateFd(int fd) { return fcntl(fd, F_DUPFD_CLOEXEC, 0); }
+
+static void CloseFd(int fd) { close(fd); }
+#else
+#if defined(_WIN32)
+static uint64_t GetPerformanceCounter() {
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return static_cast<uint64_t>(counter.QuadPart);
+}
+
+// Time on the performance counter, the clock of device timestamps and presentation times
+static uint64_t GetMonotonicTimeNs() {
+    static const uint64_t frequency = [] {
+        LARGE_INTEGER counter_frequency;
+        QueryPerformanceFrequency(&counter_frequency);
+        return static_cast<uint64_t>(counter_frequency.QuadPart);
+    }();
+    const uint64_t counter = GetPerformanceCounter();
+    return counter / frequency * 1000000000ULL + counter % frequency * 1000000000ULL / frequency;
+}
+#else
+static uint64_t GetMonotonicTimeNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+#endif
+static int CreateSharedMemoryFd(const char* name, VkDeviceSize size) { return -1; }
+static VkDeviceSize GetSharedMemoryFdSize(int fd) { return 0; }
+static uint8_t* MapSharedMemory(int fd, VkDeviceSize size) { return nullptr; }
+static void UnmapSharedMemory(uint8_t* data, VkDeviceSize size) {}
+static int CreateSemaphoreFd(unsigned int initial_value) { return -1; }
+static void SignalSemaphoreFd(int fd) {}
+static bool WaitSemaphoreFd(int fd, bool sync_fd, int wake_fd) { return false; }
+static int DuplicateFd(int fd) { return -1; }
+static void CloseFd(int fd) {}
+#endif
+
+// Live statistics, laid out as the public VkmockStats. They are always collected; when VKMOCK_STATS is set they are
+// placed in a memfd named vkmock_stats that monitors map read-only through /proc/<pid>/fd. Counters are updated with
+// relaxed atomics, so each one is read atomically but they are not consistent with each other.
+struct Stats {
+    std::atomic<uint64_t> magic;
+    std::atomic<uint64_t> version;
+    std::atomic<uint64_t> size;
+    std::atomic<uint64_t> process_id;
+    std::atomic<uint64_t> start_time_ns;
+    std::atomic<uint64_t> objects_alive[VKMOCK_STATS_OBJECT_TYPE_COUNT];
+    std::atomic<uint64_t> heap_bytes_allocated[VK_MAX_MEMORY_HEAPS];
+    std::atomic<uint64_t> submit_count;
+    std::atomic<uint64_t> present_count;
+    std::atomic<uint64_t> lock_contention_count;
+    std::atomic<uint64_t> queue_busy_ns[VKMOCK_STATS_QUEUE_COUNT];
+    std::atomic<uint64_t> shader_module_cache_hits;
+    std::atomic<uint64_t> shader_module_cache_misses;
+    std::atomic<uint64_t> shader_module_bytes_saved;
+};
+static_assert(sizeof(Stats) == sizeof(VkmockStats), "Stats must match the VkmockStats layout");
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Stats counters must be lock-free to be shared with other processes");
+
+static Stats& CreateStats() {
+    static Stats local_stats;
+    Stats* stats = &local_stats;
+    if (GetEnvSize("VKMOCK_STATS", 0) != 0) {
+        // The descriptor stays open for the lifetime of the process so monitors can find the segment
+        const int fd = CreateSharedMemoryFd("vkmock_stats", sizeof(Stats));
+        uint8_t* data = fd >= 0 ? MapSharedMemory(fd, sizeof(Stats)) : nullptr;
+        if (data) {
+            stats = new (data) Stats();
+        } else if (fd >= 0) {
+            CloseFd(fd);
+        }
+    }
+    stats->version.store(VKMOCK_STATS_VERSION, std::memory_order_relaxed);
+    stats->size.store(sizeof(Stats), std::memory_order_relaxed);
+#if defined(__linux__)
+    stats->process_id.store(static_cast<uint64_t>(getpid()), std::memory_order_relaxed);
+#endif
+    stats->start_time_ns.store(GetMonotonicTimeNs(), std::memory_order_relaxed);
+    // Written last, so a monitor that sees the magic sees an initialized segment
+    stats->magic.store(VKMOCK_STATS_MAGIC, std::memory_order_release);
+    return *stats;
+}
+static Stats& icd_stats = CreateStats();
+
+static void TrackObjects(VkObjectType type, int64_t count) {
+    const size_t index = static_cast<size_t>(type) < VKMOCK_STATS_OBJECT_TYPE_COUNT ? static_cast<size_t>(type) : 0;
+    icd_stats.objects_alive[index].fetch_add(static_cast<uint64_t>(count), std::memory_order_relaxed);
+}
+
+static void CountLockContention() { icd_stats.lock_contention_count.fetch_add(1, std::memory_order_relaxed); }
+
+// Objects alive, kept for the leak report when VKMOCK_LEAK_REPORT names a file. Each one remembers its type, when it was
+// created, its size if it is device memory, and the return addresses of the call that created it. Objects freed with
+// their pool remember the pool as their parent.
+static constexpr int icd_leak_report_frame_count = 16;
+struct LiveObject {
+    const char* type_name;
+    uint64_t parent;
+    VkDeviceSize size;
+    uint64_t create_time_ns;
+    int frame_count;
+    void* frames[icd_leak_report_frame_count];
+};
+static mutex_t live_object_lock;
+static unordered_map<uint64_t, LiveObject> live_object_map;
+
+static const char* GetLeakReportPath() {
+    static const char* const path = getenv("VKMOCK_LEAK_REPORT");
+    return (path && *path) ? path : nullptr;
+}
+
+static void AddLiveObject(const char* type_name, uint64_t handle, VkDeviceSize size = 0, uint64_t parent = 0) {
+    if (!GetLeakReportPath() || handle == 0) return;
+    LiveObject object = {type_name, parent, size, GetMonotonicTimeNs(), 0, {}};
+#if defined(__GLIBC__)
+    // Walking the stack is cheap; symbolizing it is not, and waits for the report
+    object.frame_count = backtrace(object.frames, icd_leak_report_frame_count);
+#endif
+    lock_guard_t lock(live_object_lock);
+    live_object_map[handle] = object;
+}
+
+static void RemoveLiveObject(uint64_t handle) {
+    if (!GetLeakReportPath() || handle == 0) return;
+    lock_guard_t lock(live_object_lock);
+    live_object_map.erase(handle);
+}
+
+static void RemoveLiveObjectsOf(uint64_t parent) {
+    if (!GetLeakReportPath() || parent == 0) return;
+    lock_guard_t lock(live_object_lock);
+    for (auto it = live_object_map.begin(); it != live_object_map.end();) {
+        it = it->second.parent == parent ? live_object_map.erase(it) : std::next(it);
+    }
+}
+
+// Writes the objects still alive to VKMOCK_LEAK_REPORT, or to stderr if the file cannot be opened. Objects are grouped by
+// the call stack that created them, and the call sites retaining the most device memory, then the most objects, come
+// first. backtrace_symbols names the functions that the executable (linked with -rdynamic) and shared libraries export,
+// and gives module offsets for the others.
+static void WriteLeakReport() {
+    const char* path = GetLeakReportPath();
+    if (!path) return;
+    struct CallSite {
+        uint64_t count;
+        VkDeviceSize bytes;
+        uint64_t oldest_create_time_ns;
+        std::map<std::string, uint64_t> type_counts;
+    };
+    std::map<std::vector<void*>, CallSite> site_map;
+    uint64_t object_count = 0;
+    VkDeviceSize total_bytes = 0;
+    {
+        lock_guard_t lock(live_object_lock);
+        for (const auto& handle_object : live_object_map) {
+            const auto& object = handle_object.second;
+            auto& site = site_map[std::vector<void*>(object.frames, object.frames + object.frame_count)];
+            if (site.count == 0 || object.create_time_ns < site.oldest_create_time_ns) {
+                site.oldest_create_time_ns = object.create_time_ns;
+            }
+            ++site.count;
+            site.bytes += object.size;
+            ++site.type_counts[object.type_name];
+            ++object_count;
+            total_bytes += object.size;
+        }
+    }
+    std::vector<const std::pair<const std::vector<void*>, CallSite>*> sites;
+    for (const auto& frames_site : site_map) sites.push_back(&frames_site);
+    std::stable_sort(sites.begin(), sites.end(), [](const std::pair<const std::vector<void*>, CallSite>* a,
+                                                    const std::pair<const std::vector<void*>, CallSite>* b) {
+        return a->second.bytes != b->second.bytes ? a->second.bytes > b->second.bytes : a->second.count > b->second.count;
+    });
+
+    FILE* file = fopen(path, "w");
+    FILE* out = file ? file : stderr;
+    const uint64_t start_time_ns = icd_stats.start_time_ns.load(std::memory_order_relaxed);
+    fprintf(out, "vkmock leak report: %llu objects alive, retaining %llu bytes of device memory, from %zu call sites\n",
+            static_cast<unsigned long long>(object_count), static_cast<unsigned long long>(total_bytes), sites.size());
+    for (const auto* frames_site : sites) {
+        const auto& frames = frames_site->first;
+        const auto& site = frames_site->second;
+        fprintf(out, "\n%llu bytes in %llu objects:", static_cast<unsigned long long>(site.bytes),
+                static_cast<unsigned long long>(site.count));
+        const char* separator = " ";
+        for (const auto& type_count : site.type_counts) {
+            fprintf(out, "%s%llu %s", separator, static_cast<unsigned long long>(type_count.second), type_count.first.c_str());
+            separator = ", ";
+        }
+        fprintf(out, "; oldest created %.3f s after the ICD was loaded\n",
+                static_cast<double>(site.oldest_create_time_ns - start_time_ns) / 1e9);
+#if defined(__GLIBC__)
+        char** symbols = frames.empty() ? nullptr : backtrace_symbols(frames.data(), static_cast<int>(frames.size()));
+        for (size_t i = 0; i < frames.size(); ++i) {
+            if (symbols) {
+                fprintf(out, "    #%zu %s\n", i, symbols[i]);
+            } else {
+                fprintf(out, "    #%zu %p\n", i, frames[i]);
+            }
+        }
+        free(symbols);
+#else
+        for (size_t i = 0; i < frames.size(); ++i) fprintf(out, "    #%zu %p\n", i, frames[i]);
+#endif
+    }
+    if (file) fclose(file);
+}
+
+// External payloads of semaphores. A temporary payload, imported with VK_SEMAPHORE_IMPORT_TEMPORARY_BIT or as a sync fd,
+// replaces the permanent one until the next wait. A sync fd of -1 is a payload that is already signaled.
+struct SemaphoreFdState {
+    int permanent_fd;
+    bool has_temporary_payload;
+    int temporary_fd;
+    bool temporary_is_sync_fd;
+};
+
+// Event payloads. Host calls and queue workers flip the state atomically; a queue worker blocked in vkCmdWaitEvents
+// sleeps on event_cv until the events it waits for are set. Commands hold on to the payloads of the events they
+// reference, so queue workers never look events up.
+struct EventState {
+    explicit EventState(bool set) : signaled(set) {}
+    std::atomic<bool> signaled;
+};
+static std::mutex event_mutex;
+static std::condition_variable event_cv;
+
+static void SetEventState(EventState* state, bool signaled) {
+    if (!state) return;
+    {
+        std::lock_guard<std::mutex> lock(event_mutex);
+        state->signaled.store(signaled, std::memory_order_release);
+    }
+    if (signaled) event_cv.notify_all();
+}
+
+// Simulated VK_KHR_performance_query counters. They count commands as they are recorded into each command buffer, and a
+// performance query reports how much each counter grew between its begin and end. The result becomes available when a
+// queue executes the end of the query, like the other queue commands.
+enum PerformanceCounter : uint32_t {
+    kCounterDraws,
+    kCounterDispatches,
+    kCounterBytesCopied,
+    kCounterBarriers,
+    kCounterDescriptorBinds,
+    kCounterPipelineBinds,
+    kPerformanceCounterCount
+};
+struct PerformanceCounterInfo {
+    VkPerformanceCounterUnitKHR unit;
+    const char* name;
+    const char* description;
+};
+static const std::array<PerformanceCounterInfo, kPerformanceCounterCount> performance_counter_infos = {{
+    {VK_PERFORMANCE_COUNTER_UNIT_GENERIC_KHR, "Draws", "Draws recorded, counting each draw of indirect and multi-draw commands"},
+    {VK_PERFORMANCE_COUNTER_UNIT_GENERIC_KHR, "Dispatches", "Dispatch commands recorded"},
+    {VK_PERFORMANCE_COUNTER_UNIT_BYTES_KHR, "Bytes copied", "Bytes written by buffer copy, update and fill commands"},
+    {VK_PERFORMANCE_COUNTER_UNIT_GENERIC_KHR, "Barriers", "Memory, buffer and image barriers recorded in pipeline barriers"},
+    {VK_PERFORMANCE_COUNTER_UNIT_GENERIC_KHR, "Descriptor binds", "Descriptor sets bound or pushed"},
+    {VK_PERFORMANCE_COUNTER_UNIT_GENERIC_KHR, "Pipeline binds", "Pipelines bound"},
+}};
+using PerformanceCounterValues = std::array<uint64_t, kPerformanceCounterCount>;
+
+// Results of a performance query pool, with one value per enabled counter for each query. Queues write the results of
+// the queries they execute, so the results and their availability are guarded by a lock of the pool's own.
+struct PerformanceQueryPool {
+    std::vector<uint32_t> counter_indices;
+    std::mutex lock;
+    std::condition_variable available_cv;
+    std::vector<uint64_t> results;
+    std::vector<bool> available;
+};
+
+struct ActivePerformanceQuery {
+    VkQueryPool pool;
+    std::shared_ptr<PerformanceQueryPool> pool_state;
+    uint32_t query;
+    PerformanceCounterValues begin_values;
+};
+
+// Commands recorded into a command buffer that take effect when a queue executes it
+enum class QueueCommandType : uint8_t { kSetEvent, kResetEvent, kWaitEvent, kResetQueries, kEndQuery };
+struct QueueCommand {
+    QueueCommandType type;
+    std::shared_ptr<EventState> event;
+    // Performance queries: the pool, the first query and either the number of queries reset or the results of the query
+    std::shared_ptr<PerformanceQueryPool> query_pool;
+    uint32_t query;
+    uint32_t query_count;
+    PerformanceCounterValues counter_values;
+};
+
+// Makes queries of a performance query pool unavailable
+static void ResetPerformanceQueries(PerformanceQueryPool& pool, uint32_t first_query, uint32_t query_count) {
+    std::lock_guard<std::mutex> lock(pool.lock);
+    auto& available = pool.available;
+    std::fill(available.begin() + (std::min)(size_t(first_query), available.size()),
+              available.begin() + (std::min)(size_t(first_query) + query_count, available.size()), false);
+}
+
+// Stores the counter values of a performance query and makes it available
+static void EndPerformanceQuery(PerformanceQueryPool& pool, uint32_t query, const PerformanceCounterValues& values) {
+    {
+        std::lock_guard<std::mutex> lock(pool.lock);
+        if (query >= pool.available.size()) return;
+        const size_t counter_count = pool.counter_indices.size();
+        for (size_t i = 0; i < counter_count; ++i) {
+            const uint32_t counter = pool.counter_indices[i];
+            pool.results[query * counter_count + i] = counter < kPerformanceCounterCount ? values[counter] : 0;
+        }
+        pool.available[query] = true;
+    }
+    pool.available_cv.notify_all();
+}
+
+// A submitted batch. Queue commands of its command buffers are copied at submission.
+struct QueueBatch {
+    std::vector<VkSemaphore> wait_semaphores;
+    std::vector<QueueCommand> commands;
+    std::vector<VkSemaphore> signal_semaphores;
+    VkFence fence = VK_NULL_HANDLE;
+    uint64_t gpu_time_ns = 0;
+};
+
+// Number of queues in the queue family, at most VKMOCK_STATS_QUEUE_COUNT
+static const uint32_t icd_queue_count =
+    static_cast<uint32_t>((std::max)(VkDeviceSize(1), (std::min)(GetEnvSize("VKMOCK_QUEUE_COUNT", 1), VkDeviceSize(VKMOCK_STATS_QUEUE_COUNT))));
+
+// Scheduling parameters of a queue, from its VkDeviceQueueCreateInfo
+struct QueuePriority {
+    uint32_t global_priority;  // 0 (low) to 3 (realtime)
+    float priority;
+};
+
+static uint32_t GetGlobalPriorityRank(VkQueueGlobalPriorityKHR global_priority) {
+    switch (global_priority) {
+        case VK_QUEUE_GLOBAL_PRIORITY_LOW_KHR:
+            return 0;
+        case VK_QUEUE_GLOBAL_PRIORITY_HIGH_KHR:
+            return 2;
+        case VK_QUEUE_GLOBAL_PRIORITY_REALTIME_KHR:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+// The simulated GPU of a physical device, shared by the queues of all devices created from it. A batch occupies it for VKMOCK_GPU_COMMAND_NS per command
+// recorded into its command buffers, in slices of at most kSliceNs. At every slice boundary the GPU goes to the waiting
+// queue with the highest global priority, which preempts the others. Queues of equal global priority share the GPU in
+// proportion to their queue priorities: a slice advances the virtual time of its queue by its length divided by the
+// priority, and the queue with the lowest virtual time runs next.
+class GpuTimeline {
+  public:
+    struct Queue {
+        QueuePriority priority;
+        uint32_t ordinal;  // Global queue ordinal, selecting the busy time statistic
+        double virtual_time;
+    };
+
+    void Run(Queue& queue, uint64_t duration_ns) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // A queue that was idle gets no credit for the time it did not use
+        queue.virtual_time = (std::max)(queue.virtual_time, virtual_time_);
+        waiting_.push_back(&queue);
+        const double weight = (std::max)(queue.priority.priority, 0.01f);
+        while (duration_ns > 0) {
+            cv_.wait(lock, [&] { return !busy_ && Next() == &queue; });
+            busy_ = true;
+            virtual_time_ = queue.virtual_time;
+            const uint64_t slice_ns = duration_ns < kSliceNs ? duration_ns : kSliceNs;
+            // While the GPU stays busy, each slice is timed from the end of the previous one so wakeup latency does not add up
+            slice_end_ = (idle_ ? std::chrono::steady_clock::now() : slice_end_) + std::chrono::nanoseconds(slice_ns);
+            idle_ = false;
+            const auto slice_end = slice_end_;
+            lock.unlock();
+            std::this_thread::sleep_until(slice_end);
+            lock.lock();
+            busy_ = false;
+            queue.virtual_time += slice_ns / weight;
+            duration_ns -= slice_ns;
+            icd_stats.queue_busy_ns[queue.ordinal % VKMOCK_STATS_QUEUE_COUNT].fetch_add(slice_ns, std::memory_order_relaxed);
+            cv_.notify_all();
+        }
+        waiting_.erase(std::find(waiting_.begin(), waiting_.end(), &queue));
+        if (waiting_.empty()) idle_ = true;
+    }
+
+  private:
+    static const uint64_t kSliceNs = 100000;
+
+    Queue* Next() const {
+        Queue* next = nullptr;
+        for (auto* queue : waiting_) {
+            if (!next || queue->priority.global_priority > next->priority.global_priority ||
+                (queue->priority.global_priority == next->priority.global_priority && queue->virtual_time < next->virtual_time)) {
+                next = queue;
+            }
+        }
+        return next;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool busy_ = false;
+    double virtual_time_ = 0.0;  // Virtual time of the queue that ran last
+    bool idle_ = true;
+    std::chrono::steady_clock::time_point slice_end_;
+    std::vector<Queue*> waiting_;
+};
+struct QueueSchedule {
+    GpuTimeline* timeline;
+    QueuePriority priority;
+    uint32_t ordinal;
+};
+
+// Queues are numbered in the order they are created, across all devices and physical devices
+static uint32_t AllocateQueueOrdinal() {
+    static std::atomic<uint32_t> queue_count{0};
+    return queue_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Handles of non-dispatchable objects come from global_unique_handle, so their values depend on how the creation of all
+// objects interleaved. With VKMOCK_DETERMINISTIC_HANDLES set, each instance, physical device and device numbers the
+// objects it creates in a space of its own instead, with one counter per object type starting at VKMOCK_HANDLE_SEED.
+// Replaying the same calls then yields the same handles, whatever other devices and threads do in between. From the
+// top, a handle holds the ordinal of its space, the object type and the count.
+//
+// Each instance takes the next block of icd_handle_space_block ordinals, in creation order. The first ordinal of the
+// block is its own and the others are shared out between its physical devices: each one takes the first ordinal of its
+// share and gives the rest to the devices created from it, in the order it created them. The space of a device thus
+// depends on its physical device and on how many devices that physical device created before, and not on devices
+// created from other physical devices.
+static constexpr int icd_handle_space_bits = 10;
+static constexpr int icd_handle_type_bits = 20;
+static constexpr int icd_handle_counter_bits = 34;
+static constexpr uint64_t icd_handle_space_block = 64;
+static constexpr uint64_t icd_handle_spaces_per_physical_device = (icd_handle_space_block - 2) / icd_physical_device_count;
+static_assert(icd_handle_spaces_per_physical_device >= 2, "each physical device needs a space for itself and its devices");
+
+struct HandleSpace {
+    uint64_t ordinal = 0;
+    mutex_t lock;  // Guards next_counts, so objects are created without a lock shared by all devices
+    unordered_map<uint32_t, uint64_t> next_counts;
+};
+
+static uint64_t AllocateInstanceHandleSpaceOrdinal() {
+    static std::atomic<uint64_t> instance_count{0};
+    // Blocks wrap around rather than spill into the type bits, and ordinal 0 is skipped so no handle is VK_NULL_HANDLE
+    static constexpr uint64_t block_count = (uint64_t(1) << icd_handle_space_bits) / icd_handle_space_block;
+    return instance_count.fetch_add(1, std::memory_order_relaxed) % block_count * icd_handle_space_block + 1;
+}
+
+static uint64_t GetPhysicalDeviceHandleSpaceOrdinal(uint64_t instance_ordinal, uint32_t physical_device_index) {
+    return instance_ordinal + 1 + physical_device_index * icd_handle_spaces_per_physical_device;
+}
+
+// The devices of a physical device wrap around within its share of the block
+static uint64_t GetDeviceHandleSpaceOrdinal(uint64_t physical_device_ordinal, uint64_t device_index) {
+    return physical_device_ordinal + 1 + device_index % (icd_handle_spaces_per_physical_device - 1);
+}
+
+static bool UseDeterministicHandles() {
+    static const bool deterministic = GetEnvSize("VKMOCK_DETERMINISTIC_HANDLES", 0) != 0;
+    return deterministic;
+}
+
+static uint64_t NewHandle(HandleSpace& space, VkObjectType type) {
+    static const uint64_t seed = GetEnvSize("VKMOCK_HANDLE_SEED", 1);
+    // Extension object types are 1000000000 + 1000 * (extension number - 1) + n; fold them in above the core types
+    const uint32_t type_value = static_cast<uint32_t>(type);
+    const uint64_t type_index = type_value < 1000000000u ? type_value : type_value - 1000000000u + 1000u;
+    uint64_t count;
+    {
+        lock_guard_t lock(space.lock);
+        count = space.next_counts.emplace(type_value, seed).first->second++;
+    }
+    return (space.ordinal << (icd_handle_type_bits + icd_handle_counter_bits)) |
+           ((type_index & ((uint64_t(1) << icd_handle_type_bits) - 1)) << icd_handle_counter_bits) |
+           (count & ((uint64_t(1) << icd_handle_counter_bits) - 1));
+}
+
+// States kept in dispatchable handles. An instance owns its physical devices, and the devices created from a physical
+// device share its GPU timeline.
+struct PhysicalDeviceState {
+    GpuTimeline timeline;
+    HandleSpace handle_space;
+    std::atomic<uint64_t> device_count{0};  // Devices created from this physical device
+};
+
+struct InstanceState {
+    InstanceState() {
+        handle_space.ordinal = AllocateInstanceHandleSpaceOrdinal();
+        for (uint32_t i = 0; i < icd_physical_device_count; ++i) {
+            physical_device_states[i].handle_space.ordinal = GetPhysicalDeviceHandleSpaceOrdinal(handle_space.ordinal, i);
+        }
+    }
+
+    std::array<VkPhysicalDevice, icd_physical_device_count> physical_devices = {};
+    std::array<PhysicalDeviceState, icd_physical_device_count> physical_device_states;
+    HandleSpace handle_space;
+};
+
+struct DeviceObjects;
+class QueueWorker;
+
+struct DeviceState {
+    GpuTimeline* timeline = nullptr;
+    HandleSpace handle_space;
+    // Allocation callbacks given at device creation. They back device-level allocations and are the fallback for child
+    // objects created without their own callbacks. Devices created without callbacks get an arena instead.
+    bool has_allocator = false;
+    VkAllocationCallbacks allocator = {};
+    std::unique_ptr<DeviceArena> arena;
+    // Priorities of the queues by family and index, from device creation
+    unordered_map<uint32_t, unordered_map<uint32_t, QueuePriority>> queue_priorities;
+    // Queues by family and index, created when first retrieved. They are guarded by queue_lock, so devices get their
+    // queues without contending with each other.
+    mutex_t queue_lock;
+    unordered_map<uint32_t, unordered_map<uint32_t, VkQueue>> queues;
+    // Fences and external semaphore payloads, guarded by sync_lock so that the queue workers signaling them contend
+    // neither with other devices nor with calls on the device's other objects. fence_cv is notified when fences signal.
+    mutex_t sync_lock;
+    std::condition_variable_any fence_cv;
+    // Number of submitted batches that will signal each fence. A fence is signaled whenever none is pending.
+    unordered_map<VkFence, uint32_t> pending_fences;
+    unordered_map<VkSemaphore, SemaphoreFdState> semaphore_fds;
+    // Memory, resources, pools and events of the device, guarded by a lock of their own. Allocated like the state.
+    DeviceObjects* objects = nullptr;
+};
+
+struct QueueState {
+    DeviceState* device;
+    QueueSchedule schedule;
+    // Started by the first submission. Calls on a queue are externally synchronized, so it needs no lock.
+    std::unique_ptr<QueueWorker> worker;
+};
+
+static InstanceState* GetInstanceState(VkInstance instance) { return GetDispObjState<InstanceState>(instance); }
+static PhysicalDeviceState* GetPhysicalDeviceState(VkPhysicalDevice physicalDevice) {
+    return GetDispObjState<PhysicalDeviceState>(physicalDevice);
+}
+static DeviceState* GetDeviceState(VkDevice device) { return GetDispObjState<DeviceState>(device); }
+static QueueState* GetQueueState(VkQueue queue) { return GetDispObjState<QueueState>(queue); }
+
+// Handle for an object created by an instance, physical device or device
+static uint64_t NewUniqueHandle() { return global_unique_handle.fetch_add(1, std::memory_order_relaxed); }
+static uint64_t NewHandle(VkInstance instance, VkObjectType type) {
+    return UseDeterministicHandles() ? NewHandle(GetInstanceState(instance)->handle_space, type) : NewUniqueHandle();
+}
+static uint64_t NewHandle(VkPhysicalDevice physicalDevice, VkObjectType type) {
+    return UseDeterministicHandles() ? NewHandle(GetPhysicalDeviceState(physicalDevice)->handle_space, type)
+                                     : NewUniqueHandle();
+}
+static uint64_t NewHandle(VkDevice device, VkObjectType type) {
+    return UseDeterministicHandles() ? NewHandle(GetDeviceState(device)->handle_space, type) : NewUniqueHandle();
+}
+
+// Must be called with the device's sync_lock held
+static SemaphoreFdState& GetSemaphoreFdState(DeviceState& device, VkSemaphore semaphore) {
+    return device.semaphore_fds.emplace(semaphore, SemaphoreFdState{-1, false, -1, false}).first->second;
+}
+
+// Gives up when wake_fd becomes readable
+static void WaitExternalSemaphore(DeviceState& device, VkSemaphore semaphore, int wake_fd) {
+    int fd = -1;
+    bool sync_fd = false;
+    bool temporary = false;
+    {
+        lock_guard_t lock(device.sync_lock);
+        const auto it = device.semaphore_fds.find(semaphore);
+        if (it == device.semaphore_fds.end()) return;
+        auto& state = it->second;
+        if (state.has_temporary_payload) {
+            // Waiting consumes a temporary payload and restores the permanent one
+            fd = state.temporary_fd;
+            sync_fd = state.temporary_is_sync_fd;
+            temporary = true;
+            state.has_temporary_payload = false;
+            state.temporary_fd = -1;
+        } else {
+            fd = state.permanent_fd;
+        }
+    }
+    // The payload may be signaled by another process, so wait without holding the lock
+    if (fd < 0) return;
+    WaitSemaphoreFd(fd, sync_fd, wake_fd);
+    if (temporary) CloseFd(fd);
+}
+
+static void SignalExternalSemaphore(DeviceState& device, VkSemaphore semaphore) {
+    lock_guard_t lock(device.sync_lock);
+    const auto it = device.semaphore_fds.find(semaphore);
+    if (it == device.semaphore_fds.end()) return;
+    const auto& state = it->second;
+    const int fd = state.has_temporary_payload ? (state.temporary_is_sync_fd ? -1 : state.temporary_fd) : state.permanent_fd;
+    if (fd >= 0) SignalSemaphoreFd(fd);
+}
+
+// Each queue executes its batches in submission order on a worker thread, so vkQueueSubmit returns before the submitted
+// work has run, as it does on hardware.
+class QueueWorker {
+  public:
+    explicit QueueWorker(const QueueState& queue)
+        : device_(queue.device),
+          timeline_(queue.schedule.timeline),
+          gpu_queue_{queue.schedule.priority, queue.schedule.ordinal, 0.0},
+          wake_fd_(CreateSemaphoreFd(0)),
+          stopping_(false),
+          busy_(false),
+          thread_(&QueueWorker::Run, this) {}
+
+    // Drops the batches that have not started and finishes the running one without blocking on events or semaphores,
+    // then stops the worker. The fences of dropped batches are signaled so that nothing waits for them forever.
+    ~QueueWorker() {
+        std::deque<QueueBatch> dropped_batches;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            dropped_batches.swap(batches_);
+        }
+        work_cv_.notify_one();
+        if (wake_fd_ >= 0) SignalSemaphoreFd(wake_fd_);
+        {
+            std::lock_guard<std::mutex> lock(event_mutex);
+        }
+        event_cv.notify_all();
+        thread_.join();
+        if (wake_fd_ >= 0) CloseFd(wake_fd_);
+        for (const auto& batch : dropped_batches) {
+            if (batch.fence != VK_NULL_HANDLE) CompleteFence(batch.fence);
+        }
+    }
+
+    void Submit(QueueBatch&& batch) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batches_.push_back(std::move(batch));
+        }
+        work_cv_.notify_one();
+    }
+
+    // Must not be called with the device's sync_lock held, since finishing a batch takes it
+    void WaitIdle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_cv_.wait(lock, [this] { return batches_.empty() && !busy_; });
+    }
+
+  private:
+    void Run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            work_cv_.wait(lock, [this] { return stopping_ || !batches_.empty(); });
+            if (batches_.empty()) break;
+            QueueBatch batch = std::move(batches_.front());
+            batches_.pop_front();
+            busy_ = true;
+            lock.unlock();
+            Execute(batch);
+            lock.lock();
+            busy_ = false;
+            if (batches_.empty()) idle_cv_.notify_all();
+        }
+    }
+
+    void Execute(const QueueBatch& batch) {
+        for (const auto semaphore : batch.wait_semaphores) {
+            if (stopping_) break;
+            WaitExternalSemaphore(*device_, semaphore, wake_fd_);
+        }
+        if (timeline_ && batch.gpu_time_ns && !stopping_) {
+            timeline_->Run(gpu_queue_, batch.gpu_time_ns);
+        }
+        for (const auto& command : batch.commands) {
+            switch (command.type) {
+                case QueueCommandType::kSetEvent:
+                    SetEventState(command.event.get(), true);
+                    break;
+                case QueueCommandType::kResetEvent:
+                    SetEventState(command.event.get(), false);
+                    break;
+                case QueueCommandType::kWaitEvent:
+                    WaitEvent(*command.event);
+                    break;
+                case QueueCommandType::kResetQueries:
+                    ResetPerformanceQueries(*command.query_pool, command.query, command.query_count);
+                    break;
+                case QueueCommandType::kEndQuery:
+                    EndPerformanceQuery(*command.query_pool, command.query, command.counter_values);
+                    break;
+            }
+        }
+        for (const auto semaphore : batch.signal_semaphores) {
+            SignalExternalSemaphore(*device_, semaphore);
+        }
+        if (batch.fence != VK_NULL_HANDLE) CompleteFence(batch.fence);
+    }
+
+    void CompleteFence(VkFence fence) {
+        {
+            lock_guard_t lock(device_->sync_lock);
+            const auto it = device_->pending_fences.find(fence);
+            if (it != device_->pending_fences.end() && --it->second == 0) device_->pending_fences.erase(it);
+        }
+        device_->fence_cv.notify_all();
+    }
+
+    void WaitEvent(const EventState& state) {
+        std::unique_lock<std::mutex> lock(event_mutex);
+        event_cv.wait(lock, [&] { return state.signaled.load(std::memory_order_acquire) || stopping_; });
+    }
+
+    DeviceState* device_;
+    GpuTimeline* timeline_;
+    GpuTimeline::Queue gpu_queue_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<QueueBatch> batches_;
+    int wake_fd_;  // Readable once the worker is stopping, to interrupt semaphore waits
+    std::atomic<bool> stopping_;
+    bool busy_;
+    std::thread thread_;
+};
+
+// Hands batches to the queue's worker; the fence is signaled once the last one has run
+static void SubmitToQueue(VkQueue queue, std::vector<QueueBatch>& batches, VkFence fence) {
+    icd_stats.submit_count.fetch_add(1, std::memory_order_relaxed);
+    if (batches.empty()) {
+        if (fence == VK_NULL_HANDLE) return;
+        batches.emplace_back();
+    }
+    auto* state = GetQueueState(queue);
+    if (fence != VK_NULL_HANDLE) {
+        lock_guard_t lock(state->device->sync_lock);
+        ++state->device->pending_fences[fence];
+        batches.back().fence = fence;
+    }
+    if (!state->worker) state->worker.reset(new QueueWorker(*state));
+    for (auto& batch : batches) {
+        state->worker->Submit(std::move(batch));
+    }
+}
+
+static void WaitQueueIdle(VkQueue queue) {
+    const auto* state = GetQueueState(queue);
+    if (state->worker) state->worker->WaitIdle();
+}
+
+// Pipeline compilation is simulated as VKMOCK_PIPELINE_COMPILE_NS nanoseconds of CPU work per pipeline, split into chunks
+// so that the threads joining a deferred operation can share it
+static const uint32_t icd_pipeline_compile_chunks = 8;
+
+static void CompilePipelineChunk() {
+    static const VkDeviceSize chunk_time_ns = GetEnvSize("VKMOCK_PIPELINE_COMPILE_NS", 0) / icd_pipeline_compile_chunks;
+    if (chunk_time_ns == 0) return;
+    // Spin rather than sleep, so the chunk occupies its thread like real compilation
+    const auto end = std::chrono::steady_clock::now() + std::chrono::nanoseconds(chunk_time_ns);
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+// Work of a deferred host operation. Joining threads claim chunks by incrementing next_chunk; the operation is complete
+// once every chunk has finished. An operation that has no deferred command is complete.
+struct DeferredOperationState {
+    uint32_t chunk_count = 0;
+    std::atomic<uint32_t> next_chunk{0};
+    std::atomic<uint32_t> finished_chunks{0};
+};
+
+// 64-bit hash of shader code in the style of xxHash: four independent lanes each consume one 8-byte word of every
+// 32-byte block, so the main loop carries no dependency between lanes, then the lanes, the tail and the size are folded
+// and avalanched.
+static uint64_t HashShaderCode(const void* data, size_t size) {
+    static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    const auto rotate = [](uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t lanes[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+    size_t offset = 0;
+    for (; offset + 32 <= size; offset += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            uint64_t word;
+            memcpy(&word, bytes + offset + lane * 8, sizeof(word));
+            lanes[lane] = rotate(lanes[lane] + word * kPrime2, 31) * kPrime1;
+        }
+    }
+    uint64_t hash = rotate(lanes[0], 1) + rotate(lanes[1], 7) + rotate(lanes[2], 12) + rotate(lanes[3], 18);
+    hash += static_cast<uint64_t>(size);
+    for (; offset < size; ++offset) {
+        hash = rotate(hash ^ (bytes[offset] * kPrime1), 11) * kPrime2;
+    }
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime1;
+    return hash ^ (hash >> 32);
+}
+
+// Shader modules are deduplicated by content, like a driver's shader cache: modules of a device with the same code share
+// one refcounted entry, which lives as long as any of them. A pipeline pays the simulated compile cost only if one of its
+// stages uses code that no earlier pipeline of the device compiled. Devices do not share compiled code, so each device
+// has a cache of its own.
+struct ShaderCodeEntry {
+    uint64_t hash;
+    std::vector<uint8_t> code;
+    uint32_t ref_count;
+    bool compiled;  // Whether a pipeline compiled the code
+};
+struct ShaderCodeCache {
+    std::unordered_multimap<uint64_t, std::unique_ptr<ShaderCodeEntry>> entries;
+    unordered_map<VkShaderModule, ShaderCodeEntry*> modules;
+};
+
+// Returns the entry holding the code, adding one if the code is new. Hash collisions are told apart by comparing the
+// code. Must be called with the device's objects locked.
+static ShaderCodeEntry* AcquireShaderCode(ShaderCodeCache& cache, uint64_t hash, const void* code, size_t size) {
+    const auto range = cache.entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto& entry = *it->second;
+        if (entry.code.size() == size && memcmp(entry.code.data(), code, size) == 0) {
+            ++entry.ref_count;
+            icd_stats.shader_module_cache_hits.fetch_add(1, std::memory_order_relaxed);
+            icd_stats.shader_module_bytes_saved.fetch_add(size, std::memory_order_relaxed);
+            return &entry;
+        }
+    }
+    icd_stats.shader_module_cache_misses.fetch_add(1, std::memory_order_relaxed);
+    const uint8_t* bytes = static_cast<const uint8_t*>(code);
+    std::unique_ptr<ShaderCodeEntry> entry(new ShaderCodeEntry{hash, std::vector<uint8_t>(bytes, bytes + size), 1, false});
+    return cache.entries.emplace(hash, std::move(entry))->second.get();
+}
+
+// Must be called with the device's objects locked
+static void ReleaseShaderCode(ShaderCodeCache& cache, ShaderCodeEntry* entry) {
+    if (--entry->ref_count > 0) return;
+    const auto range = cache.entries.equal_range(entry->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.get() == entry) {
+            cache.entries.erase(it);
+            return;
+        }
+    }
+}
+
+// Marks the code of a pipeline's stages compiled. Returns whether the pipeline has to compile anything, that is whether
+// a stage uses code the device did not compile before or a module the ICD does not know. Must be called with the
+// device's objects locked.
+static bool CompileShaderStages(ShaderCodeCache& cache, uint32_t stage_count, const VkPipelineShaderStageCreateInfo* stages) {
+    bool compile = stage_count == 0;
+    for (uint32_t i = 0; i < stage_count; ++i) {
+        const auto it = cache.modules.find(stages[i].module);
+        if (it == cache.modules.end()) {
+            compile = true;
+            continue;
+        }
+        if (!it->second->compiled) {
+            it->second->compiled = true;
+            compile = true;
+        }
+    }
+    return compile;
+}
+
+// Every vkCmd* call appends a record to its command buffer's stream: the opcode, followed by the by-value parameters
+// after commandBuffer packed back to back, then the pointer and array parameters copied into the record. A command buffer
+// carves its records from a chain of blocks taken from its pool and gives the blocks back when it is reset, begun again
+// or freed, so recording only allocates while the command buffers of a pool together grow past their previous
+// high-water mark.
+struct CommandRecord {
+    CommandRecord* next;
+    CommandOpcode opcode;
+    uint32_t args_size;
+    uint32_t array_count;
+    // Packed arguments follow, then array_count VkmockCommandArray aligned to kRecordAlignment and the array data
+};
+
+static const size_t kRecordAlignment = 8;
+static size_t AlignRecordSize(size_t size) { return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1); }
+
+// Blocks of a command pool that none of its command buffers is using. Vulkan requires host access to a command pool and
+// to the command buffers allocated from it to be externally synchronized, so neither the pool nor the streams recording
+// into it need a lock.
+class CommandArena {
+  public:
+    static const size_t kBlockSize = 64 * 1024;
+    struct Block {
+        Block* next;
+        size_t size;  // kBlockSize, or more for a block made for a single larger record
+    };
+    // Records start after the block header
+    static const size_t kHeaderSize = (sizeof(Block) + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+
+    // Blocks come from the pool's allocation callbacks with command scope, if it has any
+    explicit CommandArena(const VkAllocationCallbacks* allocator)
+        : has_allocator_(allocator != nullptr), allocator_(allocator ? *allocator : VkAllocationCallbacks()) {}
+    CommandArena(const CommandArena&) = delete;
+    CommandArena& operator=(const CommandArena&) = delete;
+    ~CommandArena() { Release(); }
+
+    // Returns a block of at least size bytes, or nullptr when out of memory
+    Block* Take(size_t size) {
+        if (!free_ || free_->size < size) {
+            size = (std::max)(size, kBlockSize);
+            void* memory = has_allocator_ ? allocator_.pfnAllocation(allocator_.pUserData, size, kRecordAlignment,
+                                                                     VK_SYSTEM_ALLOCATION_SCOPE_COMMAND)
+                                          : ::operator new(size, std::nothrow);
+            if (!memory) return nullptr;
+            Block* block = static_cast<Block*>(memory);
+            block->size = size;
+            return block;
+        }
+        Block* block = free_;
+        free_ = block->next;
+        return block;
+    }
+    // Takes back a chain of blocks linked from first to last
+    void Give(Block* first, Block* last) {
+        last->next = free_;
+        free_ = first;
+    }
+    // Frees the blocks that are not in use
+    void Release() {
+        while (free_) {
+            Block* next = free_->next;
+            if (has_allocator_) {
+                allocator_.pfnFree(allocator_.pUserData, free_);
+            } else {
+                ::operator delete(free_);
+            }
+            free_ = next;
+        }
+    }
+
+  private:
+    bool has_allocator_;
+    VkAllocationCallbacks allocator_;
+    Block* free_ = nullptr;
+};
+
+struct CommandStream {
+    CommandArena* arena = nullptr;  // Arena of the pool, null if the pool is unknown
+    CommandArena::Block* first_block = nullptr;
+    CommandArena::Block* last_block = nullptr;
+    size_t offset = 0;  // Bytes used in last_block
+    CommandRecord* head = nullptr;
+    CommandRecord* tail = nullptr;
+    uint32_t count = 0;
+    bool out_of_memory = false;  // A record could not be allocated, so vkEndCommandBuffer fails
+};
+
+// Returns storage for size bytes, or nullptr when out of memory. A record that does not fit in a block gets a block of
+// its own.
+static void* AllocateCommandRecord(CommandStream& stream, size_t size) {
+    size = AlignRecordSize(size);
+    if (!stream.last_block || stream.offset + size > stream.last_block->size) {
+        auto* block = stream.arena->Take(CommandArena::kHeaderSize + size);
+        if (!block) {
+            stream.out_of_memory = true;
+            return nullptr;
+        }
+        block->next = nullptr;
+        if (stream.last_block) {
+            stream.last_block->next = block;
+        } else {
+            stream.first_block = block;
+        }
+        stream.last_block = block;
+        stream.offset = CommandArena::kHeaderSize;
+    }
+    void* result = reinterpret_cast<uint8_t*>(stream.last_block) + stream.offset;
+    stream.offset += size;
+    return result;
+}
+
+// Drops the records of a stream and gives its blocks back to the pool
+static void ResetCommandStream(CommandStream& stream) {
+    if (stream.first_block) stream.arena->Give(stream.first_block, stream.last_block);
+    stream.first_block = nullptr;
+    stream.last_block = nullptr;
+    stream.offset = 0;
+    stream.head = nullptr;
+    stream.tail = nullptr;
+    stream.count = 0;
+    stream.out_of_memory = false;
+}
+
+// State of a command buffer, kept in its dispatchable handle. Command buffers are externally synchronized like their
+// pool, so recording into one takes no lock.
+struct CommandBufferState {
+    DeviceState* device = nullptr;
+    CommandStream stream;
+    std::vector<QueueCommand> queue_commands;
+    PerformanceCounterValues counters = {};
+    bool has_active_query = false;
+    ActivePerformanceQuery active_query = {};
+};
+
+static CommandBufferState* GetCommandBufferState(VkCommandBuffer commandBuffer) {
+    return GetDispObjState<CommandBufferState>(commandBuffer);
+}
+
+static void CountCommand(VkCommandBuffer commandBuffer, PerformanceCounter counter, uint64_t amount = 1) {
+    GetCommandBufferState(commandBuffer)->counters[counter] += amount;
+}
+
+// A pointer or array parameter of a recorded command, copied into its record as count elements. The elements of the
+// application's array are stride bytes apart.
+template <typename T>
+struct CommandArray {
+    const char* name;
+    const T* data;
+    uint32_t count;
+    size_t stride;
+};
+
+template <typename T>
+static CommandArray<T> RecordArray(const char* name, const T* data, uint64_t count, size_t stride = sizeof(T)) {
+    return {name, data, data ? static_cast<uint32_t>(count) : 0u, stride};
+}
+
+static size_t RecordedStringLength(const char* string) { return string ? strlen(string) + 1 : 0; }
+
+class CommandDataWriter;
+
+// How the recorded copy of a structure is fixed up, so that nothing in a record points into the application's memory.
+// Structures with pointers specialize it with the generated commands: arrays they point to are copied after them and
+// their pointers redirected to the copies, while pNext chains and pointers that cannot be followed are cleared. Other
+// types are copied as they are.
+template <typename T>
+struct RecordedStruct {
+    static const bool kHasPointers = false;
+    static size_t NestedSize(const T&) { return 0; }
+    static void CopyNested(T&, CommandDataWriter&) {}
+};
+
+template <typename T>
+static const T& GetArrayElement(const T* data, size_t index, size_t stride) {
+    return *reinterpret_cast<const T*>(reinterpret_cast<const uint8_t*>(data) + index * stride);
+}
+
+// Bytes that copying an array takes in a record, including the arrays its elements point to
+template <typename T>
+static size_t RecordedArraySize(const T* data, size_t count, size_t stride = sizeof(T)) {
+    if (!data || !count) return 0;
+    size_t size = AlignRecordSize(sizeof(T) * count);
+    if (RecordedStruct<T>::kHasPointers) {
+        for (size_t i = 0; i < count; ++i) {
+            size += RecordedStruct<T>::NestedSize(GetArrayElement(data, i, stride));
+        }
+    }
+    return size;
+}
 
-// Map device memory allocation handle to the size
-static unordered_map<VkDeviceMemory, VkDeviceSize> allocated_memory_size_map;
+// Copies arrays one after the other into the data of a record, which RecordedArraySize sized
+class CommandDataWriter {
+  public:
+    explicit CommandDataWriter(uint8_t* data) : data_(data) {}
+
+    template <typename T>
+    T* CopyArray(const T* data, size_t count, size_t stride = sizeof(T)) {
+        if (!data || !count) return nullptr;
+        T* copy = reinterpret_cast<T*>(data_);
+        data_ += AlignRecordSize(sizeof(T) * count);
+        if (stride == sizeof(T)) {
+            memcpy(copy, data, sizeof(T) * count);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                memcpy(copy + i, &GetArrayElement(data, i, stride), sizeof(T));
+            }
+        }
+        if (RecordedStruct<T>::kHasPointers) {
+            for (size_t i = 0; i < count; ++i) {
+                RecordedStruct<T>::CopyNested(copy[i], *this);
+            }
+        }
+        return copy;
+    }
+
+  private:
+    uint8_t* data_;
+};
+
+// Sizes of the parts of a record
+struct CommandRecordLayout {
+    size_t args_size = 0;
+    uint32_t array_count = 0;
+    size_t data_size = 0;
+};
+
+static void MeasureArgs(CommandRecordLayout&) {}
+template <typename T, typename... Args>
+static void MeasureArgs(CommandRecordLayout& layout, const CommandArray<T>& array, const Args&... args);
+template <typename T, typename... Args>
+static void MeasureArgs(CommandRecordLayout& layout, const T&, const Args&... args) {
+    layout.args_size += sizeof(T);
+    MeasureArgs(layout, args...);
+}
+template <typename T, typename... Args>
+static void MeasureArgs(CommandRecordLayout& layout, const CommandArray<T>& array, const Args&... args) {
+    ++layout.array_count;
+    layout.data_size += RecordedArraySize(array.data, array.count, array.stride);
+    MeasureArgs(layout, args...);
+}
+
+static void PackArgs(uint8_t*, VkmockCommandArray*, CommandDataWriter&) {}
+template <typename T, typename... Args>
+static void PackArgs(uint8_t* dst, VkmockCommandArray* arrays, CommandDataWriter& writer, const CommandArray<T>& array,
+                     const Args&... args);
+template <typename T, typename... Args>
+static void PackArgs(uint8_t* dst, VkmockCommandArray* arrays, CommandDataWriter& writer, const T& arg, const Args&... args) {
+    memcpy(dst, &arg, sizeof(T));
+    PackArgs(dst + sizeof(T), arrays, writer, args...);
+}
+template <typename T, typename... Args>
+static void PackArgs(uint8_t* dst, VkmockCommandArray* arrays, CommandDataWriter& writer, const CommandArray<T>& array,
+                     const Args&... args) {
+    arrays->pName = array.name;
+    arrays->count = array.count;
+    arrays->elementSize = sizeof(T);
+    arrays->pData = writer.CopyArray(array.data, array.count, array.stride);
+    PackArgs(dst, arrays + 1, writer, args...);
+}
+
+static const VkmockCommandArray* GetRecordedArrays(const CommandRecord* record) {
+    return reinterpret_cast<const VkmockCommandArray*>(reinterpret_cast<const uint8_t*>(record) +
+                                                       AlignRecordSize(sizeof(CommandRecord) + record->args_size));
+}
+
+// Appends a command to its command buffer's stream. Pointer and array parameters are passed through RecordArray.
+template <typename... Args>
+static void RecordCommand(VkCommandBuffer commandBuffer, CommandOpcode opcode, const Args&... args) {
+    auto& stream = GetCommandBufferState(commandBuffer)->stream;
+    if (!stream.arena) return;
+    CommandRecordLayout layout;
+    MeasureArgs(layout, args...);
+    const size_t arrays_offset = AlignRecordSize(sizeof(CommandRecord) + layout.args_size);
+    const size_t data_offset = arrays_offset + AlignRecordSize(layout.array_count * sizeof(VkmockCommandArray));
+    auto* record = static_cast<CommandRecord*>(AllocateCommandRecord(stream, data_offset + layout.data_size));
+    if (!record) return;
+    record->next = nullptr;
+    record->opcode = opcode;
+    record->args_size = static_cast<uint32_t>(layout.args_size);
+    record->array_count = layout.array_count;
+    auto* bytes = reinterpret_cast<uint8_t*>(record);
+    CommandDataWriter writer(bytes + data_offset);
+    PackArgs(reinterpret_cast<uint8_t*>(record + 1), reinterpret_cast<VkmockCommandArray*>(bytes + arrays_offset), writer,
+             args...);
+    if (stream.tail) {
+        stream.tail->next = record;
+    } else {
+        stream.head = record;
+    }
+    stream.tail = record;
+    ++stream.count;
+}
+
+static VkResult GetRecordedCommands(VkCommandBuffer commandBuffer, uint32_t* pCommandCount, VkmockCommand* pCommands) {
+    const auto& stream = GetCommandBufferState(commandBuffer)->stream;
+    if (!pCommands) {
+        *pCommandCount = stream.count;
+        return VK_SUCCESS;
+    }
+    uint32_t written = 0;
+    for (auto* record = stream.head; record && written < *pCommandCount; record = record->next) {
+        auto& command = pCommands[written++];
+        command.opcode = record->opcode;
+        command.pName = command_opcode_names[record->opcode];
+        command.argsSize = record->args_size;
+        command.pArgs = record + 1;
+        command.arrayCount = record->array_count;
+        command.pArrays = record->array_count ? GetRecordedArrays(record) : nullptr;
+    }
+    *pCommandCount = written;
+    return written < stream.count ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+// Appends the queue commands and GPU time of a command buffer to a batch
+static void AppendQueueCommands(QueueBatch& batch, VkCommandBuffer commandBuffer) {
+    static const uint64_t command_time_ns = GetEnvSize("VKMOCK_GPU_COMMAND_NS", 0);
+    const auto* state = GetCommandBufferState(commandBuffer);
+    batch.commands.insert(batch.commands.end(), state->queue_commands.begin(), state->queue_commands.end());
+    batch.gpu_time_ns += command_time_ns * state->stream.count;
+}
+
+// Drops everything recorded into a command buffer. The queue commands keep their storage and the blocks of the stream go
+// back to the pool, so recording the command buffer again does not allocate.
+static void ResetCommandBufferState(CommandBufferState& state) {
+    state.queue_commands.clear();
+    state.counters.fill(0);
+    state.has_active_query = false;
+    state.active_query.pool_state.reset();
+    ResetCommandStream(state.stream);
+}
+
+// Gives the blocks of a freed command buffer back to its pool and releases its state, which was allocated with the
+// pool's callbacks
+static void DestroyCommandBufferState(VkCommandBuffer commandBuffer, const VkAllocationCallbacks* pAllocator) {
+    auto* state = GetCommandBufferState(commandBuffer);
+    ResetCommandStream(state->stream);
+    DeleteObjectState(state, pAllocator);
+}
+
+// Reader-writer spin lock for short critical sections (std::shared_mutex needs C++17). A writer sets the writer bit,
+// which holds off new readers, then waits for the readers inside to leave.
+class RwSpinLock {
+  public:
+    void lock_shared() {
+        bool contended = false;
+        for (;;) {
+            uint32_t state = state_.load(std::memory_order_relaxed);
+            if (state & kWriter) {
+                Backoff(contended);
+            } else if (state_.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+    void unlock_shared() { state_.fetch_sub(1, std::memory_order_release); }
+    void lock() {
+        bool contended = false;
+        while (state_.fetch_or(kWriter, std::memory_order_acquire) & kWriter) Backoff(contended);
+        while (state_.load(std::memory_order_acquire) != kWriter) Backoff(contended);
+    }
+    void unlock() { state_.fetch_and(~kWriter, std::memory_order_release); }
+
+  private:
+    static const uint32_t kWriter = 1u << 31;
+    static void Backoff(bool& contended) {
+        if (!contended) {
+            contended = true;
+            CountLockContention();
+        }
+        std::this_thread::yield();
+    }
+    std::atomic<uint32_t> state_{0};
+};
+
+// Hash map split into independently locked shards, for object state that is read far more often than it changes.
+// Lookups copy the value out under one shard's shared lock, so they never wait on a device's lock, on other readers or
+// on writes to other shards. The shard locks are innermost: never take another lock while holding one.
+template <typename Key, typename Value>
+class ShardedMap {
+  public:
+    bool Find(Key key, Value* value) {
+        auto& shard = GetShard(key);
+        shard.lock.lock_shared();
+        const auto it = shard.map.find(key);
+        const bool found = it != shard.map.end();
+        if (found) *value = it->second;
+        shard.lock.unlock_shared();
+        return found;
+    }
+    void Insert(Key key, const Value& value) {
+        auto& shard = GetShard(key);
+        std::lock_guard<RwSpinLock> lock(shard.lock);
+        shard.map[key] = value;
+    }
+    void Erase(Key key) {
+        auto& shard = GetShard(key);
+        std::lock_guard<RwSpinLock> lock(shard.lock);
+        shard.map.erase(key);
+    }
+  private:
+    static const size_t kShardCount = 16;
+    struct alignas(64) Shard {
+        RwSpinLock lock;
+        unordered_map<Key, Value> map;
+    };
+    // Handles are mostly sequential, so consecutive objects land on different shards
+    Shard& GetShard(Key key) { return shards_[std::hash<Key>()(key) % kShardCount]; }
+    std::array<Shard, kShardCount> shards_;
+};
+
+struct BufferState {
+    VkDeviceSize size;
+    VkBufferCreateFlags flags;
+    VkBufferUsageFlags usage;
+};
+
+struct ImageState {
+    VkDeviceSize memory_size;
+    bool sparse;
+    bool linear;
+};
+
+// Buffer alignment by usage, in the range desktop drivers report: uniform and texel buffers need the most
+static VkDeviceSize GetBufferAlignment(VkBufferUsageFlags usage) {
+    if (usage & (VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT)) {
+        return 256;
+    }
+    if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) return 64;
+    return 16;
+}
+
+// Optimally tiled images of 64 KiB or more are aligned to 64 KiB, so they can be mapped with large pages
+static VkDeviceSize GetImageAlignment(const ImageState& state) {
+    if (state.sparse) return icd_sparse_page_size;
+    if (state.linear) return 256;
+    return state.memory_size >= 0x10000 ? 0x10000 : 4096;
+}
 
-static unordered_map<VkDevice, unordered_map<uint32_t, unordered_map<uint32_t, VkQueue>>> queue_map;
-static unordered_map<VkDevice, unordered_map<VkBuffer, VkBufferCreateInfo>> buffer_map;
-static unordered_map<VkDevice, unordered_map<VkImage, VkDeviceSize>> image_memory_size_map;
-static unordered_map<VkCommandPool, std::vector<VkCommandBuffer>> command_pool_buffer_map;
+// Ranges of device memory bound to buffers and images, keyed by the resource handle
+struct MemoryBinding {
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    bool linear;  // A buffer or linear image, as opposed to an optimally tiled image
+};
+
+struct CommandPoolState {
+    std::vector<VkCommandBuffer> command_buffers;
+    // Effective allocation callbacks of the pool, used for the command buffers allocated from it
+    bool has_allocator = false;
+    VkAllocationCallbacks allocator = {};
+    std::unique_ptr<CommandArena> arena;
+};
+
+// Callbacks for a device child's host allocations: the object's own, else the device's, else nullptr (use the arena)
+static const VkAllocationCallbacks* GetChildAllocator(VkDevice device, const VkAllocationCallbacks* pAllocator) {
+    if (pAllocator) return pAllocator;
+    const auto* state = GetDeviceState(device);
+    return state && state->has_allocator ? &state->allocator : nullptr;
+}
+
+static DeviceArena* GetDeviceArena(VkDevice device) {
+    const auto* state = GetDeviceState(device);
+    return state ? state->arena.get() : nullptr;
+}
 
 static constexpr uint32_t icd_swapchain_image_count = 1;
-static unordered_map<VkSwapchainKHR, VkImage[icd_swapchain_image_count]> swapchain_image_map;
+
+// Simulated presentation engine. The display refreshes every VKMOCK_REFRESH_DURATION_NS on the monotonic clock and shows
+// one presented image per refresh, in FIFO order, no earlier than its desired present time.
+static const size_t icd_max_past_presentation_timings = 64;
+struct SwapchainPresentState {
+    uint64_t last_present_time = 0;
+    std::deque<VkPastPresentationTimingGOOGLE> past_timings;
+};
+
+static uint64_t GetRefreshDurationNs() {
+    static const uint64_t refresh_duration = (std::max)(GetEnvSize("VKMOCK_REFRESH_DURATION_NS", 16666667), VkDeviceSize(1));
+    return refresh_duration;
+}
+
+// Returns the first refresh at or after a time
+static uint64_t GetNextRefreshTime(uint64_t time) {
+    const uint64_t refresh_duration = GetRefreshDurationNs();
+    return (time + refresh_duration - 1) / refresh_duration * refresh_duration;
+}
+
+// Schedules a presented image and sets when its refresh will happen. Returns false for a swapchain that is not among the
+// device's swapchain states. Must be called with the device's objects locked.
+static bool SchedulePresent(unordered_map<VkSwapchainKHR, SwapchainPresentState>& swapchain_states, VkSwapchainKHR swapchain,
+                            uint32_t present_id, uint64_t desired_present_time, uint64_t* present_time) {
+    const auto it = swapchain_states.find(swapchain);
+    if (it == swapchain_states.end()) return false;
+    auto& state = it->second;
+    const uint64_t now = GetMonotonicTimeNs();
+    VkPastPresentationTimingGOOGLE timing;
+    timing.presentID = present_id;
+    timing.desiredPresentTime = desired_present_time;
+    timing.earliestPresentTime = (std::max)(GetNextRefreshTime(now), state.last_present_time + GetRefreshDurationNs());
+    timing.actualPresentTime = (std::max)(timing.earliestPresentTime, GetNextRefreshTime(desired_present_time));
+    timing.presentMargin = timing.earliestPresentTime - now;
+    state.last_present_time = timing.actualPresentTime;
+    // Applications that never read their timings would otherwise grow the history without bound
+    if (state.past_timings.size() == icd_max_past_presentation_timings) state.past_timings.pop_front();
+    state.past_timings.push_back(timing);
+    *present_time = timing.actualPresentTime;
+    return true;
+}
+
+// Page table of a sparse resource: an ordered map of non-overlapping resource byte ranges to the device memory ranges
+// backing them. Adjacent ranges backed by contiguous bytes of the same allocation are coalesced, so binds, lookups and
+// unbinds are O(log n) in the number of discontiguous bound ranges.
+class SparsePageTable {
+  public:
+    void Bind(VkDeviceSize offset, VkDeviceSize size, VkDeviceMemory memory, VkDeviceSize memory_offset) {
+        if (size == 0) return;
+        const VkDeviceSize end = offset + size;
+        auto it = ranges_.lower_bound(offset);
+        // Split off the part of a preceding range that overlaps [offset, end)
+        if (it != ranges_.begin()) {
+            auto prev = std::prev(it);
+            if (prev->second.end > offset) {
+                if (prev->second.end > end) {
+                    ranges_.emplace_hint(it, end, Range{prev->second.end, prev->second.memory,
+                                                        prev->second.memory_offset + (end - prev->first)});
+                }
+                prev->second.end = offset;
+            }
+        }
+        // Drop ranges starting inside [offset, end), keeping the tail of one that extends past it
+        while (it != ranges_.end() && it->first < end) {
+            if (it->second.end > end) {
+                const Range tail = {it->second.end, it->second.memory, it->second.memory_offset + (end - it->first)};
+                it = ranges_.erase(it);
+                it = ranges_.emplace_hint(it, end, tail);
+                break;
+            }
+            it = ranges_.erase(it);
+        }
+        if (memory == VK_NULL_HANDLE) return;
+
+        VkDeviceSize start = offset;
+        VkDeviceSize start_memory_offset = memory_offset;
+        VkDeviceSize new_end = end;
+        if (it != ranges_.begin()) {
+            auto prev = std::prev(it);
+            if (prev->second.end == offset && prev->second.memory == memory &&
+                prev->second.memory_offset + (offset - prev->first) == memory_offset) {
+                start = prev->first;
+                start_memory_offset = prev->second.memory_offset;
+                ranges_.erase(prev);
+            }
+        }
+        if (it != ranges_.end() && it->first == end && it->second.memory == memory && it->second.memory_offset == memory_offset + size) {
+            new_end = it->second.end;
+            it = ranges_.erase(it);
+        }
+        ranges_.emplace_hint(it, start, Range{new_end, memory, start_memory_offset});
+    }
+
+    bool Resolve(VkDeviceSize offset, VkDeviceMemory* memory, VkDeviceSize* memory_offset) const {
+        auto it = ranges_.upper_bound(offset);
+        if (it == ranges_.begin()) return false;
+        --it;
+        if (offset >= it->second.end) return false;
+        *memory = it->second.memory;
+        *memory_offset = it->second.memory_offset + (offset - it->first);
+        return true;
+    }
+
+    VkDeviceSize GetResidentSize(VkDeviceSize offset, VkDeviceSize size) const {
+        const VkDeviceSize end = (size > UINT64_MAX - offset) ? UINT64_MAX : offset + size;
+        VkDeviceSize resident = 0;
+        auto it = ranges_.upper_bound(offset);
+        if (it != ranges_.begin()) --it;
+        for (; it != ranges_.end() && it->first < end; ++it) {
+            const VkDeviceSize overlap_begin = (std::max)(it->first, offset);
+            const VkDeviceSize overlap_end = (std::min)(it->second.end, end);
+            if (overlap_end > overlap_begin) resident += overlap_end - overlap_begin;
+        }
+        return resident;
+    }
+
+  private:
+    struct Range {
+        VkDeviceSize end;
+        VkDeviceMemory memory;
+        VkDeviceSize memory_offset;
+    };
+    std::map<VkDeviceSize, Range> ranges_;
+};
+
+// Opaque layout of a sparse residency image. Each tile of imageGranularity texels occupies one sparse page. Within an
+// array layer the tiles of the mip levels before the mip tail are stored level by level in row-major order, followed
+// by the layer's mip tail.
+struct SparseImageLayout {
+    VkImageAspectFlags aspect_mask;
+    VkExtent3D granularity;
+    VkExtent3D extent;
+    uint32_t mip_levels;
+    uint32_t array_layers;
+    uint32_t mip_tail_first_lod;
+    std::vector<VkDeviceSize> mip_offsets;
+    VkDeviceSize mip_tail_offset;
+    VkDeviceSize mip_tail_size;
+    VkDeviceSize layer_stride;
+};
+
+static uint32_t DivideRoundUp(uint32_t value, uint32_t divisor) { return (value + divisor - 1) / divisor; }
+
+static VkExtent3D GetMipExtent(const VkExtent3D& extent, uint32_t mip_level) {
+    return {(std::max)(extent.width >> mip_level, 1u), (std::max)(extent.height >> mip_level, 1u),
+            (std::max)(extent.depth >> mip_level, 1u)};
+}
+
+static VkImageAspectFlags GetSparseAspectMask(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_S8_UINT:
+            return VK_IMAGE_ASPECT_STENCIL_BIT;
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default:
+            return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+// Standard block shapes of a 64 KiB page holding 128-bit texels
+static VkExtent3D GetSparseImageGranularity(VkImageType type) {
+    switch (type) {
+        case VK_IMAGE_TYPE_1D:
+            return {4096, 1, 1};
+        case VK_IMAGE_TYPE_3D:
+            return {16, 16, 16};
+        default:
+            return {64, 64, 1};
+    }
+}
+
+static SparseImageLayout CreateSparseImageLayout(const VkImageCreateInfo* pCreateInfo) {
+    SparseImageLayout layout = {};
+    layout.aspect_mask = GetSparseAspectMask(pCreateInfo->format);
+    layout.granularity = GetSparseImageGranularity(pCreateInfo->imageType);
+    layout.extent = pCreateInfo->extent;
+    layout.mip_levels = pCreateInfo->mipLevels;
+    layout.array_layers = pCreateInfo->arrayLayers;
+    layout.mip_tail_first_lod = pCreateInfo->mipLevels;
+    VkDeviceSize offset = 0;
+    for (uint32_t mip = 0; mip < pCreateInfo->mipLevels; ++mip) {
+        const VkExtent3D mip_extent = GetMipExtent(pCreateInfo->extent, mip);
+        if (mip_extent.width < layout.granularity.width || mip_extent.height < layout.granularity.height ||
+            mip_extent.depth < layout.granularity.depth) {
+            layout.mip_tail_first_lod = mip;
+            break;
+        }
+        layout.mip_offsets.push_back(offset);
+        offset += icd_sparse_page_size * DivideRoundUp(mip_extent.width, layout.granularity.width) *
+                  DivideRoundUp(mip_extent.height, layout.granularity.height) *
+                  DivideRoundUp(mip_extent.depth, layout.granularity.depth);
+    }
+    layout.mip_tail_offset = offset;
+    layout.mip_tail_size = (layout.mip_tail_first_lod < layout.mip_levels) ? icd_sparse_page_size : 0;
+    layout.layer_stride = offset + layout.mip_tail_size;
+    return layout;
+}
+
+// Binds the tiles covered by a VkSparseImageMemoryBind. A row of tiles is contiguous both in the image's opaque layout
+// and in the bound memory, so each row is a single page table update.
+static void BindSparseImageTiles(SparsePageTable& page_table, const SparseImageLayout& layout, const VkSparseImageMemoryBind& bind) {
+    const uint32_t mip = bind.subresource.mipLevel;
+    if (mip >= layout.mip_tail_first_lod || bind.subresource.arrayLayer >= layout.array_layers) return;
+    const VkExtent3D mip_extent = GetMipExtent(layout.extent, mip);
+    const VkExtent3D& granularity = layout.granularity;
+    const uint32_t tiles_x = DivideRoundUp(mip_extent.width, granularity.width);
+    const uint32_t tiles_y = DivideRoundUp(mip_extent.height, granularity.height);
+    const uint32_t first_x = static_cast<uint32_t>(bind.offset.x) / granularity.width;
+    const uint32_t first_y = static_cast<uint32_t>(bind.offset.y) / granularity.height;
+    const uint32_t first_z = static_cast<uint32_t>(bind.offset.z) / granularity.depth;
+    const uint32_t count_x = DivideRoundUp(bind.extent.width, granularity.width);
+    const uint32_t count_y = DivideRoundUp(bind.extent.height, granularity.height);
+    const uint32_t count_z = DivideRoundUp(bind.extent.depth, granularity.depth);
+    const VkDeviceSize level_offset = layout.layer_stride * bind.subresource.arrayLayer + layout.mip_offsets[mip];
+    const VkDeviceSize row_size = icd_sparse_page_size * count_x;
+    VkDeviceSize memory_offset = bind.memoryOffset;
+    for (uint32_t z = first_z; z < first_z + count_z; ++z) {
+        for (uint32_t y = first_y; y < first_y + count_y; ++y) {
+            const VkDeviceSize tile_index = (static_cast<VkDeviceSize>(z) * tiles_y + y) * tiles_x + first_x;
+            page_table.Bind(level_offset + tile_index * icd_sparse_page_size, row_size, bind.memory, memory_offset);
+            if (bind.memory != VK_NULL_HANDLE) memory_offset += row_size;
+        }
+    }
+}
+
+// Claims size bytes of a heap's budget. Fails if the heap would exceed its budget.
+static bool ReserveHeapBytes(uint32_t heap_index, VkDeviceSize size) {
+    const VkDeviceSize budget = GetHeapBudget();
+    auto& usage = heap_usage[heap_index];
+    VkDeviceSize used = usage.load(std::memory_order_relaxed);
+    do {
+        if (size > budget || used > budget - size) return false;
+    } while (!usage.compare_exchange_weak(used, used + size, std::memory_order_relaxed));
+    icd_stats.heap_bytes_allocated[heap_index].fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+static void ReleaseHeapBytes(uint32_t heap_index, VkDeviceSize size) {
+    heap_usage[heap_index].fetch_sub(size, std::memory_order_relaxed);
+    icd_stats.heap_bytes_allocated[heap_index].fetch_sub(size, std::memory_order_relaxed);
+}
+
+// Returns the heap bytes and the contents of a device memory allocation
+static void ReleaseDeviceMemory(const DeviceMemoryState& state) {
+    ReleaseHeapBytes(state.heap_index, state.size);
+    if (state.data) {
+        if (state.fd >= 0) {
+            UnmapSharedMemory(state.data, state.size);
+        } else if (state.has_allocator) {
+            state.allocator.pfnFree(state.allocator.pUserData, state.allocation);
+        } else {
+            free(state.allocation);
+        }
+    }
+    if (state.fd >= 0) {
+        CloseFd(state.fd);
+    }
+}
+
+// Objects a device looks up by handle. Devices do not share them, so each device guards its own with its lock and calls
+// on different devices never contend. Buffers and images are looked up on every memory requirements query, so they stay
+// in sharded maps with locks of their own.
+struct DeviceObjects {
+    // Memory the application did not free is released with the device
+    ~DeviceObjects() {
+        for (const auto& pair : memories) ReleaseDeviceMemory(pair.second);
+    }
+
+    mutex_t lock;
+    unordered_map<VkDeviceMemory, DeviceMemoryState> memories;
+    // Ordered by start address for address to (memory, offset) lookups
+    std::map<VkDeviceAddress, DeviceAddressRange> addresses;
+    unordered_map<VkBuffer, BufferBinding> buffer_bindings;
+    unordered_map<VkDeviceMemory, unordered_map<uint64_t, MemoryBinding>> memory_bindings;
+    unordered_map<uint64_t, VkDeviceMemory> resource_memories;
+    // Sparse bindings of buffers and images, keyed by the resource handle
+    unordered_map<uint64_t, SparsePageTable> sparse_page_tables;
+    unordered_map<VkImage, SparseImageLayout> sparse_image_layouts;
+    unordered_map<VkCommandPool, CommandPoolState> command_pools;
+    // Number of descriptor sets allocated from each pool, which are freed implicitly when the pool is reset or destroyed
+    unordered_map<VkDescriptorPool, uint64_t> descriptor_pool_set_counts;
+    unordered_map<VkEvent, std::shared_ptr<EventState>> events;
+    ShardedMap<VkBuffer, BufferState> buffers;
+    ShardedMap<VkImage, ImageState> images;
+    // Only performance query pools are kept, so queries of other types find nothing after a shared lookup
+    ShardedMap<VkQueryPool, std::shared_ptr<PerformanceQueryPool>> performance_query_pools;
+    ShaderCodeCache shader_code;
+    unordered_map<VkDeferredOperationKHR, std::shared_ptr<DeferredOperationState>> deferred_operations;
+    unordered_map<VkSwapchainKHR, std::array<VkImage, icd_swapchain_image_count>> swapchain_images;
+    unordered_map<VkSwapchainKHR, SwapchainPresentState> swapchain_present_states;
+};
+
+static DeviceObjects& GetDeviceObjects(VkDevice device) { return *GetDeviceState(device)->objects; }
+
+// Returns the contents of a device memory allocation, allocating them on first use. Contents are aligned to
+// minMemoryMapAlignment. Must be called with the device's objects locked.
+static uint8_t* GetDeviceMemoryData(DeviceObjects& objects, VkDeviceMemory memory) {
+    static constexpr size_t alignment = 64;
+    const auto it = objects.memories.find(memory);
+    if (it == objects.memories.end()) return nullptr;
+    auto& state = it->second;
+    if (!state.data) {
+        if (state.fd >= 0) {
+            state.data = MapSharedMemory(state.fd, state.size);
+            state.allocation = state.data;
+        } else if (state.has_allocator && state.size <= SIZE_MAX) {
+            state.allocation = state.allocator.pfnAllocation(state.allocator.pUserData, static_cast<size_t>(state.size),
+                                                             alignment, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+            state.data = static_cast<uint8_t*>(state.allocation);
+        } else if (!state.has_allocator && state.size <= SIZE_MAX - alignment) {
+            state.allocation = malloc(static_cast<size_t>(state.size) + alignment - 1);
+            if (state.allocation) {
+                state.data = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(state.allocation) + alignment - 1) & ~(uintptr_t)(alignment - 1));
+            }
+        }
+        if (!state.data) return nullptr;
+        const VkDeviceAddress address = static_cast<VkDeviceAddress>(reinterpret_cast<uintptr_t>(state.data));
+        objects.addresses[address] = {address + state.size, memory};
+    }
+    return state.data;
+}
+
+static bool ResolveDeviceAddress(VkDevice device, VkDeviceAddress address, VkDeviceMemory* pMemory, VkDeviceSize* pOffset) {
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    auto it = objects.addresses.upper_bound(address);
+    if (it == objects.addresses.begin()) return false;
+    --it;
+    if (address >= it->second.end) return false;
+    *pMemory = it->second.memory;
+    *pOffset = address - it->first;
+    return true;
+}
+
+// Must be called with the device's objects locked
+static void RemoveMemoryBinding(DeviceObjects& objects, uint64_t resource) {
+    const auto it = objects.resource_memories.find(resource);
+    if (it == objects.resource_memories.end()) return;
+    objects.memory_bindings[it->second].erase(resource);
+    objects.resource_memories.erase(it);
+}
+
+// Must be called with the device's objects locked
+static void AddMemoryBinding(DeviceObjects& objects, VkDeviceMemory memory, uint64_t resource, const MemoryBinding& binding) {
+    RemoveMemoryBinding(objects, resource);
+    objects.memory_bindings[memory][resource] = binding;
+    objects.resource_memories[resource] = memory;
+}
+
+// Summarizes how the bindings of an allocation cover it. Bindings are swept in offset order while tracking the end of the
+// bytes covered so far: a binding starting past it leaves a free range, one starting before it aliases the binding that
+// reached it.
+static bool GetMemoryBindingReport(VkDevice device, VkDeviceMemory memory, VkmockMemoryBindingReport* pReport) {
+    std::vector<MemoryBinding> bindings;
+    VkDeviceSize size = 0;
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        const auto memory_it = objects.memories.find(memory);
+        if (memory_it == objects.memories.end()) return false;
+        size = memory_it->second.size;
+        const auto it = objects.memory_bindings.find(memory);
+        if (it != objects.memory_bindings.end()) {
+            for (const auto& pair : it->second) bindings.push_back(pair.second);
+        }
+    }
+    std::sort(bindings.begin(), bindings.end(), [](const MemoryBinding& a, const MemoryBinding& b) {
+        return a.offset != b.offset ? a.offset < b.offset : a.size < b.size;
+    });
+    *pReport = VkmockMemoryBindingReport();
+    pReport->size = size;
+    pReport->bindingCount = static_cast<uint32_t>(bindings.size());
+    std::vector<bool> aliased(bindings.size(), false);
+    VkDeviceSize covered_end = 0;
+    size_t covered_end_index = 0;
+    VkDeviceSize aliased_end = 0;
+    for (size_t i = 0; i < bindings.size(); ++i) {
+        const VkDeviceSize begin = (std::min)(bindings[i].offset, size);
+        const VkDeviceSize end = (std::min)(bindings[i].offset + bindings[i].size, size);
+        if (end <= begin) continue;
+        if (i > 0) {
+            const auto& previous = bindings[i - 1];
+            const VkDeviceSize previous_end = previous.offset + previous.size;
+            if (previous.linear != bindings[i].linear && previous.size > 0 && previous_end <= begin &&
+                (previous_end - 1) / icd_buffer_image_granularity == begin / icd_buffer_image_granularity) {
+                ++pReport->granularityConflictCount;
+            }
+        }
+        if (begin > covered_end) {
+            ++pReport->freeRangeCount;
+            pReport->largestFreeRange = (std::max)(pReport->largestFreeRange, begin - covered_end);
+        } else if (begin < covered_end) {
+            aliased[i] = true;
+            aliased[covered_end_index] = true;
+            // Count each aliased byte once, however many bindings share it
+            const VkDeviceSize overlap_begin = (std::max)(begin, aliased_end);
+            const VkDeviceSize overlap_end = (std::min)(end, covered_end);
+            if (overlap_end > overlap_begin) {
+                pReport->aliasedBytes += overlap_end - overlap_begin;
+                aliased_end = overlap_end;
+            }
+        }
+        if (end > covered_end) {
+            pReport->boundBytes += end - (std::max)(begin, covered_end);
+            covered_end = end;
+            covered_end_index = i;
+        }
+    }
+    if (covered_end < size) {
+        ++pReport->freeRangeCount;
+        pReport->largestFreeRange = (std::max)(pReport->largestFreeRange, size - covered_end);
+    }
+    pReport->freeBytes = size - pReport->boundBytes;
+    pReport->aliasedBindingCount = static_cast<uint32_t>(std::count(aliased.begin(), aliased.end(), true));
+    return true;
+}
+
+static const VkAllocationCallbacks* GetCommandPoolAllocator(DeviceObjects& objects, VkCommandPool command_pool) {
+    const auto it = objects.command_pools.find(command_pool);
+    return it != objects.command_pools.end() && it->second.has_allocator ? &it->second.allocator : nullptr;
+}
+
+static std::shared_ptr<EventState> GetEventState(DeviceObjects& objects, VkEvent event) {
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.events.find(event);
+    return it != objects.events.end() ? it->second : nullptr;
+}
+
+static std::shared_ptr<DeferredOperationState> GetDeferredOperationState(VkDevice device, VkDeferredOperationKHR operation) {
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.deferred_operations.find(operation);
+    return it != objects.deferred_operations.end() ? it->second : nullptr;
+}
+
+// Defers chunk_count chunks of work to the operation, or runs them on the calling thread if there is no operation.
+// Returns the result of the command that produced the work.
+static VkResult DeferWork(VkDevice device, VkDeferredOperationKHR operation, uint32_t chunk_count) {
+    const auto state = GetDeferredOperationState(device, operation);
+    if (state) {
+        state->chunk_count = chunk_count;
+        state->next_chunk.store(0, std::memory_order_relaxed);
+        state->finished_chunks.store(0, std::memory_order_relaxed);
+        return VK_OPERATION_DEFERRED_KHR;
+    }
+    for (uint32_t i = 0; i < chunk_count; ++i) {
+        CompilePipelineChunk();
+    }
+    return VK_SUCCESS;
+}
+
+static void RecordQueueCommand(VkCommandBuffer commandBuffer, QueueCommandType type, VkEvent event) {
+    auto* command_buffer_state = GetCommandBufferState(commandBuffer);
+    auto event_state = GetEventState(*command_buffer_state->device->objects, event);
+    if (!event_state) return;
+    command_buffer_state->queue_commands.push_back({type, std::move(event_state)});
+}
+
+static bool ResolveSparseAddress(VkDevice device, uint64_t resource, VkDeviceSize offset, VkDeviceMemory* pMemory,
+                                 VkDeviceSize* pMemoryOffset) {
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.sparse_page_tables.find(resource);
+    return it != objects.sparse_page_tables.end() && it->second.Resolve(offset, pMemory, pMemoryOffset);
+}
+
+static VkDeviceSize GetSparseResidentSize(VkDevice device, uint64_t resource, VkDeviceSize offset, VkDeviceSize size) {
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.sparse_page_tables.find(resource);
+    return it != objects.sparse_page_tables.end() ? it->second.GetResidentSize(offset, size) : 0;
+}
 
 // TODO: Would like to codegen this but limits aren't in XML
 static VkPhysicalDeviceLimits SetLimits(VkPhysicalDeviceLimits *limits) {
@@ -61,7 +2065,7 @@ static VkPhysicalDeviceLimits SetLimits(VkPhysicalDeviceLimits *limits) {
     limits->maxPushConstantsSize = 128;
     limits->maxMemoryAllocationCount = 4096;
     limits->maxSamplerAllocationCount = 4000;
-    limits->bufferImageGranularity = 1;
+    limits->bufferImageGranularity = icd_buffer_image_granularity;
     limits->sparseAddressSpaceSize = 2147483648;
     limits->maxBoundDescriptorSets = 4;
     limits->maxPerStageDescriptorSamplers = 16;
@@ -189,9 +2193,25 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateInstance(
     if (loader_interface_version <= 4) {
         return VK_ERROR_INCOMPATIBLE_DRIVER;
     }
-    *pInstance = (VkInstance)CreateDispObjHandle();
-    for (auto& physical_device : physical_device_map[*pInstance])
-        physical_device = (VkPhysicalDevice)CreateDispObjHandle();
+    auto* state = NewObjectState<InstanceState>(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (!state) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    *pInstance = (VkInstance)CreateDispObjHandle(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE, nullptr, state);
+    if (!*pInstance) {
+        DeleteObjectState(state, pAllocator);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    TrackObjects(VK_OBJECT_TYPE_INSTANCE, 1);
+    for (uint32_t i = 0; i < icd_physical_device_count; ++i) {
+        auto& physical_device = state->physical_devices[i];
+        physical_device = (VkPhysicalDevice)CreateDispObjHandle(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE, nullptr,
+                                                                &state->physical_device_states[i]);
+        if (!physical_device) {
+            DestroyInstance(*pInstance, pAllocator);
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
     // TODO: If emulating specific device caps, will need to add intelligence here
     return VK_SUCCESS;
 }
@@ -202,10 +2222,15 @@ static VKAPI_ATTR void VKAPI_CALL DestroyInstance(
 {
 
     if (instance) {
-        for (const auto physical_device : physical_device_map.at(instance))
-            DestroyDispObjHandle((void*)physical_device);
-        physical_device_map.erase(instance);
-        DestroyDispObjHandle((void*)instance);
+        auto* state = GetInstanceState(instance);
+        for (const auto physical_device : state->physical_devices) {
+            DestroyDispObjHandle((void*)physical_device, pAllocator, nullptr);
+        }
+        DeleteObjectState(state, pAllocator);
+        DestroyDispObjHandle((void*)instance, pAllocator, nullptr);
+        TrackObjects(VK_OBJECT_TYPE_INSTANCE, -1);
+        // Whatever outlives the last instance has leaked
+        if (icd_stats.objects_alive[VK_OBJECT_TYPE_INSTANCE].load(std::memory_order_relaxed) == 0) WriteLeakReport();
     }
 }
 
@@ -214,10 +2239,14 @@ static VKAPI_ATTR VkResult VKAPI_CALL EnumeratePhysicalDevices(
     uint32_t*                                   pPhysicalDeviceCount,
     VkPhysicalDevice*                           pPhysicalDevices)
 {
+    if (const auto hook = GetHook<PFN_vkEnumeratePhysicalDevices>(kHookEnumeratePhysicalDevices)) {
+        const HookScope scope;
+        return hook(instance, pPhysicalDeviceCount, pPhysicalDevices);
+    }
     VkResult result_code = VK_SUCCESS;
     if (pPhysicalDevices) {
         const auto return_count = (std::min)(*pPhysicalDeviceCount, icd_physical_device_count);
-        for (uint32_t i = 0; i < return_count; ++i) pPhysicalDevices[i] = physical_device_map.at(instance)[i];
+        for (uint32_t i = 0; i < return_count; ++i) pPhysicalDevices[i] = GetInstanceState(instance)->physical_devices[i];
         if (return_count < icd_physical_device_count) result_code = VK_INCOMPLETE;
         *pPhysicalDeviceCount = return_count;
     } else {
@@ -230,6 +2259,10 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFeatures(
     VkPhysicalDevice                            physicalDevice,
     VkPhysicalDeviceFeatures*                   pFeatures)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceFeatures>(kHookGetPhysicalDeviceFeatures)) {
+        const HookScope scope;
+        return hook(physicalDevice, pFeatures);
+    }
     uint32_t num_bools = sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32);
     VkBool32 *bool_array = &pFeatures->robustBufferAccess;
     SetBoolArrayTrue(bool_array, num_bools);
@@ -240,6 +2273,10 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFormatProperties(
     VkFormat                                    format,
     VkFormatProperties*                         pFormatProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceFormatProperties>(kHookGetPhysicalDeviceFormatProperties)) {
+        const HookScope scope;
+        return hook(physicalDevice, format, pFormatProperties);
+    }
     if (VK_FORMAT_UNDEFINED == format) {
         *pFormatProperties = { 0x0, 0x0, 0x0 };
     } else {
@@ -271,6 +2308,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceImageFormatProperties(
     VkImageCreateFlags                          flags,
     VkImageFormatProperties*                    pImageFormatProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceImageFormatProperties>(kHookGetPhysicalDeviceImageFormatProperties)) {
+        const HookScope scope;
+        return hook(physicalDevice, format, type, tiling, usage, flags, pImageFormatProperties);
+    }
     // A hardcoded unsupported format
     if (format == VK_FORMAT_E5B9G9R9_UFLOAT_PACK32) {
         return VK_ERROR_FORMAT_NOT_SUPPORTED;
@@ -291,6 +2332,10 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceProperties(
     VkPhysicalDevice                            physicalDevice,
     VkPhysicalDeviceProperties*                 pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceProperties>(kHookGetPhysicalDeviceProperties)) {
+        const HookScope scope;
+        return hook(physicalDevice, pProperties);
+    }
     // TODO: Just hard-coding some values for now
     pProperties->apiVersion = kSupportedVulkanAPIVersion;
     pProperties->driverVersion = 1;
@@ -309,12 +2354,16 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyProperties(
     uint32_t*                                   pQueueFamilyPropertyCount,
     VkQueueFamilyProperties*                    pQueueFamilyProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceQueueFamilyProperties>(kHookGetPhysicalDeviceQueueFamilyProperties)) {
+        const HookScope scope;
+        return hook(physicalDevice, pQueueFamilyPropertyCount, pQueueFamilyProperties);
+    }
     if (!pQueueFamilyProperties) {
         *pQueueFamilyPropertyCount = 1;
     } else {
         if (*pQueueFamilyPropertyCount) {
             pQueueFamilyProperties[0].queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT | VK_QUEUE_SPARSE_BINDING_BIT;
-            pQueueFamilyProperties[0].queueCount = 1;
+            pQueueFamilyProperties[0].queueCount = icd_queue_count;
             pQueueFamilyProperties[0].timestampValidBits = 0;
             pQueueFamilyProperties[0].minImageTransferGranularity = {1,1,1};
         }
@@ -325,16 +2374,24 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMemoryProperties(
     VkPhysicalDevice                            physicalDevice,
     VkPhysicalDeviceMemoryProperties*           pMemoryProperties)
 {
-    pMemoryProperties->memoryTypeCount = 2;
-    pMemoryProperties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    pMemoryProperties->memoryTypes[0].heapIndex = 0;
-    pMemoryProperties->memoryTypes[1].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    pMemoryProperties->memoryTypes[1].heapIndex = 1;
-    pMemoryProperties->memoryHeapCount = 2;
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceMemoryProperties>(kHookGetPhysicalDeviceMemoryProperties)) {
+        const HookScope scope;
+        return hook(physicalDevice, pMemoryProperties);
+    }
+    pMemoryProperties->memoryTypeCount = 4;
+    pMemoryProperties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    pMemoryProperties->memoryTypes[0].heapIndex = 1;
+    pMemoryProperties->memoryTypes[1].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    pMemoryProperties->memoryTypes[1].heapIndex = 0;
+    pMemoryProperties->memoryTypes[2].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+    pMemoryProperties->memoryTypes[2].heapIndex = 0;
+    pMemoryProperties->memoryTypes[3].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    pMemoryProperties->memoryTypes[3].heapIndex = 1;
+    pMemoryProperties->memoryHeapCount = icd_memory_heap_count;
     pMemoryProperties->memoryHeaps[0].flags = 0;
-    pMemoryProperties->memoryHeaps[0].size = 8000000000;
+    pMemoryProperties->memoryHeaps[0].size = icd_memory_heap_size;
     pMemoryProperties->memoryHeaps[1].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
-    pMemoryProperties->memoryHeaps[1].size = 8000000000;
+    pMemoryProperties->memoryHeaps[1].size = icd_memory_heap_size;
 }
 
 static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(
@@ -368,7 +2425,44 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(
     VkDevice*                                   pDevice)
 {
 
-    *pDevice = (VkDevice)CreateDispObjHandle();
+    auto* state = NewObjectState<DeviceState>(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+    if (!state) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    state->objects = NewObjectState<DeviceObjects>(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+    if (!state->objects) {
+        DeleteObjectState(state, pAllocator);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    auto* physical_device_state = GetPhysicalDeviceState(physicalDevice);
+    state->handle_space.ordinal =
+        GetDeviceHandleSpaceOrdinal(physical_device_state->handle_space.ordinal,
+                                    physical_device_state->device_count.fetch_add(1, std::memory_order_relaxed));
+    *pDevice = (VkDevice)CreateDispObjHandle(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE, nullptr, state);
+    if (!*pDevice) {
+        DeleteObjectState(state->objects, pAllocator);
+        DeleteObjectState(state, pAllocator);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    TrackObjects(VK_OBJECT_TYPE_DEVICE, 1);
+    AddLiveObject("VkDevice", (uint64_t)*pDevice);
+    if (pAllocator) {
+        state->has_allocator = true;
+        state->allocator = *pAllocator;
+    } else {
+        state->arena.reset(new DeviceArena(sizeof(DispatchableObject)));
+    }
+    state->timeline = &physical_device_state->timeline;
+    auto& priorities = state->queue_priorities;
+    for (uint32_t i = 0; i < pCreateInfo->queueCreateInfoCount; ++i) {
+        const auto& queue_info = pCreateInfo->pQueueCreateInfos[i];
+        const auto* global_priority_info = lvl_find_in_chain<VkDeviceQueueGlobalPriorityCreateInfoKHR>(queue_info.pNext);
+        const uint32_t global_priority =
+            GetGlobalPriorityRank(global_priority_info ? global_priority_info->globalPriority : VK_QUEUE_GLOBAL_PRIORITY_MEDIUM_KHR);
+        for (uint32_t j = 0; j < queue_info.queueCount; ++j) {
+            priorities[queue_info.queueFamilyIndex][j] = {global_priority, queue_info.pQueuePriorities[j]};
+        }
+    }
     // TODO: If emulating specific device caps, will need to add intelligence here
     return VK_SUCCESS;
 }
@@ -378,20 +2472,24 @@ static VKAPI_ATTR void VKAPI_CALL DestroyDevice(
     const VkAllocationCallbacks*                pAllocator)
 {
 
-    unique_lock_t lock(global_lock);
+    auto* state = GetDeviceState(device);
+    if (!state) return;
     // First destroy sub-device objects
-    // Destroy Queues
-    for (auto queue_family_map_pair : queue_map[device]) {
-        for (auto index_queue_pair : queue_map[device][queue_family_map_pair.first]) {
-            DestroyDispObjHandle((void*)index_queue_pair.second);
+    // Destroy Queues, which stops their workers
+    const auto* allocator = GetChildAllocator(device, pAllocator);
+    for (const auto& family : state->queues) {
+        for (const auto& index_queue_pair : family.second) {
+            DeleteObjectState(GetQueueState(index_queue_pair.second), allocator);
+            DestroyDispObjHandle((void*)index_queue_pair.second, allocator, state->arena.get());
         }
     }
 
-    queue_map.erase(device);
-    buffer_map.erase(device);
-    image_memory_size_map.erase(device);
+    DeleteObjectState(state->objects, pAllocator);
+    DeleteObjectState(state, pAllocator);
     // Now destroy device
-    DestroyDispObjHandle((void*)device);
+    DestroyDispObjHandle((void*)device, pAllocator, nullptr);
+    TrackObjects(VK_OBJECT_TYPE_DEVICE, -1);
+    RemoveLiveObject((uint64_t)device);
     // TODO: If emulating specific device caps, will need to add intelligence here
 }
 
@@ -479,13 +2577,31 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceQueue(
     uint32_t                                    queueIndex,
     VkQueue*                                    pQueue)
 {
-    unique_lock_t lock(global_lock);
-    auto queue = queue_map[device][queueFamilyIndex][queueIndex];
-    if (queue) {
-        *pQueue = queue;
-    } else {
-        *pQueue = queue_map[device][queueFamilyIndex][queueIndex] = (VkQueue)CreateDispObjHandle();
+    if (const auto hook = GetHook<PFN_vkGetDeviceQueue>(kHookGetDeviceQueue)) {
+        const HookScope scope;
+        return hook(device, queueFamilyIndex, queueIndex, pQueue);
     }
+    auto* state = GetDeviceState(device);
+    lock_guard_t lock(state->queue_lock);
+    auto& queue = state->queues[queueFamilyIndex][queueIndex];
+    if (!queue) {
+        // Queues missing from the create info run at the default priorities
+        QueuePriority priority = {GetGlobalPriorityRank(VK_QUEUE_GLOBAL_PRIORITY_MEDIUM_KHR), 1.0f};
+        const auto family = state->queue_priorities.find(queueFamilyIndex);
+        if (family != state->queue_priorities.end()) {
+            const auto it = family->second.find(queueIndex);
+            if (it != family->second.end()) priority = it->second;
+        }
+        const auto* allocator = GetChildAllocator(device, nullptr);
+        auto* queue_state = NewObjectState<QueueState>(allocator, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+        if (queue_state) {
+            queue_state->device = state;
+            queue_state->schedule = {state->timeline, priority, AllocateQueueOrdinal()};
+            queue = (VkQueue)CreateDispObjHandle(allocator, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE, state->arena.get(), queue_state);
+            if (!queue) DeleteObjectState(queue_state, allocator);
+        }
+    }
+    *pQueue = queue;
     // TODO: If emulating specific device caps, will need to add intelligence here
     return;
 }
@@ -496,21 +2612,56 @@ static VKAPI_ATTR VkResult VKAPI_CALL QueueSubmit(
     const VkSubmitInfo*                         pSubmits,
     VkFence                                     fence)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkQueueSubmit>(kHookQueueSubmit)) {
+        const HookScope scope;
+        return hook(queue, submitCount, pSubmits, fence);
+    }
+    // Semaphores only have an effect with external payloads: a wait blocks the queue until the payload is signaled,
+    // possibly by another process, and a signal releases one waiter.
+    std::vector<QueueBatch> batches(submitCount);
+    for (uint32_t i = 0; i < submitCount; ++i) {
+        const auto& submit = pSubmits[i];
+        batches[i].wait_semaphores.assign(submit.pWaitSemaphores, submit.pWaitSemaphores + submit.waitSemaphoreCount);
+        for (uint32_t j = 0; j < submit.commandBufferCount; ++j) {
+            AppendQueueCommands(batches[i], submit.pCommandBuffers[j]);
+        }
+        batches[i].signal_semaphores.assign(submit.pSignalSemaphores, submit.pSignalSemaphores + submit.signalSemaphoreCount);
+    }
+    SubmitToQueue(queue, batches, fence);
     return VK_SUCCESS;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL QueueWaitIdle(
     VkQueue                                     queue)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkQueueWaitIdle>(kHookQueueWaitIdle)) {
+        const HookScope scope;
+        return hook(queue);
+    }
+    WaitQueueIdle(queue);
     return VK_SUCCESS;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL DeviceWaitIdle(
     VkDevice                                    device)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkDeviceWaitIdle>(kHookDeviceWaitIdle)) {
+        const HookScope scope;
+        return hook(device);
+    }
+    auto* state = GetDeviceState(device);
+    std::vector<VkQueue> queues;
+    {
+        lock_guard_t lock(state->queue_lock);
+        for (const auto& family : state->queues) {
+            for (const auto& index_queue_pair : family.second) {
+                queues.push_back(index_queue_pair.second);
+            }
+        }
+    }
+    for (const auto queue : queues) {
+        WaitQueueIdle(queue);
+    }
     return VK_SUCCESS;
 }
 
@@ -520,9 +2671,45 @@ static VKAPI_ATTR VkResult VKAPI_CALL AllocateMemory(
     const VkAllocationCallbacks*                pAllocator,
     VkDeviceMemory*                             pMemory)
 {
-    unique_lock_t lock(global_lock);
-    allocated_memory_size_map[(VkDeviceMemory)global_unique_handle] = pAllocateInfo->allocationSize;
-    *pMemory = (VkDeviceMemory)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkAllocateMemory>(kHookAllocateMemory)) {
+        const HookScope scope;
+        return hook(device, pAllocateInfo, pAllocator, pMemory);
+    }
+    const uint32_t heap_index = GetMemoryTypeHeapIndex(pAllocateInfo->memoryTypeIndex);
+    if (heap_index >= icd_memory_heap_count) {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    const VkDeviceSize size = pAllocateInfo->allocationSize;
+    if (!ReserveHeapBytes(heap_index, size)) {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    int fd = -1;
+    const auto *import_info = lvl_find_in_chain<VkImportMemoryFdInfoKHR>(pAllocateInfo->pNext);
+    const auto *export_info = lvl_find_in_chain<VkExportMemoryAllocateInfo>(pAllocateInfo->pNext);
+    const VkExternalMemoryHandleTypeFlags fd_handle_types =
+        VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT | VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+    if (import_info && (import_info->handleType & fd_handle_types)) {
+        // The imported file must hold the whole allocation. A successful import takes ownership of the descriptor.
+        if (import_info->fd < 0 || GetSharedMemoryFdSize(import_info->fd) < size) {
+            ReleaseHeapBytes(heap_index, size);
+            return VK_ERROR_INVALID_EXTERNAL_HANDLE;
+        }
+        fd = import_info->fd;
+    } else if (export_info && (export_info->handleTypes & fd_handle_types)) {
+        fd = CreateSharedMemoryFd("vkmock_device_memory", size);
+        if (fd < 0) {
+            ReleaseHeapBytes(heap_index, size);
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        }
+    }
+    *pMemory = (VkDeviceMemory)NewHandle(device, VK_OBJECT_TYPE_DEVICE_MEMORY);
+    TrackObjects(VK_OBJECT_TYPE_DEVICE_MEMORY, 1);
+    AddLiveObject("VkDeviceMemory", (uint64_t)*pMemory, size);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto* allocator = GetChildAllocator(device, pAllocator);
+    objects.memories[*pMemory] = {size, heap_index, nullptr, nullptr, fd, allocator != nullptr,
+                                  allocator ? *allocator : VkAllocationCallbacks()};
     return VK_SUCCESS;
 }
 
@@ -531,8 +2718,29 @@ static VKAPI_ATTR void VKAPI_CALL FreeMemory(
     VkDeviceMemory                              memory,
     const VkAllocationCallbacks*                pAllocator)
 {
-//Destroy object
-    allocated_memory_size_map.erase(memory);
+    if (const auto hook = GetHook<PFN_vkFreeMemory>(kHookFreeMemory)) {
+        const HookScope scope;
+        return hook(device, memory, pAllocator);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.memories.find(memory);
+    if (it != objects.memories.end()) {
+        const auto& state = it->second;
+        TrackObjects(VK_OBJECT_TYPE_DEVICE_MEMORY, -1);
+        RemoveLiveObject((uint64_t)memory);
+        if (state.data) {
+            objects.addresses.erase(static_cast<VkDeviceAddress>(reinterpret_cast<uintptr_t>(state.data)));
+        }
+        ReleaseDeviceMemory(state);
+        // Resources bound to the memory outlive it, unbound
+        const auto binding_it = objects.memory_bindings.find(memory);
+        if (binding_it != objects.memory_bindings.end()) {
+            for (const auto& pair : binding_it->second) objects.resource_memories.erase(pair.first);
+            objects.memory_bindings.erase(binding_it);
+        }
+        objects.memories.erase(it);
+    }
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL MapMemory(
@@ -543,16 +2751,18 @@ static VKAPI_ATTR VkResult VKAPI_CALL MapMemory(
     VkMemoryMapFlags                            flags,
     void**                                      ppData)
 {
-    unique_lock_t lock(global_lock);
-    if (VK_WHOLE_SIZE == size) {
-        if (allocated_memory_size_map.count(memory) != 0)
-            size = allocated_memory_size_map[memory] - offset;
-        else
-            size = 0x10000;
+    if (const auto hook = GetHook<PFN_vkMapMemory>(kHookMapMemory)) {
+        const HookScope scope;
+        return hook(device, memory, offset, size, flags, ppData);
     }
-    void* map_addr = malloc((size_t)size);
-    mapped_memory_map[memory].push_back(map_addr);
-    *ppData = map_addr;
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    // Mapping exposes the memory contents themselves, so writes through the mapping are seen at the device address
+    uint8_t* data = GetDeviceMemoryData(objects, memory);
+    if (!data) {
+        return VK_ERROR_MEMORY_MAP_FAILED;
+    }
+    *ppData = data + offset;
     return VK_SUCCESS;
 }
 
@@ -560,11 +2770,11 @@ static VKAPI_ATTR void VKAPI_CALL UnmapMemory(
     VkDevice                                    device,
     VkDeviceMemory                              memory)
 {
-    unique_lock_t lock(global_lock);
-    for (auto map_addr : mapped_memory_map[memory]) {
-        free(map_addr);
+    if (const auto hook = GetHook<PFN_vkUnmapMemory>(kHookUnmapMemory)) {
+        const HookScope scope;
+        return hook(device, memory);
     }
-    mapped_memory_map.erase(memory);
+    // Contents stay allocated until the memory is freed
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL FlushMappedMemoryRanges(
@@ -572,6 +2782,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL FlushMappedMemoryRanges(
     uint32_t                                    memoryRangeCount,
     const VkMappedMemoryRange*                  pMemoryRanges)
 {
+    if (const auto hook = GetHook<PFN_vkFlushMappedMemoryRanges>(kHookFlushMappedMemoryRanges)) {
+        const HookScope scope;
+        return hook(device, memoryRangeCount, pMemoryRanges);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -581,6 +2795,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL InvalidateMappedMemoryRanges(
     uint32_t                                    memoryRangeCount,
     const VkMappedMemoryRange*                  pMemoryRanges)
 {
+    if (const auto hook = GetHook<PFN_vkInvalidateMappedMemoryRanges>(kHookInvalidateMappedMemoryRanges)) {
+        const HookScope scope;
+        return hook(device, memoryRangeCount, pMemoryRanges);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -590,6 +2808,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceMemoryCommitment(
     VkDeviceMemory                              memory,
     VkDeviceSize*                               pCommittedMemoryInBytes)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceMemoryCommitment>(kHookGetDeviceMemoryCommitment)) {
+        const HookScope scope;
+        return hook(device, memory, pCommittedMemoryInBytes);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -599,7 +2821,16 @@ static VKAPI_ATTR VkResult VKAPI_CALL BindBufferMemory(
     VkDeviceMemory                              memory,
     VkDeviceSize                                memoryOffset)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkBindBufferMemory>(kHookBindBufferMemory)) {
+        const HookScope scope;
+        return hook(device, buffer, memory, memoryOffset);
+    }
+    VkMemoryRequirements requirements;
+    CallInternal(GetBufferMemoryRequirements, device, buffer, &requirements);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.buffer_bindings[buffer] = {memory, memoryOffset};
+    AddMemoryBinding(objects, memory, (uint64_t)buffer, {memoryOffset, requirements.size, true});
     return VK_SUCCESS;
 }
 
@@ -609,7 +2840,17 @@ static VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory(
     VkDeviceMemory                              memory,
     VkDeviceSize                                memoryOffset)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkBindImageMemory>(kHookBindImageMemory)) {
+        const HookScope scope;
+        return hook(device, image, memory, memoryOffset);
+    }
+    VkMemoryRequirements requirements;
+    CallInternal(GetImageMemoryRequirements, device, image, &requirements);
+    auto& objects = GetDeviceObjects(device);
+    ImageState state;
+    const bool linear = objects.images.Find(image, &state) && state.linear;
+    unique_lock_t lock(objects.lock);
+    AddMemoryBinding(objects, memory, (uint64_t)image, {memoryOffset, requirements.size, linear});
     return VK_SUCCESS;
 }
 
@@ -618,17 +2859,22 @@ static VKAPI_ATTR void VKAPI_CALL GetBufferMemoryRequirements(
     VkBuffer                                    buffer,
     VkMemoryRequirements*                       pMemoryRequirements)
 {
-    // TODO: Just hard-coding reqs for now
+    if (const auto hook = GetHook<PFN_vkGetBufferMemoryRequirements>(kHookGetBufferMemoryRequirements)) {
+        const HookScope scope;
+        return hook(device, buffer, pMemoryRequirements);
+    }
     pMemoryRequirements->size = 4096;
-    pMemoryRequirements->alignment = 1;
-    pMemoryRequirements->memoryTypeBits = 0xFFFF;
-    // Return a better size based on the buffer size from the create info.
-    auto d_iter = buffer_map.find(device);
-    if (d_iter != buffer_map.end()) {
-        auto iter = d_iter->second.find(buffer);
-        if (iter != d_iter->second.end()) {
-            pMemoryRequirements->size = ((iter->second.size + 4095) / 4096) * 4096;
+    pMemoryRequirements->alignment = GetBufferAlignment(0);
+    pMemoryRequirements->memoryTypeBits = icd_buffer_memory_types;
+    BufferState state;
+    if (GetDeviceObjects(device).buffers.Find(buffer, &state)) {
+        VkDeviceSize alignment = GetBufferAlignment(state.usage);
+        if (state.flags & VK_BUFFER_CREATE_SPARSE_BINDING_BIT) {
+            alignment = icd_sparse_page_size;
+            pMemoryRequirements->memoryTypeBits = icd_device_local_memory_types;
         }
+        pMemoryRequirements->size = ((state.size + alignment - 1) / alignment) * alignment;
+        pMemoryRequirements->alignment = alignment;
     }
 }
 
@@ -637,18 +2883,21 @@ static VKAPI_ATTR void VKAPI_CALL GetImageMemoryRequirements(
     VkImage                                     image,
     VkMemoryRequirements*                       pMemoryRequirements)
 {
+    if (const auto hook = GetHook<PFN_vkGetImageMemoryRequirements>(kHookGetImageMemoryRequirements)) {
+        const HookScope scope;
+        return hook(device, image, pMemoryRequirements);
+    }
     pMemoryRequirements->size = 0;
     pMemoryRequirements->alignment = 1;
-
-    auto d_iter = image_memory_size_map.find(device);
-    if(d_iter != image_memory_size_map.end()){
-        auto iter = d_iter->second.find(image);
-        if (iter != d_iter->second.end()) {
-            pMemoryRequirements->size = iter->second;
-        }
+    pMemoryRequirements->memoryTypeBits = icd_device_local_memory_types;
+
+    ImageState state;
+    if (GetDeviceObjects(device).images.Find(image, &state)) {
+        const VkDeviceSize alignment = GetImageAlignment(state);
+        pMemoryRequirements->size = ((state.memory_size + alignment - 1) / alignment) * alignment;
+        pMemoryRequirements->alignment = alignment;
+        if (state.linear && !state.sparse) pMemoryRequirements->memoryTypeBits = icd_linear_image_memory_types;
     }
-    // Here we hard-code that the memory type at index 3 doesn't support this image.
-    pMemoryRequirements->memoryTypeBits = 0xFFFF & ~(0x1 << 3);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetImageSparseMemoryRequirements(
@@ -657,7 +2906,33 @@ static VKAPI_ATTR void VKAPI_CALL GetImageSparseMemoryRequirements(
     uint32_t*                                   pSparseMemoryRequirementCount,
     VkSparseImageMemoryRequirements*            pSparseMemoryRequirements)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetImageSparseMemoryRequirements>(kHookGetImageSparseMemoryRequirements)) {
+        const HookScope scope;
+        return hook(device, image, pSparseMemoryRequirementCount, pSparseMemoryRequirements);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.sparse_image_layouts.find(image);
+    if (it == objects.sparse_image_layouts.end()) {
+        *pSparseMemoryRequirementCount = 0;
+        return;
+    }
+    if (!pSparseMemoryRequirements) {
+        *pSparseMemoryRequirementCount = 1;
+        return;
+    }
+    if (*pSparseMemoryRequirementCount == 0) {
+        return;
+    }
+    const auto& layout = it->second;
+    pSparseMemoryRequirements[0].formatProperties.aspectMask = layout.aspect_mask;
+    pSparseMemoryRequirements[0].formatProperties.imageGranularity = layout.granularity;
+    pSparseMemoryRequirements[0].formatProperties.flags = 0;
+    pSparseMemoryRequirements[0].imageMipTailFirstLod = layout.mip_tail_first_lod;
+    pSparseMemoryRequirements[0].imageMipTailSize = layout.mip_tail_size;
+    pSparseMemoryRequirements[0].imageMipTailOffset = layout.mip_tail_offset;
+    pSparseMemoryRequirements[0].imageMipTailStride = layout.layer_stride;
+    *pSparseMemoryRequirementCount = 1;
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceSparseImageFormatProperties(
@@ -670,7 +2945,26 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceSparseImageFormatProperties(
     uint32_t*                                   pPropertyCount,
     VkSparseImageFormatProperties*              pProperties)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSparseImageFormatProperties>(kHookGetPhysicalDeviceSparseImageFormatProperties)) {
+        const HookScope scope;
+        return hook(physicalDevice, format, type, samples, usage, tiling, pPropertyCount, pProperties);
+    }
+    // Sparse residency is supported for single-sampled, optimally tiled images of every format
+    if (tiling != VK_IMAGE_TILING_OPTIMAL || samples != VK_SAMPLE_COUNT_1_BIT) {
+        *pPropertyCount = 0;
+        return;
+    }
+    if (!pProperties) {
+        *pPropertyCount = 1;
+        return;
+    }
+    if (*pPropertyCount == 0) {
+        return;
+    }
+    pProperties[0].aspectMask = GetSparseAspectMask(format);
+    pProperties[0].imageGranularity = GetSparseImageGranularity(type);
+    pProperties[0].flags = 0;
+    *pPropertyCount = 1;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL QueueBindSparse(
@@ -679,7 +2973,42 @@ static VKAPI_ATTR VkResult VKAPI_CALL QueueBindSparse(
     const VkBindSparseInfo*                     pBindInfo,
     VkFence                                     fence)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkQueueBindSparse>(kHookQueueBindSparse)) {
+        const HookScope scope;
+        return hook(queue, bindInfoCount, pBindInfo, fence);
+    }
+    auto& objects = *GetQueueState(queue)->device->objects;
+    unique_lock_t lock(objects.lock);
+    for (uint32_t i = 0; i < bindInfoCount; ++i) {
+        const auto& bind_info = pBindInfo[i];
+        for (uint32_t j = 0; j < bind_info.bufferBindCount; ++j) {
+            const auto& buffer_bind = bind_info.pBufferBinds[j];
+            auto& page_table = objects.sparse_page_tables[(uint64_t)buffer_bind.buffer];
+            for (uint32_t k = 0; k < buffer_bind.bindCount; ++k) {
+                const auto& bind = buffer_bind.pBinds[k];
+                page_table.Bind(bind.resourceOffset, bind.size, bind.memory, bind.memoryOffset);
+            }
+        }
+        for (uint32_t j = 0; j < bind_info.imageOpaqueBindCount; ++j) {
+            const auto& opaque_bind = bind_info.pImageOpaqueBinds[j];
+            auto& page_table = objects.sparse_page_tables[(uint64_t)opaque_bind.image];
+            for (uint32_t k = 0; k < opaque_bind.bindCount; ++k) {
+                const auto& bind = opaque_bind.pBinds[k];
+                // No metadata aspect is reported, so metadata binds have nothing to back
+                if (bind.flags & VK_SPARSE_MEMORY_BIND_METADATA_BIT) continue;
+                page_table.Bind(bind.resourceOffset, bind.size, bind.memory, bind.memoryOffset);
+            }
+        }
+        for (uint32_t j = 0; j < bind_info.imageBindCount; ++j) {
+            const auto& image_bind = bind_info.pImageBinds[j];
+            const auto layout = objects.sparse_image_layouts.find(image_bind.image);
+            if (layout == objects.sparse_image_layouts.end()) continue;
+            auto& page_table = objects.sparse_page_tables[(uint64_t)image_bind.image];
+            for (uint32_t k = 0; k < image_bind.bindCount; ++k) {
+                BindSparseImageTiles(page_table, layout->second, image_bind.pBinds[k]);
+            }
+        }
+    }
     return VK_SUCCESS;
 }
 
@@ -689,8 +3018,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateFence(
     const VkAllocationCallbacks*                pAllocator,
     VkFence*                                    pFence)
 {
-    unique_lock_t lock(global_lock);
-    *pFence = (VkFence)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateFence>(kHookCreateFence)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pFence);
+    }
+    *pFence = (VkFence)NewHandle(device, VK_OBJECT_TYPE_FENCE);
+    TrackObjects(VK_OBJECT_TYPE_FENCE, 1);
+    AddLiveObject("VkFence", (uint64_t)*pFence);
     return VK_SUCCESS;
 }
 
@@ -699,7 +3033,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyFence(
     VkFence                                     fence,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyFence>(kHookDestroyFence)) {
+        const HookScope scope;
+        return hook(device, fence, pAllocator);
+    }
 //Destroy object
+    if (fence != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_FENCE, -1);
+    RemoveLiveObject((uint64_t)fence);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL ResetFences(
@@ -707,6 +3047,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL ResetFences(
     uint32_t                                    fenceCount,
     const VkFence*                              pFences)
 {
+    if (const auto hook = GetHook<PFN_vkResetFences>(kHookResetFences)) {
+        const HookScope scope;
+        return hook(device, fenceCount, pFences);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -715,8 +3059,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetFenceStatus(
     VkDevice                                    device,
     VkFence                                     fence)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetFenceStatus>(kHookGetFenceStatus)) {
+        const HookScope scope;
+        return hook(device, fence);
+    }
+    auto* state = GetDeviceState(device);
+    lock_guard_t lock(state->sync_lock);
+    return state->pending_fences.count(fence) ? VK_NOT_READY : VK_SUCCESS;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL WaitForFences(
@@ -726,8 +3075,25 @@ static VKAPI_ATTR VkResult VKAPI_CALL WaitForFences(
     VkBool32                                    waitAll,
     uint64_t                                    timeout)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkWaitForFences>(kHookWaitForFences)) {
+        const HookScope scope;
+        return hook(device, fenceCount, pFences, waitAll, timeout);
+    }
+    auto* state = GetDeviceState(device);
+    unique_lock_t lock(state->sync_lock);
+    const auto signaled = [&]() {
+        uint32_t signaled_count = 0;
+        for (uint32_t i = 0; i < fenceCount; ++i) {
+            if (!state->pending_fences.count(pFences[i])) ++signaled_count;
+        }
+        return waitAll ? signaled_count == fenceCount : signaled_count > 0;
+    };
+    if (timeout == UINT64_MAX) {
+        state->fence_cv.wait(lock, signaled);
+        return VK_SUCCESS;
+    }
+    const auto wait_time = std::chrono::nanoseconds(static_cast<int64_t>((std::min)(timeout, static_cast<uint64_t>(INT64_MAX / 2))));
+    return state->fence_cv.wait_for(lock, wait_time, signaled) ? VK_SUCCESS : VK_TIMEOUT;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateSemaphore(
@@ -736,8 +3102,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateSemaphore(
     const VkAllocationCallbacks*                pAllocator,
     VkSemaphore*                                pSemaphore)
 {
-    unique_lock_t lock(global_lock);
-    *pSemaphore = (VkSemaphore)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateSemaphore>(kHookCreateSemaphore)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pSemaphore);
+    }
+    *pSemaphore = (VkSemaphore)NewHandle(device, VK_OBJECT_TYPE_SEMAPHORE);
+    TrackObjects(VK_OBJECT_TYPE_SEMAPHORE, 1);
+    AddLiveObject("VkSemaphore", (uint64_t)*pSemaphore);
     return VK_SUCCESS;
 }
 
@@ -746,7 +3117,20 @@ static VKAPI_ATTR void VKAPI_CALL DestroySemaphore(
     VkSemaphore                                 semaphore,
     const VkAllocationCallbacks*                pAllocator)
 {
-//Destroy object
+    if (const auto hook = GetHook<PFN_vkDestroySemaphore>(kHookDestroySemaphore)) {
+        const HookScope scope;
+        return hook(device, semaphore, pAllocator);
+    }
+    auto* state = GetDeviceState(device);
+    lock_guard_t lock(state->sync_lock);
+    const auto it = state->semaphore_fds.find(semaphore);
+    if (it != state->semaphore_fds.end()) {
+        if (it->second.permanent_fd >= 0) CloseFd(it->second.permanent_fd);
+        if (it->second.temporary_fd >= 0) CloseFd(it->second.temporary_fd);
+        state->semaphore_fds.erase(it);
+    }
+    if (semaphore != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_SEMAPHORE, -1);
+    RemoveLiveObject((uint64_t)semaphore);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateEvent(
@@ -755,8 +3139,16 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateEvent(
     const VkAllocationCallbacks*                pAllocator,
     VkEvent*                                    pEvent)
 {
-    unique_lock_t lock(global_lock);
-    *pEvent = (VkEvent)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateEvent>(kHookCreateEvent)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pEvent);
+    }
+    *pEvent = (VkEvent)NewHandle(device, VK_OBJECT_TYPE_EVENT);
+    TrackObjects(VK_OBJECT_TYPE_EVENT, 1);
+    AddLiveObject("VkEvent", (uint64_t)*pEvent);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.events[*pEvent] = std::make_shared<EventState>(false);
     return VK_SUCCESS;
 }
 
@@ -765,22 +3157,40 @@ static VKAPI_ATTR void VKAPI_CALL DestroyEvent(
     VkEvent                                     event,
     const VkAllocationCallbacks*                pAllocator)
 {
-//Destroy object
+    if (const auto hook = GetHook<PFN_vkDestroyEvent>(kHookDestroyEvent)) {
+        const HookScope scope;
+        return hook(device, event, pAllocator);
+    }
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        objects.events.erase(event);
+    }
+    if (event != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_EVENT, -1);
+    RemoveLiveObject((uint64_t)event);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetEventStatus(
     VkDevice                                    device,
     VkEvent                                     event)
 {
-//Not a CREATE or DESTROY function
-    return VK_EVENT_SET;
+    if (const auto hook = GetHook<PFN_vkGetEventStatus>(kHookGetEventStatus)) {
+        const HookScope scope;
+        return hook(device, event);
+    }
+    const auto state = GetEventState(GetDeviceObjects(device), event);
+    return (state && state->signaled.load(std::memory_order_acquire)) ? VK_EVENT_SET : VK_EVENT_RESET;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL SetEvent(
     VkDevice                                    device,
     VkEvent                                     event)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkSetEvent>(kHookSetEvent)) {
+        const HookScope scope;
+        return hook(device, event);
+    }
+    SetEventState(GetEventState(GetDeviceObjects(device), event).get(), true);
     return VK_SUCCESS;
 }
 
@@ -788,7 +3198,11 @@ static VKAPI_ATTR VkResult VKAPI_CALL ResetEvent(
     VkDevice                                    device,
     VkEvent                                     event)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkResetEvent>(kHookResetEvent)) {
+        const HookScope scope;
+        return hook(device, event);
+    }
+    SetEventState(GetEventState(GetDeviceObjects(device), event).get(), false);
     return VK_SUCCESS;
 }
 
@@ -798,8 +3212,21 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateQueryPool(
     const VkAllocationCallbacks*                pAllocator,
     VkQueryPool*                                pQueryPool)
 {
-    unique_lock_t lock(global_lock);
-    *pQueryPool = (VkQueryPool)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateQueryPool>(kHookCreateQueryPool)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pQueryPool);
+    }
+    *pQueryPool = (VkQueryPool)NewHandle(device, VK_OBJECT_TYPE_QUERY_POOL);
+    TrackObjects(VK_OBJECT_TYPE_QUERY_POOL, 1);
+    AddLiveObject("VkQueryPool", (uint64_t)*pQueryPool);
+    const auto *performance_info = lvl_find_in_chain<VkQueryPoolPerformanceCreateInfoKHR>(pCreateInfo->pNext);
+    if (pCreateInfo->queryType == VK_QUERY_TYPE_PERFORMANCE_QUERY_KHR && performance_info) {
+        auto pool = std::make_shared<PerformanceQueryPool>();
+        pool->counter_indices.assign(performance_info->pCounterIndices, performance_info->pCounterIndices + performance_info->counterIndexCount);
+        pool->results.resize(size_t(pCreateInfo->queryCount) * performance_info->counterIndexCount);
+        pool->available.resize(pCreateInfo->queryCount);
+        GetDeviceObjects(device).performance_query_pools.Insert(*pQueryPool, pool);
+    }
     return VK_SUCCESS;
 }
 
@@ -808,7 +3235,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyQueryPool(
     VkQueryPool                                 queryPool,
     const VkAllocationCallbacks*                pAllocator)
 {
-//Destroy object
+    if (const auto hook = GetHook<PFN_vkDestroyQueryPool>(kHookDestroyQueryPool)) {
+        const HookScope scope;
+        return hook(device, queryPool, pAllocator);
+    }
+    GetDeviceObjects(device).performance_query_pools.Erase(queryPool);
+    if (queryPool != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_QUERY_POOL, -1);
+    RemoveLiveObject((uint64_t)queryPool);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetQueryPoolResults(
@@ -821,8 +3254,32 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetQueryPoolResults(
     VkDeviceSize                                stride,
     VkQueryResultFlags                          flags)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetQueryPoolResults>(kHookGetQueryPoolResults)) {
+        const HookScope scope;
+        return hook(device, queryPool, firstQuery, queryCount, dataSize, pData, stride, flags);
+    }
+    std::shared_ptr<PerformanceQueryPool> pool_state;
+    if (!GetDeviceObjects(device).performance_query_pools.Find(queryPool, &pool_state)) return VK_SUCCESS;
+    auto& pool = *pool_state;
+    std::unique_lock<std::mutex> lock(pool.lock);
+    const size_t counter_count = pool.counter_indices.size();
+    const size_t result_size = counter_count * sizeof(VkPerformanceCounterResultKHR);
+    VkResult result = VK_SUCCESS;
+    for (uint32_t i = 0; i < queryCount && firstQuery + i < pool.available.size(); ++i) {
+        const uint32_t query = firstQuery + i;
+        if (i * stride + result_size > dataSize) break;
+        if (flags & VK_QUERY_RESULT_WAIT_BIT) {
+            pool.available_cv.wait(lock, [&] { return pool.available[query]; });
+        } else if (!pool.available[query]) {
+            result = VK_NOT_READY;
+            continue;
+        }
+        auto* results = reinterpret_cast<VkPerformanceCounterResultKHR*>(static_cast<uint8_t*>(pData) + i * stride);
+        for (size_t j = 0; j < counter_count; ++j) {
+            results[j].uint64 = pool.results[query * counter_count + j];
+        }
+    }
+    return result;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateBuffer(
@@ -831,9 +3288,14 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateBuffer(
     const VkAllocationCallbacks*                pAllocator,
     VkBuffer*                                   pBuffer)
 {
-    unique_lock_t lock(global_lock);
-    *pBuffer = (VkBuffer)global_unique_handle++;
-    buffer_map[device][*pBuffer] = *pCreateInfo;
+    if (const auto hook = GetHook<PFN_vkCreateBuffer>(kHookCreateBuffer)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pBuffer);
+    }
+    *pBuffer = (VkBuffer)NewHandle(device, VK_OBJECT_TYPE_BUFFER);
+    TrackObjects(VK_OBJECT_TYPE_BUFFER, 1);
+    AddLiveObject("VkBuffer", (uint64_t)*pBuffer);
+    GetDeviceObjects(device).buffers.Insert(*pBuffer, {pCreateInfo->size, pCreateInfo->flags, pCreateInfo->usage});
     return VK_SUCCESS;
 }
 
@@ -842,8 +3304,20 @@ static VKAPI_ATTR void VKAPI_CALL DestroyBuffer(
     VkBuffer                                    buffer,
     const VkAllocationCallbacks*                pAllocator)
 {
-    unique_lock_t lock(global_lock);
-    buffer_map[device].erase(buffer);
+    if (const auto hook = GetHook<PFN_vkDestroyBuffer>(kHookDestroyBuffer)) {
+        const HookScope scope;
+        return hook(device, buffer, pAllocator);
+    }
+    auto& objects = GetDeviceObjects(device);
+    objects.buffers.Erase(buffer);
+    {
+        unique_lock_t lock(objects.lock);
+        objects.buffer_bindings.erase(buffer);
+        RemoveMemoryBinding(objects, (uint64_t)buffer);
+        objects.sparse_page_tables.erase((uint64_t)buffer);
+    }
+    if (buffer != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_BUFFER, -1);
+    RemoveLiveObject((uint64_t)buffer);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateBufferView(
@@ -852,8 +3326,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateBufferView(
     const VkAllocationCallbacks*                pAllocator,
     VkBufferView*                               pView)
 {
-    unique_lock_t lock(global_lock);
-    *pView = (VkBufferView)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateBufferView>(kHookCreateBufferView)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pView);
+    }
+    *pView = (VkBufferView)NewHandle(device, VK_OBJECT_TYPE_BUFFER_VIEW);
+    TrackObjects(VK_OBJECT_TYPE_BUFFER_VIEW, 1);
+    AddLiveObject("VkBufferView", (uint64_t)*pView);
     return VK_SUCCESS;
 }
 
@@ -862,7 +3341,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyBufferView(
     VkBufferView                                bufferView,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyBufferView>(kHookDestroyBufferView)) {
+        const HookScope scope;
+        return hook(device, bufferView, pAllocator);
+    }
 //Destroy object
+    if (bufferView != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_BUFFER_VIEW, -1);
+    RemoveLiveObject((uint64_t)bufferView);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateImage(
@@ -871,11 +3356,16 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateImage(
     const VkAllocationCallbacks*                pAllocator,
     VkImage*                                    pImage)
 {
-    unique_lock_t lock(global_lock);
-    *pImage = (VkImage)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateImage>(kHookCreateImage)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pImage);
+    }
+    *pImage = (VkImage)NewHandle(device, VK_OBJECT_TYPE_IMAGE);
+    TrackObjects(VK_OBJECT_TYPE_IMAGE, 1);
+    AddLiveObject("VkImage", (uint64_t)*pImage);
     // TODO: A pixel size is 32 bytes. This accounts for the largest possible pixel size of any format. It could be changed to more accurate size if need be.
-    image_memory_size_map[device][*pImage] = pCreateInfo->extent.width * pCreateInfo->extent.height * pCreateInfo->extent.depth *
-                                             32 * pCreateInfo->arrayLayers * (pCreateInfo->mipLevels > 1 ? 2 : 1);
+    VkDeviceSize memory_size = pCreateInfo->extent.width * pCreateInfo->extent.height * pCreateInfo->extent.depth *
+                               32 * pCreateInfo->arrayLayers * (pCreateInfo->mipLevels > 1 ? 2 : 1);
     // plane count
     switch (pCreateInfo->format) {
         case VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM:
@@ -890,7 +3380,7 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateImage(
         case VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM:
         case VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM:
         case VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM:
-            image_memory_size_map[device][*pImage] *= 3;
+            memory_size *= 3;
             break;
         case VK_FORMAT_G8_B8R8_2PLANE_420_UNORM:
         case VK_FORMAT_G8_B8R8_2PLANE_422_UNORM:
@@ -900,11 +3390,19 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateImage(
         case VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16:
         case VK_FORMAT_G16_B16R16_2PLANE_420_UNORM:
         case VK_FORMAT_G16_B16R16_2PLANE_422_UNORM:
-            image_memory_size_map[device][*pImage] *= 2;
+            memory_size *= 2;
             break;
         default:
             break;
     }
+    const bool sparse = (pCreateInfo->flags & VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT) != 0;
+    auto& objects = GetDeviceObjects(device);
+    if (sparse) {
+        unique_lock_t lock(objects.lock);
+        const auto& layout = objects.sparse_image_layouts[*pImage] = CreateSparseImageLayout(pCreateInfo);
+        memory_size = layout.layer_stride * layout.array_layers;
+    }
+    objects.images.Insert(*pImage, {memory_size, sparse, pCreateInfo->tiling == VK_IMAGE_TILING_LINEAR});
     return VK_SUCCESS;
 }
 
@@ -913,8 +3411,20 @@ static VKAPI_ATTR void VKAPI_CALL DestroyImage(
     VkImage                                     image,
     const VkAllocationCallbacks*                pAllocator)
 {
-    unique_lock_t lock(global_lock);
-    image_memory_size_map[device].erase(image);
+    if (const auto hook = GetHook<PFN_vkDestroyImage>(kHookDestroyImage)) {
+        const HookScope scope;
+        return hook(device, image, pAllocator);
+    }
+    auto& objects = GetDeviceObjects(device);
+    objects.images.Erase(image);
+    {
+        unique_lock_t lock(objects.lock);
+        RemoveMemoryBinding(objects, (uint64_t)image);
+        objects.sparse_image_layouts.erase(image);
+        objects.sparse_page_tables.erase((uint64_t)image);
+    }
+    if (image != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_IMAGE, -1);
+    RemoveLiveObject((uint64_t)image);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetImageSubresourceLayout(
@@ -923,6 +3433,10 @@ static VKAPI_ATTR void VKAPI_CALL GetImageSubresourceLayout(
     const VkImageSubresource*                   pSubresource,
     VkSubresourceLayout*                        pLayout)
 {
+    if (const auto hook = GetHook<PFN_vkGetImageSubresourceLayout>(kHookGetImageSubresourceLayout)) {
+        const HookScope scope;
+        return hook(device, image, pSubresource, pLayout);
+    }
     // Need safe values. Callers are computing memory offsets from pLayout, with no return code to flag failure.
     *pLayout = VkSubresourceLayout(); // Default constructor zero values.
 }
@@ -933,8 +3447,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateImageView(
     const VkAllocationCallbacks*                pAllocator,
     VkImageView*                                pView)
 {
-    unique_lock_t lock(global_lock);
-    *pView = (VkImageView)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateImageView>(kHookCreateImageView)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pView);
+    }
+    *pView = (VkImageView)NewHandle(device, VK_OBJECT_TYPE_IMAGE_VIEW);
+    TrackObjects(VK_OBJECT_TYPE_IMAGE_VIEW, 1);
+    AddLiveObject("VkImageView", (uint64_t)*pView);
     return VK_SUCCESS;
 }
 
@@ -943,7 +3462,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyImageView(
     VkImageView                                 imageView,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyImageView>(kHookDestroyImageView)) {
+        const HookScope scope;
+        return hook(device, imageView, pAllocator);
+    }
 //Destroy object
+    if (imageView != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_IMAGE_VIEW, -1);
+    RemoveLiveObject((uint64_t)imageView);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateShaderModule(
@@ -952,8 +3477,19 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateShaderModule(
     const VkAllocationCallbacks*                pAllocator,
     VkShaderModule*                             pShaderModule)
 {
-    unique_lock_t lock(global_lock);
-    *pShaderModule = (VkShaderModule)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateShaderModule>(kHookCreateShaderModule)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pShaderModule);
+    }
+    // Hash before taking the lock, it is the expensive part
+    const uint64_t hash = HashShaderCode(pCreateInfo->pCode, pCreateInfo->codeSize);
+    *pShaderModule = (VkShaderModule)NewHandle(device, VK_OBJECT_TYPE_SHADER_MODULE);
+    TrackObjects(VK_OBJECT_TYPE_SHADER_MODULE, 1);
+    AddLiveObject("VkShaderModule", (uint64_t)*pShaderModule);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.shader_code.modules[*pShaderModule] =
+        AcquireShaderCode(objects.shader_code, hash, pCreateInfo->pCode, pCreateInfo->codeSize);
     return VK_SUCCESS;
 }
 
@@ -962,7 +3498,19 @@ static VKAPI_ATTR void VKAPI_CALL DestroyShaderModule(
     VkShaderModule                              shaderModule,
     const VkAllocationCallbacks*                pAllocator)
 {
-//Destroy object
+    if (const auto hook = GetHook<PFN_vkDestroyShaderModule>(kHookDestroyShaderModule)) {
+        const HookScope scope;
+        return hook(device, shaderModule, pAllocator);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.shader_code.modules.find(shaderModule);
+    if (it != objects.shader_code.modules.end()) {
+        ReleaseShaderCode(objects.shader_code, it->second);
+        objects.shader_code.modules.erase(it);
+    }
+    if (shaderModule != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_SHADER_MODULE, -1);
+    RemoveLiveObject((uint64_t)shaderModule);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineCache(
@@ -971,8 +3519,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineCache(
     const VkAllocationCallbacks*                pAllocator,
     VkPipelineCache*                            pPipelineCache)
 {
-    unique_lock_t lock(global_lock);
-    *pPipelineCache = (VkPipelineCache)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreatePipelineCache>(kHookCreatePipelineCache)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pPipelineCache);
+    }
+    *pPipelineCache = (VkPipelineCache)NewHandle(device, VK_OBJECT_TYPE_PIPELINE_CACHE);
+    TrackObjects(VK_OBJECT_TYPE_PIPELINE_CACHE, 1);
+    AddLiveObject("VkPipelineCache", (uint64_t)*pPipelineCache);
     return VK_SUCCESS;
 }
 
@@ -981,7 +3534,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyPipelineCache(
     VkPipelineCache                             pipelineCache,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyPipelineCache>(kHookDestroyPipelineCache)) {
+        const HookScope scope;
+        return hook(device, pipelineCache, pAllocator);
+    }
 //Destroy object
+    if (pipelineCache != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_PIPELINE_CACHE, -1);
+    RemoveLiveObject((uint64_t)pipelineCache);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetPipelineCacheData(
@@ -990,6 +3549,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPipelineCacheData(
     size_t*                                     pDataSize,
     void*                                       pData)
 {
+    if (const auto hook = GetHook<PFN_vkGetPipelineCacheData>(kHookGetPipelineCacheData)) {
+        const HookScope scope;
+        return hook(device, pipelineCache, pDataSize, pData);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -1000,6 +3563,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL MergePipelineCaches(
     uint32_t                                    srcCacheCount,
     const VkPipelineCache*                      pSrcCaches)
 {
+    if (const auto hook = GetHook<PFN_vkMergePipelineCaches>(kHookMergePipelineCaches)) {
+        const HookScope scope;
+        return hook(device, dstCache, srcCacheCount, pSrcCaches);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -1012,11 +3579,24 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateGraphicsPipelines(
     const VkAllocationCallbacks*                pAllocator,
     VkPipeline*                                 pPipelines)
 {
-    unique_lock_t lock(global_lock);
+    if (const auto hook = GetHook<PFN_vkCreateGraphicsPipelines>(kHookCreateGraphicsPipelines)) {
+        const HookScope scope;
+        return hook(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
+    }
     for (uint32_t i = 0; i < createInfoCount; ++i) {
-        pPipelines[i] = (VkPipeline)global_unique_handle++;
+        pPipelines[i] = (VkPipeline)NewHandle(device, VK_OBJECT_TYPE_PIPELINE);
+        AddLiveObject("VkPipeline", (uint64_t)pPipelines[i]);
     }
-    return VK_SUCCESS;
+    TrackObjects(VK_OBJECT_TYPE_PIPELINE, createInfoCount);
+    uint32_t compile_count = 0;
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        for (uint32_t i = 0; i < createInfoCount; ++i) {
+            if (CompileShaderStages(objects.shader_code, pCreateInfos[i].stageCount, pCreateInfos[i].pStages)) ++compile_count;
+        }
+    }
+    return DeferWork(device, VK_NULL_HANDLE, compile_count * icd_pipeline_compile_chunks);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateComputePipelines(
@@ -1027,11 +3607,24 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateComputePipelines(
     const VkAllocationCallbacks*                pAllocator,
     VkPipeline*                                 pPipelines)
 {
-    unique_lock_t lock(global_lock);
+    if (const auto hook = GetHook<PFN_vkCreateComputePipelines>(kHookCreateComputePipelines)) {
+        const HookScope scope;
+        return hook(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
+    }
     for (uint32_t i = 0; i < createInfoCount; ++i) {
-        pPipelines[i] = (VkPipeline)global_unique_handle++;
+        pPipelines[i] = (VkPipeline)NewHandle(device, VK_OBJECT_TYPE_PIPELINE);
+        AddLiveObject("VkPipeline", (uint64_t)pPipelines[i]);
     }
-    return VK_SUCCESS;
+    TrackObjects(VK_OBJECT_TYPE_PIPELINE, createInfoCount);
+    uint32_t compile_count = 0;
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        for (uint32_t i = 0; i < createInfoCount; ++i) {
+            if (CompileShaderStages(objects.shader_code, 1, &pCreateInfos[i].stage)) ++compile_count;
+        }
+    }
+    return DeferWork(device, VK_NULL_HANDLE, compile_count * icd_pipeline_compile_chunks);
 }
 
 static VKAPI_ATTR void VKAPI_CALL DestroyPipeline(
@@ -1039,7 +3632,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyPipeline(
     VkPipeline                                  pipeline,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyPipeline>(kHookDestroyPipeline)) {
+        const HookScope scope;
+        return hook(device, pipeline, pAllocator);
+    }
 //Destroy object
+    if (pipeline != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_PIPELINE, -1);
+    RemoveLiveObject((uint64_t)pipeline);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineLayout(
@@ -1048,8 +3647,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineLayout(
     const VkAllocationCallbacks*                pAllocator,
     VkPipelineLayout*                           pPipelineLayout)
 {
-    unique_lock_t lock(global_lock);
-    *pPipelineLayout = (VkPipelineLayout)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreatePipelineLayout>(kHookCreatePipelineLayout)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pPipelineLayout);
+    }
+    *pPipelineLayout = (VkPipelineLayout)NewHandle(device, VK_OBJECT_TYPE_PIPELINE_LAYOUT);
+    TrackObjects(VK_OBJECT_TYPE_PIPELINE_LAYOUT, 1);
+    AddLiveObject("VkPipelineLayout", (uint64_t)*pPipelineLayout);
     return VK_SUCCESS;
 }
 
@@ -1058,7 +3662,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyPipelineLayout(
     VkPipelineLayout                            pipelineLayout,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyPipelineLayout>(kHookDestroyPipelineLayout)) {
+        const HookScope scope;
+        return hook(device, pipelineLayout, pAllocator);
+    }
 //Destroy object
+    if (pipelineLayout != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_PIPELINE_LAYOUT, -1);
+    RemoveLiveObject((uint64_t)pipelineLayout);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateSampler(
@@ -1067,8 +3677,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateSampler(
     const VkAllocationCallbacks*                pAllocator,
     VkSampler*                                  pSampler)
 {
-    unique_lock_t lock(global_lock);
-    *pSampler = (VkSampler)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateSampler>(kHookCreateSampler)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pSampler);
+    }
+    *pSampler = (VkSampler)NewHandle(device, VK_OBJECT_TYPE_SAMPLER);
+    TrackObjects(VK_OBJECT_TYPE_SAMPLER, 1);
+    AddLiveObject("VkSampler", (uint64_t)*pSampler);
     return VK_SUCCESS;
 }
 
@@ -1077,7 +3692,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroySampler(
     VkSampler                                   sampler,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroySampler>(kHookDestroySampler)) {
+        const HookScope scope;
+        return hook(device, sampler, pAllocator);
+    }
 //Destroy object
+    if (sampler != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_SAMPLER, -1);
+    RemoveLiveObject((uint64_t)sampler);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorSetLayout(
@@ -1086,8 +3707,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorSetLayout(
     const VkAllocationCallbacks*                pAllocator,
     VkDescriptorSetLayout*                      pSetLayout)
 {
-    unique_lock_t lock(global_lock);
-    *pSetLayout = (VkDescriptorSetLayout)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateDescriptorSetLayout>(kHookCreateDescriptorSetLayout)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pSetLayout);
+    }
+    *pSetLayout = (VkDescriptorSetLayout)NewHandle(device, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+    TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, 1);
+    AddLiveObject("VkDescriptorSetLayout", (uint64_t)*pSetLayout);
     return VK_SUCCESS;
 }
 
@@ -1096,7 +3722,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyDescriptorSetLayout(
     VkDescriptorSetLayout                       descriptorSetLayout,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyDescriptorSetLayout>(kHookDestroyDescriptorSetLayout)) {
+        const HookScope scope;
+        return hook(device, descriptorSetLayout, pAllocator);
+    }
 //Destroy object
+    if (descriptorSetLayout != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, -1);
+    RemoveLiveObject((uint64_t)descriptorSetLayout);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorPool(
@@ -1105,8 +3737,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorPool(
     const VkAllocationCallbacks*                pAllocator,
     VkDescriptorPool*                           pDescriptorPool)
 {
-    unique_lock_t lock(global_lock);
-    *pDescriptorPool = (VkDescriptorPool)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateDescriptorPool>(kHookCreateDescriptorPool)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pDescriptorPool);
+    }
+    *pDescriptorPool = (VkDescriptorPool)NewHandle(device, VK_OBJECT_TYPE_DESCRIPTOR_POOL);
+    TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_POOL, 1);
+    AddLiveObject("VkDescriptorPool", (uint64_t)*pDescriptorPool);
     return VK_SUCCESS;
 }
 
@@ -1115,7 +3752,20 @@ static VKAPI_ATTR void VKAPI_CALL DestroyDescriptorPool(
     VkDescriptorPool                            descriptorPool,
     const VkAllocationCallbacks*                pAllocator)
 {
-//Destroy object
+    if (const auto hook = GetHook<PFN_vkDestroyDescriptorPool>(kHookDestroyDescriptorPool)) {
+        const HookScope scope;
+        return hook(device, descriptorPool, pAllocator);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.descriptor_pool_set_counts.find(descriptorPool);
+    if (it != objects.descriptor_pool_set_counts.end()) {
+        TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_SET, -static_cast<int64_t>(it->second));
+        objects.descriptor_pool_set_counts.erase(it);
+    }
+    RemoveLiveObjectsOf((uint64_t)descriptorPool);
+    if (descriptorPool != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_POOL, -1);
+    RemoveLiveObject((uint64_t)descriptorPool);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL ResetDescriptorPool(
@@ -1123,7 +3773,18 @@ static VKAPI_ATTR VkResult VKAPI_CALL ResetDescriptorPool(
     VkDescriptorPool                            descriptorPool,
     VkDescriptorPoolResetFlags                  flags)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkResetDescriptorPool>(kHookResetDescriptorPool)) {
+        const HookScope scope;
+        return hook(device, descriptorPool, flags);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.descriptor_pool_set_counts.find(descriptorPool);
+    if (it != objects.descriptor_pool_set_counts.end()) {
+        TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_SET, -static_cast<int64_t>(it->second));
+        it->second = 0;
+    }
+    RemoveLiveObjectsOf((uint64_t)descriptorPool);
     return VK_SUCCESS;
 }
 
@@ -1132,10 +3793,18 @@ static VKAPI_ATTR VkResult VKAPI_CALL AllocateDescriptorSets(
     const VkDescriptorSetAllocateInfo*          pAllocateInfo,
     VkDescriptorSet*                            pDescriptorSets)
 {
-    unique_lock_t lock(global_lock);
+    if (const auto hook = GetHook<PFN_vkAllocateDescriptorSets>(kHookAllocateDescriptorSets)) {
+        const HookScope scope;
+        return hook(device, pAllocateInfo, pDescriptorSets);
+    }
     for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; ++i) {
-        pDescriptorSets[i] = (VkDescriptorSet)global_unique_handle++;
+        pDescriptorSets[i] = (VkDescriptorSet)NewHandle(device, VK_OBJECT_TYPE_DESCRIPTOR_SET);
+        AddLiveObject("VkDescriptorSet", (uint64_t)pDescriptorSets[i], 0, (uint64_t)pAllocateInfo->descriptorPool);
     }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.descriptor_pool_set_counts[pAllocateInfo->descriptorPool] += pAllocateInfo->descriptorSetCount;
+    TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_SET, pAllocateInfo->descriptorSetCount);
     return VK_SUCCESS;
 }
 
@@ -1145,7 +3814,21 @@ static VKAPI_ATTR VkResult VKAPI_CALL FreeDescriptorSets(
     uint32_t                                    descriptorSetCount,
     const VkDescriptorSet*                      pDescriptorSets)
 {
-//Destroy object
+    if (const auto hook = GetHook<PFN_vkFreeDescriptorSets>(kHookFreeDescriptorSets)) {
+        const HookScope scope;
+        return hook(device, descriptorPool, descriptorSetCount, pDescriptorSets);
+    }
+    uint64_t freed_count = 0;
+    for (uint32_t i = 0; i < descriptorSetCount; ++i) {
+        if (pDescriptorSets[i] != VK_NULL_HANDLE) ++freed_count;
+        RemoveLiveObject((uint64_t)pDescriptorSets[i]);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    auto& pool_set_count = objects.descriptor_pool_set_counts[descriptorPool];
+    freed_count = (std::min)(freed_count, pool_set_count);
+    pool_set_count -= freed_count;
+    TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_SET, -static_cast<int64_t>(freed_count));
     return VK_SUCCESS;
 }
 
@@ -1156,6 +3839,10 @@ static VKAPI_ATTR void VKAPI_CALL UpdateDescriptorSets(
     uint32_t                                    descriptorCopyCount,
     const VkCopyDescriptorSet*                  pDescriptorCopies)
 {
+    if (const auto hook = GetHook<PFN_vkUpdateDescriptorSets>(kHookUpdateDescriptorSets)) {
+        const HookScope scope;
+        return hook(device, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -1165,8 +3852,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateFramebuffer(
     const VkAllocationCallbacks*                pAllocator,
     VkFramebuffer*                              pFramebuffer)
 {
-    unique_lock_t lock(global_lock);
-    *pFramebuffer = (VkFramebuffer)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateFramebuffer>(kHookCreateFramebuffer)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pFramebuffer);
+    }
+    *pFramebuffer = (VkFramebuffer)NewHandle(device, VK_OBJECT_TYPE_FRAMEBUFFER);
+    TrackObjects(VK_OBJECT_TYPE_FRAMEBUFFER, 1);
+    AddLiveObject("VkFramebuffer", (uint64_t)*pFramebuffer);
     return VK_SUCCESS;
 }
 
@@ -1175,7 +3867,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyFramebuffer(
     VkFramebuffer                               framebuffer,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyFramebuffer>(kHookDestroyFramebuffer)) {
+        const HookScope scope;
+        return hook(device, framebuffer, pAllocator);
+    }
 //Destroy object
+    if (framebuffer != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_FRAMEBUFFER, -1);
+    RemoveLiveObject((uint64_t)framebuffer);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(
@@ -1184,8 +3882,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(
     const VkAllocationCallbacks*                pAllocator,
     VkRenderPass*                               pRenderPass)
 {
-    unique_lock_t lock(global_lock);
-    *pRenderPass = (VkRenderPass)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateRenderPass>(kHookCreateRenderPass)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pRenderPass);
+    }
+    *pRenderPass = (VkRenderPass)NewHandle(device, VK_OBJECT_TYPE_RENDER_PASS);
+    TrackObjects(VK_OBJECT_TYPE_RENDER_PASS, 1);
+    AddLiveObject("VkRenderPass", (uint64_t)*pRenderPass);
     return VK_SUCCESS;
 }
 
@@ -1194,7 +3897,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyRenderPass(
     VkRenderPass                                renderPass,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyRenderPass>(kHookDestroyRenderPass)) {
+        const HookScope scope;
+        return hook(device, renderPass, pAllocator);
+    }
 //Destroy object
+    if (renderPass != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_RENDER_PASS, -1);
+    RemoveLiveObject((uint64_t)renderPass);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetRenderAreaGranularity(
@@ -1202,6 +3911,10 @@ static VKAPI_ATTR void VKAPI_CALL GetRenderAreaGranularity(
     VkRenderPass                                renderPass,
     VkExtent2D*                                 pGranularity)
 {
+    if (const auto hook = GetHook<PFN_vkGetRenderAreaGranularity>(kHookGetRenderAreaGranularity)) {
+        const HookScope scope;
+        return hook(device, renderPass, pGranularity);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -1211,8 +3924,22 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPool(
     const VkAllocationCallbacks*                pAllocator,
     VkCommandPool*                              pCommandPool)
 {
-    unique_lock_t lock(global_lock);
-    *pCommandPool = (VkCommandPool)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateCommandPool>(kHookCreateCommandPool)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pCommandPool);
+    }
+    *pCommandPool = (VkCommandPool)NewHandle(device, VK_OBJECT_TYPE_COMMAND_POOL);
+    TrackObjects(VK_OBJECT_TYPE_COMMAND_POOL, 1);
+    AddLiveObject("VkCommandPool", (uint64_t)*pCommandPool);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    auto& pool = objects.command_pools[*pCommandPool];
+    const auto* allocator = GetChildAllocator(device, pAllocator);
+    if (allocator) {
+        pool.has_allocator = true;
+        pool.allocator = *allocator;
+    }
+    pool.arena.reset(new CommandArena(allocator));
     return VK_SUCCESS;
 }
 
@@ -1221,16 +3948,28 @@ static VKAPI_ATTR void VKAPI_CALL DestroyCommandPool(
     VkCommandPool                               commandPool,
     const VkAllocationCallbacks*                pAllocator)
 {
-
+    if (const auto hook = GetHook<PFN_vkDestroyCommandPool>(kHookDestroyCommandPool)) {
+        const HookScope scope;
+        return hook(device, commandPool, pAllocator);
+    }
     // destroy command buffers for this pool
-    unique_lock_t lock(global_lock);
-    auto it = command_pool_buffer_map.find(commandPool);
-    if (it != command_pool_buffer_map.end()) {
-        for (auto& cb : it->second) {
-            DestroyDispObjHandle((void*) cb);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto* allocator = GetCommandPoolAllocator(objects, commandPool);
+    auto* arena = GetDeviceArena(device);
+    auto it = objects.command_pools.find(commandPool);
+    if (it != objects.command_pools.end()) {
+        const auto& command_buffers = it->second.command_buffers;
+        for (auto& cb : command_buffers) {
+            DestroyCommandBufferState(cb, allocator);
+            DestroyDispObjHandle((void*) cb, allocator, arena);
+            RemoveLiveObject((uint64_t)cb);
         }
-        command_pool_buffer_map.erase(it);
+        TrackObjects(VK_OBJECT_TYPE_COMMAND_BUFFER, -static_cast<int64_t>(command_buffers.size()));
+        objects.command_pools.erase(it);
     }
+    if (commandPool != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_COMMAND_POOL, -1);
+    RemoveLiveObject((uint64_t)commandPool);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL ResetCommandPool(
@@ -1238,7 +3977,19 @@ static VKAPI_ATTR VkResult VKAPI_CALL ResetCommandPool(
     VkCommandPool                               commandPool,
     VkCommandPoolResetFlags                     flags)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkResetCommandPool>(kHookResetCommandPool)) {
+        const HookScope scope;
+        return hook(device, commandPool, flags);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.command_pools.find(commandPool);
+    if (it != objects.command_pools.end()) {
+        for (const auto command_buffer : it->second.command_buffers) {
+            ResetCommandBufferState(*GetCommandBufferState(command_buffer));
+        }
+        if (flags & VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT) it->second.arena->Release();
+    }
     return VK_SUCCESS;
 }
 
@@ -1247,11 +3998,34 @@ static VKAPI_ATTR VkResult VKAPI_CALL AllocateCommandBuffers(
     const VkCommandBufferAllocateInfo*          pAllocateInfo,
     VkCommandBuffer*                            pCommandBuffers)
 {
-
-    unique_lock_t lock(global_lock);
+    if (const auto hook = GetHook<PFN_vkAllocateCommandBuffers>(kHookAllocateCommandBuffers)) {
+        const HookScope scope;
+        return hook(device, pAllocateInfo, pCommandBuffers);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto* allocator = GetCommandPoolAllocator(objects, pAllocateInfo->commandPool);
+    auto* arena = GetDeviceArena(device);
+    const auto pool_it = objects.command_pools.find(pAllocateInfo->commandPool);
     for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; ++i) {
-        pCommandBuffers[i] = (VkCommandBuffer)CreateDispObjHandle();
-        command_pool_buffer_map[pAllocateInfo->commandPool].push_back(pCommandBuffers[i]);
+        auto* state = NewObjectState<CommandBufferState>(allocator, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+        pCommandBuffers[i] = state ? (VkCommandBuffer)CreateDispObjHandle(allocator, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT,
+                                                                          arena, state)
+                                   : VK_NULL_HANDLE;
+        if (!pCommandBuffers[i]) {
+            DeleteObjectState(state, allocator);
+            lock.unlock();
+            CallInternal(FreeCommandBuffers, device, pAllocateInfo->commandPool, i, pCommandBuffers);
+            for (uint32_t j = 0; j < pAllocateInfo->commandBufferCount; ++j) pCommandBuffers[j] = VK_NULL_HANDLE;
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+        TrackObjects(VK_OBJECT_TYPE_COMMAND_BUFFER, 1);
+        AddLiveObject("VkCommandBuffer", (uint64_t)pCommandBuffers[i]);
+        state->device = GetDeviceState(device);
+        if (pool_it != objects.command_pools.end()) {
+            pool_it->second.command_buffers.push_back(pCommandBuffers[i]);
+            state->stream.arena = pool_it->second.arena.get();
+        }
     }
     return VK_SUCCESS;
 }
@@ -1262,22 +4036,32 @@ static VKAPI_ATTR void VKAPI_CALL FreeCommandBuffers(
     uint32_t                                    commandBufferCount,
     const VkCommandBuffer*                      pCommandBuffers)
 {
-
-    unique_lock_t lock(global_lock);
+    if (const auto hook = GetHook<PFN_vkFreeCommandBuffers>(kHookFreeCommandBuffers)) {
+        const HookScope scope;
+        return hook(device, commandPool, commandBufferCount, pCommandBuffers);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto* allocator = GetCommandPoolAllocator(objects, commandPool);
+    auto* arena = GetDeviceArena(device);
+    const auto pool_it = objects.command_pools.find(commandPool);
     for (auto i = 0u; i < commandBufferCount; ++i) {
         if (!pCommandBuffers[i]) {
             continue;
         }
 
-        for (auto& pair : command_pool_buffer_map) {
-            auto& cbs = pair.second;
+        if (pool_it != objects.command_pools.end()) {
+            auto& cbs = pool_it->second.command_buffers;
             auto it = std::find(cbs.begin(), cbs.end(), pCommandBuffers[i]);
             if (it != cbs.end()) {
                 cbs.erase(it);
             }
         }
-            
-        DestroyDispObjHandle((void*) pCommandBuffers[i]);
+        DestroyCommandBufferState(pCommandBuffers[i], allocator);
+
+        DestroyDispObjHandle((void*) pCommandBuffers[i], allocator, arena);
+        TrackObjects(VK_OBJECT_TYPE_COMMAND_BUFFER, -1);
+        RemoveLiveObject((uint64_t)pCommandBuffers[i]);
     }
 }
 
@@ -1285,22 +4069,34 @@ static VKAPI_ATTR VkResult VKAPI_CALL BeginCommandBuffer(
     VkCommandBuffer                             commandBuffer,
     const VkCommandBufferBeginInfo*             pBeginInfo)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkBeginCommandBuffer>(kHookBeginCommandBuffer)) {
+        const HookScope scope;
+        return hook(commandBuffer, pBeginInfo);
+    }
+    // Beginning a command buffer implicitly resets it
+    ResetCommandBufferState(*GetCommandBufferState(commandBuffer));
     return VK_SUCCESS;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL EndCommandBuffer(
     VkCommandBuffer                             commandBuffer)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkEndCommandBuffer>(kHookEndCommandBuffer)) {
+        const HookScope scope;
+        return hook(commandBuffer);
+    }
+    return GetCommandBufferState(commandBuffer)->stream.out_of_memory ? VK_ERROR_OUT_OF_HOST_MEMORY : VK_SUCCESS;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL ResetCommandBuffer(
     VkCommandBuffer                             commandBuffer,
     VkCommandBufferResetFlags                   flags)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkResetCommandBuffer>(kHookResetCommandBuffer)) {
+        const HookScope scope;
+        return hook(commandBuffer, flags);
+    }
+    ResetCommandBufferState(*GetCommandBufferState(commandBuffer));
     return VK_SUCCESS;
 }
 
@@ -1309,7 +4105,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBindPipeline(
     VkPipelineBindPoint                         pipelineBindPoint,
     VkPipeline                                  pipeline)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdBindPipeline>(kHookCmdBindPipeline)) {
+        const HookScope scope;
+        return hook(commandBuffer, pipelineBindPoint, pipeline);
+    }
+    RecordCommand(commandBuffer, kOpCmdBindPipeline, pipelineBindPoint, pipeline);
+    CountCommand(commandBuffer, kCounterPipelineBinds);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetViewport(
@@ -1318,7 +4119,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetViewport(
     uint32_t                                    viewportCount,
     const VkViewport*                           pViewports)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetViewport>(kHookCmdSetViewport)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstViewport, viewportCount, pViewports);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetViewport, firstViewport, viewportCount, RecordArray("pViewports", pViewports, viewportCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetScissor(
@@ -1327,14 +4133,24 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetScissor(
     uint32_t                                    scissorCount,
     const VkRect2D*                             pScissors)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetScissor>(kHookCmdSetScissor)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstScissor, scissorCount, pScissors);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetScissor, firstScissor, scissorCount, RecordArray("pScissors", pScissors, scissorCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetLineWidth(
     VkCommandBuffer                             commandBuffer,
     float                                       lineWidth)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetLineWidth>(kHookCmdSetLineWidth)) {
+        const HookScope scope;
+        return hook(commandBuffer, lineWidth);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetLineWidth, lineWidth);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthBias(
@@ -1343,14 +4159,24 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetDepthBias(
     float                                       depthBiasClamp,
     float                                       depthBiasSlopeFactor)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthBias>(kHookCmdSetDepthBias)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthBias, depthBiasConstantFactor, depthBiasClamp, depthBiasSlopeFactor);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetBlendConstants(
     VkCommandBuffer                             commandBuffer,
     const float                                 blendConstants[4])
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetBlendConstants>(kHookCmdSetBlendConstants)) {
+        const HookScope scope;
+        return hook(commandBuffer, blendConstants);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetBlendConstants, RecordArray("blendConstants", blendConstants, 4));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthBounds(
@@ -1358,7 +4184,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetDepthBounds(
     float                                       minDepthBounds,
     float                                       maxDepthBounds)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthBounds>(kHookCmdSetDepthBounds)) {
+        const HookScope scope;
+        return hook(commandBuffer, minDepthBounds, maxDepthBounds);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthBounds, minDepthBounds, maxDepthBounds);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetStencilCompareMask(
@@ -1366,7 +4197,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetStencilCompareMask(
     VkStencilFaceFlags                          faceMask,
     uint32_t                                    compareMask)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetStencilCompareMask>(kHookCmdSetStencilCompareMask)) {
+        const HookScope scope;
+        return hook(commandBuffer, faceMask, compareMask);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetStencilCompareMask, faceMask, compareMask);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetStencilWriteMask(
@@ -1374,7 +4210,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetStencilWriteMask(
     VkStencilFaceFlags                          faceMask,
     uint32_t                                    writeMask)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetStencilWriteMask>(kHookCmdSetStencilWriteMask)) {
+        const HookScope scope;
+        return hook(commandBuffer, faceMask, writeMask);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetStencilWriteMask, faceMask, writeMask);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetStencilReference(
@@ -1382,7 +4223,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetStencilReference(
     VkStencilFaceFlags                          faceMask,
     uint32_t                                    reference)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetStencilReference>(kHookCmdSetStencilReference)) {
+        const HookScope scope;
+        return hook(commandBuffer, faceMask, reference);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetStencilReference, faceMask, reference);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBindDescriptorSets(
@@ -1395,7 +4241,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBindDescriptorSets(
     uint32_t                                    dynamicOffsetCount,
     const uint32_t*                             pDynamicOffsets)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdBindDescriptorSets>(kHookCmdBindDescriptorSets)) {
+        const HookScope scope;
+        return hook(commandBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
+    }
+    RecordCommand(commandBuffer, kOpCmdBindDescriptorSets, pipelineBindPoint, layout, firstSet, descriptorSetCount, RecordArray("pDescriptorSets", pDescriptorSets, descriptorSetCount), dynamicOffsetCount, RecordArray("pDynamicOffsets", pDynamicOffsets, dynamicOffsetCount));
+    CountCommand(commandBuffer, kCounterDescriptorBinds, descriptorSetCount);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBindIndexBuffer(
@@ -1404,7 +4255,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBindIndexBuffer(
     VkDeviceSize                                offset,
     VkIndexType                                 indexType)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBindIndexBuffer>(kHookCmdBindIndexBuffer)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, indexType);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBindIndexBuffer, buffer, offset, indexType);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers(
@@ -1414,7 +4270,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers(
     const VkBuffer*                             pBuffers,
     const VkDeviceSize*                         pOffsets)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBindVertexBuffers>(kHookCmdBindVertexBuffers)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstBinding, bindingCount, pBuffers, pOffsets);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBindVertexBuffers, firstBinding, bindingCount, RecordArray("pBuffers", pBuffers, bindingCount), RecordArray("pOffsets", pOffsets, bindingCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDraw(
@@ -1424,7 +4285,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDraw(
     uint32_t                                    firstVertex,
     uint32_t                                    firstInstance)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDraw>(kHookCmdDraw)) {
+        const HookScope scope;
+        return hook(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+    RecordCommand(commandBuffer, kOpCmdDraw, vertexCount, instanceCount, firstVertex, firstInstance);
+    CountCommand(commandBuffer, kCounterDraws);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexed(
@@ -1435,7 +4301,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexed(
     int32_t                                     vertexOffset,
     uint32_t                                    firstInstance)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawIndexed>(kHookCmdDrawIndexed)) {
+        const HookScope scope;
+        return hook(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawIndexed, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    CountCommand(commandBuffer, kCounterDraws);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDrawIndirect(
@@ -1445,7 +4316,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawIndirect(
     uint32_t                                    drawCount,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawIndirect>(kHookCmdDrawIndirect)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, drawCount, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawIndirect, buffer, offset, drawCount, stride);
+    CountCommand(commandBuffer, kCounterDraws, drawCount);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexedIndirect(
@@ -1455,7 +4331,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexedIndirect(
     uint32_t                                    drawCount,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawIndexedIndirect>(kHookCmdDrawIndexedIndirect)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, drawCount, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawIndexedIndirect, buffer, offset, drawCount, stride);
+    CountCommand(commandBuffer, kCounterDraws, drawCount);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDispatch(
@@ -1464,7 +4345,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDispatch(
     uint32_t                                    groupCountY,
     uint32_t                                    groupCountZ)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDispatch>(kHookCmdDispatch)) {
+        const HookScope scope;
+        return hook(commandBuffer, groupCountX, groupCountY, groupCountZ);
+    }
+    RecordCommand(commandBuffer, kOpCmdDispatch, groupCountX, groupCountY, groupCountZ);
+    CountCommand(commandBuffer, kCounterDispatches);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDispatchIndirect(
@@ -1472,7 +4358,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDispatchIndirect(
     VkBuffer                                    buffer,
     VkDeviceSize                                offset)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDispatchIndirect>(kHookCmdDispatchIndirect)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset);
+    }
+    RecordCommand(commandBuffer, kOpCmdDispatchIndirect, buffer, offset);
+    CountCommand(commandBuffer, kCounterDispatches);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdCopyBuffer(
@@ -1482,7 +4373,16 @@ static VKAPI_ATTR void VKAPI_CALL CmdCopyBuffer(
     uint32_t                                    regionCount,
     const VkBufferCopy*                         pRegions)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdCopyBuffer>(kHookCmdCopyBuffer)) {
+        const HookScope scope;
+        return hook(commandBuffer, srcBuffer, dstBuffer, regionCount, pRegions);
+    }
+    RecordCommand(commandBuffer, kOpCmdCopyBuffer, srcBuffer, dstBuffer, regionCount, RecordArray("pRegions", pRegions, regionCount));
+    VkDeviceSize size = 0;
+    for (uint32_t i = 0; i < regionCount; ++i) {
+        size += pRegions[i].size;
+    }
+    CountCommand(commandBuffer, kCounterBytesCopied, size);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdCopyImage(
@@ -1494,7 +4394,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdCopyImage(
     uint32_t                                    regionCount,
     const VkImageCopy*                          pRegions)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyImage>(kHookCmdCopyImage)) {
+        const HookScope scope;
+        return hook(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyImage, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, RecordArray("pRegions", pRegions, regionCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBlitImage(
@@ -1507,7 +4412,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBlitImage(
     const VkImageBlit*                          pRegions,
     VkFilter                                    filter)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBlitImage>(kHookCmdBlitImage)) {
+        const HookScope scope;
+        return hook(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions, filter);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBlitImage, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, RecordArray("pRegions", pRegions, regionCount), filter);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(
@@ -1518,7 +4428,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(
     uint32_t                                    regionCount,
     const VkBufferImageCopy*                    pRegions)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyBufferToImage>(kHookCmdCopyBufferToImage)) {
+        const HookScope scope;
+        return hook(commandBuffer, srcBuffer, dstImage, dstImageLayout, regionCount, pRegions);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyBufferToImage, srcBuffer, dstImage, dstImageLayout, regionCount, RecordArray("pRegions", pRegions, regionCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer(
@@ -1529,7 +4444,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer(
     uint32_t                                    regionCount,
     const VkBufferImageCopy*                    pRegions)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyImageToBuffer>(kHookCmdCopyImageToBuffer)) {
+        const HookScope scope;
+        return hook(commandBuffer, srcImage, srcImageLayout, dstBuffer, regionCount, pRegions);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyImageToBuffer, srcImage, srcImageLayout, dstBuffer, regionCount, RecordArray("pRegions", pRegions, regionCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdUpdateBuffer(
@@ -1539,7 +4459,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdUpdateBuffer(
     VkDeviceSize                                dataSize,
     const void*                                 pData)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdUpdateBuffer>(kHookCmdUpdateBuffer)) {
+        const HookScope scope;
+        return hook(commandBuffer, dstBuffer, dstOffset, dataSize, pData);
+    }
+    RecordCommand(commandBuffer, kOpCmdUpdateBuffer, dstBuffer, dstOffset, dataSize, RecordArray("pData", static_cast<const uint8_t*>(pData), dataSize));
+    CountCommand(commandBuffer, kCounterBytesCopied, dataSize);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdFillBuffer(
@@ -1549,7 +4474,13 @@ static VKAPI_ATTR void VKAPI_CALL CmdFillBuffer(
     VkDeviceSize                                size,
     uint32_t                                    data)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdFillBuffer>(kHookCmdFillBuffer)) {
+        const HookScope scope;
+        return hook(commandBuffer, dstBuffer, dstOffset, size, data);
+    }
+    RecordCommand(commandBuffer, kOpCmdFillBuffer, dstBuffer, dstOffset, size, data);
+    // The size of a whole-buffer fill is not known from the command buffer, so it is not counted
+    if (size != VK_WHOLE_SIZE) CountCommand(commandBuffer, kCounterBytesCopied, size);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdClearColorImage(
@@ -1560,7 +4491,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdClearColorImage(
     uint32_t                                    rangeCount,
     const VkImageSubresourceRange*              pRanges)
 {
+    if (const auto hook = GetHook<PFN_vkCmdClearColorImage>(kHookCmdClearColorImage)) {
+        const HookScope scope;
+        return hook(commandBuffer, image, imageLayout, pColor, rangeCount, pRanges);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdClearColorImage, image, imageLayout, RecordArray("pColor", pColor, 1), rangeCount, RecordArray("pRanges", pRanges, rangeCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdClearDepthStencilImage(
@@ -1571,7 +4507,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdClearDepthStencilImage(
     uint32_t                                    rangeCount,
     const VkImageSubresourceRange*              pRanges)
 {
+    if (const auto hook = GetHook<PFN_vkCmdClearDepthStencilImage>(kHookCmdClearDepthStencilImage)) {
+        const HookScope scope;
+        return hook(commandBuffer, image, imageLayout, pDepthStencil, rangeCount, pRanges);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdClearDepthStencilImage, image, imageLayout, RecordArray("pDepthStencil", pDepthStencil, 1), rangeCount, RecordArray("pRanges", pRanges, rangeCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdClearAttachments(
@@ -1581,7 +4522,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdClearAttachments(
     uint32_t                                    rectCount,
     const VkClearRect*                          pRects)
 {
+    if (const auto hook = GetHook<PFN_vkCmdClearAttachments>(kHookCmdClearAttachments)) {
+        const HookScope scope;
+        return hook(commandBuffer, attachmentCount, pAttachments, rectCount, pRects);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdClearAttachments, attachmentCount, RecordArray("pAttachments", pAttachments, attachmentCount), rectCount, RecordArray("pRects", pRects, rectCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdResolveImage(
@@ -1593,7 +4539,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdResolveImage(
     uint32_t                                    regionCount,
     const VkImageResolve*                       pRegions)
 {
+    if (const auto hook = GetHook<PFN_vkCmdResolveImage>(kHookCmdResolveImage)) {
+        const HookScope scope;
+        return hook(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdResolveImage, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, RecordArray("pRegions", pRegions, regionCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetEvent(
@@ -1601,7 +4552,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetEvent(
     VkEvent                                     event,
     VkPipelineStageFlags                        stageMask)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdSetEvent>(kHookCmdSetEvent)) {
+        const HookScope scope;
+        return hook(commandBuffer, event, stageMask);
+    }
+    RecordCommand(commandBuffer, kOpCmdSetEvent, event, stageMask);
+    RecordQueueCommand(commandBuffer, QueueCommandType::kSetEvent, event);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdResetEvent(
@@ -1609,9 +4565,41 @@ static VKAPI_ATTR void VKAPI_CALL CmdResetEvent(
     VkEvent                                     event,
     VkPipelineStageFlags                        stageMask)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdResetEvent>(kHookCmdResetEvent)) {
+        const HookScope scope;
+        return hook(commandBuffer, event, stageMask);
+    }
+    RecordCommand(commandBuffer, kOpCmdResetEvent, event, stageMask);
+    RecordQueueCommand(commandBuffer, QueueCommandType::kResetEvent, event);
 }
 
+template <>
+struct RecordedStruct<VkMemoryBarrier> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkMemoryBarrier&) { return 0; }
+    static void CopyNested(VkMemoryBarrier& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkBufferMemoryBarrier> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkBufferMemoryBarrier&) { return 0; }
+    static void CopyNested(VkBufferMemoryBarrier& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkImageMemoryBarrier> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkImageMemoryBarrier&) { return 0; }
+    static void CopyNested(VkImageMemoryBarrier& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdWaitEvents(
     VkCommandBuffer                             commandBuffer,
     uint32_t                                    eventCount,
@@ -1625,7 +4613,14 @@ static VKAPI_ATTR void VKAPI_CALL CmdWaitEvents(
     uint32_t                                    imageMemoryBarrierCount,
     const VkImageMemoryBarrier*                 pImageMemoryBarriers)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdWaitEvents>(kHookCmdWaitEvents)) {
+        const HookScope scope;
+        return hook(commandBuffer, eventCount, pEvents, srcStageMask, dstStageMask, memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+    }
+    RecordCommand(commandBuffer, kOpCmdWaitEvents, eventCount, RecordArray("pEvents", pEvents, eventCount), srcStageMask, dstStageMask, memoryBarrierCount, RecordArray("pMemoryBarriers", pMemoryBarriers, memoryBarrierCount), bufferMemoryBarrierCount, RecordArray("pBufferMemoryBarriers", pBufferMemoryBarriers, bufferMemoryBarrierCount), imageMemoryBarrierCount, RecordArray("pImageMemoryBarriers", pImageMemoryBarriers, imageMemoryBarrierCount));
+    for (uint32_t i = 0; i < eventCount; ++i) {
+        RecordQueueCommand(commandBuffer, QueueCommandType::kWaitEvent, pEvents[i]);
+    }
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdPipelineBarrier(
@@ -1640,7 +4635,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdPipelineBarrier(
     uint32_t                                    imageMemoryBarrierCount,
     const VkImageMemoryBarrier*                 pImageMemoryBarriers)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdPipelineBarrier>(kHookCmdPipelineBarrier)) {
+        const HookScope scope;
+        return hook(commandBuffer, srcStageMask, dstStageMask, dependencyFlags, memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+    }
+    RecordCommand(commandBuffer, kOpCmdPipelineBarrier, srcStageMask, dstStageMask, dependencyFlags, memoryBarrierCount, RecordArray("pMemoryBarriers", pMemoryBarriers, memoryBarrierCount), bufferMemoryBarrierCount, RecordArray("pBufferMemoryBarriers", pBufferMemoryBarriers, bufferMemoryBarrierCount), imageMemoryBarrierCount, RecordArray("pImageMemoryBarriers", pImageMemoryBarriers, imageMemoryBarrierCount));
+    CountCommand(commandBuffer, kCounterBarriers, uint64_t(memoryBarrierCount) + bufferMemoryBarrierCount + imageMemoryBarrierCount);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBeginQuery(
@@ -1649,7 +4649,17 @@ static VKAPI_ATTR void VKAPI_CALL CmdBeginQuery(
     uint32_t                                    query,
     VkQueryControlFlags                         flags)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdBeginQuery>(kHookCmdBeginQuery)) {
+        const HookScope scope;
+        return hook(commandBuffer, queryPool, query, flags);
+    }
+    RecordCommand(commandBuffer, kOpCmdBeginQuery, queryPool, query, flags);
+    auto* state = GetCommandBufferState(commandBuffer);
+    std::shared_ptr<PerformanceQueryPool> pool;
+    if (state->device->objects->performance_query_pools.Find(queryPool, &pool)) {
+        state->has_active_query = true;
+        state->active_query = {queryPool, std::move(pool), query, state->counters};
+    }
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdEndQuery(
@@ -1657,7 +4667,21 @@ static VKAPI_ATTR void VKAPI_CALL CmdEndQuery(
     VkQueryPool                                 queryPool,
     uint32_t                                    query)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdEndQuery>(kHookCmdEndQuery)) {
+        const HookScope scope;
+        return hook(commandBuffer, queryPool, query);
+    }
+    RecordCommand(commandBuffer, kOpCmdEndQuery, queryPool, query);
+    // The pool was looked up when the query began, and the queue makes the result available when it executes the end
+    auto* state = GetCommandBufferState(commandBuffer);
+    auto& active_query = state->active_query;
+    if (!state->has_active_query || active_query.pool != queryPool || active_query.query != query) return;
+    QueueCommand command = {QueueCommandType::kEndQuery, nullptr, std::move(active_query.pool_state), query, 1};
+    for (uint32_t i = 0; i < kPerformanceCounterCount; ++i) {
+        command.counter_values[i] = state->counters[i] - active_query.begin_values[i];
+    }
+    state->queue_commands.push_back(std::move(command));
+    state->has_active_query = false;
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdResetQueryPool(
@@ -1666,7 +4690,15 @@ static VKAPI_ATTR void VKAPI_CALL CmdResetQueryPool(
     uint32_t                                    firstQuery,
     uint32_t                                    queryCount)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdResetQueryPool>(kHookCmdResetQueryPool)) {
+        const HookScope scope;
+        return hook(commandBuffer, queryPool, firstQuery, queryCount);
+    }
+    RecordCommand(commandBuffer, kOpCmdResetQueryPool, queryPool, firstQuery, queryCount);
+    auto* state = GetCommandBufferState(commandBuffer);
+    std::shared_ptr<PerformanceQueryPool> pool;
+    if (!state->device->objects->performance_query_pools.Find(queryPool, &pool)) return;
+    state->queue_commands.push_back({QueueCommandType::kResetQueries, nullptr, std::move(pool), firstQuery, queryCount});
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdWriteTimestamp(
@@ -1675,7 +4707,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdWriteTimestamp(
     VkQueryPool                                 queryPool,
     uint32_t                                    query)
 {
+    if (const auto hook = GetHook<PFN_vkCmdWriteTimestamp>(kHookCmdWriteTimestamp)) {
+        const HookScope scope;
+        return hook(commandBuffer, pipelineStage, queryPool, query);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdWriteTimestamp, pipelineStage, queryPool, query);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdCopyQueryPoolResults(
@@ -1688,7 +4725,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdCopyQueryPoolResults(
     VkDeviceSize                                stride,
     VkQueryResultFlags                          flags)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyQueryPoolResults>(kHookCmdCopyQueryPoolResults)) {
+        const HookScope scope;
+        return hook(commandBuffer, queryPool, firstQuery, queryCount, dstBuffer, dstOffset, stride, flags);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyQueryPoolResults, queryPool, firstQuery, queryCount, dstBuffer, dstOffset, stride, flags);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdPushConstants(
@@ -1699,28 +4741,62 @@ static VKAPI_ATTR void VKAPI_CALL CmdPushConstants(
     uint32_t                                    size,
     const void*                                 pValues)
 {
+    if (const auto hook = GetHook<PFN_vkCmdPushConstants>(kHookCmdPushConstants)) {
+        const HookScope scope;
+        return hook(commandBuffer, layout, stageFlags, offset, size, pValues);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdPushConstants, layout, stageFlags, offset, size, RecordArray("pValues", static_cast<const uint8_t*>(pValues), size));
 }
 
+template <>
+struct RecordedStruct<VkRenderPassBeginInfo> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkRenderPassBeginInfo& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pClearValues, s.clearValueCount);
+        return size;
+    }
+    static void CopyNested(VkRenderPassBeginInfo& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pClearValues = writer.CopyArray(s.pClearValues, s.clearValueCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdBeginRenderPass(
     VkCommandBuffer                             commandBuffer,
     const VkRenderPassBeginInfo*                pRenderPassBegin,
     VkSubpassContents                           contents)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBeginRenderPass>(kHookCmdBeginRenderPass)) {
+        const HookScope scope;
+        return hook(commandBuffer, pRenderPassBegin, contents);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBeginRenderPass, RecordArray("pRenderPassBegin", pRenderPassBegin, 1), contents);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdNextSubpass(
     VkCommandBuffer                             commandBuffer,
     VkSubpassContents                           contents)
 {
+    if (const auto hook = GetHook<PFN_vkCmdNextSubpass>(kHookCmdNextSubpass)) {
+        const HookScope scope;
+        return hook(commandBuffer, contents);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdNextSubpass, contents);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdEndRenderPass(
     VkCommandBuffer                             commandBuffer)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEndRenderPass>(kHookCmdEndRenderPass)) {
+        const HookScope scope;
+        return hook(commandBuffer);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEndRenderPass);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdExecuteCommands(
@@ -1728,7 +4804,21 @@ static VKAPI_ATTR void VKAPI_CALL CmdExecuteCommands(
     uint32_t                                    commandBufferCount,
     const VkCommandBuffer*                      pCommandBuffers)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdExecuteCommands>(kHookCmdExecuteCommands)) {
+        const HookScope scope;
+        return hook(commandBuffer, commandBufferCount, pCommandBuffers);
+    }
+    RecordCommand(commandBuffer, kOpCmdExecuteCommands, commandBufferCount, RecordArray("pCommandBuffers", pCommandBuffers, commandBufferCount));
+    // The primary takes over the queue commands of its secondaries and counts the commands they recorded
+    auto* state = GetCommandBufferState(commandBuffer);
+    for (uint32_t i = 0; i < commandBufferCount; ++i) {
+        const auto* secondary_state = GetCommandBufferState(pCommandBuffers[i]);
+        state->queue_commands.insert(state->queue_commands.end(), secondary_state->queue_commands.begin(),
+                                     secondary_state->queue_commands.end());
+        for (uint32_t j = 0; j < kPerformanceCounterCount; ++j) {
+            state->counters[j] += secondary_state->counters[j];
+        }
+    }
 }
 
 
@@ -1740,12 +4830,37 @@ static VKAPI_ATTR VkResult VKAPI_CALL EnumerateInstanceVersion(
     return VK_SUCCESS;
 }
 
+static VKAPI_ATTR VkResult VKAPI_CALL BindBufferMemory2Impl(
+    VkDevice                                    device,
+    uint32_t                                    bindInfoCount,
+    const VkBindBufferMemoryInfo*               pBindInfos)
+{
+    for (uint32_t i = 0; i < bindInfoCount; ++i) {
+        CallInternal(BindBufferMemory, device, pBindInfos[i].buffer, pBindInfos[i].memory, pBindInfos[i].memoryOffset);
+    }
+    return VK_SUCCESS;
+}
+
 static VKAPI_ATTR VkResult VKAPI_CALL BindBufferMemory2(
     VkDevice                                    device,
     uint32_t                                    bindInfoCount,
     const VkBindBufferMemoryInfo*               pBindInfos)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkBindBufferMemory2>(kHookBindBufferMemory2)) {
+        const HookScope scope;
+        return hook(device, bindInfoCount, pBindInfos);
+    }
+    return BindBufferMemory2Impl(device, bindInfoCount, pBindInfos);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory2Impl(
+    VkDevice                                    device,
+    uint32_t                                    bindInfoCount,
+    const VkBindImageMemoryInfo*                pBindInfos)
+{
+    for (uint32_t i = 0; i < bindInfoCount; ++i) {
+        CallInternal(BindImageMemory, device, pBindInfos[i].image, pBindInfos[i].memory, pBindInfos[i].memoryOffset);
+    }
     return VK_SUCCESS;
 }
 
@@ -1754,8 +4869,11 @@ static VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory2(
     uint32_t                                    bindInfoCount,
     const VkBindImageMemoryInfo*                pBindInfos)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkBindImageMemory2>(kHookBindImageMemory2)) {
+        const HookScope scope;
+        return hook(device, bindInfoCount, pBindInfos);
+    }
+    return BindImageMemory2Impl(device, bindInfoCount, pBindInfos);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetDeviceGroupPeerMemoryFeatures(
@@ -1765,6 +4883,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceGroupPeerMemoryFeatures(
     uint32_t                                    remoteDeviceIndex,
     VkPeerMemoryFeatureFlags*                   pPeerMemoryFeatures)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceGroupPeerMemoryFeatures>(kHookGetDeviceGroupPeerMemoryFeatures)) {
+        const HookScope scope;
+        return hook(device, heapIndex, localDeviceIndex, remoteDeviceIndex, pPeerMemoryFeatures);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -1772,7 +4894,24 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetDeviceMask(
     VkCommandBuffer                             commandBuffer,
     uint32_t                                    deviceMask)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDeviceMask>(kHookCmdSetDeviceMask)) {
+        const HookScope scope;
+        return hook(commandBuffer, deviceMask);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDeviceMask, deviceMask);
+}
+
+static VKAPI_ATTR void VKAPI_CALL CmdDispatchBaseImpl(
+    VkCommandBuffer                             commandBuffer,
+    uint32_t                                    baseGroupX,
+    uint32_t                                    baseGroupY,
+    uint32_t                                    baseGroupZ,
+    uint32_t                                    groupCountX,
+    uint32_t                                    groupCountY,
+    uint32_t                                    groupCountZ)
+{
+    CountCommand(commandBuffer, kCounterDispatches);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDispatchBase(
@@ -1784,7 +4923,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDispatchBase(
     uint32_t                                    groupCountY,
     uint32_t                                    groupCountZ)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDispatchBase>(kHookCmdDispatchBase)) {
+        const HookScope scope;
+        return hook(commandBuffer, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
+    }
+    RecordCommand(commandBuffer, kOpCmdDispatchBase, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
+    return CmdDispatchBaseImpl(commandBuffer, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL EnumeratePhysicalDeviceGroups(
@@ -1792,16 +4936,40 @@ static VKAPI_ATTR VkResult VKAPI_CALL EnumeratePhysicalDeviceGroups(
     uint32_t*                                   pPhysicalDeviceGroupCount,
     VkPhysicalDeviceGroupProperties*            pPhysicalDeviceGroupProperties)
 {
+    if (const auto hook = GetHook<PFN_vkEnumeratePhysicalDeviceGroups>(kHookEnumeratePhysicalDeviceGroups)) {
+        const HookScope scope;
+        return hook(instance, pPhysicalDeviceGroupCount, pPhysicalDeviceGroupProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
 
+static VKAPI_ATTR void VKAPI_CALL GetImageMemoryRequirements2Impl(
+    VkDevice                                    device,
+    const VkImageMemoryRequirementsInfo2*       pInfo,
+    VkMemoryRequirements2*                      pMemoryRequirements)
+{
+    CallInternal(GetImageMemoryRequirements, device, pInfo->image, &pMemoryRequirements->memoryRequirements);
+}
+
 static VKAPI_ATTR void VKAPI_CALL GetImageMemoryRequirements2(
     VkDevice                                    device,
     const VkImageMemoryRequirementsInfo2*       pInfo,
     VkMemoryRequirements2*                      pMemoryRequirements)
 {
-    GetImageMemoryRequirements2KHR(device, pInfo, pMemoryRequirements);
+    if (const auto hook = GetHook<PFN_vkGetImageMemoryRequirements2>(kHookGetImageMemoryRequirements2)) {
+        const HookScope scope;
+        return hook(device, pInfo, pMemoryRequirements);
+    }
+    return GetImageMemoryRequirements2Impl(device, pInfo, pMemoryRequirements);
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetBufferMemoryRequirements2Impl(
+    VkDevice                                    device,
+    const VkBufferMemoryRequirementsInfo2*      pInfo,
+    VkMemoryRequirements2*                      pMemoryRequirements)
+{
+    CallInternal(GetBufferMemoryRequirements, device, pInfo->buffer, &pMemoryRequirements->memoryRequirements);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetBufferMemoryRequirements2(
@@ -1809,7 +4977,24 @@ static VKAPI_ATTR void VKAPI_CALL GetBufferMemoryRequirements2(
     const VkBufferMemoryRequirementsInfo2*      pInfo,
     VkMemoryRequirements2*                      pMemoryRequirements)
 {
-    GetBufferMemoryRequirements2KHR(device, pInfo, pMemoryRequirements);
+    if (const auto hook = GetHook<PFN_vkGetBufferMemoryRequirements2>(kHookGetBufferMemoryRequirements2)) {
+        const HookScope scope;
+        return hook(device, pInfo, pMemoryRequirements);
+    }
+    return GetBufferMemoryRequirements2Impl(device, pInfo, pMemoryRequirements);
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetImageSparseMemoryRequirements2Impl(
+    VkDevice                                    device,
+    const VkImageSparseMemoryRequirementsInfo2* pInfo,
+    uint32_t*                                   pSparseMemoryRequirementCount,
+    VkSparseImageMemoryRequirements2*           pSparseMemoryRequirements)
+{
+    if (pSparseMemoryRequirements && *pSparseMemoryRequirementCount) {
+        CallInternal(GetImageSparseMemoryRequirements, device, pInfo->image, pSparseMemoryRequirementCount, &pSparseMemoryRequirements->memoryRequirements);
+    } else {
+        CallInternal(GetImageSparseMemoryRequirements, device, pInfo->image, pSparseMemoryRequirementCount, nullptr);
+    }
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetImageSparseMemoryRequirements2(
@@ -1818,21 +5003,142 @@ static VKAPI_ATTR void VKAPI_CALL GetImageSparseMemoryRequirements2(
     uint32_t*                                   pSparseMemoryRequirementCount,
     VkSparseImageMemoryRequirements2*           pSparseMemoryRequirements)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetImageSparseMemoryRequirements2>(kHookGetImageSparseMemoryRequirements2)) {
+        const HookScope scope;
+        return hook(device, pInfo, pSparseMemoryRequirementCount, pSparseMemoryRequirements);
+    }
+    return GetImageSparseMemoryRequirements2Impl(device, pInfo, pSparseMemoryRequirementCount, pSparseMemoryRequirements);
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFeatures2Impl(
+    VkPhysicalDevice                            physicalDevice,
+    VkPhysicalDeviceFeatures2*                  pFeatures)
+{
+    CallInternal(GetPhysicalDeviceFeatures, physicalDevice, &pFeatures->features);
+    uint32_t num_bools = 0; // Count number of VkBool32s in extension structs
+    VkBool32* feat_bools = nullptr;
+    const auto *desc_idx_features = lvl_find_in_chain<VkPhysicalDeviceDescriptorIndexingFeaturesEXT>(pFeatures->pNext);
+    if (desc_idx_features) {
+        const auto bool_size = sizeof(VkPhysicalDeviceDescriptorIndexingFeaturesEXT) - offsetof(VkPhysicalDeviceDescriptorIndexingFeaturesEXT, shaderInputAttachmentArrayDynamicIndexing);
+        num_bools = bool_size/sizeof(VkBool32);
+        feat_bools = (VkBool32*)&desc_idx_features->shaderInputAttachmentArrayDynamicIndexing;
+        SetBoolArrayTrue(feat_bools, num_bools);
+    }
+    const auto *blendop_features = lvl_find_in_chain<VkPhysicalDeviceBlendOperationAdvancedFeaturesEXT>(pFeatures->pNext);
+    if (blendop_features) {
+        const auto bool_size = sizeof(VkPhysicalDeviceBlendOperationAdvancedFeaturesEXT) - offsetof(VkPhysicalDeviceBlendOperationAdvancedFeaturesEXT, advancedBlendCoherentOperations);
+        num_bools = bool_size/sizeof(VkBool32);
+        feat_bools = (VkBool32*)&blendop_features->advancedBlendCoherentOperations;
+        SetBoolArrayTrue(feat_bools, num_bools);
+    }
+    auto *buffer_device_address_features = lvl_find_mod_in_chain<VkPhysicalDeviceBufferDeviceAddressFeatures>(pFeatures->pNext);
+    if (buffer_device_address_features) {
+        buffer_device_address_features->bufferDeviceAddress = VK_TRUE;
+        // Replaying captured addresses would need allocations placed at requested addresses
+        buffer_device_address_features->bufferDeviceAddressCaptureReplay = VK_FALSE;
+        buffer_device_address_features->bufferDeviceAddressMultiDevice = VK_FALSE;
+    }
+    auto *performance_query_features = lvl_find_mod_in_chain<VkPhysicalDevicePerformanceQueryFeaturesKHR>(pFeatures->pNext);
+    if (performance_query_features) {
+        performance_query_features->performanceCounterQueryPools = VK_TRUE;
+        performance_query_features->performanceCounterMultipleQueryPools = VK_TRUE;
+    }
+    auto *global_priority_query_features = lvl_find_mod_in_chain<VkPhysicalDeviceGlobalPriorityQueryFeaturesKHR>(pFeatures->pNext);
+    if (global_priority_query_features) {
+        global_priority_query_features->globalPriorityQuery = VK_TRUE;
+    }
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFeatures2(
     VkPhysicalDevice                            physicalDevice,
     VkPhysicalDeviceFeatures2*                  pFeatures)
 {
-    GetPhysicalDeviceFeatures2KHR(physicalDevice, pFeatures);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceFeatures2>(kHookGetPhysicalDeviceFeatures2)) {
+        const HookScope scope;
+        return hook(physicalDevice, pFeatures);
+    }
+    return GetPhysicalDeviceFeatures2Impl(physicalDevice, pFeatures);
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceProperties2Impl(
+    VkPhysicalDevice                            physicalDevice,
+    VkPhysicalDeviceProperties2*                pProperties)
+{
+    CallInternal(GetPhysicalDeviceProperties, physicalDevice, &pProperties->properties);
+    const auto *desc_idx_props = lvl_find_in_chain<VkPhysicalDeviceDescriptorIndexingPropertiesEXT>(pProperties->pNext);
+    if (desc_idx_props) {
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT* write_props = (VkPhysicalDeviceDescriptorIndexingPropertiesEXT*)desc_idx_props;
+        write_props->maxUpdateAfterBindDescriptorsInAllPools = 500000;
+        write_props->shaderUniformBufferArrayNonUniformIndexingNative = false;
+        write_props->shaderSampledImageArrayNonUniformIndexingNative = false;
+        write_props->shaderStorageBufferArrayNonUniformIndexingNative = false;
+        write_props->shaderStorageImageArrayNonUniformIndexingNative = false;
+        write_props->shaderInputAttachmentArrayNonUniformIndexingNative = false;
+        write_props->robustBufferAccessUpdateAfterBind = true;
+        write_props->quadDivergentImplicitLod = true;
+        write_props->maxPerStageDescriptorUpdateAfterBindSamplers = 500000;
+        write_props->maxPerStageDescriptorUpdateAfterBindUniformBuffers = 500000;
+        write_props->maxPerStageDescriptorUpdateAfterBindStorageBuffers = 500000;
+        write_props->maxPerStageDescriptorUpdateAfterBindSampledImages = 500000;
+        write_props->maxPerStageDescriptorUpdateAfterBindStorageImages = 500000;
+        write_props->maxPerStageDescriptorUpdateAfterBindInputAttachments = 500000;
+        write_props->maxPerStageUpdateAfterBindResources = 500000;
+        write_props->maxDescriptorSetUpdateAfterBindSamplers = 500000;
+        write_props->maxDescriptorSetUpdateAfterBindUniformBuffers = 96;
+        write_props->maxDescriptorSetUpdateAfterBindUniformBuffersDynamic = 8;
+        write_props->maxDescriptorSetUpdateAfterBindStorageBuffers = 500000;
+        write_props->maxDescriptorSetUpdateAfterBindStorageBuffersDynamic = 4;
+        write_props->maxDescriptorSetUpdateAfterBindSampledImages = 500000;
+        write_props->maxDescriptorSetUpdateAfterBindStorageImages = 500000;
+        write_props->maxDescriptorSetUpdateAfterBindInputAttachments = 500000;
+    }
+
+    const auto *push_descriptor_props = lvl_find_in_chain<VkPhysicalDevicePushDescriptorPropertiesKHR>(pProperties->pNext);
+    if (push_descriptor_props) {
+        VkPhysicalDevicePushDescriptorPropertiesKHR* write_props = (VkPhysicalDevicePushDescriptorPropertiesKHR*)push_descriptor_props;
+        write_props->maxPushDescriptors = 256;
+    }
+
+    const auto *depth_stencil_resolve_props = lvl_find_in_chain<VkPhysicalDeviceDepthStencilResolvePropertiesKHR>(pProperties->pNext);
+    if (depth_stencil_resolve_props) {
+        VkPhysicalDeviceDepthStencilResolvePropertiesKHR* write_props = (VkPhysicalDeviceDepthStencilResolvePropertiesKHR*)depth_stencil_resolve_props;
+        write_props->supportedDepthResolveModes = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT_KHR;
+        write_props->supportedStencilResolveModes = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT_KHR;
+    }
+
+    const auto *fragment_density_map2_props = lvl_find_in_chain<VkPhysicalDeviceFragmentDensityMap2PropertiesEXT>(pProperties->pNext);
+    if (fragment_density_map2_props) {
+        VkPhysicalDeviceFragmentDensityMap2PropertiesEXT* write_props = (VkPhysicalDeviceFragmentDensityMap2PropertiesEXT*)fragment_density_map2_props;
+        write_props->subsampledLoads = VK_FALSE;
+        write_props->subsampledCoarseReconstructionEarlyAccess = VK_FALSE;
+        write_props->maxSubsampledArrayLayers = 2;
+        write_props->maxDescriptorSetSubsampledSamplers = 1;
+    }
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceProperties2(
     VkPhysicalDevice                            physicalDevice,
     VkPhysicalDeviceProperties2*                pProperties)
 {
-    GetPhysicalDeviceProperties2KHR(physicalDevice, pProperties);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceProperties2>(kHookGetPhysicalDeviceProperties2)) {
+        const HookScope scope;
+        return hook(physicalDevice, pProperties);
+    }
+    return GetPhysicalDeviceProperties2Impl(physicalDevice, pProperties);
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFormatProperties2Impl(
+    VkPhysicalDevice                            physicalDevice,
+    VkFormat                                    format,
+    VkFormatProperties2*                        pFormatProperties)
+{
+    CallInternal(GetPhysicalDeviceFormatProperties, physicalDevice, format, &pFormatProperties->formatProperties);
+    VkFormatProperties3KHR *props_3 = lvl_find_mod_in_chain<VkFormatProperties3KHR>(pFormatProperties->pNext);
+    if (props_3) {
+        props_3->linearTilingFeatures = pFormatProperties->formatProperties.linearTilingFeatures;
+        props_3->optimalTilingFeatures = pFormatProperties->formatProperties.optimalTilingFeatures;
+        props_3->bufferFeatures = pFormatProperties->formatProperties.bufferFeatures;
+    }
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFormatProperties2(
@@ -1840,7 +5146,20 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFormatProperties2(
     VkFormat                                    format,
     VkFormatProperties2*                        pFormatProperties)
 {
-    GetPhysicalDeviceFormatProperties2KHR(physicalDevice, format, pFormatProperties);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceFormatProperties2>(kHookGetPhysicalDeviceFormatProperties2)) {
+        const HookScope scope;
+        return hook(physicalDevice, format, pFormatProperties);
+    }
+    return GetPhysicalDeviceFormatProperties2Impl(physicalDevice, format, pFormatProperties);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceImageFormatProperties2Impl(
+    VkPhysicalDevice                            physicalDevice,
+    const VkPhysicalDeviceImageFormatInfo2*     pImageFormatInfo,
+    VkImageFormatProperties2*                   pImageFormatProperties)
+{
+    CallInternal(GetPhysicalDeviceImageFormatProperties, physicalDevice, pImageFormatInfo->format, pImageFormatInfo->type, pImageFormatInfo->tiling, pImageFormatInfo->usage, pImageFormatInfo->flags, &pImageFormatProperties->imageFormatProperties);
+    return VK_SUCCESS;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceImageFormatProperties2(
@@ -1848,22 +5167,85 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceImageFormatProperties2(
     const VkPhysicalDeviceImageFormatInfo2*     pImageFormatInfo,
     VkImageFormatProperties2*                   pImageFormatProperties)
 {
-    return GetPhysicalDeviceImageFormatProperties2KHR(physicalDevice, pImageFormatInfo, pImageFormatProperties);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceImageFormatProperties2>(kHookGetPhysicalDeviceImageFormatProperties2)) {
+        const HookScope scope;
+        return hook(physicalDevice, pImageFormatInfo, pImageFormatProperties);
+    }
+    return GetPhysicalDeviceImageFormatProperties2Impl(physicalDevice, pImageFormatInfo, pImageFormatProperties);
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyProperties2Impl(
+    VkPhysicalDevice                            physicalDevice,
+    uint32_t*                                   pQueueFamilyPropertyCount,
+    VkQueueFamilyProperties2*                   pQueueFamilyProperties)
+{
+    if (pQueueFamilyPropertyCount && pQueueFamilyProperties) {
+        CallInternal(GetPhysicalDeviceQueueFamilyProperties, physicalDevice, pQueueFamilyPropertyCount, &pQueueFamilyProperties->queueFamilyProperties);
+        auto *global_priority_properties = lvl_find_mod_in_chain<VkQueueFamilyGlobalPriorityPropertiesKHR>(pQueueFamilyProperties->pNext);
+        if (*pQueueFamilyPropertyCount && global_priority_properties) {
+            global_priority_properties->priorityCount = 4;
+            global_priority_properties->priorities[0] = VK_QUEUE_GLOBAL_PRIORITY_LOW_KHR;
+            global_priority_properties->priorities[1] = VK_QUEUE_GLOBAL_PRIORITY_MEDIUM_KHR;
+            global_priority_properties->priorities[2] = VK_QUEUE_GLOBAL_PRIORITY_HIGH_KHR;
+            global_priority_properties->priorities[3] = VK_QUEUE_GLOBAL_PRIORITY_REALTIME_KHR;
+        }
+    } else {
+        CallInternal(GetPhysicalDeviceQueueFamilyProperties, physicalDevice, pQueueFamilyPropertyCount, nullptr);
+    }
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyProperties2(
+    VkPhysicalDevice                            physicalDevice,
+    uint32_t*                                   pQueueFamilyPropertyCount,
+    VkQueueFamilyProperties2*                   pQueueFamilyProperties)
+{
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceQueueFamilyProperties2>(kHookGetPhysicalDeviceQueueFamilyProperties2)) {
+        const HookScope scope;
+        return hook(physicalDevice, pQueueFamilyPropertyCount, pQueueFamilyProperties);
+    }
+    return GetPhysicalDeviceQueueFamilyProperties2Impl(physicalDevice, pQueueFamilyPropertyCount, pQueueFamilyProperties);
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMemoryProperties2Impl(
+    VkPhysicalDevice                            physicalDevice,
+    VkPhysicalDeviceMemoryProperties2*          pMemoryProperties)
+{
+    CallInternal(GetPhysicalDeviceMemoryProperties, physicalDevice, &pMemoryProperties->memoryProperties);
+    auto *budget_props = lvl_find_mod_in_chain<VkPhysicalDeviceMemoryBudgetPropertiesEXT>(pMemoryProperties->pNext);
+    if (budget_props) {
+        const VkDeviceSize budget = GetHeapBudget();
+        for (uint32_t i = 0; i < VK_MAX_MEMORY_HEAPS; ++i) {
+            const bool valid_heap = i < pMemoryProperties->memoryProperties.memoryHeapCount;
+            budget_props->heapBudget[i] = valid_heap ? budget : 0;
+            budget_props->heapUsage[i] = valid_heap ? heap_usage[i].load(std::memory_order_relaxed) : 0;
+        }
+    }
 }
 
-static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyProperties2(
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMemoryProperties2(
     VkPhysicalDevice                            physicalDevice,
-    uint32_t*                                   pQueueFamilyPropertyCount,
-    VkQueueFamilyProperties2*                   pQueueFamilyProperties)
+    VkPhysicalDeviceMemoryProperties2*          pMemoryProperties)
 {
-    GetPhysicalDeviceQueueFamilyProperties2KHR(physicalDevice, pQueueFamilyPropertyCount, pQueueFamilyProperties);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceMemoryProperties2>(kHookGetPhysicalDeviceMemoryProperties2)) {
+        const HookScope scope;
+        return hook(physicalDevice, pMemoryProperties);
+    }
+    return GetPhysicalDeviceMemoryProperties2Impl(physicalDevice, pMemoryProperties);
 }
 
-static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMemoryProperties2(
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceSparseImageFormatProperties2Impl(
     VkPhysicalDevice                            physicalDevice,
-    VkPhysicalDeviceMemoryProperties2*          pMemoryProperties)
+    const VkPhysicalDeviceSparseImageFormatInfo2* pFormatInfo,
+    uint32_t*                                   pPropertyCount,
+    VkSparseImageFormatProperties2*             pProperties)
 {
-    GetPhysicalDeviceMemoryProperties2KHR(physicalDevice, pMemoryProperties);
+    if (pProperties && *pPropertyCount) {
+        CallInternal(GetPhysicalDeviceSparseImageFormatProperties, physicalDevice, pFormatInfo->format, pFormatInfo->type, pFormatInfo->samples,
+                                                     pFormatInfo->usage, pFormatInfo->tiling, pPropertyCount, &pProperties->properties);
+    } else {
+        CallInternal(GetPhysicalDeviceSparseImageFormatProperties, physicalDevice, pFormatInfo->format, pFormatInfo->type, pFormatInfo->samples,
+                                                     pFormatInfo->usage, pFormatInfo->tiling, pPropertyCount, nullptr);
+    }
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceSparseImageFormatProperties2(
@@ -1872,7 +5254,23 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceSparseImageFormatProperties2(
     uint32_t*                                   pPropertyCount,
     VkSparseImageFormatProperties2*             pProperties)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSparseImageFormatProperties2>(kHookGetPhysicalDeviceSparseImageFormatProperties2)) {
+        const HookScope scope;
+        return hook(physicalDevice, pFormatInfo, pPropertyCount, pProperties);
+    }
+    return GetPhysicalDeviceSparseImageFormatProperties2Impl(physicalDevice, pFormatInfo, pPropertyCount, pProperties);
+}
+
+static VKAPI_ATTR void VKAPI_CALL TrimCommandPoolImpl(
+    VkDevice                                    device,
+    VkCommandPool                               commandPool,
+    VkCommandPoolTrimFlags                      flags)
+{
+    // Frees the blocks none of the pool's command buffers is using
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.command_pools.find(commandPool);
+    if (it != objects.command_pools.end()) it->second.arena->Release();
 }
 
 static VKAPI_ATTR void VKAPI_CALL TrimCommandPool(
@@ -1880,7 +5278,11 @@ static VKAPI_ATTR void VKAPI_CALL TrimCommandPool(
     VkCommandPool                               commandPool,
     VkCommandPoolTrimFlags                      flags)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkTrimCommandPool>(kHookTrimCommandPool)) {
+        const HookScope scope;
+        return hook(device, commandPool, flags);
+    }
+    return TrimCommandPoolImpl(device, commandPool, flags);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetDeviceQueue2(
@@ -1888,7 +5290,11 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceQueue2(
     const VkDeviceQueueInfo2*                   pQueueInfo,
     VkQueue*                                    pQueue)
 {
-    GetDeviceQueue(device, pQueueInfo->queueFamilyIndex, pQueueInfo->queueIndex, pQueue);
+    if (const auto hook = GetHook<PFN_vkGetDeviceQueue2>(kHookGetDeviceQueue2)) {
+        const HookScope scope;
+        return hook(device, pQueueInfo, pQueue);
+    }
+    CallInternal(GetDeviceQueue, device, pQueueInfo->queueFamilyIndex, pQueueInfo->queueIndex, pQueue);
     // TODO: Add further support for GetDeviceQueue2 features
 }
 
@@ -1898,8 +5304,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateSamplerYcbcrConversion(
     const VkAllocationCallbacks*                pAllocator,
     VkSamplerYcbcrConversion*                   pYcbcrConversion)
 {
-    unique_lock_t lock(global_lock);
-    *pYcbcrConversion = (VkSamplerYcbcrConversion)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateSamplerYcbcrConversion>(kHookCreateSamplerYcbcrConversion)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pYcbcrConversion);
+    }
+    *pYcbcrConversion = (VkSamplerYcbcrConversion)NewHandle(device, VK_OBJECT_TYPE_SAMPLER_YCBCR_CONVERSION);
+    TrackObjects(VK_OBJECT_TYPE_SAMPLER_YCBCR_CONVERSION, 1);
+    AddLiveObject("VkSamplerYcbcrConversion", (uint64_t)*pYcbcrConversion);
     return VK_SUCCESS;
 }
 
@@ -1908,7 +5319,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroySamplerYcbcrConversion(
     VkSamplerYcbcrConversion                    ycbcrConversion,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroySamplerYcbcrConversion>(kHookDestroySamplerYcbcrConversion)) {
+        const HookScope scope;
+        return hook(device, ycbcrConversion, pAllocator);
+    }
 //Destroy object
+    if (ycbcrConversion != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_SAMPLER_YCBCR_CONVERSION, -1);
+    RemoveLiveObject((uint64_t)ycbcrConversion);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorUpdateTemplate(
@@ -1917,8 +5334,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorUpdateTemplate(
     const VkAllocationCallbacks*                pAllocator,
     VkDescriptorUpdateTemplate*                 pDescriptorUpdateTemplate)
 {
-    unique_lock_t lock(global_lock);
-    *pDescriptorUpdateTemplate = (VkDescriptorUpdateTemplate)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateDescriptorUpdateTemplate>(kHookCreateDescriptorUpdateTemplate)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pDescriptorUpdateTemplate);
+    }
+    *pDescriptorUpdateTemplate = (VkDescriptorUpdateTemplate)NewHandle(device, VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE);
+    TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE, 1);
+    AddLiveObject("VkDescriptorUpdateTemplate", (uint64_t)*pDescriptorUpdateTemplate);
     return VK_SUCCESS;
 }
 
@@ -1927,7 +5349,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyDescriptorUpdateTemplate(
     VkDescriptorUpdateTemplate                  descriptorUpdateTemplate,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyDescriptorUpdateTemplate>(kHookDestroyDescriptorUpdateTemplate)) {
+        const HookScope scope;
+        return hook(device, descriptorUpdateTemplate, pAllocator);
+    }
 //Destroy object
+    if (descriptorUpdateTemplate != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE, -1);
+    RemoveLiveObject((uint64_t)descriptorUpdateTemplate);
 }
 
 static VKAPI_ATTR void VKAPI_CALL UpdateDescriptorSetWithTemplate(
@@ -1936,6 +5364,10 @@ static VKAPI_ATTR void VKAPI_CALL UpdateDescriptorSetWithTemplate(
     VkDescriptorUpdateTemplate                  descriptorUpdateTemplate,
     const void*                                 pData)
 {
+    if (const auto hook = GetHook<PFN_vkUpdateDescriptorSetWithTemplate>(kHookUpdateDescriptorSetWithTemplate)) {
+        const HookScope scope;
+        return hook(device, descriptorSet, descriptorUpdateTemplate, pData);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -1944,6 +5376,10 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceExternalBufferProperties(
     const VkPhysicalDeviceExternalBufferInfo*   pExternalBufferInfo,
     VkExternalBufferProperties*                 pExternalBufferProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceExternalBufferProperties>(kHookGetPhysicalDeviceExternalBufferProperties)) {
+        const HookScope scope;
+        return hook(physicalDevice, pExternalBufferInfo, pExternalBufferProperties);
+    }
     // Hard-code support for all handle types and features
     pExternalBufferProperties->externalMemoryProperties.externalMemoryFeatures = 0x7;
     pExternalBufferProperties->externalMemoryProperties.exportFromImportedHandleTypes = 0x1FF;
@@ -1955,6 +5391,10 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceExternalFenceProperties(
     const VkPhysicalDeviceExternalFenceInfo*    pExternalFenceInfo,
     VkExternalFenceProperties*                  pExternalFenceProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceExternalFenceProperties>(kHookGetPhysicalDeviceExternalFenceProperties)) {
+        const HookScope scope;
+        return hook(physicalDevice, pExternalFenceInfo, pExternalFenceProperties);
+    }
     // Hard-code support for all handle types and features
     pExternalFenceProperties->exportFromImportedHandleTypes = 0xF;
     pExternalFenceProperties->compatibleHandleTypes = 0xF;
@@ -1966,6 +5406,10 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceExternalSemaphoreProperties(
     const VkPhysicalDeviceExternalSemaphoreInfo* pExternalSemaphoreInfo,
     VkExternalSemaphoreProperties*              pExternalSemaphoreProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceExternalSemaphoreProperties>(kHookGetPhysicalDeviceExternalSemaphoreProperties)) {
+        const HookScope scope;
+        return hook(physicalDevice, pExternalSemaphoreInfo, pExternalSemaphoreProperties);
+    }
     // Hard code support for all handle types and features
     pExternalSemaphoreProperties->exportFromImportedHandleTypes = 0x1F;
     pExternalSemaphoreProperties->compatibleHandleTypes = 0x1F;
@@ -1977,10 +5421,27 @@ static VKAPI_ATTR void VKAPI_CALL GetDescriptorSetLayoutSupport(
     const VkDescriptorSetLayoutCreateInfo*      pCreateInfo,
     VkDescriptorSetLayoutSupport*               pSupport)
 {
+    if (const auto hook = GetHook<PFN_vkGetDescriptorSetLayoutSupport>(kHookGetDescriptorSetLayoutSupport)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pSupport);
+    }
 //Not a CREATE or DESTROY function
 }
 
 
+static VKAPI_ATTR void VKAPI_CALL CmdDrawIndirectCountImpl(
+    VkCommandBuffer                             commandBuffer,
+    VkBuffer                                    buffer,
+    VkDeviceSize                                offset,
+    VkBuffer                                    countBuffer,
+    VkDeviceSize                                countBufferOffset,
+    uint32_t                                    maxDrawCount,
+    uint32_t                                    stride)
+{
+    // The draw count is read from a buffer as the queue executes, so the bound the command gives is counted
+    CountCommand(commandBuffer, kCounterDraws, maxDrawCount);
+}
+
 static VKAPI_ATTR void VKAPI_CALL CmdDrawIndirectCount(
     VkCommandBuffer                             commandBuffer,
     VkBuffer                                    buffer,
@@ -1990,7 +5451,25 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawIndirectCount(
     uint32_t                                    maxDrawCount,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawIndirectCount>(kHookCmdDrawIndirectCount)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawIndirectCount, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    return CmdDrawIndirectCountImpl(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexedIndirectCountImpl(
+    VkCommandBuffer                             commandBuffer,
+    VkBuffer                                    buffer,
+    VkDeviceSize                                offset,
+    VkBuffer                                    countBuffer,
+    VkDeviceSize                                countBufferOffset,
+    uint32_t                                    maxDrawCount,
+    uint32_t                                    stride)
+{
+    // The draw count is read from a buffer as the queue executes, so the bound the command gives is counted
+    CountCommand(commandBuffer, kCounterDraws, maxDrawCount);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexedIndirectCount(
@@ -2002,7 +5481,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexedIndirectCount(
     uint32_t                                    maxDrawCount,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawIndexedIndirectCount>(kHookCmdDrawIndexedIndirectCount)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawIndexedIndirectCount, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    return CmdDrawIndexedIndirectCountImpl(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass2(
@@ -2011,32 +5495,70 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass2(
     const VkAllocationCallbacks*                pAllocator,
     VkRenderPass*                               pRenderPass)
 {
-    unique_lock_t lock(global_lock);
-    *pRenderPass = (VkRenderPass)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateRenderPass2>(kHookCreateRenderPass2)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pRenderPass);
+    }
+    *pRenderPass = (VkRenderPass)NewHandle(device, VK_OBJECT_TYPE_RENDER_PASS);
+    TrackObjects(VK_OBJECT_TYPE_RENDER_PASS, 1);
+    AddLiveObject("VkRenderPass", (uint64_t)*pRenderPass);
     return VK_SUCCESS;
 }
 
+template <>
+struct RecordedStruct<VkSubpassBeginInfo> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkSubpassBeginInfo&) { return 0; }
+    static void CopyNested(VkSubpassBeginInfo& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdBeginRenderPass2(
     VkCommandBuffer                             commandBuffer,
     const VkRenderPassBeginInfo*                pRenderPassBegin,
     const VkSubpassBeginInfo*                   pSubpassBeginInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBeginRenderPass2>(kHookCmdBeginRenderPass2)) {
+        const HookScope scope;
+        return hook(commandBuffer, pRenderPassBegin, pSubpassBeginInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBeginRenderPass2, RecordArray("pRenderPassBegin", pRenderPassBegin, 1), RecordArray("pSubpassBeginInfo", pSubpassBeginInfo, 1));
 }
 
+template <>
+struct RecordedStruct<VkSubpassEndInfo> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkSubpassEndInfo&) { return 0; }
+    static void CopyNested(VkSubpassEndInfo& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdNextSubpass2(
     VkCommandBuffer                             commandBuffer,
     const VkSubpassBeginInfo*                   pSubpassBeginInfo,
     const VkSubpassEndInfo*                     pSubpassEndInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdNextSubpass2>(kHookCmdNextSubpass2)) {
+        const HookScope scope;
+        return hook(commandBuffer, pSubpassBeginInfo, pSubpassEndInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdNextSubpass2, RecordArray("pSubpassBeginInfo", pSubpassBeginInfo, 1), RecordArray("pSubpassEndInfo", pSubpassEndInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdEndRenderPass2(
     VkCommandBuffer                             commandBuffer,
     const VkSubpassEndInfo*                     pSubpassEndInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEndRenderPass2>(kHookCmdEndRenderPass2)) {
+        const HookScope scope;
+        return hook(commandBuffer, pSubpassEndInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEndRenderPass2, RecordArray("pSubpassEndInfo", pSubpassEndInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL ResetQueryPool(
@@ -2045,7 +5567,14 @@ static VKAPI_ATTR void VKAPI_CALL ResetQueryPool(
     uint32_t                                    firstQuery,
     uint32_t                                    queryCount)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkResetQueryPool>(kHookResetQueryPool)) {
+        const HookScope scope;
+        return hook(device, queryPool, firstQuery, queryCount);
+    }
+    std::shared_ptr<PerformanceQueryPool> pool;
+    if (GetDeviceObjects(device).performance_query_pools.Find(queryPool, &pool)) {
+        ResetPerformanceQueries(*pool, firstQuery, queryCount);
+    }
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetSemaphoreCounterValue(
@@ -2053,6 +5582,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetSemaphoreCounterValue(
     VkSemaphore                                 semaphore,
     uint64_t*                                   pValue)
 {
+    if (const auto hook = GetHook<PFN_vkGetSemaphoreCounterValue>(kHookGetSemaphoreCounterValue)) {
+        const HookScope scope;
+        return hook(device, semaphore, pValue);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2062,6 +5595,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL WaitSemaphores(
     const VkSemaphoreWaitInfo*                  pWaitInfo,
     uint64_t                                    timeout)
 {
+    if (const auto hook = GetHook<PFN_vkWaitSemaphores>(kHookWaitSemaphores)) {
+        const HookScope scope;
+        return hook(device, pWaitInfo, timeout);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2070,22 +5607,47 @@ static VKAPI_ATTR VkResult VKAPI_CALL SignalSemaphore(
     VkDevice                                    device,
     const VkSemaphoreSignalInfo*                pSignalInfo)
 {
+    if (const auto hook = GetHook<PFN_vkSignalSemaphore>(kHookSignalSemaphore)) {
+        const HookScope scope;
+        return hook(device, pSignalInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
 
+static VKAPI_ATTR VkDeviceAddress VKAPI_CALL GetBufferDeviceAddressImpl(
+    VkDevice                                    device,
+    const VkBufferDeviceAddressInfo*            pInfo)
+{
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.buffer_bindings.find(pInfo->buffer);
+    if (it == objects.buffer_bindings.end()) {
+        return 0;
+    }
+    const uint8_t* data = GetDeviceMemoryData(objects, it->second.memory);
+    return data ? static_cast<VkDeviceAddress>(reinterpret_cast<uintptr_t>(data + it->second.offset)) : 0;
+}
+
 static VKAPI_ATTR VkDeviceAddress VKAPI_CALL GetBufferDeviceAddress(
     VkDevice                                    device,
     const VkBufferDeviceAddressInfo*            pInfo)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetBufferDeviceAddress>(kHookGetBufferDeviceAddress)) {
+        const HookScope scope;
+        return hook(device, pInfo);
+    }
+    return GetBufferDeviceAddressImpl(device, pInfo);
 }
 
 static VKAPI_ATTR uint64_t VKAPI_CALL GetBufferOpaqueCaptureAddress(
     VkDevice                                    device,
     const VkBufferDeviceAddressInfo*            pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkGetBufferOpaqueCaptureAddress>(kHookGetBufferOpaqueCaptureAddress)) {
+        const HookScope scope;
+        return hook(device, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2094,6 +5656,10 @@ static VKAPI_ATTR uint64_t VKAPI_CALL GetDeviceMemoryOpaqueCaptureAddress(
     VkDevice                                    device,
     const VkDeviceMemoryOpaqueCaptureAddressInfo* pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceMemoryOpaqueCaptureAddress>(kHookGetDeviceMemoryOpaqueCaptureAddress)) {
+        const HookScope scope;
+        return hook(device, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2104,6 +5670,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceToolProperties(
     uint32_t*                                   pToolCount,
     VkPhysicalDeviceToolProperties*             pToolProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceToolProperties>(kHookGetPhysicalDeviceToolProperties)) {
+        const HookScope scope;
+        return hook(physicalDevice, pToolCount, pToolProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2114,8 +5684,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreatePrivateDataSlot(
     const VkAllocationCallbacks*                pAllocator,
     VkPrivateDataSlot*                          pPrivateDataSlot)
 {
-    unique_lock_t lock(global_lock);
-    *pPrivateDataSlot = (VkPrivateDataSlot)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreatePrivateDataSlot>(kHookCreatePrivateDataSlot)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pPrivateDataSlot);
+    }
+    *pPrivateDataSlot = (VkPrivateDataSlot)NewHandle(device, VK_OBJECT_TYPE_PRIVATE_DATA_SLOT);
+    TrackObjects(VK_OBJECT_TYPE_PRIVATE_DATA_SLOT, 1);
+    AddLiveObject("VkPrivateDataSlot", (uint64_t)*pPrivateDataSlot);
     return VK_SUCCESS;
 }
 
@@ -2124,7 +5699,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyPrivateDataSlot(
     VkPrivateDataSlot                           privateDataSlot,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyPrivateDataSlot>(kHookDestroyPrivateDataSlot)) {
+        const HookScope scope;
+        return hook(device, privateDataSlot, pAllocator);
+    }
 //Destroy object
+    if (privateDataSlot != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_PRIVATE_DATA_SLOT, -1);
+    RemoveLiveObject((uint64_t)privateDataSlot);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL SetPrivateData(
@@ -2134,6 +5715,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL SetPrivateData(
     VkPrivateDataSlot                           privateDataSlot,
     uint64_t                                    data)
 {
+    if (const auto hook = GetHook<PFN_vkSetPrivateData>(kHookSetPrivateData)) {
+        const HookScope scope;
+        return hook(device, objectType, objectHandle, privateDataSlot, data);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2145,15 +5730,85 @@ static VKAPI_ATTR void VKAPI_CALL GetPrivateData(
     VkPrivateDataSlot                           privateDataSlot,
     uint64_t*                                   pData)
 {
+    if (const auto hook = GetHook<PFN_vkGetPrivateData>(kHookGetPrivateData)) {
+        const HookScope scope;
+        return hook(device, objectType, objectHandle, privateDataSlot, pData);
+    }
 //Not a CREATE or DESTROY function
 }
 
+template <>
+struct RecordedStruct<VkMemoryBarrier2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkMemoryBarrier2&) { return 0; }
+    static void CopyNested(VkMemoryBarrier2& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkBufferMemoryBarrier2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkBufferMemoryBarrier2&) { return 0; }
+    static void CopyNested(VkBufferMemoryBarrier2& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkImageMemoryBarrier2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkImageMemoryBarrier2&) { return 0; }
+    static void CopyNested(VkImageMemoryBarrier2& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkDependencyInfo> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkDependencyInfo& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pMemoryBarriers, s.memoryBarrierCount);
+        size += RecordedArraySize(s.pBufferMemoryBarriers, s.bufferMemoryBarrierCount);
+        size += RecordedArraySize(s.pImageMemoryBarriers, s.imageMemoryBarrierCount);
+        return size;
+    }
+    static void CopyNested(VkDependencyInfo& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pMemoryBarriers = writer.CopyArray(s.pMemoryBarriers, s.memoryBarrierCount);
+        s.pBufferMemoryBarriers = writer.CopyArray(s.pBufferMemoryBarriers, s.bufferMemoryBarrierCount);
+        s.pImageMemoryBarriers = writer.CopyArray(s.pImageMemoryBarriers, s.imageMemoryBarrierCount);
+    }
+};
+
+static VKAPI_ATTR void VKAPI_CALL CmdSetEvent2Impl(
+    VkCommandBuffer                             commandBuffer,
+    VkEvent                                     event,
+    const VkDependencyInfo*                     pDependencyInfo)
+{
+    RecordQueueCommand(commandBuffer, QueueCommandType::kSetEvent, event);
+}
+
 static VKAPI_ATTR void VKAPI_CALL CmdSetEvent2(
     VkCommandBuffer                             commandBuffer,
     VkEvent                                     event,
     const VkDependencyInfo*                     pDependencyInfo)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdSetEvent2>(kHookCmdSetEvent2)) {
+        const HookScope scope;
+        return hook(commandBuffer, event, pDependencyInfo);
+    }
+    RecordCommand(commandBuffer, kOpCmdSetEvent2, event, RecordArray("pDependencyInfo", pDependencyInfo, 1));
+    return CmdSetEvent2Impl(commandBuffer, event, pDependencyInfo);
+}
+
+static VKAPI_ATTR void VKAPI_CALL CmdResetEvent2Impl(
+    VkCommandBuffer                             commandBuffer,
+    VkEvent                                     event,
+    VkPipelineStageFlags2                       stageMask)
+{
+    RecordQueueCommand(commandBuffer, QueueCommandType::kResetEvent, event);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdResetEvent2(
@@ -2161,7 +5816,23 @@ static VKAPI_ATTR void VKAPI_CALL CmdResetEvent2(
     VkEvent                                     event,
     VkPipelineStageFlags2                       stageMask)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdResetEvent2>(kHookCmdResetEvent2)) {
+        const HookScope scope;
+        return hook(commandBuffer, event, stageMask);
+    }
+    RecordCommand(commandBuffer, kOpCmdResetEvent2, event, stageMask);
+    return CmdResetEvent2Impl(commandBuffer, event, stageMask);
+}
+
+static VKAPI_ATTR void VKAPI_CALL CmdWaitEvents2Impl(
+    VkCommandBuffer                             commandBuffer,
+    uint32_t                                    eventCount,
+    const VkEvent*                              pEvents,
+    const VkDependencyInfo*                     pDependencyInfos)
+{
+    for (uint32_t i = 0; i < eventCount; ++i) {
+        RecordQueueCommand(commandBuffer, QueueCommandType::kWaitEvent, pEvents[i]);
+    }
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdWaitEvents2(
@@ -2170,14 +5841,32 @@ static VKAPI_ATTR void VKAPI_CALL CmdWaitEvents2(
     const VkEvent*                              pEvents,
     const VkDependencyInfo*                     pDependencyInfos)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdWaitEvents2>(kHookCmdWaitEvents2)) {
+        const HookScope scope;
+        return hook(commandBuffer, eventCount, pEvents, pDependencyInfos);
+    }
+    RecordCommand(commandBuffer, kOpCmdWaitEvents2, eventCount, RecordArray("pEvents", pEvents, eventCount), RecordArray("pDependencyInfos", pDependencyInfos, eventCount));
+    return CmdWaitEvents2Impl(commandBuffer, eventCount, pEvents, pDependencyInfos);
+}
+
+static VKAPI_ATTR void VKAPI_CALL CmdPipelineBarrier2Impl(
+    VkCommandBuffer                             commandBuffer,
+    const VkDependencyInfo*                     pDependencyInfo)
+{
+    CountCommand(commandBuffer, kCounterBarriers, uint64_t(pDependencyInfo->memoryBarrierCount) +
+                                                      pDependencyInfo->bufferMemoryBarrierCount + pDependencyInfo->imageMemoryBarrierCount);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdPipelineBarrier2(
     VkCommandBuffer                             commandBuffer,
     const VkDependencyInfo*                     pDependencyInfo)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdPipelineBarrier2>(kHookCmdPipelineBarrier2)) {
+        const HookScope scope;
+        return hook(commandBuffer, pDependencyInfo);
+    }
+    RecordCommand(commandBuffer, kOpCmdPipelineBarrier2, RecordArray("pDependencyInfo", pDependencyInfo, 1));
+    return CmdPipelineBarrier2Impl(commandBuffer, pDependencyInfo);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdWriteTimestamp2(
@@ -2186,93 +5875,346 @@ static VKAPI_ATTR void VKAPI_CALL CmdWriteTimestamp2(
     VkQueryPool                                 queryPool,
     uint32_t                                    query)
 {
+    if (const auto hook = GetHook<PFN_vkCmdWriteTimestamp2>(kHookCmdWriteTimestamp2)) {
+        const HookScope scope;
+        return hook(commandBuffer, stage, queryPool, query);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdWriteTimestamp2, stage, queryPool, query);
 }
 
-static VKAPI_ATTR VkResult VKAPI_CALL QueueSubmit2(
+static VKAPI_ATTR VkResult VKAPI_CALL QueueSubmit2Impl(
     VkQueue                                     queue,
     uint32_t                                    submitCount,
     const VkSubmitInfo2*                        pSubmits,
     VkFence                                     fence)
 {
-//Not a CREATE or DESTROY function
+    std::vector<QueueBatch> batches(submitCount);
+    for (uint32_t i = 0; i < submitCount; ++i) {
+        const auto& submit = pSubmits[i];
+        for (uint32_t j = 0; j < submit.waitSemaphoreInfoCount; ++j) {
+            batches[i].wait_semaphores.push_back(submit.pWaitSemaphoreInfos[j].semaphore);
+        }
+        for (uint32_t j = 0; j < submit.commandBufferInfoCount; ++j) {
+            AppendQueueCommands(batches[i], submit.pCommandBufferInfos[j].commandBuffer);
+        }
+        for (uint32_t j = 0; j < submit.signalSemaphoreInfoCount; ++j) {
+            batches[i].signal_semaphores.push_back(submit.pSignalSemaphoreInfos[j].semaphore);
+        }
+    }
+    SubmitToQueue(queue, batches, fence);
     return VK_SUCCESS;
 }
 
+static VKAPI_ATTR VkResult VKAPI_CALL QueueSubmit2(
+    VkQueue                                     queue,
+    uint32_t                                    submitCount,
+    const VkSubmitInfo2*                        pSubmits,
+    VkFence                                     fence)
+{
+    if (const auto hook = GetHook<PFN_vkQueueSubmit2>(kHookQueueSubmit2)) {
+        const HookScope scope;
+        return hook(queue, submitCount, pSubmits, fence);
+    }
+    return QueueSubmit2Impl(queue, submitCount, pSubmits, fence);
+}
+
+template <>
+struct RecordedStruct<VkBufferCopy2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkBufferCopy2&) { return 0; }
+    static void CopyNested(VkBufferCopy2& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkCopyBufferInfo2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkCopyBufferInfo2& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pRegions, s.regionCount);
+        return size;
+    }
+    static void CopyNested(VkCopyBufferInfo2& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pRegions = writer.CopyArray(s.pRegions, s.regionCount);
+    }
+};
+
+static VKAPI_ATTR void VKAPI_CALL CmdCopyBuffer2Impl(
+    VkCommandBuffer                             commandBuffer,
+    const VkCopyBufferInfo2*                    pCopyBufferInfo)
+{
+    VkDeviceSize size = 0;
+    for (uint32_t i = 0; i < pCopyBufferInfo->regionCount; ++i) {
+        size += pCopyBufferInfo->pRegions[i].size;
+    }
+    CountCommand(commandBuffer, kCounterBytesCopied, size);
+}
+
 static VKAPI_ATTR void VKAPI_CALL CmdCopyBuffer2(
     VkCommandBuffer                             commandBuffer,
     const VkCopyBufferInfo2*                    pCopyBufferInfo)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdCopyBuffer2>(kHookCmdCopyBuffer2)) {
+        const HookScope scope;
+        return hook(commandBuffer, pCopyBufferInfo);
+    }
+    RecordCommand(commandBuffer, kOpCmdCopyBuffer2, RecordArray("pCopyBufferInfo", pCopyBufferInfo, 1));
+    return CmdCopyBuffer2Impl(commandBuffer, pCopyBufferInfo);
 }
 
+template <>
+struct RecordedStruct<VkImageCopy2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkImageCopy2&) { return 0; }
+    static void CopyNested(VkImageCopy2& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkCopyImageInfo2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkCopyImageInfo2& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pRegions, s.regionCount);
+        return size;
+    }
+    static void CopyNested(VkCopyImageInfo2& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pRegions = writer.CopyArray(s.pRegions, s.regionCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdCopyImage2(
     VkCommandBuffer                             commandBuffer,
     const VkCopyImageInfo2*                     pCopyImageInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyImage2>(kHookCmdCopyImage2)) {
+        const HookScope scope;
+        return hook(commandBuffer, pCopyImageInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyImage2, RecordArray("pCopyImageInfo", pCopyImageInfo, 1));
 }
 
+template <>
+struct RecordedStruct<VkBufferImageCopy2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkBufferImageCopy2&) { return 0; }
+    static void CopyNested(VkBufferImageCopy2& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkCopyBufferToImageInfo2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkCopyBufferToImageInfo2& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pRegions, s.regionCount);
+        return size;
+    }
+    static void CopyNested(VkCopyBufferToImageInfo2& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pRegions = writer.CopyArray(s.pRegions, s.regionCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage2(
     VkCommandBuffer                             commandBuffer,
     const VkCopyBufferToImageInfo2*             pCopyBufferToImageInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyBufferToImage2>(kHookCmdCopyBufferToImage2)) {
+        const HookScope scope;
+        return hook(commandBuffer, pCopyBufferToImageInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyBufferToImage2, RecordArray("pCopyBufferToImageInfo", pCopyBufferToImageInfo, 1));
 }
 
+template <>
+struct RecordedStruct<VkCopyImageToBufferInfo2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkCopyImageToBufferInfo2& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pRegions, s.regionCount);
+        return size;
+    }
+    static void CopyNested(VkCopyImageToBufferInfo2& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pRegions = writer.CopyArray(s.pRegions, s.regionCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer2(
     VkCommandBuffer                             commandBuffer,
     const VkCopyImageToBufferInfo2*             pCopyImageToBufferInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyImageToBuffer2>(kHookCmdCopyImageToBuffer2)) {
+        const HookScope scope;
+        return hook(commandBuffer, pCopyImageToBufferInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyImageToBuffer2, RecordArray("pCopyImageToBufferInfo", pCopyImageToBufferInfo, 1));
 }
 
+template <>
+struct RecordedStruct<VkImageBlit2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkImageBlit2&) { return 0; }
+    static void CopyNested(VkImageBlit2& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkBlitImageInfo2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkBlitImageInfo2& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pRegions, s.regionCount);
+        return size;
+    }
+    static void CopyNested(VkBlitImageInfo2& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pRegions = writer.CopyArray(s.pRegions, s.regionCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdBlitImage2(
     VkCommandBuffer                             commandBuffer,
     const VkBlitImageInfo2*                     pBlitImageInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBlitImage2>(kHookCmdBlitImage2)) {
+        const HookScope scope;
+        return hook(commandBuffer, pBlitImageInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBlitImage2, RecordArray("pBlitImageInfo", pBlitImageInfo, 1));
 }
 
+template <>
+struct RecordedStruct<VkImageResolve2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkImageResolve2&) { return 0; }
+    static void CopyNested(VkImageResolve2& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkResolveImageInfo2> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkResolveImageInfo2& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pRegions, s.regionCount);
+        return size;
+    }
+    static void CopyNested(VkResolveImageInfo2& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pRegions = writer.CopyArray(s.pRegions, s.regionCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdResolveImage2(
     VkCommandBuffer                             commandBuffer,
     const VkResolveImageInfo2*                  pResolveImageInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdResolveImage2>(kHookCmdResolveImage2)) {
+        const HookScope scope;
+        return hook(commandBuffer, pResolveImageInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdResolveImage2, RecordArray("pResolveImageInfo", pResolveImageInfo, 1));
 }
 
+template <>
+struct RecordedStruct<VkRenderingAttachmentInfo> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkRenderingAttachmentInfo&) { return 0; }
+    static void CopyNested(VkRenderingAttachmentInfo& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkRenderingInfo> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkRenderingInfo& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pColorAttachments, s.colorAttachmentCount);
+        size += RecordedArraySize(s.pDepthAttachment, 1);
+        size += RecordedArraySize(s.pStencilAttachment, 1);
+        return size;
+    }
+    static void CopyNested(VkRenderingInfo& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pColorAttachments = writer.CopyArray(s.pColorAttachments, s.colorAttachmentCount);
+        s.pDepthAttachment = writer.CopyArray(s.pDepthAttachment, 1);
+        s.pStencilAttachment = writer.CopyArray(s.pStencilAttachment, 1);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdBeginRendering(
     VkCommandBuffer                             commandBuffer,
     const VkRenderingInfo*                      pRenderingInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBeginRendering>(kHookCmdBeginRendering)) {
+        const HookScope scope;
+        return hook(commandBuffer, pRenderingInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBeginRendering, RecordArray("pRenderingInfo", pRenderingInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdEndRendering(
     VkCommandBuffer                             commandBuffer)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEndRendering>(kHookCmdEndRendering)) {
+        const HookScope scope;
+        return hook(commandBuffer);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEndRendering);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetCullMode(
     VkCommandBuffer                             commandBuffer,
     VkCullModeFlags                             cullMode)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetCullMode>(kHookCmdSetCullMode)) {
+        const HookScope scope;
+        return hook(commandBuffer, cullMode);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetCullMode, cullMode);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetFrontFace(
     VkCommandBuffer                             commandBuffer,
     VkFrontFace                                 frontFace)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetFrontFace>(kHookCmdSetFrontFace)) {
+        const HookScope scope;
+        return hook(commandBuffer, frontFace);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetFrontFace, frontFace);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetPrimitiveTopology(
     VkCommandBuffer                             commandBuffer,
     VkPrimitiveTopology                         primitiveTopology)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetPrimitiveTopology>(kHookCmdSetPrimitiveTopology)) {
+        const HookScope scope;
+        return hook(commandBuffer, primitiveTopology);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetPrimitiveTopology, primitiveTopology);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetViewportWithCount(
@@ -2280,7 +6222,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetViewportWithCount(
     uint32_t                                    viewportCount,
     const VkViewport*                           pViewports)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetViewportWithCount>(kHookCmdSetViewportWithCount)) {
+        const HookScope scope;
+        return hook(commandBuffer, viewportCount, pViewports);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetViewportWithCount, viewportCount, RecordArray("pViewports", pViewports, viewportCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetScissorWithCount(
@@ -2288,7 +6235,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetScissorWithCount(
     uint32_t                                    scissorCount,
     const VkRect2D*                             pScissors)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetScissorWithCount>(kHookCmdSetScissorWithCount)) {
+        const HookScope scope;
+        return hook(commandBuffer, scissorCount, pScissors);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetScissorWithCount, scissorCount, RecordArray("pScissors", pScissors, scissorCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers2(
@@ -2300,42 +6252,72 @@ static VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers2(
     const VkDeviceSize*                         pSizes,
     const VkDeviceSize*                         pStrides)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBindVertexBuffers2>(kHookCmdBindVertexBuffers2)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstBinding, bindingCount, pBuffers, pOffsets, pSizes, pStrides);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBindVertexBuffers2, firstBinding, bindingCount, RecordArray("pBuffers", pBuffers, bindingCount), RecordArray("pOffsets", pOffsets, bindingCount), RecordArray("pSizes", pSizes, bindingCount), RecordArray("pStrides", pStrides, bindingCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthTestEnable(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    depthTestEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthTestEnable>(kHookCmdSetDepthTestEnable)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthTestEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthTestEnable, depthTestEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthWriteEnable(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    depthWriteEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthWriteEnable>(kHookCmdSetDepthWriteEnable)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthWriteEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthWriteEnable, depthWriteEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthCompareOp(
     VkCommandBuffer                             commandBuffer,
     VkCompareOp                                 depthCompareOp)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthCompareOp>(kHookCmdSetDepthCompareOp)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthCompareOp);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthCompareOp, depthCompareOp);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthBoundsTestEnable(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    depthBoundsTestEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthBoundsTestEnable>(kHookCmdSetDepthBoundsTestEnable)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthBoundsTestEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthBoundsTestEnable, depthBoundsTestEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetStencilTestEnable(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    stencilTestEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetStencilTestEnable>(kHookCmdSetStencilTestEnable)) {
+        const HookScope scope;
+        return hook(commandBuffer, stencilTestEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetStencilTestEnable, stencilTestEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetStencilOp(
@@ -2346,28 +6328,48 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetStencilOp(
     VkStencilOp                                 depthFailOp,
     VkCompareOp                                 compareOp)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetStencilOp>(kHookCmdSetStencilOp)) {
+        const HookScope scope;
+        return hook(commandBuffer, faceMask, failOp, passOp, depthFailOp, compareOp);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetStencilOp, faceMask, failOp, passOp, depthFailOp, compareOp);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetRasterizerDiscardEnable(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    rasterizerDiscardEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetRasterizerDiscardEnable>(kHookCmdSetRasterizerDiscardEnable)) {
+        const HookScope scope;
+        return hook(commandBuffer, rasterizerDiscardEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetRasterizerDiscardEnable, rasterizerDiscardEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthBiasEnable(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    depthBiasEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthBiasEnable>(kHookCmdSetDepthBiasEnable)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthBiasEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthBiasEnable, depthBiasEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetPrimitiveRestartEnable(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    primitiveRestartEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetPrimitiveRestartEnable>(kHookCmdSetPrimitiveRestartEnable)) {
+        const HookScope scope;
+        return hook(commandBuffer, primitiveRestartEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetPrimitiveRestartEnable, primitiveRestartEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetDeviceBufferMemoryRequirements(
@@ -2375,6 +6377,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceBufferMemoryRequirements(
     const VkDeviceBufferMemoryRequirements*     pInfo,
     VkMemoryRequirements2*                      pMemoryRequirements)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceBufferMemoryRequirements>(kHookGetDeviceBufferMemoryRequirements)) {
+        const HookScope scope;
+        return hook(device, pInfo, pMemoryRequirements);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -2383,6 +6389,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceImageMemoryRequirements(
     const VkDeviceImageMemoryRequirements*      pInfo,
     VkMemoryRequirements2*                      pMemoryRequirements)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceImageMemoryRequirements>(kHookGetDeviceImageMemoryRequirements)) {
+        const HookScope scope;
+        return hook(device, pInfo, pMemoryRequirements);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -2392,6 +6402,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceImageSparseMemoryRequirements(
     uint32_t*                                   pSparseMemoryRequirementCount,
     VkSparseImageMemoryRequirements2*           pSparseMemoryRequirements)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceImageSparseMemoryRequirements>(kHookGetDeviceImageSparseMemoryRequirements)) {
+        const HookScope scope;
+        return hook(device, pInfo, pSparseMemoryRequirementCount, pSparseMemoryRequirements);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -2401,7 +6415,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroySurfaceKHR(
     VkSurfaceKHR                                surface,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroySurfaceKHR>(kHookDestroySurfaceKHR)) {
+        const HookScope scope;
+        return hook(instance, surface, pAllocator);
+    }
 //Destroy object
+    if (surface != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, -1);
+    RemoveLiveObject((uint64_t)surface);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceSupportKHR(
@@ -2410,6 +6430,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceSupportKHR(
     VkSurfaceKHR                                surface,
     VkBool32*                                   pSupported)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSurfaceSupportKHR>(kHookGetPhysicalDeviceSurfaceSupportKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, queueFamilyIndex, surface, pSupported);
+    }
     // Currently say that all surface/queue combos are supported
     *pSupported = VK_TRUE;
     return VK_SUCCESS;
@@ -2420,6 +6444,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceCapabilitiesKHR(
     VkSurfaceKHR                                surface,
     VkSurfaceCapabilitiesKHR*                   pSurfaceCapabilities)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR>(kHookGetPhysicalDeviceSurfaceCapabilitiesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, surface, pSurfaceCapabilities);
+    }
     // In general just say max supported is available for requested surface
     pSurfaceCapabilities->minImageCount = 1;
     pSurfaceCapabilities->maxImageCount = 0;
@@ -2461,6 +6489,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceFormatsKHR(
     uint32_t*                                   pSurfaceFormatCount,
     VkSurfaceFormatKHR*                         pSurfaceFormats)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSurfaceFormatsKHR>(kHookGetPhysicalDeviceSurfaceFormatsKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, surface, pSurfaceFormatCount, pSurfaceFormats);
+    }
     // Currently always say that RGBA8 & BGRA8 are supported
     if (!pSurfaceFormats) {
         *pSurfaceFormatCount = 2;
@@ -2486,6 +6518,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfacePresentModesKHR(
     uint32_t*                                   pPresentModeCount,
     VkPresentModeKHR*                           pPresentModes)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSurfacePresentModesKHR>(kHookGetPhysicalDeviceSurfacePresentModesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, surface, pPresentModeCount, pPresentModes);
+    }
     // Currently always say that all present modes are supported
     if (!pPresentModes) {
         *pPresentModeCount = 6;
@@ -2522,11 +6558,21 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateSwapchainKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkSwapchainKHR*                             pSwapchain)
 {
-    unique_lock_t lock(global_lock);
-    *pSwapchain = (VkSwapchainKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateSwapchainKHR>(kHookCreateSwapchainKHR)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pSwapchain);
+    }
+    *pSwapchain = (VkSwapchainKHR)NewHandle(device, VK_OBJECT_TYPE_SWAPCHAIN_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SWAPCHAIN_KHR, 1);
+    AddLiveObject("VkSwapchainKHR", (uint64_t)*pSwapchain);
+    std::array<VkImage, icd_swapchain_image_count> images;
     for(uint32_t i = 0; i < icd_swapchain_image_count; ++i){
-        swapchain_image_map[*pSwapchain][i] = (VkImage)global_unique_handle++;
+        images[i] = (VkImage)NewHandle(device, VK_OBJECT_TYPE_IMAGE);
     }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.swapchain_images[*pSwapchain] = images;
+    objects.swapchain_present_states[*pSwapchain];
     return VK_SUCCESS;
 }
 
@@ -2535,8 +6581,16 @@ static VKAPI_ATTR void VKAPI_CALL DestroySwapchainKHR(
     VkSwapchainKHR                              swapchain,
     const VkAllocationCallbacks*                pAllocator)
 {
-    unique_lock_t lock(global_lock);
-    swapchain_image_map.clear();
+    if (const auto hook = GetHook<PFN_vkDestroySwapchainKHR>(kHookDestroySwapchainKHR)) {
+        const HookScope scope;
+        return hook(device, swapchain, pAllocator);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.swapchain_images.erase(swapchain);
+    objects.swapchain_present_states.erase(swapchain);
+    if (swapchain != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_SWAPCHAIN_KHR, -1);
+    RemoveLiveObject((uint64_t)swapchain);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetSwapchainImagesKHR(
@@ -2545,12 +6599,17 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetSwapchainImagesKHR(
     uint32_t*                                   pSwapchainImageCount,
     VkImage*                                    pSwapchainImages)
 {
+    if (const auto hook = GetHook<PFN_vkGetSwapchainImagesKHR>(kHookGetSwapchainImagesKHR)) {
+        const HookScope scope;
+        return hook(device, swapchain, pSwapchainImageCount, pSwapchainImages);
+    }
     if (!pSwapchainImages) {
         *pSwapchainImageCount = icd_swapchain_image_count;
     } else {
-        unique_lock_t lock(global_lock);
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
         for (uint32_t img_i = 0; img_i < (std::min)(*pSwapchainImageCount, icd_swapchain_image_count); ++img_i){
-            pSwapchainImages[img_i] = swapchain_image_map.at(swapchain)[img_i];
+            pSwapchainImages[img_i] = objects.swapchain_images.at(swapchain)[img_i];
         }
 
         if (*pSwapchainImageCount < icd_swapchain_image_count) return VK_INCOMPLETE;
@@ -2567,6 +6626,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(
     VkFence                                     fence,
     uint32_t*                                   pImageIndex)
 {
+    if (const auto hook = GetHook<PFN_vkAcquireNextImageKHR>(kHookAcquireNextImageKHR)) {
+        const HookScope scope;
+        return hook(device, swapchain, timeout, semaphore, fence, pImageIndex);
+    }
     *pImageIndex = 0;
     return VK_SUCCESS;
 }
@@ -2575,14 +6638,48 @@ static VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(
     VkQueue                                     queue,
     const VkPresentInfoKHR*                     pPresentInfo)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkQueuePresentKHR>(kHookQueuePresentKHR)) {
+        const HookScope scope;
+        return hook(queue, pPresentInfo);
+    }
+    icd_stats.present_count.fetch_add(pPresentInfo->swapchainCount, std::memory_order_relaxed);
+    const auto *present_times = lvl_find_in_chain<VkPresentTimesInfoGOOGLE>(pPresentInfo->pNext);
+    uint64_t last_present_time = 0;
+    VkResult result = VK_SUCCESS;
+    {
+        auto& objects = *GetQueueState(queue)->device->objects;
+        unique_lock_t lock(objects.lock);
+        for (uint32_t i = 0; i < pPresentInfo->swapchainCount; ++i) {
+            const bool has_time = present_times && present_times->pTimes && i < present_times->swapchainCount;
+            uint64_t present_time = 0;
+            const VkResult swapchain_result =
+                SchedulePresent(objects.swapchain_present_states, pPresentInfo->pSwapchains[i],
+                                has_time ? present_times->pTimes[i].presentID : 0,
+                                has_time ? present_times->pTimes[i].desiredPresentTime : 0, &present_time)
+                    ? VK_SUCCESS
+                    : VK_ERROR_OUT_OF_DATE_KHR;
+            last_present_time = (std::max)(last_present_time, present_time);
+            if (pPresentInfo->pResults) pPresentInfo->pResults[i] = swapchain_result;
+            if (result == VK_SUCCESS) result = swapchain_result;
+        }
+    }
+    // With pacing, presentation blocks like a FIFO swapchain whose queue is full until the image is displayed
+    static const bool pace_presents = GetEnvSize("VKMOCK_PRESENT_PACING", 0) != 0;
+    if (pace_presents) {
+        const uint64_t now = GetMonotonicTimeNs();
+        if (last_present_time > now) std::this_thread::sleep_for(std::chrono::nanoseconds(last_present_time - now));
+    }
+    return result;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetDeviceGroupPresentCapabilitiesKHR(
     VkDevice                                    device,
     VkDeviceGroupPresentCapabilitiesKHR*        pDeviceGroupPresentCapabilities)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceGroupPresentCapabilitiesKHR>(kHookGetDeviceGroupPresentCapabilitiesKHR)) {
+        const HookScope scope;
+        return hook(device, pDeviceGroupPresentCapabilities);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2592,6 +6689,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetDeviceGroupSurfacePresentModesKHR(
     VkSurfaceKHR                                surface,
     VkDeviceGroupPresentModeFlagsKHR*           pModes)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceGroupSurfacePresentModesKHR>(kHookGetDeviceGroupSurfacePresentModesKHR)) {
+        const HookScope scope;
+        return hook(device, surface, pModes);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2602,6 +6703,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDevicePresentRectanglesKHR(
     uint32_t*                                   pRectCount,
     VkRect2D*                                   pRects)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDevicePresentRectanglesKHR>(kHookGetPhysicalDevicePresentRectanglesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, surface, pRectCount, pRects);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2611,6 +6716,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImage2KHR(
     const VkAcquireNextImageInfoKHR*            pAcquireInfo,
     uint32_t*                                   pImageIndex)
 {
+    if (const auto hook = GetHook<PFN_vkAcquireNextImage2KHR>(kHookAcquireNextImage2KHR)) {
+        const HookScope scope;
+        return hook(device, pAcquireInfo, pImageIndex);
+    }
     *pImageIndex = 0;
     return VK_SUCCESS;
 }
@@ -2621,6 +6730,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceDisplayPropertiesKHR(
     uint32_t*                                   pPropertyCount,
     VkDisplayPropertiesKHR*                     pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceDisplayPropertiesKHR>(kHookGetPhysicalDeviceDisplayPropertiesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pPropertyCount, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2630,6 +6743,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceDisplayPlanePropertiesKHR
     uint32_t*                                   pPropertyCount,
     VkDisplayPlanePropertiesKHR*                pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceDisplayPlanePropertiesKHR>(kHookGetPhysicalDeviceDisplayPlanePropertiesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pPropertyCount, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2640,6 +6757,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetDisplayPlaneSupportedDisplaysKHR(
     uint32_t*                                   pDisplayCount,
     VkDisplayKHR*                               pDisplays)
 {
+    if (const auto hook = GetHook<PFN_vkGetDisplayPlaneSupportedDisplaysKHR>(kHookGetDisplayPlaneSupportedDisplaysKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, planeIndex, pDisplayCount, pDisplays);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2650,6 +6771,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetDisplayModePropertiesKHR(
     uint32_t*                                   pPropertyCount,
     VkDisplayModePropertiesKHR*                 pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetDisplayModePropertiesKHR>(kHookGetDisplayModePropertiesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, display, pPropertyCount, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2661,8 +6786,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDisplayModeKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkDisplayModeKHR*                           pMode)
 {
-    unique_lock_t lock(global_lock);
-    *pMode = (VkDisplayModeKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateDisplayModeKHR>(kHookCreateDisplayModeKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, display, pCreateInfo, pAllocator, pMode);
+    }
+    *pMode = (VkDisplayModeKHR)NewHandle(physicalDevice, VK_OBJECT_TYPE_DISPLAY_MODE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_DISPLAY_MODE_KHR, 1);
+    AddLiveObject("VkDisplayModeKHR", (uint64_t)*pMode);
     return VK_SUCCESS;
 }
 
@@ -2672,6 +6802,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetDisplayPlaneCapabilitiesKHR(
     uint32_t                                    planeIndex,
     VkDisplayPlaneCapabilitiesKHR*              pCapabilities)
 {
+    if (const auto hook = GetHook<PFN_vkGetDisplayPlaneCapabilitiesKHR>(kHookGetDisplayPlaneCapabilitiesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, mode, planeIndex, pCapabilities);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2682,8 +6816,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDisplayPlaneSurfaceKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateDisplayPlaneSurfaceKHR>(kHookCreateDisplayPlaneSurfaceKHR)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 
@@ -2695,10 +6834,15 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateSharedSwapchainsKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkSwapchainKHR*                             pSwapchains)
 {
-    unique_lock_t lock(global_lock);
+    if (const auto hook = GetHook<PFN_vkCreateSharedSwapchainsKHR>(kHookCreateSharedSwapchainsKHR)) {
+        const HookScope scope;
+        return hook(device, swapchainCount, pCreateInfos, pAllocator, pSwapchains);
+    }
     for (uint32_t i = 0; i < swapchainCount; ++i) {
-        pSwapchains[i] = (VkSwapchainKHR)global_unique_handle++;
+        pSwapchains[i] = (VkSwapchainKHR)NewHandle(device, VK_OBJECT_TYPE_SWAPCHAIN_KHR);
+        AddLiveObject("VkSwapchainKHR", (uint64_t)pSwapchains[i]);
     }
+    TrackObjects(VK_OBJECT_TYPE_SWAPCHAIN_KHR, swapchainCount);
     return VK_SUCCESS;
 }
 
@@ -2710,8 +6854,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateXlibSurfaceKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateXlibSurfaceKHR>(kHookCreateXlibSurfaceKHR)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 
@@ -2721,6 +6870,10 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceXlibPresentationSupportKH
     Display*                                    dpy,
     VisualID                                    visualID)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceXlibPresentationSupportKHR>(kHookGetPhysicalDeviceXlibPresentationSupportKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, queueFamilyIndex, dpy, visualID);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2734,8 +6887,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateXcbSurfaceKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateXcbSurfaceKHR>(kHookCreateXcbSurfaceKHR)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 
@@ -2745,6 +6903,10 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceXcbPresentationSupportKHR
     xcb_connection_t*                           connection,
     xcb_visualid_t                              visual_id)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR>(kHookGetPhysicalDeviceXcbPresentationSupportKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, queueFamilyIndex, connection, visual_id);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2758,8 +6920,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateWaylandSurfaceKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateWaylandSurfaceKHR>(kHookCreateWaylandSurfaceKHR)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 
@@ -2768,6 +6935,10 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceWaylandPresentationSuppor
     uint32_t                                    queueFamilyIndex,
     struct wl_display*                          display)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR>(kHookGetPhysicalDeviceWaylandPresentationSupportKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, queueFamilyIndex, display);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2781,8 +6952,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateAndroidSurfaceKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateAndroidSurfaceKHR>(kHookCreateAndroidSurfaceKHR)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 #endif /* VK_USE_PLATFORM_ANDROID_KHR */
@@ -2795,8 +6971,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateWin32SurfaceKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateWin32SurfaceKHR>(kHookCreateWin32SurfaceKHR)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 
@@ -2804,6 +6985,10 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceWin32PresentationSupportK
     VkPhysicalDevice                            physicalDevice,
     uint32_t                                    queueFamilyIndex)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceWin32PresentationSupportKHR>(kHookGetPhysicalDeviceWin32PresentationSupportKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, queueFamilyIndex);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2817,6 +7002,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceVideoCapabilitiesKHR(
     const VkVideoProfileKHR*                    pVideoProfile,
     VkVideoCapabilitiesKHR*                     pCapabilities)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceVideoCapabilitiesKHR>(kHookGetPhysicalDeviceVideoCapabilitiesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pVideoProfile, pCapabilities);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2827,6 +7016,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceVideoFormatPropertiesKHR(
     uint32_t*                                   pVideoFormatPropertyCount,
     VkVideoFormatPropertiesKHR*                 pVideoFormatProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceVideoFormatPropertiesKHR>(kHookGetPhysicalDeviceVideoFormatPropertiesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pVideoFormatInfo, pVideoFormatPropertyCount, pVideoFormatProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2837,8 +7030,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateVideoSessionKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkVideoSessionKHR*                          pVideoSession)
 {
-    unique_lock_t lock(global_lock);
-    *pVideoSession = (VkVideoSessionKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateVideoSessionKHR>(kHookCreateVideoSessionKHR)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pVideoSession);
+    }
+    *pVideoSession = (VkVideoSessionKHR)NewHandle(device, VK_OBJECT_TYPE_VIDEO_SESSION_KHR);
+    TrackObjects(VK_OBJECT_TYPE_VIDEO_SESSION_KHR, 1);
+    AddLiveObject("VkVideoSessionKHR", (uint64_t)*pVideoSession);
     return VK_SUCCESS;
 }
 
@@ -2847,7 +7045,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyVideoSessionKHR(
     VkVideoSessionKHR                           videoSession,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyVideoSessionKHR>(kHookDestroyVideoSessionKHR)) {
+        const HookScope scope;
+        return hook(device, videoSession, pAllocator);
+    }
 //Destroy object
+    if (videoSession != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_VIDEO_SESSION_KHR, -1);
+    RemoveLiveObject((uint64_t)videoSession);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetVideoSessionMemoryRequirementsKHR(
@@ -2856,6 +7060,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetVideoSessionMemoryRequirementsKHR(
     uint32_t*                                   pVideoSessionMemoryRequirementsCount,
     VkVideoGetMemoryPropertiesKHR*              pVideoSessionMemoryRequirements)
 {
+    if (const auto hook = GetHook<PFN_vkGetVideoSessionMemoryRequirementsKHR>(kHookGetVideoSessionMemoryRequirementsKHR)) {
+        const HookScope scope;
+        return hook(device, videoSession, pVideoSessionMemoryRequirementsCount, pVideoSessionMemoryRequirements);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2866,6 +7074,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL BindVideoSessionMemoryKHR(
     uint32_t                                    videoSessionBindMemoryCount,
     const VkVideoBindMemoryKHR*                 pVideoSessionBindMemories)
 {
+    if (const auto hook = GetHook<PFN_vkBindVideoSessionMemoryKHR>(kHookBindVideoSessionMemoryKHR)) {
+        const HookScope scope;
+        return hook(device, videoSession, videoSessionBindMemoryCount, pVideoSessionBindMemories);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2876,8 +7088,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateVideoSessionParametersKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkVideoSessionParametersKHR*                pVideoSessionParameters)
 {
-    unique_lock_t lock(global_lock);
-    *pVideoSessionParameters = (VkVideoSessionParametersKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateVideoSessionParametersKHR>(kHookCreateVideoSessionParametersKHR)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pVideoSessionParameters);
+    }
+    *pVideoSessionParameters = (VkVideoSessionParametersKHR)NewHandle(device, VK_OBJECT_TYPE_VIDEO_SESSION_PARAMETERS_KHR);
+    TrackObjects(VK_OBJECT_TYPE_VIDEO_SESSION_PARAMETERS_KHR, 1);
+    AddLiveObject("VkVideoSessionParametersKHR", (uint64_t)*pVideoSessionParameters);
     return VK_SUCCESS;
 }
 
@@ -2886,6 +7103,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL UpdateVideoSessionParametersKHR(
     VkVideoSessionParametersKHR                 videoSessionParameters,
     const VkVideoSessionParametersUpdateInfoKHR* pUpdateInfo)
 {
+    if (const auto hook = GetHook<PFN_vkUpdateVideoSessionParametersKHR>(kHookUpdateVideoSessionParametersKHR)) {
+        const HookScope scope;
+        return hook(device, videoSessionParameters, pUpdateInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -2895,38 +7116,137 @@ static VKAPI_ATTR void VKAPI_CALL DestroyVideoSessionParametersKHR(
     VkVideoSessionParametersKHR                 videoSessionParameters,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyVideoSessionParametersKHR>(kHookDestroyVideoSessionParametersKHR)) {
+        const HookScope scope;
+        return hook(device, videoSessionParameters, pAllocator);
+    }
 //Destroy object
+    if (videoSessionParameters != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_VIDEO_SESSION_PARAMETERS_KHR, -1);
+    RemoveLiveObject((uint64_t)videoSessionParameters);
 }
 
+template <>
+struct RecordedStruct<VkVideoPictureResourceKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkVideoPictureResourceKHR&) { return 0; }
+    static void CopyNested(VkVideoPictureResourceKHR& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkVideoReferenceSlotKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkVideoReferenceSlotKHR& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pPictureResource, 1);
+        return size;
+    }
+    static void CopyNested(VkVideoReferenceSlotKHR& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pPictureResource = writer.CopyArray(s.pPictureResource, 1);
+    }
+};
+
+template <>
+struct RecordedStruct<VkVideoBeginCodingInfoKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkVideoBeginCodingInfoKHR& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pReferenceSlots, s.referenceSlotCount);
+        return size;
+    }
+    static void CopyNested(VkVideoBeginCodingInfoKHR& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pReferenceSlots = writer.CopyArray(s.pReferenceSlots, s.referenceSlotCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdBeginVideoCodingKHR(
     VkCommandBuffer                             commandBuffer,
     const VkVideoBeginCodingInfoKHR*            pBeginInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBeginVideoCodingKHR>(kHookCmdBeginVideoCodingKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pBeginInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBeginVideoCodingKHR, RecordArray("pBeginInfo", pBeginInfo, 1));
 }
 
+template <>
+struct RecordedStruct<VkVideoEndCodingInfoKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkVideoEndCodingInfoKHR&) { return 0; }
+    static void CopyNested(VkVideoEndCodingInfoKHR& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdEndVideoCodingKHR(
     VkCommandBuffer                             commandBuffer,
     const VkVideoEndCodingInfoKHR*              pEndCodingInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEndVideoCodingKHR>(kHookCmdEndVideoCodingKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pEndCodingInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEndVideoCodingKHR, RecordArray("pEndCodingInfo", pEndCodingInfo, 1));
 }
 
+template <>
+struct RecordedStruct<VkVideoCodingControlInfoKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkVideoCodingControlInfoKHR&) { return 0; }
+    static void CopyNested(VkVideoCodingControlInfoKHR& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdControlVideoCodingKHR(
     VkCommandBuffer                             commandBuffer,
     const VkVideoCodingControlInfoKHR*          pCodingControlInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdControlVideoCodingKHR>(kHookCmdControlVideoCodingKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pCodingControlInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdControlVideoCodingKHR, RecordArray("pCodingControlInfo", pCodingControlInfo, 1));
 }
 #endif /* VK_ENABLE_BETA_EXTENSIONS */
 
 #ifdef VK_ENABLE_BETA_EXTENSIONS
 
+template <>
+struct RecordedStruct<VkVideoDecodeInfoKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkVideoDecodeInfoKHR& s) {
+        size_t size = 0;
+        size += RecordedStruct<VkVideoPictureResourceKHR>::NestedSize(s.dstPictureResource);
+        size += RecordedArraySize(s.pSetupReferenceSlot, 1);
+        size += RecordedArraySize(s.pReferenceSlots, s.referenceSlotCount);
+        return size;
+    }
+    static void CopyNested(VkVideoDecodeInfoKHR& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        RecordedStruct<VkVideoPictureResourceKHR>::CopyNested(s.dstPictureResource, writer);
+        s.pSetupReferenceSlot = writer.CopyArray(s.pSetupReferenceSlot, 1);
+        s.pReferenceSlots = writer.CopyArray(s.pReferenceSlots, s.referenceSlotCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdDecodeVideoKHR(
     VkCommandBuffer                             commandBuffer,
     const VkVideoDecodeInfoKHR*                 pFrameInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdDecodeVideoKHR>(kHookCmdDecodeVideoKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pFrameInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdDecodeVideoKHR, RecordArray("pFrameInfo", pFrameInfo, 1));
 }
 #endif /* VK_ENABLE_BETA_EXTENSIONS */
 
@@ -2935,13 +7255,23 @@ static VKAPI_ATTR void VKAPI_CALL CmdBeginRenderingKHR(
     VkCommandBuffer                             commandBuffer,
     const VkRenderingInfo*                      pRenderingInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBeginRenderingKHR>(kHookCmdBeginRenderingKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pRenderingInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBeginRenderingKHR, RecordArray("pRenderingInfo", pRenderingInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdEndRenderingKHR(
     VkCommandBuffer                             commandBuffer)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEndRenderingKHR>(kHookCmdEndRenderingKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEndRenderingKHR);
 }
 
 
@@ -2950,79 +7280,22 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFeatures2KHR(
     VkPhysicalDevice                            physicalDevice,
     VkPhysicalDeviceFeatures2*                  pFeatures)
 {
-    GetPhysicalDeviceFeatures(physicalDevice, &pFeatures->features);
-    uint32_t num_bools = 0; // Count number of VkBool32s in extension structs
-    VkBool32* feat_bools = nullptr;
-    const auto *desc_idx_features = lvl_find_in_chain<VkPhysicalDeviceDescriptorIndexingFeaturesEXT>(pFeatures->pNext);
-    if (desc_idx_features) {
-        const auto bool_size = sizeof(VkPhysicalDeviceDescriptorIndexingFeaturesEXT) - offsetof(VkPhysicalDeviceDescriptorIndexingFeaturesEXT, shaderInputAttachmentArrayDynamicIndexing);
-        num_bools = bool_size/sizeof(VkBool32);
-        feat_bools = (VkBool32*)&desc_idx_features->shaderInputAttachmentArrayDynamicIndexing;
-        SetBoolArrayTrue(feat_bools, num_bools);
-    }
-    const auto *blendop_features = lvl_find_in_chain<VkPhysicalDeviceBlendOperationAdvancedFeaturesEXT>(pFeatures->pNext);
-    if (blendop_features) {
-        const auto bool_size = sizeof(VkPhysicalDeviceBlendOperationAdvancedFeaturesEXT) - offsetof(VkPhysicalDeviceBlendOperationAdvancedFeaturesEXT, advancedBlendCoherentOperations);
-        num_bools = bool_size/sizeof(VkBool32);
-        feat_bools = (VkBool32*)&blendop_features->advancedBlendCoherentOperations;
-        SetBoolArrayTrue(feat_bools, num_bools);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceFeatures2KHR>(kHookGetPhysicalDeviceFeatures2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pFeatures);
     }
+    return GetPhysicalDeviceFeatures2Impl(physicalDevice, pFeatures);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceProperties2KHR(
     VkPhysicalDevice                            physicalDevice,
     VkPhysicalDeviceProperties2*                pProperties)
 {
-    GetPhysicalDeviceProperties(physicalDevice, &pProperties->properties);
-    const auto *desc_idx_props = lvl_find_in_chain<VkPhysicalDeviceDescriptorIndexingPropertiesEXT>(pProperties->pNext);
-    if (desc_idx_props) {
-        VkPhysicalDeviceDescriptorIndexingPropertiesEXT* write_props = (VkPhysicalDeviceDescriptorIndexingPropertiesEXT*)desc_idx_props;
-        write_props->maxUpdateAfterBindDescriptorsInAllPools = 500000;
-        write_props->shaderUniformBufferArrayNonUniformIndexingNative = false;
-        write_props->shaderSampledImageArrayNonUniformIndexingNative = false;
-        write_props->shaderStorageBufferArrayNonUniformIndexingNative = false;
-        write_props->shaderStorageImageArrayNonUniformIndexingNative = false;
-        write_props->shaderInputAttachmentArrayNonUniformIndexingNative = false;
-        write_props->robustBufferAccessUpdateAfterBind = true;
-        write_props->quadDivergentImplicitLod = true;
-        write_props->maxPerStageDescriptorUpdateAfterBindSamplers = 500000;
-        write_props->maxPerStageDescriptorUpdateAfterBindUniformBuffers = 500000;
-        write_props->maxPerStageDescriptorUpdateAfterBindStorageBuffers = 500000;
-        write_props->maxPerStageDescriptorUpdateAfterBindSampledImages = 500000;
-        write_props->maxPerStageDescriptorUpdateAfterBindStorageImages = 500000;
-        write_props->maxPerStageDescriptorUpdateAfterBindInputAttachments = 500000;
-        write_props->maxPerStageUpdateAfterBindResources = 500000;
-        write_props->maxDescriptorSetUpdateAfterBindSamplers = 500000;
-        write_props->maxDescriptorSetUpdateAfterBindUniformBuffers = 96;
-        write_props->maxDescriptorSetUpdateAfterBindUniformBuffersDynamic = 8;
-        write_props->maxDescriptorSetUpdateAfterBindStorageBuffers = 500000;
-        write_props->maxDescriptorSetUpdateAfterBindStorageBuffersDynamic = 4;
-        write_props->maxDescriptorSetUpdateAfterBindSampledImages = 500000;
-        write_props->maxDescriptorSetUpdateAfterBindStorageImages = 500000;
-        write_props->maxDescriptorSetUpdateAfterBindInputAttachments = 500000;
-    }
-
-    const auto *push_descriptor_props = lvl_find_in_chain<VkPhysicalDevicePushDescriptorPropertiesKHR>(pProperties->pNext);
-    if (push_descriptor_props) {
-        VkPhysicalDevicePushDescriptorPropertiesKHR* write_props = (VkPhysicalDevicePushDescriptorPropertiesKHR*)push_descriptor_props;
-        write_props->maxPushDescriptors = 256;
-    }
-
-    const auto *depth_stencil_resolve_props = lvl_find_in_chain<VkPhysicalDeviceDepthStencilResolvePropertiesKHR>(pProperties->pNext);
-    if (depth_stencil_resolve_props) {
-        VkPhysicalDeviceDepthStencilResolvePropertiesKHR* write_props = (VkPhysicalDeviceDepthStencilResolvePropertiesKHR*)depth_stencil_resolve_props;
-        write_props->supportedDepthResolveModes = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT_KHR;
-        write_props->supportedStencilResolveModes = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT_KHR;
-    }
-
-    const auto *fragment_density_map2_props = lvl_find_in_chain<VkPhysicalDeviceFragmentDensityMap2PropertiesEXT>(pProperties->pNext);
-    if (fragment_density_map2_props) {
-        VkPhysicalDeviceFragmentDensityMap2PropertiesEXT* write_props = (VkPhysicalDeviceFragmentDensityMap2PropertiesEXT*)fragment_density_map2_props;
-        write_props->subsampledLoads = VK_FALSE;
-        write_props->subsampledCoarseReconstructionEarlyAccess = VK_FALSE;
-        write_props->maxSubsampledArrayLayers = 2;
-        write_props->maxDescriptorSetSubsampledSamplers = 1;
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceProperties2KHR>(kHookGetPhysicalDeviceProperties2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pProperties);
     }
+    return GetPhysicalDeviceProperties2Impl(physicalDevice, pProperties);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFormatProperties2KHR(
@@ -3030,13 +7303,11 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFormatProperties2KHR(
     VkFormat                                    format,
     VkFormatProperties2*                        pFormatProperties)
 {
-    GetPhysicalDeviceFormatProperties(physicalDevice, format, &pFormatProperties->formatProperties);
-    VkFormatProperties3KHR *props_3 = lvl_find_mod_in_chain<VkFormatProperties3KHR>(pFormatProperties->pNext);
-    if (props_3) {
-        props_3->linearTilingFeatures = pFormatProperties->formatProperties.linearTilingFeatures;
-        props_3->optimalTilingFeatures = pFormatProperties->formatProperties.optimalTilingFeatures;
-        props_3->bufferFeatures = pFormatProperties->formatProperties.bufferFeatures;
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceFormatProperties2KHR>(kHookGetPhysicalDeviceFormatProperties2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, format, pFormatProperties);
     }
+    return GetPhysicalDeviceFormatProperties2Impl(physicalDevice, format, pFormatProperties);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceImageFormatProperties2KHR(
@@ -3044,8 +7315,11 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceImageFormatProperties2KHR
     const VkPhysicalDeviceImageFormatInfo2*     pImageFormatInfo,
     VkImageFormatProperties2*                   pImageFormatProperties)
 {
-    GetPhysicalDeviceImageFormatProperties(physicalDevice, pImageFormatInfo->format, pImageFormatInfo->type, pImageFormatInfo->tiling, pImageFormatInfo->usage, pImageFormatInfo->flags, &pImageFormatProperties->imageFormatProperties);
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceImageFormatProperties2KHR>(kHookGetPhysicalDeviceImageFormatProperties2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pImageFormatInfo, pImageFormatProperties);
+    }
+    return GetPhysicalDeviceImageFormatProperties2Impl(physicalDevice, pImageFormatInfo, pImageFormatProperties);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyProperties2KHR(
@@ -3053,18 +7327,22 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyProperties2KHR(
     uint32_t*                                   pQueueFamilyPropertyCount,
     VkQueueFamilyProperties2*                   pQueueFamilyProperties)
 {
-    if (pQueueFamilyPropertyCount && pQueueFamilyProperties) {
-        GetPhysicalDeviceQueueFamilyProperties(physicalDevice, pQueueFamilyPropertyCount, &pQueueFamilyProperties->queueFamilyProperties);
-    } else {
-        GetPhysicalDeviceQueueFamilyProperties(physicalDevice, pQueueFamilyPropertyCount, nullptr);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceQueueFamilyProperties2KHR>(kHookGetPhysicalDeviceQueueFamilyProperties2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pQueueFamilyPropertyCount, pQueueFamilyProperties);
     }
+    return GetPhysicalDeviceQueueFamilyProperties2Impl(physicalDevice, pQueueFamilyPropertyCount, pQueueFamilyProperties);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMemoryProperties2KHR(
     VkPhysicalDevice                            physicalDevice,
     VkPhysicalDeviceMemoryProperties2*          pMemoryProperties)
 {
-    GetPhysicalDeviceMemoryProperties(physicalDevice, &pMemoryProperties->memoryProperties);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(kHookGetPhysicalDeviceMemoryProperties2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pMemoryProperties);
+    }
+    return GetPhysicalDeviceMemoryProperties2Impl(physicalDevice, pMemoryProperties);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceSparseImageFormatProperties2KHR(
@@ -3073,7 +7351,11 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceSparseImageFormatProperties2K
     uint32_t*                                   pPropertyCount,
     VkSparseImageFormatProperties2*             pProperties)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSparseImageFormatProperties2KHR>(kHookGetPhysicalDeviceSparseImageFormatProperties2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pFormatInfo, pPropertyCount, pProperties);
+    }
+    return GetPhysicalDeviceSparseImageFormatProperties2Impl(physicalDevice, pFormatInfo, pPropertyCount, pProperties);
 }
 
 
@@ -3084,6 +7366,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceGroupPeerMemoryFeaturesKHR(
     uint32_t                                    remoteDeviceIndex,
     VkPeerMemoryFeatureFlags*                   pPeerMemoryFeatures)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceGroupPeerMemoryFeaturesKHR>(kHookGetDeviceGroupPeerMemoryFeaturesKHR)) {
+        const HookScope scope;
+        return hook(device, heapIndex, localDeviceIndex, remoteDeviceIndex, pPeerMemoryFeatures);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -3091,7 +7377,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetDeviceMaskKHR(
     VkCommandBuffer                             commandBuffer,
     uint32_t                                    deviceMask)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDeviceMaskKHR>(kHookCmdSetDeviceMaskKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, deviceMask);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDeviceMaskKHR, deviceMask);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDispatchBaseKHR(
@@ -3103,7 +7394,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDispatchBaseKHR(
     uint32_t                                    groupCountY,
     uint32_t                                    groupCountZ)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDispatchBaseKHR>(kHookCmdDispatchBaseKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
+    }
+    RecordCommand(commandBuffer, kOpCmdDispatchBaseKHR, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
+    return CmdDispatchBaseImpl(commandBuffer, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
 }
 
 
@@ -3113,7 +7409,11 @@ static VKAPI_ATTR void VKAPI_CALL TrimCommandPoolKHR(
     VkCommandPool                               commandPool,
     VkCommandPoolTrimFlags                      flags)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkTrimCommandPoolKHR>(kHookTrimCommandPoolKHR)) {
+        const HookScope scope;
+        return hook(device, commandPool, flags);
+    }
+    return TrimCommandPoolImpl(device, commandPool, flags);
 }
 
 
@@ -3122,6 +7422,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL EnumeratePhysicalDeviceGroupsKHR(
     uint32_t*                                   pPhysicalDeviceGroupCount,
     VkPhysicalDeviceGroupProperties*            pPhysicalDeviceGroupProperties)
 {
+    if (const auto hook = GetHook<PFN_vkEnumeratePhysicalDeviceGroupsKHR>(kHookEnumeratePhysicalDeviceGroupsKHR)) {
+        const HookScope scope;
+        return hook(instance, pPhysicalDeviceGroupCount, pPhysicalDeviceGroupProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3132,7 +7436,11 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceExternalBufferPropertiesKHR(
     const VkPhysicalDeviceExternalBufferInfo*   pExternalBufferInfo,
     VkExternalBufferProperties*                 pExternalBufferProperties)
 {
-    GetPhysicalDeviceExternalBufferProperties(physicalDevice, pExternalBufferInfo, pExternalBufferProperties);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceExternalBufferPropertiesKHR>(kHookGetPhysicalDeviceExternalBufferPropertiesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pExternalBufferInfo, pExternalBufferProperties);
+    }
+    CallInternal(GetPhysicalDeviceExternalBufferProperties, physicalDevice, pExternalBufferInfo, pExternalBufferProperties);
 }
 
 
@@ -3143,6 +7451,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryWin32HandleKHR(
     const VkMemoryGetWin32HandleInfoKHR*        pGetWin32HandleInfo,
     HANDLE*                                     pHandle)
 {
+    if (const auto hook = GetHook<PFN_vkGetMemoryWin32HandleKHR>(kHookGetMemoryWin32HandleKHR)) {
+        const HookScope scope;
+        return hook(device, pGetWin32HandleInfo, pHandle);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3153,6 +7465,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryWin32HandlePropertiesKHR(
     HANDLE                                      handle,
     VkMemoryWin32HandlePropertiesKHR*           pMemoryWin32HandleProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetMemoryWin32HandlePropertiesKHR>(kHookGetMemoryWin32HandlePropertiesKHR)) {
+        const HookScope scope;
+        return hook(device, handleType, handle, pMemoryWin32HandleProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3164,8 +7480,19 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryFdKHR(
     const VkMemoryGetFdInfoKHR*                 pGetFdInfo,
     int*                                        pFd)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetMemoryFdKHR>(kHookGetMemoryFdKHR)) {
+        const HookScope scope;
+        return hook(device, pGetFdInfo, pFd);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.memories.find(pGetFdInfo->memory);
+    // Only memory allocated with VkExportMemoryAllocateInfo or imported from a file descriptor has one to share
+    if (it == objects.memories.end() || it->second.fd < 0) {
+        return VK_ERROR_TOO_MANY_OBJECTS;
+    }
+    *pFd = DuplicateFd(it->second.fd);
+    return *pFd >= 0 ? VK_SUCCESS : VK_ERROR_TOO_MANY_OBJECTS;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryFdPropertiesKHR(
@@ -3174,7 +7501,17 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryFdPropertiesKHR(
     int                                         fd,
     VkMemoryFdPropertiesKHR*                    pMemoryFdProperties)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetMemoryFdPropertiesKHR>(kHookGetMemoryFdPropertiesKHR)) {
+        const HookScope scope;
+        return hook(device, handleType, fd, pMemoryFdProperties);
+    }
+    // Opaque file descriptors cannot be queried: their memory types are those of the allocation that exported them
+    if (handleType == VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT || fd < 0 || GetSharedMemoryFdSize(fd) == 0) {
+        return VK_ERROR_INVALID_EXTERNAL_HANDLE;
+    }
+    VkPhysicalDeviceMemoryProperties memory_properties;
+    CallInternal(GetPhysicalDeviceMemoryProperties, VK_NULL_HANDLE, &memory_properties);
+    pMemoryFdProperties->memoryTypeBits = (1u << memory_properties.memoryTypeCount) - 1;
     return VK_SUCCESS;
 }
 
@@ -3187,7 +7524,11 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceExternalSemaphorePropertiesKH
     const VkPhysicalDeviceExternalSemaphoreInfo* pExternalSemaphoreInfo,
     VkExternalSemaphoreProperties*              pExternalSemaphoreProperties)
 {
-    GetPhysicalDeviceExternalSemaphoreProperties(physicalDevice, pExternalSemaphoreInfo, pExternalSemaphoreProperties);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceExternalSemaphorePropertiesKHR>(kHookGetPhysicalDeviceExternalSemaphorePropertiesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pExternalSemaphoreInfo, pExternalSemaphoreProperties);
+    }
+    CallInternal(GetPhysicalDeviceExternalSemaphoreProperties, physicalDevice, pExternalSemaphoreInfo, pExternalSemaphoreProperties);
 }
 
 
@@ -3197,6 +7538,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL ImportSemaphoreWin32HandleKHR(
     VkDevice                                    device,
     const VkImportSemaphoreWin32HandleInfoKHR*  pImportSemaphoreWin32HandleInfo)
 {
+    if (const auto hook = GetHook<PFN_vkImportSemaphoreWin32HandleKHR>(kHookImportSemaphoreWin32HandleKHR)) {
+        const HookScope scope;
+        return hook(device, pImportSemaphoreWin32HandleInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3206,6 +7551,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetSemaphoreWin32HandleKHR(
     const VkSemaphoreGetWin32HandleInfoKHR*     pGetWin32HandleInfo,
     HANDLE*                                     pHandle)
 {
+    if (const auto hook = GetHook<PFN_vkGetSemaphoreWin32HandleKHR>(kHookGetSemaphoreWin32HandleKHR)) {
+        const HookScope scope;
+        return hook(device, pGetWin32HandleInfo, pHandle);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3216,7 +7565,23 @@ static VKAPI_ATTR VkResult VKAPI_CALL ImportSemaphoreFdKHR(
     VkDevice                                    device,
     const VkImportSemaphoreFdInfoKHR*           pImportSemaphoreFdInfo)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkImportSemaphoreFdKHR>(kHookImportSemaphoreFdKHR)) {
+        const HookScope scope;
+        return hook(device, pImportSemaphoreFdInfo);
+    }
+    auto* device_state = GetDeviceState(device);
+    lock_guard_t lock(device_state->sync_lock);
+    auto& state = GetSemaphoreFdState(*device_state, pImportSemaphoreFdInfo->semaphore);
+    const bool sync_fd = pImportSemaphoreFdInfo->handleType == VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT;
+    if (sync_fd || (pImportSemaphoreFdInfo->flags & VK_SEMAPHORE_IMPORT_TEMPORARY_BIT)) {
+        if (state.temporary_fd >= 0) CloseFd(state.temporary_fd);
+        state.has_temporary_payload = true;
+        state.temporary_fd = pImportSemaphoreFdInfo->fd;
+        state.temporary_is_sync_fd = sync_fd;
+    } else {
+        if (state.permanent_fd >= 0) CloseFd(state.permanent_fd);
+        state.permanent_fd = pImportSemaphoreFdInfo->fd;
+    }
     return VK_SUCCESS;
 }
 
@@ -3225,11 +7590,40 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetSemaphoreFdKHR(
     const VkSemaphoreGetFdInfoKHR*              pGetFdInfo,
     int*                                        pFd)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetSemaphoreFdKHR>(kHookGetSemaphoreFdKHR)) {
+        const HookScope scope;
+        return hook(device, pGetFdInfo, pFd);
+    }
+    if (pGetFdInfo->handleType == VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT) {
+        *pFd = CreateSemaphoreFd(1);
+        return *pFd >= 0 ? VK_SUCCESS : VK_ERROR_TOO_MANY_OBJECTS;
+    }
+    auto* device_state = GetDeviceState(device);
+    lock_guard_t lock(device_state->sync_lock);
+    auto& state = GetSemaphoreFdState(*device_state, pGetFdInfo->semaphore);
+    if (state.permanent_fd < 0) {
+        state.permanent_fd = CreateSemaphoreFd(0);
+        if (state.permanent_fd < 0) {
+            return VK_ERROR_TOO_MANY_OBJECTS;
+        }
+    }
+    *pFd = DuplicateFd(state.permanent_fd);
+    return *pFd >= 0 ? VK_SUCCESS : VK_ERROR_TOO_MANY_OBJECTS;
 }
 
 
+template <>
+struct RecordedStruct<VkWriteDescriptorSet> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkWriteDescriptorSet&) { return 0; }
+    static void CopyNested(VkWriteDescriptorSet& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+        s.pImageInfo = nullptr;
+        s.pBufferInfo = nullptr;
+        s.pTexelBufferView = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdPushDescriptorSetKHR(
     VkCommandBuffer                             commandBuffer,
     VkPipelineBindPoint                         pipelineBindPoint,
@@ -3238,7 +7632,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdPushDescriptorSetKHR(
     uint32_t                                    descriptorWriteCount,
     const VkWriteDescriptorSet*                 pDescriptorWrites)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdPushDescriptorSetKHR>(kHookCmdPushDescriptorSetKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pipelineBindPoint, layout, set, descriptorWriteCount, pDescriptorWrites);
+    }
+    RecordCommand(commandBuffer, kOpCmdPushDescriptorSetKHR, pipelineBindPoint, layout, set, descriptorWriteCount, RecordArray("pDescriptorWrites", pDescriptorWrites, descriptorWriteCount));
+    CountCommand(commandBuffer, kCounterDescriptorBinds);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdPushDescriptorSetWithTemplateKHR(
@@ -3248,7 +7647,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdPushDescriptorSetWithTemplateKHR(
     uint32_t                                    set,
     const void*                                 pData)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdPushDescriptorSetWithTemplateKHR>(kHookCmdPushDescriptorSetWithTemplateKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, descriptorUpdateTemplate, layout, set, pData);
+    }
+    RecordCommand(commandBuffer, kOpCmdPushDescriptorSetWithTemplateKHR, descriptorUpdateTemplate, layout, set);
+    CountCommand(commandBuffer, kCounterDescriptorBinds);
 }
 
 
@@ -3261,8 +7665,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorUpdateTemplateKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkDescriptorUpdateTemplate*                 pDescriptorUpdateTemplate)
 {
-    unique_lock_t lock(global_lock);
-    *pDescriptorUpdateTemplate = (VkDescriptorUpdateTemplate)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateDescriptorUpdateTemplateKHR>(kHookCreateDescriptorUpdateTemplateKHR)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pDescriptorUpdateTemplate);
+    }
+    *pDescriptorUpdateTemplate = (VkDescriptorUpdateTemplate)NewHandle(device, VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE);
+    TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE, 1);
+    AddLiveObject("VkDescriptorUpdateTemplate", (uint64_t)*pDescriptorUpdateTemplate);
     return VK_SUCCESS;
 }
 
@@ -3271,7 +7680,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyDescriptorUpdateTemplateKHR(
     VkDescriptorUpdateTemplate                  descriptorUpdateTemplate,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyDescriptorUpdateTemplateKHR>(kHookDestroyDescriptorUpdateTemplateKHR)) {
+        const HookScope scope;
+        return hook(device, descriptorUpdateTemplate, pAllocator);
+    }
 //Destroy object
+    if (descriptorUpdateTemplate != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE, -1);
+    RemoveLiveObject((uint64_t)descriptorUpdateTemplate);
 }
 
 static VKAPI_ATTR void VKAPI_CALL UpdateDescriptorSetWithTemplateKHR(
@@ -3280,6 +7695,10 @@ static VKAPI_ATTR void VKAPI_CALL UpdateDescriptorSetWithTemplateKHR(
     VkDescriptorUpdateTemplate                  descriptorUpdateTemplate,
     const void*                                 pData)
 {
+    if (const auto hook = GetHook<PFN_vkUpdateDescriptorSetWithTemplateKHR>(kHookUpdateDescriptorSetWithTemplateKHR)) {
+        const HookScope scope;
+        return hook(device, descriptorSet, descriptorUpdateTemplate, pData);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -3291,8 +7710,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass2KHR(
     const VkAllocationCallbacks*                pAllocator,
     VkRenderPass*                               pRenderPass)
 {
-    unique_lock_t lock(global_lock);
-    *pRenderPass = (VkRenderPass)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateRenderPass2KHR>(kHookCreateRenderPass2KHR)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pRenderPass);
+    }
+    *pRenderPass = (VkRenderPass)NewHandle(device, VK_OBJECT_TYPE_RENDER_PASS);
+    TrackObjects(VK_OBJECT_TYPE_RENDER_PASS, 1);
+    AddLiveObject("VkRenderPass", (uint64_t)*pRenderPass);
     return VK_SUCCESS;
 }
 
@@ -3301,7 +7725,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBeginRenderPass2KHR(
     const VkRenderPassBeginInfo*                pRenderPassBegin,
     const VkSubpassBeginInfo*                   pSubpassBeginInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBeginRenderPass2KHR>(kHookCmdBeginRenderPass2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pRenderPassBegin, pSubpassBeginInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBeginRenderPass2KHR, RecordArray("pRenderPassBegin", pRenderPassBegin, 1), RecordArray("pSubpassBeginInfo", pSubpassBeginInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdNextSubpass2KHR(
@@ -3309,14 +7738,24 @@ static VKAPI_ATTR void VKAPI_CALL CmdNextSubpass2KHR(
     const VkSubpassBeginInfo*                   pSubpassBeginInfo,
     const VkSubpassEndInfo*                     pSubpassEndInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdNextSubpass2KHR>(kHookCmdNextSubpass2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pSubpassBeginInfo, pSubpassEndInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdNextSubpass2KHR, RecordArray("pSubpassBeginInfo", pSubpassBeginInfo, 1), RecordArray("pSubpassEndInfo", pSubpassEndInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdEndRenderPass2KHR(
     VkCommandBuffer                             commandBuffer,
     const VkSubpassEndInfo*                     pSubpassEndInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEndRenderPass2KHR>(kHookCmdEndRenderPass2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pSubpassEndInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEndRenderPass2KHR, RecordArray("pSubpassEndInfo", pSubpassEndInfo, 1));
 }
 
 
@@ -3324,6 +7763,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetSwapchainStatusKHR(
     VkDevice                                    device,
     VkSwapchainKHR                              swapchain)
 {
+    if (const auto hook = GetHook<PFN_vkGetSwapchainStatusKHR>(kHookGetSwapchainStatusKHR)) {
+        const HookScope scope;
+        return hook(device, swapchain);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3334,7 +7777,11 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceExternalFencePropertiesKHR(
     const VkPhysicalDeviceExternalFenceInfo*    pExternalFenceInfo,
     VkExternalFenceProperties*                  pExternalFenceProperties)
 {
-    GetPhysicalDeviceExternalFenceProperties(physicalDevice, pExternalFenceInfo, pExternalFenceProperties);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceExternalFencePropertiesKHR>(kHookGetPhysicalDeviceExternalFencePropertiesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pExternalFenceInfo, pExternalFenceProperties);
+    }
+    CallInternal(GetPhysicalDeviceExternalFenceProperties, physicalDevice, pExternalFenceInfo, pExternalFenceProperties);
 }
 
 
@@ -3344,6 +7791,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL ImportFenceWin32HandleKHR(
     VkDevice                                    device,
     const VkImportFenceWin32HandleInfoKHR*      pImportFenceWin32HandleInfo)
 {
+    if (const auto hook = GetHook<PFN_vkImportFenceWin32HandleKHR>(kHookImportFenceWin32HandleKHR)) {
+        const HookScope scope;
+        return hook(device, pImportFenceWin32HandleInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3353,6 +7804,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetFenceWin32HandleKHR(
     const VkFenceGetWin32HandleInfoKHR*         pGetWin32HandleInfo,
     HANDLE*                                     pHandle)
 {
+    if (const auto hook = GetHook<PFN_vkGetFenceWin32HandleKHR>(kHookGetFenceWin32HandleKHR)) {
+        const HookScope scope;
+        return hook(device, pGetWin32HandleInfo, pHandle);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3363,6 +7818,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL ImportFenceFdKHR(
     VkDevice                                    device,
     const VkImportFenceFdInfoKHR*               pImportFenceFdInfo)
 {
+    if (const auto hook = GetHook<PFN_vkImportFenceFdKHR>(kHookImportFenceFdKHR)) {
+        const HookScope scope;
+        return hook(device, pImportFenceFdInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3372,6 +7831,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetFenceFdKHR(
     const VkFenceGetFdInfoKHR*                  pGetFdInfo,
     int*                                        pFd)
 {
+    if (const auto hook = GetHook<PFN_vkGetFenceFdKHR>(kHookGetFenceFdKHR)) {
+        const HookScope scope;
+        return hook(device, pGetFdInfo, pFd);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3384,8 +7847,32 @@ static VKAPI_ATTR VkResult VKAPI_CALL EnumeratePhysicalDeviceQueueFamilyPerforma
     VkPerformanceCounterKHR*                    pCounters,
     VkPerformanceCounterDescriptionKHR*         pCounterDescriptions)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR>(kHookEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, queueFamilyIndex, pCounterCount, pCounters, pCounterDescriptions);
+    }
+    if (!pCounters) {
+        *pCounterCount = kPerformanceCounterCount;
+        return VK_SUCCESS;
+    }
+    const uint32_t count = (std::min)(*pCounterCount, uint32_t(kPerformanceCounterCount));
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto& info = performance_counter_infos[i];
+        pCounters[i].unit = info.unit;
+        pCounters[i].scope = VK_PERFORMANCE_COUNTER_SCOPE_COMMAND_BUFFER_KHR;
+        pCounters[i].storage = VK_PERFORMANCE_COUNTER_STORAGE_UINT64_KHR;
+        std::fill(std::begin(pCounters[i].uuid), std::end(pCounters[i].uuid), uint8_t(0));
+        std::copy_n("vkmock", 6, pCounters[i].uuid);
+        pCounters[i].uuid[VK_UUID_SIZE - 1] = static_cast<uint8_t>(i);
+        if (pCounterDescriptions) {
+            pCounterDescriptions[i].flags = 0;
+            strncpy(pCounterDescriptions[i].name, info.name, VK_MAX_DESCRIPTION_SIZE);
+            strncpy(pCounterDescriptions[i].category, "Commands", VK_MAX_DESCRIPTION_SIZE);
+            strncpy(pCounterDescriptions[i].description, info.description, VK_MAX_DESCRIPTION_SIZE);
+        }
+    }
+    *pCounterCount = count;
+    return count < kPerformanceCounterCount ? VK_INCOMPLETE : VK_SUCCESS;
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR(
@@ -3393,13 +7880,22 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyPerformanceQueryPa
     const VkQueryPoolPerformanceCreateInfoKHR*  pPerformanceQueryCreateInfo,
     uint32_t*                                   pNumPasses)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR>(kHookGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pPerformanceQueryCreateInfo, pNumPasses);
+    }
+    // All counters are collected together
+    *pNumPasses = 1;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL AcquireProfilingLockKHR(
     VkDevice                                    device,
     const VkAcquireProfilingLockInfoKHR*        pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkAcquireProfilingLockKHR>(kHookAcquireProfilingLockKHR)) {
+        const HookScope scope;
+        return hook(device, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3407,6 +7903,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL AcquireProfilingLockKHR(
 static VKAPI_ATTR void VKAPI_CALL ReleaseProfilingLockKHR(
     VkDevice                                    device)
 {
+    if (const auto hook = GetHook<PFN_vkReleaseProfilingLockKHR>(kHookReleaseProfilingLockKHR)) {
+        const HookScope scope;
+        return hook(device);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -3417,7 +7917,11 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceCapabilities2KHR(
     const VkPhysicalDeviceSurfaceInfo2KHR*      pSurfaceInfo,
     VkSurfaceCapabilities2KHR*                  pSurfaceCapabilities)
 {
-    GetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, pSurfaceInfo->surface, &pSurfaceCapabilities->surfaceCapabilities);
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSurfaceCapabilities2KHR>(kHookGetPhysicalDeviceSurfaceCapabilities2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pSurfaceInfo, pSurfaceCapabilities);
+    }
+    CallInternal(GetPhysicalDeviceSurfaceCapabilitiesKHR, physicalDevice, pSurfaceInfo->surface, &pSurfaceCapabilities->surfaceCapabilities);
     return VK_SUCCESS;
 }
 
@@ -3427,6 +7931,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceFormats2KHR(
     uint32_t*                                   pSurfaceFormatCount,
     VkSurfaceFormat2KHR*                        pSurfaceFormats)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSurfaceFormats2KHR>(kHookGetPhysicalDeviceSurfaceFormats2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pSurfaceInfo, pSurfaceFormatCount, pSurfaceFormats);
+    }
     // Currently always say that RGBA8 & BGRA8 are supported
     if (!pSurfaceFormats) {
         *pSurfaceFormatCount = 2;
@@ -3455,6 +7963,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceDisplayProperties2KHR(
     uint32_t*                                   pPropertyCount,
     VkDisplayProperties2KHR*                    pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceDisplayProperties2KHR>(kHookGetPhysicalDeviceDisplayProperties2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pPropertyCount, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3464,6 +7976,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceDisplayPlaneProperties2KH
     uint32_t*                                   pPropertyCount,
     VkDisplayPlaneProperties2KHR*               pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceDisplayPlaneProperties2KHR>(kHookGetPhysicalDeviceDisplayPlaneProperties2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pPropertyCount, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3474,6 +7990,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetDisplayModeProperties2KHR(
     uint32_t*                                   pPropertyCount,
     VkDisplayModeProperties2KHR*                pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetDisplayModeProperties2KHR>(kHookGetDisplayModeProperties2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, display, pPropertyCount, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3483,6 +8003,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetDisplayPlaneCapabilities2KHR(
     const VkDisplayPlaneInfo2KHR*               pDisplayPlaneInfo,
     VkDisplayPlaneCapabilities2KHR*             pCapabilities)
 {
+    if (const auto hook = GetHook<PFN_vkGetDisplayPlaneCapabilities2KHR>(kHookGetDisplayPlaneCapabilities2KHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pDisplayPlaneInfo, pCapabilities);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3496,7 +8020,11 @@ static VKAPI_ATTR void VKAPI_CALL GetImageMemoryRequirements2KHR(
     const VkImageMemoryRequirementsInfo2*       pInfo,
     VkMemoryRequirements2*                      pMemoryRequirements)
 {
-    GetImageMemoryRequirements(device, pInfo->image, &pMemoryRequirements->memoryRequirements);
+    if (const auto hook = GetHook<PFN_vkGetImageMemoryRequirements2KHR>(kHookGetImageMemoryRequirements2KHR)) {
+        const HookScope scope;
+        return hook(device, pInfo, pMemoryRequirements);
+    }
+    return GetImageMemoryRequirements2Impl(device, pInfo, pMemoryRequirements);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetBufferMemoryRequirements2KHR(
@@ -3504,7 +8032,11 @@ static VKAPI_ATTR void VKAPI_CALL GetBufferMemoryRequirements2KHR(
     const VkBufferMemoryRequirementsInfo2*      pInfo,
     VkMemoryRequirements2*                      pMemoryRequirements)
 {
-    GetBufferMemoryRequirements(device, pInfo->buffer, &pMemoryRequirements->memoryRequirements);
+    if (const auto hook = GetHook<PFN_vkGetBufferMemoryRequirements2KHR>(kHookGetBufferMemoryRequirements2KHR)) {
+        const HookScope scope;
+        return hook(device, pInfo, pMemoryRequirements);
+    }
+    return GetBufferMemoryRequirements2Impl(device, pInfo, pMemoryRequirements);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetImageSparseMemoryRequirements2KHR(
@@ -3513,7 +8045,11 @@ static VKAPI_ATTR void VKAPI_CALL GetImageSparseMemoryRequirements2KHR(
     uint32_t*                                   pSparseMemoryRequirementCount,
     VkSparseImageMemoryRequirements2*           pSparseMemoryRequirements)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetImageSparseMemoryRequirements2KHR>(kHookGetImageSparseMemoryRequirements2KHR)) {
+        const HookScope scope;
+        return hook(device, pInfo, pSparseMemoryRequirementCount, pSparseMemoryRequirements);
+    }
+    return GetImageSparseMemoryRequirements2Impl(device, pInfo, pSparseMemoryRequirementCount, pSparseMemoryRequirements);
 }
 
 
@@ -3524,8 +8060,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateSamplerYcbcrConversionKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkSamplerYcbcrConversion*                   pYcbcrConversion)
 {
-    unique_lock_t lock(global_lock);
-    *pYcbcrConversion = (VkSamplerYcbcrConversion)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateSamplerYcbcrConversionKHR>(kHookCreateSamplerYcbcrConversionKHR)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pYcbcrConversion);
+    }
+    *pYcbcrConversion = (VkSamplerYcbcrConversion)NewHandle(device, VK_OBJECT_TYPE_SAMPLER_YCBCR_CONVERSION);
+    TrackObjects(VK_OBJECT_TYPE_SAMPLER_YCBCR_CONVERSION, 1);
+    AddLiveObject("VkSamplerYcbcrConversion", (uint64_t)*pYcbcrConversion);
     return VK_SUCCESS;
 }
 
@@ -3534,7 +8075,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroySamplerYcbcrConversionKHR(
     VkSamplerYcbcrConversion                    ycbcrConversion,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroySamplerYcbcrConversionKHR>(kHookDestroySamplerYcbcrConversionKHR)) {
+        const HookScope scope;
+        return hook(device, ycbcrConversion, pAllocator);
+    }
 //Destroy object
+    if (ycbcrConversion != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_SAMPLER_YCBCR_CONVERSION, -1);
+    RemoveLiveObject((uint64_t)ycbcrConversion);
 }
 
 
@@ -3543,8 +8090,11 @@ static VKAPI_ATTR VkResult VKAPI_CALL BindBufferMemory2KHR(
     uint32_t                                    bindInfoCount,
     const VkBindBufferMemoryInfo*               pBindInfos)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkBindBufferMemory2KHR>(kHookBindBufferMemory2KHR)) {
+        const HookScope scope;
+        return hook(device, bindInfoCount, pBindInfos);
+    }
+    return BindBufferMemory2Impl(device, bindInfoCount, pBindInfos);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory2KHR(
@@ -3552,8 +8102,11 @@ static VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory2KHR(
     uint32_t                                    bindInfoCount,
     const VkBindImageMemoryInfo*                pBindInfos)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkBindImageMemory2KHR>(kHookBindImageMemory2KHR)) {
+        const HookScope scope;
+        return hook(device, bindInfoCount, pBindInfos);
+    }
+    return BindImageMemory2Impl(device, bindInfoCount, pBindInfos);
 }
 
 #ifdef VK_ENABLE_BETA_EXTENSIONS
@@ -3565,6 +8118,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDescriptorSetLayoutSupportKHR(
     const VkDescriptorSetLayoutCreateInfo*      pCreateInfo,
     VkDescriptorSetLayoutSupport*               pSupport)
 {
+    if (const auto hook = GetHook<PFN_vkGetDescriptorSetLayoutSupportKHR>(kHookGetDescriptorSetLayoutSupportKHR)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pSupport);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -3578,7 +8135,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawIndirectCountKHR(
     uint32_t                                    maxDrawCount,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawIndirectCountKHR>(kHookCmdDrawIndirectCountKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawIndirectCountKHR, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    return CmdDrawIndirectCountImpl(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexedIndirectCountKHR(
@@ -3590,7 +8152,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexedIndirectCountKHR(
     uint32_t                                    maxDrawCount,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawIndexedIndirectCountKHR>(kHookCmdDrawIndexedIndirectCountKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawIndexedIndirectCountKHR, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    return CmdDrawIndexedIndirectCountImpl(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
 }
 
 
@@ -3608,6 +8175,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetSemaphoreCounterValueKHR(
     VkSemaphore                                 semaphore,
     uint64_t*                                   pValue)
 {
+    if (const auto hook = GetHook<PFN_vkGetSemaphoreCounterValueKHR>(kHookGetSemaphoreCounterValueKHR)) {
+        const HookScope scope;
+        return hook(device, semaphore, pValue);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3617,6 +8188,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL WaitSemaphoresKHR(
     const VkSemaphoreWaitInfo*                  pWaitInfo,
     uint64_t                                    timeout)
 {
+    if (const auto hook = GetHook<PFN_vkWaitSemaphoresKHR>(kHookWaitSemaphoresKHR)) {
+        const HookScope scope;
+        return hook(device, pWaitInfo, timeout);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3625,6 +8200,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL SignalSemaphoreKHR(
     VkDevice                                    device,
     const VkSemaphoreSignalInfo*                pSignalInfo)
 {
+    if (const auto hook = GetHook<PFN_vkSignalSemaphoreKHR>(kHookSignalSemaphoreKHR)) {
+        const HookScope scope;
+        return hook(device, pSignalInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3637,6 +8216,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceFragmentShadingRatesKHR(
     uint32_t*                                   pFragmentShadingRateCount,
     VkPhysicalDeviceFragmentShadingRateKHR*     pFragmentShadingRates)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceFragmentShadingRatesKHR>(kHookGetPhysicalDeviceFragmentShadingRatesKHR)) {
+        const HookScope scope;
+        return hook(physicalDevice, pFragmentShadingRateCount, pFragmentShadingRates);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3646,7 +8229,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetFragmentShadingRateKHR(
     const VkExtent2D*                           pFragmentSize,
     const VkFragmentShadingRateCombinerOpKHR    combinerOps[2])
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetFragmentShadingRateKHR>(kHookCmdSetFragmentShadingRateKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pFragmentSize, combinerOps);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetFragmentShadingRateKHR, RecordArray("pFragmentSize", pFragmentSize, 1), RecordArray("combinerOps", combinerOps, 2));
 }
 
 
@@ -3659,6 +8247,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL WaitForPresentKHR(
     uint64_t                                    presentId,
     uint64_t                                    timeout)
 {
+    if (const auto hook = GetHook<PFN_vkWaitForPresentKHR>(kHookWaitForPresentKHR)) {
+        const HookScope scope;
+        return hook(device, swapchain, presentId, timeout);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3669,14 +8261,21 @@ static VKAPI_ATTR VkDeviceAddress VKAPI_CALL GetBufferDeviceAddressKHR(
     VkDevice                                    device,
     const VkBufferDeviceAddressInfo*            pInfo)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetBufferDeviceAddressKHR>(kHookGetBufferDeviceAddressKHR)) {
+        const HookScope scope;
+        return hook(device, pInfo);
+    }
+    return GetBufferDeviceAddressImpl(device, pInfo);
 }
 
 static VKAPI_ATTR uint64_t VKAPI_CALL GetBufferOpaqueCaptureAddressKHR(
     VkDevice                                    device,
     const VkBufferDeviceAddressInfo*            pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkGetBufferOpaqueCaptureAddressKHR>(kHookGetBufferOpaqueCaptureAddressKHR)) {
+        const HookScope scope;
+        return hook(device, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3685,6 +8284,10 @@ static VKAPI_ATTR uint64_t VKAPI_CALL GetDeviceMemoryOpaqueCaptureAddressKHR(
     VkDevice                                    device,
     const VkDeviceMemoryOpaqueCaptureAddressInfo* pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceMemoryOpaqueCaptureAddressKHR>(kHookGetDeviceMemoryOpaqueCaptureAddressKHR)) {
+        const HookScope scope;
+        return hook(device, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3695,8 +8298,16 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDeferredOperationKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkDeferredOperationKHR*                     pDeferredOperation)
 {
-    unique_lock_t lock(global_lock);
-    *pDeferredOperation = (VkDeferredOperationKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateDeferredOperationKHR>(kHookCreateDeferredOperationKHR)) {
+        const HookScope scope;
+        return hook(device, pAllocator, pDeferredOperation);
+    }
+    *pDeferredOperation = (VkDeferredOperationKHR)NewHandle(device, VK_OBJECT_TYPE_DEFERRED_OPERATION_KHR);
+    TrackObjects(VK_OBJECT_TYPE_DEFERRED_OPERATION_KHR, 1);
+    AddLiveObject("VkDeferredOperationKHR", (uint64_t)*pDeferredOperation);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.deferred_operations[*pDeferredOperation] = std::make_shared<DeferredOperationState>();
     return VK_SUCCESS;
 }
 
@@ -3705,22 +8316,44 @@ static VKAPI_ATTR void VKAPI_CALL DestroyDeferredOperationKHR(
     VkDeferredOperationKHR                      operation,
     const VkAllocationCallbacks*                pAllocator)
 {
-//Destroy object
+    if (const auto hook = GetHook<PFN_vkDestroyDeferredOperationKHR>(kHookDestroyDeferredOperationKHR)) {
+        const HookScope scope;
+        return hook(device, operation, pAllocator);
+    }
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        objects.deferred_operations.erase(operation);
+    }
+    if (operation != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_DEFERRED_OPERATION_KHR, -1);
+    RemoveLiveObject((uint64_t)operation);
 }
 
 static VKAPI_ATTR uint32_t VKAPI_CALL GetDeferredOperationMaxConcurrencyKHR(
     VkDevice                                    device,
     VkDeferredOperationKHR                      operation)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetDeferredOperationMaxConcurrencyKHR>(kHookGetDeferredOperationMaxConcurrencyKHR)) {
+        const HookScope scope;
+        return hook(device, operation);
+    }
+    // Every chunk that has not been claimed yet could run on its own thread
+    const auto state = GetDeferredOperationState(device, operation);
+    if (!state) return 0;
+    const uint32_t next_chunk = state->next_chunk.load(std::memory_order_relaxed);
+    return next_chunk < state->chunk_count ? state->chunk_count - next_chunk : 0;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetDeferredOperationResultKHR(
     VkDevice                                    device,
     VkDeferredOperationKHR                      operation)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetDeferredOperationResultKHR>(kHookGetDeferredOperationResultKHR)) {
+        const HookScope scope;
+        return hook(device, operation);
+    }
+    const auto state = GetDeferredOperationState(device, operation);
+    if (state && state->finished_chunks.load(std::memory_order_acquire) < state->chunk_count) return VK_NOT_READY;
     return VK_SUCCESS;
 }
 
@@ -3728,8 +8361,20 @@ static VKAPI_ATTR VkResult VKAPI_CALL DeferredOperationJoinKHR(
     VkDevice                                    device,
     VkDeferredOperationKHR                      operation)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkDeferredOperationJoinKHR>(kHookDeferredOperationJoinKHR)) {
+        const HookScope scope;
+        return hook(device, operation);
+    }
+    const auto state = GetDeferredOperationState(device, operation);
+    if (!state) return VK_SUCCESS;
+    while (state->next_chunk.load(std::memory_order_relaxed) < state->chunk_count) {
+        const uint32_t chunk = state->next_chunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= state->chunk_count) break;
+        CompilePipelineChunk();
+        state->finished_chunks.fetch_add(1, std::memory_order_acq_rel);
+    }
+    // Threads that run out of chunks while others still work on theirs are done; the last one completes the operation
+    return state->finished_chunks.load(std::memory_order_acquire) == state->chunk_count ? VK_SUCCESS : VK_THREAD_DONE_KHR;
 }
 
 
@@ -3739,6 +8384,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPipelineExecutablePropertiesKHR(
     uint32_t*                                   pExecutableCount,
     VkPipelineExecutablePropertiesKHR*          pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPipelineExecutablePropertiesKHR>(kHookGetPipelineExecutablePropertiesKHR)) {
+        const HookScope scope;
+        return hook(device, pPipelineInfo, pExecutableCount, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3749,6 +8398,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPipelineExecutableStatisticsKHR(
     uint32_t*                                   pStatisticCount,
     VkPipelineExecutableStatisticKHR*           pStatistics)
 {
+    if (const auto hook = GetHook<PFN_vkGetPipelineExecutableStatisticsKHR>(kHookGetPipelineExecutableStatisticsKHR)) {
+        const HookScope scope;
+        return hook(device, pExecutableInfo, pStatisticCount, pStatistics);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3759,6 +8412,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPipelineExecutableInternalRepresentatio
     uint32_t*                                   pInternalRepresentationCount,
     VkPipelineExecutableInternalRepresentationKHR* pInternalRepresentations)
 {
+    if (const auto hook = GetHook<PFN_vkGetPipelineExecutableInternalRepresentationsKHR>(kHookGetPipelineExecutableInternalRepresentationsKHR)) {
+        const HookScope scope;
+        return hook(device, pExecutableInfo, pInternalRepresentationCount, pInternalRepresentations);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3769,11 +8426,34 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPipelineExecutableInternalRepresentatio
 
 #ifdef VK_ENABLE_BETA_EXTENSIONS
 
+template <>
+struct RecordedStruct<VkVideoEncodeInfoKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkVideoEncodeInfoKHR& s) {
+        size_t size = 0;
+        size += RecordedStruct<VkVideoPictureResourceKHR>::NestedSize(s.srcPictureResource);
+        size += RecordedArraySize(s.pSetupReferenceSlot, 1);
+        size += RecordedArraySize(s.pReferenceSlots, s.referenceSlotCount);
+        return size;
+    }
+    static void CopyNested(VkVideoEncodeInfoKHR& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        RecordedStruct<VkVideoPictureResourceKHR>::CopyNested(s.srcPictureResource, writer);
+        s.pSetupReferenceSlot = writer.CopyArray(s.pSetupReferenceSlot, 1);
+        s.pReferenceSlots = writer.CopyArray(s.pReferenceSlots, s.referenceSlotCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdEncodeVideoKHR(
     VkCommandBuffer                             commandBuffer,
     const VkVideoEncodeInfoKHR*                 pEncodeInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEncodeVideoKHR>(kHookCmdEncodeVideoKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pEncodeInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEncodeVideoKHR, RecordArray("pEncodeInfo", pEncodeInfo, 1));
 }
 #endif /* VK_ENABLE_BETA_EXTENSIONS */
 
@@ -3783,7 +8463,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetEvent2KHR(
     VkEvent                                     event,
     const VkDependencyInfo*                     pDependencyInfo)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdSetEvent2KHR>(kHookCmdSetEvent2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, event, pDependencyInfo);
+    }
+    RecordCommand(commandBuffer, kOpCmdSetEvent2KHR, event, RecordArray("pDependencyInfo", pDependencyInfo, 1));
+    return CmdSetEvent2Impl(commandBuffer, event, pDependencyInfo);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdResetEvent2KHR(
@@ -3791,7 +8476,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdResetEvent2KHR(
     VkEvent                                     event,
     VkPipelineStageFlags2                       stageMask)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdResetEvent2KHR>(kHookCmdResetEvent2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, event, stageMask);
+    }
+    RecordCommand(commandBuffer, kOpCmdResetEvent2KHR, event, stageMask);
+    return CmdResetEvent2Impl(commandBuffer, event, stageMask);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdWaitEvents2KHR(
@@ -3800,14 +8490,24 @@ static VKAPI_ATTR void VKAPI_CALL CmdWaitEvents2KHR(
     const VkEvent*                              pEvents,
     const VkDependencyInfo*                     pDependencyInfos)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdWaitEvents2KHR>(kHookCmdWaitEvents2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, eventCount, pEvents, pDependencyInfos);
+    }
+    RecordCommand(commandBuffer, kOpCmdWaitEvents2KHR, eventCount, RecordArray("pEvents", pEvents, eventCount), RecordArray("pDependencyInfos", pDependencyInfos, eventCount));
+    return CmdWaitEvents2Impl(commandBuffer, eventCount, pEvents, pDependencyInfos);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdPipelineBarrier2KHR(
     VkCommandBuffer                             commandBuffer,
     const VkDependencyInfo*                     pDependencyInfo)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdPipelineBarrier2KHR>(kHookCmdPipelineBarrier2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pDependencyInfo);
+    }
+    RecordCommand(commandBuffer, kOpCmdPipelineBarrier2KHR, RecordArray("pDependencyInfo", pDependencyInfo, 1));
+    return CmdPipelineBarrier2Impl(commandBuffer, pDependencyInfo);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdWriteTimestamp2KHR(
@@ -3816,7 +8516,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdWriteTimestamp2KHR(
     VkQueryPool                                 queryPool,
     uint32_t                                    query)
 {
+    if (const auto hook = GetHook<PFN_vkCmdWriteTimestamp2KHR>(kHookCmdWriteTimestamp2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, stage, queryPool, query);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdWriteTimestamp2KHR, stage, queryPool, query);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL QueueSubmit2KHR(
@@ -3825,8 +8530,11 @@ static VKAPI_ATTR VkResult VKAPI_CALL QueueSubmit2KHR(
     const VkSubmitInfo2*                        pSubmits,
     VkFence                                     fence)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkQueueSubmit2KHR>(kHookQueueSubmit2KHR)) {
+        const HookScope scope;
+        return hook(queue, submitCount, pSubmits, fence);
+    }
+    return QueueSubmit2Impl(queue, submitCount, pSubmits, fence);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdWriteBufferMarker2AMD(
@@ -3836,7 +8544,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdWriteBufferMarker2AMD(
     VkDeviceSize                                dstOffset,
     uint32_t                                    marker)
 {
+    if (const auto hook = GetHook<PFN_vkCmdWriteBufferMarker2AMD>(kHookCmdWriteBufferMarker2AMD)) {
+        const HookScope scope;
+        return hook(commandBuffer, stage, dstBuffer, dstOffset, marker);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdWriteBufferMarker2AMD, stage, dstBuffer, dstOffset, marker);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetQueueCheckpointData2NV(
@@ -3844,6 +8557,10 @@ static VKAPI_ATTR void VKAPI_CALL GetQueueCheckpointData2NV(
     uint32_t*                                   pCheckpointDataCount,
     VkCheckpointData2NV*                        pCheckpointData)
 {
+    if (const auto hook = GetHook<PFN_vkGetQueueCheckpointData2NV>(kHookGetQueueCheckpointData2NV)) {
+        const HookScope scope;
+        return hook(queue, pCheckpointDataCount, pCheckpointData);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -3855,42 +8572,72 @@ static VKAPI_ATTR void VKAPI_CALL CmdCopyBuffer2KHR(
     VkCommandBuffer                             commandBuffer,
     const VkCopyBufferInfo2*                    pCopyBufferInfo)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdCopyBuffer2KHR>(kHookCmdCopyBuffer2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pCopyBufferInfo);
+    }
+    RecordCommand(commandBuffer, kOpCmdCopyBuffer2KHR, RecordArray("pCopyBufferInfo", pCopyBufferInfo, 1));
+    return CmdCopyBuffer2Impl(commandBuffer, pCopyBufferInfo);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdCopyImage2KHR(
     VkCommandBuffer                             commandBuffer,
     const VkCopyImageInfo2*                     pCopyImageInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyImage2KHR>(kHookCmdCopyImage2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pCopyImageInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyImage2KHR, RecordArray("pCopyImageInfo", pCopyImageInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage2KHR(
     VkCommandBuffer                             commandBuffer,
     const VkCopyBufferToImageInfo2*             pCopyBufferToImageInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyBufferToImage2KHR>(kHookCmdCopyBufferToImage2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pCopyBufferToImageInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyBufferToImage2KHR, RecordArray("pCopyBufferToImageInfo", pCopyBufferToImageInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer2KHR(
     VkCommandBuffer                             commandBuffer,
     const VkCopyImageToBufferInfo2*             pCopyImageToBufferInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyImageToBuffer2KHR>(kHookCmdCopyImageToBuffer2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pCopyImageToBufferInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyImageToBuffer2KHR, RecordArray("pCopyImageToBufferInfo", pCopyImageToBufferInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBlitImage2KHR(
     VkCommandBuffer                             commandBuffer,
     const VkBlitImageInfo2*                     pBlitImageInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBlitImage2KHR>(kHookCmdBlitImage2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pBlitImageInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBlitImage2KHR, RecordArray("pBlitImageInfo", pBlitImageInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdResolveImage2KHR(
     VkCommandBuffer                             commandBuffer,
     const VkResolveImageInfo2*                  pResolveImageInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdResolveImage2KHR>(kHookCmdResolveImage2KHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pResolveImageInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdResolveImage2KHR, RecordArray("pResolveImageInfo", pResolveImageInfo, 1));
 }
 
 
@@ -3900,6 +8647,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceBufferMemoryRequirementsKHR(
     const VkDeviceBufferMemoryRequirements*     pInfo,
     VkMemoryRequirements2*                      pMemoryRequirements)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceBufferMemoryRequirementsKHR>(kHookGetDeviceBufferMemoryRequirementsKHR)) {
+        const HookScope scope;
+        return hook(device, pInfo, pMemoryRequirements);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -3908,6 +8659,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceImageMemoryRequirementsKHR(
     const VkDeviceImageMemoryRequirements*      pInfo,
     VkMemoryRequirements2*                      pMemoryRequirements)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceImageMemoryRequirementsKHR>(kHookGetDeviceImageMemoryRequirementsKHR)) {
+        const HookScope scope;
+        return hook(device, pInfo, pMemoryRequirements);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -3917,6 +8672,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceImageSparseMemoryRequirementsKHR(
     uint32_t*                                   pSparseMemoryRequirementCount,
     VkSparseImageMemoryRequirements2*           pSparseMemoryRequirements)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceImageSparseMemoryRequirementsKHR>(kHookGetDeviceImageSparseMemoryRequirementsKHR)) {
+        const HookScope scope;
+        return hook(device, pInfo, pSparseMemoryRequirementCount, pSparseMemoryRequirements);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -3927,8 +8686,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDebugReportCallbackEXT(
     const VkAllocationCallbacks*                pAllocator,
     VkDebugReportCallbackEXT*                   pCallback)
 {
-    unique_lock_t lock(global_lock);
-    *pCallback = (VkDebugReportCallbackEXT)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateDebugReportCallbackEXT>(kHookCreateDebugReportCallbackEXT)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pCallback);
+    }
+    *pCallback = (VkDebugReportCallbackEXT)NewHandle(instance, VK_OBJECT_TYPE_DEBUG_REPORT_CALLBACK_EXT);
+    TrackObjects(VK_OBJECT_TYPE_DEBUG_REPORT_CALLBACK_EXT, 1);
+    AddLiveObject("VkDebugReportCallbackEXT", (uint64_t)*pCallback);
     return VK_SUCCESS;
 }
 
@@ -3937,7 +8701,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyDebugReportCallbackEXT(
     VkDebugReportCallbackEXT                    callback,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyDebugReportCallbackEXT>(kHookDestroyDebugReportCallbackEXT)) {
+        const HookScope scope;
+        return hook(instance, callback, pAllocator);
+    }
 //Destroy object
+    if (callback != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_DEBUG_REPORT_CALLBACK_EXT, -1);
+    RemoveLiveObject((uint64_t)callback);
 }
 
 static VKAPI_ATTR void VKAPI_CALL DebugReportMessageEXT(
@@ -3950,6 +8720,10 @@ static VKAPI_ATTR void VKAPI_CALL DebugReportMessageEXT(
     const char*                                 pLayerPrefix,
     const char*                                 pMessage)
 {
+    if (const auto hook = GetHook<PFN_vkDebugReportMessageEXT>(kHookDebugReportMessageEXT)) {
+        const HookScope scope;
+        return hook(instance, flags, objectType, object, location, messageCode, pLayerPrefix, pMessage);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -3964,6 +8738,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL DebugMarkerSetObjectTagEXT(
     VkDevice                                    device,
     const VkDebugMarkerObjectTagInfoEXT*        pTagInfo)
 {
+    if (const auto hook = GetHook<PFN_vkDebugMarkerSetObjectTagEXT>(kHookDebugMarkerSetObjectTagEXT)) {
+        const HookScope scope;
+        return hook(device, pTagInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -3972,28 +8750,61 @@ static VKAPI_ATTR VkResult VKAPI_CALL DebugMarkerSetObjectNameEXT(
     VkDevice                                    device,
     const VkDebugMarkerObjectNameInfoEXT*       pNameInfo)
 {
+    if (const auto hook = GetHook<PFN_vkDebugMarkerSetObjectNameEXT>(kHookDebugMarkerSetObjectNameEXT)) {
+        const HookScope scope;
+        return hook(device, pNameInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
 
+template <>
+struct RecordedStruct<VkDebugMarkerMarkerInfoEXT> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkDebugMarkerMarkerInfoEXT& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pMarkerName, RecordedStringLength(s.pMarkerName));
+        return size;
+    }
+    static void CopyNested(VkDebugMarkerMarkerInfoEXT& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pMarkerName = writer.CopyArray(s.pMarkerName, RecordedStringLength(s.pMarkerName));
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdDebugMarkerBeginEXT(
     VkCommandBuffer                             commandBuffer,
     const VkDebugMarkerMarkerInfoEXT*           pMarkerInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdDebugMarkerBeginEXT>(kHookCmdDebugMarkerBeginEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, pMarkerInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdDebugMarkerBeginEXT, RecordArray("pMarkerInfo", pMarkerInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDebugMarkerEndEXT(
     VkCommandBuffer                             commandBuffer)
 {
+    if (const auto hook = GetHook<PFN_vkCmdDebugMarkerEndEXT>(kHookCmdDebugMarkerEndEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdDebugMarkerEndEXT);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDebugMarkerInsertEXT(
     VkCommandBuffer                             commandBuffer,
     const VkDebugMarkerMarkerInfoEXT*           pMarkerInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdDebugMarkerInsertEXT>(kHookCmdDebugMarkerInsertEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, pMarkerInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdDebugMarkerInsertEXT, RecordArray("pMarkerInfo", pMarkerInfo, 1));
 }
 
 
@@ -4007,7 +8818,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBindTransformFeedbackBuffersEXT(
     const VkDeviceSize*                         pOffsets,
     const VkDeviceSize*                         pSizes)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBindTransformFeedbackBuffersEXT>(kHookCmdBindTransformFeedbackBuffersEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstBinding, bindingCount, pBuffers, pOffsets, pSizes);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBindTransformFeedbackBuffersEXT, firstBinding, bindingCount, RecordArray("pBuffers", pBuffers, bindingCount), RecordArray("pOffsets", pOffsets, bindingCount), RecordArray("pSizes", pSizes, bindingCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBeginTransformFeedbackEXT(
@@ -4017,7 +8833,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBeginTransformFeedbackEXT(
     const VkBuffer*                             pCounterBuffers,
     const VkDeviceSize*                         pCounterBufferOffsets)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBeginTransformFeedbackEXT>(kHookCmdBeginTransformFeedbackEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstCounterBuffer, counterBufferCount, pCounterBuffers, pCounterBufferOffsets);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBeginTransformFeedbackEXT, firstCounterBuffer, counterBufferCount, RecordArray("pCounterBuffers", pCounterBuffers, counterBufferCount), RecordArray("pCounterBufferOffsets", pCounterBufferOffsets, counterBufferCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdEndTransformFeedbackEXT(
@@ -4027,7 +8848,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdEndTransformFeedbackEXT(
     const VkBuffer*                             pCounterBuffers,
     const VkDeviceSize*                         pCounterBufferOffsets)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEndTransformFeedbackEXT>(kHookCmdEndTransformFeedbackEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstCounterBuffer, counterBufferCount, pCounterBuffers, pCounterBufferOffsets);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEndTransformFeedbackEXT, firstCounterBuffer, counterBufferCount, RecordArray("pCounterBuffers", pCounterBuffers, counterBufferCount), RecordArray("pCounterBufferOffsets", pCounterBufferOffsets, counterBufferCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBeginQueryIndexedEXT(
@@ -4037,7 +8863,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBeginQueryIndexedEXT(
     VkQueryControlFlags                         flags,
     uint32_t                                    index)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBeginQueryIndexedEXT>(kHookCmdBeginQueryIndexedEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, queryPool, query, flags, index);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBeginQueryIndexedEXT, queryPool, query, flags, index);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdEndQueryIndexedEXT(
@@ -4046,7 +8877,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdEndQueryIndexedEXT(
     uint32_t                                    query,
     uint32_t                                    index)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEndQueryIndexedEXT>(kHookCmdEndQueryIndexedEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, queryPool, query, index);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEndQueryIndexedEXT, queryPool, query, index);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDrawIndirectByteCountEXT(
@@ -4058,7 +8894,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawIndirectByteCountEXT(
     uint32_t                                    counterOffset,
     uint32_t                                    vertexStride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawIndirectByteCountEXT>(kHookCmdDrawIndirectByteCountEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, instanceCount, firstInstance, counterBuffer, counterBufferOffset, counterOffset, vertexStride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawIndirectByteCountEXT, instanceCount, firstInstance, counterBuffer, counterBufferOffset, counterOffset, vertexStride);
+    CountCommand(commandBuffer, kCounterDraws);
 }
 
 
@@ -4068,8 +8909,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateCuModuleNVX(
     const VkAllocationCallbacks*                pAllocator,
     VkCuModuleNVX*                              pModule)
 {
-    unique_lock_t lock(global_lock);
-    *pModule = (VkCuModuleNVX)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateCuModuleNVX>(kHookCreateCuModuleNVX)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pModule);
+    }
+    *pModule = (VkCuModuleNVX)NewHandle(device, VK_OBJECT_TYPE_CU_MODULE_NVX);
+    TrackObjects(VK_OBJECT_TYPE_CU_MODULE_NVX, 1);
+    AddLiveObject("VkCuModuleNVX", (uint64_t)*pModule);
     return VK_SUCCESS;
 }
 
@@ -4079,8 +8925,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateCuFunctionNVX(
     const VkAllocationCallbacks*                pAllocator,
     VkCuFunctionNVX*                            pFunction)
 {
-    unique_lock_t lock(global_lock);
-    *pFunction = (VkCuFunctionNVX)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateCuFunctionNVX>(kHookCreateCuFunctionNVX)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pFunction);
+    }
+    *pFunction = (VkCuFunctionNVX)NewHandle(device, VK_OBJECT_TYPE_CU_FUNCTION_NVX);
+    TrackObjects(VK_OBJECT_TYPE_CU_FUNCTION_NVX, 1);
+    AddLiveObject("VkCuFunctionNVX", (uint64_t)*pFunction);
     return VK_SUCCESS;
 }
 
@@ -4089,7 +8940,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyCuModuleNVX(
     VkCuModuleNVX                               module,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyCuModuleNVX>(kHookDestroyCuModuleNVX)) {
+        const HookScope scope;
+        return hook(device, module, pAllocator);
+    }
 //Destroy object
+    if (module != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_CU_MODULE_NVX, -1);
+    RemoveLiveObject((uint64_t)module);
 }
 
 static VKAPI_ATTR void VKAPI_CALL DestroyCuFunctionNVX(
@@ -4097,14 +8954,36 @@ static VKAPI_ATTR void VKAPI_CALL DestroyCuFunctionNVX(
     VkCuFunctionNVX                             function,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyCuFunctionNVX>(kHookDestroyCuFunctionNVX)) {
+        const HookScope scope;
+        return hook(device, function, pAllocator);
+    }
 //Destroy object
-}
+    if (function != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_CU_FUNCTION_NVX, -1);
+    RemoveLiveObject((uint64_t)function);
+}
+
+template <>
+struct RecordedStruct<VkCuLaunchInfoNVX> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkCuLaunchInfoNVX&) { return 0; }
+    static void CopyNested(VkCuLaunchInfoNVX& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+        s.pParams = nullptr;
+        s.pExtras = nullptr;
+    }
+};
 
 static VKAPI_ATTR void VKAPI_CALL CmdCuLaunchKernelNVX(
     VkCommandBuffer                             commandBuffer,
     const VkCuLaunchInfoNVX*                    pLaunchInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCuLaunchKernelNVX>(kHookCmdCuLaunchKernelNVX)) {
+        const HookScope scope;
+        return hook(commandBuffer, pLaunchInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCuLaunchKernelNVX, RecordArray("pLaunchInfo", pLaunchInfo, 1));
 }
 
 
@@ -4112,6 +8991,10 @@ static VKAPI_ATTR uint32_t VKAPI_CALL GetImageViewHandleNVX(
     VkDevice                                    device,
     const VkImageViewHandleInfoNVX*             pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkGetImageViewHandleNVX>(kHookGetImageViewHandleNVX)) {
+        const HookScope scope;
+        return hook(device, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4121,6 +9004,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetImageViewAddressNVX(
     VkImageView                                 imageView,
     VkImageViewAddressPropertiesNVX*            pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetImageViewAddressNVX>(kHookGetImageViewAddressNVX)) {
+        const HookScope scope;
+        return hook(device, imageView, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4135,7 +9022,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawIndirectCountAMD(
     uint32_t                                    maxDrawCount,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawIndirectCountAMD>(kHookCmdDrawIndirectCountAMD)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawIndirectCountAMD, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    CountCommand(commandBuffer, kCounterDraws, maxDrawCount);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexedIndirectCountAMD(
@@ -4147,7 +9039,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawIndexedIndirectCountAMD(
     uint32_t                                    maxDrawCount,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawIndexedIndirectCountAMD>(kHookCmdDrawIndexedIndirectCountAMD)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawIndexedIndirectCountAMD, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    CountCommand(commandBuffer, kCounterDraws, maxDrawCount);
 }
 
 
@@ -4172,6 +9069,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetShaderInfoAMD(
     size_t*                                     pInfoSize,
     void*                                       pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkGetShaderInfoAMD>(kHookGetShaderInfoAMD)) {
+        const HookScope scope;
+        return hook(device, pipeline, shaderStage, infoType, pInfoSize, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4185,8 +9086,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateStreamDescriptorSurfaceGGP(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateStreamDescriptorSurfaceGGP>(kHookCreateStreamDescriptorSurfaceGGP)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 #endif /* VK_USE_PLATFORM_GGP */
@@ -4204,6 +9110,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceExternalImageFormatProper
     VkExternalMemoryHandleTypeFlagsNV           externalHandleType,
     VkExternalImageFormatPropertiesNV*          pExternalImageFormatProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceExternalImageFormatPropertiesNV>(kHookGetPhysicalDeviceExternalImageFormatPropertiesNV)) {
+        const HookScope scope;
+        return hook(physicalDevice, format, type, tiling, usage, flags, externalHandleType, pExternalImageFormatProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4217,6 +9127,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryWin32HandleNV(
     VkExternalMemoryHandleTypeFlagsNV           handleType,
     HANDLE*                                     pHandle)
 {
+    if (const auto hook = GetHook<PFN_vkGetMemoryWin32HandleNV>(kHookGetMemoryWin32HandleNV)) {
+        const HookScope scope;
+        return hook(device, memory, handleType, pHandle);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4234,8 +9148,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateViSurfaceNN(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateViSurfaceNN>(kHookCreateViSurfaceNN)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 #endif /* VK_USE_PLATFORM_VI_NN */
@@ -4245,17 +9164,36 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateViSurfaceNN(
 
 
 
+template <>
+struct RecordedStruct<VkConditionalRenderingBeginInfoEXT> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkConditionalRenderingBeginInfoEXT&) { return 0; }
+    static void CopyNested(VkConditionalRenderingBeginInfoEXT& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdBeginConditionalRenderingEXT(
     VkCommandBuffer                             commandBuffer,
     const VkConditionalRenderingBeginInfoEXT*   pConditionalRenderingBegin)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBeginConditionalRenderingEXT>(kHookCmdBeginConditionalRenderingEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, pConditionalRenderingBegin);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBeginConditionalRenderingEXT, RecordArray("pConditionalRenderingBegin", pConditionalRenderingBegin, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdEndConditionalRenderingEXT(
     VkCommandBuffer                             commandBuffer)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEndConditionalRenderingEXT>(kHookCmdEndConditionalRenderingEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEndConditionalRenderingEXT);
 }
 
 
@@ -4265,7 +9203,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetViewportWScalingNV(
     uint32_t                                    viewportCount,
     const VkViewportWScalingNV*                 pViewportWScalings)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetViewportWScalingNV>(kHookCmdSetViewportWScalingNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstViewport, viewportCount, pViewportWScalings);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetViewportWScalingNV, firstViewport, viewportCount, RecordArray("pViewportWScalings", pViewportWScalings, viewportCount));
 }
 
 
@@ -4273,6 +9216,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL ReleaseDisplayEXT(
     VkPhysicalDevice                            physicalDevice,
     VkDisplayKHR                                display)
 {
+    if (const auto hook = GetHook<PFN_vkReleaseDisplayEXT>(kHookReleaseDisplayEXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, display);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4284,6 +9231,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL AcquireXlibDisplayEXT(
     Display*                                    dpy,
     VkDisplayKHR                                display)
 {
+    if (const auto hook = GetHook<PFN_vkAcquireXlibDisplayEXT>(kHookAcquireXlibDisplayEXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, dpy, display);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4294,6 +9245,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetRandROutputDisplayEXT(
     RROutput                                    rrOutput,
     VkDisplayKHR*                               pDisplay)
 {
+    if (const auto hook = GetHook<PFN_vkGetRandROutputDisplayEXT>(kHookGetRandROutputDisplayEXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, dpy, rrOutput, pDisplay);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4305,6 +9260,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceCapabilities2EXT(
     VkSurfaceKHR                                surface,
     VkSurfaceCapabilities2EXT*                  pSurfaceCapabilities)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSurfaceCapabilities2EXT>(kHookGetPhysicalDeviceSurfaceCapabilities2EXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, surface, pSurfaceCapabilities);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4315,6 +9274,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL DisplayPowerControlEXT(
     VkDisplayKHR                                display,
     const VkDisplayPowerInfoEXT*                pDisplayPowerInfo)
 {
+    if (const auto hook = GetHook<PFN_vkDisplayPowerControlEXT>(kHookDisplayPowerControlEXT)) {
+        const HookScope scope;
+        return hook(device, display, pDisplayPowerInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4325,6 +9288,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL RegisterDeviceEventEXT(
     const VkAllocationCallbacks*                pAllocator,
     VkFence*                                    pFence)
 {
+    if (const auto hook = GetHook<PFN_vkRegisterDeviceEventEXT>(kHookRegisterDeviceEventEXT)) {
+        const HookScope scope;
+        return hook(device, pDeviceEventInfo, pAllocator, pFence);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4336,6 +9303,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL RegisterDisplayEventEXT(
     const VkAllocationCallbacks*                pAllocator,
     VkFence*                                    pFence)
 {
+    if (const auto hook = GetHook<PFN_vkRegisterDisplayEventEXT>(kHookRegisterDisplayEventEXT)) {
+        const HookScope scope;
+        return hook(device, display, pDisplayEventInfo, pAllocator, pFence);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4346,6 +9317,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetSwapchainCounterEXT(
     VkSurfaceCounterFlagBitsEXT                 counter,
     uint64_t*                                   pCounterValue)
 {
+    if (const auto hook = GetHook<PFN_vkGetSwapchainCounterEXT>(kHookGetSwapchainCounterEXT)) {
+        const HookScope scope;
+        return hook(device, swapchain, counter, pCounterValue);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4356,7 +9331,16 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetRefreshCycleDurationGOOGLE(
     VkSwapchainKHR                              swapchain,
     VkRefreshCycleDurationGOOGLE*               pDisplayTimingProperties)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetRefreshCycleDurationGOOGLE>(kHookGetRefreshCycleDurationGOOGLE)) {
+        const HookScope scope;
+        return hook(device, swapchain, pDisplayTimingProperties);
+    }
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        if (!objects.swapchain_present_states.count(swapchain)) return VK_ERROR_OUT_OF_DATE_KHR;
+    }
+    pDisplayTimingProperties->refreshDuration = GetRefreshDurationNs();
     return VK_SUCCESS;
 }
 
@@ -4366,8 +9350,34 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPastPresentationTimingGOOGLE(
     uint32_t*                                   pPresentationTimingCount,
     VkPastPresentationTimingGOOGLE*             pPresentationTimings)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetPastPresentationTimingGOOGLE>(kHookGetPastPresentationTimingGOOGLE)) {
+        const HookScope scope;
+        return hook(device, swapchain, pPresentationTimingCount, pPresentationTimings);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto state = objects.swapchain_present_states.find(swapchain);
+    if (state == objects.swapchain_present_states.end()) {
+        *pPresentationTimingCount = 0;
+        return VK_ERROR_OUT_OF_DATE_KHR;
+    }
+    auto& past_timings = state->second.past_timings;
+    // Only presents whose image has reached the display are in the past
+    const uint64_t now = GetMonotonicTimeNs();
+    uint32_t available_count = 0;
+    while (available_count < past_timings.size() && past_timings[available_count].actualPresentTime <= now) {
+        ++available_count;
+    }
+    if (!pPresentationTimings) {
+        *pPresentationTimingCount = available_count;
+        return VK_SUCCESS;
+    }
+    // Each timing is reported once
+    const uint32_t count = (std::min)(*pPresentationTimingCount, available_count);
+    std::copy(past_timings.begin(), past_timings.begin() + count, pPresentationTimings);
+    past_timings.erase(past_timings.begin(), past_timings.begin() + count);
+    *pPresentationTimingCount = count;
+    return count < available_count ? VK_INCOMPLETE : VK_SUCCESS;
 }
 
 
@@ -4382,7 +9392,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetDiscardRectangleEXT(
     uint32_t                                    discardRectangleCount,
     const VkRect2D*                             pDiscardRectangles)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDiscardRectangleEXT>(kHookCmdSetDiscardRectangleEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstDiscardRectangle, discardRectangleCount, pDiscardRectangles);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDiscardRectangleEXT, firstDiscardRectangle, discardRectangleCount, RecordArray("pDiscardRectangles", pDiscardRectangles, discardRectangleCount));
 }
 
 
@@ -4395,6 +9410,10 @@ static VKAPI_ATTR void VKAPI_CALL SetHdrMetadataEXT(
     const VkSwapchainKHR*                       pSwapchains,
     const VkHdrMetadataEXT*                     pMetadata)
 {
+    if (const auto hook = GetHook<PFN_vkSetHdrMetadataEXT>(kHookSetHdrMetadataEXT)) {
+        const HookScope scope;
+        return hook(device, swapchainCount, pSwapchains, pMetadata);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -4406,8 +9425,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateIOSSurfaceMVK(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateIOSSurfaceMVK>(kHookCreateIOSSurfaceMVK)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 #endif /* VK_USE_PLATFORM_IOS_MVK */
@@ -4420,8 +9444,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateMacOSSurfaceMVK(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateMacOSSurfaceMVK>(kHookCreateMacOSSurfaceMVK)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 #endif /* VK_USE_PLATFORM_MACOS_MVK */
@@ -4433,6 +9462,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL SetDebugUtilsObjectNameEXT(
     VkDevice                                    device,
     const VkDebugUtilsObjectNameInfoEXT*        pNameInfo)
 {
+    if (const auto hook = GetHook<PFN_vkSetDebugUtilsObjectNameEXT>(kHookSetDebugUtilsObjectNameEXT)) {
+        const HookScope scope;
+        return hook(device, pNameInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4441,6 +9474,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL SetDebugUtilsObjectTagEXT(
     VkDevice                                    device,
     const VkDebugUtilsObjectTagInfoEXT*         pTagInfo)
 {
+    if (const auto hook = GetHook<PFN_vkSetDebugUtilsObjectTagEXT>(kHookSetDebugUtilsObjectTagEXT)) {
+        const HookScope scope;
+        return hook(device, pTagInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4449,12 +9486,20 @@ static VKAPI_ATTR void VKAPI_CALL QueueBeginDebugUtilsLabelEXT(
     VkQueue                                     queue,
     const VkDebugUtilsLabelEXT*                 pLabelInfo)
 {
+    if (const auto hook = GetHook<PFN_vkQueueBeginDebugUtilsLabelEXT>(kHookQueueBeginDebugUtilsLabelEXT)) {
+        const HookScope scope;
+        return hook(queue, pLabelInfo);
+    }
 //Not a CREATE or DESTROY function
 }
 
 static VKAPI_ATTR void VKAPI_CALL QueueEndDebugUtilsLabelEXT(
     VkQueue                                     queue)
 {
+    if (const auto hook = GetHook<PFN_vkQueueEndDebugUtilsLabelEXT>(kHookQueueEndDebugUtilsLabelEXT)) {
+        const HookScope scope;
+        return hook(queue);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -4462,27 +9507,60 @@ static VKAPI_ATTR void VKAPI_CALL QueueInsertDebugUtilsLabelEXT(
     VkQueue                                     queue,
     const VkDebugUtilsLabelEXT*                 pLabelInfo)
 {
+    if (const auto hook = GetHook<PFN_vkQueueInsertDebugUtilsLabelEXT>(kHookQueueInsertDebugUtilsLabelEXT)) {
+        const HookScope scope;
+        return hook(queue, pLabelInfo);
+    }
 //Not a CREATE or DESTROY function
 }
 
+template <>
+struct RecordedStruct<VkDebugUtilsLabelEXT> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkDebugUtilsLabelEXT& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pLabelName, RecordedStringLength(s.pLabelName));
+        return size;
+    }
+    static void CopyNested(VkDebugUtilsLabelEXT& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pLabelName = writer.CopyArray(s.pLabelName, RecordedStringLength(s.pLabelName));
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdBeginDebugUtilsLabelEXT(
     VkCommandBuffer                             commandBuffer,
     const VkDebugUtilsLabelEXT*                 pLabelInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBeginDebugUtilsLabelEXT>(kHookCmdBeginDebugUtilsLabelEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, pLabelInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBeginDebugUtilsLabelEXT, RecordArray("pLabelInfo", pLabelInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdEndDebugUtilsLabelEXT(
     VkCommandBuffer                             commandBuffer)
 {
+    if (const auto hook = GetHook<PFN_vkCmdEndDebugUtilsLabelEXT>(kHookCmdEndDebugUtilsLabelEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdEndDebugUtilsLabelEXT);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdInsertDebugUtilsLabelEXT(
     VkCommandBuffer                             commandBuffer,
     const VkDebugUtilsLabelEXT*                 pLabelInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdInsertDebugUtilsLabelEXT>(kHookCmdInsertDebugUtilsLabelEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, pLabelInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdInsertDebugUtilsLabelEXT, RecordArray("pLabelInfo", pLabelInfo, 1));
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateDebugUtilsMessengerEXT(
@@ -4491,8 +9569,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDebugUtilsMessengerEXT(
     const VkAllocationCallbacks*                pAllocator,
     VkDebugUtilsMessengerEXT*                   pMessenger)
 {
-    unique_lock_t lock(global_lock);
-    *pMessenger = (VkDebugUtilsMessengerEXT)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateDebugUtilsMessengerEXT>(kHookCreateDebugUtilsMessengerEXT)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pMessenger);
+    }
+    *pMessenger = (VkDebugUtilsMessengerEXT)NewHandle(instance, VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT);
+    TrackObjects(VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT, 1);
+    AddLiveObject("VkDebugUtilsMessengerEXT", (uint64_t)*pMessenger);
     return VK_SUCCESS;
 }
 
@@ -4501,7 +9584,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyDebugUtilsMessengerEXT(
     VkDebugUtilsMessengerEXT                    messenger,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyDebugUtilsMessengerEXT>(kHookDestroyDebugUtilsMessengerEXT)) {
+        const HookScope scope;
+        return hook(instance, messenger, pAllocator);
+    }
 //Destroy object
+    if (messenger != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT, -1);
+    RemoveLiveObject((uint64_t)messenger);
 }
 
 static VKAPI_ATTR void VKAPI_CALL SubmitDebugUtilsMessageEXT(
@@ -4510,6 +9599,10 @@ static VKAPI_ATTR void VKAPI_CALL SubmitDebugUtilsMessageEXT(
     VkDebugUtilsMessageTypeFlagsEXT             messageTypes,
     const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData)
 {
+    if (const auto hook = GetHook<PFN_vkSubmitDebugUtilsMessageEXT>(kHookSubmitDebugUtilsMessageEXT)) {
+        const HookScope scope;
+        return hook(instance, messageSeverity, messageTypes, pCallbackData);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -4520,6 +9613,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetAndroidHardwareBufferPropertiesANDROID(
     const struct AHardwareBuffer*               buffer,
     VkAndroidHardwareBufferPropertiesANDROID*   pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetAndroidHardwareBufferPropertiesANDROID>(kHookGetAndroidHardwareBufferPropertiesANDROID)) {
+        const HookScope scope;
+        return hook(device, buffer, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4529,6 +9626,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryAndroidHardwareBufferANDROID(
     const VkMemoryGetAndroidHardwareBufferInfoANDROID* pInfo,
     struct AHardwareBuffer**                    pBuffer)
 {
+    if (const auto hook = GetHook<PFN_vkGetMemoryAndroidHardwareBufferANDROID>(kHookGetMemoryAndroidHardwareBufferANDROID)) {
+        const HookScope scope;
+        return hook(device, pInfo, pBuffer);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4541,11 +9642,30 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryAndroidHardwareBufferANDROID(
 
 
 
+template <>
+struct RecordedStruct<VkSampleLocationsInfoEXT> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkSampleLocationsInfoEXT& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pSampleLocations, s.sampleLocationsCount);
+        return size;
+    }
+    static void CopyNested(VkSampleLocationsInfoEXT& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pSampleLocations = writer.CopyArray(s.pSampleLocations, s.sampleLocationsCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdSetSampleLocationsEXT(
     VkCommandBuffer                             commandBuffer,
     const VkSampleLocationsInfoEXT*             pSampleLocationsInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetSampleLocationsEXT>(kHookCmdSetSampleLocationsEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, pSampleLocationsInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetSampleLocationsEXT, RecordArray("pSampleLocationsInfo", pSampleLocationsInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMultisamplePropertiesEXT(
@@ -4553,6 +9673,10 @@ static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMultisamplePropertiesEXT(
     VkSampleCountFlagBits                       samples,
     VkMultisamplePropertiesEXT*                 pMultisampleProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceMultisamplePropertiesEXT>(kHookGetPhysicalDeviceMultisamplePropertiesEXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, samples, pMultisampleProperties);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -4568,6 +9692,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetImageDrmFormatModifierPropertiesEXT(
     VkImage                                     image,
     VkImageDrmFormatModifierPropertiesEXT*      pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetImageDrmFormatModifierPropertiesEXT>(kHookGetImageDrmFormatModifierPropertiesEXT)) {
+        const HookScope scope;
+        return hook(device, image, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4579,8 +9707,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateValidationCacheEXT(
     const VkAllocationCallbacks*                pAllocator,
     VkValidationCacheEXT*                       pValidationCache)
 {
-    unique_lock_t lock(global_lock);
-    *pValidationCache = (VkValidationCacheEXT)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateValidationCacheEXT>(kHookCreateValidationCacheEXT)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pValidationCache);
+    }
+    *pValidationCache = (VkValidationCacheEXT)NewHandle(device, VK_OBJECT_TYPE_VALIDATION_CACHE_EXT);
+    TrackObjects(VK_OBJECT_TYPE_VALIDATION_CACHE_EXT, 1);
+    AddLiveObject("VkValidationCacheEXT", (uint64_t)*pValidationCache);
     return VK_SUCCESS;
 }
 
@@ -4589,7 +9722,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyValidationCacheEXT(
     VkValidationCacheEXT                        validationCache,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyValidationCacheEXT>(kHookDestroyValidationCacheEXT)) {
+        const HookScope scope;
+        return hook(device, validationCache, pAllocator);
+    }
 //Destroy object
+    if (validationCache != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_VALIDATION_CACHE_EXT, -1);
+    RemoveLiveObject((uint64_t)validationCache);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL MergeValidationCachesEXT(
@@ -4598,6 +9737,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL MergeValidationCachesEXT(
     uint32_t                                    srcCacheCount,
     const VkValidationCacheEXT*                 pSrcCaches)
 {
+    if (const auto hook = GetHook<PFN_vkMergeValidationCachesEXT>(kHookMergeValidationCachesEXT)) {
+        const HookScope scope;
+        return hook(device, dstCache, srcCacheCount, pSrcCaches);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4608,6 +9751,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetValidationCacheDataEXT(
     size_t*                                     pDataSize,
     void*                                       pData)
 {
+    if (const auto hook = GetHook<PFN_vkGetValidationCacheDataEXT>(kHookGetValidationCacheDataEXT)) {
+        const HookScope scope;
+        return hook(device, validationCache, pDataSize, pData);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4620,25 +9767,66 @@ static VKAPI_ATTR void VKAPI_CALL CmdBindShadingRateImageNV(
     VkImageView                                 imageView,
     VkImageLayout                               imageLayout)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBindShadingRateImageNV>(kHookCmdBindShadingRateImageNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, imageView, imageLayout);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBindShadingRateImageNV, imageView, imageLayout);
 }
 
+template <>
+struct RecordedStruct<VkShadingRatePaletteNV> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkShadingRatePaletteNV& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pShadingRatePaletteEntries, s.shadingRatePaletteEntryCount);
+        return size;
+    }
+    static void CopyNested(VkShadingRatePaletteNV& s, CommandDataWriter& writer) {
+        s.pShadingRatePaletteEntries = writer.CopyArray(s.pShadingRatePaletteEntries, s.shadingRatePaletteEntryCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdSetViewportShadingRatePaletteNV(
     VkCommandBuffer                             commandBuffer,
     uint32_t                                    firstViewport,
     uint32_t                                    viewportCount,
     const VkShadingRatePaletteNV*               pShadingRatePalettes)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetViewportShadingRatePaletteNV>(kHookCmdSetViewportShadingRatePaletteNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstViewport, viewportCount, pShadingRatePalettes);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetViewportShadingRatePaletteNV, firstViewport, viewportCount, RecordArray("pShadingRatePalettes", pShadingRatePalettes, viewportCount));
 }
 
+template <>
+struct RecordedStruct<VkCoarseSampleOrderCustomNV> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkCoarseSampleOrderCustomNV& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pSampleLocations, s.sampleLocationCount);
+        return size;
+    }
+    static void CopyNested(VkCoarseSampleOrderCustomNV& s, CommandDataWriter& writer) {
+        s.pSampleLocations = writer.CopyArray(s.pSampleLocations, s.sampleLocationCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdSetCoarseSampleOrderNV(
     VkCommandBuffer                             commandBuffer,
     VkCoarseSampleOrderTypeNV                   sampleOrderType,
     uint32_t                                    customSampleOrderCount,
     const VkCoarseSampleOrderCustomNV*          pCustomSampleOrders)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetCoarseSampleOrderNV>(kHookCmdSetCoarseSampleOrderNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, sampleOrderType, customSampleOrderCount, pCustomSampleOrders);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetCoarseSampleOrderNV, sampleOrderType, customSampleOrderCount, RecordArray("pCustomSampleOrders", pCustomSampleOrders, customSampleOrderCount));
 }
 
 
@@ -4648,8 +9836,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateAccelerationStructureNV(
     const VkAllocationCallbacks*                pAllocator,
     VkAccelerationStructureNV*                  pAccelerationStructure)
 {
-    unique_lock_t lock(global_lock);
-    *pAccelerationStructure = (VkAccelerationStructureNV)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateAccelerationStructureNV>(kHookCreateAccelerationStructureNV)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pAccelerationStructure);
+    }
+    *pAccelerationStructure = (VkAccelerationStructureNV)NewHandle(device, VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_NV);
+    TrackObjects(VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_NV, 1);
+    AddLiveObject("VkAccelerationStructureNV", (uint64_t)*pAccelerationStructure);
     return VK_SUCCESS;
 }
 
@@ -4658,7 +9851,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyAccelerationStructureNV(
     VkAccelerationStructureNV                   accelerationStructure,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyAccelerationStructureNV>(kHookDestroyAccelerationStructureNV)) {
+        const HookScope scope;
+        return hook(device, accelerationStructure, pAllocator);
+    }
 //Destroy object
+    if (accelerationStructure != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_NV, -1);
+    RemoveLiveObject((uint64_t)accelerationStructure);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetAccelerationStructureMemoryRequirementsNV(
@@ -4666,6 +9865,10 @@ static VKAPI_ATTR void VKAPI_CALL GetAccelerationStructureMemoryRequirementsNV(
     const VkAccelerationStructureMemoryRequirementsInfoNV* pInfo,
     VkMemoryRequirements2KHR*                   pMemoryRequirements)
 {
+    if (const auto hook = GetHook<PFN_vkGetAccelerationStructureMemoryRequirementsNV>(kHookGetAccelerationStructureMemoryRequirementsNV)) {
+        const HookScope scope;
+        return hook(device, pInfo, pMemoryRequirements);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -4674,10 +9877,75 @@ static VKAPI_ATTR VkResult VKAPI_CALL BindAccelerationStructureMemoryNV(
     uint32_t                                    bindInfoCount,
     const VkBindAccelerationStructureMemoryInfoNV* pBindInfos)
 {
+    if (const auto hook = GetHook<PFN_vkBindAccelerationStructureMemoryNV>(kHookBindAccelerationStructureMemoryNV)) {
+        const HookScope scope;
+        return hook(device, bindInfoCount, pBindInfos);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
 
+template <>
+struct RecordedStruct<VkGeometryTrianglesNV> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkGeometryTrianglesNV&) { return 0; }
+    static void CopyNested(VkGeometryTrianglesNV& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkGeometryAABBNV> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkGeometryAABBNV&) { return 0; }
+    static void CopyNested(VkGeometryAABBNV& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkGeometryDataNV> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkGeometryDataNV& s) {
+        size_t size = 0;
+        size += RecordedStruct<VkGeometryTrianglesNV>::NestedSize(s.triangles);
+        size += RecordedStruct<VkGeometryAABBNV>::NestedSize(s.aabbs);
+        return size;
+    }
+    static void CopyNested(VkGeometryDataNV& s, CommandDataWriter& writer) {
+        RecordedStruct<VkGeometryTrianglesNV>::CopyNested(s.triangles, writer);
+        RecordedStruct<VkGeometryAABBNV>::CopyNested(s.aabbs, writer);
+    }
+};
+
+template <>
+struct RecordedStruct<VkGeometryNV> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkGeometryNV& s) {
+        size_t size = 0;
+        size += RecordedStruct<VkGeometryDataNV>::NestedSize(s.geometry);
+        return size;
+    }
+    static void CopyNested(VkGeometryNV& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        RecordedStruct<VkGeometryDataNV>::CopyNested(s.geometry, writer);
+    }
+};
+
+template <>
+struct RecordedStruct<VkAccelerationStructureInfoNV> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkAccelerationStructureInfoNV& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pGeometries, s.geometryCount);
+        return size;
+    }
+    static void CopyNested(VkAccelerationStructureInfoNV& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pGeometries = writer.CopyArray(s.pGeometries, s.geometryCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdBuildAccelerationStructureNV(
     VkCommandBuffer                             commandBuffer,
     const VkAccelerationStructureInfoNV*        pInfo,
@@ -4689,7 +9957,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBuildAccelerationStructureNV(
     VkBuffer                                    scratch,
     VkDeviceSize                                scratchOffset)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBuildAccelerationStructureNV>(kHookCmdBuildAccelerationStructureNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, pInfo, instanceData, instanceOffset, update, dst, src, scratch, scratchOffset);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBuildAccelerationStructureNV, RecordArray("pInfo", pInfo, 1), instanceData, instanceOffset, update, dst, src, scratch, scratchOffset);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdCopyAccelerationStructureNV(
@@ -4698,7 +9971,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdCopyAccelerationStructureNV(
     VkAccelerationStructureNV                   src,
     VkCopyAccelerationStructureModeKHR          mode)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyAccelerationStructureNV>(kHookCmdCopyAccelerationStructureNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, dst, src, mode);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyAccelerationStructureNV, dst, src, mode);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdTraceRaysNV(
@@ -4718,7 +9996,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdTraceRaysNV(
     uint32_t                                    height,
     uint32_t                                    depth)
 {
+    if (const auto hook = GetHook<PFN_vkCmdTraceRaysNV>(kHookCmdTraceRaysNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, raygenShaderBindingTableBuffer, raygenShaderBindingOffset, missShaderBindingTableBuffer, missShaderBindingOffset, missShaderBindingStride, hitShaderBindingTableBuffer, hitShaderBindingOffset, hitShaderBindingStride, callableShaderBindingTableBuffer, callableShaderBindingOffset, callableShaderBindingStride, width, height, depth);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdTraceRaysNV, raygenShaderBindingTableBuffer, raygenShaderBindingOffset, missShaderBindingTableBuffer, missShaderBindingOffset, missShaderBindingStride, hitShaderBindingTableBuffer, hitShaderBindingOffset, hitShaderBindingStride, callableShaderBindingTableBuffer, callableShaderBindingOffset, callableShaderBindingStride, width, height, depth);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateRayTracingPipelinesNV(
@@ -4729,10 +10012,15 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateRayTracingPipelinesNV(
     const VkAllocationCallbacks*                pAllocator,
     VkPipeline*                                 pPipelines)
 {
-    unique_lock_t lock(global_lock);
+    if (const auto hook = GetHook<PFN_vkCreateRayTracingPipelinesNV>(kHookCreateRayTracingPipelinesNV)) {
+        const HookScope scope;
+        return hook(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
+    }
     for (uint32_t i = 0; i < createInfoCount; ++i) {
-        pPipelines[i] = (VkPipeline)global_unique_handle++;
+        pPipelines[i] = (VkPipeline)NewHandle(device, VK_OBJECT_TYPE_PIPELINE);
+        AddLiveObject("VkPipeline", (uint64_t)pPipelines[i]);
     }
+    TrackObjects(VK_OBJECT_TYPE_PIPELINE, createInfoCount);
     return VK_SUCCESS;
 }
 
@@ -4744,6 +10032,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetRayTracingShaderGroupHandlesKHR(
     size_t                                      dataSize,
     void*                                       pData)
 {
+    if (const auto hook = GetHook<PFN_vkGetRayTracingShaderGroupHandlesKHR>(kHookGetRayTracingShaderGroupHandlesKHR)) {
+        const HookScope scope;
+        return hook(device, pipeline, firstGroup, groupCount, dataSize, pData);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4756,6 +10048,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetRayTracingShaderGroupHandlesNV(
     size_t                                      dataSize,
     void*                                       pData)
 {
+    if (const auto hook = GetHook<PFN_vkGetRayTracingShaderGroupHandlesNV>(kHookGetRayTracingShaderGroupHandlesNV)) {
+        const HookScope scope;
+        return hook(device, pipeline, firstGroup, groupCount, dataSize, pData);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4766,6 +10062,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetAccelerationStructureHandleNV(
     size_t                                      dataSize,
     void*                                       pData)
 {
+    if (const auto hook = GetHook<PFN_vkGetAccelerationStructureHandleNV>(kHookGetAccelerationStructureHandleNV)) {
+        const HookScope scope;
+        return hook(device, accelerationStructure, dataSize, pData);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4778,7 +10078,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdWriteAccelerationStructuresPropertiesNV(
     VkQueryPool                                 queryPool,
     uint32_t                                    firstQuery)
 {
+    if (const auto hook = GetHook<PFN_vkCmdWriteAccelerationStructuresPropertiesNV>(kHookCmdWriteAccelerationStructuresPropertiesNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, accelerationStructureCount, pAccelerationStructures, queryType, queryPool, firstQuery);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdWriteAccelerationStructuresPropertiesNV, accelerationStructureCount, RecordArray("pAccelerationStructures", pAccelerationStructures, accelerationStructureCount), queryType, queryPool, firstQuery);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CompileDeferredNV(
@@ -4786,6 +10091,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL CompileDeferredNV(
     VkPipeline                                  pipeline,
     uint32_t                                    shader)
 {
+    if (const auto hook = GetHook<PFN_vkCompileDeferredNV>(kHookCompileDeferredNV)) {
+        const HookScope scope;
+        return hook(device, pipeline, shader);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4801,6 +10110,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryHostPointerPropertiesEXT(
     const void*                                 pHostPointer,
     VkMemoryHostPointerPropertiesEXT*           pMemoryHostPointerProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetMemoryHostPointerPropertiesEXT>(kHookGetMemoryHostPointerPropertiesEXT)) {
+        const HookScope scope;
+        return hook(device, handleType, pHostPointer, pMemoryHostPointerProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4813,7 +10126,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdWriteBufferMarkerAMD(
     VkDeviceSize                                dstOffset,
     uint32_t                                    marker)
 {
+    if (const auto hook = GetHook<PFN_vkCmdWriteBufferMarkerAMD>(kHookCmdWriteBufferMarkerAMD)) {
+        const HookScope scope;
+        return hook(commandBuffer, pipelineStage, dstBuffer, dstOffset, marker);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdWriteBufferMarkerAMD, pipelineStage, dstBuffer, dstOffset, marker);
 }
 
 
@@ -4823,8 +10141,28 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceCalibrateableTimeDomainsE
     uint32_t*                                   pTimeDomainCount,
     VkTimeDomainEXT*                            pTimeDomains)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT>(kHookGetPhysicalDeviceCalibrateableTimeDomainsEXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, pTimeDomainCount, pTimeDomains);
+    }
+    // Host clocks are only reported where they can be sampled
+    static const std::vector<VkTimeDomainEXT> time_domains = {
+        VK_TIME_DOMAIN_DEVICE_EXT,
+#if defined(__linux__)
+        VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT,
+        VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_EXT,
+#elif defined(_WIN32)
+        VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT,
+#endif
+    };
+    if (!pTimeDomains) {
+        *pTimeDomainCount = static_cast<uint32_t>(time_domains.size());
+        return VK_SUCCESS;
+    }
+    const uint32_t count = (std::min)(*pTimeDomainCount, static_cast<uint32_t>(time_domains.size()));
+    std::copy(time_domains.begin(), time_domains.begin() + count, pTimeDomains);
+    *pTimeDomainCount = count;
+    return count < time_domains.size() ? VK_INCOMPLETE : VK_SUCCESS;
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetCalibratedTimestampsEXT(
@@ -4834,7 +10172,37 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetCalibratedTimestampsEXT(
     uint64_t*                                   pTimestamps,
     uint64_t*                                   pMaxDeviation)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkGetCalibratedTimestampsEXT>(kHookGetCalibratedTimestampsEXT)) {
+        const HookScope scope;
+        return hook(device, timestampCount, pTimestampInfos, pTimestamps, pMaxDeviation);
+    }
+    // Device timestamps count nanoseconds of CLOCK_MONOTONIC on Linux and of the performance counter on Windows
+    // (timestampPeriod is 1), so only the other host clock is sampled separately. The deviation is the time it took to
+    // sample both.
+    const uint64_t begin_time = GetMonotonicTimeNs();
+#if defined(__linux__)
+    const uint64_t raw_time = GetMonotonicRawTimeNs();
+#elif defined(_WIN32)
+    const uint64_t counter = GetPerformanceCounter();
+#endif
+    const uint64_t end_time = GetMonotonicTimeNs();
+    for (uint32_t i = 0; i < timestampCount; ++i) {
+        switch (pTimestampInfos[i].timeDomain) {
+#if defined(__linux__)
+            case VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_EXT:
+                pTimestamps[i] = raw_time;
+                break;
+#elif defined(_WIN32)
+            case VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT:
+                pTimestamps[i] = counter;
+                break;
+#endif
+            default:
+                pTimestamps[i] = begin_time;
+                break;
+        }
+    }
+    *pMaxDeviation = (std::max)(end_time - begin_time, uint64_t(1));
     return VK_SUCCESS;
 }
 
@@ -4856,7 +10224,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawMeshTasksNV(
     uint32_t                                    taskCount,
     uint32_t                                    firstTask)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawMeshTasksNV>(kHookCmdDrawMeshTasksNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, taskCount, firstTask);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawMeshTasksNV, taskCount, firstTask);
+    CountCommand(commandBuffer, kCounterDraws);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDrawMeshTasksIndirectNV(
@@ -4866,7 +10239,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawMeshTasksIndirectNV(
     uint32_t                                    drawCount,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawMeshTasksIndirectNV>(kHookCmdDrawMeshTasksIndirectNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, drawCount, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawMeshTasksIndirectNV, buffer, offset, drawCount, stride);
+    CountCommand(commandBuffer, kCounterDraws, drawCount);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDrawMeshTasksIndirectCountNV(
@@ -4878,7 +10256,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawMeshTasksIndirectCountNV(
     uint32_t                                    maxDrawCount,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawMeshTasksIndirectCountNV>(kHookCmdDrawMeshTasksIndirectCountNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawMeshTasksIndirectCountNV, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    CountCommand(commandBuffer, kCounterDraws, maxDrawCount);
 }
 
 
@@ -4890,7 +10273,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetExclusiveScissorNV(
     uint32_t                                    exclusiveScissorCount,
     const VkRect2D*                             pExclusiveScissors)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetExclusiveScissorNV>(kHookCmdSetExclusiveScissorNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstExclusiveScissor, exclusiveScissorCount, pExclusiveScissors);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetExclusiveScissorNV, firstExclusiveScissor, exclusiveScissorCount, RecordArray("pExclusiveScissors", pExclusiveScissors, exclusiveScissorCount));
 }
 
 
@@ -4898,7 +10286,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetCheckpointNV(
     VkCommandBuffer                             commandBuffer,
     const void*                                 pCheckpointMarker)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetCheckpointNV>(kHookCmdSetCheckpointNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, pCheckpointMarker);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetCheckpointNV);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetQueueCheckpointDataNV(
@@ -4906,6 +10299,10 @@ static VKAPI_ATTR void VKAPI_CALL GetQueueCheckpointDataNV(
     uint32_t*                                   pCheckpointDataCount,
     VkCheckpointDataNV*                         pCheckpointData)
 {
+    if (const auto hook = GetHook<PFN_vkGetQueueCheckpointDataNV>(kHookGetQueueCheckpointDataNV)) {
+        const HookScope scope;
+        return hook(queue, pCheckpointDataCount, pCheckpointData);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -4915,6 +10312,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL InitializePerformanceApiINTEL(
     VkDevice                                    device,
     const VkInitializePerformanceApiInfoINTEL*  pInitializeInfo)
 {
+    if (const auto hook = GetHook<PFN_vkInitializePerformanceApiINTEL>(kHookInitializePerformanceApiINTEL)) {
+        const HookScope scope;
+        return hook(device, pInitializeInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4922,30 +10323,76 @@ static VKAPI_ATTR VkResult VKAPI_CALL InitializePerformanceApiINTEL(
 static VKAPI_ATTR void VKAPI_CALL UninitializePerformanceApiINTEL(
     VkDevice                                    device)
 {
+    if (const auto hook = GetHook<PFN_vkUninitializePerformanceApiINTEL>(kHookUninitializePerformanceApiINTEL)) {
+        const HookScope scope;
+        return hook(device);
+    }
 //Not a CREATE or DESTROY function
 }
 
+template <>
+struct RecordedStruct<VkPerformanceMarkerInfoINTEL> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkPerformanceMarkerInfoINTEL&) { return 0; }
+    static void CopyNested(VkPerformanceMarkerInfoINTEL& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR VkResult VKAPI_CALL CmdSetPerformanceMarkerINTEL(
     VkCommandBuffer                             commandBuffer,
     const VkPerformanceMarkerInfoINTEL*         pMarkerInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetPerformanceMarkerINTEL>(kHookCmdSetPerformanceMarkerINTEL)) {
+        const HookScope scope;
+        return hook(commandBuffer, pMarkerInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetPerformanceMarkerINTEL, RecordArray("pMarkerInfo", pMarkerInfo, 1));
     return VK_SUCCESS;
 }
 
+template <>
+struct RecordedStruct<VkPerformanceStreamMarkerInfoINTEL> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkPerformanceStreamMarkerInfoINTEL&) { return 0; }
+    static void CopyNested(VkPerformanceStreamMarkerInfoINTEL& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR VkResult VKAPI_CALL CmdSetPerformanceStreamMarkerINTEL(
     VkCommandBuffer                             commandBuffer,
     const VkPerformanceStreamMarkerInfoINTEL*   pMarkerInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetPerformanceStreamMarkerINTEL>(kHookCmdSetPerformanceStreamMarkerINTEL)) {
+        const HookScope scope;
+        return hook(commandBuffer, pMarkerInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetPerformanceStreamMarkerINTEL, RecordArray("pMarkerInfo", pMarkerInfo, 1));
     return VK_SUCCESS;
 }
 
+template <>
+struct RecordedStruct<VkPerformanceOverrideInfoINTEL> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkPerformanceOverrideInfoINTEL&) { return 0; }
+    static void CopyNested(VkPerformanceOverrideInfoINTEL& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR VkResult VKAPI_CALL CmdSetPerformanceOverrideINTEL(
     VkCommandBuffer                             commandBuffer,
     const VkPerformanceOverrideInfoINTEL*       pOverrideInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetPerformanceOverrideINTEL>(kHookCmdSetPerformanceOverrideINTEL)) {
+        const HookScope scope;
+        return hook(commandBuffer, pOverrideInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetPerformanceOverrideINTEL, RecordArray("pOverrideInfo", pOverrideInfo, 1));
     return VK_SUCCESS;
 }
 
@@ -4954,6 +10401,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL AcquirePerformanceConfigurationINTEL(
     const VkPerformanceConfigurationAcquireInfoINTEL* pAcquireInfo,
     VkPerformanceConfigurationINTEL*            pConfiguration)
 {
+    if (const auto hook = GetHook<PFN_vkAcquirePerformanceConfigurationINTEL>(kHookAcquirePerformanceConfigurationINTEL)) {
+        const HookScope scope;
+        return hook(device, pAcquireInfo, pConfiguration);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4962,6 +10413,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL ReleasePerformanceConfigurationINTEL(
     VkDevice                                    device,
     VkPerformanceConfigurationINTEL             configuration)
 {
+    if (const auto hook = GetHook<PFN_vkReleasePerformanceConfigurationINTEL>(kHookReleasePerformanceConfigurationINTEL)) {
+        const HookScope scope;
+        return hook(device, configuration);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4970,6 +10425,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL QueueSetPerformanceConfigurationINTEL(
     VkQueue                                     queue,
     VkPerformanceConfigurationINTEL             configuration)
 {
+    if (const auto hook = GetHook<PFN_vkQueueSetPerformanceConfigurationINTEL>(kHookQueueSetPerformanceConfigurationINTEL)) {
+        const HookScope scope;
+        return hook(queue, configuration);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4979,6 +10438,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPerformanceParameterINTEL(
     VkPerformanceParameterTypeINTEL             parameter,
     VkPerformanceValueINTEL*                    pValue)
 {
+    if (const auto hook = GetHook<PFN_vkGetPerformanceParameterINTEL>(kHookGetPerformanceParameterINTEL)) {
+        const HookScope scope;
+        return hook(device, parameter, pValue);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -4990,6 +10453,10 @@ static VKAPI_ATTR void VKAPI_CALL SetLocalDimmingAMD(
     VkSwapchainKHR                              swapChain,
     VkBool32                                    localDimmingEnable)
 {
+    if (const auto hook = GetHook<PFN_vkSetLocalDimmingAMD>(kHookSetLocalDimmingAMD)) {
+        const HookScope scope;
+        return hook(device, swapChain, localDimmingEnable);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -5001,8 +10468,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateImagePipeSurfaceFUCHSIA(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateImagePipeSurfaceFUCHSIA>(kHookCreateImagePipeSurfaceFUCHSIA)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 #endif /* VK_USE_PLATFORM_FUCHSIA */
@@ -5015,8 +10487,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateMetalSurfaceEXT(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateMetalSurfaceEXT>(kHookCreateMetalSurfaceEXT)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 #endif /* VK_USE_PLATFORM_METAL_EXT */
@@ -5037,8 +10514,11 @@ static VKAPI_ATTR VkDeviceAddress VKAPI_CALL GetBufferDeviceAddressEXT(
     VkDevice                                    device,
     const VkBufferDeviceAddressInfo*            pInfo)
 {
-//Not a CREATE or DESTROY function
-    return VK_SUCCESS;
+    if (const auto hook = GetHook<PFN_vkGetBufferDeviceAddressEXT>(kHookGetBufferDeviceAddressEXT)) {
+        const HookScope scope;
+        return hook(device, pInfo);
+    }
+    return GetBufferDeviceAddressImpl(device, pInfo);
 }
 
 
@@ -5047,6 +10527,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceToolPropertiesEXT(
     uint32_t*                                   pToolCount,
     VkPhysicalDeviceToolProperties*             pToolProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceToolPropertiesEXT>(kHookGetPhysicalDeviceToolPropertiesEXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, pToolCount, pToolProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5059,6 +10543,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceCooperativeMatrixProperti
     uint32_t*                                   pPropertyCount,
     VkCooperativeMatrixPropertiesNV*            pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceCooperativeMatrixPropertiesNV>(kHookGetPhysicalDeviceCooperativeMatrixPropertiesNV)) {
+        const HookScope scope;
+        return hook(physicalDevice, pPropertyCount, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5069,6 +10557,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSupportedFramebufferMixed
     uint32_t*                                   pCombinationCount,
     VkFramebufferMixedSamplesCombinationNV*     pCombinations)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV>(kHookGetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV)) {
+        const HookScope scope;
+        return hook(physicalDevice, pCombinationCount, pCombinations);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5084,6 +10576,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfacePresentModes2EXT(
     uint32_t*                                   pPresentModeCount,
     VkPresentModeKHR*                           pPresentModes)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceSurfacePresentModes2EXT>(kHookGetPhysicalDeviceSurfacePresentModes2EXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, pSurfaceInfo, pPresentModeCount, pPresentModes);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5092,6 +10588,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL AcquireFullScreenExclusiveModeEXT(
     VkDevice                                    device,
     VkSwapchainKHR                              swapchain)
 {
+    if (const auto hook = GetHook<PFN_vkAcquireFullScreenExclusiveModeEXT>(kHookAcquireFullScreenExclusiveModeEXT)) {
+        const HookScope scope;
+        return hook(device, swapchain);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5100,6 +10600,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL ReleaseFullScreenExclusiveModeEXT(
     VkDevice                                    device,
     VkSwapchainKHR                              swapchain)
 {
+    if (const auto hook = GetHook<PFN_vkReleaseFullScreenExclusiveModeEXT>(kHookReleaseFullScreenExclusiveModeEXT)) {
+        const HookScope scope;
+        return hook(device, swapchain);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5109,6 +10613,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetDeviceGroupSurfacePresentModes2EXT(
     const VkPhysicalDeviceSurfaceInfo2KHR*      pSurfaceInfo,
     VkDeviceGroupPresentModeFlagsKHR*           pModes)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceGroupSurfacePresentModes2EXT>(kHookGetDeviceGroupSurfacePresentModes2EXT)) {
+        const HookScope scope;
+        return hook(device, pSurfaceInfo, pModes);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5121,8 +10629,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateHeadlessSurfaceEXT(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateHeadlessSurfaceEXT>(kHookCreateHeadlessSurfaceEXT)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 
@@ -5132,7 +10645,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetLineStippleEXT(
     uint32_t                                    lineStippleFactor,
     uint16_t                                    lineStipplePattern)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetLineStippleEXT>(kHookCmdSetLineStippleEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, lineStippleFactor, lineStipplePattern);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetLineStippleEXT, lineStippleFactor, lineStipplePattern);
 }
 
 
@@ -5143,7 +10661,11 @@ static VKAPI_ATTR void VKAPI_CALL ResetQueryPoolEXT(
     uint32_t                                    firstQuery,
     uint32_t                                    queryCount)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkResetQueryPoolEXT>(kHookResetQueryPoolEXT)) {
+        const HookScope scope;
+        return hook(device, queryPool, firstQuery, queryCount);
+    }
+    CallInternal(ResetQueryPool, device, queryPool, firstQuery, queryCount);
 }
 
 
@@ -5152,21 +10674,36 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetCullModeEXT(
     VkCommandBuffer                             commandBuffer,
     VkCullModeFlags                             cullMode)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetCullModeEXT>(kHookCmdSetCullModeEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, cullMode);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetCullModeEXT, cullMode);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetFrontFaceEXT(
     VkCommandBuffer                             commandBuffer,
     VkFrontFace                                 frontFace)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetFrontFaceEXT>(kHookCmdSetFrontFaceEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, frontFace);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetFrontFaceEXT, frontFace);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetPrimitiveTopologyEXT(
     VkCommandBuffer                             commandBuffer,
     VkPrimitiveTopology                         primitiveTopology)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetPrimitiveTopologyEXT>(kHookCmdSetPrimitiveTopologyEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, primitiveTopology);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetPrimitiveTopologyEXT, primitiveTopology);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetViewportWithCountEXT(
@@ -5174,7 +10711,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetViewportWithCountEXT(
     uint32_t                                    viewportCount,
     const VkViewport*                           pViewports)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetViewportWithCountEXT>(kHookCmdSetViewportWithCountEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, viewportCount, pViewports);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetViewportWithCountEXT, viewportCount, RecordArray("pViewports", pViewports, viewportCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetScissorWithCountEXT(
@@ -5182,7 +10724,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetScissorWithCountEXT(
     uint32_t                                    scissorCount,
     const VkRect2D*                             pScissors)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetScissorWithCountEXT>(kHookCmdSetScissorWithCountEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, scissorCount, pScissors);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetScissorWithCountEXT, scissorCount, RecordArray("pScissors", pScissors, scissorCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers2EXT(
@@ -5194,42 +10741,72 @@ static VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers2EXT(
     const VkDeviceSize*                         pSizes,
     const VkDeviceSize*                         pStrides)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBindVertexBuffers2EXT>(kHookCmdBindVertexBuffers2EXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, firstBinding, bindingCount, pBuffers, pOffsets, pSizes, pStrides);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBindVertexBuffers2EXT, firstBinding, bindingCount, RecordArray("pBuffers", pBuffers, bindingCount), RecordArray("pOffsets", pOffsets, bindingCount), RecordArray("pSizes", pSizes, bindingCount), RecordArray("pStrides", pStrides, bindingCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthTestEnableEXT(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    depthTestEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthTestEnableEXT>(kHookCmdSetDepthTestEnableEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthTestEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthTestEnableEXT, depthTestEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthWriteEnableEXT(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    depthWriteEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthWriteEnableEXT>(kHookCmdSetDepthWriteEnableEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthWriteEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthWriteEnableEXT, depthWriteEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthCompareOpEXT(
     VkCommandBuffer                             commandBuffer,
     VkCompareOp                                 depthCompareOp)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthCompareOpEXT>(kHookCmdSetDepthCompareOpEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthCompareOp);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthCompareOpEXT, depthCompareOp);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthBoundsTestEnableEXT(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    depthBoundsTestEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthBoundsTestEnableEXT>(kHookCmdSetDepthBoundsTestEnableEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthBoundsTestEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthBoundsTestEnableEXT, depthBoundsTestEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetStencilTestEnableEXT(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    stencilTestEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetStencilTestEnableEXT>(kHookCmdSetStencilTestEnableEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, stencilTestEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetStencilTestEnableEXT, stencilTestEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetStencilOpEXT(
@@ -5240,7 +10817,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetStencilOpEXT(
     VkStencilOp                                 depthFailOp,
     VkCompareOp                                 compareOp)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetStencilOpEXT>(kHookCmdSetStencilOpEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, faceMask, failOp, passOp, depthFailOp, compareOp);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetStencilOpEXT, faceMask, failOp, passOp, depthFailOp, compareOp);
 }
 
 
@@ -5251,14 +10833,37 @@ static VKAPI_ATTR void VKAPI_CALL GetGeneratedCommandsMemoryRequirementsNV(
     const VkGeneratedCommandsMemoryRequirementsInfoNV* pInfo,
     VkMemoryRequirements2*                      pMemoryRequirements)
 {
+    if (const auto hook = GetHook<PFN_vkGetGeneratedCommandsMemoryRequirementsNV>(kHookGetGeneratedCommandsMemoryRequirementsNV)) {
+        const HookScope scope;
+        return hook(device, pInfo, pMemoryRequirements);
+    }
 //Not a CREATE or DESTROY function
 }
 
+template <>
+struct RecordedStruct<VkGeneratedCommandsInfoNV> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkGeneratedCommandsInfoNV& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pStreams, s.streamCount);
+        return size;
+    }
+    static void CopyNested(VkGeneratedCommandsInfoNV& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pStreams = writer.CopyArray(s.pStreams, s.streamCount);
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdPreprocessGeneratedCommandsNV(
     VkCommandBuffer                             commandBuffer,
     const VkGeneratedCommandsInfoNV*            pGeneratedCommandsInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdPreprocessGeneratedCommandsNV>(kHookCmdPreprocessGeneratedCommandsNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, pGeneratedCommandsInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdPreprocessGeneratedCommandsNV, RecordArray("pGeneratedCommandsInfo", pGeneratedCommandsInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdExecuteGeneratedCommandsNV(
@@ -5266,7 +10871,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdExecuteGeneratedCommandsNV(
     VkBool32                                    isPreprocessed,
     const VkGeneratedCommandsInfoNV*            pGeneratedCommandsInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdExecuteGeneratedCommandsNV>(kHookCmdExecuteGeneratedCommandsNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, isPreprocessed, pGeneratedCommandsInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdExecuteGeneratedCommandsNV, isPreprocessed, RecordArray("pGeneratedCommandsInfo", pGeneratedCommandsInfo, 1));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBindPipelineShaderGroupNV(
@@ -5275,7 +10885,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBindPipelineShaderGroupNV(
     VkPipeline                                  pipeline,
     uint32_t                                    groupIndex)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBindPipelineShaderGroupNV>(kHookCmdBindPipelineShaderGroupNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, pipelineBindPoint, pipeline, groupIndex);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBindPipelineShaderGroupNV, pipelineBindPoint, pipeline, groupIndex);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateIndirectCommandsLayoutNV(
@@ -5284,8 +10899,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateIndirectCommandsLayoutNV(
     const VkAllocationCallbacks*                pAllocator,
     VkIndirectCommandsLayoutNV*                 pIndirectCommandsLayout)
 {
-    unique_lock_t lock(global_lock);
-    *pIndirectCommandsLayout = (VkIndirectCommandsLayoutNV)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateIndirectCommandsLayoutNV>(kHookCreateIndirectCommandsLayoutNV)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pIndirectCommandsLayout);
+    }
+    *pIndirectCommandsLayout = (VkIndirectCommandsLayoutNV)NewHandle(device, VK_OBJECT_TYPE_INDIRECT_COMMANDS_LAYOUT_NV);
+    TrackObjects(VK_OBJECT_TYPE_INDIRECT_COMMANDS_LAYOUT_NV, 1);
+    AddLiveObject("VkIndirectCommandsLayoutNV", (uint64_t)*pIndirectCommandsLayout);
     return VK_SUCCESS;
 }
 
@@ -5294,7 +10914,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyIndirectCommandsLayoutNV(
     VkIndirectCommandsLayoutNV                  indirectCommandsLayout,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyIndirectCommandsLayoutNV>(kHookDestroyIndirectCommandsLayoutNV)) {
+        const HookScope scope;
+        return hook(device, indirectCommandsLayout, pAllocator);
+    }
 //Destroy object
+    if (indirectCommandsLayout != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_INDIRECT_COMMANDS_LAYOUT_NV, -1);
+    RemoveLiveObject((uint64_t)indirectCommandsLayout);
 }
 
 
@@ -5307,6 +10933,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL AcquireDrmDisplayEXT(
     int32_t                                     drmFd,
     VkDisplayKHR                                display)
 {
+    if (const auto hook = GetHook<PFN_vkAcquireDrmDisplayEXT>(kHookAcquireDrmDisplayEXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, drmFd, display);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5317,6 +10947,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetDrmDisplayEXT(
     uint32_t                                    connectorId,
     VkDisplayKHR*                               display)
 {
+    if (const auto hook = GetHook<PFN_vkGetDrmDisplayEXT>(kHookGetDrmDisplayEXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, drmFd, connectorId, display);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5331,8 +10965,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreatePrivateDataSlotEXT(
     const VkAllocationCallbacks*                pAllocator,
     VkPrivateDataSlot*                          pPrivateDataSlot)
 {
-    unique_lock_t lock(global_lock);
-    *pPrivateDataSlot = (VkPrivateDataSlot)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreatePrivateDataSlotEXT>(kHookCreatePrivateDataSlotEXT)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pPrivateDataSlot);
+    }
+    *pPrivateDataSlot = (VkPrivateDataSlot)NewHandle(device, VK_OBJECT_TYPE_PRIVATE_DATA_SLOT);
+    TrackObjects(VK_OBJECT_TYPE_PRIVATE_DATA_SLOT, 1);
+    AddLiveObject("VkPrivateDataSlot", (uint64_t)*pPrivateDataSlot);
     return VK_SUCCESS;
 }
 
@@ -5341,7 +10980,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyPrivateDataSlotEXT(
     VkPrivateDataSlot                           privateDataSlot,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyPrivateDataSlotEXT>(kHookDestroyPrivateDataSlotEXT)) {
+        const HookScope scope;
+        return hook(device, privateDataSlot, pAllocator);
+    }
 //Destroy object
+    if (privateDataSlot != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_PRIVATE_DATA_SLOT, -1);
+    RemoveLiveObject((uint64_t)privateDataSlot);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL SetPrivateDataEXT(
@@ -5351,6 +10996,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL SetPrivateDataEXT(
     VkPrivateDataSlot                           privateDataSlot,
     uint64_t                                    data)
 {
+    if (const auto hook = GetHook<PFN_vkSetPrivateDataEXT>(kHookSetPrivateDataEXT)) {
+        const HookScope scope;
+        return hook(device, objectType, objectHandle, privateDataSlot, data);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5362,6 +11011,10 @@ static VKAPI_ATTR void VKAPI_CALL GetPrivateDataEXT(
     VkPrivateDataSlot                           privateDataSlot,
     uint64_t*                                   pData)
 {
+    if (const auto hook = GetHook<PFN_vkGetPrivateDataEXT>(kHookGetPrivateDataEXT)) {
+        const HookScope scope;
+        return hook(device, objectType, objectHandle, privateDataSlot, pData);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -5374,7 +11027,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetFragmentShadingRateEnumNV(
     VkFragmentShadingRateNV                     shadingRate,
     const VkFragmentShadingRateCombinerOpKHR    combinerOps[2])
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetFragmentShadingRateEnumNV>(kHookCmdSetFragmentShadingRateEnumNV)) {
+        const HookScope scope;
+        return hook(commandBuffer, shadingRate, combinerOps);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetFragmentShadingRateEnumNV, shadingRate, RecordArray("combinerOps", combinerOps, 2));
 }
 
 
@@ -5391,6 +11049,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL AcquireWinrtDisplayNV(
     VkPhysicalDevice                            physicalDevice,
     VkDisplayKHR                                display)
 {
+    if (const auto hook = GetHook<PFN_vkAcquireWinrtDisplayNV>(kHookAcquireWinrtDisplayNV)) {
+        const HookScope scope;
+        return hook(physicalDevice, display);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5400,6 +11062,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetWinrtDisplayNV(
     uint32_t                                    deviceRelativeId,
     VkDisplayKHR*                               pDisplay)
 {
+    if (const auto hook = GetHook<PFN_vkGetWinrtDisplayNV>(kHookGetWinrtDisplayNV)) {
+        const HookScope scope;
+        return hook(physicalDevice, deviceRelativeId, pDisplay);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5413,8 +11079,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateDirectFBSurfaceEXT(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateDirectFBSurfaceEXT>(kHookCreateDirectFBSurfaceEXT)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 
@@ -5423,6 +11094,10 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceDirectFBPresentationSuppo
     uint32_t                                    queueFamilyIndex,
     IDirectFB*                                  dfb)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceDirectFBPresentationSupportEXT>(kHookGetPhysicalDeviceDirectFBPresentationSupportEXT)) {
+        const HookScope scope;
+        return hook(physicalDevice, queueFamilyIndex, dfb);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5430,6 +11105,24 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceDirectFBPresentationSuppo
 
 
 
+template <>
+struct RecordedStruct<VkVertexInputBindingDescription2EXT> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkVertexInputBindingDescription2EXT&) { return 0; }
+    static void CopyNested(VkVertexInputBindingDescription2EXT& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkVertexInputAttributeDescription2EXT> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkVertexInputAttributeDescription2EXT&) { return 0; }
+    static void CopyNested(VkVertexInputAttributeDescription2EXT& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdSetVertexInputEXT(
     VkCommandBuffer                             commandBuffer,
     uint32_t                                    vertexBindingDescriptionCount,
@@ -5437,7 +11130,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetVertexInputEXT(
     uint32_t                                    vertexAttributeDescriptionCount,
     const VkVertexInputAttributeDescription2EXT* pVertexAttributeDescriptions)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetVertexInputEXT>(kHookCmdSetVertexInputEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, vertexBindingDescriptionCount, pVertexBindingDescriptions, vertexAttributeDescriptionCount, pVertexAttributeDescriptions);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetVertexInputEXT, vertexBindingDescriptionCount, RecordArray("pVertexBindingDescriptions", pVertexBindingDescriptions, vertexBindingDescriptionCount), vertexAttributeDescriptionCount, RecordArray("pVertexAttributeDescriptions", pVertexAttributeDescriptions, vertexAttributeDescriptionCount));
 }
 
 
@@ -5450,6 +11148,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryZirconHandleFUCHSIA(
     const VkMemoryGetZirconHandleInfoFUCHSIA*   pGetZirconHandleInfo,
     zx_handle_t*                                pZirconHandle)
 {
+    if (const auto hook = GetHook<PFN_vkGetMemoryZirconHandleFUCHSIA>(kHookGetMemoryZirconHandleFUCHSIA)) {
+        const HookScope scope;
+        return hook(device, pGetZirconHandleInfo, pZirconHandle);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5460,6 +11162,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryZirconHandlePropertiesFUCHSIA(
     zx_handle_t                                 zirconHandle,
     VkMemoryZirconHandlePropertiesFUCHSIA*      pMemoryZirconHandleProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetMemoryZirconHandlePropertiesFUCHSIA>(kHookGetMemoryZirconHandlePropertiesFUCHSIA)) {
+        const HookScope scope;
+        return hook(device, handleType, zirconHandle, pMemoryZirconHandleProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5471,6 +11177,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL ImportSemaphoreZirconHandleFUCHSIA(
     VkDevice                                    device,
     const VkImportSemaphoreZirconHandleInfoFUCHSIA* pImportSemaphoreZirconHandleInfo)
 {
+    if (const auto hook = GetHook<PFN_vkImportSemaphoreZirconHandleFUCHSIA>(kHookImportSemaphoreZirconHandleFUCHSIA)) {
+        const HookScope scope;
+        return hook(device, pImportSemaphoreZirconHandleInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5480,6 +11190,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetSemaphoreZirconHandleFUCHSIA(
     const VkSemaphoreGetZirconHandleInfoFUCHSIA* pGetZirconHandleInfo,
     zx_handle_t*                                pZirconHandle)
 {
+    if (const auto hook = GetHook<PFN_vkGetSemaphoreZirconHandleFUCHSIA>(kHookGetSemaphoreZirconHandleFUCHSIA)) {
+        const HookScope scope;
+        return hook(device, pGetZirconHandleInfo, pZirconHandle);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5493,8 +11207,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateBufferCollectionFUCHSIA(
     const VkAllocationCallbacks*                pAllocator,
     VkBufferCollectionFUCHSIA*                  pCollection)
 {
-    unique_lock_t lock(global_lock);
-    *pCollection = (VkBufferCollectionFUCHSIA)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateBufferCollectionFUCHSIA>(kHookCreateBufferCollectionFUCHSIA)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pCollection);
+    }
+    *pCollection = (VkBufferCollectionFUCHSIA)NewHandle(device, VK_OBJECT_TYPE_BUFFER_COLLECTION_FUCHSIA);
+    TrackObjects(VK_OBJECT_TYPE_BUFFER_COLLECTION_FUCHSIA, 1);
+    AddLiveObject("VkBufferCollectionFUCHSIA", (uint64_t)*pCollection);
     return VK_SUCCESS;
 }
 
@@ -5503,6 +11222,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL SetBufferCollectionImageConstraintsFUCHSIA
     VkBufferCollectionFUCHSIA                   collection,
     const VkImageConstraintsInfoFUCHSIA*        pImageConstraintsInfo)
 {
+    if (const auto hook = GetHook<PFN_vkSetBufferCollectionImageConstraintsFUCHSIA>(kHookSetBufferCollectionImageConstraintsFUCHSIA)) {
+        const HookScope scope;
+        return hook(device, collection, pImageConstraintsInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5512,6 +11235,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL SetBufferCollectionBufferConstraintsFUCHSI
     VkBufferCollectionFUCHSIA                   collection,
     const VkBufferConstraintsInfoFUCHSIA*       pBufferConstraintsInfo)
 {
+    if (const auto hook = GetHook<PFN_vkSetBufferCollectionBufferConstraintsFUCHSIA>(kHookSetBufferCollectionBufferConstraintsFUCHSIA)) {
+        const HookScope scope;
+        return hook(device, collection, pBufferConstraintsInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5521,7 +11248,13 @@ static VKAPI_ATTR void VKAPI_CALL DestroyBufferCollectionFUCHSIA(
     VkBufferCollectionFUCHSIA                   collection,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyBufferCollectionFUCHSIA>(kHookDestroyBufferCollectionFUCHSIA)) {
+        const HookScope scope;
+        return hook(device, collection, pAllocator);
+    }
 //Destroy object
+    if (collection != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_BUFFER_COLLECTION_FUCHSIA, -1);
+    RemoveLiveObject((uint64_t)collection);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetBufferCollectionPropertiesFUCHSIA(
@@ -5529,6 +11262,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetBufferCollectionPropertiesFUCHSIA(
     VkBufferCollectionFUCHSIA                   collection,
     VkBufferCollectionPropertiesFUCHSIA*        pProperties)
 {
+    if (const auto hook = GetHook<PFN_vkGetBufferCollectionPropertiesFUCHSIA>(kHookGetBufferCollectionPropertiesFUCHSIA)) {
+        const HookScope scope;
+        return hook(device, collection, pProperties);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5540,6 +11277,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetDeviceSubpassShadingMaxWorkgroupSizeHUA
     VkRenderPass                                renderpass,
     VkExtent2D*                                 pMaxWorkgroupSize)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceSubpassShadingMaxWorkgroupSizeHUAWEI>(kHookGetDeviceSubpassShadingMaxWorkgroupSizeHUAWEI)) {
+        const HookScope scope;
+        return hook(device, renderpass, pMaxWorkgroupSize);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5547,7 +11288,12 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetDeviceSubpassShadingMaxWorkgroupSizeHUA
 static VKAPI_ATTR void VKAPI_CALL CmdSubpassShadingHUAWEI(
     VkCommandBuffer                             commandBuffer)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSubpassShadingHUAWEI>(kHookCmdSubpassShadingHUAWEI)) {
+        const HookScope scope;
+        return hook(commandBuffer);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSubpassShadingHUAWEI);
 }
 
 
@@ -5556,7 +11302,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBindInvocationMaskHUAWEI(
     VkImageView                                 imageView,
     VkImageLayout                               imageLayout)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBindInvocationMaskHUAWEI>(kHookCmdBindInvocationMaskHUAWEI)) {
+        const HookScope scope;
+        return hook(commandBuffer, imageView, imageLayout);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBindInvocationMaskHUAWEI, imageView, imageLayout);
 }
 
 
@@ -5565,6 +11316,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetMemoryRemoteAddressNV(
     const VkMemoryGetRemoteAddressInfoNV*       pMemoryGetRemoteAddressInfo,
     VkRemoteAddressNV*                          pAddress)
 {
+    if (const auto hook = GetHook<PFN_vkGetMemoryRemoteAddressNV>(kHookGetMemoryRemoteAddressNV)) {
+        const HookScope scope;
+        return hook(device, pMemoryGetRemoteAddressInfo, pAddress);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5574,35 +11329,60 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetPatchControlPointsEXT(
     VkCommandBuffer                             commandBuffer,
     uint32_t                                    patchControlPoints)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetPatchControlPointsEXT>(kHookCmdSetPatchControlPointsEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, patchControlPoints);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetPatchControlPointsEXT, patchControlPoints);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetRasterizerDiscardEnableEXT(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    rasterizerDiscardEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetRasterizerDiscardEnableEXT>(kHookCmdSetRasterizerDiscardEnableEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, rasterizerDiscardEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetRasterizerDiscardEnableEXT, rasterizerDiscardEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetDepthBiasEnableEXT(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    depthBiasEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetDepthBiasEnableEXT>(kHookCmdSetDepthBiasEnableEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, depthBiasEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetDepthBiasEnableEXT, depthBiasEnable);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetLogicOpEXT(
     VkCommandBuffer                             commandBuffer,
     VkLogicOp                                   logicOp)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetLogicOpEXT>(kHookCmdSetLogicOpEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, logicOp);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetLogicOpEXT, logicOp);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdSetPrimitiveRestartEnableEXT(
     VkCommandBuffer                             commandBuffer,
     VkBool32                                    primitiveRestartEnable)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetPrimitiveRestartEnableEXT>(kHookCmdSetPrimitiveRestartEnableEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, primitiveRestartEnable);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetPrimitiveRestartEnableEXT, primitiveRestartEnable);
 }
 
 #ifdef VK_USE_PLATFORM_SCREEN_QNX
@@ -5613,8 +11393,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateScreenSurfaceQNX(
     const VkAllocationCallbacks*                pAllocator,
     VkSurfaceKHR*                               pSurface)
 {
-    unique_lock_t lock(global_lock);
-    *pSurface = (VkSurfaceKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateScreenSurfaceQNX>(kHookCreateScreenSurfaceQNX)) {
+        const HookScope scope;
+        return hook(instance, pCreateInfo, pAllocator, pSurface);
+    }
+    *pSurface = (VkSurfaceKHR)NewHandle(instance, VK_OBJECT_TYPE_SURFACE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SURFACE_KHR, 1);
+    AddLiveObject("VkSurfaceKHR", (uint64_t)*pSurface);
     return VK_SUCCESS;
 }
 
@@ -5623,6 +11408,10 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceScreenPresentationSupport
     uint32_t                                    queueFamilyIndex,
     struct _screen_window*                      window)
 {
+    if (const auto hook = GetHook<PFN_vkGetPhysicalDeviceScreenPresentationSupportQNX>(kHookGetPhysicalDeviceScreenPresentationSupportQNX)) {
+        const HookScope scope;
+        return hook(physicalDevice, queueFamilyIndex, window);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5634,7 +11423,12 @@ static VKAPI_ATTR void                                    VKAPI_CALL CmdSetColor
     uint32_t                                    attachmentCount,
     const VkBool32*                             pColorWriteEnables)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetColorWriteEnableEXT>(kHookCmdSetColorWriteEnableEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, attachmentCount, pColorWriteEnables);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetColorWriteEnableEXT, attachmentCount);
 }
 
 
@@ -5648,7 +11442,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawMultiEXT(
     uint32_t                                    firstInstance,
     uint32_t                                    stride)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawMultiEXT>(kHookCmdDrawMultiEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, drawCount, pVertexInfo, instanceCount, firstInstance, stride);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawMultiEXT, drawCount, RecordArray("pVertexInfo", pVertexInfo, drawCount, stride), instanceCount, firstInstance, stride);
+    CountCommand(commandBuffer, kCounterDraws, drawCount);
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdDrawMultiIndexedEXT(
@@ -5660,7 +11459,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdDrawMultiIndexedEXT(
     uint32_t                                    stride,
     const int32_t*                              pVertexOffset)
 {
-//Not a CREATE or DESTROY function
+    if (const auto hook = GetHook<PFN_vkCmdDrawMultiIndexedEXT>(kHookCmdDrawMultiIndexedEXT)) {
+        const HookScope scope;
+        return hook(commandBuffer, drawCount, pIndexInfo, instanceCount, firstInstance, stride, pVertexOffset);
+    }
+    RecordCommand(commandBuffer, kOpCmdDrawMultiIndexedEXT, drawCount, RecordArray("pIndexInfo", pIndexInfo, drawCount, stride), instanceCount, firstInstance, stride, RecordArray("pVertexOffset", pVertexOffset, 1));
+    CountCommand(commandBuffer, kCounterDraws, drawCount);
 }
 
 
@@ -5671,6 +11475,10 @@ static VKAPI_ATTR void VKAPI_CALL SetDeviceMemoryPriorityEXT(
     VkDeviceMemory                              memory,
     float                                       priority)
 {
+    if (const auto hook = GetHook<PFN_vkSetDeviceMemoryPriorityEXT>(kHookSetDeviceMemoryPriorityEXT)) {
+        const HookScope scope;
+        return hook(device, memory, priority);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -5684,8 +11492,13 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateAccelerationStructureKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkAccelerationStructureKHR*                 pAccelerationStructure)
 {
-    unique_lock_t lock(global_lock);
-    *pAccelerationStructure = (VkAccelerationStructureKHR)global_unique_handle++;
+    if (const auto hook = GetHook<PFN_vkCreateAccelerationStructureKHR>(kHookCreateAccelerationStructureKHR)) {
+        const HookScope scope;
+        return hook(device, pCreateInfo, pAllocator, pAccelerationStructure);
+    }
+    *pAccelerationStructure = (VkAccelerationStructureKHR)NewHandle(device, VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR);
+    TrackObjects(VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR, 1);
+    AddLiveObject("VkAccelerationStructureKHR", (uint64_t)*pAccelerationStructure);
     return VK_SUCCESS;
 }
 
@@ -5694,16 +11507,51 @@ static VKAPI_ATTR void VKAPI_CALL DestroyAccelerationStructureKHR(
     VkAccelerationStructureKHR                  accelerationStructure,
     const VkAllocationCallbacks*                pAllocator)
 {
+    if (const auto hook = GetHook<PFN_vkDestroyAccelerationStructureKHR>(kHookDestroyAccelerationStructureKHR)) {
+        const HookScope scope;
+        return hook(device, accelerationStructure, pAllocator);
+    }
 //Destroy object
+    if (accelerationStructure != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR, -1);
+    RemoveLiveObject((uint64_t)accelerationStructure);
 }
 
+template <>
+struct RecordedStruct<VkAccelerationStructureGeometryKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkAccelerationStructureGeometryKHR&) { return 0; }
+    static void CopyNested(VkAccelerationStructureGeometryKHR& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
+template <>
+struct RecordedStruct<VkAccelerationStructureBuildGeometryInfoKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkAccelerationStructureBuildGeometryInfoKHR& s) {
+        size_t size = 0;
+        size += RecordedArraySize(s.pGeometries, s.geometryCount);
+        return size;
+    }
+    static void CopyNested(VkAccelerationStructureBuildGeometryInfoKHR& s, CommandDataWriter& writer) {
+        s.pNext = nullptr;
+        s.pGeometries = writer.CopyArray(s.pGeometries, s.geometryCount);
+        s.ppGeometries = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdBuildAccelerationStructuresKHR(
     VkCommandBuffer                             commandBuffer,
     uint32_t                                    infoCount,
     const VkAccelerationStructureBuildGeometryInfoKHR* pInfos,
     const VkAccelerationStructureBuildRangeInfoKHR* const* ppBuildRangeInfos)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBuildAccelerationStructuresKHR>(kHookCmdBuildAccelerationStructuresKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, infoCount, pInfos, ppBuildRangeInfos);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBuildAccelerationStructuresKHR, infoCount, RecordArray("pInfos", pInfos, infoCount));
 }
 
 static VKAPI_ATTR void VKAPI_CALL CmdBuildAccelerationStructuresIndirectKHR(
@@ -5714,7 +11562,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdBuildAccelerationStructuresIndirectKHR(
     const uint32_t*                             pIndirectStrides,
     const uint32_t* const*                      ppMaxPrimitiveCounts)
 {
+    if (const auto hook = GetHook<PFN_vkCmdBuildAccelerationStructuresIndirectKHR>(kHookCmdBuildAccelerationStructuresIndirectKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, infoCount, pInfos, pIndirectDeviceAddresses, pIndirectStrides, ppMaxPrimitiveCounts);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdBuildAccelerationStructuresIndirectKHR, infoCount, RecordArray("pInfos", pInfos, infoCount), RecordArray("pIndirectDeviceAddresses", pIndirectDeviceAddresses, infoCount), RecordArray("pIndirectStrides", pIndirectStrides, infoCount));
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL BuildAccelerationStructuresKHR(
@@ -5724,6 +11577,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL BuildAccelerationStructuresKHR(
     const VkAccelerationStructureBuildGeometryInfoKHR* pInfos,
     const VkAccelerationStructureBuildRangeInfoKHR* const* ppBuildRangeInfos)
 {
+    if (const auto hook = GetHook<PFN_vkBuildAccelerationStructuresKHR>(kHookBuildAccelerationStructuresKHR)) {
+        const HookScope scope;
+        return hook(device, deferredOperation, infoCount, pInfos, ppBuildRangeInfos);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5733,6 +11590,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL CopyAccelerationStructureKHR(
     VkDeferredOperationKHR                      deferredOperation,
     const VkCopyAccelerationStructureInfoKHR*   pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCopyAccelerationStructureKHR>(kHookCopyAccelerationStructureKHR)) {
+        const HookScope scope;
+        return hook(device, deferredOperation, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5742,6 +11603,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL CopyAccelerationStructureToMemoryKHR(
     VkDeferredOperationKHR                      deferredOperation,
     const VkCopyAccelerationStructureToMemoryInfoKHR* pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCopyAccelerationStructureToMemoryKHR>(kHookCopyAccelerationStructureToMemoryKHR)) {
+        const HookScope scope;
+        return hook(device, deferredOperation, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5751,6 +11616,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL CopyMemoryToAccelerationStructureKHR(
     VkDeferredOperationKHR                      deferredOperation,
     const VkCopyMemoryToAccelerationStructureInfoKHR* pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCopyMemoryToAccelerationStructureKHR>(kHookCopyMemoryToAccelerationStructureKHR)) {
+        const HookScope scope;
+        return hook(device, deferredOperation, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5764,35 +11633,85 @@ static VKAPI_ATTR VkResult VKAPI_CALL WriteAccelerationStructuresPropertiesKHR(
     void*                                       pData,
     size_t                                      stride)
 {
+    if (const auto hook = GetHook<PFN_vkWriteAccelerationStructuresPropertiesKHR>(kHookWriteAccelerationStructuresPropertiesKHR)) {
+        const HookScope scope;
+        return hook(device, accelerationStructureCount, pAccelerationStructures, queryType, dataSize, pData, stride);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
 
+template <>
+struct RecordedStruct<VkCopyAccelerationStructureInfoKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkCopyAccelerationStructureInfoKHR&) { return 0; }
+    static void CopyNested(VkCopyAccelerationStructureInfoKHR& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdCopyAccelerationStructureKHR(
     VkCommandBuffer                             commandBuffer,
     const VkCopyAccelerationStructureInfoKHR*   pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyAccelerationStructureKHR>(kHookCmdCopyAccelerationStructureKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyAccelerationStructureKHR, RecordArray("pInfo", pInfo, 1));
 }
 
+template <>
+struct RecordedStruct<VkCopyAccelerationStructureToMemoryInfoKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkCopyAccelerationStructureToMemoryInfoKHR&) { return 0; }
+    static void CopyNested(VkCopyAccelerationStructureToMemoryInfoKHR& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdCopyAccelerationStructureToMemoryKHR(
     VkCommandBuffer                             commandBuffer,
     const VkCopyAccelerationStructureToMemoryInfoKHR* pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyAccelerationStructureToMemoryKHR>(kHookCmdCopyAccelerationStructureToMemoryKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyAccelerationStructureToMemoryKHR, RecordArray("pInfo", pInfo, 1));
 }
 
+template <>
+struct RecordedStruct<VkCopyMemoryToAccelerationStructureInfoKHR> {
+    static const bool kHasPointers = true;
+    static size_t NestedSize(const VkCopyMemoryToAccelerationStructureInfoKHR&) { return 0; }
+    static void CopyNested(VkCopyMemoryToAccelerationStructureInfoKHR& s, CommandDataWriter&) {
+        s.pNext = nullptr;
+    }
+};
+
 static VKAPI_ATTR void VKAPI_CALL CmdCopyMemoryToAccelerationStructureKHR(
     VkCommandBuffer                             commandBuffer,
     const VkCopyMemoryToAccelerationStructureInfoKHR* pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkCmdCopyMemoryToAccelerationStructureKHR>(kHookCmdCopyMemoryToAccelerationStructureKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pInfo);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdCopyMemoryToAccelerationStructureKHR, RecordArray("pInfo", pInfo, 1));
 }
 
 static VKAPI_ATTR VkDeviceAddress VKAPI_CALL GetAccelerationStructureDeviceAddressKHR(
     VkDevice                                    device,
     const VkAccelerationStructureDeviceAddressInfoKHR* pInfo)
 {
+    if (const auto hook = GetHook<PFN_vkGetAccelerationStructureDeviceAddressKHR>(kHookGetAccelerationStructureDeviceAddressKHR)) {
+        const HookScope scope;
+        return hook(device, pInfo);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5805,7 +11724,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdWriteAccelerationStructuresPropertiesKHR(
     VkQueryPool                                 queryPool,
     uint32_t                                    firstQuery)
 {
+    if (const auto hook = GetHook<PFN_vkCmdWriteAccelerationStructuresPropertiesKHR>(kHookCmdWriteAccelerationStructuresPropertiesKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, accelerationStructureCount, pAccelerationStructures, queryType, queryPool, firstQuery);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdWriteAccelerationStructuresPropertiesKHR, accelerationStructureCount, RecordArray("pAccelerationStructures", pAccelerationStructures, accelerationStructureCount), queryType, queryPool, firstQuery);
 }
 
 static VKAPI_ATTR void VKAPI_CALL GetDeviceAccelerationStructureCompatibilityKHR(
@@ -5813,6 +11737,10 @@ static VKAPI_ATTR void VKAPI_CALL GetDeviceAccelerationStructureCompatibilityKHR
     const VkAccelerationStructureVersionInfoKHR* pVersionInfo,
     VkAccelerationStructureCompatibilityKHR*    pCompatibility)
 {
+    if (const auto hook = GetHook<PFN_vkGetDeviceAccelerationStructureCompatibilityKHR>(kHookGetDeviceAccelerationStructureCompatibilityKHR)) {
+        const HookScope scope;
+        return hook(device, pVersionInfo, pCompatibility);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -5823,6 +11751,10 @@ static VKAPI_ATTR void VKAPI_CALL GetAccelerationStructureBuildSizesKHR(
     const uint32_t*                             pMaxPrimitiveCounts,
     VkAccelerationStructureBuildSizesInfoKHR*   pSizeInfo)
 {
+    if (const auto hook = GetHook<PFN_vkGetAccelerationStructureBuildSizesKHR>(kHookGetAccelerationStructureBuildSizesKHR)) {
+        const HookScope scope;
+        return hook(device, buildType, pBuildInfo, pMaxPrimitiveCounts, pSizeInfo);
+    }
 //Not a CREATE or DESTROY function
 }
 
@@ -5837,7 +11769,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdTraceRaysKHR(
     uint32_t                                    height,
     uint32_t                                    depth)
 {
+    if (const auto hook = GetHook<PFN_vkCmdTraceRaysKHR>(kHookCmdTraceRaysKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pRaygenShaderBindingTable, pMissShaderBindingTable, pHitShaderBindingTable, pCallableShaderBindingTable, width, height, depth);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdTraceRaysKHR, RecordArray("pRaygenShaderBindingTable", pRaygenShaderBindingTable, 1), RecordArray("pMissShaderBindingTable", pMissShaderBindingTable, 1), RecordArray("pHitShaderBindingTable", pHitShaderBindingTable, 1), RecordArray("pCallableShaderBindingTable", pCallableShaderBindingTable, 1), width, height, depth);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL CreateRayTracingPipelinesKHR(
@@ -5849,11 +11786,24 @@ static VKAPI_ATTR VkResult VKAPI_CALL CreateRayTracingPipelinesKHR(
     const VkAllocationCallbacks*                pAllocator,
     VkPipeline*                                 pPipelines)
 {
-    unique_lock_t lock(global_lock);
+    if (const auto hook = GetHook<PFN_vkCreateRayTracingPipelinesKHR>(kHookCreateRayTracingPipelinesKHR)) {
+        const HookScope scope;
+        return hook(device, deferredOperation, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines);
+    }
     for (uint32_t i = 0; i < createInfoCount; ++i) {
-        pPipelines[i] = (VkPipeline)global_unique_handle++;
+        pPipelines[i] = (VkPipeline)NewHandle(device, VK_OBJECT_TYPE_PIPELINE);
+        AddLiveObject("VkPipeline", (uint64_t)pPipelines[i]);
     }
-    return VK_SUCCESS;
+    TrackObjects(VK_OBJECT_TYPE_PIPELINE, createInfoCount);
+    uint32_t compile_count = 0;
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        for (uint32_t i = 0; i < createInfoCount; ++i) {
+            if (CompileShaderStages(objects.shader_code, pCreateInfos[i].stageCount, pCreateInfos[i].pStages)) ++compile_count;
+        }
+    }
+    return DeferWork(device, deferredOperation, compile_count * icd_pipeline_compile_chunks);
 }
 
 static VKAPI_ATTR VkResult VKAPI_CALL GetRayTracingCaptureReplayShaderGroupHandlesKHR(
@@ -5864,6 +11814,10 @@ static VKAPI_ATTR VkResult VKAPI_CALL GetRayTracingCaptureReplayShaderGroupHandl
     size_t                                      dataSize,
     void*                                       pData)
 {
+    if (const auto hook = GetHook<PFN_vkGetRayTracingCaptureReplayShaderGroupHandlesKHR>(kHookGetRayTracingCaptureReplayShaderGroupHandlesKHR)) {
+        const HookScope scope;
+        return hook(device, pipeline, firstGroup, groupCount, dataSize, pData);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5876,7 +11830,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdTraceRaysIndirectKHR(
     const VkStridedDeviceAddressRegionKHR*      pCallableShaderBindingTable,
     VkDeviceAddress                             indirectDeviceAddress)
 {
+    if (const auto hook = GetHook<PFN_vkCmdTraceRaysIndirectKHR>(kHookCmdTraceRaysIndirectKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pRaygenShaderBindingTable, pMissShaderBindingTable, pHitShaderBindingTable, pCallableShaderBindingTable, indirectDeviceAddress);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdTraceRaysIndirectKHR, RecordArray("pRaygenShaderBindingTable", pRaygenShaderBindingTable, 1), RecordArray("pMissShaderBindingTable", pMissShaderBindingTable, 1), RecordArray("pHitShaderBindingTable", pHitShaderBindingTable, 1), RecordArray("pCallableShaderBindingTable", pCallableShaderBindingTable, 1), indirectDeviceAddress);
 }
 
 static VKAPI_ATTR VkDeviceSize VKAPI_CALL GetRayTracingShaderGroupStackSizeKHR(
@@ -5885,6 +11844,10 @@ static VKAPI_ATTR VkDeviceSize VKAPI_CALL GetRayTracingShaderGroupStackSizeKHR(
     uint32_t                                    group,
     VkShaderGroupShaderKHR                      groupShader)
 {
+    if (const auto hook = GetHook<PFN_vkGetRayTracingShaderGroupStackSizeKHR>(kHookGetRayTracingShaderGroupStackSizeKHR)) {
+        const HookScope scope;
+        return hook(device, pipeline, group, groupShader);
+    }
 //Not a CREATE or DESTROY function
     return VK_SUCCESS;
 }
@@ -5893,7 +11856,12 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetRayTracingPipelineStackSizeKHR(
     VkCommandBuffer                             commandBuffer,
     uint32_t                                    pipelineStackSize)
 {
+    if (const auto hook = GetHook<PFN_vkCmdSetRayTracingPipelineStackSizeKHR>(kHookCmdSetRayTracingPipelineStackSizeKHR)) {
+        const HookScope scope;
+        return hook(commandBuffer, pipelineStackSize);
+    }
 //Not a CREATE or DESTROY function
+    RecordCommand(commandBuffer, kOpCmdSetRayTracingPipelineStackSizeKHR, pipelineStackSize);
 }
 
 
@@ -5941,6 +11909,39 @@ EXPORT VKAPI_ATTR VkResult VKAPI_CALL vk_icdNegotiateLoaderICDInterfaceVersion(u
     return VK_SUCCESS;
 }
 
+EXPORT VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_ResolveSparseAddress(VkDevice device, uint64_t resource, VkDeviceSize offset,
+                                                                  VkDeviceMemory* pMemory, VkDeviceSize* pMemoryOffset) {
+    return vkmock::ResolveSparseAddress(device, resource, offset, pMemory, pMemoryOffset) ? VK_TRUE : VK_FALSE;
+}
+
+EXPORT VKAPI_ATTR VkDeviceSize VKAPI_CALL vkmock_GetSparseResidentSize(VkDevice device, uint64_t resource, VkDeviceSize offset,
+                                                                       VkDeviceSize size) {
+    return vkmock::GetSparseResidentSize(device, resource, offset, size);
+}
+
+EXPORT VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_ResolveDeviceAddress(VkDevice device, VkDeviceAddress address, VkDeviceMemory* pMemory,
+                                                                  VkDeviceSize* pOffset) {
+    return vkmock::ResolveDeviceAddress(device, address, pMemory, pOffset) ? VK_TRUE : VK_FALSE;
+}
+
+EXPORT VKAPI_ATTR const VkmockStats* VKAPI_CALL vkmock_GetStats() {
+    return reinterpret_cast<const VkmockStats*>(&vkmock::icd_stats);
+}
+
+EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkmock_GetRecordedCommands(VkCommandBuffer commandBuffer, uint32_t* pCommandCount,
+                                                                 VkmockCommand* pCommands) {
+    return vkmock::GetRecordedCommands(commandBuffer, pCommandCount, pCommands);
+}
+
+EXPORT VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_GetMemoryBindingReport(VkDevice device, VkDeviceMemory memory,
+                                                                   VkmockMemoryBindingReport* pReport) {
+    return vkmock::GetMemoryBindingReport(device, memory, pReport) ? VK_TRUE : VK_FALSE;
+}
+
+EXPORT VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_SetHook(const char* pName, PFN_vkVoidFunction pfnHook) {
+    return vkmock::SetHook(pName, pfnHook) ? VK_TRUE : VK_FALSE;
+}
+
 
 EXPORT VKAPI_ATTR void VKAPI_CALL vkDestroySurfaceKHR(
     VkInstance                                  instance,
@@ -22,30 +22,141 @@
 **
 */
 
+#include <algorithm>
+#include <atomic>
+#include <new>
 #include <unordered_map>
 #include <mutex>
+#include <vector>
 #include <string>
 #include <cstring>
 #include "vulkan/vk_icd.h"
 namespace vkmock {
 
 
-using mutex_t = std::mutex;
+// std::mutex that counts the times a thread had to wait for it, for the lock contention statistic
+static void CountLockContention();
+class mutex_t {
+  public:
+    void lock() {
+        if (mutex_.try_lock()) return;
+        CountLockContention();
+        mutex_.lock();
+    }
+    bool try_lock() { return mutex_.try_lock(); }
+    void unlock() { mutex_.unlock(); }
+
+  private:
+    std::mutex mutex_;
+};
 using lock_guard_t = std::lock_guard<mutex_t>;
 using unique_lock_t = std::unique_lock<mutex_t>;
 
-static mutex_t global_lock;
-static uint64_t global_unique_handle = 1;
+static std::atomic<uint64_t> global_unique_handle{1};
 static const uint32_t SUPPORTED_LOADER_ICD_INTERFACE_VERSION = 5;
 static uint32_t loader_interface_version = 0;
 static bool negotiate_loader_icd_interface_called = false;
-static void* CreateDispObjHandle() {
-    auto handle = new VK_LOADER_DATA;
-    set_loader_magic_value(handle);
+
+// Fixed-size block pool for a device's dispatchable children (queues, command buffers) when the application
+// supplies no VkAllocationCallbacks. Freed blocks are recycled and all chunks are released with the device.
+class DeviceArena {
+  public:
+    explicit DeviceArena(size_t block_size)
+        : block_size_(((std::max)(block_size, sizeof(void*)) + sizeof(void*) - 1) & ~(sizeof(void*) - 1)) {}
+    DeviceArena(const DeviceArena&) = delete;
+    DeviceArena& operator=(const DeviceArena&) = delete;
+    ~DeviceArena() {
+        for (auto chunk : chunks_) ::operator delete(chunk);
+    }
+    void* Allocate() {
+        lock_guard_t lock(lock_);
+        if (!free_list_) {
+            char* chunk = static_cast<char*>(::operator new(block_size_ * kBlocksPerChunk, std::nothrow));
+            if (!chunk) return nullptr;
+            chunks_.push_back(chunk);
+            for (size_t i = 0; i < kBlocksPerChunk; ++i) {
+                PushFree(chunk + i * block_size_);
+            }
+        }
+        void* block = free_list_;
+        free_list_ = *static_cast<void**>(block);
+        return block;
+    }
+    void Free(void* block) {
+        lock_guard_t lock(lock_);
+        PushFree(block);
+    }
+
+  private:
+    static const size_t kBlocksPerChunk = 64;
+    void PushFree(void* block) {
+        *static_cast<void**>(block) = free_list_;
+        free_list_ = block;
+    }
+    mutex_t lock_;
+    size_t block_size_;
+    void* free_list_ = nullptr;
+    std::vector<void*> chunks_;
+};
+
+// Dispatchable handles are real host allocations since the loader writes its dispatch pointer into them. They come from
+// the application's allocator when one applies, else from the owning device's arena, else from the C++ heap. After the
+// loader's pointer, a handle holds the ICD's state for the object, so per-instance and per-device state is reached from
+// the handle rather than looked up in maps shared by every instance.
+struct DispatchableObject {
+    VK_LOADER_DATA loader_data;
+    void* state;
+};
+
+static void* CreateDispObjHandle(const VkAllocationCallbacks* pAllocator, VkSystemAllocationScope scope, DeviceArena* arena,
+                                 void* state) {
+    void* handle = nullptr;
+    if (pAllocator) {
+        handle = pAllocator->pfnAllocation(pAllocator->pUserData, sizeof(DispatchableObject), alignof(DispatchableObject), scope);
+    } else if (arena) {
+        handle = arena->Allocate();
+    } else {
+        handle = ::operator new(sizeof(DispatchableObject), std::nothrow);
+    }
+    if (handle) {
+        set_loader_magic_value(handle);
+        static_cast<DispatchableObject*>(handle)->state = state;
+    }
     return handle;
 }
-static void DestroyDispObjHandle(void* handle) {
-    delete reinterpret_cast<VK_LOADER_DATA*>(handle);
+
+template <typename State>
+static State* GetDispObjState(const void* handle) {
+    return handle ? static_cast<State*>(static_cast<const DispatchableObject*>(handle)->state) : nullptr;
+}
+static void DestroyDispObjHandle(void* handle, const VkAllocationCallbacks* pAllocator, DeviceArena* arena) {
+    if (!handle) return;
+    if (pAllocator) {
+        pAllocator->pfnFree(pAllocator->pUserData, handle);
+    } else if (arena) {
+        arena->Free(handle);
+    } else {
+        ::operator delete(handle);
+    }
+}
+
+// The ICD's state for an object comes from the same allocator as the object's handle, with the same scope. Without an
+// allocator it comes from the C++ heap rather than the device's arena, whose blocks only fit a handle.
+template <typename State>
+static State* NewObjectState(const VkAllocationCallbacks* pAllocator, VkSystemAllocationScope scope) {
+    void* memory = pAllocator ? pAllocator->pfnAllocation(pAllocator->pUserData, sizeof(State), alignof(State), scope)
+                              : ::operator new(sizeof(State), std::nothrow);
+    return memory ? new (memory) State() : nullptr;
+}
+template <typename State>
+static void DeleteObjectState(State* state, const VkAllocationCallbacks* pAllocator) {
+    if (!state) return;
+    state->~State();
+    if (pAllocator) {
+        pAllocator->pfnFree(pAllocator->pUserData, state);
+    } else {
+        ::operator delete(state);
+    }
 }
 
 // Map of instance extension name to version
@@ -3646,6 +3757,1681 @@ static VKAPI_ATTR void VKAPI_CALL CmdSetRayTracingPipelineStackSizeKHR(
     uint32_t                                    pipelineStackSize);
 
 
+enum CommandOpcode : uint32_t {
+    kOpCmdBindPipeline,
+    kOpCmdSetViewport,
+    kOpCmdSetScissor,
+    kOpCmdSetLineWidth,
+    kOpCmdSetDepthBias,
+    kOpCmdSetBlendConstants,
+    kOpCmdSetDepthBounds,
+    kOpCmdSetStencilCompareMask,
+    kOpCmdSetStencilWriteMask,
+    kOpCmdSetStencilReference,
+    kOpCmdBindDescriptorSets,
+    kOpCmdBindIndexBuffer,
+    kOpCmdBindVertexBuffers,
+    kOpCmdDraw,
+    kOpCmdDrawIndexed,
+    kOpCmdDrawIndirect,
+    kOpCmdDrawIndexedIndirect,
+    kOpCmdDispatch,
+    kOpCmdDispatchIndirect,
+    kOpCmdCopyBuffer,
+    kOpCmdCopyImage,
+    kOpCmdBlitImage,
+    kOpCmdCopyBufferToImage,
+    kOpCmdCopyImageToBuffer,
+    kOpCmdUpdateBuffer,
+    kOpCmdFillBuffer,
+    kOpCmdClearColorImage,
+    kOpCmdClearDepthStencilImage,
+    kOpCmdClearAttachments,
+    kOpCmdResolveImage,
+    kOpCmdSetEvent,
+    kOpCmdResetEvent,
+    kOpCmdWaitEvents,
+    kOpCmdPipelineBarrier,
+    kOpCmdBeginQuery,
+    kOpCmdEndQuery,
+    kOpCmdResetQueryPool,
+    kOpCmdWriteTimestamp,
+    kOpCmdCopyQueryPoolResults,
+    kOpCmdPushConstants,
+    kOpCmdBeginRenderPass,
+    kOpCmdNextSubpass,
+    kOpCmdEndRenderPass,
+    kOpCmdExecuteCommands,
+    kOpCmdSetDeviceMask,
+    kOpCmdDispatchBase,
+    kOpCmdDrawIndirectCount,
+    kOpCmdDrawIndexedIndirectCount,
+    kOpCmdBeginRenderPass2,
+    kOpCmdNextSubpass2,
+    kOpCmdEndRenderPass2,
+    kOpCmdSetEvent2,
+    kOpCmdResetEvent2,
+    kOpCmdWaitEvents2,
+    kOpCmdPipelineBarrier2,
+    kOpCmdWriteTimestamp2,
+    kOpCmdCopyBuffer2,
+    kOpCmdCopyImage2,
+    kOpCmdCopyBufferToImage2,
+    kOpCmdCopyImageToBuffer2,
+    kOpCmdBlitImage2,
+    kOpCmdResolveImage2,
+    kOpCmdBeginRendering,
+    kOpCmdEndRendering,
+    kOpCmdSetCullMode,
+    kOpCmdSetFrontFace,
+    kOpCmdSetPrimitiveTopology,
+    kOpCmdSetViewportWithCount,
+    kOpCmdSetScissorWithCount,
+    kOpCmdBindVertexBuffers2,
+    kOpCmdSetDepthTestEnable,
+    kOpCmdSetDepthWriteEnable,
+    kOpCmdSetDepthCompareOp,
+    kOpCmdSetDepthBoundsTestEnable,
+    kOpCmdSetStencilTestEnable,
+    kOpCmdSetStencilOp,
+    kOpCmdSetRasterizerDiscardEnable,
+    kOpCmdSetDepthBiasEnable,
+    kOpCmdSetPrimitiveRestartEnable,
+    kOpCmdBeginVideoCodingKHR,
+    kOpCmdEndVideoCodingKHR,
+    kOpCmdControlVideoCodingKHR,
+    kOpCmdDecodeVideoKHR,
+    kOpCmdBeginRenderingKHR,
+    kOpCmdEndRenderingKHR,
+    kOpCmdSetDeviceMaskKHR,
+    kOpCmdDispatchBaseKHR,
+    kOpCmdPushDescriptorSetKHR,
+    kOpCmdPushDescriptorSetWithTemplateKHR,
+    kOpCmdBeginRenderPass2KHR,
+    kOpCmdNextSubpass2KHR,
+    kOpCmdEndRenderPass2KHR,
+    kOpCmdDrawIndirectCountKHR,
+    kOpCmdDrawIndexedIndirectCountKHR,
+    kOpCmdSetFragmentShadingRateKHR,
+    kOpCmdEncodeVideoKHR,
+    kOpCmdSetEvent2KHR,
+    kOpCmdResetEvent2KHR,
+    kOpCmdWaitEvents2KHR,
+    kOpCmdPipelineBarrier2KHR,
+    kOpCmdWriteTimestamp2KHR,
+    kOpCmdWriteBufferMarker2AMD,
+    kOpCmdCopyBuffer2KHR,
+    kOpCmdCopyImage2KHR,
+    kOpCmdCopyBufferToImage2KHR,
+    kOpCmdCopyImageToBuffer2KHR,
+    kOpCmdBlitImage2KHR,
+    kOpCmdResolveImage2KHR,
+    kOpCmdDebugMarkerBeginEXT,
+    kOpCmdDebugMarkerEndEXT,
+    kOpCmdDebugMarkerInsertEXT,
+    kOpCmdBindTransformFeedbackBuffersEXT,
+    kOpCmdBeginTransformFeedbackEXT,
+    kOpCmdEndTransformFeedbackEXT,
+    kOpCmdBeginQueryIndexedEXT,
+    kOpCmdEndQueryIndexedEXT,
+    kOpCmdDrawIndirectByteCountEXT,
+    kOpCmdCuLaunchKernelNVX,
+    kOpCmdDrawIndirectCountAMD,
+    kOpCmdDrawIndexedIndirectCountAMD,
+    kOpCmdBeginConditionalRenderingEXT,
+    kOpCmdEndConditionalRenderingEXT,
+    kOpCmdSetViewportWScalingNV,
+    kOpCmdSetDiscardRectangleEXT,
+    kOpCmdBeginDebugUtilsLabelEXT,
+    kOpCmdEndDebugUtilsLabelEXT,
+    kOpCmdInsertDebugUtilsLabelEXT,
+    kOpCmdSetSampleLocationsEXT,
+    kOpCmdBindShadingRateImageNV,
+    kOpCmdSetViewportShadingRatePaletteNV,
+    kOpCmdSetCoarseSampleOrderNV,
+    kOpCmdBuildAccelerationStructureNV,
+    kOpCmdCopyAccelerationStructureNV,
+    kOpCmdTraceRaysNV,
+    kOpCmdWriteAccelerationStructuresPropertiesNV,
+    kOpCmdWriteBufferMarkerAMD,
+    kOpCmdDrawMeshTasksNV,
+    kOpCmdDrawMeshTasksIndirectNV,
+    kOpCmdDrawMeshTasksIndirectCountNV,
+    kOpCmdSetExclusiveScissorNV,
+    kOpCmdSetCheckpointNV,
+    kOpCmdSetPerformanceMarkerINTEL,
+    kOpCmdSetPerformanceStreamMarkerINTEL,
+    kOpCmdSetPerformanceOverrideINTEL,
+    kOpCmdSetLineStippleEXT,
+    kOpCmdSetCullModeEXT,
+    kOpCmdSetFrontFaceEXT,
+    kOpCmdSetPrimitiveTopologyEXT,
+    kOpCmdSetViewportWithCountEXT,
+    kOpCmdSetScissorWithCountEXT,
+    kOpCmdBindVertexBuffers2EXT,
+    kOpCmdSetDepthTestEnableEXT,
+    kOpCmdSetDepthWriteEnableEXT,
+    kOpCmdSetDepthCompareOpEXT,
+    kOpCmdSetDepthBoundsTestEnableEXT,
+    kOpCmdSetStencilTestEnableEXT,
+    kOpCmdSetStencilOpEXT,
+    kOpCmdPreprocessGeneratedCommandsNV,
+    kOpCmdExecuteGeneratedCommandsNV,
+    kOpCmdBindPipelineShaderGroupNV,
+    kOpCmdSetFragmentShadingRateEnumNV,
+    kOpCmdSetVertexInputEXT,
+    kOpCmdSubpassShadingHUAWEI,
+    kOpCmdBindInvocationMaskHUAWEI,
+    kOpCmdSetPatchControlPointsEXT,
+    kOpCmdSetRasterizerDiscardEnableEXT,
+    kOpCmdSetDepthBiasEnableEXT,
+    kOpCmdSetLogicOpEXT,
+    kOpCmdSetPrimitiveRestartEnableEXT,
+    kOpCmdSetColorWriteEnableEXT,
+    kOpCmdDrawMultiEXT,
+    kOpCmdDrawMultiIndexedEXT,
+    kOpCmdBuildAccelerationStructuresKHR,
+    kOpCmdBuildAccelerationStructuresIndirectKHR,
+    kOpCmdCopyAccelerationStructureKHR,
+    kOpCmdCopyAccelerationStructureToMemoryKHR,
+    kOpCmdCopyMemoryToAccelerationStructureKHR,
+    kOpCmdWriteAccelerationStructuresPropertiesKHR,
+    kOpCmdTraceRaysKHR,
+    kOpCmdTraceRaysIndirectKHR,
+    kOpCmdSetRayTracingPipelineStackSizeKHR,
+};
+
+static const char* const command_opcode_names[] = {
+    "vkCmdBindPipeline",
+    "vkCmdSetViewport",
+    "vkCmdSetScissor",
+    "vkCmdSetLineWidth",
+    "vkCmdSetDepthBias",
+    "vkCmdSetBlendConstants",
+    "vkCmdSetDepthBounds",
+    "vkCmdSetStencilCompareMask",
+    "vkCmdSetStencilWriteMask",
+    "vkCmdSetStencilReference",
+    "vkCmdBindDescriptorSets",
+    "vkCmdBindIndexBuffer",
+    "vkCmdBindVertexBuffers",
+    "vkCmdDraw",
+    "vkCmdDrawIndexed",
+    "vkCmdDrawIndirect",
+    "vkCmdDrawIndexedIndirect",
+    "vkCmdDispatch",
+    "vkCmdDispatchIndirect",
+    "vkCmdCopyBuffer",
+    "vkCmdCopyImage",
+    "vkCmdBlitImage",
+    "vkCmdCopyBufferToImage",
+    "vkCmdCopyImageToBuffer",
+    "vkCmdUpdateBuffer",
+    "vkCmdFillBuffer",
+    "vkCmdClearColorImage",
+    "vkCmdClearDepthStencilImage",
+    "vkCmdClearAttachments",
+    "vkCmdResolveImage",
+    "vkCmdSetEvent",
+    "vkCmdResetEvent",
+    "vkCmdWaitEvents",
+    "vkCmdPipelineBarrier",
+    "vkCmdBeginQuery",
+    "vkCmdEndQuery",
+    "vkCmdResetQueryPool",
+    "vkCmdWriteTimestamp",
+    "vkCmdCopyQueryPoolResults",
+    "vkCmdPushConstants",
+    "vkCmdBeginRenderPass",
+    "vkCmdNextSubpass",
+    "vkCmdEndRenderPass",
+    "vkCmdExecuteCommands",
+    "vkCmdSetDeviceMask",
+    "vkCmdDispatchBase",
+    "vkCmdDrawIndirectCount",
+    "vkCmdDrawIndexedIndirectCount",
+    "vkCmdBeginRenderPass2",
+    "vkCmdNextSubpass2",
+    "vkCmdEndRenderPass2",
+    "vkCmdSetEvent2",
+    "vkCmdResetEvent2",
+    "vkCmdWaitEvents2",
+    "vkCmdPipelineBarrier2",
+    "vkCmdWriteTimestamp2",
+    "vkCmdCopyBuffer2",
+    "vkCmdCopyImage2",
+    "vkCmdCopyBufferToImage2",
+    "vkCmdCopyImageToBuffer2",
+    "vkCmdBlitImage2",
+    "vkCmdResolveImage2",
+    "vkCmdBeginRendering",
+    "vkCmdEndRendering",
+    "vkCmdSetCullMode",
+    "vkCmdSetFrontFace",
+    "vkCmdSetPrimitiveTopology",
+    "vkCmdSetViewportWithCount",
+    "vkCmdSetScissorWithCount",
+    "vkCmdBindVertexBuffers2",
+    "vkCmdSetDepthTestEnable",
+    "vkCmdSetDepthWriteEnable",
+    "vkCmdSetDepthCompareOp",
+    "vkCmdSetDepthBoundsTestEnable",
+    "vkCmdSetStencilTestEnable",
+    "vkCmdSetStencilOp",
+    "vkCmdSetRasterizerDiscardEnable",
+    "vkCmdSetDepthBiasEnable",
+    "vkCmdSetPrimitiveRestartEnable",
+    "vkCmdBeginVideoCodingKHR",
+    "vkCmdEndVideoCodingKHR",
+    "vkCmdControlVideoCodingKHR",
+    "vkCmdDecodeVideoKHR",
+    "vkCmdBeginRenderingKHR",
+    "vkCmdEndRenderingKHR",
+    "vkCmdSetDeviceMaskKHR",
+    "vkCmdDispatchBaseKHR",
+    "vkCmdPushDescriptorSetKHR",
+    "vkCmdPushDescriptorSetWithTemplateKHR",
+    "vkCmdBeginRenderPass2KHR",
+    "vkCmdNextSubpass2KHR",
+    "vkCmdEndRenderPass2KHR",
+    "vkCmdDrawIndirectCountKHR",
+    "vkCmdDrawIndexedIndirectCountKHR",
+    "vkCmdSetFragmentShadingRateKHR",
+    "vkCmdEncodeVideoKHR",
+    "vkCmdSetEvent2KHR",
+    "vkCmdResetEvent2KHR",
+    "vkCmdWaitEvents2KHR",
+    "vkCmdPipelineBarrier2KHR",
+    "vkCmdWriteTimestamp2KHR",
+    "vkCmdWriteBufferMarker2AMD",
+    "vkCmdCopyBuffer2KHR",
+    "vkCmdCopyImage2KHR",
+    "vkCmdCopyBufferToImage2KHR",
+    "vkCmdCopyImageToBuffer2KHR",
+    "vkCmdBlitImage2KHR",
+    "vkCmdResolveImage2KHR",
+    "vkCmdDebugMarkerBeginEXT",
+    "vkCmdDebugMarkerEndEXT",
+    "vkCmdDebugMarkerInsertEXT",
+    "vkCmdBindTransformFeedbackBuffersEXT",
+    "vkCmdBeginTransformFeedbackEXT",
+    "vkCmdEndTransformFeedbackEXT",
+    "vkCmdBeginQueryIndexedEXT",
+    "vkCmdEndQueryIndexedEXT",
+    "vkCmdDrawIndirectByteCountEXT",
+    "vkCmdCuLaunchKernelNVX",
+    "vkCmdDrawIndirectCountAMD",
+    "vkCmdDrawIndexedIndirectCountAMD",
+    "vkCmdBeginConditionalRenderingEXT",
+    "vkCmdEndConditionalRenderingEXT",
+    "vkCmdSetViewportWScalingNV",
+    "vkCmdSetDiscardRectangleEXT",
+    "vkCmdBeginDebugUtilsLabelEXT",
+    "vkCmdEndDebugUtilsLabelEXT",
+    "vkCmdInsertDebugUtilsLabelEXT",
+    "vkCmdSetSampleLocationsEXT",
+    "vkCmdBindShadingRateImageNV",
+    "vkCmdSetViewportShadingRatePaletteNV",
+    "vkCmdSetCoarseSampleOrderNV",
+    "vkCmdBuildAccelerationStructureNV",
+    "vkCmdCopyAccelerationStructureNV",
+    "vkCmdTraceRaysNV",
+    "vkCmdWriteAccelerationStructuresPropertiesNV",
+    "vkCmdWriteBufferMarkerAMD",
+    "vkCmdDrawMeshTasksNV",
+    "vkCmdDrawMeshTasksIndirectNV",
+    "vkCmdDrawMeshTasksIndirectCountNV",
+    "vkCmdSetExclusiveScissorNV",
+    "vkCmdSetCheckpointNV",
+    "vkCmdSetPerformanceMarkerINTEL",
+    "vkCmdSetPerformanceStreamMarkerINTEL",
+    "vkCmdSetPerformanceOverrideINTEL",
+    "vkCmdSetLineStippleEXT",
+    "vkCmdSetCullModeEXT",
+    "vkCmdSetFrontFaceEXT",
+    "vkCmdSetPrimitiveTopologyEXT",
+    "vkCmdSetViewportWithCountEXT",
+    "vkCmdSetScissorWithCountEXT",
+    "vkCmdBindVertexBuffers2EXT",
+    "vkCmdSetDepthTestEnableEXT",
+    "vkCmdSetDepthWriteEnableEXT",
+    "vkCmdSetDepthCompareOpEXT",
+    "vkCmdSetDepthBoundsTestEnableEXT",
+    "vkCmdSetStencilTestEnableEXT",
+    "vkCmdSetStencilOpEXT",
+    "vkCmdPreprocessGeneratedCommandsNV",
+    "vkCmdExecuteGeneratedCommandsNV",
+    "vkCmdBindPipelineShaderGroupNV",
+    "vkCmdSetFragmentShadingRateEnumNV",
+    "vkCmdSetVertexInputEXT",
+    "vkCmdSubpassShadingHUAWEI",
+    "vkCmdBindInvocationMaskHUAWEI",
+    "vkCmdSetPatchControlPointsEXT",
+    "vkCmdSetRasterizerDiscardEnableEXT",
+    "vkCmdSetDepthBiasEnableEXT",
+    "vkCmdSetLogicOpEXT",
+    "vkCmdSetPrimitiveRestartEnableEXT",
+    "vkCmdSetColorWriteEnableEXT",
+    "vkCmdDrawMultiEXT",
+    "vkCmdDrawMultiIndexedEXT",
+    "vkCmdBuildAccelerationStructuresKHR",
+    "vkCmdBuildAccelerationStructuresIndirectKHR",
+    "vkCmdCopyAccelerationStructureKHR",
+    "vkCmdCopyAccelerationStructureToMemoryKHR",
+    "vkCmdCopyMemoryToAccelerationStructureKHR",
+    "vkCmdWriteAccelerationStructuresPropertiesKHR",
+    "vkCmdTraceRaysKHR",
+    "vkCmdTraceRaysIndirectKHR",
+    "vkCmdSetRayTracingPipelineStackSizeKHR",
+};
+
+enum HookSlot : uint32_t {
+    kHookEnumeratePhysicalDevices,
+    kHookGetPhysicalDeviceFeatures,
+    kHookGetPhysicalDeviceFormatProperties,
+    kHookGetPhysicalDeviceImageFormatProperties,
+    kHookGetPhysicalDeviceProperties,
+    kHookGetPhysicalDeviceQueueFamilyProperties,
+    kHookGetPhysicalDeviceMemoryProperties,
+    kHookGetDeviceQueue,
+    kHookQueueSubmit,
+    kHookQueueWaitIdle,
+    kHookDeviceWaitIdle,
+    kHookAllocateMemory,
+    kHookFreeMemory,
+    kHookMapMemory,
+    kHookUnmapMemory,
+    kHookFlushMappedMemoryRanges,
+    kHookInvalidateMappedMemoryRanges,
+    kHookGetDeviceMemoryCommitment,
+    kHookBindBufferMemory,
+    kHookBindImageMemory,
+    kHookGetBufferMemoryRequirements,
+    kHookGetImageMemoryRequirements,
+    kHookGetImageSparseMemoryRequirements,
+    kHookGetPhysicalDeviceSparseImageFormatProperties,
+    kHookQueueBindSparse,
+    kHookCreateFence,
+    kHookDestroyFence,
+    kHookResetFences,
+    kHookGetFenceStatus,
+    kHookWaitForFences,
+    kHookCreateSemaphore,
+    kHookDestroySemaphore,
+    kHookCreateEvent,
+    kHookDestroyEvent,
+    kHookGetEventStatus,
+    kHookSetEvent,
+    kHookResetEvent,
+    kHookCreateQueryPool,
+    kHookDestroyQueryPool,
+    kHookGetQueryPoolResults,
+    kHookCreateBuffer,
+    kHookDestroyBuffer,
+    kHookCreateBufferView,
+    kHookDestroyBufferView,
+    kHookCreateImage,
+    kHookDestroyImage,
+    kHookGetImageSubresourceLayout,
+    kHookCreateImageView,
+    kHookDestroyImageView,
+    kHookCreateShaderModule,
+    kHookDestroyShaderModule,
+    kHookCreatePipelineCache,
+    kHookDestroyPipelineCache,
+    kHookGetPipelineCacheData,
+    kHookMergePipelineCaches,
+    kHookCreateGraphicsPipelines,
+    kHookCreateComputePipelines,
+    kHookDestroyPipeline,
+    kHookCreatePipelineLayout,
+    kHookDestroyPipelineLayout,
+    kHookCreateSampler,
+    kHookDestroySampler,
+    kHookCreateDescriptorSetLayout,
+    kHookDestroyDescriptorSetLayout,
+    kHookCreateDescriptorPool,
+    kHookDestroyDescriptorPool,
+    kHookResetDescriptorPool,
+    kHookAllocateDescriptorSets,
+    kHookFreeDescriptorSets,
+    kHookUpdateDescriptorSets,
+    kHookCreateFramebuffer,
+    kHookDestroyFramebuffer,
+    kHookCreateRenderPass,
+    kHookDestroyRenderPass,
+    kHookGetRenderAreaGranularity,
+    kHookCreateCommandPool,
+    kHookDestroyCommandPool,
+    kHookResetCommandPool,
+    kHookAllocateCommandBuffers,
+    kHookFreeCommandBuffers,
+    kHookBeginCommandBuffer,
+    kHookEndCommandBuffer,
+    kHookResetCommandBuffer,
+    kHookCmdBindPipeline,
+    kHookCmdSetViewport,
+    kHookCmdSetScissor,
+    kHookCmdSetLineWidth,
+    kHookCmdSetDepthBias,
+    kHookCmdSetBlendConstants,
+    kHookCmdSetDepthBounds,
+    kHookCmdSetStencilCompareMask,
+    kHookCmdSetStencilWriteMask,
+    kHookCmdSetStencilReference,
+    kHookCmdBindDescriptorSets,
+    kHookCmdBindIndexBuffer,
+    kHookCmdBindVertexBuffers,
+    kHookCmdDraw,
+    kHookCmdDrawIndexed,
+    kHookCmdDrawIndirect,
+    kHookCmdDrawIndexedIndirect,
+    kHookCmdDispatch,
+    kHookCmdDispatchIndirect,
+    kHookCmdCopyBuffer,
+    kHookCmdCopyImage,
+    kHookCmdBlitImage,
+    kHookCmdCopyBufferToImage,
+    kHookCmdCopyImageToBuffer,
+    kHookCmdUpdateBuffer,
+    kHookCmdFillBuffer,
+    kHookCmdClearColorImage,
+    kHookCmdClearDepthStencilImage,
+    kHookCmdClearAttachments,
+    kHookCmdResolveImage,
+    kHookCmdSetEvent,
+    kHookCmdResetEvent,
+    kHookCmdWaitEvents,
+    kHookCmdPipelineBarrier,
+    kHookCmdBeginQuery,
+    kHookCmdEndQuery,
+    kHookCmdResetQueryPool,
+    kHookCmdWriteTimestamp,
+    kHookCmdCopyQueryPoolResults,
+    kHookCmdPushConstants,
+    kHookCmdBeginRenderPass,
+    kHookCmdNextSubpass,
+    kHookCmdEndRenderPass,
+    kHookCmdExecuteCommands,
+    kHookBindBufferMemory2,
+    kHookBindImageMemory2,
+    kHookGetDeviceGroupPeerMemoryFeatures,
+    kHookCmdSetDeviceMask,
+    kHookCmdDispatchBase,
+    kHookEnumeratePhysicalDeviceGroups,
+    kHookGetImageMemoryRequirements2,
+    kHookGetBufferMemoryRequirements2,
+    kHookGetImageSparseMemoryRequirements2,
+    kHookGetPhysicalDeviceFeatures2,
+    kHookGetPhysicalDeviceProperties2,
+    kHookGetPhysicalDeviceFormatProperties2,
+    kHookGetPhysicalDeviceImageFormatProperties2,
+    kHookGetPhysicalDeviceQueueFamilyProperties2,
+    kHookGetPhysicalDeviceMemoryProperties2,
+    kHookGetPhysicalDeviceSparseImageFormatProperties2,
+    kHookTrimCommandPool,
+    kHookGetDeviceQueue2,
+    kHookCreateSamplerYcbcrConversion,
+    kHookDestroySamplerYcbcrConversion,
+    kHookCreateDescriptorUpdateTemplate,
+    kHookDestroyDescriptorUpdateTemplate,
+    kHookUpdateDescriptorSetWithTemplate,
+    kHookGetPhysicalDeviceExternalBufferProperties,
+    kHookGetPhysicalDeviceExternalFenceProperties,
+    kHookGetPhysicalDeviceExternalSemaphoreProperties,
+    kHookGetDescriptorSetLayoutSupport,
+    kHookCmdDrawIndirectCount,
+    kHookCmdDrawIndexedIndirectCount,
+    kHookCreateRenderPass2,
+    kHookCmdBeginRenderPass2,
+    kHookCmdNextSubpass2,
+    kHookCmdEndRenderPass2,
+    kHookResetQueryPool,
+    kHookGetSemaphoreCounterValue,
+    kHookWaitSemaphores,
+    kHookSignalSemaphore,
+    kHookGetBufferDeviceAddress,
+    kHookGetBufferOpaqueCaptureAddress,
+    kHookGetDeviceMemoryOpaqueCaptureAddress,
+    kHookGetPhysicalDeviceToolProperties,
+    kHookCreatePrivateDataSlot,
+    kHookDestroyPrivateDataSlot,
+    kHookSetPrivateData,
+    kHookGetPrivateData,
+    kHookCmdSetEvent2,
+    kHookCmdResetEvent2,
+    kHookCmdWaitEvents2,
+    kHookCmdPipelineBarrier2,
+    kHookCmdWriteTimestamp2,
+    kHookQueueSubmit2,
+    kHookCmdCopyBuffer2,
+    kHookCmdCopyImage2,
+    kHookCmdCopyBufferToImage2,
+    kHookCmdCopyImageToBuffer2,
+    kHookCmdBlitImage2,
+    kHookCmdResolveImage2,
+    kHookCmdBeginRendering,
+    kHookCmdEndRendering,
+    kHookCmdSetCullMode,
+    kHookCmdSetFrontFace,
+    kHookCmdSetPrimitiveTopology,
+    kHookCmdSetViewportWithCount,
+    kHookCmdSetScissorWithCount,
+    kHookCmdBindVertexBuffers2,
+    kHookCmdSetDepthTestEnable,
+    kHookCmdSetDepthWriteEnable,
+    kHookCmdSetDepthCompareOp,
+    kHookCmdSetDepthBoundsTestEnable,
+    kHookCmdSetStencilTestEnable,
+    kHookCmdSetStencilOp,
+    kHookCmdSetRasterizerDiscardEnable,
+    kHookCmdSetDepthBiasEnable,
+    kHookCmdSetPrimitiveRestartEnable,
+    kHookGetDeviceBufferMemoryRequirements,
+    kHookGetDeviceImageMemoryRequirements,
+    kHookGetDeviceImageSparseMemoryRequirements,
+    kHookDestroySurfaceKHR,
+    kHookGetPhysicalDeviceSurfaceSupportKHR,
+    kHookGetPhysicalDeviceSurfaceCapabilitiesKHR,
+    kHookGetPhysicalDeviceSurfaceFormatsKHR,
+    kHookGetPhysicalDeviceSurfacePresentModesKHR,
+    kHookCreateSwapchainKHR,
+    kHookDestroySwapchainKHR,
+    kHookGetSwapchainImagesKHR,
+    kHookAcquireNextImageKHR,
+    kHookQueuePresentKHR,
+    kHookGetDeviceGroupPresentCapabilitiesKHR,
+    kHookGetDeviceGroupSurfacePresentModesKHR,
+    kHookGetPhysicalDevicePresentRectanglesKHR,
+    kHookAcquireNextImage2KHR,
+    kHookGetPhysicalDeviceDisplayPropertiesKHR,
+    kHookGetPhysicalDeviceDisplayPlanePropertiesKHR,
+    kHookGetDisplayPlaneSupportedDisplaysKHR,
+    kHookGetDisplayModePropertiesKHR,
+    kHookCreateDisplayModeKHR,
+    kHookGetDisplayPlaneCapabilitiesKHR,
+    kHookCreateDisplayPlaneSurfaceKHR,
+    kHookCreateSharedSwapchainsKHR,
+#ifdef VK_USE_PLATFORM_XLIB_KHR
+    kHookCreateXlibSurfaceKHR,
+#endif
+#ifdef VK_USE_PLATFORM_XLIB_KHR
+    kHookGetPhysicalDeviceXlibPresentationSupportKHR,
+#endif
+#ifdef VK_USE_PLATFORM_XCB_KHR
+    kHookCreateXcbSurfaceKHR,
+#endif
+#ifdef VK_USE_PLATFORM_XCB_KHR
+    kHookGetPhysicalDeviceXcbPresentationSupportKHR,
+#endif
+#ifdef VK_USE_PLATFORM_WAYLAND_KHR
+    kHookCreateWaylandSurfaceKHR,
+#endif
+#ifdef VK_USE_PLATFORM_WAYLAND_KHR
+    kHookGetPhysicalDeviceWaylandPresentationSupportKHR,
+#endif
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    kHookCreateAndroidSurfaceKHR,
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookCreateWin32SurfaceKHR,
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookGetPhysicalDeviceWin32PresentationSupportKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookGetPhysicalDeviceVideoCapabilitiesKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookGetPhysicalDeviceVideoFormatPropertiesKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookCreateVideoSessionKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookDestroyVideoSessionKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookGetVideoSessionMemoryRequirementsKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookBindVideoSessionMemoryKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookCreateVideoSessionParametersKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookUpdateVideoSessionParametersKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookDestroyVideoSessionParametersKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookCmdBeginVideoCodingKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookCmdEndVideoCodingKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookCmdControlVideoCodingKHR,
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookCmdDecodeVideoKHR,
+#endif
+    kHookCmdBeginRenderingKHR,
+    kHookCmdEndRenderingKHR,
+    kHookGetPhysicalDeviceFeatures2KHR,
+    kHookGetPhysicalDeviceProperties2KHR,
+    kHookGetPhysicalDeviceFormatProperties2KHR,
+    kHookGetPhysicalDeviceImageFormatProperties2KHR,
+    kHookGetPhysicalDeviceQueueFamilyProperties2KHR,
+    kHookGetPhysicalDeviceMemoryProperties2KHR,
+    kHookGetPhysicalDeviceSparseImageFormatProperties2KHR,
+    kHookGetDeviceGroupPeerMemoryFeaturesKHR,
+    kHookCmdSetDeviceMaskKHR,
+    kHookCmdDispatchBaseKHR,
+    kHookTrimCommandPoolKHR,
+    kHookEnumeratePhysicalDeviceGroupsKHR,
+    kHookGetPhysicalDeviceExternalBufferPropertiesKHR,
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookGetMemoryWin32HandleKHR,
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookGetMemoryWin32HandlePropertiesKHR,
+#endif
+    kHookGetMemoryFdKHR,
+    kHookGetMemoryFdPropertiesKHR,
+    kHookGetPhysicalDeviceExternalSemaphorePropertiesKHR,
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookImportSemaphoreWin32HandleKHR,
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookGetSemaphoreWin32HandleKHR,
+#endif
+    kHookImportSemaphoreFdKHR,
+    kHookGetSemaphoreFdKHR,
+    kHookCmdPushDescriptorSetKHR,
+    kHookCmdPushDescriptorSetWithTemplateKHR,
+    kHookCreateDescriptorUpdateTemplateKHR,
+    kHookDestroyDescriptorUpdateTemplateKHR,
+    kHookUpdateDescriptorSetWithTemplateKHR,
+    kHookCreateRenderPass2KHR,
+    kHookCmdBeginRenderPass2KHR,
+    kHookCmdNextSubpass2KHR,
+    kHookCmdEndRenderPass2KHR,
+    kHookGetSwapchainStatusKHR,
+    kHookGetPhysicalDeviceExternalFencePropertiesKHR,
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookImportFenceWin32HandleKHR,
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookGetFenceWin32HandleKHR,
+#endif
+    kHookImportFenceFdKHR,
+    kHookGetFenceFdKHR,
+    kHookEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR,
+    kHookGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR,
+    kHookAcquireProfilingLockKHR,
+    kHookReleaseProfilingLockKHR,
+    kHookGetPhysicalDeviceSurfaceCapabilities2KHR,
+    kHookGetPhysicalDeviceSurfaceFormats2KHR,
+    kHookGetPhysicalDeviceDisplayProperties2KHR,
+    kHookGetPhysicalDeviceDisplayPlaneProperties2KHR,
+    kHookGetDisplayModeProperties2KHR,
+    kHookGetDisplayPlaneCapabilities2KHR,
+    kHookGetImageMemoryRequirements2KHR,
+    kHookGetBufferMemoryRequirements2KHR,
+    kHookGetImageSparseMemoryRequirements2KHR,
+    kHookCreateSamplerYcbcrConversionKHR,
+    kHookDestroySamplerYcbcrConversionKHR,
+    kHookBindBufferMemory2KHR,
+    kHookBindImageMemory2KHR,
+    kHookGetDescriptorSetLayoutSupportKHR,
+    kHookCmdDrawIndirectCountKHR,
+    kHookCmdDrawIndexedIndirectCountKHR,
+    kHookGetSemaphoreCounterValueKHR,
+    kHookWaitSemaphoresKHR,
+    kHookSignalSemaphoreKHR,
+    kHookGetPhysicalDeviceFragmentShadingRatesKHR,
+    kHookCmdSetFragmentShadingRateKHR,
+    kHookWaitForPresentKHR,
+    kHookGetBufferDeviceAddressKHR,
+    kHookGetBufferOpaqueCaptureAddressKHR,
+    kHookGetDeviceMemoryOpaqueCaptureAddressKHR,
+    kHookCreateDeferredOperationKHR,
+    kHookDestroyDeferredOperationKHR,
+    kHookGetDeferredOperationMaxConcurrencyKHR,
+    kHookGetDeferredOperationResultKHR,
+    kHookDeferredOperationJoinKHR,
+    kHookGetPipelineExecutablePropertiesKHR,
+    kHookGetPipelineExecutableStatisticsKHR,
+    kHookGetPipelineExecutableInternalRepresentationsKHR,
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    kHookCmdEncodeVideoKHR,
+#endif
+    kHookCmdSetEvent2KHR,
+    kHookCmdResetEvent2KHR,
+    kHookCmdWaitEvents2KHR,
+    kHookCmdPipelineBarrier2KHR,
+    kHookCmdWriteTimestamp2KHR,
+    kHookQueueSubmit2KHR,
+    kHookCmdWriteBufferMarker2AMD,
+    kHookGetQueueCheckpointData2NV,
+    kHookCmdCopyBuffer2KHR,
+    kHookCmdCopyImage2KHR,
+    kHookCmdCopyBufferToImage2KHR,
+    kHookCmdCopyImageToBuffer2KHR,
+    kHookCmdBlitImage2KHR,
+    kHookCmdResolveImage2KHR,
+    kHookGetDeviceBufferMemoryRequirementsKHR,
+    kHookGetDeviceImageMemoryRequirementsKHR,
+    kHookGetDeviceImageSparseMemoryRequirementsKHR,
+    kHookCreateDebugReportCallbackEXT,
+    kHookDestroyDebugReportCallbackEXT,
+    kHookDebugReportMessageEXT,
+    kHookDebugMarkerSetObjectTagEXT,
+    kHookDebugMarkerSetObjectNameEXT,
+    kHookCmdDebugMarkerBeginEXT,
+    kHookCmdDebugMarkerEndEXT,
+    kHookCmdDebugMarkerInsertEXT,
+    kHookCmdBindTransformFeedbackBuffersEXT,
+    kHookCmdBeginTransformFeedbackEXT,
+    kHookCmdEndTransformFeedbackEXT,
+    kHookCmdBeginQueryIndexedEXT,
+    kHookCmdEndQueryIndexedEXT,
+    kHookCmdDrawIndirectByteCountEXT,
+    kHookCreateCuModuleNVX,
+    kHookCreateCuFunctionNVX,
+    kHookDestroyCuModuleNVX,
+    kHookDestroyCuFunctionNVX,
+    kHookCmdCuLaunchKernelNVX,
+    kHookGetImageViewHandleNVX,
+    kHookGetImageViewAddressNVX,
+    kHookCmdDrawIndirectCountAMD,
+    kHookCmdDrawIndexedIndirectCountAMD,
+    kHookGetShaderInfoAMD,
+#ifdef VK_USE_PLATFORM_GGP
+    kHookCreateStreamDescriptorSurfaceGGP,
+#endif
+    kHookGetPhysicalDeviceExternalImageFormatPropertiesNV,
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookGetMemoryWin32HandleNV,
+#endif
+#ifdef VK_USE_PLATFORM_VI_NN
+    kHookCreateViSurfaceNN,
+#endif
+    kHookCmdBeginConditionalRenderingEXT,
+    kHookCmdEndConditionalRenderingEXT,
+    kHookCmdSetViewportWScalingNV,
+    kHookReleaseDisplayEXT,
+#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
+    kHookAcquireXlibDisplayEXT,
+#endif
+#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
+    kHookGetRandROutputDisplayEXT,
+#endif
+    kHookGetPhysicalDeviceSurfaceCapabilities2EXT,
+    kHookDisplayPowerControlEXT,
+    kHookRegisterDeviceEventEXT,
+    kHookRegisterDisplayEventEXT,
+    kHookGetSwapchainCounterEXT,
+    kHookGetRefreshCycleDurationGOOGLE,
+    kHookGetPastPresentationTimingGOOGLE,
+    kHookCmdSetDiscardRectangleEXT,
+    kHookSetHdrMetadataEXT,
+#ifdef VK_USE_PLATFORM_IOS_MVK
+    kHookCreateIOSSurfaceMVK,
+#endif
+#ifdef VK_USE_PLATFORM_MACOS_MVK
+    kHookCreateMacOSSurfaceMVK,
+#endif
+    kHookSetDebugUtilsObjectNameEXT,
+    kHookSetDebugUtilsObjectTagEXT,
+    kHookQueueBeginDebugUtilsLabelEXT,
+    kHookQueueEndDebugUtilsLabelEXT,
+    kHookQueueInsertDebugUtilsLabelEXT,
+    kHookCmdBeginDebugUtilsLabelEXT,
+    kHookCmdEndDebugUtilsLabelEXT,
+    kHookCmdInsertDebugUtilsLabelEXT,
+    kHookCreateDebugUtilsMessengerEXT,
+    kHookDestroyDebugUtilsMessengerEXT,
+    kHookSubmitDebugUtilsMessageEXT,
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    kHookGetAndroidHardwareBufferPropertiesANDROID,
+#endif
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    kHookGetMemoryAndroidHardwareBufferANDROID,
+#endif
+    kHookCmdSetSampleLocationsEXT,
+    kHookGetPhysicalDeviceMultisamplePropertiesEXT,
+    kHookGetImageDrmFormatModifierPropertiesEXT,
+    kHookCreateValidationCacheEXT,
+    kHookDestroyValidationCacheEXT,
+    kHookMergeValidationCachesEXT,
+    kHookGetValidationCacheDataEXT,
+    kHookCmdBindShadingRateImageNV,
+    kHookCmdSetViewportShadingRatePaletteNV,
+    kHookCmdSetCoarseSampleOrderNV,
+    kHookCreateAccelerationStructureNV,
+    kHookDestroyAccelerationStructureNV,
+    kHookGetAccelerationStructureMemoryRequirementsNV,
+    kHookBindAccelerationStructureMemoryNV,
+    kHookCmdBuildAccelerationStructureNV,
+    kHookCmdCopyAccelerationStructureNV,
+    kHookCmdTraceRaysNV,
+    kHookCreateRayTracingPipelinesNV,
+    kHookGetRayTracingShaderGroupHandlesKHR,
+    kHookGetRayTracingShaderGroupHandlesNV,
+    kHookGetAccelerationStructureHandleNV,
+    kHookCmdWriteAccelerationStructuresPropertiesNV,
+    kHookCompileDeferredNV,
+    kHookGetMemoryHostPointerPropertiesEXT,
+    kHookCmdWriteBufferMarkerAMD,
+    kHookGetPhysicalDeviceCalibrateableTimeDomainsEXT,
+    kHookGetCalibratedTimestampsEXT,
+    kHookCmdDrawMeshTasksNV,
+    kHookCmdDrawMeshTasksIndirectNV,
+    kHookCmdDrawMeshTasksIndirectCountNV,
+    kHookCmdSetExclusiveScissorNV,
+    kHookCmdSetCheckpointNV,
+    kHookGetQueueCheckpointDataNV,
+    kHookInitializePerformanceApiINTEL,
+    kHookUninitializePerformanceApiINTEL,
+    kHookCmdSetPerformanceMarkerINTEL,
+    kHookCmdSetPerformanceStreamMarkerINTEL,
+    kHookCmdSetPerformanceOverrideINTEL,
+    kHookAcquirePerformanceConfigurationINTEL,
+    kHookReleasePerformanceConfigurationINTEL,
+    kHookQueueSetPerformanceConfigurationINTEL,
+    kHookGetPerformanceParameterINTEL,
+    kHookSetLocalDimmingAMD,
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    kHookCreateImagePipeSurfaceFUCHSIA,
+#endif
+#ifdef VK_USE_PLATFORM_METAL_EXT
+    kHookCreateMetalSurfaceEXT,
+#endif
+    kHookGetBufferDeviceAddressEXT,
+    kHookGetPhysicalDeviceToolPropertiesEXT,
+    kHookGetPhysicalDeviceCooperativeMatrixPropertiesNV,
+    kHookGetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV,
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookGetPhysicalDeviceSurfacePresentModes2EXT,
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookAcquireFullScreenExclusiveModeEXT,
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookReleaseFullScreenExclusiveModeEXT,
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookGetDeviceGroupSurfacePresentModes2EXT,
+#endif
+    kHookCreateHeadlessSurfaceEXT,
+    kHookCmdSetLineStippleEXT,
+    kHookResetQueryPoolEXT,
+    kHookCmdSetCullModeEXT,
+    kHookCmdSetFrontFaceEXT,
+    kHookCmdSetPrimitiveTopologyEXT,
+    kHookCmdSetViewportWithCountEXT,
+    kHookCmdSetScissorWithCountEXT,
+    kHookCmdBindVertexBuffers2EXT,
+    kHookCmdSetDepthTestEnableEXT,
+    kHookCmdSetDepthWriteEnableEXT,
+    kHookCmdSetDepthCompareOpEXT,
+    kHookCmdSetDepthBoundsTestEnableEXT,
+    kHookCmdSetStencilTestEnableEXT,
+    kHookCmdSetStencilOpEXT,
+    kHookGetGeneratedCommandsMemoryRequirementsNV,
+    kHookCmdPreprocessGeneratedCommandsNV,
+    kHookCmdExecuteGeneratedCommandsNV,
+    kHookCmdBindPipelineShaderGroupNV,
+    kHookCreateIndirectCommandsLayoutNV,
+    kHookDestroyIndirectCommandsLayoutNV,
+    kHookAcquireDrmDisplayEXT,
+    kHookGetDrmDisplayEXT,
+    kHookCreatePrivateDataSlotEXT,
+    kHookDestroyPrivateDataSlotEXT,
+    kHookSetPrivateDataEXT,
+    kHookGetPrivateDataEXT,
+    kHookCmdSetFragmentShadingRateEnumNV,
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookAcquireWinrtDisplayNV,
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    kHookGetWinrtDisplayNV,
+#endif
+#ifdef VK_USE_PLATFORM_DIRECTFB_EXT
+    kHookCreateDirectFBSurfaceEXT,
+#endif
+#ifdef VK_USE_PLATFORM_DIRECTFB_EXT
+    kHookGetPhysicalDeviceDirectFBPresentationSupportEXT,
+#endif
+    kHookCmdSetVertexInputEXT,
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    kHookGetMemoryZirconHandleFUCHSIA,
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    kHookGetMemoryZirconHandlePropertiesFUCHSIA,
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    kHookImportSemaphoreZirconHandleFUCHSIA,
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    kHookGetSemaphoreZirconHandleFUCHSIA,
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    kHookCreateBufferCollectionFUCHSIA,
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    kHookSetBufferCollectionImageConstraintsFUCHSIA,
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    kHookSetBufferCollectionBufferConstraintsFUCHSIA,
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    kHookDestroyBufferCollectionFUCHSIA,
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    kHookGetBufferCollectionPropertiesFUCHSIA,
+#endif
+    kHookGetDeviceSubpassShadingMaxWorkgroupSizeHUAWEI,
+    kHookCmdSubpassShadingHUAWEI,
+    kHookCmdBindInvocationMaskHUAWEI,
+    kHookGetMemoryRemoteAddressNV,
+    kHookCmdSetPatchControlPointsEXT,
+    kHookCmdSetRasterizerDiscardEnableEXT,
+    kHookCmdSetDepthBiasEnableEXT,
+    kHookCmdSetLogicOpEXT,
+    kHookCmdSetPrimitiveRestartEnableEXT,
+#ifdef VK_USE_PLATFORM_SCREEN_QNX
+    kHookCreateScreenSurfaceQNX,
+#endif
+#ifdef VK_USE_PLATFORM_SCREEN_QNX
+    kHookGetPhysicalDeviceScreenPresentationSupportQNX,
+#endif
+    kHookCmdSetColorWriteEnableEXT,
+    kHookCmdDrawMultiEXT,
+    kHookCmdDrawMultiIndexedEXT,
+    kHookSetDeviceMemoryPriorityEXT,
+    kHookCreateAccelerationStructureKHR,
+    kHookDestroyAccelerationStructureKHR,
+    kHookCmdBuildAccelerationStructuresKHR,
+    kHookCmdBuildAccelerationStructuresIndirectKHR,
+    kHookBuildAccelerationStructuresKHR,
+    kHookCopyAccelerationStructureKHR,
+    kHookCopyAccelerationStructureToMemoryKHR,
+    kHookCopyMemoryToAccelerationStructureKHR,
+    kHookWriteAccelerationStructuresPropertiesKHR,
+    kHookCmdCopyAccelerationStructureKHR,
+    kHookCmdCopyAccelerationStructureToMemoryKHR,
+    kHookCmdCopyMemoryToAccelerationStructureKHR,
+    kHookGetAccelerationStructureDeviceAddressKHR,
+    kHookCmdWriteAccelerationStructuresPropertiesKHR,
+    kHookGetDeviceAccelerationStructureCompatibilityKHR,
+    kHookGetAccelerationStructureBuildSizesKHR,
+    kHookCmdTraceRaysKHR,
+    kHookCreateRayTracingPipelinesKHR,
+    kHookGetRayTracingCaptureReplayShaderGroupHandlesKHR,
+    kHookCmdTraceRaysIndirectKHR,
+    kHookGetRayTracingShaderGroupStackSizeKHR,
+    kHookCmdSetRayTracingPipelineStackSizeKHR,
+    kHookSlotCount
+};
+
+static const std::unordered_map<std::string, uint32_t> name_to_hook_slot_map = {
+    {"vkEnumeratePhysicalDevices", kHookEnumeratePhysicalDevices},
+    {"vkGetPhysicalDeviceFeatures", kHookGetPhysicalDeviceFeatures},
+    {"vkGetPhysicalDeviceFormatProperties", kHookGetPhysicalDeviceFormatProperties},
+    {"vkGetPhysicalDeviceImageFormatProperties", kHookGetPhysicalDeviceImageFormatProperties},
+    {"vkGetPhysicalDeviceProperties", kHookGetPhysicalDeviceProperties},
+    {"vkGetPhysicalDeviceQueueFamilyProperties", kHookGetPhysicalDeviceQueueFamilyProperties},
+    {"vkGetPhysicalDeviceMemoryProperties", kHookGetPhysicalDeviceMemoryProperties},
+    {"vkGetDeviceQueue", kHookGetDeviceQueue},
+    {"vkQueueSubmit", kHookQueueSubmit},
+    {"vkQueueWaitIdle", kHookQueueWaitIdle},
+    {"vkDeviceWaitIdle", kHookDeviceWaitIdle},
+    {"vkAllocateMemory", kHookAllocateMemory},
+    {"vkFreeMemory", kHookFreeMemory},
+    {"vkMapMemory", kHookMapMemory},
+    {"vkUnmapMemory", kHookUnmapMemory},
+    {"vkFlushMappedMemoryRanges", kHookFlushMappedMemoryRanges},
+    {"vkInvalidateMappedMemoryRanges", kHookInvalidateMappedMemoryRanges},
+    {"vkGetDeviceMemoryCommitment", kHookGetDeviceMemoryCommitment},
+    {"vkBindBufferMemory", kHookBindBufferMemory},
+    {"vkBindImageMemory", kHookBindImageMemory},
+    {"vkGetBufferMemoryRequirements", kHookGetBufferMemoryRequirements},
+    {"vkGetImageMemoryRequirements", kHookGetImageMemoryRequirements},
+    {"vkGetImageSparseMemoryRequirements", kHookGetImageSparseMemoryRequirements},
+    {"vkGetPhysicalDeviceSparseImageFormatProperties", kHookGetPhysicalDeviceSparseImageFormatProperties},
+    {"vkQueueBindSparse", kHookQueueBindSparse},
+    {"vkCreateFence", kHookCreateFence},
+    {"vkDestroyFence", kHookDestroyFence},
+    {"vkResetFences", kHookResetFences},
+    {"vkGetFenceStatus", kHookGetFenceStatus},
+    {"vkWaitForFences", kHookWaitForFences},
+    {"vkCreateSemaphore", kHookCreateSemaphore},
+    {"vkDestroySemaphore", kHookDestroySemaphore},
+    {"vkCreateEvent", kHookCreateEvent},
+    {"vkDestroyEvent", kHookDestroyEvent},
+    {"vkGetEventStatus", kHookGetEventStatus},
+    {"vkSetEvent", kHookSetEvent},
+    {"vkResetEvent", kHookResetEvent},
+    {"vkCreateQueryPool", kHookCreateQueryPool},
+    {"vkDestroyQueryPool", kHookDestroyQueryPool},
+    {"vkGetQueryPoolResults", kHookGetQueryPoolResults},
+    {"vkCreateBuffer", kHookCreateBuffer},
+    {"vkDestroyBuffer", kHookDestroyBuffer},
+    {"vkCreateBufferView", kHookCreateBufferView},
+    {"vkDestroyBufferView", kHookDestroyBufferView},
+    {"vkCreateImage", kHookCreateImage},
+    {"vkDestroyImage", kHookDestroyImage},
+    {"vkGetImageSubresourceLayout", kHookGetImageSubresourceLayout},
+    {"vkCreateImageView", kHookCreateImageView},
+    {"vkDestroyImageView", kHookDestroyImageView},
+    {"vkCreateShaderModule", kHookCreateShaderModule},
+    {"vkDestroyShaderModule", kHookDestroyShaderModule},
+    {"vkCreatePipelineCache", kHookCreatePipelineCache},
+    {"vkDestroyPipelineCache", kHookDestroyPipelineCache},
+    {"vkGetPipelineCacheData", kHookGetPipelineCacheData},
+    {"vkMergePipelineCaches", kHookMergePipelineCaches},
+    {"vkCreateGraphicsPipelines", kHookCreateGraphicsPipelines},
+    {"vkCreateComputePipelines", kHookCreateComputePipelines},
+    {"vkDestroyPipeline", kHookDestroyPipeline},
+    {"vkCreatePipelineLayout", kHookCreatePipelineLayout},
+    {"vkDestroyPipelineLayout", kHookDestroyPipelineLayout},
+    {"vkCreateSampler", kHookCreateSampler},
+    {"vkDestroySampler", kHookDestroySampler},
+    {"vkCreateDescriptorSetLayout", kHookCreateDescriptorSetLayout},
+    {"vkDestroyDescriptorSetLayout", kHookDestroyDescriptorSetLayout},
+    {"vkCreateDescriptorPool", kHookCreateDescriptorPool},
+    {"vkDestroyDescriptorPool", kHookDestroyDescriptorPool},
+    {"vkResetDescriptorPool", kHookResetDescriptorPool},
+    {"vkAllocateDescriptorSets", kHookAllocateDescriptorSets},
+    {"vkFreeDescriptorSets", kHookFreeDescriptorSets},
+    {"vkUpdateDescriptorSets", kHookUpdateDescriptorSets},
+    {"vkCreateFramebuffer", kHookCreateFramebuffer},
+    {"vkDestroyFramebuffer", kHookDestroyFramebuffer},
+    {"vkCreateRenderPass", kHookCreateRenderPass},
+    {"vkDestroyRenderPass", kHookDestroyRenderPass},
+    {"vkGetRenderAreaGranularity", kHookGetRenderAreaGranularity},
+    {"vkCreateCommandPool", kHookCreateCommandPool},
+    {"vkDestroyCommandPool", kHookDestroyCommandPool},
+    {"vkResetCommandPool", kHookResetCommandPool},
+    {"vkAllocateCommandBuffers", kHookAllocateCommandBuffers},
+    {"vkFreeCommandBuffers", kHookFreeCommandBuffers},
+    {"vkBeginCommandBuffer", kHookBeginCommandBuffer},
+    {"vkEndCommandBuffer", kHookEndCommandBuffer},
+    {"vkResetCommandBuffer", kHookResetCommandBuffer},
+    {"vkCmdBindPipeline", kHookCmdBindPipeline},
+    {"vkCmdSetViewport", kHookCmdSetViewport},
+    {"vkCmdSetScissor", kHookCmdSetScissor},
+    {"vkCmdSetLineWidth", kHookCmdSetLineWidth},
+    {"vkCmdSetDepthBias", kHookCmdSetDepthBias},
+    {"vkCmdSetBlendConstants", kHookCmdSetBlendConstants},
+    {"vkCmdSetDepthBounds", kHookCmdSetDepthBounds},
+    {"vkCmdSetStencilCompareMask", kHookCmdSetStencilCompareMask},
+    {"vkCmdSetStencilWriteMask", kHookCmdSetStencilWriteMask},
+    {"vkCmdSetStencilReference", kHookCmdSetStencilReference},
+    {"vkCmdBindDescriptorSets", kHookCmdBindDescriptorSets},
+    {"vkCmdBindIndexBuffer", kHookCmdBindIndexBuffer},
+    {"vkCmdBindVertexBuffers", kHookCmdBindVertexBuffers},
+    {"vkCmdDraw", kHookCmdDraw},
+    {"vkCmdDrawIndexed", kHookCmdDrawIndexed},
+    {"vkCmdDrawIndirect", kHookCmdDrawIndirect},
+    {"vkCmdDrawIndexedIndirect", kHookCmdDrawIndexedIndirect},
+    {"vkCmdDispatch", kHookCmdDispatch},
+    {"vkCmdDispatchIndirect", kHookCmdDispatchIndirect},
+    {"vkCmdCopyBuffer", kHookCmdCopyBuffer},
+    {"vkCmdCopyImage", kHookCmdCopyImage},
+    {"vkCmdBlitImage", kHookCmdBlitImage},
+    {"vkCmdCopyBufferToImage", kHookCmdCopyBufferToImage},
+    {"vkCmdCopyImageToBuffer", kHookCmdCopyImageToBuffer},
+    {"vkCmdUpdateBuffer", kHookCmdUpdateBuffer},
+    {"vkCmdFillBuffer", kHookCmdFillBuffer},
+    {"vkCmdClearColorImage", kHookCmdClearColorImage},
+    {"vkCmdClearDepthStencilImage", kHookCmdClearDepthStencilImage},
+    {"vkCmdClearAttachments", kHookCmdClearAttachments},
+    {"vkCmdResolveImage", kHookCmdResolveImage},
+    {"vkCmdSetEvent", kHookCmdSetEvent},
+    {"vkCmdResetEvent", kHookCmdResetEvent},
+    {"vkCmdWaitEvents", kHookCmdWaitEvents},
+    {"vkCmdPipelineBarrier", kHookCmdPipelineBarrier},
+    {"vkCmdBeginQuery", kHookCmdBeginQuery},
+    {"vkCmdEndQuery", kHookCmdEndQuery},
+    {"vkCmdResetQueryPool", kHookCmdResetQueryPool},
+    {"vkCmdWriteTimestamp", kHookCmdWriteTimestamp},
+    {"vkCmdCopyQueryPoolResults", kHookCmdCopyQueryPoolResults},
+    {"vkCmdPushConstants", kHookCmdPushConstants},
+    {"vkCmdBeginRenderPass", kHookCmdBeginRenderPass},
+    {"vkCmdNextSubpass", kHookCmdNextSubpass},
+    {"vkCmdEndRenderPass", kHookCmdEndRenderPass},
+    {"vkCmdExecuteCommands", kHookCmdExecuteCommands},
+    {"vkBindBufferMemory2", kHookBindBufferMemory2},
+    {"vkBindImageMemory2", kHookBindImageMemory2},
+    {"vkGetDeviceGroupPeerMemoryFeatures", kHookGetDeviceGroupPeerMemoryFeatures},
+    {"vkCmdSetDeviceMask", kHookCmdSetDeviceMask},
+    {"vkCmdDispatchBase", kHookCmdDispatchBase},
+    {"vkEnumeratePhysicalDeviceGroups", kHookEnumeratePhysicalDeviceGroups},
+    {"vkGetImageMemoryRequirements2", kHookGetImageMemoryRequirements2},
+    {"vkGetBufferMemoryRequirements2", kHookGetBufferMemoryRequirements2},
+    {"vkGetImageSparseMemoryRequirements2", kHookGetImageSparseMemoryRequirements2},
+    {"vkGetPhysicalDeviceFeatures2", kHookGetPhysicalDeviceFeatures2},
+    {"vkGetPhysicalDeviceProperties2", kHookGetPhysicalDeviceProperties2},
+    {"vkGetPhysicalDeviceFormatProperties2", kHookGetPhysicalDeviceFormatProperties2},
+    {"vkGetPhysicalDeviceImageFormatProperties2", kHookGetPhysicalDeviceImageFormatProperties2},
+    {"vkGetPhysicalDeviceQueueFamilyProperties2", kHookGetPhysicalDeviceQueueFamilyProperties2},
+    {"vkGetPhysicalDeviceMemoryProperties2", kHookGetPhysicalDeviceMemoryProperties2},
+    {"vkGetPhysicalDeviceSparseImageFormatProperties2", kHookGetPhysicalDeviceSparseImageFormatProperties2},
+    {"vkTrimCommandPool", kHookTrimCommandPool},
+    {"vkGetDeviceQueue2", kHookGetDeviceQueue2},
+    {"vkCreateSamplerYcbcrConversion", kHookCreateSamplerYcbcrConversion},
+    {"vkDestroySamplerYcbcrConversion", kHookDestroySamplerYcbcrConversion},
+    {"vkCreateDescriptorUpdateTemplate", kHookCreateDescriptorUpdateTemplate},
+    {"vkDestroyDescriptorUpdateTemplate", kHookDestroyDescriptorUpdateTemplate},
+    {"vkUpdateDescriptorSetWithTemplate", kHookUpdateDescriptorSetWithTemplate},
+    {"vkGetPhysicalDeviceExternalBufferProperties", kHookGetPhysicalDeviceExternalBufferProperties},
+    {"vkGetPhysicalDeviceExternalFenceProperties", kHookGetPhysicalDeviceExternalFenceProperties},
+    {"vkGetPhysicalDeviceExternalSemaphoreProperties", kHookGetPhysicalDeviceExternalSemaphoreProperties},
+    {"vkGetDescriptorSetLayoutSupport", kHookGetDescriptorSetLayoutSupport},
+    {"vkCmdDrawIndirectCount", kHookCmdDrawIndirectCount},
+    {"vkCmdDrawIndexedIndirectCount", kHookCmdDrawIndexedIndirectCount},
+    {"vkCreateRenderPass2", kHookCreateRenderPass2},
+    {"vkCmdBeginRenderPass2", kHookCmdBeginRenderPass2},
+    {"vkCmdNextSubpass2", kHookCmdNextSubpass2},
+    {"vkCmdEndRenderPass2", kHookCmdEndRenderPass2},
+    {"vkResetQueryPool", kHookResetQueryPool},
+    {"vkGetSemaphoreCounterValue", kHookGetSemaphoreCounterValue},
+    {"vkWaitSemaphores", kHookWaitSemaphores},
+    {"vkSignalSemaphore", kHookSignalSemaphore},
+    {"vkGetBufferDeviceAddress", kHookGetBufferDeviceAddress},
+    {"vkGetBufferOpaqueCaptureAddress", kHookGetBufferOpaqueCaptureAddress},
+    {"vkGetDeviceMemoryOpaqueCaptureAddress", kHookGetDeviceMemoryOpaqueCaptureAddress},
+    {"vkGetPhysicalDeviceToolProperties", kHookGetPhysicalDeviceToolProperties},
+    {"vkCreatePrivateDataSlot", kHookCreatePrivateDataSlot},
+    {"vkDestroyPrivateDataSlot", kHookDestroyPrivateDataSlot},
+    {"vkSetPrivateData", kHookSetPrivateData},
+    {"vkGetPrivateData", kHookGetPrivateData},
+    {"vkCmdSetEvent2", kHookCmdSetEvent2},
+    {"vkCmdResetEvent2", kHookCmdResetEvent2},
+    {"vkCmdWaitEvents2", kHookCmdWaitEvents2},
+    {"vkCmdPipelineBarrier2", kHookCmdPipelineBarrier2},
+    {"vkCmdWriteTimestamp2", kHookCmdWriteTimestamp2},
+    {"vkQueueSubmit2", kHookQueueSubmit2},
+    {"vkCmdCopyBuffer2", kHookCmdCopyBuffer2},
+    {"vkCmdCopyImage2", kHookCmdCopyImage2},
+    {"vkCmdCopyBufferToImage2", kHookCmdCopyBufferToImage2},
+    {"vkCmdCopyImageToBuffer2", kHookCmdCopyImageToBuffer2},
+    {"vkCmdBlitImage2", kHookCmdBlitImage2},
+    {"vkCmdResolveImage2", kHookCmdResolveImage2},
+    {"vkCmdBeginRendering", kHookCmdBeginRendering},
+    {"vkCmdEndRendering", kHookCmdEndRendering},
+    {"vkCmdSetCullMode", kHookCmdSetCullMode},
+    {"vkCmdSetFrontFace", kHookCmdSetFrontFace},
+    {"vkCmdSetPrimitiveTopology", kHookCmdSetPrimitiveTopology},
+    {"vkCmdSetViewportWithCount", kHookCmdSetViewportWithCount},
+    {"vkCmdSetScissorWithCount", kHookCmdSetScissorWithCount},
+    {"vkCmdBindVertexBuffers2", kHookCmdBindVertexBuffers2},
+    {"vkCmdSetDepthTestEnable", kHookCmdSetDepthTestEnable},
+    {"vkCmdSetDepthWriteEnable", kHookCmdSetDepthWriteEnable},
+    {"vkCmdSetDepthCompareOp", kHookCmdSetDepthCompareOp},
+    {"vkCmdSetDepthBoundsTestEnable", kHookCmdSetDepthBoundsTestEnable},
+    {"vkCmdSetStencilTestEnable", kHookCmdSetStencilTestEnable},
+    {"vkCmdSetStencilOp", kHookCmdSetStencilOp},
+    {"vkCmdSetRasterizerDiscardEnable", kHookCmdSetRasterizerDiscardEnable},
+    {"vkCmdSetDepthBiasEnable", kHookCmdSetDepthBiasEnable},
+    {"vkCmdSetPrimitiveRestartEnable", kHookCmdSetPrimitiveRestartEnable},
+    {"vkGetDeviceBufferMemoryRequirements", kHookGetDeviceBufferMemoryRequirements},
+    {"vkGetDeviceImageMemoryRequirements", kHookGetDeviceImageMemoryRequirements},
+    {"vkGetDeviceImageSparseMemoryRequirements", kHookGetDeviceImageSparseMemoryRequirements},
+    {"vkDestroySurfaceKHR", kHookDestroySurfaceKHR},
+    {"vkGetPhysicalDeviceSurfaceSupportKHR", kHookGetPhysicalDeviceSurfaceSupportKHR},
+    {"vkGetPhysicalDeviceSurfaceCapabilitiesKHR", kHookGetPhysicalDeviceSurfaceCapabilitiesKHR},
+    {"vkGetPhysicalDeviceSurfaceFormatsKHR", kHookGetPhysicalDeviceSurfaceFormatsKHR},
+    {"vkGetPhysicalDeviceSurfacePresentModesKHR", kHookGetPhysicalDeviceSurfacePresentModesKHR},
+    {"vkCreateSwapchainKHR", kHookCreateSwapchainKHR},
+    {"vkDestroySwapchainKHR", kHookDestroySwapchainKHR},
+    {"vkGetSwapchainImagesKHR", kHookGetSwapchainImagesKHR},
+    {"vkAcquireNextImageKHR", kHookAcquireNextImageKHR},
+    {"vkQueuePresentKHR", kHookQueuePresentKHR},
+    {"vkGetDeviceGroupPresentCapabilitiesKHR", kHookGetDeviceGroupPresentCapabilitiesKHR},
+    {"vkGetDeviceGroupSurfacePresentModesKHR", kHookGetDeviceGroupSurfacePresentModesKHR},
+    {"vkGetPhysicalDevicePresentRectanglesKHR", kHookGetPhysicalDevicePresentRectanglesKHR},
+    {"vkAcquireNextImage2KHR", kHookAcquireNextImage2KHR},
+    {"vkGetPhysicalDeviceDisplayPropertiesKHR", kHookGetPhysicalDeviceDisplayPropertiesKHR},
+    {"vkGetPhysicalDeviceDisplayPlanePropertiesKHR", kHookGetPhysicalDeviceDisplayPlanePropertiesKHR},
+    {"vkGetDisplayPlaneSupportedDisplaysKHR", kHookGetDisplayPlaneSupportedDisplaysKHR},
+    {"vkGetDisplayModePropertiesKHR", kHookGetDisplayModePropertiesKHR},
+    {"vkCreateDisplayModeKHR", kHookCreateDisplayModeKHR},
+    {"vkGetDisplayPlaneCapabilitiesKHR", kHookGetDisplayPlaneCapabilitiesKHR},
+    {"vkCreateDisplayPlaneSurfaceKHR", kHookCreateDisplayPlaneSurfaceKHR},
+    {"vkCreateSharedSwapchainsKHR", kHookCreateSharedSwapchainsKHR},
+#ifdef VK_USE_PLATFORM_XLIB_KHR
+    {"vkCreateXlibSurfaceKHR", kHookCreateXlibSurfaceKHR},
+#endif
+#ifdef VK_USE_PLATFORM_XLIB_KHR
+    {"vkGetPhysicalDeviceXlibPresentationSupportKHR", kHookGetPhysicalDeviceXlibPresentationSupportKHR},
+#endif
+#ifdef VK_USE_PLATFORM_XCB_KHR
+    {"vkCreateXcbSurfaceKHR", kHookCreateXcbSurfaceKHR},
+#endif
+#ifdef VK_USE_PLATFORM_XCB_KHR
+    {"vkGetPhysicalDeviceXcbPresentationSupportKHR", kHookGetPhysicalDeviceXcbPresentationSupportKHR},
+#endif
+#ifdef VK_USE_PLATFORM_WAYLAND_KHR
+    {"vkCreateWaylandSurfaceKHR", kHookCreateWaylandSurfaceKHR},
+#endif
+#ifdef VK_USE_PLATFORM_WAYLAND_KHR
+    {"vkGetPhysicalDeviceWaylandPresentationSupportKHR", kHookGetPhysicalDeviceWaylandPresentationSupportKHR},
+#endif
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    {"vkCreateAndroidSurfaceKHR", kHookCreateAndroidSurfaceKHR},
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkCreateWin32SurfaceKHR", kHookCreateWin32SurfaceKHR},
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkGetPhysicalDeviceWin32PresentationSupportKHR", kHookGetPhysicalDeviceWin32PresentationSupportKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkGetPhysicalDeviceVideoCapabilitiesKHR", kHookGetPhysicalDeviceVideoCapabilitiesKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkGetPhysicalDeviceVideoFormatPropertiesKHR", kHookGetPhysicalDeviceVideoFormatPropertiesKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkCreateVideoSessionKHR", kHookCreateVideoSessionKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkDestroyVideoSessionKHR", kHookDestroyVideoSessionKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkGetVideoSessionMemoryRequirementsKHR", kHookGetVideoSessionMemoryRequirementsKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkBindVideoSessionMemoryKHR", kHookBindVideoSessionMemoryKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkCreateVideoSessionParametersKHR", kHookCreateVideoSessionParametersKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkUpdateVideoSessionParametersKHR", kHookUpdateVideoSessionParametersKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkDestroyVideoSessionParametersKHR", kHookDestroyVideoSessionParametersKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkCmdBeginVideoCodingKHR", kHookCmdBeginVideoCodingKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkCmdEndVideoCodingKHR", kHookCmdEndVideoCodingKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkCmdControlVideoCodingKHR", kHookCmdControlVideoCodingKHR},
+#endif
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkCmdDecodeVideoKHR", kHookCmdDecodeVideoKHR},
+#endif
+    {"vkCmdBeginRenderingKHR", kHookCmdBeginRenderingKHR},
+    {"vkCmdEndRenderingKHR", kHookCmdEndRenderingKHR},
+    {"vkGetPhysicalDeviceFeatures2KHR", kHookGetPhysicalDeviceFeatures2KHR},
+    {"vkGetPhysicalDeviceProperties2KHR", kHookGetPhysicalDeviceProperties2KHR},
+    {"vkGetPhysicalDeviceFormatProperties2KHR", kHookGetPhysicalDeviceFormatProperties2KHR},
+    {"vkGetPhysicalDeviceImageFormatProperties2KHR", kHookGetPhysicalDeviceImageFormatProperties2KHR},
+    {"vkGetPhysicalDeviceQueueFamilyProperties2KHR", kHookGetPhysicalDeviceQueueFamilyProperties2KHR},
+    {"vkGetPhysicalDeviceMemoryProperties2KHR", kHookGetPhysicalDeviceMemoryProperties2KHR},
+    {"vkGetPhysicalDeviceSparseImageFormatProperties2KHR", kHookGetPhysicalDeviceSparseImageFormatProperties2KHR},
+    {"vkGetDeviceGroupPeerMemoryFeaturesKHR", kHookGetDeviceGroupPeerMemoryFeaturesKHR},
+    {"vkCmdSetDeviceMaskKHR", kHookCmdSetDeviceMaskKHR},
+    {"vkCmdDispatchBaseKHR", kHookCmdDispatchBaseKHR},
+    {"vkTrimCommandPoolKHR", kHookTrimCommandPoolKHR},
+    {"vkEnumeratePhysicalDeviceGroupsKHR", kHookEnumeratePhysicalDeviceGroupsKHR},
+    {"vkGetPhysicalDeviceExternalBufferPropertiesKHR", kHookGetPhysicalDeviceExternalBufferPropertiesKHR},
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkGetMemoryWin32HandleKHR", kHookGetMemoryWin32HandleKHR},
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkGetMemoryWin32HandlePropertiesKHR", kHookGetMemoryWin32HandlePropertiesKHR},
+#endif
+    {"vkGetMemoryFdKHR", kHookGetMemoryFdKHR},
+    {"vkGetMemoryFdPropertiesKHR", kHookGetMemoryFdPropertiesKHR},
+    {"vkGetPhysicalDeviceExternalSemaphorePropertiesKHR", kHookGetPhysicalDeviceExternalSemaphorePropertiesKHR},
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkImportSemaphoreWin32HandleKHR", kHookImportSemaphoreWin32HandleKHR},
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkGetSemaphoreWin32HandleKHR", kHookGetSemaphoreWin32HandleKHR},
+#endif
+    {"vkImportSemaphoreFdKHR", kHookImportSemaphoreFdKHR},
+    {"vkGetSemaphoreFdKHR", kHookGetSemaphoreFdKHR},
+    {"vkCmdPushDescriptorSetKHR", kHookCmdPushDescriptorSetKHR},
+    {"vkCmdPushDescriptorSetWithTemplateKHR", kHookCmdPushDescriptorSetWithTemplateKHR},
+    {"vkCreateDescriptorUpdateTemplateKHR", kHookCreateDescriptorUpdateTemplateKHR},
+    {"vkDestroyDescriptorUpdateTemplateKHR", kHookDestroyDescriptorUpdateTemplateKHR},
+    {"vkUpdateDescriptorSetWithTemplateKHR", kHookUpdateDescriptorSetWithTemplateKHR},
+    {"vkCreateRenderPass2KHR", kHookCreateRenderPass2KHR},
+    {"vkCmdBeginRenderPass2KHR", kHookCmdBeginRenderPass2KHR},
+    {"vkCmdNextSubpass2KHR", kHookCmdNextSubpass2KHR},
+    {"vkCmdEndRenderPass2KHR", kHookCmdEndRenderPass2KHR},
+    {"vkGetSwapchainStatusKHR", kHookGetSwapchainStatusKHR},
+    {"vkGetPhysicalDeviceExternalFencePropertiesKHR", kHookGetPhysicalDeviceExternalFencePropertiesKHR},
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkImportFenceWin32HandleKHR", kHookImportFenceWin32HandleKHR},
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkGetFenceWin32HandleKHR", kHookGetFenceWin32HandleKHR},
+#endif
+    {"vkImportFenceFdKHR", kHookImportFenceFdKHR},
+    {"vkGetFenceFdKHR", kHookGetFenceFdKHR},
+    {"vkEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR", kHookEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR},
+    {"vkGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR", kHookGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR},
+    {"vkAcquireProfilingLockKHR", kHookAcquireProfilingLockKHR},
+    {"vkReleaseProfilingLockKHR", kHookReleaseProfilingLockKHR},
+    {"vkGetPhysicalDeviceSurfaceCapabilities2KHR", kHookGetPhysicalDeviceSurfaceCapabilities2KHR},
+    {"vkGetPhysicalDeviceSurfaceFormats2KHR", kHookGetPhysicalDeviceSurfaceFormats2KHR},
+    {"vkGetPhysicalDeviceDisplayProperties2KHR", kHookGetPhysicalDeviceDisplayProperties2KHR},
+    {"vkGetPhysicalDeviceDisplayPlaneProperties2KHR", kHookGetPhysicalDeviceDisplayPlaneProperties2KHR},
+    {"vkGetDisplayModeProperties2KHR", kHookGetDisplayModeProperties2KHR},
+    {"vkGetDisplayPlaneCapabilities2KHR", kHookGetDisplayPlaneCapabilities2KHR},
+    {"vkGetImageMemoryRequirements2KHR", kHookGetImageMemoryRequirements2KHR},
+    {"vkGetBufferMemoryRequirements2KHR", kHookGetBufferMemoryRequirements2KHR},
+    {"vkGetImageSparseMemoryRequirements2KHR", kHookGetImageSparseMemoryRequirements2KHR},
+    {"vkCreateSamplerYcbcrConversionKHR", kHookCreateSamplerYcbcrConversionKHR},
+    {"vkDestroySamplerYcbcrConversionKHR", kHookDestroySamplerYcbcrConversionKHR},
+    {"vkBindBufferMemory2KHR", kHookBindBufferMemory2KHR},
+    {"vkBindImageMemory2KHR", kHookBindImageMemory2KHR},
+    {"vkGetDescriptorSetLayoutSupportKHR", kHookGetDescriptorSetLayoutSupportKHR},
+    {"vkCmdDrawIndirectCountKHR", kHookCmdDrawIndirectCountKHR},
+    {"vkCmdDrawIndexedIndirectCountKHR", kHookCmdDrawIndexedIndirectCountKHR},
+    {"vkGetSemaphoreCounterValueKHR", kHookGetSemaphoreCounterValueKHR},
+    {"vkWaitSemaphoresKHR", kHookWaitSemaphoresKHR},
+    {"vkSignalSemaphoreKHR", kHookSignalSemaphoreKHR},
+    {"vkGetPhysicalDeviceFragmentShadingRatesKHR", kHookGetPhysicalDeviceFragmentShadingRatesKHR},
+    {"vkCmdSetFragmentShadingRateKHR", kHookCmdSetFragmentShadingRateKHR},
+    {"vkWaitForPresentKHR", kHookWaitForPresentKHR},
+    {"vkGetBufferDeviceAddressKHR", kHookGetBufferDeviceAddressKHR},
+    {"vkGetBufferOpaqueCaptureAddressKHR", kHookGetBufferOpaqueCaptureAddressKHR},
+    {"vkGetDeviceMemoryOpaqueCaptureAddressKHR", kHookGetDeviceMemoryOpaqueCaptureAddressKHR},
+    {"vkCreateDeferredOperationKHR", kHookCreateDeferredOperationKHR},
+    {"vkDestroyDeferredOperationKHR", kHookDestroyDeferredOperationKHR},
+    {"vkGetDeferredOperationMaxConcurrencyKHR", kHookGetDeferredOperationMaxConcurrencyKHR},
+    {"vkGetDeferredOperationResultKHR", kHookGetDeferredOperationResultKHR},
+    {"vkDeferredOperationJoinKHR", kHookDeferredOperationJoinKHR},
+    {"vkGetPipelineExecutablePropertiesKHR", kHookGetPipelineExecutablePropertiesKHR},
+    {"vkGetPipelineExecutableStatisticsKHR", kHookGetPipelineExecutableStatisticsKHR},
+    {"vkGetPipelineExecutableInternalRepresentationsKHR", kHookGetPipelineExecutableInternalRepresentationsKHR},
+#ifdef VK_ENABLE_BETA_EXTENSIONS
+    {"vkCmdEncodeVideoKHR", kHookCmdEncodeVideoKHR},
+#endif
+    {"vkCmdSetEvent2KHR", kHookCmdSetEvent2KHR},
+    {"vkCmdResetEvent2KHR", kHookCmdResetEvent2KHR},
+    {"vkCmdWaitEvents2KHR", kHookCmdWaitEvents2KHR},
+    {"vkCmdPipelineBarrier2KHR", kHookCmdPipelineBarrier2KHR},
+    {"vkCmdWriteTimestamp2KHR", kHookCmdWriteTimestamp2KHR},
+    {"vkQueueSubmit2KHR", kHookQueueSubmit2KHR},
+    {"vkCmdWriteBufferMarker2AMD", kHookCmdWriteBufferMarker2AMD},
+    {"vkGetQueueCheckpointData2NV", kHookGetQueueCheckpointData2NV},
+    {"vkCmdCopyBuffer2KHR", kHookCmdCopyBuffer2KHR},
+    {"vkCmdCopyImage2KHR", kHookCmdCopyImage2KHR},
+    {"vkCmdCopyBufferToImage2KHR", kHookCmdCopyBufferToImage2KHR},
+    {"vkCmdCopyImageToBuffer2KHR", kHookCmdCopyImageToBuffer2KHR},
+    {"vkCmdBlitImage2KHR", kHookCmdBlitImage2KHR},
+    {"vkCmdResolveImage2KHR", kHookCmdResolveImage2KHR},
+    {"vkGetDeviceBufferMemoryRequirementsKHR", kHookGetDeviceBufferMemoryRequirementsKHR},
+    {"vkGetDeviceImageMemoryRequirementsKHR", kHookGetDeviceImageMemoryRequirementsKHR},
+    {"vkGetDeviceImageSparseMemoryRequirementsKHR", kHookGetDeviceImageSparseMemoryRequirementsKHR},
+    {"vkCreateDebugReportCallbackEXT", kHookCreateDebugReportCallbackEXT},
+    {"vkDestroyDebugReportCallbackEXT", kHookDestroyDebugReportCallbackEXT},
+    {"vkDebugReportMessageEXT", kHookDebugReportMessageEXT},
+    {"vkDebugMarkerSetObjectTagEXT", kHookDebugMarkerSetObjectTagEXT},
+    {"vkDebugMarkerSetObjectNameEXT", kHookDebugMarkerSetObjectNameEXT},
+    {"vkCmdDebugMarkerBeginEXT", kHookCmdDebugMarkerBeginEXT},
+    {"vkCmdDebugMarkerEndEXT", kHookCmdDebugMarkerEndEXT},
+    {"vkCmdDebugMarkerInsertEXT", kHookCmdDebugMarkerInsertEXT},
+    {"vkCmdBindTransformFeedbackBuffersEXT", kHookCmdBindTransformFeedbackBuffersEXT},
+    {"vkCmdBeginTransformFeedbackEXT", kHookCmdBeginTransformFeedbackEXT},
+    {"vkCmdEndTransformFeedbackEXT", kHookCmdEndTransformFeedbackEXT},
+    {"vkCmdBeginQueryIndexedEXT", kHookCmdBeginQueryIndexedEXT},
+    {"vkCmdEndQueryIndexedEXT", kHookCmdEndQueryIndexedEXT},
+    {"vkCmdDrawIndirectByteCountEXT", kHookCmdDrawIndirectByteCountEXT},
+    {"vkCreateCuModuleNVX", kHookCreateCuModuleNVX},
+    {"vkCreateCuFunctionNVX", kHookCreateCuFunctionNVX},
+    {"vkDestroyCuModuleNVX", kHookDestroyCuModuleNVX},
+    {"vkDestroyCuFunctionNVX", kHookDestroyCuFunctionNVX},
+    {"vkCmdCuLaunchKernelNVX", kHookCmdCuLaunchKernelNVX},
+    {"vkGetImageViewHandleNVX", kHookGetImageViewHandleNVX},
+    {"vkGetImageViewAddressNVX", kHookGetImageViewAddressNVX},
+    {"vkCmdDrawIndirectCountAMD", kHookCmdDrawIndirectCountAMD},
+    {"vkCmdDrawIndexedIndirectCountAMD", kHookCmdDrawIndexedIndirectCountAMD},
+    {"vkGetShaderInfoAMD", kHookGetShaderInfoAMD},
+#ifdef VK_USE_PLATFORM_GGP
+    {"vkCreateStreamDescriptorSurfaceGGP", kHookCreateStreamDescriptorSurfaceGGP},
+#endif
+    {"vkGetPhysicalDeviceExternalImageFormatPropertiesNV", kHookGetPhysicalDeviceExternalImageFormatPropertiesNV},
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkGetMemoryWin32HandleNV", kHookGetMemoryWin32HandleNV},
+#endif
+#ifdef VK_USE_PLATFORM_VI_NN
+    {"vkCreateViSurfaceNN", kHookCreateViSurfaceNN},
+#endif
+    {"vkCmdBeginConditionalRenderingEXT", kHookCmdBeginConditionalRenderingEXT},
+    {"vkCmdEndConditionalRenderingEXT", kHookCmdEndConditionalRenderingEXT},
+    {"vkCmdSetViewportWScalingNV", kHookCmdSetViewportWScalingNV},
+    {"vkReleaseDisplayEXT", kHookReleaseDisplayEXT},
+#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
+    {"vkAcquireXlibDisplayEXT", kHookAcquireXlibDisplayEXT},
+#endif
+#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
+    {"vkGetRandROutputDisplayEXT", kHookGetRandROutputDisplayEXT},
+#endif
+    {"vkGetPhysicalDeviceSurfaceCapabilities2EXT", kHookGetPhysicalDeviceSurfaceCapabilities2EXT},
+    {"vkDisplayPowerControlEXT", kHookDisplayPowerControlEXT},
+    {"vkRegisterDeviceEventEXT", kHookRegisterDeviceEventEXT},
+    {"vkRegisterDisplayEventEXT", kHookRegisterDisplayEventEXT},
+    {"vkGetSwapchainCounterEXT", kHookGetSwapchainCounterEXT},
+    {"vkGetRefreshCycleDurationGOOGLE", kHookGetRefreshCycleDurationGOOGLE},
+    {"vkGetPastPresentationTimingGOOGLE", kHookGetPastPresentationTimingGOOGLE},
+    {"vkCmdSetDiscardRectangleEXT", kHookCmdSetDiscardRectangleEXT},
+    {"vkSetHdrMetadataEXT", kHookSetHdrMetadataEXT},
+#ifdef VK_USE_PLATFORM_IOS_MVK
+    {"vkCreateIOSSurfaceMVK", kHookCreateIOSSurfaceMVK},
+#endif
+#ifdef VK_USE_PLATFORM_MACOS_MVK
+    {"vkCreateMacOSSurfaceMVK", kHookCreateMacOSSurfaceMVK},
+#endif
+    {"vkSetDebugUtilsObjectNameEXT", kHookSetDebugUtilsObjectNameEXT},
+    {"vkSetDebugUtilsObjectTagEXT", kHookSetDebugUtilsObjectTagEXT},
+    {"vkQueueBeginDebugUtilsLabelEXT", kHookQueueBeginDebugUtilsLabelEXT},
+    {"vkQueueEndDebugUtilsLabelEXT", kHookQueueEndDebugUtilsLabelEXT},
+    {"vkQueueInsertDebugUtilsLabelEXT", kHookQueueInsertDebugUtilsLabelEXT},
+    {"vkCmdBeginDebugUtilsLabelEXT", kHookCmdBeginDebugUtilsLabelEXT},
+    {"vkCmdEndDebugUtilsLabelEXT", kHookCmdEndDebugUtilsLabelEXT},
+    {"vkCmdInsertDebugUtilsLabelEXT", kHookCmdInsertDebugUtilsLabelEXT},
+    {"vkCreateDebugUtilsMessengerEXT", kHookCreateDebugUtilsMessengerEXT},
+    {"vkDestroyDebugUtilsMessengerEXT", kHookDestroyDebugUtilsMessengerEXT},
+    {"vkSubmitDebugUtilsMessageEXT", kHookSubmitDebugUtilsMessageEXT},
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    {"vkGetAndroidHardwareBufferPropertiesANDROID", kHookGetAndroidHardwareBufferPropertiesANDROID},
+#endif
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    {"vkGetMemoryAndroidHardwareBufferANDROID", kHookGetMemoryAndroidHardwareBufferANDROID},
+#endif
+    {"vkCmdSetSampleLocationsEXT", kHookCmdSetSampleLocationsEXT},
+    {"vkGetPhysicalDeviceMultisamplePropertiesEXT", kHookGetPhysicalDeviceMultisamplePropertiesEXT},
+    {"vkGetImageDrmFormatModifierPropertiesEXT", kHookGetImageDrmFormatModifierPropertiesEXT},
+    {"vkCreateValidationCacheEXT", kHookCreateValidationCacheEXT},
+    {"vkDestroyValidationCacheEXT", kHookDestroyValidationCacheEXT},
+    {"vkMergeValidationCachesEXT", kHookMergeValidationCachesEXT},
+    {"vkGetValidationCacheDataEXT", kHookGetValidationCacheDataEXT},
+    {"vkCmdBindShadingRateImageNV", kHookCmdBindShadingRateImageNV},
+    {"vkCmdSetViewportShadingRatePaletteNV", kHookCmdSetViewportShadingRatePaletteNV},
+    {"vkCmdSetCoarseSampleOrderNV", kHookCmdSetCoarseSampleOrderNV},
+    {"vkCreateAccelerationStructureNV", kHookCreateAccelerationStructureNV},
+    {"vkDestroyAccelerationStructureNV", kHookDestroyAccelerationStructureNV},
+    {"vkGetAccelerationStructureMemoryRequirementsNV", kHookGetAccelerationStructureMemoryRequirementsNV},
+    {"vkBindAccelerationStructureMemoryNV", kHookBindAccelerationStructureMemoryNV},
+    {"vkCmdBuildAccelerationStructureNV", kHookCmdBuildAccelerationStructureNV},
+    {"vkCmdCopyAccelerationStructureNV", kHookCmdCopyAccelerationStructureNV},
+    {"vkCmdTraceRaysNV", kHookCmdTraceRaysNV},
+    {"vkCreateRayTracingPipelinesNV", kHookCreateRayTracingPipelinesNV},
+    {"vkGetRayTracingShaderGroupHandlesKHR", kHookGetRayTracingShaderGroupHandlesKHR},
+    {"vkGetRayTracingShaderGroupHandlesNV", kHookGetRayTracingShaderGroupHandlesNV},
+    {"vkGetAccelerationStructureHandleNV", kHookGetAccelerationStructureHandleNV},
+    {"vkCmdWriteAccelerationStructuresPropertiesNV", kHookCmdWriteAccelerationStructuresPropertiesNV},
+    {"vkCompileDeferredNV", kHookCompileDeferredNV},
+    {"vkGetMemoryHostPointerPropertiesEXT", kHookGetMemoryHostPointerPropertiesEXT},
+    {"vkCmdWriteBufferMarkerAMD", kHookCmdWriteBufferMarkerAMD},
+    {"vkGetPhysicalDeviceCalibrateableTimeDomainsEXT", kHookGetPhysicalDeviceCalibrateableTimeDomainsEXT},
+    {"vkGetCalibratedTimestampsEXT", kHookGetCalibratedTimestampsEXT},
+    {"vkCmdDrawMeshTasksNV", kHookCmdDrawMeshTasksNV},
+    {"vkCmdDrawMeshTasksIndirectNV", kHookCmdDrawMeshTasksIndirectNV},
+    {"vkCmdDrawMeshTasksIndirectCountNV", kHookCmdDrawMeshTasksIndirectCountNV},
+    {"vkCmdSetExclusiveScissorNV", kHookCmdSetExclusiveScissorNV},
+    {"vkCmdSetCheckpointNV", kHookCmdSetCheckpointNV},
+    {"vkGetQueueCheckpointDataNV", kHookGetQueueCheckpointDataNV},
+    {"vkInitializePerformanceApiINTEL", kHookInitializePerformanceApiINTEL},
+    {"vkUninitializePerformanceApiINTEL", kHookUninitializePerformanceApiINTEL},
+    {"vkCmdSetPerformanceMarkerINTEL", kHookCmdSetPerformanceMarkerINTEL},
+    {"vkCmdSetPerformanceStreamMarkerINTEL", kHookCmdSetPerformanceStreamMarkerINTEL},
+    {"vkCmdSetPerformanceOverrideINTEL", kHookCmdSetPerformanceOverrideINTEL},
+    {"vkAcquirePerformanceConfigurationINTEL", kHookAcquirePerformanceConfigurationINTEL},
+    {"vkReleasePerformanceConfigurationINTEL", kHookReleasePerformanceConfigurationINTEL},
+    {"vkQueueSetPerformanceConfigurationINTEL", kHookQueueSetPerformanceConfigurationINTEL},
+    {"vkGetPerformanceParameterINTEL", kHookGetPerformanceParameterINTEL},
+    {"vkSetLocalDimmingAMD", kHookSetLocalDimmingAMD},
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"vkCreateImagePipeSurfaceFUCHSIA", kHookCreateImagePipeSurfaceFUCHSIA},
+#endif
+#ifdef VK_USE_PLATFORM_METAL_EXT
+    {"vkCreateMetalSurfaceEXT", kHookCreateMetalSurfaceEXT},
+#endif
+    {"vkGetBufferDeviceAddressEXT", kHookGetBufferDeviceAddressEXT},
+    {"vkGetPhysicalDeviceToolPropertiesEXT", kHookGetPhysicalDeviceToolPropertiesEXT},
+    {"vkGetPhysicalDeviceCooperativeMatrixPropertiesNV", kHookGetPhysicalDeviceCooperativeMatrixPropertiesNV},
+    {"vkGetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV", kHookGetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV},
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkGetPhysicalDeviceSurfacePresentModes2EXT", kHookGetPhysicalDeviceSurfacePresentModes2EXT},
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkAcquireFullScreenExclusiveModeEXT", kHookAcquireFullScreenExclusiveModeEXT},
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkReleaseFullScreenExclusiveModeEXT", kHookReleaseFullScreenExclusiveModeEXT},
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkGetDeviceGroupSurfacePresentModes2EXT", kHookGetDeviceGroupSurfacePresentModes2EXT},
+#endif
+    {"vkCreateHeadlessSurfaceEXT", kHookCreateHeadlessSurfaceEXT},
+    {"vkCmdSetLineStippleEXT", kHookCmdSetLineStippleEXT},
+    {"vkResetQueryPoolEXT", kHookResetQueryPoolEXT},
+    {"vkCmdSetCullModeEXT", kHookCmdSetCullModeEXT},
+    {"vkCmdSetFrontFaceEXT", kHookCmdSetFrontFaceEXT},
+    {"vkCmdSetPrimitiveTopologyEXT", kHookCmdSetPrimitiveTopologyEXT},
+    {"vkCmdSetViewportWithCountEXT", kHookCmdSetViewportWithCountEXT},
+    {"vkCmdSetScissorWithCountEXT", kHookCmdSetScissorWithCountEXT},
+    {"vkCmdBindVertexBuffers2EXT", kHookCmdBindVertexBuffers2EXT},
+    {"vkCmdSetDepthTestEnableEXT", kHookCmdSetDepthTestEnableEXT},
+    {"vkCmdSetDepthWriteEnableEXT", kHookCmdSetDepthWriteEnableEXT},
+    {"vkCmdSetDepthCompareOpEXT", kHookCmdSetDepthCompareOpEXT},
+    {"vkCmdSetDepthBoundsTestEnableEXT", kHookCmdSetDepthBoundsTestEnableEXT},
+    {"vkCmdSetStencilTestEnableEXT", kHookCmdSetStencilTestEnableEXT},
+    {"vkCmdSetStencilOpEXT", kHookCmdSetStencilOpEXT},
+    {"vkGetGeneratedCommandsMemoryRequirementsNV", kHookGetGeneratedCommandsMemoryRequirementsNV},
+    {"vkCmdPreprocessGeneratedCommandsNV", kHookCmdPreprocessGeneratedCommandsNV},
+    {"vkCmdExecuteGeneratedCommandsNV", kHookCmdExecuteGeneratedCommandsNV},
+    {"vkCmdBindPipelineShaderGroupNV", kHookCmdBindPipelineShaderGroupNV},
+    {"vkCreateIndirectCommandsLayoutNV", kHookCreateIndirectCommandsLayoutNV},
+    {"vkDestroyIndirectCommandsLayoutNV", kHookDestroyIndirectCommandsLayoutNV},
+    {"vkAcquireDrmDisplayEXT", kHookAcquireDrmDisplayEXT},
+    {"vkGetDrmDisplayEXT", kHookGetDrmDisplayEXT},
+    {"vkCreatePrivateDataSlotEXT", kHookCreatePrivateDataSlotEXT},
+    {"vkDestroyPrivateDataSlotEXT", kHookDestroyPrivateDataSlotEXT},
+    {"vkSetPrivateDataEXT", kHookSetPrivateDataEXT},
+    {"vkGetPrivateDataEXT", kHookGetPrivateDataEXT},
+    {"vkCmdSetFragmentShadingRateEnumNV", kHookCmdSetFragmentShadingRateEnumNV},
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkAcquireWinrtDisplayNV", kHookAcquireWinrtDisplayNV},
+#endif
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"vkGetWinrtDisplayNV", kHookGetWinrtDisplayNV},
+#endif
+#ifdef VK_USE_PLATFORM_DIRECTFB_EXT
+    {"vkCreateDirectFBSurfaceEXT", kHookCreateDirectFBSurfaceEXT},
+#endif
+#ifdef VK_USE_PLATFORM_DIRECTFB_EXT
+    {"vkGetPhysicalDeviceDirectFBPresentationSupportEXT", kHookGetPhysicalDeviceDirectFBPresentationSupportEXT},
+#endif
+    {"vkCmdSetVertexInputEXT", kHookCmdSetVertexInputEXT},
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"vkGetMemoryZirconHandleFUCHSIA", kHookGetMemoryZirconHandleFUCHSIA},
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"vkGetMemoryZirconHandlePropertiesFUCHSIA", kHookGetMemoryZirconHandlePropertiesFUCHSIA},
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"vkImportSemaphoreZirconHandleFUCHSIA", kHookImportSemaphoreZirconHandleFUCHSIA},
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"vkGetSemaphoreZirconHandleFUCHSIA", kHookGetSemaphoreZirconHandleFUCHSIA},
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"vkCreateBufferCollectionFUCHSIA", kHookCreateBufferCollectionFUCHSIA},
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"vkSetBufferCollectionImageConstraintsFUCHSIA", kHookSetBufferCollectionImageConstraintsFUCHSIA},
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"vkSetBufferCollectionBufferConstraintsFUCHSIA", kHookSetBufferCollectionBufferConstraintsFUCHSIA},
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"vkDestroyBufferCollectionFUCHSIA", kHookDestroyBufferCollectionFUCHSIA},
+#endif
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"vkGetBufferCollectionPropertiesFUCHSIA", kHookGetBufferCollectionPropertiesFUCHSIA},
+#endif
+    {"vkGetDeviceSubpassShadingMaxWorkgroupSizeHUAWEI", kHookGetDeviceSubpassShadingMaxWorkgroupSizeHUAWEI},
+    {"vkCmdSubpassShadingHUAWEI", kHookCmdSubpassShadingHUAWEI},
+    {"vkCmdBindInvocationMaskHUAWEI", kHookCmdBindInvocationMaskHUAWEI},
+    {"vkGetMemoryRemoteAddressNV", kHookGetMemoryRemoteAddressNV},
+    {"vkCmdSetPatchControlPointsEXT", kHookCmdSetPatchControlPointsEXT},
+    {"vkCmdSetRasterizerDiscardEnableEXT", kHookCmdSetRasterizerDiscardEnableEXT},
+    {"vkCmdSetDepthBiasEnableEXT", kHookCmdSetDepthBiasEnableEXT},
+    {"vkCmdSetLogicOpEXT", kHookCmdSetLogicOpEXT},
+    {"vkCmdSetPrimitiveRestartEnableEXT", kHookCmdSetPrimitiveRestartEnableEXT},
+#ifdef VK_USE_PLATFORM_SCREEN_QNX
+    {"vkCreateScreenSurfaceQNX", kHookCreateScreenSurfaceQNX},
+#endif
+#ifdef VK_USE_PLATFORM_SCREEN_QNX
+    {"vkGetPhysicalDeviceScreenPresentationSupportQNX", kHookGetPhysicalDeviceScreenPresentationSupportQNX},
+#endif
+    {"vkCmdSetColorWriteEnableEXT", kHookCmdSetColorWriteEnableEXT},
+    {"vkCmdDrawMultiEXT", kHookCmdDrawMultiEXT},
+    {"vkCmdDrawMultiIndexedEXT", kHookCmdDrawMultiIndexedEXT},
+    {"vkSetDeviceMemoryPriorityEXT", kHookSetDeviceMemoryPriorityEXT},
+    {"vkCreateAccelerationStructureKHR", kHookCreateAccelerationStructureKHR},
+    {"vkDestroyAccelerationStructureKHR", kHookDestroyAccelerationStructureKHR},
+    {"vkCmdBuildAccelerationStructuresKHR", kHookCmdBuildAccelerationStructuresKHR},
+    {"vkCmdBuildAccelerationStructuresIndirectKHR", kHookCmdBuildAccelerationStructuresIndirectKHR},
+    {"vkBuildAccelerationStructuresKHR", kHookBuildAccelerationStructuresKHR},
+    {"vkCopyAccelerationStructureKHR", kHookCopyAccelerationStructureKHR},
+    {"vkCopyAccelerationStructureToMemoryKHR", kHookCopyAccelerationStructureToMemoryKHR},
+    {"vkCopyMemoryToAccelerationStructureKHR", kHookCopyMemoryToAccelerationStructureKHR},
+    {"vkWriteAccelerationStructuresPropertiesKHR", kHookWriteAccelerationStructuresPropertiesKHR},
+    {"vkCmdCopyAccelerationStructureKHR", kHookCmdCopyAccelerationStructureKHR},
+    {"vkCmdCopyAccelerationStructureToMemoryKHR", kHookCmdCopyAccelerationStructureToMemoryKHR},
+    {"vkCmdCopyMemoryToAccelerationStructureKHR", kHookCmdCopyMemoryToAccelerationStructureKHR},
+    {"vkGetAccelerationStructureDeviceAddressKHR", kHookGetAccelerationStructureDeviceAddressKHR},
+    {"vkCmdWriteAccelerationStructuresPropertiesKHR", kHookCmdWriteAccelerationStructuresPropertiesKHR},
+    {"vkGetDeviceAccelerationStructureCompatibilityKHR", kHookGetDeviceAccelerationStructureCompatibilityKHR},
+    {"vkGetAccelerationStructureBuildSizesKHR", kHookGetAccelerationStructureBuildSizesKHR},
+    {"vkCmdTraceRaysKHR", kHookCmdTraceRaysKHR},
+    {"vkCreateRayTracingPipelinesKHR", kHookCreateRayTracingPipelinesKHR},
+    {"vkGetRayTracingCaptureReplayShaderGroupHandlesKHR", kHookGetRayTracingCaptureReplayShaderGroupHandlesKHR},
+    {"vkCmdTraceRaysIndirectKHR", kHookCmdTraceRaysIndirectKHR},
+    {"vkGetRayTracingShaderGroupStackSizeKHR", kHookGetRayTracingShaderGroupStackSizeKHR},
+    {"vkCmdSetRayTracingPipelineStackSizeKHR", kHookCmdSetRayTracingPipelineStackSizeKHR},
+};
+
 // Map of all APIs to be intercepted by this layer
 static const std::unordered_map<std::string, void*> name_to_funcptr_map = {
     {"vkCreateInstance", (void*)CreateInstance},
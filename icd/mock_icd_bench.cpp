@@ -0,0 +1,559 @@
+/*
+ * Copyright (c) 2015-2021 The Khronos Group Inc.
+ * Copyright (c) 2015-2021 Valve Corporation
+ * Copyright (c) 2015-2021 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Microbenchmarks of the mock ICD's own overhead. The ICD library is loaded directly and driven through
+// vk_icdGetInstanceProcAddr without a loader in between, so the numbers only contain time spent inside the mock.
+//
+// Every benchmark runs at 1, 2, 4, ... up to --threads threads. Each thread does its setup, waits for all other threads,
+// then runs --iterations operations; the run time is that of the slowest thread. Results are printed as JSON (default) or
+// CSV so that runs against different versions of the mock can be compared by scripts.
+
+#include <vulkan/vulkan.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef MOCK_ICD_BENCH_LIBRARY
+#if defined(_WIN32)
+#define MOCK_ICD_BENCH_LIBRARY "VkICD_mock_icd.dll"
+#elif defined(__APPLE__)
+#define MOCK_ICD_BENCH_LIBRARY "libVkICD_mock_icd.dylib"
+#else
+#define MOCK_ICD_BENCH_LIBRARY "libVkICD_mock_icd.so"
+#endif
+#endif
+
+typedef VkResult(VKAPI_PTR *PFN_NegotiateLoaderICDInterfaceVersion)(uint32_t *pSupportedVersion);
+typedef PFN_vkVoidFunction(VKAPI_PTR *PFN_GetInstanceProcAddr)(VkInstance instance, const char *pName);
+
+#define BENCH_CHECK(expr)                                                                               \
+    do {                                                                                                \
+        VkResult bench_check_result = (expr);                                                           \
+        if (bench_check_result != VK_SUCCESS) {                                                         \
+            fprintf(stderr, "%s:%d: %s returned %d\n", __FILE__, __LINE__, #expr, bench_check_result); \
+            exit(1);                                                                                    \
+        }                                                                                               \
+    } while (0)
+
+struct BenchOptions {
+    std::string library = MOCK_ICD_BENCH_LIBRARY;
+    uint32_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t iterations = 20000;
+    std::string filter;
+    bool csv = false;
+};
+
+struct BenchResult {
+    std::string name;
+    uint32_t threads;
+    uint64_t operations;
+    double seconds;
+};
+
+// Entry points of the mock ICD used by the benchmarks
+struct MockIcd {
+#if defined(_WIN32)
+    HMODULE library = nullptr;
+#else
+    void *library = nullptr;
+#endif
+    PFN_GetInstanceProcAddr GetInstanceProcAddr = nullptr;
+    VkInstance instance = VK_NULL_HANDLE;
+    VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+    uint32_t host_visible_memory_type = 0;  // First host visible and coherent memory type, which benchmarks map
+
+    PFN_vkCreateInstance fp_vkCreateInstance = nullptr;
+    PFN_vkDestroyInstance fp_vkDestroyInstance = nullptr;
+    PFN_vkEnumeratePhysicalDevices fp_vkEnumeratePhysicalDevices = nullptr;
+    PFN_vkGetPhysicalDeviceMemoryProperties fp_vkGetPhysicalDeviceMemoryProperties = nullptr;
+    PFN_vkCreateDevice fp_vkCreateDevice = nullptr;
+    PFN_vkGetDeviceProcAddr fp_vkGetDeviceProcAddr = nullptr;
+    PFN_vkDestroyDevice fp_vkDestroyDevice = nullptr;
+    PFN_vkGetDeviceQueue fp_vkGetDeviceQueue = nullptr;
+    PFN_vkCreateBuffer fp_vkCreateBuffer = nullptr;
+    PFN_vkDestroyBuffer fp_vkDestroyBuffer = nullptr;
+    PFN_vkCreateImage fp_vkCreateImage = nullptr;
+    PFN_vkDestroyImage fp_vkDestroyImage = nullptr;
+    PFN_vkCreateFence fp_vkCreateFence = nullptr;
+    PFN_vkDestroyFence fp_vkDestroyFence = nullptr;
+    PFN_vkCreateSemaphore fp_vkCreateSemaphore = nullptr;
+    PFN_vkDestroySemaphore fp_vkDestroySemaphore = nullptr;
+    PFN_vkCreateEvent fp_vkCreateEvent = nullptr;
+    PFN_vkDestroyEvent fp_vkDestroyEvent = nullptr;
+    PFN_vkCreateSampler fp_vkCreateSampler = nullptr;
+    PFN_vkDestroySampler fp_vkDestroySampler = nullptr;
+    PFN_vkCreateShaderModule fp_vkCreateShaderModule = nullptr;
+    PFN_vkDestroyShaderModule fp_vkDestroyShaderModule = nullptr;
+    PFN_vkCreateCommandPool fp_vkCreateCommandPool = nullptr;
+    PFN_vkDestroyCommandPool fp_vkDestroyCommandPool = nullptr;
+    PFN_vkAllocateCommandBuffers fp_vkAllocateCommandBuffers = nullptr;
+    PFN_vkAllocateMemory fp_vkAllocateMemory = nullptr;
+    PFN_vkFreeMemory fp_vkFreeMemory = nullptr;
+    PFN_vkMapMemory fp_vkMapMemory = nullptr;
+    PFN_vkUnmapMemory fp_vkUnmapMemory = nullptr;
+    PFN_vkQueueSubmit fp_vkQueueSubmit = nullptr;
+
+    template <typename T>
+    void LoadInstance(T &func_dest, const char *func_name) {
+        func_dest = reinterpret_cast<T>(GetInstanceProcAddr(instance, func_name));
+        if (!func_dest) {
+            fprintf(stderr, "mock ICD does not expose %s\n", func_name);
+            exit(1);
+        }
+    }
+    template <typename T>
+    void LoadDevice(VkDevice device, T &func_dest, const char *func_name) {
+        func_dest = reinterpret_cast<T>(fp_vkGetDeviceProcAddr(device, func_name));
+        if (!func_dest) {
+            fprintf(stderr, "mock ICD does not expose %s\n", func_name);
+            exit(1);
+        }
+    }
+
+    void Initialize(const std::string &path) {
+#if defined(_WIN32)
+        library = LoadLibraryA(path.c_str());
+        if (library) {
+            GetInstanceProcAddr = reinterpret_cast<PFN_GetInstanceProcAddr>(GetProcAddress(library, "vk_icdGetInstanceProcAddr"));
+        }
+        auto negotiate = library ? reinterpret_cast<PFN_NegotiateLoaderICDInterfaceVersion>(
+                                       GetProcAddress(library, "vk_icdNegotiateLoaderICDInterfaceVersion"))
+                                 : nullptr;
+#else
+        library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (library) {
+            GetInstanceProcAddr = reinterpret_cast<PFN_GetInstanceProcAddr>(dlsym(library, "vk_icdGetInstanceProcAddr"));
+        }
+        auto negotiate = library ? reinterpret_cast<PFN_NegotiateLoaderICDInterfaceVersion>(
+                                       dlsym(library, "vk_icdNegotiateLoaderICDInterfaceVersion"))
+                                 : nullptr;
+#endif
+        if (!GetInstanceProcAddr) {
+            fprintf(stderr, "failed to load vk_icdGetInstanceProcAddr from %s\n", path.c_str());
+            exit(1);
+        }
+        if (negotiate) {
+            uint32_t version = 5;
+            negotiate(&version);
+        }
+
+        LoadInstance(fp_vkCreateInstance, "vkCreateInstance");
+        VkApplicationInfo app_info = {};
+        app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        app_info.pApplicationName = "mock_icd_bench";
+        app_info.apiVersion = VK_API_VERSION_1_2;
+        VkInstanceCreateInfo instance_info = {};
+        instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        instance_info.pApplicationInfo = &app_info;
+        BENCH_CHECK(fp_vkCreateInstance(&instance_info, nullptr, &instance));
+
+        LoadInstance(fp_vkDestroyInstance, "vkDestroyInstance");
+        LoadInstance(fp_vkEnumeratePhysicalDevices, "vkEnumeratePhysicalDevices");
+        LoadInstance(fp_vkCreateDevice, "vkCreateDevice");
+        LoadInstance(fp_vkGetDeviceProcAddr, "vkGetDeviceProcAddr");
+        LoadInstance(fp_vkGetPhysicalDeviceMemoryProperties, "vkGetPhysicalDeviceMemoryProperties");
+        uint32_t count = 1;
+        BENCH_CHECK(fp_vkEnumeratePhysicalDevices(instance, &count, &physical_device));
+        VkPhysicalDeviceMemoryProperties memory_properties;
+        fp_vkGetPhysicalDeviceMemoryProperties(physical_device, &memory_properties);
+        const VkMemoryPropertyFlags host_visible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        while (host_visible_memory_type < memory_properties.memoryTypeCount &&
+               (memory_properties.memoryTypes[host_visible_memory_type].propertyFlags & host_visible) != host_visible) {
+            ++host_visible_memory_type;
+        }
+        if (host_visible_memory_type == memory_properties.memoryTypeCount) {
+            fprintf(stderr, "mock ICD has no host visible memory type\n");
+            exit(1);
+        }
+
+        // Device level entry points are the same for every device, so resolve them once against a temporary device
+        VkDevice device = NewDevice();
+        LoadDevice(device, fp_vkDestroyDevice, "vkDestroyDevice");
+        LoadDevice(device, fp_vkGetDeviceQueue, "vkGetDeviceQueue");
+        LoadDevice(device, fp_vkCreateBuffer, "vkCreateBuffer");
+        LoadDevice(device, fp_vkDestroyBuffer, "vkDestroyBuffer");
+        LoadDevice(device, fp_vkCreateImage, "vkCreateImage");
+        LoadDevice(device, fp_vkDestroyImage, "vkDestroyImage");
+        LoadDevice(device, fp_vkCreateFence, "vkCreateFence");
+        LoadDevice(device, fp_vkDestroyFence, "vkDestroyFence");
+        LoadDevice(device, fp_vkCreateSemaphore, "vkCreateSemaphore");
+        LoadDevice(device, fp_vkDestroySemaphore, "vkDestroySemaphore");
+        LoadDevice(device, fp_vkCreateEvent, "vkCreateEvent");
+        LoadDevice(device, fp_vkDestroyEvent, "vkDestroyEvent");
+        LoadDevice(device, fp_vkCreateSampler, "vkCreateSampler");
+        LoadDevice(device, fp_vkDestroySampler, "vkDestroySampler");
+        LoadDevice(device, fp_vkCreateShaderModule, "vkCreateShaderModule");
+        LoadDevice(device, fp_vkDestroyShaderModule, "vkDestroyShaderModule");
+        LoadDevice(device, fp_vkCreateCommandPool, "vkCreateCommandPool");
+        LoadDevice(device, fp_vkDestroyCommandPool, "vkDestroyCommandPool");
+        LoadDevice(device, fp_vkAllocateCommandBuffers, "vkAllocateCommandBuffers");
+        LoadDevice(device, fp_vkAllocateMemory, "vkAllocateMemory");
+        LoadDevice(device, fp_vkFreeMemory, "vkFreeMemory");
+        LoadDevice(device, fp_vkMapMemory, "vkMapMemory");
+        LoadDevice(device, fp_vkUnmapMemory, "vkUnmapMemory");
+        LoadDevice(device, fp_vkQueueSubmit, "vkQueueSubmit");
+        fp_vkDestroyDevice(device, nullptr);
+    }
+
+    void Close() {
+        fp_vkDestroyInstance(instance, nullptr);
+#if defined(_WIN32)
+        FreeLibrary(library);
+#else
+        dlclose(library);
+#endif
+    }
+
+    VkDevice NewDevice() {
+        const float priority = 1.0f;
+        VkDeviceQueueCreateInfo queue_info = {};
+        queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queue_info.queueFamilyIndex = 0;
+        queue_info.queueCount = 1;
+        queue_info.pQueuePriorities = &priority;
+        VkDeviceCreateInfo device_info = {};
+        device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        device_info.queueCreateInfoCount = 1;
+        device_info.pQueueCreateInfos = &queue_info;
+        VkDevice device = VK_NULL_HANDLE;
+        BENCH_CHECK(fp_vkCreateDevice(physical_device, &device_info, nullptr, &device));
+        return device;
+    }
+};
+
+// A benchmark is a per-thread body run for a number of iterations. Per-thread state is created and released by the body
+// itself: everything before the call to |start| and after it returns is excluded from the measurement.
+typedef std::function<void(uint64_t iterations, const std::function<void()> &start, std::chrono::steady_clock::duration &elapsed)>
+    BenchBody;
+
+// Measures |body| run the given number of iterations on each of |threads| threads
+static BenchResult RunBenchmark(const std::string &name, uint32_t threads, uint64_t iterations, const BenchBody &body) {
+    std::mutex mutex;
+    std::condition_variable ready_cv;
+    std::condition_variable start_cv;
+    uint32_t ready = 0;
+    bool go = false;
+    std::vector<std::chrono::steady_clock::duration> elapsed(threads);
+    std::vector<std::thread> workers;
+    for (uint32_t i = 0; i < threads; ++i) {
+        workers.emplace_back([&, i]() {
+            const std::function<void()> start = [&]() {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (++ready == threads) ready_cv.notify_one();
+                start_cv.wait(lock, [&]() { return go; });
+            };
+            body(iterations, start, elapsed[i]);
+        });
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready_cv.wait(lock, [&]() { return ready == threads; });
+        go = true;
+    }
+    start_cv.notify_all();
+    for (auto &worker : workers) worker.join();
+
+    const auto slowest = *std::max_element(elapsed.begin(), elapsed.end());
+    BenchResult result;
+    result.name = name;
+    result.threads = threads;
+    result.operations = iterations * threads;
+    result.seconds = std::chrono::duration<double>(slowest).count();
+    return result;
+}
+
+// Times |op| between the start barrier and the end of the loop
+template <typename Op>
+static void TimedLoop(uint64_t iterations, const std::function<void()> &start, std::chrono::steady_clock::duration &elapsed, Op op) {
+    start();
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) op(i);
+    elapsed = std::chrono::steady_clock::now() - begin;
+}
+
+static std::vector<std::pair<std::string, BenchBody>> MakeBenchmarks(MockIcd &icd, VkDevice device) {
+    std::vector<std::pair<std::string, BenchBody>> benchmarks;
+
+    benchmarks.emplace_back("create_destroy/buffer", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                     std::chrono::steady_clock::duration &elapsed) {
+        VkBufferCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        info.size = 4096;
+        info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        TimedLoop(n, start, elapsed, [&](uint64_t) {
+            VkBuffer buffer;
+            BENCH_CHECK(icd.fp_vkCreateBuffer(device, &info, nullptr, &buffer));
+            icd.fp_vkDestroyBuffer(device, buffer, nullptr);
+        });
+    });
+    benchmarks.emplace_back("create_destroy/image", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                    std::chrono::steady_clock::duration &elapsed) {
+        VkImageCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        info.imageType = VK_IMAGE_TYPE_2D;
+        info.format = VK_FORMAT_R8G8B8A8_UNORM;
+        info.extent = {256, 256, 1};
+        info.mipLevels = 1;
+        info.arrayLayers = 1;
+        info.samples = VK_SAMPLE_COUNT_1_BIT;
+        info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        info.usage = VK_IMAGE_USAGE_SAMPLED_BIT;
+        info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        TimedLoop(n, start, elapsed, [&](uint64_t) {
+            VkImage image;
+            BENCH_CHECK(icd.fp_vkCreateImage(device, &info, nullptr, &image));
+            icd.fp_vkDestroyImage(device, image, nullptr);
+        });
+    });
+    benchmarks.emplace_back("create_destroy/fence", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                    std::chrono::steady_clock::duration &elapsed) {
+        VkFenceCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        TimedLoop(n, start, elapsed, [&](uint64_t) {
+            VkFence fence;
+            BENCH_CHECK(icd.fp_vkCreateFence(device, &info, nullptr, &fence));
+            icd.fp_vkDestroyFence(device, fence, nullptr);
+        });
+    });
+    benchmarks.emplace_back("create_destroy/semaphore", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                        std::chrono::steady_clock::duration &elapsed) {
+        VkSemaphoreCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        TimedLoop(n, start, elapsed, [&](uint64_t) {
+            VkSemaphore semaphore;
+            BENCH_CHECK(icd.fp_vkCreateSemaphore(device, &info, nullptr, &semaphore));
+            icd.fp_vkDestroySemaphore(device, semaphore, nullptr);
+        });
+    });
+    benchmarks.emplace_back("create_destroy/event", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                    std::chrono::steady_clock::duration &elapsed) {
+        VkEventCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+        TimedLoop(n, start, elapsed, [&](uint64_t) {
+            VkEvent event;
+            BENCH_CHECK(icd.fp_vkCreateEvent(device, &info, nullptr, &event));
+            icd.fp_vkDestroyEvent(device, event, nullptr);
+        });
+    });
+    benchmarks.emplace_back("create_destroy/sampler", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                      std::chrono::steady_clock::duration &elapsed) {
+        VkSamplerCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        info.magFilter = VK_FILTER_LINEAR;
+        info.minFilter = VK_FILTER_LINEAR;
+        info.maxLod = 1.0f;
+        TimedLoop(n, start, elapsed, [&](uint64_t) {
+            VkSampler sampler;
+            BENCH_CHECK(icd.fp_vkCreateSampler(device, &info, nullptr, &sampler));
+            icd.fp_vkDestroySampler(device, sampler, nullptr);
+        });
+    });
+    benchmarks.emplace_back("create_destroy/shader_module", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                            std::chrono::steady_clock::duration &elapsed) {
+        // SPIR-V header of an empty module; the mock never parses the code
+        static const uint32_t code[] = {0x07230203, 0x00010000, 0, 1, 0};
+        VkShaderModuleCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        info.codeSize = sizeof(code);
+        info.pCode = code;
+        TimedLoop(n, start, elapsed, [&](uint64_t) {
+            VkShaderModule module;
+            BENCH_CHECK(icd.fp_vkCreateShaderModule(device, &info, nullptr, &module));
+            icd.fp_vkDestroyShaderModule(device, module, nullptr);
+        });
+    });
+    benchmarks.emplace_back("create_destroy/command_pool", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                           std::chrono::steady_clock::duration &elapsed) {
+        VkCommandPoolCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        TimedLoop(n, start, elapsed, [&](uint64_t) {
+            VkCommandPool pool;
+            BENCH_CHECK(icd.fp_vkCreateCommandPool(device, &info, nullptr, &pool));
+            icd.fp_vkDestroyCommandPool(device, pool, nullptr);
+        });
+    });
+    benchmarks.emplace_back("memory/allocate_free", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                    std::chrono::steady_clock::duration &elapsed) {
+        VkMemoryAllocateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        info.allocationSize = 65536;
+        info.memoryTypeIndex = icd.host_visible_memory_type;
+        TimedLoop(n, start, elapsed, [&](uint64_t) {
+            VkDeviceMemory memory;
+            BENCH_CHECK(icd.fp_vkAllocateMemory(device, &info, nullptr, &memory));
+            icd.fp_vkFreeMemory(device, memory, nullptr);
+        });
+    });
+    benchmarks.emplace_back("memory/map_unmap", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                std::chrono::steady_clock::duration &elapsed) {
+        VkMemoryAllocateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        info.allocationSize = 65536;
+        info.memoryTypeIndex = icd.host_visible_memory_type;
+        VkDeviceMemory memory;
+        BENCH_CHECK(icd.fp_vkAllocateMemory(device, &info, nullptr, &memory));
+        TimedLoop(n, start, elapsed, [&](uint64_t) {
+            void *data;
+            BENCH_CHECK(icd.fp_vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &data));
+            icd.fp_vkUnmapMemory(device, memory);
+        });
+        icd.fp_vkFreeMemory(device, memory, nullptr);
+    });
+    benchmarks.emplace_back("get_device_proc_addr", [&icd, device](uint64_t n, const std::function<void()> &start,
+                                                                    std::chrono::steady_clock::duration &elapsed) {
+        static const char *const names[] = {"vkCmdDraw",         "vkCmdBindPipeline",   "vkQueueSubmit",  "vkCreateBuffer",
+                                            "vkCmdCopyBuffer",   "vkAllocateMemory",    "vkWaitForFences", "vkCmdPipelineBarrier",
+                                            "vkCmdDispatch",     "vkUpdateDescriptorSets", "vkCmdBeginRenderPass", "vkNotAFunction"};
+        const uint64_t name_count = sizeof(names) / sizeof(names[0]);
+        TimedLoop(n, start, elapsed, [&](uint64_t i) {
+            volatile PFN_vkVoidFunction function = icd.fp_vkGetDeviceProcAddr(device, names[i % name_count]);
+            (void)function;
+        });
+    });
+    benchmarks.emplace_back("queue_submit", [&icd](uint64_t n, const std::function<void()> &start,
+                                                   std::chrono::steady_clock::duration &elapsed) {
+        // Queues require external synchronization and the mock exposes a single queue per device, so every thread
+        // submits to a queue of its own device
+        VkDevice thread_device = icd.NewDevice();
+        VkQueue queue;
+        icd.fp_vkGetDeviceQueue(thread_device, 0, 0, &queue);
+        VkCommandPoolCreateInfo pool_info = {};
+        pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        VkCommandPool pool;
+        BENCH_CHECK(icd.fp_vkCreateCommandPool(thread_device, &pool_info, nullptr, &pool));
+        VkCommandBufferAllocateInfo command_buffer_info = {};
+        command_buffer_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        command_buffer_info.commandPool = pool;
+        command_buffer_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        command_buffer_info.commandBufferCount = 1;
+        VkCommandBuffer command_buffer;
+        BENCH_CHECK(icd.fp_vkAllocateCommandBuffers(thread_device, &command_buffer_info, &command_buffer));
+        VkSubmitInfo submit_info = {};
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = &command_buffer;
+        TimedLoop(n, start, elapsed, [&](uint64_t) { BENCH_CHECK(icd.fp_vkQueueSubmit(queue, 1, &submit_info, VK_NULL_HANDLE)); });
+        icd.fp_vkDestroyCommandPool(thread_device, pool, nullptr);
+        icd.fp_vkDestroyDevice(thread_device, nullptr);
+    });
+    return benchmarks;
+}
+
+static void PrintResults(const BenchOptions &options, const std::vector<BenchResult> &results) {
+    if (options.csv) {
+        printf("benchmark,threads,operations,seconds,ops_per_second,ns_per_op\n");
+        for (const auto &r : results) {
+            printf("%s,%u,%llu,%.9f,%.1f,%.1f\n", r.name.c_str(), r.threads, static_cast<unsigned long long>(r.operations),
+                   r.seconds, r.operations / r.seconds, r.seconds * 1e9 * r.threads / r.operations);
+        }
+        return;
+    }
+    printf("{\n");
+    printf("    \"library\": \"");
+    for (char c : options.library) {
+        if (c == '"' || c == '\\') putchar('\\');
+        putchar(c);
+    }
+    printf("\",\n");
+    printf("    \"iterations\": %llu,\n", static_cast<unsigned long long>(options.iterations));
+    printf("    \"results\": [");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto &r = results[i];
+        printf("%s\n        {\"benchmark\": \"%s\", \"threads\": %u, \"operations\": %llu, \"seconds\": %.9f, "
+               "\"ops_per_second\": %.1f, \"ns_per_op\": %.1f}",
+               i ? "," : "", r.name.c_str(), r.threads, static_cast<unsigned long long>(r.operations), r.seconds,
+               r.operations / r.seconds, r.seconds * 1e9 * r.threads / r.operations);
+    }
+    printf("\n    ]\n}\n");
+}
+
+static void PrintUsage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --library <path>     Mock ICD library to load (default: %s)\n"
+            "  --threads <n>        Highest thread count to run; counts are 1, 2, 4, ... n (default: hardware threads)\n"
+            "  --iterations <n>     Operations per thread per run (default: 20000)\n"
+            "  --filter <text>      Only run benchmarks whose name contains <text>\n"
+            "  --format json|csv    Output format (default: json)\n",
+            argv0, MOCK_ICD_BENCH_LIBRARY);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--library" && has_value) {
+            options.library = argv[++i];
+        } else if (arg == "--threads" && has_value) {
+            options.max_threads = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--iterations" && has_value) {
+            options.iterations = std::max(1ull, strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--format" && has_value) {
+            const std::string format = argv[++i];
+            if (format != "json" && format != "csv") {
+                PrintUsage(argv[0]);
+                return 1;
+            }
+            options.csv = format == "csv";
+        } else {
+            PrintUsage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    std::vector<uint32_t> thread_counts;
+    for (uint32_t threads = 1; threads < options.max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(options.max_threads);
+
+    MockIcd icd;
+    icd.Initialize(options.library);
+    VkDevice device = icd.NewDevice();
+
+    std::vector<BenchResult> results;
+    for (const auto &benchmark : MakeBenchmarks(icd, device)) {
+        if (benchmark.first.find(options.filter) == std::string::npos) continue;
+        for (uint32_t threads : thread_counts) {
+            results.push_back(RunBenchmark(benchmark.first, threads, options.iterations, benchmark.second));
+        }
+    }
+
+    icd.fp_vkDestroyDevice(device, nullptr);
+    icd.Close();
+    PrintResults(options, results);
+    return 0;
+}
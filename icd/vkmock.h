@@ -0,0 +1,154 @@
+/*
+** Copyright (c) 2015-2018 The Khronos Group Inc.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+
+/*
+** Debug entry points exported by the mock ICD in addition to the loader interface. They are not reachable through
+** vkGetInstanceProcAddr; tests look them up from the VkICD_mock_icd library directly (dlsym or GetProcAddress).
+*/
+
+#ifndef VKMOCK_H_
+#define VKMOCK_H_ 1
+
+#include <vulkan/vulkan.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Resolves a byte offset of a sparse buffer or image (for images, in the opaque layout reported by
+// vkGetImageSparseMemoryRequirements) to the memory bound there. Returns VK_FALSE if the page is not resident.
+typedef VkBool32(VKAPI_PTR* PFN_vkmock_ResolveSparseAddress)(VkDevice device, uint64_t resource, VkDeviceSize offset,
+                                                            VkDeviceMemory* pMemory, VkDeviceSize* pMemoryOffset);
+
+// Returns how many bytes of [offset, offset + size) of a sparse buffer or image are backed by memory.
+typedef VkDeviceSize(VKAPI_PTR* PFN_vkmock_GetSparseResidentSize)(VkDevice device, uint64_t resource, VkDeviceSize offset,
+                                                                 VkDeviceSize size);
+
+// Resolves a device address returned by vkGetBufferDeviceAddress to the device memory and offset it points to.
+// Device addresses are host pointers to the memory contents, so they can also be dereferenced directly.
+// Returns VK_FALSE if no memory contains the address.
+typedef VkBool32(VKAPI_PTR* PFN_vkmock_ResolveDeviceAddress)(VkDevice device, VkDeviceAddress address, VkDeviceMemory* pMemory,
+                                                            VkDeviceSize* pOffset);
+
+// Live statistics of the mock ICD. With VKMOCK_STATS set, the ICD places them in a memfd named vkmock_stats, which
+// monitors in other processes can map read-only from /proc/<pid>/fd. Each counter is updated atomically with relaxed
+// ordering; read fields with 64-bit atomic loads and expect no consistency between them. Rates such as submits per second
+// are the difference of two samples over the time between them.
+#define VKMOCK_STATS_MAGIC 0x544154534B4D4B56ULL  // "VKMKSTAT"
+#define VKMOCK_STATS_VERSION 3
+#define VKMOCK_STATS_OBJECT_TYPE_COUNT 32
+#define VKMOCK_STATS_QUEUE_COUNT 16
+
+typedef struct VkmockStats {
+    uint64_t magic;      // VKMOCK_STATS_MAGIC once the segment is initialized
+    uint64_t version;    // VKMOCK_STATS_VERSION
+    uint64_t size;       // sizeof(VkmockStats)
+    uint64_t processId;  // 0 where unknown
+    uint64_t startTimeNs;  // Monotonic clock time at which the ICD was loaded
+    // Live objects, indexed by VkObjectType for types below VKMOCK_STATS_OBJECT_TYPE_COUNT. Objects of other types
+    // count toward VK_OBJECT_TYPE_UNKNOWN.
+    uint64_t objectsAlive[VKMOCK_STATS_OBJECT_TYPE_COUNT];
+    uint64_t heapBytesAllocated[VK_MAX_MEMORY_HEAPS];
+    uint64_t submitCount;          // vkQueueSubmit and vkQueueSubmit2 calls
+    uint64_t presentCount;         // Swapchain images presented
+    uint64_t lockContentionCount;  // Times a thread blocked on an ICD mutex held by another thread
+    // Simulated GPU time, in nanoseconds, that queues spent executing batches, indexed by the order in which queues were
+    // first retrieved across all devices. Queue n adds up with queue n + VKMOCK_STATS_QUEUE_COUNT.
+    uint64_t queueBusyNs[VKMOCK_STATS_QUEUE_COUNT];
+    // Shader modules created with code identical to a live module (hits) or not (misses), and the code bytes that
+    // hits did not have to store
+    uint64_t shaderModuleCacheHits;
+    uint64_t shaderModuleCacheMisses;
+    uint64_t shaderModuleBytesSaved;
+} VkmockStats;
+
+// Returns the statistics of this process, whether or not they are published
+typedef const VkmockStats*(VKAPI_PTR* PFN_vkmock_GetStats)(void);
+
+// A pointer or array parameter of a recorded command, copied when the command was recorded. Structures are copied with
+// the arrays and strings they point to, and their pointers lead to those copies. Their pNext chains, pointers to
+// pointers and members that are only valid for some values of another member are NULL in the copy.
+typedef struct VkmockCommandArray {
+    const char* pName;     // Parameter name, such as "pRegions"
+    uint32_t count;        // Elements copied: the length the parameter is declared with, or 1 for a single structure
+    uint32_t elementSize;  // Size of an element, 1 for untyped data
+    const void* pData;     // NULL when count is 0
+} VkmockCommandArray;
+
+// A command recorded into a command buffer. The arguments are the by-value parameters of the call after commandBuffer,
+// packed in declaration order without padding. The pointer and array parameters follow as arrays, in declaration order;
+// untyped pointers without a length and pointers to pointers are not recorded. Opcodes are only meaningful within one
+// build of the ICD, names are stable. Everything a command points to is valid until the command buffer is reset, begun
+// again or freed, or its pool is reset.
+typedef struct VkmockCommand {
+    uint32_t opcode;
+    const char* pName;  // Entry point name, such as "vkCmdDraw"
+    uint32_t argsSize;
+    const void* pArgs;
+    uint32_t arrayCount;
+    const VkmockCommandArray* pArrays;
+} VkmockCommand;
+
+// Enumerates the commands recorded into a command buffer in recording order, like other Vulkan enumerations
+typedef VkResult(VKAPI_PTR* PFN_vkmock_GetRecordedCommands)(VkCommandBuffer commandBuffer, uint32_t* pCommandCount,
+                                                            VkmockCommand* pCommands);
+
+// How the buffers and images bound to a VkDeviceMemory cover it, from the ranges given to vkBindBufferMemory and
+// vkBindImageMemory and the sizes reported by the memory requirements queries.
+typedef struct VkmockMemoryBindingReport {
+    VkDeviceSize size;                  // Allocation size
+    uint32_t bindingCount;              // Buffers and images bound to the memory
+    VkDeviceSize boundBytes;            // Bytes covered by at least one binding
+    VkDeviceSize freeBytes;             // Bytes covered by none
+    uint32_t freeRangeCount;            // Maximal unbound ranges, a measure of fragmentation
+    VkDeviceSize largestFreeRange;      // Size of the largest of them
+    uint32_t aliasedBindingCount;       // Bindings overlapping at least one other binding
+    VkDeviceSize aliasedBytes;          // Bytes covered by more than one binding
+    uint32_t granularityConflictCount;  // Neighboring linear and optimal resources within one bufferImageGranularity page
+} VkmockMemoryBindingReport;
+
+// Reports the bindings of a device memory allocation. Returns VK_FALSE if the memory does not exist.
+typedef VkBool32(VKAPI_PTR* PFN_vkmock_GetMemoryBindingReport)(VkDevice device, VkDeviceMemory memory,
+                                                              VkmockMemoryBindingReport* pReport);
+
+// Overrides an entry point of the mock ICD, named like "vkQueueSubmit", with a function of the same signature; NULL
+// restores the mock implementation. The entry point calls the hook instead of its own implementation, on every thread,
+// from the next call on. While a hook runs, entry points called on the same thread skip their hooks, so a hook can wrap
+// the mock implementation by calling the entry point it overrides. Calls the ICD makes to its own entry points never
+// reach a hook, and a core entry point and its KHR alias have separate hooks. Returns VK_FALSE for names that cannot be
+// hooked: unknown ones and the loader, instance and device creation entry points.
+typedef VkBool32(VKAPI_PTR* PFN_vkmock_SetHook)(const char* pName, PFN_vkVoidFunction pfnHook);
+
+#ifndef VK_NO_PROTOTYPES
+VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_ResolveSparseAddress(VkDevice device, uint64_t resource, VkDeviceSize offset,
+                                                           VkDeviceMemory* pMemory, VkDeviceSize* pMemoryOffset);
+VKAPI_ATTR VkDeviceSize VKAPI_CALL vkmock_GetSparseResidentSize(VkDevice device, uint64_t resource, VkDeviceSize offset,
+                                                                VkDeviceSize size);
+VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_ResolveDeviceAddress(VkDevice device, VkDeviceAddress address, VkDeviceMemory* pMemory,
+                                                           VkDeviceSize* pOffset);
+VKAPI_ATTR const VkmockStats* VKAPI_CALL vkmock_GetStats(void);
+VKAPI_ATTR VkResult VKAPI_CALL vkmock_GetRecordedCommands(VkCommandBuffer commandBuffer, uint32_t* pCommandCount,
+                                                          VkmockCommand* pCommands);
+VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_GetMemoryBindingReport(VkDevice device, VkDeviceMemory memory,
+                                                             VkmockMemoryBindingReport* pReport);
+VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_SetHook(const char* pName, PFN_vkVoidFunction pfnHook);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // VKMOCK_H_
@@ -31,46 +31,2131 @@ from common_codegen import *
 
 # Mock header code
 HEADER_C_CODE = '''
-using mutex_t = std::mutex;
+// std::mutex that counts the times a thread had to wait for it, for the lock contention statistic
+static void CountLockContention();
+class mutex_t {
+  public:
+    void lock() {
+        if (mutex_.try_lock()) return;
+        CountLockContention();
+        mutex_.lock();
+    }
+    bool try_lock() { return mutex_.try_lock(); }
+    void unlock() { mutex_.unlock(); }
+
+  private:
+    std::mutex mutex_;
+};
 using lock_guard_t = std::lock_guard<mutex_t>;
 using unique_lock_t = std::unique_lock<mutex_t>;
 
-static mutex_t global_lock;
-static uint64_t global_unique_handle = 1;
-static const uint32_t SUPPORTED_LOADER_ICD_INTERFACE_VERSION = 5;
-static uint32_t loader_interface_version = 0;
-static bool negotiate_loader_icd_interface_called = false;
-static void* CreateDispObjHandle() {
-    auto handle = new VK_LOADER_DATA;
-    set_loader_magic_value(handle);
-    return handle;
+static std::atomic<uint64_t> global_unique_handle{1};
+static const uint32_t SUPPORTED_LOADER_ICD_INTERFACE_VERSION = 5;
+static uint32_t loader_interface_version = 0;
+static bool negotiate_loader_icd_interface_called = false;
+
+// Fixed-size block pool for a device's dispatchable children (queues, command buffers) when the application
+// supplies no VkAllocationCallbacks. Freed blocks are recycled and all chunks are released with the device.
+class DeviceArena {
+  public:
+    explicit DeviceArena(size_t block_size)
+        : block_size_(((std::max)(block_size, sizeof(void*)) + sizeof(void*) - 1) & ~(sizeof(void*) - 1)) {}
+    DeviceArena(const DeviceArena&) = delete;
+    DeviceArena& operator=(const DeviceArena&) = delete;
+    ~DeviceArena() {
+        for (auto chunk : chunks_) ::operator delete(chunk);
+    }
+    void* Allocate() {
+        lock_guard_t lock(lock_);
+        if (!free_list_) {
+            char* chunk = static_cast<char*>(::operator new(block_size_ * kBlocksPerChunk, std::nothrow));
+            if (!chunk) return nullptr;
+            chunks_.push_back(chunk);
+            for (size_t i = 0; i < kBlocksPerChunk; ++i) {
+                PushFree(chunk + i * block_size_);
+            }
+        }
+        void* block = free_list_;
+        free_list_ = *static_cast<void**>(block);
+        return block;
+    }
+    void Free(void* block) {
+        lock_guard_t lock(lock_);
+        PushFree(block);
+    }
+
+  private:
+    static const size_t kBlocksPerChunk = 64;
+    void PushFree(void* block) {
+        *static_cast<void**>(block) = free_list_;
+        free_list_ = block;
+    }
+    mutex_t lock_;
+    size_t block_size_;
+    void* free_list_ = nullptr;
+    std::vector<void*> chunks_;
+};
+
+// Dispatchable handles are real host allocations since the loader writes its dispatch pointer into them. They come from
+// the application's allocator when one applies, else from the owning device's arena, else from the C++ heap. After the
+// loader's pointer, a handle holds the ICD's state for the object, so per-instance and per-device state is reached from
+// the handle rather than looked up in maps shared by every instance.
+struct DispatchableObject {
+    VK_LOADER_DATA loader_data;
+    void* state;
+};
+
+static void* CreateDispObjHandle(const VkAllocationCallbacks* pAllocator, VkSystemAllocationScope scope, DeviceArena* arena,
+                                 void* state) {
+    void* handle = nullptr;
+    if (pAllocator) {
+        handle = pAllocator->pfnAllocation(pAllocator->pUserData, sizeof(DispatchableObject), alignof(DispatchableObject), scope);
+    } else if (arena) {
+        handle = arena->Allocate();
+    } else {
+        handle = ::operator new(sizeof(DispatchableObject), std::nothrow);
+    }
+    if (handle) {
+        set_loader_magic_value(handle);
+        static_cast<DispatchableObject*>(handle)->state = state;
+    }
+    return handle;
+}
+
+template <typename State>
+static State* GetDispObjState(const void* handle) {
+    return handle ? static_cast<State*>(static_cast<const DispatchableObject*>(handle)->state) : nullptr;
+}
+static void DestroyDispObjHandle(void* handle, const VkAllocationCallbacks* pAllocator, DeviceArena* arena) {
+    if (!handle) return;
+    if (pAllocator) {
+        pAllocator->pfnFree(pAllocator->pUserData, handle);
+    } else if (arena) {
+        arena->Free(handle);
+    } else {
+        ::operator delete(handle);
+    }
+}
+
+// The ICD's state for an object comes from the same allocator as the object's handle, with the same scope. Without an
+// allocator it comes from the C++ heap rather than the device's arena, whose blocks only fit a handle.
+template <typename State>
+static State* NewObjectState(const VkAllocationCallbacks* pAllocator, VkSystemAllocationScope scope) {
+    void* memory = pAllocator ? pAllocator->pfnAllocation(pAllocator->pUserData, sizeof(State), alignof(State), scope)
+                              : ::operator new(sizeof(State), std::nothrow);
+    return memory ? new (memory) State() : nullptr;
+}
+template <typename State>
+static void DeleteObjectState(State* state, const VkAllocationCallbacks* pAllocator) {
+    if (!state) return;
+    state->~State();
+    if (pAllocator) {
+        pAllocator->pfnFree(pAllocator->pUserData, state);
+    } else {
+        ::operator delete(state);
+    }
+}
+'''
+
+# Manual code at the top of the cpp source file
+SOURCE_CPP_PREFIX = '''
+using std::unordered_map;
+
+static constexpr uint32_t icd_physical_device_count = 1;
+static constexpr uint32_t kSupportedVulkanAPIVersion = VK_API_VERSION_1_1;
+
+// Overrides of entry points installed with vkmock_SetHook. Every entry point but the loader and instance plumbing starts
+// by loading its slot, so one that is not hooked pays a relaxed load and a predictable branch. While a hook runs, entry
+// points called on its thread skip their hooks, which lets a hook delegate to the mock implementation of its entry point.
+static std::atomic<PFN_vkVoidFunction> hook_table[kHookSlotCount];
+static thread_local bool in_hook = false;
+
+class HookScope {
+  public:
+    HookScope() : was_in_hook_(in_hook) { in_hook = true; }
+    ~HookScope() { in_hook = was_in_hook_; }
+
+  private:
+    const bool was_in_hook_;
+};
+
+template <typename PFN>
+static PFN GetHook(uint32_t slot) {
+    const PFN_vkVoidFunction hook = hook_table[slot].load(std::memory_order_relaxed);
+    return hook && !in_hook ? reinterpret_cast<PFN>(hook) : nullptr;
+}
+
+// Calls an entry point on behalf of the mock itself, such as an intercept delegating to another one. Hooks only see the
+// calls of the application, so neither the entry point nor the ones it calls in turn go to a hook.
+template <typename T>
+struct NonDeduced {
+    using type = T;
+};
+template <typename Result, typename... Params>
+static Result CallInternal(Result(VKAPI_PTR* entry_point)(Params...), typename NonDeduced<Params>::type... args) {
+    const HookScope scope;
+    return entry_point(args...);
+}
+
+static bool SetHook(const char* pName, PFN_vkVoidFunction pfnHook) {
+    const auto it = name_to_hook_slot_map.find(pName);
+    if (it == name_to_hook_slot_map.end()) return false;
+    hook_table[it->second].store(pfnHook, std::memory_order_relaxed);
+    return true;
+}
+
+// Size of a device memory allocation, the heap it was allocated from and its contents. The contents live
+// in a host allocation made the first time the memory is mapped or its device address is taken; it never moves, so the
+// host address of the contents is also the device address of the memory. The host allocation comes from the memory's
+// allocation callbacks with object scope, if it has any. Memory exported or imported as a file descriptor keeps its
+// contents in that file instead.
+struct DeviceMemoryState {
+    VkDeviceSize size;
+    uint32_t heap_index;
+    void* allocation;
+    uint8_t* data;
+    int fd;
+    bool has_allocator;
+    VkAllocationCallbacks allocator;
+};
+
+// Device address range taken by the contents of a device memory allocation, keyed by its start address
+struct DeviceAddressRange {
+    VkDeviceAddress end;
+    VkDeviceMemory memory;
+};
+
+// Memory bound to a buffer
+struct BufferBinding {
+    VkDeviceMemory memory;
+    VkDeviceSize offset;
+};
+
+// VK_EXT_memory_budget simulation. Bytes allocated are tracked per heap and an allocation that would exceed the heap's
+// budget fails with VK_ERROR_OUT_OF_DEVICE_MEMORY. The budget starts at VKMOCK_HEAP_BUDGET bytes (default: the heap
+// size) and shrinks by VKMOCK_HEAP_BUDGET_SHRINK_RATE bytes per second down to VKMOCK_HEAP_BUDGET_MIN, imitating other
+// processes claiming device memory over time.
+static constexpr uint32_t icd_memory_heap_count = 2;
+static constexpr VkDeviceSize icd_memory_heap_size = 8000000000;
+
+// Memory types follow a desktop GPU with dedicated memory (heap 1) next to system memory (heap 0): device memory
+// (type 0), write-combined host memory (type 1), cached host memory for readback (type 2) and host visible device memory
+// (type 3). As the specification requires, a type whose properties are a subset of another's comes first, so
+// applications that pick the first type with the properties they need get the plainest one. Optimally tiled images and
+// sparse resources can only live in device memory, linear images not in the readback type.
+static constexpr uint32_t icd_buffer_memory_types = 0xF;
+static constexpr uint32_t icd_linear_image_memory_types = 0xB;
+static constexpr uint32_t icd_device_local_memory_types = 0x9;
+// Buffers and linear images must not share a page of this size with optimally tiled images in the same memory
+static constexpr VkDeviceSize icd_buffer_image_granularity = 1024;
+// Sparse resources are bound in pages of this size, which is also their memory alignment
+static constexpr VkDeviceSize icd_sparse_page_size = 0x10000;
+static std::array<std::atomic<VkDeviceSize>, icd_memory_heap_count> heap_usage;
+static const auto heap_budget_start_time = std::chrono::steady_clock::now();
+
+static VkDeviceSize GetEnvSize(const char* name, VkDeviceSize default_value) {
+    const char* value = getenv(name);
+    return (value && *value) ? strtoull(value, nullptr, 0) : default_value;
+}
+
+static VkDeviceSize GetHeapBudget() {
+    static const VkDeviceSize initial_budget = (std::min)(GetEnvSize("VKMOCK_HEAP_BUDGET", icd_memory_heap_size), icd_memory_heap_size);
+    static const VkDeviceSize min_budget = (std::min)(GetEnvSize("VKMOCK_HEAP_BUDGET_MIN", 0), initial_budget);
+    static const VkDeviceSize shrink_rate = GetEnvSize("VKMOCK_HEAP_BUDGET_SHRINK_RATE", 0);
+    if (shrink_rate == 0) return initial_budget;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - heap_budget_start_time).count();
+    const double shrunk = seconds * static_cast<double>(shrink_rate);
+    if (shrunk >= static_cast<double>(initial_budget - min_budget)) return min_budget;
+    return initial_budget - static_cast<VkDeviceSize>(shrunk);
+}
+
+static uint32_t GetMemoryTypeHeapIndex(uint32_t memory_type_index) {
+    static const VkPhysicalDeviceMemoryProperties memory_properties = [] {
+        VkPhysicalDeviceMemoryProperties props = {};
+        CallInternal(GetPhysicalDeviceMemoryProperties, VK_NULL_HANDLE, &props);
+        return props;
+    }();
+    if (memory_type_index >= memory_properties.memoryTypeCount) return UINT32_MAX;
+    return memory_properties.memoryTypes[memory_type_index].heapIndex;
+}
+
+// VK_KHR_external_memory_fd and VK_KHR_external_semaphore_fd are backed by Linux file descriptors. Shareable device
+// memory lives in a memfd that importers map with MAP_SHARED, so every process sees the same pages. Shareable semaphore
+// payloads are eventfds in semaphore mode: a signal operation adds one and a wait operation blocks until it can take one.
+// Sync fds exported from a semaphore are already signaled, since submitted work completes immediately. Waits poll the
+// payload together with a wake fd, so a queue worker blocked on a payload nobody signals can still be stopped.
+#if defined(__linux__)
+static uint64_t ReadClockNs(clockid_t clock) {
+    timespec time;
+    clock_gettime(clock, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000ULL + static_cast<uint64_t>(time.tv_nsec);
+}
+
+// Time on CLOCK_MONOTONIC, the clock of device timestamps and presentation times
+static uint64_t GetMonotonicTimeNs() { return ReadClockNs(CLOCK_MONOTONIC); }
+static uint64_t GetMonotonicRawTimeNs() { return ReadClockNs(CLOCK_MONOTONIC_RAW); }
+
+static int CreateSharedMemoryFd(const char* name, VkDeviceSize size) {
+    static constexpr unsigned int memfd_cloexec = 0x0001U;  // MFD_CLOEXEC, not declared by older C libraries
+    const int fd = static_cast<int>(syscall(SYS_memfd_create, name, memfd_cloexec));
+    if (fd < 0) return -1;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static VkDeviceSize GetSharedMemoryFdSize(int fd) {
+    struct stat fd_stat;
+    return fstat(fd, &fd_stat) == 0 ? static_cast<VkDeviceSize>(fd_stat.st_size) : 0;
+}
+
+static uint8_t* MapSharedMemory(int fd, VkDeviceSize size) {
+    void* mapping = mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return mapping == MAP_FAILED ? nullptr : static_cast<uint8_t*>(mapping);
+}
+
+static void UnmapSharedMemory(uint8_t* data, VkDeviceSize size) { munmap(data, static_cast<size_t>(size)); }
+
+static int CreateSemaphoreFd(unsigned int initial_value) {
+    return eventfd(initial_value, EFD_CLOEXEC | EFD_NONBLOCK | EFD_SEMAPHORE);
+}
+
+static void SignalSemaphoreFd(int fd) {
+    const uint64_t one = 1;
+    while (write(fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
+
+// Waits until the payload is signaled and takes it, or until wake_fd becomes readable. Returns whether it took the
+// payload. The read does not block, so a payload another process took between the poll and the read restarts the wait.
+static bool WaitSemaphoreFd(int fd, bool sync_fd, int wake_fd) {
+    // Imported payloads may come from an exporter that made a blocking eventfd
+    if (!sync_fd) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    while (true) {
+        pollfd poll_fds[2] = {{fd, POLLIN, 0}, {wake_fd, POLLIN, 0}};
+        if (poll(poll_fds, wake_fd >= 0 ? 2 : 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (poll_fds[1].revents & POLLIN) return false;
+        // Sync files are signaled once and stay signaled, so only wait for them to become readable
+        if (sync_fd) return true;
+        uint64_t value;
+        if (read(fd, &value, sizeof(value)) == sizeof(value)) return true;
+        if (errno != EAGAIN && errno != EINTR) return false;
+    }
+}
+
+static int DuplicateFd(int fd) { return fcntl(fd, F_DUPFD_CLOEXEC, 0); }
+
+static void CloseFd(int fd) { close(fd); }
+#else
+#if defined(_WIN32)
+static uint64_t GetPerformanceCounter() {
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return static_cast<uint64_t>(counter.QuadPart);
+}
+
+// Time on the performance counter, the clock of device timestamps and presentation times
+static uint64_t GetMonotonicTimeNs() {
+    static const uint64_t frequency = [] {
+        LARGE_INTEGER counter_frequency;
+        QueryPerformanceFrequency(&counter_frequency);
+        return static_cast<uint64_t>(counter_frequency.QuadPart);
+    }();
+    const uint64_t counter = GetPerformanceCounter();
+    return counter / frequency * 1000000000ULL + counter % frequency * 1000000000ULL / frequency;
+}
+#else
+static uint64_t GetMonotonicTimeNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+#endif
+static int CreateSharedMemoryFd(const char* name, VkDeviceSize size) { return -1; }
+static VkDeviceSize GetSharedMemoryFdSize(int fd) { return 0; }
+static uint8_t* MapSharedMemory(int fd, VkDeviceSize size) { return nullptr; }
+static void UnmapSharedMemory(uint8_t* data, VkDeviceSize size) {}
+static int CreateSemaphoreFd(unsigned int initial_value) { return -1; }
+static void SignalSemaphoreFd(int fd) {}
+static bool WaitSemaphoreFd(int fd, bool sync_fd, int wake_fd) { return false; }
+static int DuplicateFd(int fd) { return -1; }
+static void CloseFd(int fd) {}
+#endif
+
+// Live statistics, laid out as the public VkmockStats. They are always collected; when VKMOCK_STATS is set they are
+// placed in a memfd named vkmock_stats that monitors map read-only through /proc/<pid>/fd. Counters are updated with
+// relaxed atomics, so each one is read atomically but they are not consistent with each other.
+struct Stats {
+    std::atomic<uint64_t> magic;
+    std::atomic<uint64_t> version;
+    std::atomic<uint64_t> size;
+    std::atomic<uint64_t> process_id;
+    std::atomic<uint64_t> start_time_ns;
+    std::atomic<uint64_t> objects_alive[VKMOCK_STATS_OBJECT_TYPE_COUNT];
+    std::atomic<uint64_t> heap_bytes_allocated[VK_MAX_MEMORY_HEAPS];
+    std::atomic<uint64_t> submit_count;
+    std::atomic<uint64_t> present_count;
+    std::atomic<uint64_t> lock_contention_count;
+    std::atomic<uint64_t> queue_busy_ns[VKMOCK_STATS_QUEUE_COUNT];
+    std::atomic<uint64_t> shader_module_cache_hits;
+    std::atomic<uint64_t> shader_module_cache_misses;
+    std::atomic<uint64_t> shader_module_bytes_saved;
+};
+static_assert(sizeof(Stats) == sizeof(VkmockStats), "Stats must match the VkmockStats layout");
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Stats counters must be lock-free to be shared with other processes");
+
+static Stats& CreateStats() {
+    static Stats local_stats;
+    Stats* stats = &local_stats;
+    if (GetEnvSize("VKMOCK_STATS", 0) != 0) {
+        // The descriptor stays open for the lifetime of the process so monitors can find the segment
+        const int fd = CreateSharedMemoryFd("vkmock_stats", sizeof(Stats));
+        uint8_t* data = fd >= 0 ? MapSharedMemory(fd, sizeof(Stats)) : nullptr;
+        if (data) {
+            stats = new (data) Stats();
+        } else if (fd >= 0) {
+            CloseFd(fd);
+        }
+    }
+    stats->version.store(VKMOCK_STATS_VERSION, std::memory_order_relaxed);
+    stats->size.store(sizeof(Stats), std::memory_order_relaxed);
+#if defined(__linux__)
+    stats->process_id.store(static_cast<uint64_t>(getpid()), std::memory_order_relaxed);
+#endif
+    stats->start_time_ns.store(GetMonotonicTimeNs(), std::memory_order_relaxed);
+    // Written last, so a monitor that sees the magic sees an initialized segment
+    stats->magic.store(VKMOCK_STATS_MAGIC, std::memory_order_release);
+    return *stats;
+}
+static Stats& icd_stats = CreateStats();
+
+static void TrackObjects(VkObjectType type, int64_t count) {
+    const size_t index = static_cast<size_t>(type) < VKMOCK_STATS_OBJECT_TYPE_COUNT ? static_cast<size_t>(type) : 0;
+    icd_stats.objects_alive[index].fetch_add(static_cast<uint64_t>(count), std::memory_order_relaxed);
+}
+
+static void CountLockContention() { icd_stats.lock_contention_count.fetch_add(1, std::memory_order_relaxed); }
+
+// Objects alive, kept for the leak report when VKMOCK_LEAK_REPORT names a file. Each one remembers its type, when it was
+// created, its size if it is device memory, and the return addresses of the call that created it. Objects freed with
+// their pool remember the pool as their parent.
+static constexpr int icd_leak_report_frame_count = 16;
+struct LiveObject {
+    const char* type_name;
+    uint64_t parent;
+    VkDeviceSize size;
+    uint64_t create_time_ns;
+    int frame_count;
+    void* frames[icd_leak_report_frame_count];
+};
+static mutex_t live_object_lock;
+static unordered_map<uint64_t, LiveObject> live_object_map;
+
+static const char* GetLeakReportPath() {
+    static const char* const path = getenv("VKMOCK_LEAK_REPORT");
+    return (path && *path) ? path : nullptr;
+}
+
+static void AddLiveObject(const char* type_name, uint64_t handle, VkDeviceSize size = 0, uint64_t parent = 0) {
+    if (!GetLeakReportPath() || handle == 0) return;
+    LiveObject object = {type_name, parent, size, GetMonotonicTimeNs(), 0, {}};
+#if defined(__GLIBC__)
+    // Walking the stack is cheap; symbolizing it is not, and waits for the report
+    object.frame_count = backtrace(object.frames, icd_leak_report_frame_count);
+#endif
+    lock_guard_t lock(live_object_lock);
+    live_object_map[handle] = object;
+}
+
+static void RemoveLiveObject(uint64_t handle) {
+    if (!GetLeakReportPath() || handle == 0) return;
+    lock_guard_t lock(live_object_lock);
+    live_object_map.erase(handle);
+}
+
+static void RemoveLiveObjectsOf(uint64_t parent) {
+    if (!GetLeakReportPath() || parent == 0) return;
+    lock_guard_t lock(live_object_lock);
+    for (auto it = live_object_map.begin(); it != live_object_map.end();) {
+        it = it->second.parent == parent ? live_object_map.erase(it) : std::next(it);
+    }
+}
+
+// Writes the objects still alive to VKMOCK_LEAK_REPORT, or to stderr if the file cannot be opened. Objects are grouped by
+// the call stack that created them, and the call sites retaining the most device memory, then the most objects, come
+// first. backtrace_symbols names the functions that the executable (linked with -rdynamic) and shared libraries export,
+// and gives module offsets for the others.
+static void WriteLeakReport() {
+    const char* path = GetLeakReportPath();
+    if (!path) return;
+    struct CallSite {
+        uint64_t count;
+        VkDeviceSize bytes;
+        uint64_t oldest_create_time_ns;
+        std::map<std::string, uint64_t> type_counts;
+    };
+    std::map<std::vector<void*>, CallSite> site_map;
+    uint64_t object_count = 0;
+    VkDeviceSize total_bytes = 0;
+    {
+        lock_guard_t lock(live_object_lock);
+        for (const auto& handle_object : live_object_map) {
+            const auto& object = handle_object.second;
+            auto& site = site_map[std::vector<void*>(object.frames, object.frames + object.frame_count)];
+            if (site.count == 0 || object.create_time_ns < site.oldest_create_time_ns) {
+                site.oldest_create_time_ns = object.create_time_ns;
+            }
+            ++site.count;
+            site.bytes += object.size;
+            ++site.type_counts[object.type_name];
+            ++object_count;
+            total_bytes += object.size;
+        }
+    }
+    std::vector<const std::pair<const std::vector<void*>, CallSite>*> sites;
+    for (const auto& frames_site : site_map) sites.push_back(&frames_site);
+    std::stable_sort(sites.begin(), sites.end(), [](const std::pair<const std::vector<void*>, CallSite>* a,
+                                                    const std::pair<const std::vector<void*>, CallSite>* b) {
+        return a->second.bytes != b->second.bytes ? a->second.bytes > b->second.bytes : a->second.count > b->second.count;
+    });
+
+    FILE* file = fopen(path, "w");
+    FILE* out = file ? file : stderr;
+    const uint64_t start_time_ns = icd_stats.start_time_ns.load(std::memory_order_relaxed);
+    fprintf(out, "vkmock leak report: %llu objects alive, retaining %llu bytes of device memory, from %zu call sites\\n",
+            static_cast<unsigned long long>(object_count), static_cast<unsigned long long>(total_bytes), sites.size());
+    for (const auto* frames_site : sites) {
+        const auto& frames = frames_site->first;
+        const auto& site = frames_site->second;
+        fprintf(out, "\\n%llu bytes in %llu objects:", static_cast<unsigned long long>(site.bytes),
+                static_cast<unsigned long long>(site.count));
+        const char* separator = " ";
+        for (const auto& type_count : site.type_counts) {
+            fprintf(out, "%s%llu %s", separator, static_cast<unsigned long long>(type_count.second), type_count.first.c_str());
+            separator = ", ";
+        }
+        fprintf(out, "; oldest created %.3f s after the ICD was loaded\\n",
+                static_cast<double>(site.oldest_create_time_ns - start_time_ns) / 1e9);
+#if defined(__GLIBC__)
+        char** symbols = frames.empty() ? nullptr : backtrace_symbols(frames.data(), static_cast<int>(frames.size()));
+        for (size_t i = 0; i < frames.size(); ++i) {
+            if (symbols) {
+                fprintf(out, "    #%zu %s\\n", i, symbols[i]);
+            } else {
+                fprintf(out, "    #%zu %p\\n", i, frames[i]);
+            }
+        }
+        free(symbols);
+#else
+        for (size_t i = 0; i < frames.size(); ++i) fprintf(out, "    #%zu %p\\n", i, frames[i]);
+#endif
+    }
+    if (file) fclose(file);
+}
+
+// External payloads of semaphores. A temporary payload, imported with VK_SEMAPHORE_IMPORT_TEMPORARY_BIT or as a sync fd,
+// replaces the permanent one until the next wait. A sync fd of -1 is a payload that is already signaled.
+struct SemaphoreFdState {
+    int permanent_fd;
+    bool has_temporary_payload;
+    int temporary_fd;
+    bool temporary_is_sync_fd;
+};
+
+// Event payloads. Host calls and queue workers flip the state atomically; a queue worker blocked in vkCmdWaitEvents
+// sleeps on event_cv until the events it waits for are set. Commands hold on to the payloads of the events they
+// reference, so queue workers never look events up.
+struct EventState {
+    explicit EventState(bool set) : signaled(set) {}
+    std::atomic<bool> signaled;
+};
+static std::mutex event_mutex;
+static std::condition_variable event_cv;
+
+static void SetEventState(EventState* state, bool signaled) {
+    if (!state) return;
+    {
+        std::lock_guard<std::mutex> lock(event_mutex);
+        state->signaled.store(signaled, std::memory_order_release);
+    }
+    if (signaled) event_cv.notify_all();
+}
+
+// Simulated VK_KHR_performance_query counters. They count commands as they are recorded into each command buffer, and a
+// performance query reports how much each counter grew between its begin and end. The result becomes available when a
+// queue executes the end of the query, like the other queue commands.
+enum PerformanceCounter : uint32_t {
+    kCounterDraws,
+    kCounterDispatches,
+    kCounterBytesCopied,
+    kCounterBarriers,
+    kCounterDescriptorBinds,
+    kCounterPipelineBinds,
+    kPerformanceCounterCount
+};
+struct PerformanceCounterInfo {
+    VkPerformanceCounterUnitKHR unit;
+    const char* name;
+    const char* description;
+};
+static const std::array<PerformanceCounterInfo, kPerformanceCounterCount> performance_counter_infos = {{
+    {VK_PERFORMANCE_COUNTER_UNIT_GENERIC_KHR, "Draws", "Draws recorded, counting each draw of indirect and multi-draw commands"},
+    {VK_PERFORMANCE_COUNTER_UNIT_GENERIC_KHR, "Dispatches", "Dispatch commands recorded"},
+    {VK_PERFORMANCE_COUNTER_UNIT_BYTES_KHR, "Bytes copied", "Bytes written by buffer copy, update and fill commands"},
+    {VK_PERFORMANCE_COUNTER_UNIT_GENERIC_KHR, "Barriers", "Memory, buffer and image barriers recorded in pipeline barriers"},
+    {VK_PERFORMANCE_COUNTER_UNIT_GENERIC_KHR, "Descriptor binds", "Descriptor sets bound or pushed"},
+    {VK_PERFORMANCE_COUNTER_UNIT_GENERIC_KHR, "Pipeline binds", "Pipelines bound"},
+}};
+using PerformanceCounterValues = std::array<uint64_t, kPerformanceCounterCount>;
+
+// Results of a performance query pool, with one value per enabled counter for each query. Queues write the results of
+// the queries they execute, so the results and their availability are guarded by a lock of the pool's own.
+struct PerformanceQueryPool {
+    std::vector<uint32_t> counter_indices;
+    std::mutex lock;
+    std::condition_variable available_cv;
+    std::vector<uint64_t> results;
+    std::vector<bool> available;
+};
+
+struct ActivePerformanceQuery {
+    VkQueryPool pool;
+    std::shared_ptr<PerformanceQueryPool> pool_state;
+    uint32_t query;
+    PerformanceCounterValues begin_values;
+};
+
+// Commands recorded into a command buffer that take effect when a queue executes it
+enum class QueueCommandType : uint8_t { kSetEvent, kResetEvent, kWaitEvent, kResetQueries, kEndQuery };
+struct QueueCommand {
+    QueueCommandType type;
+    std::shared_ptr<EventState> event;
+    // Performance queries: the pool, the first query and either the number of queries reset or the results of the query
+    std::shared_ptr<PerformanceQueryPool> query_pool;
+    uint32_t query;
+    uint32_t query_count;
+    PerformanceCounterValues counter_values;
+};
+
+// Makes queries of a performance query pool unavailable
+static void ResetPerformanceQueries(PerformanceQueryPool& pool, uint32_t first_query, uint32_t query_count) {
+    std::lock_guard<std::mutex> lock(pool.lock);
+    auto& available = pool.available;
+    std::fill(available.begin() + (std::min)(size_t(first_query), available.size()),
+              available.begin() + (std::min)(size_t(first_query) + query_count, available.size()), false);
+}
+
+// Stores the counter values of a performance query and makes it available
+static void EndPerformanceQuery(PerformanceQueryPool& pool, uint32_t query, const PerformanceCounterValues& values) {
+    {
+        std::lock_guard<std::mutex> lock(pool.lock);
+        if (query >= pool.available.size()) return;
+        const size_t counter_count = pool.counter_indices.size();
+        for (size_t i = 0; i < counter_count; ++i) {
+            const uint32_t counter = pool.counter_indices[i];
+            pool.results[query * counter_count + i] = counter < kPerformanceCounterCount ? values[counter] : 0;
+        }
+        pool.available[query] = true;
+    }
+    pool.available_cv.notify_all();
+}
+
+// A submitted batch. Queue commands of its command buffers are copied at submission.
+struct QueueBatch {
+    std::vector<VkSemaphore> wait_semaphores;
+    std::vector<QueueCommand> commands;
+    std::vector<VkSemaphore> signal_semaphores;
+    VkFence fence = VK_NULL_HANDLE;
+    uint64_t gpu_time_ns = 0;
+};
+
+// Number of queues in the queue family, at most VKMOCK_STATS_QUEUE_COUNT
+static const uint32_t icd_queue_count =
+    static_cast<uint32_t>((std::max)(VkDeviceSize(1), (std::min)(GetEnvSize("VKMOCK_QUEUE_COUNT", 1), VkDeviceSize(VKMOCK_STATS_QUEUE_COUNT))));
+
+// Scheduling parameters of a queue, from its VkDeviceQueueCreateInfo
+struct QueuePriority {
+    uint32_t global_priority;  // 0 (low) to 3 (realtime)
+    float priority;
+};
+
+static uint32_t GetGlobalPriorityRank(VkQueueGlobalPriorityKHR global_priority) {
+    switch (global_priority) {
+        case VK_QUEUE_GLOBAL_PRIORITY_LOW_KHR:
+            return 0;
+        case VK_QUEUE_GLOBAL_PRIORITY_HIGH_KHR:
+            return 2;
+        case VK_QUEUE_GLOBAL_PRIORITY_REALTIME_KHR:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+// The simulated GPU of a physical device, shared by the queues of all devices created from it. A batch occupies it for VKMOCK_GPU_COMMAND_NS per command
+// recorded into its command buffers, in slices of at most kSliceNs. At every slice boundary the GPU goes to the waiting
+// queue with the highest global priority, which preempts the others. Queues of equal global priority share the GPU in
+// proportion to their queue priorities: a slice advances the virtual time of its queue by its length divided by the
+// priority, and the queue with the lowest virtual time runs next.
+class GpuTimeline {
+  public:
+    struct Queue {
+        QueuePriority priority;
+        uint32_t ordinal;  // Global queue ordinal, selecting the busy time statistic
+        double virtual_time;
+    };
+
+    void Run(Queue& queue, uint64_t duration_ns) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // A queue that was idle gets no credit for the time it did not use
+        queue.virtual_time = (std::max)(queue.virtual_time, virtual_time_);
+        waiting_.push_back(&queue);
+        const double weight = (std::max)(queue.priority.priority, 0.01f);
+        while (duration_ns > 0) {
+            cv_.wait(lock, [&] { return !busy_ && Next() == &queue; });
+            busy_ = true;
+            virtual_time_ = queue.virtual_time;
+            const uint64_t slice_ns = duration_ns < kSliceNs ? duration_ns : kSliceNs;
+            // While the GPU stays busy, each slice is timed from the end of the previous one so wakeup latency does not add up
+            slice_end_ = (idle_ ? std::chrono::steady_clock::now() : slice_end_) + std::chrono::nanoseconds(slice_ns);
+            idle_ = false;
+            const auto slice_end = slice_end_;
+            lock.unlock();
+            std::this_thread::sleep_until(slice_end);
+            lock.lock();
+            busy_ = false;
+            queue.virtual_time += slice_ns / weight;
+            duration_ns -= slice_ns;
+            icd_stats.queue_busy_ns[queue.ordinal % VKMOCK_STATS_QUEUE_COUNT].fetch_add(slice_ns, std::memory_order_relaxed);
+            cv_.notify_all();
+        }
+        waiting_.erase(std::find(waiting_.begin(), waiting_.end(), &queue));
+        if (waiting_.empty()) idle_ = true;
+    }
+
+  private:
+    static const uint64_t kSliceNs = 100000;
+
+    Queue* Next() const {
+        Queue* next = nullptr;
+        for (auto* queue : waiting_) {
+            if (!next || queue->priority.global_priority > next->priority.global_priority ||
+                (queue->priority.global_priority == next->priority.global_priority && queue->virtual_time < next->virtual_time)) {
+                next = queue;
+            }
+        }
+        return next;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool busy_ = false;
+    double virtual_time_ = 0.0;  // Virtual time of the queue that ran last
+    bool idle_ = true;
+    std::chrono::steady_clock::time_point slice_end_;
+    std::vector<Queue*> waiting_;
+};
+struct QueueSchedule {
+    GpuTimeline* timeline;
+    QueuePriority priority;
+    uint32_t ordinal;
+};
+
+// Queues are numbered in the order they are created, across all devices and physical devices
+static uint32_t AllocateQueueOrdinal() {
+    static std::atomic<uint32_t> queue_count{0};
+    return queue_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Handles of non-dispatchable objects come from global_unique_handle, so their values depend on how the creation of all
+// objects interleaved. With VKMOCK_DETERMINISTIC_HANDLES set, each instance, physical device and device numbers the
+// objects it creates in a space of its own instead, with one counter per object type starting at VKMOCK_HANDLE_SEED.
+// Replaying the same calls then yields the same handles, whatever other devices and threads do in between. From the
+// top, a handle holds the ordinal of its space, the object type and the count.
+//
+// Each instance takes the next block of icd_handle_space_block ordinals, in creation order. The first ordinal of the
+// block is its own and the others are shared out between its physical devices: each one takes the first ordinal of its
+// share and gives the rest to the devices created from it, in the order it created them. The space of a device thus
+// depends on its physical device and on how many devices that physical device created before, and not on devices
+// created from other physical devices.
+static constexpr int icd_handle_space_bits = 10;
+static constexpr int icd_handle_type_bits = 20;
+static constexpr int icd_handle_counter_bits = 34;
+static constexpr uint64_t icd_handle_space_block = 64;
+static constexpr uint64_t icd_handle_spaces_per_physical_device = (icd_handle_space_block - 2) / icd_physical_device_count;
+static_assert(icd_handle_spaces_per_physical_device >= 2, "each physical device needs a space for itself and its devices");
+
+struct HandleSpace {
+    uint64_t ordinal = 0;
+    mutex_t lock;  // Guards next_counts, so objects are created without a lock shared by all devices
+    unordered_map<uint32_t, uint64_t> next_counts;
+};
+
+static uint64_t AllocateInstanceHandleSpaceOrdinal() {
+    static std::atomic<uint64_t> instance_count{0};
+    // Blocks wrap around rather than spill into the type bits, and ordinal 0 is skipped so no handle is VK_NULL_HANDLE
+    static constexpr uint64_t block_count = (uint64_t(1) << icd_handle_space_bits) / icd_handle_space_block;
+    return instance_count.fetch_add(1, std::memory_order_relaxed) % block_count * icd_handle_space_block + 1;
+}
+
+static uint64_t GetPhysicalDeviceHandleSpaceOrdinal(uint64_t instance_ordinal, uint32_t physical_device_index) {
+    return instance_ordinal + 1 + physical_device_index * icd_handle_spaces_per_physical_device;
+}
+
+// The devices of a physical device wrap around within its share of the block
+static uint64_t GetDeviceHandleSpaceOrdinal(uint64_t physical_device_ordinal, uint64_t device_index) {
+    return physical_device_ordinal + 1 + device_index % (icd_handle_spaces_per_physical_device - 1);
+}
+
+static bool UseDeterministicHandles() {
+    static const bool deterministic = GetEnvSize("VKMOCK_DETERMINISTIC_HANDLES", 0) != 0;
+    return deterministic;
+}
+
+static uint64_t NewHandle(HandleSpace& space, VkObjectType type) {
+    static const uint64_t seed = GetEnvSize("VKMOCK_HANDLE_SEED", 1);
+    // Extension object types are 1000000000 + 1000 * (extension number - 1) + n; fold them in above the core types
+    const uint32_t type_value = static_cast<uint32_t>(type);
+    const uint64_t type_index = type_value < 1000000000u ? type_value : type_value - 1000000000u + 1000u;
+    uint64_t count;
+    {
+        lock_guard_t lock(space.lock);
+        count = space.next_counts.emplace(type_value, seed).first->second++;
+    }
+    return (space.ordinal << (icd_handle_type_bits + icd_handle_counter_bits)) |
+           ((type_index & ((uint64_t(1) << icd_handle_type_bits) - 1)) << icd_handle_counter_bits) |
+           (count & ((uint64_t(1) << icd_handle_counter_bits) - 1));
+}
+
+// States kept in dispatchable handles. An instance owns its physical devices, and the devices created from a physical
+// device share its GPU timeline.
+struct PhysicalDeviceState {
+    GpuTimeline timeline;
+    HandleSpace handle_space;
+    std::atomic<uint64_t> device_count{0};  // Devices created from this physical device
+};
+
+struct InstanceState {
+    InstanceState() {
+        handle_space.ordinal = AllocateInstanceHandleSpaceOrdinal();
+        for (uint32_t i = 0; i < icd_physical_device_count; ++i) {
+            physical_device_states[i].handle_space.ordinal = GetPhysicalDeviceHandleSpaceOrdinal(handle_space.ordinal, i);
+        }
+    }
+
+    std::array<VkPhysicalDevice, icd_physical_device_count> physical_devices = {};
+    std::array<PhysicalDeviceState, icd_physical_device_count> physical_device_states;
+    HandleSpace handle_space;
+};
+
+struct DeviceObjects;
+class QueueWorker;
+
+struct DeviceState {
+    GpuTimeline* timeline = nullptr;
+    HandleSpace handle_space;
+    // Allocation callbacks given at device creation. They back device-level allocations and are the fallback for child
+    // objects created without their own callbacks. Devices created without callbacks get an arena instead.
+    bool has_allocator = false;
+    VkAllocationCallbacks allocator = {};
+    std::unique_ptr<DeviceArena> arena;
+    // Priorities of the queues by family and index, from device creation
+    unordered_map<uint32_t, unordered_map<uint32_t, QueuePriority>> queue_priorities;
+    // Queues by family and index, created when first retrieved. They are guarded by queue_lock, so devices get their
+    // queues without contending with each other.
+    mutex_t queue_lock;
+    unordered_map<uint32_t, unordered_map<uint32_t, VkQueue>> queues;
+    // Fences and external semaphore payloads, guarded by sync_lock so that the queue workers signaling them contend
+    // neither with other devices nor with calls on the device's other objects. fence_cv is notified when fences signal.
+    mutex_t sync_lock;
+    std::condition_variable_any fence_cv;
+    // Number of submitted batches that will signal each fence. A fence is signaled whenever none is pending.
+    unordered_map<VkFence, uint32_t> pending_fences;
+    unordered_map<VkSemaphore, SemaphoreFdState> semaphore_fds;
+    // Memory, resources, pools and events of the device, guarded by a lock of their own. Allocated like the state.
+    DeviceObjects* objects = nullptr;
+};
+
+struct QueueState {
+    DeviceState* device;
+    QueueSchedule schedule;
+    // Started by the first submission. Calls on a queue are externally synchronized, so it needs no lock.
+    std::unique_ptr<QueueWorker> worker;
+};
+
+static InstanceState* GetInstanceState(VkInstance instance) { return GetDispObjState<InstanceState>(instance); }
+static PhysicalDeviceState* GetPhysicalDeviceState(VkPhysicalDevice physicalDevice) {
+    return GetDispObjState<PhysicalDeviceState>(physicalDevice);
+}
+static DeviceState* GetDeviceState(VkDevice device) { return GetDispObjState<DeviceState>(device); }
+static QueueState* GetQueueState(VkQueue queue) { return GetDispObjState<QueueState>(queue); }
+
+// Handle for an object created by an instance, physical device or device
+static uint64_t NewUniqueHandle() { return global_unique_handle.fetch_add(1, std::memory_order_relaxed); }
+static uint64_t NewHandle(VkInstance instance, VkObjectType type) {
+    return UseDeterministicHandles() ? NewHandle(GetInstanceState(instance)->handle_space, type) : NewUniqueHandle();
+}
+static uint64_t NewHandle(VkPhysicalDevice physicalDevice, VkObjectType type) {
+    return UseDeterministicHandles() ? NewHandle(GetPhysicalDeviceState(physicalDevice)->handle_space, type)
+                                     : NewUniqueHandle();
+}
+static uint64_t NewHandle(VkDevice device, VkObjectType type) {
+    return UseDeterministicHandles() ? NewHandle(GetDeviceState(device)->handle_space, type) : NewUniqueHandle();
+}
+
+// Must be called with the device's sync_lock held
+static SemaphoreFdState& GetSemaphoreFdState(DeviceState& device, VkSemaphore semaphore) {
+    return device.semaphore_fds.emplace(semaphore, SemaphoreFdState{-1, false, -1, false}).first->second;
+}
+
+// Gives up when wake_fd becomes readable
+static void WaitExternalSemaphore(DeviceState& device, VkSemaphore semaphore, int wake_fd) {
+    int fd = -1;
+    bool sync_fd = false;
+    bool temporary = false;
+    {
+        lock_guard_t lock(device.sync_lock);
+        const auto it = device.semaphore_fds.find(semaphore);
+        if (it == device.semaphore_fds.end()) return;
+        auto& state = it->second;
+        if (state.has_temporary_payload) {
+            // Waiting consumes a temporary payload and restores the permanent one
+            fd = state.temporary_fd;
+            sync_fd = state.temporary_is_sync_fd;
+            temporary = true;
+            state.has_temporary_payload = false;
+            state.temporary_fd = -1;
+        } else {
+            fd = state.permanent_fd;
+        }
+    }
+    // The payload may be signaled by another process, so wait without holding the lock
+    if (fd < 0) return;
+    WaitSemaphoreFd(fd, sync_fd, wake_fd);
+    if (temporary) CloseFd(fd);
+}
+
+static void SignalExternalSemaphore(DeviceState& device, VkSemaphore semaphore) {
+    lock_guard_t lock(device.sync_lock);
+    const auto it = device.semaphore_fds.find(semaphore);
+    if (it == device.semaphore_fds.end()) return;
+    const auto& state = it->second;
+    const int fd = state.has_temporary_payload ? (state.temporary_is_sync_fd ? -1 : state.temporary_fd) : state.permanent_fd;
+    if (fd >= 0) SignalSemaphoreFd(fd);
+}
+
+// Each queue executes its batches in submission order on a worker thread, so vkQueueSubmit returns before the submitted
+// work has run, as it does on hardware.
+class QueueWorker {
+  public:
+    explicit QueueWorker(const QueueState& queue)
+        : device_(queue.device),
+          timeline_(queue.schedule.timeline),
+          gpu_queue_{queue.schedule.priority, queue.schedule.ordinal, 0.0},
+          wake_fd_(CreateSemaphoreFd(0)),
+          stopping_(false),
+          busy_(false),
+          thread_(&QueueWorker::Run, this) {}
+
+    // Drops the batches that have not started and finishes the running one without blocking on events or semaphores,
+    // then stops the worker. The fences of dropped batches are signaled so that nothing waits for them forever.
+    ~QueueWorker() {
+        std::deque<QueueBatch> dropped_batches;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            dropped_batches.swap(batches_);
+        }
+        work_cv_.notify_one();
+        if (wake_fd_ >= 0) SignalSemaphoreFd(wake_fd_);
+        {
+            std::lock_guard<std::mutex> lock(event_mutex);
+        }
+        event_cv.notify_all();
+        thread_.join();
+        if (wake_fd_ >= 0) CloseFd(wake_fd_);
+        for (const auto& batch : dropped_batches) {
+            if (batch.fence != VK_NULL_HANDLE) CompleteFence(batch.fence);
+        }
+    }
+
+    void Submit(QueueBatch&& batch) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batches_.push_back(std::move(batch));
+        }
+        work_cv_.notify_one();
+    }
+
+    // Must not be called with the device's sync_lock held, since finishing a batch takes it
+    void WaitIdle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_cv_.wait(lock, [this] { return batches_.empty() && !busy_; });
+    }
+
+  private:
+    void Run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            work_cv_.wait(lock, [this] { return stopping_ || !batches_.empty(); });
+            if (batches_.empty()) break;
+            QueueBatch batch = std::move(batches_.front());
+            batches_.pop_front();
+            busy_ = true;
+            lock.unlock();
+            Execute(batch);
+            lock.lock();
+            busy_ = false;
+            if (batches_.empty()) idle_cv_.notify_all();
+        }
+    }
+
+    void Execute(const QueueBatch& batch) {
+        for (const auto semaphore : batch.wait_semaphores) {
+            if (stopping_) break;
+            WaitExternalSemaphore(*device_, semaphore, wake_fd_);
+        }
+        if (timeline_ && batch.gpu_time_ns && !stopping_) {
+            timeline_->Run(gpu_queue_, batch.gpu_time_ns);
+        }
+        for (const auto& command : batch.commands) {
+            switch (command.type) {
+                case QueueCommandType::kSetEvent:
+                    SetEventState(command.event.get(), true);
+                    break;
+                case QueueCommandType::kResetEvent:
+                    SetEventState(command.event.get(), false);
+                    break;
+                case QueueCommandType::kWaitEvent:
+                    WaitEvent(*command.event);
+                    break;
+                case QueueCommandType::kResetQueries:
+                    ResetPerformanceQueries(*command.query_pool, command.query, command.query_count);
+                    break;
+                case QueueCommandType::kEndQuery:
+                    EndPerformanceQuery(*command.query_pool, command.query, command.counter_values);
+                    break;
+            }
+        }
+        for (const auto semaphore : batch.signal_semaphores) {
+            SignalExternalSemaphore(*device_, semaphore);
+        }
+        if (batch.fence != VK_NULL_HANDLE) CompleteFence(batch.fence);
+    }
+
+    void CompleteFence(VkFence fence) {
+        {
+            lock_guard_t lock(device_->sync_lock);
+            const auto it = device_->pending_fences.find(fence);
+            if (it != device_->pending_fences.end() && --it->second == 0) device_->pending_fences.erase(it);
+        }
+        device_->fence_cv.notify_all();
+    }
+
+    void WaitEvent(const EventState& state) {
+        std::unique_lock<std::mutex> lock(event_mutex);
+        event_cv.wait(lock, [&] { return state.signaled.load(std::memory_order_acquire) || stopping_; });
+    }
+
+    DeviceState* device_;
+    GpuTimeline* timeline_;
+    GpuTimeline::Queue gpu_queue_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<QueueBatch> batches_;
+    int wake_fd_;  // Readable once the worker is stopping, to interrupt semaphore waits
+    std::atomic<bool> stopping_;
+    bool busy_;
+    std::thread thread_;
+};
+
+// Hands batches to the queue's worker; the fence is signaled once the last one has run
+static void SubmitToQueue(VkQueue queue, std::vector<QueueBatch>& batches, VkFence fence) {
+    icd_stats.submit_count.fetch_add(1, std::memory_order_relaxed);
+    if (batches.empty()) {
+        if (fence == VK_NULL_HANDLE) return;
+        batches.emplace_back();
+    }
+    auto* state = GetQueueState(queue);
+    if (fence != VK_NULL_HANDLE) {
+        lock_guard_t lock(state->device->sync_lock);
+        ++state->device->pending_fences[fence];
+        batches.back().fence = fence;
+    }
+    if (!state->worker) state->worker.reset(new QueueWorker(*state));
+    for (auto& batch : batches) {
+        state->worker->Submit(std::move(batch));
+    }
+}
+
+static void WaitQueueIdle(VkQueue queue) {
+    const auto* state = GetQueueState(queue);
+    if (state->worker) state->worker->WaitIdle();
+}
+
+// Pipeline compilation is simulated as VKMOCK_PIPELINE_COMPILE_NS nanoseconds of CPU work per pipeline, split into chunks
+// so that the threads joining a deferred operation can share it
+static const uint32_t icd_pipeline_compile_chunks = 8;
+
+static void CompilePipelineChunk() {
+    static const VkDeviceSize chunk_time_ns = GetEnvSize("VKMOCK_PIPELINE_COMPILE_NS", 0) / icd_pipeline_compile_chunks;
+    if (chunk_time_ns == 0) return;
+    // Spin rather than sleep, so the chunk occupies its thread like real compilation
+    const auto end = std::chrono::steady_clock::now() + std::chrono::nanoseconds(chunk_time_ns);
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+// Work of a deferred host operation. Joining threads claim chunks by incrementing next_chunk; the operation is complete
+// once every chunk has finished. An operation that has no deferred command is complete.
+struct DeferredOperationState {
+    uint32_t chunk_count = 0;
+    std::atomic<uint32_t> next_chunk{0};
+    std::atomic<uint32_t> finished_chunks{0};
+};
+
+// 64-bit hash of shader code in the style of xxHash: four independent lanes each consume one 8-byte word of every
+// 32-byte block, so the main loop carries no dependency between lanes, then the lanes, the tail and the size are folded
+// and avalanched.
+static uint64_t HashShaderCode(const void* data, size_t size) {
+    static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    const auto rotate = [](uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t lanes[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+    size_t offset = 0;
+    for (; offset + 32 <= size; offset += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            uint64_t word;
+            memcpy(&word, bytes + offset + lane * 8, sizeof(word));
+            lanes[lane] = rotate(lanes[lane] + word * kPrime2, 31) * kPrime1;
+        }
+    }
+    uint64_t hash = rotate(lanes[0], 1) + rotate(lanes[1], 7) + rotate(lanes[2], 12) + rotate(lanes[3], 18);
+    hash += static_cast<uint64_t>(size);
+    for (; offset < size; ++offset) {
+        hash = rotate(hash ^ (bytes[offset] * kPrime1), 11) * kPrime2;
+    }
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime1;
+    return hash ^ (hash >> 32);
+}
+
+// Shader modules are deduplicated by content, like a driver's shader cache: modules of a device with the same code share
+// one refcounted entry, which lives as long as any of them. A pipeline pays the simulated compile cost only if one of its
+// stages uses code that no earlier pipeline of the device compiled. Devices do not share compiled code, so each device
+// has a cache of its own.
+struct ShaderCodeEntry {
+    uint64_t hash;
+    std::vector<uint8_t> code;
+    uint32_t ref_count;
+    bool compiled;  // Whether a pipeline compiled the code
+};
+struct ShaderCodeCache {
+    std::unordered_multimap<uint64_t, std::unique_ptr<ShaderCodeEntry>> entries;
+    unordered_map<VkShaderModule, ShaderCodeEntry*> modules;
+};
+
+// Returns the entry holding the code, adding one if the code is new. Hash collisions are told apart by comparing the
+// code. Must be called with the device's objects locked.
+static ShaderCodeEntry* AcquireShaderCode(ShaderCodeCache& cache, uint64_t hash, const void* code, size_t size) {
+    const auto range = cache.entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto& entry = *it->second;
+        if (entry.code.size() == size && memcmp(entry.code.data(), code, size) == 0) {
+            ++entry.ref_count;
+            icd_stats.shader_module_cache_hits.fetch_add(1, std::memory_order_relaxed);
+            icd_stats.shader_module_bytes_saved.fetch_add(size, std::memory_order_relaxed);
+            return &entry;
+        }
+    }
+    icd_stats.shader_module_cache_misses.fetch_add(1, std::memory_order_relaxed);
+    const uint8_t* bytes = static_cast<const uint8_t*>(code);
+    std::unique_ptr<ShaderCodeEntry> entry(new ShaderCodeEntry{hash, std::vector<uint8_t>(bytes, bytes + size), 1, false});
+    return cache.entries.emplace(hash, std::move(entry))->second.get();
+}
+
+// Must be called with the device's objects locked
+static void ReleaseShaderCode(ShaderCodeCache& cache, ShaderCodeEntry* entry) {
+    if (--entry->ref_count > 0) return;
+    const auto range = cache.entries.equal_range(entry->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.get() == entry) {
+            cache.entries.erase(it);
+            return;
+        }
+    }
+}
+
+// Marks the code of a pipeline's stages compiled. Returns whether the pipeline has to compile anything, that is whether
+// a stage uses code the device did not compile before or a module the ICD does not know. Must be called with the
+// device's objects locked.
+static bool CompileShaderStages(ShaderCodeCache& cache, uint32_t stage_count, const VkPipelineShaderStageCreateInfo* stages) {
+    bool compile = stage_count == 0;
+    for (uint32_t i = 0; i < stage_count; ++i) {
+        const auto it = cache.modules.find(stages[i].module);
+        if (it == cache.modules.end()) {
+            compile = true;
+            continue;
+        }
+        if (!it->second->compiled) {
+            it->second->compiled = true;
+            compile = true;
+        }
+    }
+    return compile;
+}
+
+// Every vkCmd* call appends a record to its command buffer's stream: the opcode, followed by the by-value parameters
+// after commandBuffer packed back to back, then the pointer and array parameters copied into the record. A command buffer
+// carves its records from a chain of blocks taken from its pool and gives the blocks back when it is reset, begun again
+// or freed, so recording only allocates while the command buffers of a pool together grow past their previous
+// high-water mark.
+struct CommandRecord {
+    CommandRecord* next;
+    CommandOpcode opcode;
+    uint32_t args_size;
+    uint32_t array_count;
+    // Packed arguments follow, then array_count VkmockCommandArray aligned to kRecordAlignment and the array data
+};
+
+static const size_t kRecordAlignment = 8;
+static size_t AlignRecordSize(size_t size) { return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1); }
+
+// Blocks of a command pool that none of its command buffers is using. Vulkan requires host access to a command pool and
+// to the command buffers allocated from it to be externally synchronized, so neither the pool nor the streams recording
+// into it need a lock.
+class CommandArena {
+  public:
+    static const size_t kBlockSize = 64 * 1024;
+    struct Block {
+        Block* next;
+        size_t size;  // kBlockSize, or more for a block made for a single larger record
+    };
+    // Records start after the block header
+    static const size_t kHeaderSize = (sizeof(Block) + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+
+    // Blocks come from the pool's allocation callbacks with command scope, if it has any
+    explicit CommandArena(const VkAllocationCallbacks* allocator)
+        : has_allocator_(allocator != nullptr), allocator_(allocator ? *allocator : VkAllocationCallbacks()) {}
+    CommandArena(const CommandArena&) = delete;
+    CommandArena& operator=(const CommandArena&) = delete;
+    ~CommandArena() { Release(); }
+
+    // Returns a block of at least size bytes, or nullptr when out of memory
+    Block* Take(size_t size) {
+        if (!free_ || free_->size < size) {
+            size = (std::max)(size, kBlockSize);
+            void* memory = has_allocator_ ? allocator_.pfnAllocation(allocator_.pUserData, size, kRecordAlignment,
+                                                                     VK_SYSTEM_ALLOCATION_SCOPE_COMMAND)
+                                          : ::operator new(size, std::nothrow);
+            if (!memory) return nullptr;
+            Block* block = static_cast<Block*>(memory);
+            block->size = size;
+            return block;
+        }
+        Block* block = free_;
+        free_ = block->next;
+        return block;
+    }
+    // Takes back a chain of blocks linked from first to last
+    void Give(Block* first, Block* last) {
+        last->next = free_;
+        free_ = first;
+    }
+    // Frees the blocks that are not in use
+    void Release() {
+        while (free_) {
+            Block* next = free_->next;
+            if (has_allocator_) {
+                allocator_.pfnFree(allocator_.pUserData, free_);
+            } else {
+                ::operator delete(free_);
+            }
+            free_ = next;
+        }
+    }
+
+  private:
+    bool has_allocator_;
+    VkAllocationCallbacks allocator_;
+    Block* free_ = nullptr;
+};
+
+struct CommandStream {
+    CommandArena* arena = nullptr;  // Arena of the pool, null if the pool is unknown
+    CommandArena::Block* first_block = nullptr;
+    CommandArena::Block* last_block = nullptr;
+    size_t offset = 0;  // Bytes used in last_block
+    CommandRecord* head = nullptr;
+    CommandRecord* tail = nullptr;
+    uint32_t count = 0;
+    bool out_of_memory = false;  // A record could not be allocated, so vkEndCommandBuffer fails
+};
+
+// Returns storage for size bytes, or nullptr when out of memory. A record that does not fit in a block gets a block of
+// its own.
+static void* AllocateCommandRecord(CommandStream& stream, size_t size) {
+    size = AlignRecordSize(size);
+    if (!stream.last_block || stream.offset + size > stream.last_block->size) {
+        auto* block = stream.arena->Take(CommandArena::kHeaderSize + size);
+        if (!block) {
+            stream.out_of_memory = true;
+            return nullptr;
+        }
+        block->next = nullptr;
+        if (stream.last_block) {
+            stream.last_block->next = block;
+        } else {
+            stream.first_block = block;
+        }
+        stream.last_block = block;
+        stream.offset = CommandArena::kHeaderSize;
+    }
+    void* result = reinterpret_cast<uint8_t*>(stream.last_block) + stream.offset;
+    stream.offset += size;
+    return result;
+}
+
+// Drops the records of a stream and gives its blocks back to the pool
+static void ResetCommandStream(CommandStream& stream) {
+    if (stream.first_block) stream.arena->Give(stream.first_block, stream.last_block);
+    stream.first_block = nullptr;
+    stream.last_block = nullptr;
+    stream.offset = 0;
+    stream.head = nullptr;
+    stream.tail = nullptr;
+    stream.count = 0;
+    stream.out_of_memory = false;
+}
+
+// State of a command buffer, kept in its dispatchable handle. Command buffers are externally synchronized like their
+// pool, so recording into one takes no lock.
+struct CommandBufferState {
+    DeviceState* device = nullptr;
+    CommandStream stream;
+    std::vector<QueueCommand> queue_commands;
+    PerformanceCounterValues counters = {};
+    bool has_active_query = false;
+    ActivePerformanceQuery active_query = {};
+};
+
+static CommandBufferState* GetCommandBufferState(VkCommandBuffer commandBuffer) {
+    return GetDispObjState<CommandBufferState>(commandBuffer);
+}
+
+static void CountCommand(VkCommandBuffer commandBuffer, PerformanceCounter counter, uint64_t amount = 1) {
+    GetCommandBufferState(commandBuffer)->counters[counter] += amount;
+}
+
+// A pointer or array parameter of a recorded command, copied into its record as count elements. The elements of the
+// application's array are stride bytes apart.
+template <typename T>
+struct CommandArray {
+    const char* name;
+    const T* data;
+    uint32_t count;
+    size_t stride;
+};
+
+template <typename T>
+static CommandArray<T> RecordArray(const char* name, const T* data, uint64_t count, size_t stride = sizeof(T)) {
+    return {name, data, data ? static_cast<uint32_t>(count) : 0u, stride};
+}
+
+static size_t RecordedStringLength(const char* string) { return string ? strlen(string) + 1 : 0; }
+
+class CommandDataWriter;
+
+// How the recorded copy of a structure is fixed up, so that nothing in a record points into the application's memory.
+// Structures with pointers specialize it with the generated commands: arrays they point to are copied after them and
+// their pointers redirected to the copies, while pNext chains and pointers that cannot be followed are cleared. Other
+// types are copied as they are.
+template <typename T>
+struct RecordedStruct {
+    static const bool kHasPointers = false;
+    static size_t NestedSize(const T&) { return 0; }
+    static void CopyNested(T&, CommandDataWriter&) {}
+};
+
+template <typename T>
+static const T& GetArrayElement(const T* data, size_t index, size_t stride) {
+    return *reinterpret_cast<const T*>(reinterpret_cast<const uint8_t*>(data) + index * stride);
+}
+
+// Bytes that copying an array takes in a record, including the arrays its elements point to
+template <typename T>
+static size_t RecordedArraySize(const T* data, size_t count, size_t stride = sizeof(T)) {
+    if (!data || !count) return 0;
+    size_t size = AlignRecordSize(sizeof(T) * count);
+    if (RecordedStruct<T>::kHasPointers) {
+        for (size_t i = 0; i < count; ++i) {
+            size += RecordedStruct<T>::NestedSize(GetArrayElement(data, i, stride));
+        }
+    }
+    return size;
+}
+
+// Copies arrays one after the other into the data of a record, which RecordedArraySize sized
+class CommandDataWriter {
+  public:
+    explicit CommandDataWriter(uint8_t* data) : data_(data) {}
+
+    template <typename T>
+    T* CopyArray(const T* data, size_t count, size_t stride = sizeof(T)) {
+        if (!data || !count) return nullptr;
+        T* copy = reinterpret_cast<T*>(data_);
+        data_ += AlignRecordSize(sizeof(T) * count);
+        if (stride == sizeof(T)) {
+            memcpy(copy, data, sizeof(T) * count);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                memcpy(copy + i, &GetArrayElement(data, i, stride), sizeof(T));
+            }
+        }
+        if (RecordedStruct<T>::kHasPointers) {
+            for (size_t i = 0; i < count; ++i) {
+                RecordedStruct<T>::CopyNested(copy[i], *this);
+            }
+        }
+        return copy;
+    }
+
+  private:
+    uint8_t* data_;
+};
+
+// Sizes of the parts of a record
+struct CommandRecordLayout {
+    size_t args_size = 0;
+    uint32_t array_count = 0;
+    size_t data_size = 0;
+};
+
+static void MeasureArgs(CommandRecordLayout&) {}
+template <typename T, typename... Args>
+static void MeasureArgs(CommandRecordLayout& layout, const CommandArray<T>& array, const Args&... args);
+template <typename T, typename... Args>
+static void MeasureArgs(CommandRecordLayout& layout, const T&, const Args&... args) {
+    layout.args_size += sizeof(T);
+    MeasureArgs(layout, args...);
+}
+template <typename T, typename... Args>
+static void MeasureArgs(CommandRecordLayout& layout, const CommandArray<T>& array, const Args&... args) {
+    ++layout.array_count;
+    layout.data_size += RecordedArraySize(array.data, array.count, array.stride);
+    MeasureArgs(layout, args...);
+}
+
+static void PackArgs(uint8_t*, VkmockCommandArray*, CommandDataWriter&) {}
+template <typename T, typename... Args>
+static void PackArgs(uint8_t* dst, VkmockCommandArray* arrays, CommandDataWriter& writer, const CommandArray<T>& array,
+                     const Args&... args);
+template <typename T, typename... Args>
+static void PackArgs(uint8_t* dst, VkmockCommandArray* arrays, CommandDataWriter& writer, const T& arg, const Args&... args) {
+    memcpy(dst, &arg, sizeof(T));
+    PackArgs(dst + sizeof(T), arrays, writer, args...);
+}
+template <typename T, typename... Args>
+static void PackArgs(uint8_t* dst, VkmockCommandArray* arrays, CommandDataWriter& writer, const CommandArray<T>& array,
+                     const Args&... args) {
+    arrays->pName = array.name;
+    arrays->count = array.count;
+    arrays->elementSize = sizeof(T);
+    arrays->pData = writer.CopyArray(array.data, array.count, array.stride);
+    PackArgs(dst, arrays + 1, writer, args...);
+}
+
+static const VkmockCommandArray* GetRecordedArrays(const CommandRecord* record) {
+    return reinterpret_cast<const VkmockCommandArray*>(reinterpret_cast<const uint8_t*>(record) +
+                                                       AlignRecordSize(sizeof(CommandRecord) + record->args_size));
+}
+
+// Appends a command to its command buffer's stream. Pointer and array parameters are passed through RecordArray.
+template <typename... Args>
+static void RecordCommand(VkCommandBuffer commandBuffer, CommandOpcode opcode, const Args&... args) {
+    auto& stream = GetCommandBufferState(commandBuffer)->stream;
+    if (!stream.arena) return;
+    CommandRecordLayout layout;
+    MeasureArgs(layout, args...);
+    const size_t arrays_offset = AlignRecordSize(sizeof(CommandRecord) + layout.args_size);
+    const size_t data_offset = arrays_offset + AlignRecordSize(layout.array_count * sizeof(VkmockCommandArray));
+    auto* record = static_cast<CommandRecord*>(AllocateCommandRecord(stream, data_offset + layout.data_size));
+    if (!record) return;
+    record->next = nullptr;
+    record->opcode = opcode;
+    record->args_size = static_cast<uint32_t>(layout.args_size);
+    record->array_count = layout.array_count;
+    auto* bytes = reinterpret_cast<uint8_t*>(record);
+    CommandDataWriter writer(bytes + data_offset);
+    PackArgs(reinterpret_cast<uint8_t*>(record + 1), reinterpret_cast<VkmockCommandArray*>(bytes + arrays_offset), writer,
+             args...);
+    if (stream.tail) {
+        stream.tail->next = record;
+    } else {
+        stream.head = record;
+    }
+    stream.tail = record;
+    ++stream.count;
+}
+
+static VkResult GetRecordedCommands(VkCommandBuffer commandBuffer, uint32_t* pCommandCount, VkmockCommand* pCommands) {
+    const auto& stream = GetCommandBufferState(commandBuffer)->stream;
+    if (!pCommands) {
+        *pCommandCount = stream.count;
+        return VK_SUCCESS;
+    }
+    uint32_t written = 0;
+    for (auto* record = stream.head; record && written < *pCommandCount; record = record->next) {
+        auto& command = pCommands[written++];
+        command.opcode = record->opcode;
+        command.pName = command_opcode_names[record->opcode];
+        command.argsSize = record->args_size;
+        command.pArgs = record + 1;
+        command.arrayCount = record->array_count;
+        command.pArrays = record->array_count ? GetRecordedArrays(record) : nullptr;
+    }
+    *pCommandCount = written;
+    return written < stream.count ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+// Appends the queue commands and GPU time of a command buffer to a batch
+static void AppendQueueCommands(QueueBatch& batch, VkCommandBuffer commandBuffer) {
+    static const uint64_t command_time_ns = GetEnvSize("VKMOCK_GPU_COMMAND_NS", 0);
+    const auto* state = GetCommandBufferState(commandBuffer);
+    batch.commands.insert(batch.commands.end(), state->queue_commands.begin(), state->queue_commands.end());
+    batch.gpu_time_ns += command_time_ns * state->stream.count;
+}
+
+// Drops everything recorded into a command buffer. The queue commands keep their storage and the blocks of the stream go
+// back to the pool, so recording the command buffer again does not allocate.
+static void ResetCommandBufferState(CommandBufferState& state) {
+    state.queue_commands.clear();
+    state.counters.fill(0);
+    state.has_active_query = false;
+    state.active_query.pool_state.reset();
+    ResetCommandStream(state.stream);
+}
+
+// Gives the blocks of a freed command buffer back to its pool and releases its state, which was allocated with the
+// pool's callbacks
+static void DestroyCommandBufferState(VkCommandBuffer commandBuffer, const VkAllocationCallbacks* pAllocator) {
+    auto* state = GetCommandBufferState(commandBuffer);
+    ResetCommandStream(state->stream);
+    DeleteObjectState(state, pAllocator);
+}
+
+// Reader-writer spin lock for short critical sections (std::shared_mutex needs C++17). A writer sets the writer bit,
+// which holds off new readers, then waits for the readers inside to leave.
+class RwSpinLock {
+  public:
+    void lock_shared() {
+        bool contended = false;
+        for (;;) {
+            uint32_t state = state_.load(std::memory_order_relaxed);
+            if (state & kWriter) {
+                Backoff(contended);
+            } else if (state_.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+    void unlock_shared() { state_.fetch_sub(1, std::memory_order_release); }
+    void lock() {
+        bool contended = false;
+        while (state_.fetch_or(kWriter, std::memory_order_acquire) & kWriter) Backoff(contended);
+        while (state_.load(std::memory_order_acquire) != kWriter) Backoff(contended);
+    }
+    void unlock() { state_.fetch_and(~kWriter, std::memory_order_release); }
+
+  private:
+    static const uint32_t kWriter = 1u << 31;
+    static void Backoff(bool& contended) {
+        if (!contended) {
+            contended = true;
+            CountLockContention();
+        }
+        std::this_thread::yield();
+    }
+    std::atomic<uint32_t> state_{0};
+};
+
+// Hash map split into independently locked shards, for object state that is read far more often than it changes.
+// Lookups copy the value out under one shard's shared lock, so they never wait on a device's lock, on other readers or
+// on writes to other shards. The shard locks are innermost: never take another lock while holding one.
+template <typename Key, typename Value>
+class ShardedMap {
+  public:
+    bool Find(Key key, Value* value) {
+        auto& shard = GetShard(key);
+        shard.lock.lock_shared();
+        const auto it = shard.map.find(key);
+        const bool found = it != shard.map.end();
+        if (found) *value = it->second;
+        shard.lock.unlock_shared();
+        return found;
+    }
+    void Insert(Key key, const Value& value) {
+        auto& shard = GetShard(key);
+        std::lock_guard<RwSpinLock> lock(shard.lock);
+        shard.map[key] = value;
+    }
+    void Erase(Key key) {
+        auto& shard = GetShard(key);
+        std::lock_guard<RwSpinLock> lock(shard.lock);
+        shard.map.erase(key);
+    }
+  private:
+    static const size_t kShardCount = 16;
+    struct alignas(64) Shard {
+        RwSpinLock lock;
+        unordered_map<Key, Value> map;
+    };
+    // Handles are mostly sequential, so consecutive objects land on different shards
+    Shard& GetShard(Key key) { return shards_[std::hash<Key>()(key) % kShardCount]; }
+    std::array<Shard, kShardCount> shards_;
+};
+
+struct BufferState {
+    VkDeviceSize size;
+    VkBufferCreateFlags flags;
+    VkBufferUsageFlags usage;
+};
+
+struct ImageState {
+    VkDeviceSize memory_size;
+    bool sparse;
+    bool linear;
+};
+
+// Buffer alignment by usage, in the range desktop drivers report: uniform and texel buffers need the most
+static VkDeviceSize GetBufferAlignment(VkBufferUsageFlags usage) {
+    if (usage & (VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT)) {
+        return 256;
+    }
+    if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) return 64;
+    return 16;
+}
+
+// Optimally tiled images of 64 KiB or more are aligned to 64 KiB, so they can be mapped with large pages
+static VkDeviceSize GetImageAlignment(const ImageState& state) {
+    if (state.sparse) return icd_sparse_page_size;
+    if (state.linear) return 256;
+    return state.memory_size >= 0x10000 ? 0x10000 : 4096;
 }
-static void DestroyDispObjHandle(void* handle) {
-    delete reinterpret_cast<VK_LOADER_DATA*>(handle);
+
+// Ranges of device memory bound to buffers and images, keyed by the resource handle
+struct MemoryBinding {
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    bool linear;  // A buffer or linear image, as opposed to an optimally tiled image
+};
+
+struct CommandPoolState {
+    std::vector<VkCommandBuffer> command_buffers;
+    // Effective allocation callbacks of the pool, used for the command buffers allocated from it
+    bool has_allocator = false;
+    VkAllocationCallbacks allocator = {};
+    std::unique_ptr<CommandArena> arena;
+};
+
+// Callbacks for a device child's host allocations: the object's own, else the device's, else nullptr (use the arena)
+static const VkAllocationCallbacks* GetChildAllocator(VkDevice device, const VkAllocationCallbacks* pAllocator) {
+    if (pAllocator) return pAllocator;
+    const auto* state = GetDeviceState(device);
+    return state && state->has_allocator ? &state->allocator : nullptr;
 }
-'''
 
-# Manual code at the top of the cpp source file
-SOURCE_CPP_PREFIX = '''
-using std::unordered_map;
+static DeviceArena* GetDeviceArena(VkDevice device) {
+    const auto* state = GetDeviceState(device);
+    return state ? state->arena.get() : nullptr;
+}
 
-static constexpr uint32_t icd_physical_device_count = 1;
-static constexpr uint32_t kSupportedVulkanAPIVersion = VK_API_VERSION_1_1;
-static unordered_map<VkInstance, std::array<VkPhysicalDevice, icd_physical_device_count>> physical_device_map;
+static constexpr uint32_t icd_swapchain_image_count = 1;
 
-// Map device memory handle to any mapped allocations that we'll need to free on unmap
-static unordered_map<VkDeviceMemory, std::vector<void*>> mapped_memory_map;
+// Simulated presentation engine. The display refreshes every VKMOCK_REFRESH_DURATION_NS on the monotonic clock and shows
+// one presented image per refresh, in FIFO order, no earlier than its desired present time.
+static const size_t icd_max_past_presentation_timings = 64;
+struct SwapchainPresentState {
+    uint64_t last_present_time = 0;
+    std::deque<VkPastPresentationTimingGOOGLE> past_timings;
+};
 
-// Map device memory allocation handle to the size
-static unordered_map<VkDeviceMemory, VkDeviceSize> allocated_memory_size_map;
+static uint64_t GetRefreshDurationNs() {
+    static const uint64_t refresh_duration = (std::max)(GetEnvSize("VKMOCK_REFRESH_DURATION_NS", 16666667), VkDeviceSize(1));
+    return refresh_duration;
+}
 
-static unordered_map<VkDevice, unordered_map<uint32_t, unordered_map<uint32_t, VkQueue>>> queue_map;
-static unordered_map<VkDevice, unordered_map<VkBuffer, VkBufferCreateInfo>> buffer_map;
-static unordered_map<VkDevice, unordered_map<VkImage, VkDeviceSize>> image_memory_size_map;
-static unordered_map<VkCommandPool, std::vector<VkCommandBuffer>> command_pool_buffer_map;
+// Returns the first refresh at or after a time
+static uint64_t GetNextRefreshTime(uint64_t time) {
+    const uint64_t refresh_duration = GetRefreshDurationNs();
+    return (time + refresh_duration - 1) / refresh_duration * refresh_duration;
+}
 
-static constexpr uint32_t icd_swapchain_image_count = 1;
-static unordered_map<VkSwapchainKHR, VkImage[icd_swapchain_image_count]> swapchain_image_map;
+// Schedules a presented image and sets when its refresh will happen. Returns false for a swapchain that is not among the
+// device's swapchain states. Must be called with the device's objects locked.
+static bool SchedulePresent(unordered_map<VkSwapchainKHR, SwapchainPresentState>& swapchain_states, VkSwapchainKHR swapchain,
+                            uint32_t present_id, uint64_t desired_present_time, uint64_t* present_time) {
+    const auto it = swapchain_states.find(swapchain);
+    if (it == swapchain_states.end()) return false;
+    auto& state = it->second;
+    const uint64_t now = GetMonotonicTimeNs();
+    VkPastPresentationTimingGOOGLE timing;
+    timing.presentID = present_id;
+    timing.desiredPresentTime = desired_present_time;
+    timing.earliestPresentTime = (std::max)(GetNextRefreshTime(now), state.last_present_time + GetRefreshDurationNs());
+    timing.actualPresentTime = (std::max)(timing.earliestPresentTime, GetNextRefreshTime(desired_present_time));
+    timing.presentMargin = timing.earliestPresentTime - now;
+    state.last_present_time = timing.actualPresentTime;
+    // Applications that never read their timings would otherwise grow the history without bound
+    if (state.past_timings.size() == icd_max_past_presentation_timings) state.past_timings.pop_front();
+    state.past_timings.push_back(timing);
+    *present_time = timing.actualPresentTime;
+    return true;
+}
+
+// Page table of a sparse resource: an ordered map of non-overlapping resource byte ranges to the device memory ranges
+// backing them. Adjacent ranges backed by contiguous bytes of the same allocation are coalesced, so binds, lookups and
+// unbinds are O(log n) in the number of discontiguous bound ranges.
+class SparsePageTable {
+  public:
+    void Bind(VkDeviceSize offset, VkDeviceSize size, VkDeviceMemory memory, VkDeviceSize memory_offset) {
+        if (size == 0) return;
+        const VkDeviceSize end = offset + size;
+        auto it = ranges_.lower_bound(offset);
+        // Split off the part of a preceding range that overlaps [offset, end)
+        if (it != ranges_.begin()) {
+            auto prev = std::prev(it);
+            if (prev->second.end > offset) {
+                if (prev->second.end > end) {
+                    ranges_.emplace_hint(it, end, Range{prev->second.end, prev->second.memory,
+                                                        prev->second.memory_offset + (end - prev->first)});
+                }
+                prev->second.end = offset;
+            }
+        }
+        // Drop ranges starting inside [offset, end), keeping the tail of one that extends past it
+        while (it != ranges_.end() && it->first < end) {
+            if (it->second.end > end) {
+                const Range tail = {it->second.end, it->second.memory, it->second.memory_offset + (end - it->first)};
+                it = ranges_.erase(it);
+                it = ranges_.emplace_hint(it, end, tail);
+                break;
+            }
+            it = ranges_.erase(it);
+        }
+        if (memory == VK_NULL_HANDLE) return;
+
+        VkDeviceSize start = offset;
+        VkDeviceSize start_memory_offset = memory_offset;
+        VkDeviceSize new_end = end;
+        if (it != ranges_.begin()) {
+            auto prev = std::prev(it);
+            if (prev->second.end == offset && prev->second.memory == memory &&
+                prev->second.memory_offset + (offset - prev->first) == memory_offset) {
+                start = prev->first;
+                start_memory_offset = prev->second.memory_offset;
+                ranges_.erase(prev);
+            }
+        }
+        if (it != ranges_.end() && it->first == end && it->second.memory == memory && it->second.memory_offset == memory_offset + size) {
+            new_end = it->second.end;
+            it = ranges_.erase(it);
+        }
+        ranges_.emplace_hint(it, start, Range{new_end, memory, start_memory_offset});
+    }
+
+    bool Resolve(VkDeviceSize offset, VkDeviceMemory* memory, VkDeviceSize* memory_offset) const {
+        auto it = ranges_.upper_bound(offset);
+        if (it == ranges_.begin()) return false;
+        --it;
+        if (offset >= it->second.end) return false;
+        *memory = it->second.memory;
+        *memory_offset = it->second.memory_offset + (offset - it->first);
+        return true;
+    }
+
+    VkDeviceSize GetResidentSize(VkDeviceSize offset, VkDeviceSize size) const {
+        const VkDeviceSize end = (size > UINT64_MAX - offset) ? UINT64_MAX : offset + size;
+        VkDeviceSize resident = 0;
+        auto it = ranges_.upper_bound(offset);
+        if (it != ranges_.begin()) --it;
+        for (; it != ranges_.end() && it->first < end; ++it) {
+            const VkDeviceSize overlap_begin = (std::max)(it->first, offset);
+            const VkDeviceSize overlap_end = (std::min)(it->second.end, end);
+            if (overlap_end > overlap_begin) resident += overlap_end - overlap_begin;
+        }
+        return resident;
+    }
+
+  private:
+    struct Range {
+        VkDeviceSize end;
+        VkDeviceMemory memory;
+        VkDeviceSize memory_offset;
+    };
+    std::map<VkDeviceSize, Range> ranges_;
+};
+
+// Opaque layout of a sparse residency image. Each tile of imageGranularity texels occupies one sparse page. Within an
+// array layer the tiles of the mip levels before the mip tail are stored level by level in row-major order, followed
+// by the layer's mip tail.
+struct SparseImageLayout {
+    VkImageAspectFlags aspect_mask;
+    VkExtent3D granularity;
+    VkExtent3D extent;
+    uint32_t mip_levels;
+    uint32_t array_layers;
+    uint32_t mip_tail_first_lod;
+    std::vector<VkDeviceSize> mip_offsets;
+    VkDeviceSize mip_tail_offset;
+    VkDeviceSize mip_tail_size;
+    VkDeviceSize layer_stride;
+};
+
+static uint32_t DivideRoundUp(uint32_t value, uint32_t divisor) { return (value + divisor - 1) / divisor; }
+
+static VkExtent3D GetMipExtent(const VkExtent3D& extent, uint32_t mip_level) {
+    return {(std::max)(extent.width >> mip_level, 1u), (std::max)(extent.height >> mip_level, 1u),
+            (std::max)(extent.depth >> mip_level, 1u)};
+}
+
+static VkImageAspectFlags GetSparseAspectMask(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_S8_UINT:
+            return VK_IMAGE_ASPECT_STENCIL_BIT;
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default:
+            return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+// Standard block shapes of a 64 KiB page holding 128-bit texels
+static VkExtent3D GetSparseImageGranularity(VkImageType type) {
+    switch (type) {
+        case VK_IMAGE_TYPE_1D:
+            return {4096, 1, 1};
+        case VK_IMAGE_TYPE_3D:
+            return {16, 16, 16};
+        default:
+            return {64, 64, 1};
+    }
+}
+
+static SparseImageLayout CreateSparseImageLayout(const VkImageCreateInfo* pCreateInfo) {
+    SparseImageLayout layout = {};
+    layout.aspect_mask = GetSparseAspectMask(pCreateInfo->format);
+    layout.granularity = GetSparseImageGranularity(pCreateInfo->imageType);
+    layout.extent = pCreateInfo->extent;
+    layout.mip_levels = pCreateInfo->mipLevels;
+    layout.array_layers = pCreateInfo->arrayLayers;
+    layout.mip_tail_first_lod = pCreateInfo->mipLevels;
+    VkDeviceSize offset = 0;
+    for (uint32_t mip = 0; mip < pCreateInfo->mipLevels; ++mip) {
+        const VkExtent3D mip_extent = GetMipExtent(pCreateInfo->extent, mip);
+        if (mip_extent.width < layout.granularity.width || mip_extent.height < layout.granularity.height ||
+            mip_extent.depth < layout.granularity.depth) {
+            layout.mip_tail_first_lod = mip;
+            break;
+        }
+        layout.mip_offsets.push_back(offset);
+        offset += icd_sparse_page_size * DivideRoundUp(mip_extent.width, layout.granularity.width) *
+                  DivideRoundUp(mip_extent.height, layout.granularity.height) *
+                  DivideRoundUp(mip_extent.depth, layout.granularity.depth);
+    }
+    layout.mip_tail_offset = offset;
+    layout.mip_tail_size = (layout.mip_tail_first_lod < layout.mip_levels) ? icd_sparse_page_size : 0;
+    layout.layer_stride = offset + layout.mip_tail_size;
+    return layout;
+}
+
+// Binds the tiles covered by a VkSparseImageMemoryBind. A row of tiles is contiguous both in the image's opaque layout
+// and in the bound memory, so each row is a single page table update.
+static void BindSparseImageTiles(SparsePageTable& page_table, const SparseImageLayout& layout, const VkSparseImageMemoryBind& bind) {
+    const uint32_t mip = bind.subresource.mipLevel;
+    if (mip >= layout.mip_tail_first_lod || bind.subresource.arrayLayer >= layout.array_layers) return;
+    const VkExtent3D mip_extent = GetMipExtent(layout.extent, mip);
+    const VkExtent3D& granularity = layout.granularity;
+    const uint32_t tiles_x = DivideRoundUp(mip_extent.width, granularity.width);
+    const uint32_t tiles_y = DivideRoundUp(mip_extent.height, granularity.height);
+    const uint32_t first_x = static_cast<uint32_t>(bind.offset.x) / granularity.width;
+    const uint32_t first_y = static_cast<uint32_t>(bind.offset.y) / granularity.height;
+    const uint32_t first_z = static_cast<uint32_t>(bind.offset.z) / granularity.depth;
+    const uint32_t count_x = DivideRoundUp(bind.extent.width, granularity.width);
+    const uint32_t count_y = DivideRoundUp(bind.extent.height, granularity.height);
+    const uint32_t count_z = DivideRoundUp(bind.extent.depth, granularity.depth);
+    const VkDeviceSize level_offset = layout.layer_stride * bind.subresource.arrayLayer + layout.mip_offsets[mip];
+    const VkDeviceSize row_size = icd_sparse_page_size * count_x;
+    VkDeviceSize memory_offset = bind.memoryOffset;
+    for (uint32_t z = first_z; z < first_z + count_z; ++z) {
+        for (uint32_t y = first_y; y < first_y + count_y; ++y) {
+            const VkDeviceSize tile_index = (static_cast<VkDeviceSize>(z) * tiles_y + y) * tiles_x + first_x;
+            page_table.Bind(level_offset + tile_index * icd_sparse_page_size, row_size, bind.memory, memory_offset);
+            if (bind.memory != VK_NULL_HANDLE) memory_offset += row_size;
+        }
+    }
+}
+
+// Claims size bytes of a heap's budget. Fails if the heap would exceed its budget.
+static bool ReserveHeapBytes(uint32_t heap_index, VkDeviceSize size) {
+    const VkDeviceSize budget = GetHeapBudget();
+    auto& usage = heap_usage[heap_index];
+    VkDeviceSize used = usage.load(std::memory_order_relaxed);
+    do {
+        if (size > budget || used > budget - size) return false;
+    } while (!usage.compare_exchange_weak(used, used + size, std::memory_order_relaxed));
+    icd_stats.heap_bytes_allocated[heap_index].fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+static void ReleaseHeapBytes(uint32_t heap_index, VkDeviceSize size) {
+    heap_usage[heap_index].fetch_sub(size, std::memory_order_relaxed);
+    icd_stats.heap_bytes_allocated[heap_index].fetch_sub(size, std::memory_order_relaxed);
+}
+
+// Returns the heap bytes and the contents of a device memory allocation
+static void ReleaseDeviceMemory(const DeviceMemoryState& state) {
+    ReleaseHeapBytes(state.heap_index, state.size);
+    if (state.data) {
+        if (state.fd >= 0) {
+            UnmapSharedMemory(state.data, state.size);
+        } else if (state.has_allocator) {
+            state.allocator.pfnFree(state.allocator.pUserData, state.allocation);
+        } else {
+            free(state.allocation);
+        }
+    }
+    if (state.fd >= 0) {
+        CloseFd(state.fd);
+    }
+}
+
+// Objects a device looks up by handle. Devices do not share them, so each device guards its own with its lock and calls
+// on different devices never contend. Buffers and images are looked up on every memory requirements query, so they stay
+// in sharded maps with locks of their own.
+struct DeviceObjects {
+    // Memory the application did not free is released with the device
+    ~DeviceObjects() {
+        for (const auto& pair : memories) ReleaseDeviceMemory(pair.second);
+    }
+
+    mutex_t lock;
+    unordered_map<VkDeviceMemory, DeviceMemoryState> memories;
+    // Ordered by start address for address to (memory, offset) lookups
+    std::map<VkDeviceAddress, DeviceAddressRange> addresses;
+    unordered_map<VkBuffer, BufferBinding> buffer_bindings;
+    unordered_map<VkDeviceMemory, unordered_map<uint64_t, MemoryBinding>> memory_bindings;
+    unordered_map<uint64_t, VkDeviceMemory> resource_memories;
+    // Sparse bindings of buffers and images, keyed by the resource handle
+    unordered_map<uint64_t, SparsePageTable> sparse_page_tables;
+    unordered_map<VkImage, SparseImageLayout> sparse_image_layouts;
+    unordered_map<VkCommandPool, CommandPoolState> command_pools;
+    // Number of descriptor sets allocated from each pool, which are freed implicitly when the pool is reset or destroyed
+    unordered_map<VkDescriptorPool, uint64_t> descriptor_pool_set_counts;
+    unordered_map<VkEvent, std::shared_ptr<EventState>> events;
+    ShardedMap<VkBuffer, BufferState> buffers;
+    ShardedMap<VkImage, ImageState> images;
+    // Only performance query pools are kept, so queries of other types find nothing after a shared lookup
+    ShardedMap<VkQueryPool, std::shared_ptr<PerformanceQueryPool>> performance_query_pools;
+    ShaderCodeCache shader_code;
+    unordered_map<VkDeferredOperationKHR, std::shared_ptr<DeferredOperationState>> deferred_operations;
+    unordered_map<VkSwapchainKHR, std::array<VkImage, icd_swapchain_image_count>> swapchain_images;
+    unordered_map<VkSwapchainKHR, SwapchainPresentState> swapchain_present_states;
+};
+
+static DeviceObjects& GetDeviceObjects(VkDevice device) { return *GetDeviceState(device)->objects; }
+
+// Returns the contents of a device memory allocation, allocating them on first use. Contents are aligned to
+// minMemoryMapAlignment. Must be called with the device's objects locked.
+static uint8_t* GetDeviceMemoryData(DeviceObjects& objects, VkDeviceMemory memory) {
+    static constexpr size_t alignment = 64;
+    const auto it = objects.memories.find(memory);
+    if (it == objects.memories.end()) return nullptr;
+    auto& state = it->second;
+    if (!state.data) {
+        if (state.fd >= 0) {
+            state.data = MapSharedMemory(state.fd, state.size);
+            state.allocation = state.data;
+        } else if (state.has_allocator && state.size <= SIZE_MAX) {
+            state.allocation = state.allocator.pfnAllocation(state.allocator.pUserData, static_cast<size_t>(state.size),
+                                                             alignment, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+            state.data = static_cast<uint8_t*>(state.allocation);
+        } else if (!state.has_allocator && state.size <= SIZE_MAX - alignment) {
+            state.allocation = malloc(static_cast<size_t>(state.size) + alignment - 1);
+            if (state.allocation) {
+                state.data = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(state.allocation) + alignment - 1) & ~(uintptr_t)(alignment - 1));
+            }
+        }
+        if (!state.data) return nullptr;
+        const VkDeviceAddress address = static_cast<VkDeviceAddress>(reinterpret_cast<uintptr_t>(state.data));
+        objects.addresses[address] = {address + state.size, memory};
+    }
+    return state.data;
+}
+
+static bool ResolveDeviceAddress(VkDevice device, VkDeviceAddress address, VkDeviceMemory* pMemory, VkDeviceSize* pOffset) {
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    auto it = objects.addresses.upper_bound(address);
+    if (it == objects.addresses.begin()) return false;
+    --it;
+    if (address >= it->second.end) return false;
+    *pMemory = it->second.memory;
+    *pOffset = address - it->first;
+    return true;
+}
+
+// Must be called with the device's objects locked
+static void RemoveMemoryBinding(DeviceObjects& objects, uint64_t resource) {
+    const auto it = objects.resource_memories.find(resource);
+    if (it == objects.resource_memories.end()) return;
+    objects.memory_bindings[it->second].erase(resource);
+    objects.resource_memories.erase(it);
+}
+
+// Must be called with the device's objects locked
+static void AddMemoryBinding(DeviceObjects& objects, VkDeviceMemory memory, uint64_t resource, const MemoryBinding& binding) {
+    RemoveMemoryBinding(objects, resource);
+    objects.memory_bindings[memory][resource] = binding;
+    objects.resource_memories[resource] = memory;
+}
+
+// Summarizes how the bindings of an allocation cover it. Bindings are swept in offset order while tracking the end of the
+// bytes covered so far: a binding starting past it leaves a free range, one starting before it aliases the binding that
+// reached it.
+static bool GetMemoryBindingReport(VkDevice device, VkDeviceMemory memory, VkmockMemoryBindingReport* pReport) {
+    std::vector<MemoryBinding> bindings;
+    VkDeviceSize size = 0;
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        const auto memory_it = objects.memories.find(memory);
+        if (memory_it == objects.memories.end()) return false;
+        size = memory_it->second.size;
+        const auto it = objects.memory_bindings.find(memory);
+        if (it != objects.memory_bindings.end()) {
+            for (const auto& pair : it->second) bindings.push_back(pair.second);
+        }
+    }
+    std::sort(bindings.begin(), bindings.end(), [](const MemoryBinding& a, const MemoryBinding& b) {
+        return a.offset != b.offset ? a.offset < b.offset : a.size < b.size;
+    });
+    *pReport = VkmockMemoryBindingReport();
+    pReport->size = size;
+    pReport->bindingCount = static_cast<uint32_t>(bindings.size());
+    std::vector<bool> aliased(bindings.size(), false);
+    VkDeviceSize covered_end = 0;
+    size_t covered_end_index = 0;
+    VkDeviceSize aliased_end = 0;
+    for (size_t i = 0; i < bindings.size(); ++i) {
+        const VkDeviceSize begin = (std::min)(bindings[i].offset, size);
+        const VkDeviceSize end = (std::min)(bindings[i].offset + bindings[i].size, size);
+        if (end <= begin) continue;
+        if (i > 0) {
+            const auto& previous = bindings[i - 1];
+            const VkDeviceSize previous_end = previous.offset + previous.size;
+            if (previous.linear != bindings[i].linear && previous.size > 0 && previous_end <= begin &&
+                (previous_end - 1) / icd_buffer_image_granularity == begin / icd_buffer_image_granularity) {
+                ++pReport->granularityConflictCount;
+            }
+        }
+        if (begin > covered_end) {
+            ++pReport->freeRangeCount;
+            pReport->largestFreeRange = (std::max)(pReport->largestFreeRange, begin - covered_end);
+        } else if (begin < covered_end) {
+            aliased[i] = true;
+            aliased[covered_end_index] = true;
+            // Count each aliased byte once, however many bindings share it
+            const VkDeviceSize overlap_begin = (std::max)(begin, aliased_end);
+            const VkDeviceSize overlap_end = (std::min)(end, covered_end);
+            if (overlap_end > overlap_begin) {
+                pReport->aliasedBytes += overlap_end - overlap_begin;
+                aliased_end = overlap_end;
+            }
+        }
+        if (end > covered_end) {
+            pReport->boundBytes += end - (std::max)(begin, covered_end);
+            covered_end = end;
+            covered_end_index = i;
+        }
+    }
+    if (covered_end < size) {
+        ++pReport->freeRangeCount;
+        pReport->largestFreeRange = (std::max)(pReport->largestFreeRange, size - covered_end);
+    }
+    pReport->freeBytes = size - pReport->boundBytes;
+    pReport->aliasedBindingCount = static_cast<uint32_t>(std::count(aliased.begin(), aliased.end(), true));
+    return true;
+}
+
+static const VkAllocationCallbacks* GetCommandPoolAllocator(DeviceObjects& objects, VkCommandPool command_pool) {
+    const auto it = objects.command_pools.find(command_pool);
+    return it != objects.command_pools.end() && it->second.has_allocator ? &it->second.allocator : nullptr;
+}
+
+static std::shared_ptr<EventState> GetEventState(DeviceObjects& objects, VkEvent event) {
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.events.find(event);
+    return it != objects.events.end() ? it->second : nullptr;
+}
+
+static std::shared_ptr<DeferredOperationState> GetDeferredOperationState(VkDevice device, VkDeferredOperationKHR operation) {
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.deferred_operations.find(operation);
+    return it != objects.deferred_operations.end() ? it->second : nullptr;
+}
+
+// Defers chunk_count chunks of work to the operation, or runs them on the calling thread if there is no operation.
+// Returns the result of the command that produced the work.
+static VkResult DeferWork(VkDevice device, VkDeferredOperationKHR operation, uint32_t chunk_count) {
+    const auto state = GetDeferredOperationState(device, operation);
+    if (state) {
+        state->chunk_count = chunk_count;
+        state->next_chunk.store(0, std::memory_order_relaxed);
+        state->finished_chunks.store(0, std::memory_order_relaxed);
+        return VK_OPERATION_DEFERRED_KHR;
+    }
+    for (uint32_t i = 0; i < chunk_count; ++i) {
+        CompilePipelineChunk();
+    }
+    return VK_SUCCESS;
+}
+
+static void RecordQueueCommand(VkCommandBuffer commandBuffer, QueueCommandType type, VkEvent event) {
+    auto* command_buffer_state = GetCommandBufferState(commandBuffer);
+    auto event_state = GetEventState(*command_buffer_state->device->objects, event);
+    if (!event_state) return;
+    command_buffer_state->queue_commands.push_back({type, std::move(event_state)});
+}
+
+static bool ResolveSparseAddress(VkDevice device, uint64_t resource, VkDeviceSize offset, VkDeviceMemory* pMemory,
+                                 VkDeviceSize* pMemoryOffset) {
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.sparse_page_tables.find(resource);
+    return it != objects.sparse_page_tables.end() && it->second.Resolve(offset, pMemory, pMemoryOffset);
+}
+
+static VkDeviceSize GetSparseResidentSize(VkDevice device, uint64_t resource, VkDeviceSize offset, VkDeviceSize size) {
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.sparse_page_tables.find(resource);
+    return it != objects.sparse_page_tables.end() ? it->second.GetResidentSize(offset, size) : 0;
+}
 
 // TODO: Would like to codegen this but limits aren't in XML
 static VkPhysicalDeviceLimits SetLimits(VkPhysicalDeviceLimits *limits) {
@@ -85,7 +2170,7 @@ static VkPhysicalDeviceLimits SetLimits(VkPhysicalDeviceLimits *limits) {
     limits->maxPushConstantsSize = 128;
     limits->maxMemoryAllocationCount = 4096;
     limits->maxSamplerAllocationCount = 4000;
-    limits->bufferImageGranularity = 1;
+    limits->bufferImageGranularity = icd_buffer_image_granularity;
     limits->sparseAddressSpaceSize = 2147483648;
     limits->maxBoundDescriptorSets = 4;
     limits->maxPerStageDescriptorSamplers = 16;
@@ -245,6 +2330,39 @@ EXPORT VKAPI_ATTR VkResult VKAPI_CALL vk_icdNegotiateLoaderICDInterfaceVersion(u
     return VK_SUCCESS;
 }
 
+EXPORT VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_ResolveSparseAddress(VkDevice device, uint64_t resource, VkDeviceSize offset,
+                                                                  VkDeviceMemory* pMemory, VkDeviceSize* pMemoryOffset) {
+    return vkmock::ResolveSparseAddress(device, resource, offset, pMemory, pMemoryOffset) ? VK_TRUE : VK_FALSE;
+}
+
+EXPORT VKAPI_ATTR VkDeviceSize VKAPI_CALL vkmock_GetSparseResidentSize(VkDevice device, uint64_t resource, VkDeviceSize offset,
+                                                                       VkDeviceSize size) {
+    return vkmock::GetSparseResidentSize(device, resource, offset, size);
+}
+
+EXPORT VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_ResolveDeviceAddress(VkDevice device, VkDeviceAddress address, VkDeviceMemory* pMemory,
+                                                                  VkDeviceSize* pOffset) {
+    return vkmock::ResolveDeviceAddress(device, address, pMemory, pOffset) ? VK_TRUE : VK_FALSE;
+}
+
+EXPORT VKAPI_ATTR const VkmockStats* VKAPI_CALL vkmock_GetStats() {
+    return reinterpret_cast<const VkmockStats*>(&vkmock::icd_stats);
+}
+
+EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkmock_GetRecordedCommands(VkCommandBuffer commandBuffer, uint32_t* pCommandCount,
+                                                                 VkmockCommand* pCommands) {
+    return vkmock::GetRecordedCommands(commandBuffer, pCommandCount, pCommands);
+}
+
+EXPORT VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_GetMemoryBindingReport(VkDevice device, VkDeviceMemory memory,
+                                                                   VkmockMemoryBindingReport* pReport) {
+    return vkmock::GetMemoryBindingReport(device, memory, pReport) ? VK_TRUE : VK_FALSE;
+}
+
+EXPORT VKAPI_ATTR VkBool32 VKAPI_CALL vkmock_SetHook(const char* pName, PFN_vkVoidFunction pfnHook) {
+    return vkmock::SetHook(pName, pfnHook) ? VK_TRUE : VK_FALSE;
+}
+
 
 EXPORT VKAPI_ATTR void VKAPI_CALL vkDestroySurfaceKHR(
     VkInstance                                  instance,
@@ -431,62 +2549,119 @@ CUSTOM_C_INTERCEPTS = {
     if (loader_interface_version <= 4) {
         return VK_ERROR_INCOMPATIBLE_DRIVER;
     }
-    *pInstance = (VkInstance)CreateDispObjHandle();
-    for (auto& physical_device : physical_device_map[*pInstance])
-        physical_device = (VkPhysicalDevice)CreateDispObjHandle();
+    auto* state = NewObjectState<InstanceState>(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (!state) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    *pInstance = (VkInstance)CreateDispObjHandle(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE, nullptr, state);
+    if (!*pInstance) {
+        DeleteObjectState(state, pAllocator);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    TrackObjects(VK_OBJECT_TYPE_INSTANCE, 1);
+    for (uint32_t i = 0; i < icd_physical_device_count; ++i) {
+        auto& physical_device = state->physical_devices[i];
+        physical_device = (VkPhysicalDevice)CreateDispObjHandle(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE, nullptr,
+                                                                &state->physical_device_states[i]);
+        if (!physical_device) {
+            DestroyInstance(*pInstance, pAllocator);
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
     // TODO: If emulating specific device caps, will need to add intelligence here
     return VK_SUCCESS;
 ''',
 'vkDestroyInstance': '''
     if (instance) {
-        for (const auto physical_device : physical_device_map.at(instance))
-            DestroyDispObjHandle((void*)physical_device);
-        physical_device_map.erase(instance);
-        DestroyDispObjHandle((void*)instance);
+        auto* state = GetInstanceState(instance);
+        for (const auto physical_device : state->physical_devices) {
+            DestroyDispObjHandle((void*)physical_device, pAllocator, nullptr);
+        }
+        DeleteObjectState(state, pAllocator);
+        DestroyDispObjHandle((void*)instance, pAllocator, nullptr);
+        TrackObjects(VK_OBJECT_TYPE_INSTANCE, -1);
+        // Whatever outlives the last instance has leaked
+        if (icd_stats.objects_alive[VK_OBJECT_TYPE_INSTANCE].load(std::memory_order_relaxed) == 0) WriteLeakReport();
     }
 ''',
 'vkAllocateCommandBuffers': '''
-    unique_lock_t lock(global_lock);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto* allocator = GetCommandPoolAllocator(objects, pAllocateInfo->commandPool);
+    auto* arena = GetDeviceArena(device);
+    const auto pool_it = objects.command_pools.find(pAllocateInfo->commandPool);
     for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; ++i) {
-        pCommandBuffers[i] = (VkCommandBuffer)CreateDispObjHandle();
-        command_pool_buffer_map[pAllocateInfo->commandPool].push_back(pCommandBuffers[i]);
+        auto* state = NewObjectState<CommandBufferState>(allocator, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+        pCommandBuffers[i] = state ? (VkCommandBuffer)CreateDispObjHandle(allocator, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT,
+                                                                          arena, state)
+                                   : VK_NULL_HANDLE;
+        if (!pCommandBuffers[i]) {
+            DeleteObjectState(state, allocator);
+            lock.unlock();
+            CallInternal(FreeCommandBuffers, device, pAllocateInfo->commandPool, i, pCommandBuffers);
+            for (uint32_t j = 0; j < pAllocateInfo->commandBufferCount; ++j) pCommandBuffers[j] = VK_NULL_HANDLE;
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+        TrackObjects(VK_OBJECT_TYPE_COMMAND_BUFFER, 1);
+        AddLiveObject("VkCommandBuffer", (uint64_t)pCommandBuffers[i]);
+        state->device = GetDeviceState(device);
+        if (pool_it != objects.command_pools.end()) {
+            pool_it->second.command_buffers.push_back(pCommandBuffers[i]);
+            state->stream.arena = pool_it->second.arena.get();
+        }
     }
     return VK_SUCCESS;
 ''',
 'vkFreeCommandBuffers': '''
-    unique_lock_t lock(global_lock);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto* allocator = GetCommandPoolAllocator(objects, commandPool);
+    auto* arena = GetDeviceArena(device);
+    const auto pool_it = objects.command_pools.find(commandPool);
     for (auto i = 0u; i < commandBufferCount; ++i) {
         if (!pCommandBuffers[i]) {
             continue;
         }
 
-        for (auto& pair : command_pool_buffer_map) {
-            auto& cbs = pair.second;
+        if (pool_it != objects.command_pools.end()) {
+            auto& cbs = pool_it->second.command_buffers;
             auto it = std::find(cbs.begin(), cbs.end(), pCommandBuffers[i]);
             if (it != cbs.end()) {
                 cbs.erase(it);
             }
         }
-            
-        DestroyDispObjHandle((void*) pCommandBuffers[i]);
+        DestroyCommandBufferState(pCommandBuffers[i], allocator);
+
+        DestroyDispObjHandle((void*) pCommandBuffers[i], allocator, arena);
+        TrackObjects(VK_OBJECT_TYPE_COMMAND_BUFFER, -1);
+        RemoveLiveObject((uint64_t)pCommandBuffers[i]);
     }
 ''',
 'vkDestroyCommandPool': '''
     // destroy command buffers for this pool
-    unique_lock_t lock(global_lock);
-    auto it = command_pool_buffer_map.find(commandPool);
-    if (it != command_pool_buffer_map.end()) {
-        for (auto& cb : it->second) {
-            DestroyDispObjHandle((void*) cb);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto* allocator = GetCommandPoolAllocator(objects, commandPool);
+    auto* arena = GetDeviceArena(device);
+    auto it = objects.command_pools.find(commandPool);
+    if (it != objects.command_pools.end()) {
+        const auto& command_buffers = it->second.command_buffers;
+        for (auto& cb : command_buffers) {
+            DestroyCommandBufferState(cb, allocator);
+            DestroyDispObjHandle((void*) cb, allocator, arena);
+            RemoveLiveObject((uint64_t)cb);
         }
-        command_pool_buffer_map.erase(it);
+        TrackObjects(VK_OBJECT_TYPE_COMMAND_BUFFER, -static_cast<int64_t>(command_buffers.size()));
+        objects.command_pools.erase(it);
     }
+    if (commandPool != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_COMMAND_POOL, -1);
+    RemoveLiveObject((uint64_t)commandPool);
 ''',
 'vkEnumeratePhysicalDevices': '''
     VkResult result_code = VK_SUCCESS;
     if (pPhysicalDevices) {
         const auto return_count = (std::min)(*pPhysicalDeviceCount, icd_physical_device_count);
-        for (uint32_t i = 0; i < return_count; ++i) pPhysicalDevices[i] = physical_device_map.at(instance)[i];
+        for (uint32_t i = 0; i < return_count; ++i) pPhysicalDevices[i] = GetInstanceState(instance)->physical_devices[i];
         if (return_count < icd_physical_device_count) result_code = VK_INCOMPLETE;
         *pPhysicalDeviceCount = return_count;
     } else {
@@ -495,40 +2670,95 @@ CUSTOM_C_INTERCEPTS = {
     return result_code;
 ''',
 'vkCreateDevice': '''
-    *pDevice = (VkDevice)CreateDispObjHandle();
+    auto* state = NewObjectState<DeviceState>(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+    if (!state) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    state->objects = NewObjectState<DeviceObjects>(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+    if (!state->objects) {
+        DeleteObjectState(state, pAllocator);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    auto* physical_device_state = GetPhysicalDeviceState(physicalDevice);
+    state->handle_space.ordinal =
+        GetDeviceHandleSpaceOrdinal(physical_device_state->handle_space.ordinal,
+                                    physical_device_state->device_count.fetch_add(1, std::memory_order_relaxed));
+    *pDevice = (VkDevice)CreateDispObjHandle(pAllocator, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE, nullptr, state);
+    if (!*pDevice) {
+        DeleteObjectState(state->objects, pAllocator);
+        DeleteObjectState(state, pAllocator);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    TrackObjects(VK_OBJECT_TYPE_DEVICE, 1);
+    AddLiveObject("VkDevice", (uint64_t)*pDevice);
+    if (pAllocator) {
+        state->has_allocator = true;
+        state->allocator = *pAllocator;
+    } else {
+        state->arena.reset(new DeviceArena(sizeof(DispatchableObject)));
+    }
+    state->timeline = &physical_device_state->timeline;
+    auto& priorities = state->queue_priorities;
+    for (uint32_t i = 0; i < pCreateInfo->queueCreateInfoCount; ++i) {
+        const auto& queue_info = pCreateInfo->pQueueCreateInfos[i];
+        const auto* global_priority_info = lvl_find_in_chain<VkDeviceQueueGlobalPriorityCreateInfoKHR>(queue_info.pNext);
+        const uint32_t global_priority =
+            GetGlobalPriorityRank(global_priority_info ? global_priority_info->globalPriority : VK_QUEUE_GLOBAL_PRIORITY_MEDIUM_KHR);
+        for (uint32_t j = 0; j < queue_info.queueCount; ++j) {
+            priorities[queue_info.queueFamilyIndex][j] = {global_priority, queue_info.pQueuePriorities[j]};
+        }
+    }
     // TODO: If emulating specific device caps, will need to add intelligence here
     return VK_SUCCESS;
 ''',
 'vkDestroyDevice': '''
-    unique_lock_t lock(global_lock);
+    auto* state = GetDeviceState(device);
+    if (!state) return;
     // First destroy sub-device objects
-    // Destroy Queues
-    for (auto queue_family_map_pair : queue_map[device]) {
-        for (auto index_queue_pair : queue_map[device][queue_family_map_pair.first]) {
-            DestroyDispObjHandle((void*)index_queue_pair.second);
+    // Destroy Queues, which stops their workers
+    const auto* allocator = GetChildAllocator(device, pAllocator);
+    for (const auto& family : state->queues) {
+        for (const auto& index_queue_pair : family.second) {
+            DeleteObjectState(GetQueueState(index_queue_pair.second), allocator);
+            DestroyDispObjHandle((void*)index_queue_pair.second, allocator, state->arena.get());
         }
     }
 
-    queue_map.erase(device);
-    buffer_map.erase(device);
-    image_memory_size_map.erase(device);
+    DeleteObjectState(state->objects, pAllocator);
+    DeleteObjectState(state, pAllocator);
     // Now destroy device
-    DestroyDispObjHandle((void*)device);
+    DestroyDispObjHandle((void*)device, pAllocator, nullptr);
+    TrackObjects(VK_OBJECT_TYPE_DEVICE, -1);
+    RemoveLiveObject((uint64_t)device);
     // TODO: If emulating specific device caps, will need to add intelligence here
 ''',
 'vkGetDeviceQueue': '''
-    unique_lock_t lock(global_lock);
-    auto queue = queue_map[device][queueFamilyIndex][queueIndex];
-    if (queue) {
-        *pQueue = queue;
-    } else {
-        *pQueue = queue_map[device][queueFamilyIndex][queueIndex] = (VkQueue)CreateDispObjHandle();
+    auto* state = GetDeviceState(device);
+    lock_guard_t lock(state->queue_lock);
+    auto& queue = state->queues[queueFamilyIndex][queueIndex];
+    if (!queue) {
+        // Queues missing from the create info run at the default priorities
+        QueuePriority priority = {GetGlobalPriorityRank(VK_QUEUE_GLOBAL_PRIORITY_MEDIUM_KHR), 1.0f};
+        const auto family = state->queue_priorities.find(queueFamilyIndex);
+        if (family != state->queue_priorities.end()) {
+            const auto it = family->second.find(queueIndex);
+            if (it != family->second.end()) priority = it->second;
+        }
+        const auto* allocator = GetChildAllocator(device, nullptr);
+        auto* queue_state = NewObjectState<QueueState>(allocator, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+        if (queue_state) {
+            queue_state->device = state;
+            queue_state->schedule = {state->timeline, priority, AllocateQueueOrdinal()};
+            queue = (VkQueue)CreateDispObjHandle(allocator, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE, state->arena.get(), queue_state);
+            if (!queue) DeleteObjectState(queue_state, allocator);
+        }
     }
+    *pQueue = queue;
     // TODO: If emulating specific device caps, will need to add intelligence here
     return;
 ''',
 'vkGetDeviceQueue2': '''
-    GetDeviceQueue(device, pQueueInfo->queueFamilyIndex, pQueueInfo->queueIndex, pQueue);
+    CallInternal(GetDeviceQueue, device, pQueueInfo->queueFamilyIndex, pQueueInfo->queueIndex, pQueue);
     // TODO: Add further support for GetDeviceQueue2 features
 ''',
 'vkEnumerateInstanceLayerProperties': '''
@@ -699,7 +2929,7 @@ CUSTOM_C_INTERCEPTS = {
     return VK_SUCCESS;
 ''',
 'vkGetPhysicalDeviceSurfaceCapabilities2KHR': '''
-    GetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, pSurfaceInfo->surface, &pSurfaceCapabilities->surfaceCapabilities);
+    CallInternal(GetPhysicalDeviceSurfaceCapabilitiesKHR, physicalDevice, pSurfaceInfo->surface, &pSurfaceCapabilities->surfaceCapabilities);
     return VK_SUCCESS;
 ''',
 'vkGetInstanceProcAddr': '''
@@ -717,19 +2947,32 @@ CUSTOM_C_INTERCEPTS = {
     return GetInstanceProcAddr(nullptr, pName);
 ''',
 'vkGetPhysicalDeviceMemoryProperties': '''
-    pMemoryProperties->memoryTypeCount = 2;
-    pMemoryProperties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    pMemoryProperties->memoryTypes[0].heapIndex = 0;
-    pMemoryProperties->memoryTypes[1].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    pMemoryProperties->memoryTypes[1].heapIndex = 1;
-    pMemoryProperties->memoryHeapCount = 2;
+    pMemoryProperties->memoryTypeCount = 4;
+    pMemoryProperties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    pMemoryProperties->memoryTypes[0].heapIndex = 1;
+    pMemoryProperties->memoryTypes[1].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    pMemoryProperties->memoryTypes[1].heapIndex = 0;
+    pMemoryProperties->memoryTypes[2].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+    pMemoryProperties->memoryTypes[2].heapIndex = 0;
+    pMemoryProperties->memoryTypes[3].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    pMemoryProperties->memoryTypes[3].heapIndex = 1;
+    pMemoryProperties->memoryHeapCount = icd_memory_heap_count;
     pMemoryProperties->memoryHeaps[0].flags = 0;
-    pMemoryProperties->memoryHeaps[0].size = 8000000000;
+    pMemoryProperties->memoryHeaps[0].size = icd_memory_heap_size;
     pMemoryProperties->memoryHeaps[1].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
-    pMemoryProperties->memoryHeaps[1].size = 8000000000;
+    pMemoryProperties->memoryHeaps[1].size = icd_memory_heap_size;
 ''',
 'vkGetPhysicalDeviceMemoryProperties2KHR': '''
-    GetPhysicalDeviceMemoryProperties(physicalDevice, &pMemoryProperties->memoryProperties);
+    CallInternal(GetPhysicalDeviceMemoryProperties, physicalDevice, &pMemoryProperties->memoryProperties);
+    auto *budget_props = lvl_find_mod_in_chain<VkPhysicalDeviceMemoryBudgetPropertiesEXT>(pMemoryProperties->pNext);
+    if (budget_props) {
+        const VkDeviceSize budget = GetHeapBudget();
+        for (uint32_t i = 0; i < VK_MAX_MEMORY_HEAPS; ++i) {
+            const bool valid_heap = i < pMemoryProperties->memoryProperties.memoryHeapCount;
+            budget_props->heapBudget[i] = valid_heap ? budget : 0;
+            budget_props->heapUsage[i] = valid_heap ? heap_usage[i].load(std::memory_order_relaxed) : 0;
+        }
+    }
 ''',
 'vkGetPhysicalDeviceQueueFamilyProperties': '''
     if (!pQueueFamilyProperties) {
@@ -737,7 +2980,7 @@ CUSTOM_C_INTERCEPTS = {
     } else {
         if (*pQueueFamilyPropertyCount) {
             pQueueFamilyProperties[0].queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT | VK_QUEUE_SPARSE_BINDING_BIT;
-            pQueueFamilyProperties[0].queueCount = 1;
+            pQueueFamilyProperties[0].queueCount = icd_queue_count;
             pQueueFamilyProperties[0].timestampValidBits = 0;
             pQueueFamilyProperties[0].minImageTransferGranularity = {1,1,1};
         }
@@ -745,9 +2988,17 @@ CUSTOM_C_INTERCEPTS = {
 ''',
 'vkGetPhysicalDeviceQueueFamilyProperties2KHR': '''
     if (pQueueFamilyPropertyCount && pQueueFamilyProperties) {
-        GetPhysicalDeviceQueueFamilyProperties(physicalDevice, pQueueFamilyPropertyCount, &pQueueFamilyProperties->queueFamilyProperties);
+        CallInternal(GetPhysicalDeviceQueueFamilyProperties, physicalDevice, pQueueFamilyPropertyCount, &pQueueFamilyProperties->queueFamilyProperties);
+        auto *global_priority_properties = lvl_find_mod_in_chain<VkQueueFamilyGlobalPriorityPropertiesKHR>(pQueueFamilyProperties->pNext);
+        if (*pQueueFamilyPropertyCount && global_priority_properties) {
+            global_priority_properties->priorityCount = 4;
+            global_priority_properties->priorities[0] = VK_QUEUE_GLOBAL_PRIORITY_LOW_KHR;
+            global_priority_properties->priorities[1] = VK_QUEUE_GLOBAL_PRIORITY_MEDIUM_KHR;
+            global_priority_properties->priorities[2] = VK_QUEUE_GLOBAL_PRIORITY_HIGH_KHR;
+            global_priority_properties->priorities[3] = VK_QUEUE_GLOBAL_PRIORITY_REALTIME_KHR;
+        }
     } else {
-        GetPhysicalDeviceQueueFamilyProperties(physicalDevice, pQueueFamilyPropertyCount, nullptr);
+        CallInternal(GetPhysicalDeviceQueueFamilyProperties, physicalDevice, pQueueFamilyPropertyCount, nullptr);
     }
 ''',
 'vkGetPhysicalDeviceFeatures': '''
@@ -756,7 +3007,7 @@ CUSTOM_C_INTERCEPTS = {
     SetBoolArrayTrue(bool_array, num_bools);
 ''',
 'vkGetPhysicalDeviceFeatures2KHR': '''
-    GetPhysicalDeviceFeatures(physicalDevice, &pFeatures->features);
+    CallInternal(GetPhysicalDeviceFeatures, physicalDevice, &pFeatures->features);
     uint32_t num_bools = 0; // Count number of VkBool32s in extension structs
     VkBool32* feat_bools = nullptr;
     const auto *desc_idx_features = lvl_find_in_chain<VkPhysicalDeviceDescriptorIndexingFeaturesEXT>(pFeatures->pNext);
@@ -773,6 +3024,22 @@ CUSTOM_C_INTERCEPTS = {
         feat_bools = (VkBool32*)&blendop_features->advancedBlendCoherentOperations;
         SetBoolArrayTrue(feat_bools, num_bools);
     }
+    auto *buffer_device_address_features = lvl_find_mod_in_chain<VkPhysicalDeviceBufferDeviceAddressFeatures>(pFeatures->pNext);
+    if (buffer_device_address_features) {
+        buffer_device_address_features->bufferDeviceAddress = VK_TRUE;
+        // Replaying captured addresses would need allocations placed at requested addresses
+        buffer_device_address_features->bufferDeviceAddressCaptureReplay = VK_FALSE;
+        buffer_device_address_features->bufferDeviceAddressMultiDevice = VK_FALSE;
+    }
+    auto *performance_query_features = lvl_find_mod_in_chain<VkPhysicalDevicePerformanceQueryFeaturesKHR>(pFeatures->pNext);
+    if (performance_query_features) {
+        performance_query_features->performanceCounterQueryPools = VK_TRUE;
+        performance_query_features->performanceCounterMultipleQueryPools = VK_TRUE;
+    }
+    auto *global_priority_query_features = lvl_find_mod_in_chain<VkPhysicalDeviceGlobalPriorityQueryFeaturesKHR>(pFeatures->pNext);
+    if (global_priority_query_features) {
+        global_priority_query_features->globalPriorityQuery = VK_TRUE;
+    }
 ''',
 'vkGetPhysicalDeviceFormatProperties': '''
     if (VK_FORMAT_UNDEFINED == format) {
@@ -797,7 +3064,7 @@ CUSTOM_C_INTERCEPTS = {
     }
 ''',
 'vkGetPhysicalDeviceFormatProperties2KHR': '''
-    GetPhysicalDeviceFormatProperties(physicalDevice, format, &pFormatProperties->formatProperties);
+    CallInternal(GetPhysicalDeviceFormatProperties, physicalDevice, format, &pFormatProperties->formatProperties);
     VkFormatProperties3KHR *props_3 = lvl_find_mod_in_chain<VkFormatProperties3KHR>(pFormatProperties->pNext);
     if (props_3) {
         props_3->linearTilingFeatures = pFormatProperties->formatProperties.linearTilingFeatures;
@@ -822,7 +3089,7 @@ CUSTOM_C_INTERCEPTS = {
     return VK_SUCCESS;
 ''',
 'vkGetPhysicalDeviceImageFormatProperties2KHR': '''
-    GetPhysicalDeviceImageFormatProperties(physicalDevice, pImageFormatInfo->format, pImageFormatInfo->type, pImageFormatInfo->tiling, pImageFormatInfo->usage, pImageFormatInfo->flags, &pImageFormatProperties->imageFormatProperties);
+    CallInternal(GetPhysicalDeviceImageFormatProperties, physicalDevice, pImageFormatInfo->format, pImageFormatInfo->type, pImageFormatInfo->tiling, pImageFormatInfo->usage, pImageFormatInfo->flags, &pImageFormatProperties->imageFormatProperties);
     return VK_SUCCESS;
 ''',
 'vkGetPhysicalDeviceProperties': '''
@@ -839,7 +3106,7 @@ CUSTOM_C_INTERCEPTS = {
     pProperties->sparseProperties = { VK_TRUE, VK_TRUE, VK_TRUE, VK_TRUE, VK_TRUE };
 ''',
 'vkGetPhysicalDeviceProperties2KHR': '''
-    GetPhysicalDeviceProperties(physicalDevice, &pProperties->properties);
+    CallInternal(GetPhysicalDeviceProperties, physicalDevice, &pProperties->properties);
     const auto *desc_idx_props = lvl_find_in_chain<VkPhysicalDeviceDescriptorIndexingPropertiesEXT>(pProperties->pNext);
     if (desc_idx_props) {
         VkPhysicalDeviceDescriptorIndexingPropertiesEXT* write_props = (VkPhysicalDeviceDescriptorIndexingPropertiesEXT*)desc_idx_props;
@@ -867,133 +3134,563 @@ CUSTOM_C_INTERCEPTS = {
         write_props->maxDescriptorSetUpdateAfterBindStorageImages = 500000;
         write_props->maxDescriptorSetUpdateAfterBindInputAttachments = 500000;
     }
-
-    const auto *push_descriptor_props = lvl_find_in_chain<VkPhysicalDevicePushDescriptorPropertiesKHR>(pProperties->pNext);
-    if (push_descriptor_props) {
-        VkPhysicalDevicePushDescriptorPropertiesKHR* write_props = (VkPhysicalDevicePushDescriptorPropertiesKHR*)push_descriptor_props;
-        write_props->maxPushDescriptors = 256;
+
+    const auto *push_descriptor_props = lvl_find_in_chain<VkPhysicalDevicePushDescriptorPropertiesKHR>(pProperties->pNext);
+    if (push_descriptor_props) {
+        VkPhysicalDevicePushDescriptorPropertiesKHR* write_props = (VkPhysicalDevicePushDescriptorPropertiesKHR*)push_descriptor_props;
+        write_props->maxPushDescriptors = 256;
+    }
+
+    const auto *depth_stencil_resolve_props = lvl_find_in_chain<VkPhysicalDeviceDepthStencilResolvePropertiesKHR>(pProperties->pNext);
+    if (depth_stencil_resolve_props) {
+        VkPhysicalDeviceDepthStencilResolvePropertiesKHR* write_props = (VkPhysicalDeviceDepthStencilResolvePropertiesKHR*)depth_stencil_resolve_props;
+        write_props->supportedDepthResolveModes = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT_KHR;
+        write_props->supportedStencilResolveModes = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT_KHR;
+    }
+
+    const auto *fragment_density_map2_props = lvl_find_in_chain<VkPhysicalDeviceFragmentDensityMap2PropertiesEXT>(pProperties->pNext);
+    if (fragment_density_map2_props) {
+        VkPhysicalDeviceFragmentDensityMap2PropertiesEXT* write_props = (VkPhysicalDeviceFragmentDensityMap2PropertiesEXT*)fragment_density_map2_props;
+        write_props->subsampledLoads = VK_FALSE;
+        write_props->subsampledCoarseReconstructionEarlyAccess = VK_FALSE;
+        write_props->maxSubsampledArrayLayers = 2;
+        write_props->maxDescriptorSetSubsampledSamplers = 1;
+    }
+''',
+'vkGetPhysicalDeviceExternalSemaphoreProperties':'''
+    // Hard code support for all handle types and features
+    pExternalSemaphoreProperties->exportFromImportedHandleTypes = 0x1F;
+    pExternalSemaphoreProperties->compatibleHandleTypes = 0x1F;
+    pExternalSemaphoreProperties->externalSemaphoreFeatures = 0x3;
+''',
+'vkGetPhysicalDeviceExternalSemaphorePropertiesKHR':'''
+    CallInternal(GetPhysicalDeviceExternalSemaphoreProperties, physicalDevice, pExternalSemaphoreInfo, pExternalSemaphoreProperties);
+''',
+'vkGetPhysicalDeviceExternalFenceProperties':'''
+    // Hard-code support for all handle types and features
+    pExternalFenceProperties->exportFromImportedHandleTypes = 0xF;
+    pExternalFenceProperties->compatibleHandleTypes = 0xF;
+    pExternalFenceProperties->externalFenceFeatures = 0x3;
+''',
+'vkGetPhysicalDeviceExternalFencePropertiesKHR':'''
+    CallInternal(GetPhysicalDeviceExternalFenceProperties, physicalDevice, pExternalFenceInfo, pExternalFenceProperties);
+''',
+'vkGetPhysicalDeviceExternalBufferProperties':'''
+    // Hard-code support for all handle types and features
+    pExternalBufferProperties->externalMemoryProperties.externalMemoryFeatures = 0x7;
+    pExternalBufferProperties->externalMemoryProperties.exportFromImportedHandleTypes = 0x1FF;
+    pExternalBufferProperties->externalMemoryProperties.compatibleHandleTypes = 0x1FF;
+''',
+'vkGetPhysicalDeviceExternalBufferPropertiesKHR':'''
+    CallInternal(GetPhysicalDeviceExternalBufferProperties, physicalDevice, pExternalBufferInfo, pExternalBufferProperties);
+''',
+'vkGetBufferMemoryRequirements': '''
+    pMemoryRequirements->size = 4096;
+    pMemoryRequirements->alignment = GetBufferAlignment(0);
+    pMemoryRequirements->memoryTypeBits = icd_buffer_memory_types;
+    BufferState state;
+    if (GetDeviceObjects(device).buffers.Find(buffer, &state)) {
+        VkDeviceSize alignment = GetBufferAlignment(state.usage);
+        if (state.flags & VK_BUFFER_CREATE_SPARSE_BINDING_BIT) {
+            alignment = icd_sparse_page_size;
+            pMemoryRequirements->memoryTypeBits = icd_device_local_memory_types;
+        }
+        pMemoryRequirements->size = ((state.size + alignment - 1) / alignment) * alignment;
+        pMemoryRequirements->alignment = alignment;
+    }
+''',
+'vkGetBufferMemoryRequirements2KHR': '''
+    CallInternal(GetBufferMemoryRequirements, device, pInfo->buffer, &pMemoryRequirements->memoryRequirements);
+''',
+'vkGetImageMemoryRequirements': '''
+    pMemoryRequirements->size = 0;
+    pMemoryRequirements->alignment = 1;
+    pMemoryRequirements->memoryTypeBits = icd_device_local_memory_types;
+
+    ImageState state;
+    if (GetDeviceObjects(device).images.Find(image, &state)) {
+        const VkDeviceSize alignment = GetImageAlignment(state);
+        pMemoryRequirements->size = ((state.memory_size + alignment - 1) / alignment) * alignment;
+        pMemoryRequirements->alignment = alignment;
+        if (state.linear && !state.sparse) pMemoryRequirements->memoryTypeBits = icd_linear_image_memory_types;
+    }
+''',
+'vkGetImageMemoryRequirements2KHR': '''
+    CallInternal(GetImageMemoryRequirements, device, pInfo->image, &pMemoryRequirements->memoryRequirements);
+''',
+'vkAllocateMemory': '''
+    const uint32_t heap_index = GetMemoryTypeHeapIndex(pAllocateInfo->memoryTypeIndex);
+    if (heap_index >= icd_memory_heap_count) {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    const VkDeviceSize size = pAllocateInfo->allocationSize;
+    if (!ReserveHeapBytes(heap_index, size)) {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    int fd = -1;
+    const auto *import_info = lvl_find_in_chain<VkImportMemoryFdInfoKHR>(pAllocateInfo->pNext);
+    const auto *export_info = lvl_find_in_chain<VkExportMemoryAllocateInfo>(pAllocateInfo->pNext);
+    const VkExternalMemoryHandleTypeFlags fd_handle_types =
+        VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT | VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+    if (import_info && (import_info->handleType & fd_handle_types)) {
+        // The imported file must hold the whole allocation. A successful import takes ownership of the descriptor.
+        if (import_info->fd < 0 || GetSharedMemoryFdSize(import_info->fd) < size) {
+            ReleaseHeapBytes(heap_index, size);
+            return VK_ERROR_INVALID_EXTERNAL_HANDLE;
+        }
+        fd = import_info->fd;
+    } else if (export_info && (export_info->handleTypes & fd_handle_types)) {
+        fd = CreateSharedMemoryFd("vkmock_device_memory", size);
+        if (fd < 0) {
+            ReleaseHeapBytes(heap_index, size);
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        }
+    }
+    *pMemory = (VkDeviceMemory)NewHandle(device, VK_OBJECT_TYPE_DEVICE_MEMORY);
+    TrackObjects(VK_OBJECT_TYPE_DEVICE_MEMORY, 1);
+    AddLiveObject("VkDeviceMemory", (uint64_t)*pMemory, size);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto* allocator = GetChildAllocator(device, pAllocator);
+    objects.memories[*pMemory] = {size, heap_index, nullptr, nullptr, fd, allocator != nullptr,
+                                  allocator ? *allocator : VkAllocationCallbacks()};
+    return VK_SUCCESS;
+''',
+'vkFreeMemory': '''
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.memories.find(memory);
+    if (it != objects.memories.end()) {
+        const auto& state = it->second;
+        TrackObjects(VK_OBJECT_TYPE_DEVICE_MEMORY, -1);
+        RemoveLiveObject((uint64_t)memory);
+        if (state.data) {
+            objects.addresses.erase(static_cast<VkDeviceAddress>(reinterpret_cast<uintptr_t>(state.data)));
+        }
+        ReleaseDeviceMemory(state);
+        // Resources bound to the memory outlive it, unbound
+        const auto binding_it = objects.memory_bindings.find(memory);
+        if (binding_it != objects.memory_bindings.end()) {
+            for (const auto& pair : binding_it->second) objects.resource_memories.erase(pair.first);
+            objects.memory_bindings.erase(binding_it);
+        }
+        objects.memories.erase(it);
+    }
+''',
+'vkGetImageSparseMemoryRequirements': '''
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.sparse_image_layouts.find(image);
+    if (it == objects.sparse_image_layouts.end()) {
+        *pSparseMemoryRequirementCount = 0;
+        return;
+    }
+    if (!pSparseMemoryRequirements) {
+        *pSparseMemoryRequirementCount = 1;
+        return;
+    }
+    if (*pSparseMemoryRequirementCount == 0) {
+        return;
+    }
+    const auto& layout = it->second;
+    pSparseMemoryRequirements[0].formatProperties.aspectMask = layout.aspect_mask;
+    pSparseMemoryRequirements[0].formatProperties.imageGranularity = layout.granularity;
+    pSparseMemoryRequirements[0].formatProperties.flags = 0;
+    pSparseMemoryRequirements[0].imageMipTailFirstLod = layout.mip_tail_first_lod;
+    pSparseMemoryRequirements[0].imageMipTailSize = layout.mip_tail_size;
+    pSparseMemoryRequirements[0].imageMipTailOffset = layout.mip_tail_offset;
+    pSparseMemoryRequirements[0].imageMipTailStride = layout.layer_stride;
+    *pSparseMemoryRequirementCount = 1;
+''',
+'vkGetImageSparseMemoryRequirements2KHR': '''
+    if (pSparseMemoryRequirements && *pSparseMemoryRequirementCount) {
+        CallInternal(GetImageSparseMemoryRequirements, device, pInfo->image, pSparseMemoryRequirementCount, &pSparseMemoryRequirements->memoryRequirements);
+    } else {
+        CallInternal(GetImageSparseMemoryRequirements, device, pInfo->image, pSparseMemoryRequirementCount, nullptr);
+    }
+''',
+'vkGetPhysicalDeviceSparseImageFormatProperties': '''
+    // Sparse residency is supported for single-sampled, optimally tiled images of every format
+    if (tiling != VK_IMAGE_TILING_OPTIMAL || samples != VK_SAMPLE_COUNT_1_BIT) {
+        *pPropertyCount = 0;
+        return;
+    }
+    if (!pProperties) {
+        *pPropertyCount = 1;
+        return;
+    }
+    if (*pPropertyCount == 0) {
+        return;
+    }
+    pProperties[0].aspectMask = GetSparseAspectMask(format);
+    pProperties[0].imageGranularity = GetSparseImageGranularity(type);
+    pProperties[0].flags = 0;
+    *pPropertyCount = 1;
+''',
+'vkGetPhysicalDeviceSparseImageFormatProperties2KHR': '''
+    if (pProperties && *pPropertyCount) {
+        CallInternal(GetPhysicalDeviceSparseImageFormatProperties, physicalDevice, pFormatInfo->format, pFormatInfo->type, pFormatInfo->samples,
+                                                     pFormatInfo->usage, pFormatInfo->tiling, pPropertyCount, &pProperties->properties);
+    } else {
+        CallInternal(GetPhysicalDeviceSparseImageFormatProperties, physicalDevice, pFormatInfo->format, pFormatInfo->type, pFormatInfo->samples,
+                                                     pFormatInfo->usage, pFormatInfo->tiling, pPropertyCount, nullptr);
+    }
+''',
+'vkQueueBindSparse': '''
+    auto& objects = *GetQueueState(queue)->device->objects;
+    unique_lock_t lock(objects.lock);
+    for (uint32_t i = 0; i < bindInfoCount; ++i) {
+        const auto& bind_info = pBindInfo[i];
+        for (uint32_t j = 0; j < bind_info.bufferBindCount; ++j) {
+            const auto& buffer_bind = bind_info.pBufferBinds[j];
+            auto& page_table = objects.sparse_page_tables[(uint64_t)buffer_bind.buffer];
+            for (uint32_t k = 0; k < buffer_bind.bindCount; ++k) {
+                const auto& bind = buffer_bind.pBinds[k];
+                page_table.Bind(bind.resourceOffset, bind.size, bind.memory, bind.memoryOffset);
+            }
+        }
+        for (uint32_t j = 0; j < bind_info.imageOpaqueBindCount; ++j) {
+            const auto& opaque_bind = bind_info.pImageOpaqueBinds[j];
+            auto& page_table = objects.sparse_page_tables[(uint64_t)opaque_bind.image];
+            for (uint32_t k = 0; k < opaque_bind.bindCount; ++k) {
+                const auto& bind = opaque_bind.pBinds[k];
+                // No metadata aspect is reported, so metadata binds have nothing to back
+                if (bind.flags & VK_SPARSE_MEMORY_BIND_METADATA_BIT) continue;
+                page_table.Bind(bind.resourceOffset, bind.size, bind.memory, bind.memoryOffset);
+            }
+        }
+        for (uint32_t j = 0; j < bind_info.imageBindCount; ++j) {
+            const auto& image_bind = bind_info.pImageBinds[j];
+            const auto layout = objects.sparse_image_layouts.find(image_bind.image);
+            if (layout == objects.sparse_image_layouts.end()) continue;
+            auto& page_table = objects.sparse_page_tables[(uint64_t)image_bind.image];
+            for (uint32_t k = 0; k < image_bind.bindCount; ++k) {
+                BindSparseImageTiles(page_table, layout->second, image_bind.pBinds[k]);
+            }
+        }
+    }
+    return VK_SUCCESS;
+''',
+'vkMapMemory': '''
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    // Mapping exposes the memory contents themselves, so writes through the mapping are seen at the device address
+    uint8_t* data = GetDeviceMemoryData(objects, memory);
+    if (!data) {
+        return VK_ERROR_MEMORY_MAP_FAILED;
+    }
+    *ppData = data + offset;
+    return VK_SUCCESS;
+''',
+'vkUnmapMemory': '''
+    // Contents stay allocated until the memory is freed
+''',
+'vkBindBufferMemory': '''
+    VkMemoryRequirements requirements;
+    CallInternal(GetBufferMemoryRequirements, device, buffer, &requirements);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.buffer_bindings[buffer] = {memory, memoryOffset};
+    AddMemoryBinding(objects, memory, (uint64_t)buffer, {memoryOffset, requirements.size, true});
+    return VK_SUCCESS;
+''',
+'vkBindBufferMemory2KHR': '''
+    for (uint32_t i = 0; i < bindInfoCount; ++i) {
+        CallInternal(BindBufferMemory, device, pBindInfos[i].buffer, pBindInfos[i].memory, pBindInfos[i].memoryOffset);
+    }
+    return VK_SUCCESS;
+''',
+'vkBindImageMemory': '''
+    VkMemoryRequirements requirements;
+    CallInternal(GetImageMemoryRequirements, device, image, &requirements);
+    auto& objects = GetDeviceObjects(device);
+    ImageState state;
+    const bool linear = objects.images.Find(image, &state) && state.linear;
+    unique_lock_t lock(objects.lock);
+    AddMemoryBinding(objects, memory, (uint64_t)image, {memoryOffset, requirements.size, linear});
+    return VK_SUCCESS;
+''',
+'vkBindImageMemory2KHR': '''
+    for (uint32_t i = 0; i < bindInfoCount; ++i) {
+        CallInternal(BindImageMemory, device, pBindInfos[i].image, pBindInfos[i].memory, pBindInfos[i].memoryOffset);
     }
-
-    const auto *depth_stencil_resolve_props = lvl_find_in_chain<VkPhysicalDeviceDepthStencilResolvePropertiesKHR>(pProperties->pNext);
-    if (depth_stencil_resolve_props) {
-        VkPhysicalDeviceDepthStencilResolvePropertiesKHR* write_props = (VkPhysicalDeviceDepthStencilResolvePropertiesKHR*)depth_stencil_resolve_props;
-        write_props->supportedDepthResolveModes = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT_KHR;
-        write_props->supportedStencilResolveModes = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT_KHR;
+    return VK_SUCCESS;
+''',
+'vkGetMemoryFdKHR': '''
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.memories.find(pGetFdInfo->memory);
+    // Only memory allocated with VkExportMemoryAllocateInfo or imported from a file descriptor has one to share
+    if (it == objects.memories.end() || it->second.fd < 0) {
+        return VK_ERROR_TOO_MANY_OBJECTS;
     }
-
-    const auto *fragment_density_map2_props = lvl_find_in_chain<VkPhysicalDeviceFragmentDensityMap2PropertiesEXT>(pProperties->pNext);
-    if (fragment_density_map2_props) {
-        VkPhysicalDeviceFragmentDensityMap2PropertiesEXT* write_props = (VkPhysicalDeviceFragmentDensityMap2PropertiesEXT*)fragment_density_map2_props;
-        write_props->subsampledLoads = VK_FALSE;
-        write_props->subsampledCoarseReconstructionEarlyAccess = VK_FALSE;
-        write_props->maxSubsampledArrayLayers = 2;
-        write_props->maxDescriptorSetSubsampledSamplers = 1;
+    *pFd = DuplicateFd(it->second.fd);
+    return *pFd >= 0 ? VK_SUCCESS : VK_ERROR_TOO_MANY_OBJECTS;
+''',
+'vkGetMemoryFdPropertiesKHR': '''
+    // Opaque file descriptors cannot be queried: their memory types are those of the allocation that exported them
+    if (handleType == VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT || fd < 0 || GetSharedMemoryFdSize(fd) == 0) {
+        return VK_ERROR_INVALID_EXTERNAL_HANDLE;
     }
+    VkPhysicalDeviceMemoryProperties memory_properties;
+    CallInternal(GetPhysicalDeviceMemoryProperties, VK_NULL_HANDLE, &memory_properties);
+    pMemoryFdProperties->memoryTypeBits = (1u << memory_properties.memoryTypeCount) - 1;
+    return VK_SUCCESS;
 ''',
-'vkGetPhysicalDeviceExternalSemaphoreProperties':'''
-    // Hard code support for all handle types and features
-    pExternalSemaphoreProperties->exportFromImportedHandleTypes = 0x1F;
-    pExternalSemaphoreProperties->compatibleHandleTypes = 0x1F;
-    pExternalSemaphoreProperties->externalSemaphoreFeatures = 0x3;
+'vkDestroySemaphore': '''
+    auto* state = GetDeviceState(device);
+    lock_guard_t lock(state->sync_lock);
+    const auto it = state->semaphore_fds.find(semaphore);
+    if (it != state->semaphore_fds.end()) {
+        if (it->second.permanent_fd >= 0) CloseFd(it->second.permanent_fd);
+        if (it->second.temporary_fd >= 0) CloseFd(it->second.temporary_fd);
+        state->semaphore_fds.erase(it);
+    }
+    if (semaphore != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_SEMAPHORE, -1);
+    RemoveLiveObject((uint64_t)semaphore);
 ''',
-'vkGetPhysicalDeviceExternalSemaphorePropertiesKHR':'''
-    GetPhysicalDeviceExternalSemaphoreProperties(physicalDevice, pExternalSemaphoreInfo, pExternalSemaphoreProperties);
+'vkGetSemaphoreFdKHR': '''
+    if (pGetFdInfo->handleType == VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT) {
+        *pFd = CreateSemaphoreFd(1);
+        return *pFd >= 0 ? VK_SUCCESS : VK_ERROR_TOO_MANY_OBJECTS;
+    }
+    auto* device_state = GetDeviceState(device);
+    lock_guard_t lock(device_state->sync_lock);
+    auto& state = GetSemaphoreFdState(*device_state, pGetFdInfo->semaphore);
+    if (state.permanent_fd < 0) {
+        state.permanent_fd = CreateSemaphoreFd(0);
+        if (state.permanent_fd < 0) {
+            return VK_ERROR_TOO_MANY_OBJECTS;
+        }
+    }
+    *pFd = DuplicateFd(state.permanent_fd);
+    return *pFd >= 0 ? VK_SUCCESS : VK_ERROR_TOO_MANY_OBJECTS;
 ''',
-'vkGetPhysicalDeviceExternalFenceProperties':'''
-    // Hard-code support for all handle types and features
-    pExternalFenceProperties->exportFromImportedHandleTypes = 0xF;
-    pExternalFenceProperties->compatibleHandleTypes = 0xF;
-    pExternalFenceProperties->externalFenceFeatures = 0x3;
+'vkImportSemaphoreFdKHR': '''
+    auto* device_state = GetDeviceState(device);
+    lock_guard_t lock(device_state->sync_lock);
+    auto& state = GetSemaphoreFdState(*device_state, pImportSemaphoreFdInfo->semaphore);
+    const bool sync_fd = pImportSemaphoreFdInfo->handleType == VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT;
+    if (sync_fd || (pImportSemaphoreFdInfo->flags & VK_SEMAPHORE_IMPORT_TEMPORARY_BIT)) {
+        if (state.temporary_fd >= 0) CloseFd(state.temporary_fd);
+        state.has_temporary_payload = true;
+        state.temporary_fd = pImportSemaphoreFdInfo->fd;
+        state.temporary_is_sync_fd = sync_fd;
+    } else {
+        if (state.permanent_fd >= 0) CloseFd(state.permanent_fd);
+        state.permanent_fd = pImportSemaphoreFdInfo->fd;
+    }
+    return VK_SUCCESS;
 ''',
-'vkGetPhysicalDeviceExternalFencePropertiesKHR':'''
-    GetPhysicalDeviceExternalFenceProperties(physicalDevice, pExternalFenceInfo, pExternalFenceProperties);
+'vkQueueSubmit': '''
+    // Semaphores only have an effect with external payloads: a wait blocks the queue until the payload is signaled,
+    // possibly by another process, and a signal releases one waiter.
+    std::vector<QueueBatch> batches(submitCount);
+    for (uint32_t i = 0; i < submitCount; ++i) {
+        const auto& submit = pSubmits[i];
+        batches[i].wait_semaphores.assign(submit.pWaitSemaphores, submit.pWaitSemaphores + submit.waitSemaphoreCount);
+        for (uint32_t j = 0; j < submit.commandBufferCount; ++j) {
+            AppendQueueCommands(batches[i], submit.pCommandBuffers[j]);
+        }
+        batches[i].signal_semaphores.assign(submit.pSignalSemaphores, submit.pSignalSemaphores + submit.signalSemaphoreCount);
+    }
+    SubmitToQueue(queue, batches, fence);
+    return VK_SUCCESS;
 ''',
-'vkGetPhysicalDeviceExternalBufferProperties':'''
-    // Hard-code support for all handle types and features
-    pExternalBufferProperties->externalMemoryProperties.externalMemoryFeatures = 0x7;
-    pExternalBufferProperties->externalMemoryProperties.exportFromImportedHandleTypes = 0x1FF;
-    pExternalBufferProperties->externalMemoryProperties.compatibleHandleTypes = 0x1FF;
+'vkQueueSubmit2KHR': '''
+    std::vector<QueueBatch> batches(submitCount);
+    for (uint32_t i = 0; i < submitCount; ++i) {
+        const auto& submit = pSubmits[i];
+        for (uint32_t j = 0; j < submit.waitSemaphoreInfoCount; ++j) {
+            batches[i].wait_semaphores.push_back(submit.pWaitSemaphoreInfos[j].semaphore);
+        }
+        for (uint32_t j = 0; j < submit.commandBufferInfoCount; ++j) {
+            AppendQueueCommands(batches[i], submit.pCommandBufferInfos[j].commandBuffer);
+        }
+        for (uint32_t j = 0; j < submit.signalSemaphoreInfoCount; ++j) {
+            batches[i].signal_semaphores.push_back(submit.pSignalSemaphoreInfos[j].semaphore);
+        }
+    }
+    SubmitToQueue(queue, batches, fence);
+    return VK_SUCCESS;
 ''',
-'vkGetPhysicalDeviceExternalBufferPropertiesKHR':'''
-    GetPhysicalDeviceExternalBufferProperties(physicalDevice, pExternalBufferInfo, pExternalBufferProperties);
+'vkQueueWaitIdle': '''
+    WaitQueueIdle(queue);
+    return VK_SUCCESS;
 ''',
-'vkGetBufferMemoryRequirements': '''
-    // TODO: Just hard-coding reqs for now
-    pMemoryRequirements->size = 4096;
-    pMemoryRequirements->alignment = 1;
-    pMemoryRequirements->memoryTypeBits = 0xFFFF;
-    // Return a better size based on the buffer size from the create info.
-    auto d_iter = buffer_map.find(device);
-    if (d_iter != buffer_map.end()) {
-        auto iter = d_iter->second.find(buffer);
-        if (iter != d_iter->second.end()) {
-            pMemoryRequirements->size = ((iter->second.size + 4095) / 4096) * 4096;
+'vkDeviceWaitIdle': '''
+    auto* state = GetDeviceState(device);
+    std::vector<VkQueue> queues;
+    {
+        lock_guard_t lock(state->queue_lock);
+        for (const auto& family : state->queues) {
+            for (const auto& index_queue_pair : family.second) {
+                queues.push_back(index_queue_pair.second);
+            }
         }
     }
+    for (const auto queue : queues) {
+        WaitQueueIdle(queue);
+    }
+    return VK_SUCCESS;
 ''',
-'vkGetBufferMemoryRequirements2KHR': '''
-    GetBufferMemoryRequirements(device, pInfo->buffer, &pMemoryRequirements->memoryRequirements);
+'vkGetFenceStatus': '''
+    auto* state = GetDeviceState(device);
+    lock_guard_t lock(state->sync_lock);
+    return state->pending_fences.count(fence) ? VK_NOT_READY : VK_SUCCESS;
 ''',
-'vkGetImageMemoryRequirements': '''
-    pMemoryRequirements->size = 0;
-    pMemoryRequirements->alignment = 1;
-
-    auto d_iter = image_memory_size_map.find(device);
-    if(d_iter != image_memory_size_map.end()){
-        auto iter = d_iter->second.find(image);
-        if (iter != d_iter->second.end()) {
-            pMemoryRequirements->size = iter->second;
+'vkWaitForFences': '''
+    auto* state = GetDeviceState(device);
+    unique_lock_t lock(state->sync_lock);
+    const auto signaled = [&]() {
+        uint32_t signaled_count = 0;
+        for (uint32_t i = 0; i < fenceCount; ++i) {
+            if (!state->pending_fences.count(pFences[i])) ++signaled_count;
         }
+        return waitAll ? signaled_count == fenceCount : signaled_count > 0;
+    };
+    if (timeout == UINT64_MAX) {
+        state->fence_cv.wait(lock, signaled);
+        return VK_SUCCESS;
     }
-    // Here we hard-code that the memory type at index 3 doesn't support this image.
-    pMemoryRequirements->memoryTypeBits = 0xFFFF & ~(0x1 << 3);
+    const auto wait_time = std::chrono::nanoseconds(static_cast<int64_t>((std::min)(timeout, static_cast<uint64_t>(INT64_MAX / 2))));
+    return state->fence_cv.wait_for(lock, wait_time, signaled) ? VK_SUCCESS : VK_TIMEOUT;
 ''',
-'vkGetImageMemoryRequirements2KHR': '''
-    GetImageMemoryRequirements(device, pInfo->image, &pMemoryRequirements->memoryRequirements);
+'vkCreateEvent': '''
+    *pEvent = (VkEvent)NewHandle(device, VK_OBJECT_TYPE_EVENT);
+    TrackObjects(VK_OBJECT_TYPE_EVENT, 1);
+    AddLiveObject("VkEvent", (uint64_t)*pEvent);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.events[*pEvent] = std::make_shared<EventState>(false);
+    return VK_SUCCESS;
 ''',
-'vkMapMemory': '''
-    unique_lock_t lock(global_lock);
-    if (VK_WHOLE_SIZE == size) {
-        if (allocated_memory_size_map.count(memory) != 0)
-            size = allocated_memory_size_map[memory] - offset;
-        else
-            size = 0x10000;
-    }
-    void* map_addr = malloc((size_t)size);
-    mapped_memory_map[memory].push_back(map_addr);
-    *ppData = map_addr;
+'vkDestroyEvent': '''
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        objects.events.erase(event);
+    }
+    if (event != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_EVENT, -1);
+    RemoveLiveObject((uint64_t)event);
+''',
+'vkGetEventStatus': '''
+    const auto state = GetEventState(GetDeviceObjects(device), event);
+    return (state && state->signaled.load(std::memory_order_acquire)) ? VK_EVENT_SET : VK_EVENT_RESET;
+''',
+'vkSetEvent': '''
+    SetEventState(GetEventState(GetDeviceObjects(device), event).get(), true);
     return VK_SUCCESS;
 ''',
-'vkUnmapMemory': '''
-    unique_lock_t lock(global_lock);
-    for (auto map_addr : mapped_memory_map[memory]) {
-        free(map_addr);
+'vkResetEvent': '''
+    SetEventState(GetEventState(GetDeviceObjects(device), event).get(), false);
+    return VK_SUCCESS;
+''',
+'vkCmdSetEvent': '''
+    RecordQueueCommand(commandBuffer, QueueCommandType::kSetEvent, event);
+''',
+'vkCmdSetEvent2KHR': '''
+    RecordQueueCommand(commandBuffer, QueueCommandType::kSetEvent, event);
+''',
+'vkCmdResetEvent': '''
+    RecordQueueCommand(commandBuffer, QueueCommandType::kResetEvent, event);
+''',
+'vkCmdResetEvent2KHR': '''
+    RecordQueueCommand(commandBuffer, QueueCommandType::kResetEvent, event);
+''',
+'vkCmdWaitEvents': '''
+    for (uint32_t i = 0; i < eventCount; ++i) {
+        RecordQueueCommand(commandBuffer, QueueCommandType::kWaitEvent, pEvents[i]);
+    }
+''',
+'vkCmdWaitEvents2KHR': '''
+    for (uint32_t i = 0; i < eventCount; ++i) {
+        RecordQueueCommand(commandBuffer, QueueCommandType::kWaitEvent, pEvents[i]);
+    }
+''',
+'vkCmdExecuteCommands': '''
+    // The primary takes over the queue commands of its secondaries and counts the commands they recorded
+    auto* state = GetCommandBufferState(commandBuffer);
+    for (uint32_t i = 0; i < commandBufferCount; ++i) {
+        const auto* secondary_state = GetCommandBufferState(pCommandBuffers[i]);
+        state->queue_commands.insert(state->queue_commands.end(), secondary_state->queue_commands.begin(),
+                                     secondary_state->queue_commands.end());
+        for (uint32_t j = 0; j < kPerformanceCounterCount; ++j) {
+            state->counters[j] += secondary_state->counters[j];
+        }
+    }
+''',
+'vkBeginCommandBuffer': '''
+    // Beginning a command buffer implicitly resets it
+    ResetCommandBufferState(*GetCommandBufferState(commandBuffer));
+    return VK_SUCCESS;
+''',
+'vkResetCommandBuffer': '''
+    ResetCommandBufferState(*GetCommandBufferState(commandBuffer));
+    return VK_SUCCESS;
+''',
+'vkEndCommandBuffer': '''
+    return GetCommandBufferState(commandBuffer)->stream.out_of_memory ? VK_ERROR_OUT_OF_HOST_MEMORY : VK_SUCCESS;
+''',
+'vkResetCommandPool': '''
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.command_pools.find(commandPool);
+    if (it != objects.command_pools.end()) {
+        for (const auto command_buffer : it->second.command_buffers) {
+            ResetCommandBufferState(*GetCommandBufferState(command_buffer));
+        }
+        if (flags & VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT) it->second.arena->Release();
+    }
+    return VK_SUCCESS;
+''',
+'vkGetBufferDeviceAddressKHR': '''
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.buffer_bindings.find(pInfo->buffer);
+    if (it == objects.buffer_bindings.end()) {
+        return 0;
     }
-    mapped_memory_map.erase(memory);
+    const uint8_t* data = GetDeviceMemoryData(objects, it->second.memory);
+    return data ? static_cast<VkDeviceAddress>(reinterpret_cast<uintptr_t>(data + it->second.offset)) : 0;
+''',
+'vkGetBufferDeviceAddressEXT': '''
+    return GetBufferDeviceAddressImpl(device, pInfo);
 ''',
 'vkGetImageSubresourceLayout': '''
     // Need safe values. Callers are computing memory offsets from pLayout, with no return code to flag failure.
     *pLayout = VkSubresourceLayout(); // Default constructor zero values.
 ''',
 'vkCreateSwapchainKHR': '''
-    unique_lock_t lock(global_lock);
-    *pSwapchain = (VkSwapchainKHR)global_unique_handle++;
+    *pSwapchain = (VkSwapchainKHR)NewHandle(device, VK_OBJECT_TYPE_SWAPCHAIN_KHR);
+    TrackObjects(VK_OBJECT_TYPE_SWAPCHAIN_KHR, 1);
+    AddLiveObject("VkSwapchainKHR", (uint64_t)*pSwapchain);
+    std::array<VkImage, icd_swapchain_image_count> images;
     for(uint32_t i = 0; i < icd_swapchain_image_count; ++i){
-        swapchain_image_map[*pSwapchain][i] = (VkImage)global_unique_handle++;
+        images[i] = (VkImage)NewHandle(device, VK_OBJECT_TYPE_IMAGE);
     }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.swapchain_images[*pSwapchain] = images;
+    objects.swapchain_present_states[*pSwapchain];
     return VK_SUCCESS;
 ''',
 'vkDestroySwapchainKHR': '''
-    unique_lock_t lock(global_lock);
-    swapchain_image_map.clear();
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.swapchain_images.erase(swapchain);
+    objects.swapchain_present_states.erase(swapchain);
+    if (swapchain != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_SWAPCHAIN_KHR, -1);
+    RemoveLiveObject((uint64_t)swapchain);
 ''',
 'vkGetSwapchainImagesKHR': '''
     if (!pSwapchainImages) {
         *pSwapchainImageCount = icd_swapchain_image_count;
     } else {
-        unique_lock_t lock(global_lock);
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
         for (uint32_t img_i = 0; img_i < (std::min)(*pSwapchainImageCount, icd_swapchain_image_count); ++img_i){
-            pSwapchainImages[img_i] = swapchain_image_map.at(swapchain)[img_i];
+            pSwapchainImages[img_i] = objects.swapchain_images.at(swapchain)[img_i];
         }
 
         if (*pSwapchainImageCount < icd_swapchain_image_count) return VK_INCOMPLETE;
@@ -1009,22 +3706,529 @@ CUSTOM_C_INTERCEPTS = {
     *pImageIndex = 0;
     return VK_SUCCESS;
 ''',
+'vkTrimCommandPoolKHR': '''
+    // Frees the blocks none of the pool's command buffers is using
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.command_pools.find(commandPool);
+    if (it != objects.command_pools.end()) it->second.arena->Release();
+''',
+'vkCreateCommandPool': '''
+    *pCommandPool = (VkCommandPool)NewHandle(device, VK_OBJECT_TYPE_COMMAND_POOL);
+    TrackObjects(VK_OBJECT_TYPE_COMMAND_POOL, 1);
+    AddLiveObject("VkCommandPool", (uint64_t)*pCommandPool);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    auto& pool = objects.command_pools[*pCommandPool];
+    const auto* allocator = GetChildAllocator(device, pAllocator);
+    if (allocator) {
+        pool.has_allocator = true;
+        pool.allocator = *allocator;
+    }
+    pool.arena.reset(new CommandArena(allocator));
+    return VK_SUCCESS;
+''',
+'vkAllocateDescriptorSets': '''
+    for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; ++i) {
+        pDescriptorSets[i] = (VkDescriptorSet)NewHandle(device, VK_OBJECT_TYPE_DESCRIPTOR_SET);
+        AddLiveObject("VkDescriptorSet", (uint64_t)pDescriptorSets[i], 0, (uint64_t)pAllocateInfo->descriptorPool);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.descriptor_pool_set_counts[pAllocateInfo->descriptorPool] += pAllocateInfo->descriptorSetCount;
+    TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_SET, pAllocateInfo->descriptorSetCount);
+    return VK_SUCCESS;
+''',
+'vkFreeDescriptorSets': '''
+    uint64_t freed_count = 0;
+    for (uint32_t i = 0; i < descriptorSetCount; ++i) {
+        if (pDescriptorSets[i] != VK_NULL_HANDLE) ++freed_count;
+        RemoveLiveObject((uint64_t)pDescriptorSets[i]);
+    }
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    auto& pool_set_count = objects.descriptor_pool_set_counts[descriptorPool];
+    freed_count = (std::min)(freed_count, pool_set_count);
+    pool_set_count -= freed_count;
+    TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_SET, -static_cast<int64_t>(freed_count));
+    return VK_SUCCESS;
+''',
+'vkResetDescriptorPool': '''
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.descriptor_pool_set_counts.find(descriptorPool);
+    if (it != objects.descriptor_pool_set_counts.end()) {
+        TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_SET, -static_cast<int64_t>(it->second));
+        it->second = 0;
+    }
+    RemoveLiveObjectsOf((uint64_t)descriptorPool);
+    return VK_SUCCESS;
+''',
+'vkDestroyDescriptorPool': '''
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.descriptor_pool_set_counts.find(descriptorPool);
+    if (it != objects.descriptor_pool_set_counts.end()) {
+        TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_SET, -static_cast<int64_t>(it->second));
+        objects.descriptor_pool_set_counts.erase(it);
+    }
+    RemoveLiveObjectsOf((uint64_t)descriptorPool);
+    if (descriptorPool != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_DESCRIPTOR_POOL, -1);
+    RemoveLiveObject((uint64_t)descriptorPool);
+''',
+'vkQueuePresentKHR': '''
+    icd_stats.present_count.fetch_add(pPresentInfo->swapchainCount, std::memory_order_relaxed);
+    const auto *present_times = lvl_find_in_chain<VkPresentTimesInfoGOOGLE>(pPresentInfo->pNext);
+    uint64_t last_present_time = 0;
+    VkResult result = VK_SUCCESS;
+    {
+        auto& objects = *GetQueueState(queue)->device->objects;
+        unique_lock_t lock(objects.lock);
+        for (uint32_t i = 0; i < pPresentInfo->swapchainCount; ++i) {
+            const bool has_time = present_times && present_times->pTimes && i < present_times->swapchainCount;
+            uint64_t present_time = 0;
+            const VkResult swapchain_result =
+                SchedulePresent(objects.swapchain_present_states, pPresentInfo->pSwapchains[i],
+                                has_time ? present_times->pTimes[i].presentID : 0,
+                                has_time ? present_times->pTimes[i].desiredPresentTime : 0, &present_time)
+                    ? VK_SUCCESS
+                    : VK_ERROR_OUT_OF_DATE_KHR;
+            last_present_time = (std::max)(last_present_time, present_time);
+            if (pPresentInfo->pResults) pPresentInfo->pResults[i] = swapchain_result;
+            if (result == VK_SUCCESS) result = swapchain_result;
+        }
+    }
+    // With pacing, presentation blocks like a FIFO swapchain whose queue is full until the image is displayed
+    static const bool pace_presents = GetEnvSize("VKMOCK_PRESENT_PACING", 0) != 0;
+    if (pace_presents) {
+        const uint64_t now = GetMonotonicTimeNs();
+        if (last_present_time > now) std::this_thread::sleep_for(std::chrono::nanoseconds(last_present_time - now));
+    }
+    return result;
+''',
+'vkGetRefreshCycleDurationGOOGLE': '''
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        if (!objects.swapchain_present_states.count(swapchain)) return VK_ERROR_OUT_OF_DATE_KHR;
+    }
+    pDisplayTimingProperties->refreshDuration = GetRefreshDurationNs();
+    return VK_SUCCESS;
+''',
+'vkGetPastPresentationTimingGOOGLE': '''
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto state = objects.swapchain_present_states.find(swapchain);
+    if (state == objects.swapchain_present_states.end()) {
+        *pPresentationTimingCount = 0;
+        return VK_ERROR_OUT_OF_DATE_KHR;
+    }
+    auto& past_timings = state->second.past_timings;
+    // Only presents whose image has reached the display are in the past
+    const uint64_t now = GetMonotonicTimeNs();
+    uint32_t available_count = 0;
+    while (available_count < past_timings.size() && past_timings[available_count].actualPresentTime <= now) {
+        ++available_count;
+    }
+    if (!pPresentationTimings) {
+        *pPresentationTimingCount = available_count;
+        return VK_SUCCESS;
+    }
+    // Each timing is reported once
+    const uint32_t count = (std::min)(*pPresentationTimingCount, available_count);
+    std::copy(past_timings.begin(), past_timings.begin() + count, pPresentationTimings);
+    past_timings.erase(past_timings.begin(), past_timings.begin() + count);
+    *pPresentationTimingCount = count;
+    return count < available_count ? VK_INCOMPLETE : VK_SUCCESS;
+''',
+'vkGetPhysicalDeviceCalibrateableTimeDomainsEXT': '''
+    // Host clocks are only reported where they can be sampled
+    static const std::vector<VkTimeDomainEXT> time_domains = {
+        VK_TIME_DOMAIN_DEVICE_EXT,
+#if defined(__linux__)
+        VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT,
+        VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_EXT,
+#elif defined(_WIN32)
+        VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT,
+#endif
+    };
+    if (!pTimeDomains) {
+        *pTimeDomainCount = static_cast<uint32_t>(time_domains.size());
+        return VK_SUCCESS;
+    }
+    const uint32_t count = (std::min)(*pTimeDomainCount, static_cast<uint32_t>(time_domains.size()));
+    std::copy(time_domains.begin(), time_domains.begin() + count, pTimeDomains);
+    *pTimeDomainCount = count;
+    return count < time_domains.size() ? VK_INCOMPLETE : VK_SUCCESS;
+''',
+'vkGetCalibratedTimestampsEXT': '''
+    // Device timestamps count nanoseconds of CLOCK_MONOTONIC on Linux and of the performance counter on Windows
+    // (timestampPeriod is 1), so only the other host clock is sampled separately. The deviation is the time it took to
+    // sample both.
+    const uint64_t begin_time = GetMonotonicTimeNs();
+#if defined(__linux__)
+    const uint64_t raw_time = GetMonotonicRawTimeNs();
+#elif defined(_WIN32)
+    const uint64_t counter = GetPerformanceCounter();
+#endif
+    const uint64_t end_time = GetMonotonicTimeNs();
+    for (uint32_t i = 0; i < timestampCount; ++i) {
+        switch (pTimestampInfos[i].timeDomain) {
+#if defined(__linux__)
+            case VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_EXT:
+                pTimestamps[i] = raw_time;
+                break;
+#elif defined(_WIN32)
+            case VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT:
+                pTimestamps[i] = counter;
+                break;
+#endif
+            default:
+                pTimestamps[i] = begin_time;
+                break;
+        }
+    }
+    *pMaxDeviation = (std::max)(end_time - begin_time, uint64_t(1));
+    return VK_SUCCESS;
+''',
+'vkCreateShaderModule': '''
+    // Hash before taking the lock, it is the expensive part
+    const uint64_t hash = HashShaderCode(pCreateInfo->pCode, pCreateInfo->codeSize);
+    *pShaderModule = (VkShaderModule)NewHandle(device, VK_OBJECT_TYPE_SHADER_MODULE);
+    TrackObjects(VK_OBJECT_TYPE_SHADER_MODULE, 1);
+    AddLiveObject("VkShaderModule", (uint64_t)*pShaderModule);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.shader_code.modules[*pShaderModule] =
+        AcquireShaderCode(objects.shader_code, hash, pCreateInfo->pCode, pCreateInfo->codeSize);
+    return VK_SUCCESS;
+''',
+'vkDestroyShaderModule': '''
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    const auto it = objects.shader_code.modules.find(shaderModule);
+    if (it != objects.shader_code.modules.end()) {
+        ReleaseShaderCode(objects.shader_code, it->second);
+        objects.shader_code.modules.erase(it);
+    }
+    if (shaderModule != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_SHADER_MODULE, -1);
+    RemoveLiveObject((uint64_t)shaderModule);
+''',
+'vkCreateGraphicsPipelines': '''
+    for (uint32_t i = 0; i < createInfoCount; ++i) {
+        pPipelines[i] = (VkPipeline)NewHandle(device, VK_OBJECT_TYPE_PIPELINE);
+        AddLiveObject("VkPipeline", (uint64_t)pPipelines[i]);
+    }
+    TrackObjects(VK_OBJECT_TYPE_PIPELINE, createInfoCount);
+    uint32_t compile_count = 0;
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        for (uint32_t i = 0; i < createInfoCount; ++i) {
+            if (CompileShaderStages(objects.shader_code, pCreateInfos[i].stageCount, pCreateInfos[i].pStages)) ++compile_count;
+        }
+    }
+    return DeferWork(device, VK_NULL_HANDLE, compile_count * icd_pipeline_compile_chunks);
+''',
+'vkCreateComputePipelines': '''
+    for (uint32_t i = 0; i < createInfoCount; ++i) {
+        pPipelines[i] = (VkPipeline)NewHandle(device, VK_OBJECT_TYPE_PIPELINE);
+        AddLiveObject("VkPipeline", (uint64_t)pPipelines[i]);
+    }
+    TrackObjects(VK_OBJECT_TYPE_PIPELINE, createInfoCount);
+    uint32_t compile_count = 0;
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        for (uint32_t i = 0; i < createInfoCount; ++i) {
+            if (CompileShaderStages(objects.shader_code, 1, &pCreateInfos[i].stage)) ++compile_count;
+        }
+    }
+    return DeferWork(device, VK_NULL_HANDLE, compile_count * icd_pipeline_compile_chunks);
+''',
+'vkCreateRayTracingPipelinesKHR': '''
+    for (uint32_t i = 0; i < createInfoCount; ++i) {
+        pPipelines[i] = (VkPipeline)NewHandle(device, VK_OBJECT_TYPE_PIPELINE);
+        AddLiveObject("VkPipeline", (uint64_t)pPipelines[i]);
+    }
+    TrackObjects(VK_OBJECT_TYPE_PIPELINE, createInfoCount);
+    uint32_t compile_count = 0;
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        for (uint32_t i = 0; i < createInfoCount; ++i) {
+            if (CompileShaderStages(objects.shader_code, pCreateInfos[i].stageCount, pCreateInfos[i].pStages)) ++compile_count;
+        }
+    }
+    return DeferWork(device, deferredOperation, compile_count * icd_pipeline_compile_chunks);
+''',
+'vkCreateDeferredOperationKHR': '''
+    *pDeferredOperation = (VkDeferredOperationKHR)NewHandle(device, VK_OBJECT_TYPE_DEFERRED_OPERATION_KHR);
+    TrackObjects(VK_OBJECT_TYPE_DEFERRED_OPERATION_KHR, 1);
+    AddLiveObject("VkDeferredOperationKHR", (uint64_t)*pDeferredOperation);
+    auto& objects = GetDeviceObjects(device);
+    unique_lock_t lock(objects.lock);
+    objects.deferred_operations[*pDeferredOperation] = std::make_shared<DeferredOperationState>();
+    return VK_SUCCESS;
+''',
+'vkDestroyDeferredOperationKHR': '''
+    {
+        auto& objects = GetDeviceObjects(device);
+        unique_lock_t lock(objects.lock);
+        objects.deferred_operations.erase(operation);
+    }
+    if (operation != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_DEFERRED_OPERATION_KHR, -1);
+    RemoveLiveObject((uint64_t)operation);
+''',
+'vkGetDeferredOperationMaxConcurrencyKHR': '''
+    // Every chunk that has not been claimed yet could run on its own thread
+    const auto state = GetDeferredOperationState(device, operation);
+    if (!state) return 0;
+    const uint32_t next_chunk = state->next_chunk.load(std::memory_order_relaxed);
+    return next_chunk < state->chunk_count ? state->chunk_count - next_chunk : 0;
+''',
+'vkGetDeferredOperationResultKHR': '''
+    const auto state = GetDeferredOperationState(device, operation);
+    if (state && state->finished_chunks.load(std::memory_order_acquire) < state->chunk_count) return VK_NOT_READY;
+    return VK_SUCCESS;
+''',
+'vkDeferredOperationJoinKHR': '''
+    const auto state = GetDeferredOperationState(device, operation);
+    if (!state) return VK_SUCCESS;
+    while (state->next_chunk.load(std::memory_order_relaxed) < state->chunk_count) {
+        const uint32_t chunk = state->next_chunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= state->chunk_count) break;
+        CompilePipelineChunk();
+        state->finished_chunks.fetch_add(1, std::memory_order_acq_rel);
+    }
+    // Threads that run out of chunks while others still work on theirs are done; the last one completes the operation
+    return state->finished_chunks.load(std::memory_order_acquire) == state->chunk_count ? VK_SUCCESS : VK_THREAD_DONE_KHR;
+''',
+'vkCreateQueryPool': '''
+    *pQueryPool = (VkQueryPool)NewHandle(device, VK_OBJECT_TYPE_QUERY_POOL);
+    TrackObjects(VK_OBJECT_TYPE_QUERY_POOL, 1);
+    AddLiveObject("VkQueryPool", (uint64_t)*pQueryPool);
+    const auto *performance_info = lvl_find_in_chain<VkQueryPoolPerformanceCreateInfoKHR>(pCreateInfo->pNext);
+    if (pCreateInfo->queryType == VK_QUERY_TYPE_PERFORMANCE_QUERY_KHR && performance_info) {
+        auto pool = std::make_shared<PerformanceQueryPool>();
+        pool->counter_indices.assign(performance_info->pCounterIndices, performance_info->pCounterIndices + performance_info->counterIndexCount);
+        pool->results.resize(size_t(pCreateInfo->queryCount) * performance_info->counterIndexCount);
+        pool->available.resize(pCreateInfo->queryCount);
+        GetDeviceObjects(device).performance_query_pools.Insert(*pQueryPool, pool);
+    }
+    return VK_SUCCESS;
+''',
+'vkDestroyQueryPool': '''
+    GetDeviceObjects(device).performance_query_pools.Erase(queryPool);
+    if (queryPool != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_QUERY_POOL, -1);
+    RemoveLiveObject((uint64_t)queryPool);
+''',
+'vkResetQueryPool': '''
+    std::shared_ptr<PerformanceQueryPool> pool;
+    if (GetDeviceObjects(device).performance_query_pools.Find(queryPool, &pool)) {
+        ResetPerformanceQueries(*pool, firstQuery, queryCount);
+    }
+''',
+'vkResetQueryPoolEXT': '''
+    CallInternal(ResetQueryPool, device, queryPool, firstQuery, queryCount);
+''',
+'vkCmdResetQueryPool': '''
+    auto* state = GetCommandBufferState(commandBuffer);
+    std::shared_ptr<PerformanceQueryPool> pool;
+    if (!state->device->objects->performance_query_pools.Find(queryPool, &pool)) return;
+    state->queue_commands.push_back({QueueCommandType::kResetQueries, nullptr, std::move(pool), firstQuery, queryCount});
+''',
+'vkCmdBeginQuery': '''
+    auto* state = GetCommandBufferState(commandBuffer);
+    std::shared_ptr<PerformanceQueryPool> pool;
+    if (state->device->objects->performance_query_pools.Find(queryPool, &pool)) {
+        state->has_active_query = true;
+        state->active_query = {queryPool, std::move(pool), query, state->counters};
+    }
+''',
+'vkCmdEndQuery': '''
+    // The pool was looked up when the query began, and the queue makes the result available when it executes the end
+    auto* state = GetCommandBufferState(commandBuffer);
+    auto& active_query = state->active_query;
+    if (!state->has_active_query || active_query.pool != queryPool || active_query.query != query) return;
+    QueueCommand command = {QueueCommandType::kEndQuery, nullptr, std::move(active_query.pool_state), query, 1};
+    for (uint32_t i = 0; i < kPerformanceCounterCount; ++i) {
+        command.counter_values[i] = state->counters[i] - active_query.begin_values[i];
+    }
+    state->queue_commands.push_back(std::move(command));
+    state->has_active_query = false;
+''',
+'vkGetQueryPoolResults': '''
+    std::shared_ptr<PerformanceQueryPool> pool_state;
+    if (!GetDeviceObjects(device).performance_query_pools.Find(queryPool, &pool_state)) return VK_SUCCESS;
+    auto& pool = *pool_state;
+    std::unique_lock<std::mutex> lock(pool.lock);
+    const size_t counter_count = pool.counter_indices.size();
+    const size_t result_size = counter_count * sizeof(VkPerformanceCounterResultKHR);
+    VkResult result = VK_SUCCESS;
+    for (uint32_t i = 0; i < queryCount && firstQuery + i < pool.available.size(); ++i) {
+        const uint32_t query = firstQuery + i;
+        if (i * stride + result_size > dataSize) break;
+        if (flags & VK_QUERY_RESULT_WAIT_BIT) {
+            pool.available_cv.wait(lock, [&] { return pool.available[query]; });
+        } else if (!pool.available[query]) {
+            result = VK_NOT_READY;
+            continue;
+        }
+        auto* results = reinterpret_cast<VkPerformanceCounterResultKHR*>(static_cast<uint8_t*>(pData) + i * stride);
+        for (size_t j = 0; j < counter_count; ++j) {
+            results[j].uint64 = pool.results[query * counter_count + j];
+        }
+    }
+    return result;
+''',
+'vkEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR': '''
+    if (!pCounters) {
+        *pCounterCount = kPerformanceCounterCount;
+        return VK_SUCCESS;
+    }
+    const uint32_t count = (std::min)(*pCounterCount, uint32_t(kPerformanceCounterCount));
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto& info = performance_counter_infos[i];
+        pCounters[i].unit = info.unit;
+        pCounters[i].scope = VK_PERFORMANCE_COUNTER_SCOPE_COMMAND_BUFFER_KHR;
+        pCounters[i].storage = VK_PERFORMANCE_COUNTER_STORAGE_UINT64_KHR;
+        std::fill(std::begin(pCounters[i].uuid), std::end(pCounters[i].uuid), uint8_t(0));
+        std::copy_n("vkmock", 6, pCounters[i].uuid);
+        pCounters[i].uuid[VK_UUID_SIZE - 1] = static_cast<uint8_t>(i);
+        if (pCounterDescriptions) {
+            pCounterDescriptions[i].flags = 0;
+            strncpy(pCounterDescriptions[i].name, info.name, VK_MAX_DESCRIPTION_SIZE);
+            strncpy(pCounterDescriptions[i].category, "Commands", VK_MAX_DESCRIPTION_SIZE);
+            strncpy(pCounterDescriptions[i].description, info.description, VK_MAX_DESCRIPTION_SIZE);
+        }
+    }
+    *pCounterCount = count;
+    return count < kPerformanceCounterCount ? VK_INCOMPLETE : VK_SUCCESS;
+''',
+'vkGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR': '''
+    // All counters are collected together
+    *pNumPasses = 1;
+''',
+'vkCmdBindPipeline': '''
+    CountCommand(commandBuffer, kCounterPipelineBinds);
+''',
+'vkCmdBindDescriptorSets': '''
+    CountCommand(commandBuffer, kCounterDescriptorBinds, descriptorSetCount);
+''',
+'vkCmdPushDescriptorSetKHR': '''
+    CountCommand(commandBuffer, kCounterDescriptorBinds);
+''',
+'vkCmdPushDescriptorSetWithTemplateKHR': '''
+    CountCommand(commandBuffer, kCounterDescriptorBinds);
+''',
+'vkCmdDraw': '''
+    CountCommand(commandBuffer, kCounterDraws);
+''',
+'vkCmdDrawIndexed': '''
+    CountCommand(commandBuffer, kCounterDraws);
+''',
+'vkCmdDrawIndirect': '''
+    CountCommand(commandBuffer, kCounterDraws, drawCount);
+''',
+'vkCmdDrawIndexedIndirect': '''
+    CountCommand(commandBuffer, kCounterDraws, drawCount);
+''',
+'vkCmdDrawIndirectCountKHR': '''
+    // The draw count is read from a buffer as the queue executes, so the bound the command gives is counted
+    CountCommand(commandBuffer, kCounterDraws, maxDrawCount);
+''',
+'vkCmdDrawIndexedIndirectCountKHR': '''
+    // The draw count is read from a buffer as the queue executes, so the bound the command gives is counted
+    CountCommand(commandBuffer, kCounterDraws, maxDrawCount);
+''',
+'vkCmdDrawMultiEXT': '''
+    CountCommand(commandBuffer, kCounterDraws, drawCount);
+''',
+'vkCmdDrawMultiIndexedEXT': '''
+    CountCommand(commandBuffer, kCounterDraws, drawCount);
+''',
+'vkCmdDrawIndirectCountAMD': '''
+    CountCommand(commandBuffer, kCounterDraws, maxDrawCount);
+''',
+'vkCmdDrawIndexedIndirectCountAMD': '''
+    CountCommand(commandBuffer, kCounterDraws, maxDrawCount);
+''',
+'vkCmdDrawIndirectByteCountEXT': '''
+    CountCommand(commandBuffer, kCounterDraws);
+''',
+'vkCmdDrawMeshTasksNV': '''
+    CountCommand(commandBuffer, kCounterDraws);
+''',
+'vkCmdDrawMeshTasksIndirectNV': '''
+    CountCommand(commandBuffer, kCounterDraws, drawCount);
+''',
+'vkCmdDrawMeshTasksIndirectCountNV': '''
+    CountCommand(commandBuffer, kCounterDraws, maxDrawCount);
+''',
+'vkCmdDispatch': '''
+    CountCommand(commandBuffer, kCounterDispatches);
+''',
+'vkCmdDispatchIndirect': '''
+    CountCommand(commandBuffer, kCounterDispatches);
+''',
+'vkCmdDispatchBaseKHR': '''
+    CountCommand(commandBuffer, kCounterDispatches);
+''',
+'vkCmdCopyBuffer': '''
+    VkDeviceSize size = 0;
+    for (uint32_t i = 0; i < regionCount; ++i) {
+        size += pRegions[i].size;
+    }
+    CountCommand(commandBuffer, kCounterBytesCopied, size);
+''',
+'vkCmdCopyBuffer2KHR': '''
+    VkDeviceSize size = 0;
+    for (uint32_t i = 0; i < pCopyBufferInfo->regionCount; ++i) {
+        size += pCopyBufferInfo->pRegions[i].size;
+    }
+    CountCommand(commandBuffer, kCounterBytesCopied, size);
+''',
+'vkCmdUpdateBuffer': '''
+    CountCommand(commandBuffer, kCounterBytesCopied, dataSize);
+''',
+'vkCmdFillBuffer': '''
+    // The size of a whole-buffer fill is not known from the command buffer, so it is not counted
+    if (size != VK_WHOLE_SIZE) CountCommand(commandBuffer, kCounterBytesCopied, size);
+''',
+'vkCmdPipelineBarrier': '''
+    CountCommand(commandBuffer, kCounterBarriers, uint64_t(memoryBarrierCount) + bufferMemoryBarrierCount + imageMemoryBarrierCount);
+''',
+'vkCmdPipelineBarrier2KHR': '''
+    CountCommand(commandBuffer, kCounterBarriers, uint64_t(pDependencyInfo->memoryBarrierCount) +
+                                                      pDependencyInfo->bufferMemoryBarrierCount + pDependencyInfo->imageMemoryBarrierCount);
+''',
 'vkCreateBuffer': '''
-    unique_lock_t lock(global_lock);
-    *pBuffer = (VkBuffer)global_unique_handle++;
-    buffer_map[device][*pBuffer] = *pCreateInfo;
+    *pBuffer = (VkBuffer)NewHandle(device, VK_OBJECT_TYPE_BUFFER);
+    TrackObjects(VK_OBJECT_TYPE_BUFFER, 1);
+    AddLiveObject("VkBuffer", (uint64_t)*pBuffer);
+    GetDeviceObjects(device).buffers.Insert(*pBuffer, {pCreateInfo->size, pCreateInfo->flags, pCreateInfo->usage});
     return VK_SUCCESS;
 ''',
 'vkDestroyBuffer': '''
-    unique_lock_t lock(global_lock);
-    buffer_map[device].erase(buffer);
+    auto& objects = GetDeviceObjects(device);
+    objects.buffers.Erase(buffer);
+    {
+        unique_lock_t lock(objects.lock);
+        objects.buffer_bindings.erase(buffer);
+        RemoveMemoryBinding(objects, (uint64_t)buffer);
+        objects.sparse_page_tables.erase((uint64_t)buffer);
+    }
+    if (buffer != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_BUFFER, -1);
+    RemoveLiveObject((uint64_t)buffer);
 ''',
 'vkCreateImage': '''
-    unique_lock_t lock(global_lock);
-    *pImage = (VkImage)global_unique_handle++;
+    *pImage = (VkImage)NewHandle(device, VK_OBJECT_TYPE_IMAGE);
+    TrackObjects(VK_OBJECT_TYPE_IMAGE, 1);
+    AddLiveObject("VkImage", (uint64_t)*pImage);
     // TODO: A pixel size is 32 bytes. This accounts for the largest possible pixel size of any format. It could be changed to more accurate size if need be.
-    image_memory_size_map[device][*pImage] = pCreateInfo->extent.width * pCreateInfo->extent.height * pCreateInfo->extent.depth *
-                                             32 * pCreateInfo->arrayLayers * (pCreateInfo->mipLevels > 1 ? 2 : 1);
+    VkDeviceSize memory_size = pCreateInfo->extent.width * pCreateInfo->extent.height * pCreateInfo->extent.depth *
+                               32 * pCreateInfo->arrayLayers * (pCreateInfo->mipLevels > 1 ? 2 : 1);
     // plane count
     switch (pCreateInfo->format) {
         case VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM:
@@ -1039,7 +4243,7 @@ CUSTOM_C_INTERCEPTS = {
         case VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM:
         case VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM:
         case VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM:
-            image_memory_size_map[device][*pImage] *= 3;
+            memory_size *= 3;
             break;
         case VK_FORMAT_G8_B8R8_2PLANE_420_UNORM:
         case VK_FORMAT_G8_B8R8_2PLANE_422_UNORM:
@@ -1049,19 +4253,41 @@ CUSTOM_C_INTERCEPTS = {
         case VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16:
         case VK_FORMAT_G16_B16R16_2PLANE_420_UNORM:
         case VK_FORMAT_G16_B16R16_2PLANE_422_UNORM:
-            image_memory_size_map[device][*pImage] *= 2;
+            memory_size *= 2;
             break;
         default:
             break;
     }
+    const bool sparse = (pCreateInfo->flags & VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT) != 0;
+    auto& objects = GetDeviceObjects(device);
+    if (sparse) {
+        unique_lock_t lock(objects.lock);
+        const auto& layout = objects.sparse_image_layouts[*pImage] = CreateSparseImageLayout(pCreateInfo);
+        memory_size = layout.layer_stride * layout.array_layers;
+    }
+    objects.images.Insert(*pImage, {memory_size, sparse, pCreateInfo->tiling == VK_IMAGE_TILING_LINEAR});
     return VK_SUCCESS;
 ''',
 'vkDestroyImage': '''
-    unique_lock_t lock(global_lock);
-    image_memory_size_map[device].erase(image);
+    auto& objects = GetDeviceObjects(device);
+    objects.images.Erase(image);
+    {
+        unique_lock_t lock(objects.lock);
+        RemoveMemoryBinding(objects, (uint64_t)image);
+        objects.sparse_image_layouts.erase(image);
+        objects.sparse_page_tables.erase((uint64_t)image);
+    }
+    if (image != VK_NULL_HANDLE) TrackObjects(VK_OBJECT_TYPE_IMAGE, -1);
+    RemoveLiveObject((uint64_t)image);
 ''',
 }
 
+# Members that recorded copies of a structure clear instead of following, because they are only valid for some values
+# of another member
+RECORDED_STRUCT_IGNORED_MEMBERS = {
+    'VkWriteDescriptorSet': ['pImageInfo', 'pBufferInfo', 'pTexelBufferView'],
+}
+
 # MockICDGeneratorOptions - subclass of GeneratorOptions.
 #
 # Adds options used by MockICDOutputGenerator objects during Mock
@@ -1175,6 +4401,31 @@ class MockICDOutputGenerator(OutputGenerator):
     TYPE_SECTIONS = ['include', 'define', 'basetype', 'handle', 'enum',
                      'group', 'bitmask', 'funcpointer', 'struct']
     ALL_SECTIONS = TYPE_SECTIONS + ['command']
+    manual_functions = [
+        # Include functions here to be intercepted w/ manually implemented function bodies
+        'vkGetDeviceProcAddr',
+        'vkGetInstanceProcAddr',
+        'vkCreateDevice',
+        'vkDestroyDevice',
+        'vkCreateInstance',
+        'vkDestroyInstance',
+        'vkFreeCommandBuffers',
+        'vkAllocateCommandBuffers',
+        'vkDestroyCommandPool',
+        #'vkCreateDebugReportCallbackEXT',
+        #'vkDestroyDebugReportCallbackEXT',
+        'vkEnumerateInstanceLayerProperties',
+        'vkEnumerateInstanceVersion',
+        'vkEnumerateInstanceExtensionProperties',
+        'vkEnumerateDeviceLayerProperties',
+        'vkEnumerateDeviceExtensionProperties',
+    ]
+    # Manually implemented functions that vkmock_SetHook can still override
+    hooked_manual_functions = [
+        'vkFreeCommandBuffers',
+        'vkAllocateCommandBuffers',
+        'vkDestroyCommandPool',
+    ]
     def __init__(self,
                  errFile = sys.stderr,
                  warnFile = sys.stderr,
@@ -1183,6 +4434,11 @@ class MockICDOutputGenerator(OutputGenerator):
         # Internal state - accumulators for different inner block text
         self.sections = dict([(section, []) for section in self.ALL_SECTIONS])
         self.intercepts = []
+        self.recorded_commands = []
+        self.hook_slots = []
+        self.shared_implementations = set()
+        self.recorded_struct_fixups = {}
+        self.recorded_struct_protects = {}
 
     # Check if the parameter passed in is a pointer to an array
     def paramIsArray(self, param):
@@ -1196,6 +4452,149 @@ class MockICDOutputGenerator(OutputGenerator):
                 ispointer = True
         return ispointer
 
+    # Commands recorded into the command stream. A core entry point and its KHR alias record their own opcodes.
+    def isRecordedCommand(self, name):
+        return name.startswith('vkCmd')
+
+    # Call appending a command to its command buffer's stream, with the parameters after commandBuffer. Pointer and
+    # array parameters are copied into the record by RecordArray, except untyped ones without a length and pointers to
+    # pointers.
+    def recordCommandCall(self, cmdinfo, name):
+        args = ['commandBuffer', 'kOp' + name[2:]]
+        params = cmdinfo.elem.findall('param')[1:]
+        param_names = [param.find('name').text for param in params]
+        for param in params:
+            decl = ''.join(param.itertext())
+            param_name = param.find('name').text
+            if '*' not in decl and '[' not in decl:
+                args.append(param_name)
+                continue
+            if decl.count('*') > 1:
+                continue
+            param_type = param.find('type').text
+            bound = re.search(r'\[(\w+)\]', decl)
+            length = (param.get('len') or '').split(',')[0]
+            if bound:
+                count = bound.group(1)
+            elif length in param_names:
+                count = length
+            elif length and param.get('altlen'):
+                count = param.get('altlen')
+            elif length or param_type == 'void':
+                continue
+            else:
+                count = '1'
+            data = param_name if param_type != 'void' else 'static_cast<const uint8_t*>(%s)' % param_name
+            array_args = ['"%s"' % param_name, data, count]
+            if param.get('stride'):
+                array_args.append(param.get('stride'))
+            args.append('RecordArray(%s)' % ', '.join(array_args))
+        return '    RecordCommand(%s);' % ', '.join(args)
+
+    # Name of the type an alias stands for
+    def resolveTypeAlias(self, type_name):
+        typeinfo = self.registry.typedict.get(type_name)
+        while typeinfo is not None and typeinfo.elem.get('alias'):
+            type_name = typeinfo.elem.get('alias')
+            typeinfo = self.registry.typedict.get(type_name)
+        return type_name
+
+    # Fixups of the recorded copy of a structure, as (kind, member, member type, count) in member order: 'clear' sets
+    # a pointer to NULL, 'array' copies count elements it points to and 'struct' fixes up a member structure. Empty for
+    # types that are copied as they are.
+    def recordedStructFixups(self, type_name):
+        type_name = self.resolveTypeAlias(type_name)
+        if type_name in self.recorded_struct_fixups:
+            return self.recorded_struct_fixups[type_name]
+        # Structures that point back to themselves stop there
+        self.recorded_struct_fixups[type_name] = []
+        typeinfo = self.registry.typedict.get(type_name)
+        if typeinfo is None or typeinfo.elem.get('category') != 'struct':
+            return []
+        fixups = []
+        members = typeinfo.elem.findall('member')
+        member_names = [member.find('name').text for member in members]
+        for member in members:
+            decl = (member.text or '') + ''.join(''.join(child.itertext()) + (child.tail or '') for child in member if child.tag != 'comment')
+            member_name = member.find('name').text
+            member_type = member.find('type').text
+            length = (member.get('len') or '').split(',')[0]
+            if '*' not in decl:
+                if '[' not in decl and self.recordedStructFixups(member_type):
+                    fixups.append(('struct', member_name, member_type, None))
+            elif (member_name == 'pNext' or decl.count('*') > 1 or member_type == 'void' or
+                  member_name in RECORDED_STRUCT_IGNORED_MEMBERS.get(type_name, [])):
+                fixups.append(('clear', member_name, member_type, None))
+            elif length == 'null-terminated':
+                fixups.append(('array', member_name, member_type, 'RecordedStringLength(s.%s)' % member_name))
+            elif length in member_names:
+                fixups.append(('array', member_name, member_type, 's.%s' % length))
+            elif not length:
+                fixups.append(('array', member_name, member_type, '1'))
+            else:
+                fixups.append(('clear', member_name, member_type, None))
+        self.recorded_struct_fixups[type_name] = fixups
+        return fixups
+
+    # Specializations of RecordedStruct for the structures the parameters of a recorded command point to, each emitted
+    # before the first command that records it
+    def genRecordedStructs(self, cmdinfo):
+        for param in cmdinfo.elem.findall('param')[1:]:
+            decl = ''.join(param.itertext())
+            if '*' in decl and decl.count('*') == 1:
+                self.genRecordedStruct(param.find('type').text)
+
+    def genRecordedStruct(self, type_name):
+        type_name = self.resolveTypeAlias(type_name)
+        if type_name in self.recorded_struct_protects and self.recorded_struct_protects[type_name] in (None, self.featureExtraProtect):
+            return
+        fixups = self.recordedStructFixups(type_name)
+        if not fixups:
+            return
+        self.recorded_struct_protects[type_name] = self.featureExtraProtect
+        for kind, member_name, member_type, count in fixups:
+            if kind != 'clear':
+                self.genRecordedStruct(member_type)
+        sizes = []
+        copies = []
+        for kind, member_name, member_type, count in fixups:
+            if kind == 'clear':
+                copies.append('        s.%s = nullptr;' % member_name)
+            elif kind == 'array':
+                sizes.append('        size += RecordedArraySize(s.%s, %s);' % (member_name, count))
+                copies.append('        s.%s = writer.CopyArray(s.%s, %s);' % (member_name, member_name, count))
+            else:
+                member_type = self.resolveTypeAlias(member_type)
+                sizes.append('        size += RecordedStruct<%s>::NestedSize(s.%s);' % (member_type, member_name))
+                copies.append('        RecordedStruct<%s>::CopyNested(s.%s, writer);' % (member_type, member_name))
+        lines = ['template <>',
+                 'struct RecordedStruct<%s> {' % type_name,
+                 '    static const bool kHasPointers = true;']
+        if sizes:
+            lines += ['    static size_t NestedSize(const %s& s) {' % type_name,
+                      '        size_t size = 0;'] + sizes + ['        return size;',
+                      '    }']
+        else:
+            lines += ['    static size_t NestedSize(const %s&) { return 0; }' % type_name]
+        lines += ['    static void CopyNested(%s& s, CommandDataWriter&%s) {' % (type_name, ' writer' if sizes else '')]
+        lines += copies + ['    }', '};']
+        self.appendSection('command', '')
+        self.appendSection('command', '\n'.join(lines))
+
+    # Call of the hook installed for an entry point with vkmock_SetHook, if any, in place of the mock implementation
+    def hookCall(self, cmdinfo, name):
+        params = [param.text for param in cmdinfo.elem.findall('param/name')]
+        lines = ['    if (const auto hook = GetHook<PFN_%s>(kHook%s)) {' % (name, name[2:]),
+                 '        const HookScope scope;',
+                 '        return hook(%s);' % ', '.join(params),
+                 '    }']
+        return '\n'.join(lines)
+
+    # Call of the implementation a core entry point shares with its custom KHR alias, which has no hook
+    def sharedImplementationCall(self, cmdinfo, core_name):
+        params = [param.text for param in cmdinfo.elem.findall('param/name')]
+        return '    return %sImpl(%s);' % (core_name[2:], ', '.join(params))
+
     # Check if an object is a non-dispatchable handle
     def isHandleTypeNonDispatchable(self, handletype):
         handle = self.registry.tree.find("types/type/[name='" + handletype + "'][@category='handle']")
@@ -1204,6 +4603,16 @@ class MockICDOutputGenerator(OutputGenerator):
         else:
             return False
 
+    # Get the VkObjectType enumerant of a handle type
+    def getHandleObjectType(self, handletype):
+        handle = self.registry.tree.find("types/type/[name='" + handletype + "'][@category='handle']")
+        if handle is not None and handle.get('objtypeenum') is not None:
+            return handle.get('objtypeenum')
+        # Registries without objtypeenum: VkSamplerYcbcrConversion -> VK_OBJECT_TYPE_SAMPLER_YCBCR_CONVERSION
+        match = re.match(r'Vk(\w*?)([A-Z]{2,})?$', handletype)
+        words = re.sub(r'([a-z0-9])([A-Z])', r'\1_\2', match.group(1)).upper()
+        return 'VK_OBJECT_TYPE_' + words + ('_' + match.group(2) if match.group(2) else '')
+
     # Check if an object is a dispatchable handle
     def isHandleTypeDispatchable(self, handletype):
         handle = self.registry.tree.find("types/type/[name='" + handletype + "'][@category='handle']")
@@ -1230,17 +4639,47 @@ class MockICDOutputGenerator(OutputGenerator):
             for s in genOpts.prefixText:
                 write(s, file=self.outFile)
         if self.header:
+            write('#include <algorithm>', file=self.outFile)
+            write('#include <atomic>', file=self.outFile)
+            write('#include <new>', file=self.outFile)
             write('#include <unordered_map>', file=self.outFile)
             write('#include <mutex>', file=self.outFile)
+            write('#include <vector>', file=self.outFile)
             write('#include <string>', file=self.outFile)
             write('#include <cstring>', file=self.outFile)
             write('#include "vulkan/vk_icd.h"', file=self.outFile)
         else:
             write('#include "mock_icd.h"', file=self.outFile)
+            write('#include "vkmock.h"', file=self.outFile)
+            write('#include <stdio.h>', file=self.outFile)
             write('#include <stdlib.h>', file=self.outFile)
             write('#include <algorithm>', file=self.outFile)
             write('#include <array>', file=self.outFile)
+            write('#include <atomic>', file=self.outFile)
+            write('#include <chrono>', file=self.outFile)
+            write('#include <condition_variable>', file=self.outFile)
+            write('#include <deque>', file=self.outFile)
+            write('#include <iterator>', file=self.outFile)
+            write('#include <map>', file=self.outFile)
+            write('#include <memory>', file=self.outFile)
+            write('#include <thread>', file=self.outFile)
             write('#include <vector>', file=self.outFile)
+            write('#if defined(__linux__)', file=self.outFile)
+            write('#include <errno.h>', file=self.outFile)
+            write('#include <fcntl.h>', file=self.outFile)
+            write('#include <poll.h>', file=self.outFile)
+            write('#include <sys/eventfd.h>', file=self.outFile)
+            write('#include <sys/mman.h>', file=self.outFile)
+            write('#include <sys/stat.h>', file=self.outFile)
+            write('#include <sys/syscall.h>', file=self.outFile)
+            write('#include <time.h>', file=self.outFile)
+            write('#include <unistd.h>', file=self.outFile)
+            write('#elif defined(_WIN32)', file=self.outFile)
+            write('#include <windows.h>', file=self.outFile)
+            write('#endif', file=self.outFile)
+            write('#if defined(__GLIBC__)', file=self.outFile)
+            write('#include <execinfo.h>', file=self.outFile)
+            write('#endif', file=self.outFile)
             write('#include "vk_typemap_helper.h"', file=self.outFile)
 
         write('namespace vkmock {', file=self.outFile)
@@ -1284,6 +4723,21 @@ class MockICDOutputGenerator(OutputGenerator):
         self.newline()
         if self.header:
             # record intercepted procedures
+            # opcodes of the recorded commands, indexing their names
+            write('enum CommandOpcode : uint32_t {', file=self.outFile)
+            write('\n'.join(['    kOp%s,' % name[2:] for name in self.recorded_commands]), file=self.outFile)
+            write('};\n', file=self.outFile)
+            write('static const char* const command_opcode_names[] = {', file=self.outFile)
+            write('\n'.join(['    "%s",' % name for name in self.recorded_commands]), file=self.outFile)
+            write('};\n', file=self.outFile)
+            # slots of the entry points that vkmock_SetHook can override
+            write('enum HookSlot : uint32_t {', file=self.outFile)
+            write('\n'.join([line if line.startswith('#') else '    kHook%s,' % line[2:] for line in self.hook_slots]), file=self.outFile)
+            write('    kHookSlotCount', file=self.outFile)
+            write('};\n', file=self.outFile)
+            write('static const std::unordered_map<std::string, uint32_t> name_to_hook_slot_map = {', file=self.outFile)
+            write('\n'.join([line if line.startswith('#') else '    {"%s", kHook%s},' % (line, line[2:]) for line in self.hook_slots]), file=self.outFile)
+            write('};\n', file=self.outFile)
             write('// Map of all APIs to be intercepted by this layer', file=self.outFile)
             write('static const std::unordered_map<std::string, void*> name_to_funcptr_map = {', file=self.outFile)
             write('\n'.join(self.intercepts), file=self.outFile)
@@ -1387,33 +4841,25 @@ class MockICDOutputGenerator(OutputGenerator):
             self.intercepts += [ '    {"%s", (void*)%s},' % (name,name[2:]) ]
             if (self.featureExtraProtect != None):
                 self.intercepts += [ '#endif' ]
+            if self.isRecordedCommand(name):
+                self.recorded_commands.append(name)
+            if name not in self.manual_functions or name in self.hooked_manual_functions:
+                if (self.featureExtraProtect != None):
+                    self.hook_slots += [ '#ifdef %s' % self.featureExtraProtect ]
+                self.hook_slots += [ name ]
+                if (self.featureExtraProtect != None):
+                    self.hook_slots += [ '#endif' ]
             return
 
-        manual_functions = [
-            # Include functions here to be intercepted w/ manually implemented function bodies
-            'vkGetDeviceProcAddr',
-            'vkGetInstanceProcAddr',
-            'vkCreateDevice',
-            'vkDestroyDevice',
-            'vkCreateInstance',
-            'vkDestroyInstance',
-            'vkFreeCommandBuffers',
-            'vkAllocateCommandBuffers',
-            'vkDestroyCommandPool',
-            #'vkCreateDebugReportCallbackEXT',
-            #'vkDestroyDebugReportCallbackEXT',
-            'vkEnumerateInstanceLayerProperties',
-            'vkEnumerateInstanceVersion',
-            'vkEnumerateInstanceExtensionProperties',
-            'vkEnumerateDeviceLayerProperties',
-            'vkEnumerateDeviceExtensionProperties',
-        ]
-        if name in manual_functions:
+        if name in self.manual_functions:
             self.appendSection('command', '')
             if name not in CUSTOM_C_INTERCEPTS:
                 self.appendSection('command', '// declare only')
                 self.appendSection('command', 'static %s' % (decls[0]))
                 self.appendSection('command', '// TODO: Implement custom intercept body')
+            elif name in self.hooked_manual_functions:
+                self.appendSection('command', 'static %s' % (decls[0][:-1]))
+                self.appendSection('command', '{\n%s%s}' % (self.hookCall(cmdinfo, name), CUSTOM_C_INTERCEPTS[name]))
             else:
                 self.appendSection('command', 'static %s' % (decls[0][:-1]))
                 self.appendSection('command', '{\n%s}' % (CUSTOM_C_INTERCEPTS[name]))
@@ -1427,31 +4873,40 @@ class MockICDOutputGenerator(OutputGenerator):
             self.intercepts += [ '#endif' ]
 
         OutputGenerator.genCmd(self, cmdinfo, name, alias)
+        if self.isRecordedCommand(name):
+            self.genRecordedStructs(cmdinfo)
         #
+        # if the name w/ KHR postfix is in the CUSTOM_C_INTERCEPTS, the KHR custom version becomes an implementation
+        # without hook that both entry points call, so hooks and the command stream see the entry point actually called
+        khr_name = name + "KHR"
+        shares_khr_implementation = khr_name in CUSTOM_C_INTERCEPTS and name not in CUSTOM_C_INTERCEPTS
+        if shares_khr_implementation:
+            self.appendSection('command', '')
+            self.appendSection('command', 'static %s' % (decls[0][:-1].replace(' %s(' % name[2:], ' %sImpl(' % name[2:])))
+            self.appendSection('command', '{%s}' % (CUSTOM_C_INTERCEPTS[khr_name]))
+            self.shared_implementations.add(khr_name)
         self.appendSection('command', '')
         self.appendSection('command', 'static %s' % (decls[0][:-1]))
+        hook_call = self.hookCall(cmdinfo, name)
+        if shares_khr_implementation or name in self.shared_implementations:
+            core_name = name if shares_khr_implementation else name[:-3]
+            if self.isRecordedCommand(name):
+                hook_call += '\n' + self.recordCommandCall(cmdinfo, name)
+            self.appendSection('command', '{\n%s\n%s\n}' % (hook_call, self.sharedImplementationCall(cmdinfo, core_name)))
+            return
         if name in CUSTOM_C_INTERCEPTS:
-            self.appendSection('command', '{%s}' % (CUSTOM_C_INTERCEPTS[name]))
+            if self.isRecordedCommand(name):
+                self.appendSection('command', '{\n%s\n%s%s}' % (hook_call, self.recordCommandCall(cmdinfo, name), CUSTOM_C_INTERCEPTS[name]))
+            else:
+                self.appendSection('command', '{\n%s%s}' % (hook_call, CUSTOM_C_INTERCEPTS[name]))
             return
 
         # Declare result variable, if any.
         resulttype = cmdinfo.elem.find('proto/type')
         if (resulttype != None and resulttype.text == 'void'):
             resulttype = None
-        # if the name w/ KHR postfix is in the CUSTOM_C_INTERCEPTS
-        # Call the KHR custom version instead of generating separate code
-        khr_name = name + "KHR"
-        if khr_name in CUSTOM_C_INTERCEPTS:
-            return_string = ''
-            if resulttype != None:
-                return_string = 'return '
-            params = cmdinfo.elem.findall('param/name')
-            param_names = []
-            for param in params:
-                param_names.append(param.text)
-            self.appendSection('command', '{\n    %s%s(%s);\n}' % (return_string, khr_name[2:], ", ".join(param_names)))
-            return
         self.appendSection('command', '{')
+        self.appendSection('command', hook_call)
 
         api_function_name = cmdinfo.elem.attrib.get('name')
         # GET THE TYPE OF FUNCTION
@@ -1464,31 +4919,31 @@ class MockICDOutputGenerator(OutputGenerator):
                 lp_len = last_param.attrib['len']
                 lp_len = lp_len.replace('::', '->')
             lp_type = last_param.find('type').text
-            handle_type = 'dispatchable'
-            allocator_txt = 'CreateDispObjHandle()';
+            # Dispatchable objects are all created by manual functions. NewHandle, TrackObjects and AddLiveObject are
+            # thread-safe, so creating a non-dispatchable object takes no lock.
             if (self.isHandleTypeNonDispatchable(lp_type)):
-                handle_type = 'non-' + handle_type
-                allocator_txt = 'global_unique_handle++';
-            # Need to lock in both cases
-            self.appendSection('command', '    unique_lock_t lock(global_lock);')
-            if (lp_len != None):
-                #print("%s last params (%s) has len %s" % (handle_type, lp_txt, lp_len))
-                self.appendSection('command', '    for (uint32_t i = 0; i < %s; ++i) {' % (lp_len))
-                self.appendSection('command', '        %s[i] = (%s)%s;' % (lp_txt, lp_type, allocator_txt))
-                self.appendSection('command', '    }')
-            else:
-                #print("Single %s last param is '%s' w/ type '%s'" % (handle_type, lp_txt, lp_type))
-                if 'AllocateMemory' in api_function_name:
-                    # Store allocation size in case it's mapped
-                    self.appendSection('command', '    allocated_memory_size_map[(VkDeviceMemory)global_unique_handle] = pAllocateInfo->allocationSize;')
-                self.appendSection('command', '    *%s = (%s)%s;' % (lp_txt, lp_type, allocator_txt))
+                handle_txt = 'NewHandle(%s, %s)' % (cmdinfo.elem.find('param/name').text, self.getHandleObjectType(lp_type))
+                if (lp_len != None):
+                    self.appendSection('command', '    for (uint32_t i = 0; i < %s; ++i) {' % (lp_len))
+                    self.appendSection('command', '        %s[i] = (%s)%s;' % (lp_txt, lp_type, handle_txt))
+                    self.appendSection('command', '        AddLiveObject("%s", (uint64_t)%s[i]);' % (lp_type, lp_txt))
+                    self.appendSection('command', '    }')
+                else:
+                    self.appendSection('command', '    *%s = (%s)%s;' % (lp_txt, lp_type, handle_txt))
+                self.appendSection('command', '    TrackObjects(%s, %s);' % (self.getHandleObjectType(lp_type), lp_len if lp_len != None else '1'))
+                if lp_len == None:
+                    self.appendSection('command', '    AddLiveObject("%s", (uint64_t)*%s);' % (lp_type, lp_txt))
         elif True in [ftxt in api_function_name for ftxt in ['Destroy', 'Free']]:
             self.appendSection('command', '//Destroy object')
-            if 'FreeMemory' in api_function_name:
-                # Remove from allocation map
-                self.appendSection('command', '    allocated_memory_size_map.erase(memory);')
+            params = cmdinfo.elem.findall('param')
+            if api_function_name.startswith('vkDestroy') and len(params) > 1 and self.isHandleTypeNonDispatchable(params[1].find('type').text):
+                handle_name = params[1].find('name').text
+                self.appendSection('command', '    if (%s != VK_NULL_HANDLE) TrackObjects(%s, -1);' % (handle_name, self.getHandleObjectType(params[1].find('type').text)))
+                self.appendSection('command', '    RemoveLiveObject((uint64_t)%s);' % handle_name)
         else:
             self.appendSection('command', '//Not a CREATE or DESTROY function')
+        if self.isRecordedCommand(name):
+            self.appendSection('command', self.recordCommandCall(cmdinfo, name))
 
         # Return result variable, if any.
         if (resulttype != None):
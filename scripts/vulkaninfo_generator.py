@@ -59,9 +59,10 @@ license_header = '''
 '''
 
 custom_formaters = r'''
-void DumpVkConformanceVersion(Printer &p, std::string name, VkConformanceVersion &c, int width = 0) {
-    p.PrintKeyString("conformanceVersion", std::to_string(c.major)+ "." + std::to_string(c.minor) + "." + std::to_string(c.subminor) + "."
-             + std::to_string(c.patch), width);
+void DumpVkConformanceVersion(Printer &p, util::string_view name, VkConformanceVersion &c, int width = 0) {
+    char version[16];
+    snprintf(version, sizeof(version), "%u.%u.%u.%u", c.major, c.minor, c.subminor, c.patch);
+    p.PrintKeyString("conformanceVersion", version, width);
 }
 
 template <typename T>
@@ -71,16 +72,6 @@ std::string to_hex_str(T i) {
     return stream.str();
 }
 
-template <typename T>
-std::string to_hex_str(Printer &p, T i) {
-    if (p.Type() == OutputType::json)
-        return std::to_string(i);
-    else if (p.Type() == OutputType::vkconfig_output)
-        return std::string("\"") + to_hex_str(i) + std::string("\"");
-    else
-        return to_hex_str(i);
-}
-
 '''
 
 
@@ -417,7 +408,7 @@ def PrintEnumToString(enum, gen):
 def PrintEnum(enum, gen):
     out = ''
     out += AddGuardHeader(GetExtension(enum.name, gen))
-    out += f"void Dump{enum.name}(Printer &p, std::string name, {enum.name} value, int width = 0) {{\n"
+    out += f"void Dump{enum.name}(Printer &p, util::string_view name, {enum.name} value, int width = 0) {{\n"
     out += f"    if (p.Type() == OutputType::json) {{\n"
     out += f"        p.PrintKeyValue(name, value, width);\n"
     out += f"    }} else {{\n"
@@ -427,20 +418,20 @@ def PrintEnum(enum, gen):
     return out
 
 
-def PrintGetFlagStrings(name, bitmask):
+def PrintForEachFlagString(name, bitmask):
     out = ''
-    out += f"std::vector<const char *>{name}GetStrings({name} value) {{\n"
-    out += f"    std::vector<const char *> strings;\n"
-    out += f"    if (value == 0) {{ strings.push_back(\"None\"); return strings; }}\n"
+    out += f"template <typename F>\n"
+    out += f"void {name}ForEachString({name} value, F &&f) {{\n"
+    out += f"    if (value == 0) {{ f(\"None\"); return; }}\n"
     for v in bitmask.options:
         val = v.value if isinstance(v.value, str) else str(hex(v.value))
-        out += f"    if ({val} & value) strings.push_back(\"{str(v.name[3:])}\");\n"
-    out += f"    return strings;\n}}\n"
+        out += f"    if ({val} & value) f(\"{str(v.name[3:])}\");\n"
+    out += f"}}\n"
     return out
 
 
 def PrintFlags(bitmask, name):
-    out = f"void Dump{name}(Printer &p, std::string name, {name} value, int width = 0) {{\n"
+    out = f"void Dump{name}(Printer &p, util::string_view name, {name} value, int width = 0) {{\n"
     out += f"    if (p.Type() == OutputType::json) {{ p.PrintKeyValue(name, value); return; }}\n"
     out += f"    if (static_cast<{bitmask.name}>(value) == 0) {{\n"
     out += f"        ArrayWrapper arr(p, name, 0);\n"
@@ -448,25 +439,26 @@ def PrintFlags(bitmask, name):
     out += f"            p.SetAsType().PrintString(\"None\");\n"
     out += f"        return;\n"
     out += f"    }}\n"
-    out += f"    auto strings = {bitmask.name}GetStrings(static_cast<{bitmask.name}>(value));\n"
-    out += f"    ArrayWrapper arr(p, name, strings.size());\n"
-    out += f"    for(auto& str : strings){{\n"
-    out += f"        p.SetAsType().PrintString(str);\n"
-    out += f"    }}\n"
+    out += f"    size_t count = 0;\n"
+    out += f"    {bitmask.name}ForEachString(static_cast<{bitmask.name}>(value), [&count](const char *) {{ count++; }});\n"
+    out += f"    ArrayWrapper arr(p, name, count);\n"
+    out += f"    {bitmask.name}ForEachString(static_cast<{bitmask.name}>(value), [&p](const char *str) {{ p.SetAsType().PrintString(str); }});\n"
     out += f"}}\n"
     return out
 
 
 def PrintFlagBits(bitmask):
-    out = f"void Dump{bitmask.name}(Printer &p, std::string name, {bitmask.name} value, int width = 0) {{\n"
-    out += f"    auto strings = {bitmask.name}GetStrings(value);\n"
-    out += f"    p.PrintKeyString(name, strings.at(0), width);\n"
+    out = f"void Dump{bitmask.name}(Printer &p, util::string_view name, {bitmask.name} value, int width = 0) {{\n"
+    out += f"    const char *first = \"\";\n"
+    out += f"    bool found = false;\n"
+    out += f"    {bitmask.name}ForEachString(value, [&](const char *str) {{ if (!found) {{ first = str; found = true; }} }});\n"
+    out += f"    p.PrintKeyString(name, first, width);\n"
     out += f"}}\n"
     return out
 
 
 def PrintBitMask(bitmask, name, gen):
-    out = PrintGetFlagStrings(bitmask.name, bitmask)
+    out = PrintForEachFlagString(bitmask.name, bitmask)
     out += AddGuardHeader(GetExtension(bitmask.name, gen))
     out += PrintFlags(bitmask, name)
     out += PrintFlagBits(bitmask)
@@ -505,7 +497,7 @@ def PrintStructure(struct, types_to_gen, structure_names, aliases):
             if len(v.name) > max_key_len:
                 max_key_len = len(v.name)
 
-    out += f"void Dump{struct.name}(Printer &p, std::string name, {struct.name} &obj) {{\n"
+    out += f"void Dump{struct.name}(Printer &p, util::string_view name, {struct.name} &obj) {{\n"
     if struct.name == "VkPhysicalDeviceLimits":
         out += f"    if (p.Type() == OutputType::json)\n"
         out += f"        p.ObjectStart(\"limits\");\n"
@@ -552,7 +544,7 @@ def PrintStructure(struct, types_to_gen, structure_names, aliases):
         elif v.typeID == "VkConformanceVersion":
             out += f"    DumpVkConformanceVersion(p, \"conformanceVersion\", obj.{v.name}, {str(max_key_len)});\n"
         elif v.typeID == "VkDeviceSize":
-            out += f"    p.PrintKeyValue(\"{v.name}\", to_hex_str(p, obj.{v.name}), {str(max_key_len)});\n"
+            out += f"    p.PrintKeyHex(\"{v.name}\", obj.{v.name}, {str(max_key_len)});\n"
         elif v.typeID in predefined_types:
             out += f"    p.PrintKeyValue(\"{v.name}\", obj.{v.name}, {str(max_key_len)});\n"
         elif v.name not in ['sType', 'pNext']:
@@ -21,14 +21,41 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <ostream>
 #include <stack>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace util {
+/* A string_view refers to characters it does not own, so that string literals, char arrays and std::strings can all be
+ * handed to the Printer without being copied into a new std::string.
+ * The interface is taken from C++17's <string_view> with many aspects removed.
+ */
+class string_view {
+  public:
+    string_view() = default;
+    string_view(const char *str) : str(str), length(strlen(str)) {}
+    string_view(const char *str, size_t length) : str(str), length(length) {}
+    string_view(const std::string &str) : str(str.data()), length(str.size()) {}
+
+    const char *data() const { return str; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+  private:
+    const char *str = "";
+    size_t length = 0;
+};
+}  // namespace util
 
 std::string insert_quotes(std::string s) { return "\"" + s + "\""; }
 
@@ -75,112 +102,115 @@ struct PrinterCreateDetails {
 class Printer {
   public:
     Printer(const PrinterCreateDetails &details, std::ostream &out, const uint32_t selected_gpu, const VulkanVersion vulkan_version)
-        : output_type(details.output_type), out(out) {
+        : output_type(details.output_type), out(out), buffer(buffer_size) {
         switch (output_type) {
             case (OutputType::text):
-                out << "==========\n";
-                out << "VULKANINFO\n";
-                out << "==========\n\n";
-                out << "Vulkan Instance Version: " << VkVersionString(vulkan_version) << "\n\n\n";
+                Write("==========\n");
+                Write("VULKANINFO\n");
+                Write("==========\n\n");
+                Write("Vulkan Instance Version: ");
+                Write(VkVersionString(vulkan_version));
+                Write("\n\n\n");
                 break;
             case (OutputType::html):
-                out << "<!doctype html>\n";
-                out << "<html lang='en'>\n";
-                out << "\t<head>\n";
-                out << "\t\t<title>vulkaninfo</title>\n";
-                out << "\t\t<style>\n";
-                out << "\t\thtml {\n";
-                out << "\t\t\tbackground-color: #0b1e48;\n";
-                out << "\t\t\tbackground-image: url(\"https://vulkan.lunarg.com/img/bg-starfield.jpg\");\n";
-                out << "\t\t\tbackground-position: center;\n";
-                out << "\t\t\t-webkit-background-size: cover;\n";
-                out << "\t\t\t-moz-background-size: cover;\n";
-                out << "\t\t\t-o-background-size: cover;\n";
-                out << "\t\t\tbackground-size: cover;\n";
-                out << "\t\t\tbackground-attachment: fixed;\n";
-                out << "\t\t\tbackground-repeat: no-repeat;\n";
-                out << "\t\t\theight: 100%;\n";
-                out << "\t\t}\n";
-                out << "\t\t#header {\n";
-                out << "\t\t\tz-index: -1;\n";
-                out << "\t\t}\n";
-                out << "\t\t#header>img {\n";
-                out << "\t\t\tposition: absolute;\n";
-                out << "\t\t\twidth: 160px;\n";
-                out << "\t\t\tmargin-left: -280px;\n";
-                out << "\t\t\ttop: -10px;\n";
-                out << "\t\t\tleft: 50%;\n";
-                out << "\t\t}\n";
-                out << "\t\t#header>h1 {\n";
-                out << "\t\t\tfont-family: Arial, \"Helvetica Neue\", Helvetica, sans-serif;\n";
-                out << "\t\t\tfont-size: 44px;\n";
-                out << "\t\t\tfont-weight: 200;\n";
-                out << "\t\t\ttext-shadow: 4px 4px 5px #000;\n";
-                out << "\t\t\tcolor: #eee;\n";
-                out << "\t\t\tposition: absolute;\n";
-                out << "\t\t\twidth: 400px;\n";
-                out << "\t\t\tmargin-left: -80px;\n";
-                out << "\t\t\ttop: 8px;\n";
-                out << "\t\t\tleft: 50%;\n";
-                out << "\t\t}\n";
-                out << "\t\tbody {\n";
-                out << "\t\t\tfont-family: Consolas, monaco, monospace;\n";
-                out << "\t\t\tfont-size: 14px;\n";
-                out << "\t\t\tline-height: 20px;\n";
-                out << "\t\t\tcolor: #eee;\n";
-                out << "\t\t\theight: 100%;\n";
-                out << "\t\t\tmargin: 0;\n";
-                out << "\t\t\toverflow: hidden;\n";
-                out << "\t\t}\n";
-                out << "\t\t#wrapper {\n";
-                out << "\t\t\tbackground-color: rgba(0, 0, 0, 0.7);\n";
-                out << "\t\t\tborder: 1px solid #446;\n";
-                out << "\t\t\tbox-shadow: 0px 0px 10px #000;\n";
-                out << "\t\t\tpadding: 8px 12px;\n\n";
-                out << "\t\t\tdisplay: inline-block;\n";
-                out << "\t\t\tposition: absolute;\n";
-                out << "\t\t\ttop: 80px;\n";
-                out << "\t\t\tbottom: 25px;\n";
-                out << "\t\t\tleft: 50px;\n";
-                out << "\t\t\tright: 50px;\n";
-                out << "\t\t\toverflow: auto;\n";
-                out << "\t\t}\n";
-                out << "\t\tdetails>details {\n";
-                out << "\t\t\tmargin-left: 22px;\n";
-                out << "\t\t}\n";
-                out << "\t\tdetails>summary:only-child::-webkit-details-marker {\n";
-                out << "\t\t\tdisplay: none;\n";
-                out << "\t\t}\n";
-                out << "\t\t.var, .type, .val {\n";
-                out << "\t\t\tdisplay: inline;\n";
-                out << "\t\t}\n";
-                out << "\t\t.var {\n";
-                out << "\t\t}\n";
-                out << "\t\t.type {\n";
-                out << "\t\t\tcolor: #acf;\n";
-                out << "\t\t\tmargin: 0 12px;\n";
-                out << "\t\t}\n";
-                out << "\t\t.val {\n";
-                out << "\t\t\tcolor: #afa;\n";
-                out << "\t\t\tbackground: #222;\n";
-                out << "\t\t\ttext-align: right;\n";
-                out << "\t\t}\n";
-                out << "\t\t</style>\n";
-                out << "\t</head>\n";
-                out << "\t<body>\n";
-                out << "\t\t<div id='header'>\n";
-                out << "\t\t\t<h1>vulkaninfo</h1>\n";
-                out << "\t\t</div>\n";
-                out << "\t\t<div id='wrapper'>\n";
-
-                out << "\t\t\t<details><summary>Vulkan Instance Version: <span class='val'>" << VkVersionString(vulkan_version)
-                    << "</span></summary></details>\n\t\t\t<br />\n";
+                Write("<!doctype html>\n");
+                Write("<html lang='en'>\n");
+                Write("\t<head>\n");
+                Write("\t\t<title>vulkaninfo</title>\n");
+                Write("\t\t<style>\n");
+                Write("\t\thtml {\n");
+                Write("\t\t\tbackground-color: #0b1e48;\n");
+                Write("\t\t\tbackground-image: url(\"https://vulkan.lunarg.com/img/bg-starfield.jpg\");\n");
+                Write("\t\t\tbackground-position: center;\n");
+                Write("\t\t\t-webkit-background-size: cover;\n");
+                Write("\t\t\t-moz-background-size: cover;\n");
+                Write("\t\t\t-o-background-size: cover;\n");
+                Write("\t\t\tbackground-size: cover;\n");
+                Write("\t\t\tbackground-attachment: fixed;\n");
+                Write("\t\t\tbackground-repeat: no-repeat;\n");
+                Write("\t\t\theight: 100%;\n");
+                Write("\t\t}\n");
+                Write("\t\t#header {\n");
+                Write("\t\t\tz-index: -1;\n");
+                Write("\t\t}\n");
+                Write("\t\t#header>img {\n");
+                Write("\t\t\tposition: absolute;\n");
+                Write("\t\t\twidth: 160px;\n");
+                Write("\t\t\tmargin-left: -280px;\n");
+                Write("\t\t\ttop: -10px;\n");
+                Write("\t\t\tleft: 50%;\n");
+                Write("\t\t}\n");
+                Write("\t\t#header>h1 {\n");
+                Write("\t\t\tfont-family: Arial, \"Helvetica Neue\", Helvetica, sans-serif;\n");
+                Write("\t\t\tfont-size: 44px;\n");
+                Write("\t\t\tfont-weight: 200;\n");
+                Write("\t\t\ttext-shadow: 4px 4px 5px #000;\n");
+                Write("\t\t\tcolor: #eee;\n");
+                Write("\t\t\tposition: absolute;\n");
+                Write("\t\t\twidth: 400px;\n");
+                Write("\t\t\tmargin-left: -80px;\n");
+                Write("\t\t\ttop: 8px;\n");
+                Write("\t\t\tleft: 50%;\n");
+                Write("\t\t}\n");
+                Write("\t\tbody {\n");
+                Write("\t\t\tfont-family: Consolas, monaco, monospace;\n");
+                Write("\t\t\tfont-size: 14px;\n");
+                Write("\t\t\tline-height: 20px;\n");
+                Write("\t\t\tcolor: #eee;\n");
+                Write("\t\t\theight: 100%;\n");
+                Write("\t\t\tmargin: 0;\n");
+                Write("\t\t\toverflow: hidden;\n");
+                Write("\t\t}\n");
+                Write("\t\t#wrapper {\n");
+                Write("\t\t\tbackground-color: rgba(0, 0, 0, 0.7);\n");
+                Write("\t\t\tborder: 1px solid #446;\n");
+                Write("\t\t\tbox-shadow: 0px 0px 10px #000;\n");
+                Write("\t\t\tpadding: 8px 12px;\n\n");
+                Write("\t\t\tdisplay: inline-block;\n");
+                Write("\t\t\tposition: absolute;\n");
+                Write("\t\t\ttop: 80px;\n");
+                Write("\t\t\tbottom: 25px;\n");
+                Write("\t\t\tleft: 50px;\n");
+                Write("\t\t\tright: 50px;\n");
+                Write("\t\t\toverflow: auto;\n");
+                Write("\t\t}\n");
+                Write("\t\tdetails>details {\n");
+                Write("\t\t\tmargin-left: 22px;\n");
+                Write("\t\t}\n");
+                Write("\t\tdetails>summary:only-child::-webkit-details-marker {\n");
+                Write("\t\t\tdisplay: none;\n");
+                Write("\t\t}\n");
+                Write("\t\t.var, .type, .val {\n");
+                Write("\t\t\tdisplay: inline;\n");
+                Write("\t\t}\n");
+                Write("\t\t.var {\n");
+                Write("\t\t}\n");
+                Write("\t\t.type {\n");
+                Write("\t\t\tcolor: #acf;\n");
+                Write("\t\t\tmargin: 0 12px;\n");
+                Write("\t\t}\n");
+                Write("\t\t.val {\n");
+                Write("\t\t\tcolor: #afa;\n");
+                Write("\t\t\tbackground: #222;\n");
+                Write("\t\t\ttext-align: right;\n");
+                Write("\t\t}\n");
+                Write("\t\t</style>\n");
+                Write("\t</head>\n");
+                Write("\t<body>\n");
+                Write("\t\t<div id='header'>\n");
+                Write("\t\t\t<h1>vulkaninfo</h1>\n");
+                Write("\t\t</div>\n");
+                Write("\t\t<div id='wrapper'>\n");
+
+                Write("\t\t\t<details><summary>Vulkan Instance Version: <span class='val'>");
+                Write(VkVersionString(vulkan_version));
+                Write("</span></summary></details>\n\t\t\t<br />\n");
                 indents += 3;
                 break;
             case (OutputType::json):
                 /* fall through */
             case (OutputType::vkconfig_output):
-                out << details.start_string;
+                Write(details.start_string);
                 indents++;
                 is_first_item.push(false);
                 is_array.push(false);
@@ -195,14 +225,14 @@ class Printer {
 
                 break;
             case (OutputType::html):
-                out << "\t\t</div>\n";
-                out << "\t</body>\n";
-                out << "</html>\n";
+                Write("\t\t</div>\n");
+                Write("\t</body>\n");
+                Write("</html>\n");
                 indents -= 3;
                 break;
             case (OutputType::json):
             case (OutputType::vkconfig_output):
-                out << "\n}\n";
+                Write("\n}\n");
                 indents--;
                 is_first_item.pop();
                 assert(is_first_item.empty() && "mismatched number of ObjectStart/ObjectEnd or ArrayStart/ArrayEnd's");
@@ -210,6 +240,7 @@ class Printer {
                 break;
         }
         assert(indents == 0 && "indents must be zero at program end");
+        Flush();
     };
 
     Printer(const Printer &) = delete;
@@ -225,18 +256,19 @@ class Printer {
                 break;
             case (OutputType::html):
                 while (indents > 3) {
-                    out << "</details>\n";
+                    Write("</details>\n");
                     indents--;
                 }
                 break;
             case (OutputType::json):
             case (OutputType::vkconfig_output):
                 while (indents > 1) {
-                    out << "\n" << std::string(static_cast<size_t>(indents), '\t');
+                    Write('\n');
+                    WriteIndent();
                     if (is_array.top()) {
-                        out << "]";
+                        Write(']');
                     } else {
-                        out << "}";
+                        Write('}');
                     }
                     is_array.pop();
                     indents--;
@@ -294,89 +326,106 @@ class Printer {
         return *this;
     }
 
-    void ObjectStart(std::string object_name, int32_t count_subobjects = -1) {
+    void ObjectStart(util::string_view object_name, int32_t count_subobjects = -1) {
         switch (output_type) {
             case (OutputType::text): {
-                out << std::string(static_cast<size_t>(indents), '\t') << object_name;
+                WriteIndent();
+                Write(object_name);
                 if (element_index != -1) {
-                    out << "[" << element_index << "]";
+                    Write('[');
+                    WriteValue(element_index);
+                    Write(']');
                 }
-                out << ":";
+                Write(':');
                 if (count_subobjects >= 0) {
-                    out << " count = " << count_subobjects;
+                    Write(" count = ");
+                    WriteValue(count_subobjects);
                 }
-                out << "\n";
+                Write('\n');
                 size_t headersize = object_name.size() + 1;
                 if (count_subobjects >= 0) {
-                    headersize += 9 + std::to_string(count_subobjects).size();
+                    headersize += 9 + CountDigits(static_cast<uint64_t>(count_subobjects));
                 }
                 if (element_index != -1) {
-                    headersize += 2 + std::to_string(element_index).size();
+                    headersize += 2 + CountDigits(static_cast<uint64_t>(element_index));
                     element_index = -1;
                 }
                 PrintHeaderUnderlines(headersize);
                 break;
             }
             case (OutputType::html):
-                out << std::string(static_cast<size_t>(indents), '\t');
+                WriteIndent();
                 if (set_details_open || should_always_open) {
-                    out << "<details open>";
+                    Write("<details open>");
                     set_details_open = false;
                 } else {
-                    out << "<details>";
+                    Write("<details>");
                 }
-                out << "<summary>";
+                Write("<summary>");
                 if (set_object_name_as_type) {
-                    out << "<span class='type'>" << object_name << "</span>";
+                    Write("<span class='type'>");
+                    Write(object_name);
+                    Write("</span>");
                     set_object_name_as_type = false;
                 } else {
-                    out << object_name;
+                    Write(object_name);
                 }
                 if (element_index != -1) {
-                    out << "[<span class='val'>" << element_index << "</span>]";
+                    Write("[<span class='val'>");
+                    WriteValue(element_index);
+                    Write("</span>]");
                     element_index = -1;
                 }
                 if (count_subobjects >= 0) {
-                    out << ": count = <span class='val'>" << std::to_string(count_subobjects) << "</span>";
+                    Write(": count = <span class='val'>");
+                    WriteValue(count_subobjects);
+                    Write("</span>");
                 }
-                out << "</summary>\n";
+                Write("</summary>\n");
                 break;
             case (OutputType::json):
                 if (!is_first_item.top()) {
-                    out << ",\n";
+                    Write(",\n");
                 } else {
                     is_first_item.top() = false;
                 }
-                out << std::string(static_cast<size_t>(indents), '\t');
+                WriteIndent();
                 // Objects with no name are elements in an array of objects
-                if (object_name == "" || element_index != -1) {
-                    out << "{\n";
+                if (object_name.empty() || element_index != -1) {
+                    Write("{\n");
                     element_index = -1;
                 } else {
-                    out << "\"" << object_name << "\": {\n";
+                    Write('"');
+                    Write(object_name);
+                    Write("\": {\n");
                 }
 
                 is_first_item.push(true);
                 is_array.push(false);
-
                 break;
             case (OutputType::vkconfig_output):
                 if (!is_first_item.top()) {
-                    out << ",\n";
+                    Write(",\n");
                 } else {
                     is_first_item.top() = false;
                 }
-                out << std::string(static_cast<size_t>(indents), '\t');
+                WriteIndent();
 
                 if (element_index != -1) {
-                    out << "\"" << object_name << "[" << element_index << "]\": {\n";
+                    Write('"');
+                    Write(object_name);
+                    Write('[');
+                    WriteValue(element_index);
+                    Write("]\": {\n");
                     element_index = -1;
                 } else {
-                    out << "\"" << object_name << "\": {\n";
+                    Write('"');
+                    Write(object_name);
+                    Write("\": {\n");
                 }
+
                 is_first_item.push(true);
                 is_array.push(false);
-
                 break;
             default:
                 break;
@@ -391,11 +440,14 @@ class Printer {
 
                 break;
             case (OutputType::html):
-                out << std::string(static_cast<size_t>(indents), '\t') << "</details>\n";
+                WriteIndent();
+                Write("</details>\n");
                 break;
             case (OutputType::json):
             case (OutputType::vkconfig_output):
-                out << "\n" << std::string(static_cast<size_t>(indents), '\t') << "}";
+                Write('\n');
+                WriteIndent();
+                Write('}');
                 is_first_item.pop();
                 assert(is_array.top() == false && "cannot call ObjectEnd while inside an Array");
                 is_array.pop();
@@ -404,42 +456,50 @@ class Printer {
                 break;
         }
     }
-    void ArrayStart(std::string array_name, size_t element_count = 0) {
+    void ArrayStart(util::string_view array_name, size_t element_count = 0) {
         switch (output_type) {
             case (OutputType::text): {
-                out << std::string(static_cast<size_t>(indents), '\t') << array_name << ":";
+                WriteIndent();
+                Write(array_name);
+                Write(':');
                 size_t underline_count = array_name.size() + 1;
                 if (element_count > 0) {
-                    out << " count = " << element_count;
-                    underline_count += 9 + std::to_string(element_count).size();
+                    Write(" count = ");
+                    WriteValue(element_count);
+                    underline_count += 9 + CountDigits(element_count);
                 }
-                out << "\n";
+                Write('\n');
                 PrintHeaderUnderlines(underline_count);
                 break;
             }
             case (OutputType::html):
-                out << std::string(static_cast<size_t>(indents), '\t');
+                WriteIndent();
                 if (set_details_open || should_always_open) {
-                    out << "<details open>";
+                    Write("<details open>");
                     set_details_open = false;
                 } else {
-                    out << "<details>";
+                    Write("<details>");
                 }
-                out << "<summary>" << array_name;
+                Write("<summary>");
+                Write(array_name);
                 if (element_count > 0) {
-                    out << ": count = <span class='val'>" << element_count << "</span>";
+                    Write(": count = <span class='val'>");
+                    WriteValue(element_count);
+                    Write("</span>");
                 }
-                out << "</summary>\n";
+                Write("</summary>\n");
                 break;
             case (OutputType::json):
             case (OutputType::vkconfig_output):
                 if (!is_first_item.top()) {
-                    out << ",\n";
+                    Write(",\n");
                 } else {
                     is_first_item.top() = false;
                 }
-                out << std::string(static_cast<size_t>(indents), '\t') << "\"" << array_name << "\": "
-                    << "[\n";
+                WriteIndent();
+                Write('"');
+                Write(array_name);
+                Write("\": [\n");
                 assert(is_array.top() == false && "Cant start an array object inside another array, must be enclosed in an object");
                 is_first_item.push(true);
                 is_array.push(true);
@@ -457,11 +517,14 @@ class Printer {
 
                 break;
             case (OutputType::html):
-                out << std::string(static_cast<size_t>(indents), '\t') << "</details>\n";
+                WriteIndent();
+                Write("</details>\n");
                 break;
             case (OutputType::json):
             case (OutputType::vkconfig_output):
-                out << "\n" << std::string(static_cast<size_t>(indents), '\t') << "]";
+                Write('\n');
+                WriteIndent();
+                Write(']');
                 is_first_item.pop();
                 assert(is_array.top() == true && "cannot call ArrayEnd while inside an Object");
                 is_array.pop();
@@ -475,54 +538,75 @@ class Printer {
     // min_key_width lines up the values listed
     // value_description is for reference information and is displayed inside parenthesis after the value
     template <typename T>
-    void PrintKeyValue(std::string key, T value, size_t min_key_width = 0, std::string value_description = "") {
+    void PrintKeyValue(util::string_view key, const T &value, size_t min_key_width = 0, util::string_view value_description = "") {
         switch (output_type) {
             case (OutputType::text):
-                out << std::string(static_cast<size_t>(indents), '\t') << key;
+                WriteIndent();
+                Write(key);
                 if (min_key_width > key.size() && !ignore_min_width_parameter) {
-                    out << std::string(min_key_width - key.size(), ' ');
+                    WriteRepeated(' ', min_key_width - key.size());
                 }
-                out << " = " << value;
-                if (value_description != "") {
-                    out << " (" << value_description << ")";
+                Write(" = ");
+                WriteValue(value);
+                if (!value_description.empty()) {
+                    Write(" (");
+                    Write(value_description);
+                    Write(')');
                 }
-                out << "\n";
+                Write('\n');
                 break;
             case (OutputType::html):
-                out << std::string(static_cast<size_t>(indents), '\t') << "<details><summary>" << key;
+                WriteIndent();
+                Write("<details><summary>");
+                Write(key);
                 if (min_key_width > key.size()) {
-                    out << std::string(min_key_width - key.size(), ' ');
+                    WriteRepeated(' ', min_key_width - key.size());
                 }
                 if (set_as_type) {
                     set_as_type = false;
-                    out << " = <span class='type'>" << value << "</span>";
+                    Write(" = <span class='type'>");
                 } else {
-                    out << " = <span class='val'>" << value << "</span>";
+                    Write(" = <span class='val'>");
                 }
-                if (value_description != "") {
-                    out << " (<span class='val'>" << value_description << "</span>)";
+                WriteValue(value);
+                Write("</span>");
+                if (!value_description.empty()) {
+                    Write(" (<span class='val'>");
+                    Write(value_description);
+                    Write("</span>)");
                 }
-                out << "</summary></details>\n";
+                Write("</summary></details>\n");
                 break;
             case (OutputType::json):
                 if (!is_first_item.top()) {
-                    out << ",\n";
+                    Write(",\n");
                 } else {
                     is_first_item.top() = false;
                 }
-                out << std::string(static_cast<size_t>(indents), '\t') << "\"" << key << "\": " << value;
+                WriteIndent();
+                Write('"');
+                Write(key);
+                Write("\": ");
+                WriteValue(value);
                 break;
             case (OutputType::vkconfig_output):
                 if (!is_first_item.top()) {
-                    out << ",\n";
+                    Write(",\n");
                 } else {
                     is_first_item.top() = false;
                 }
-                out << std::string(static_cast<size_t>(indents), '\t') << "\"" << key << "\": ";
-                if (value_description != "") {
-                    out << "\"" << value << " (" << value_description << ")\"";
+                WriteIndent();
+                Write('"');
+                Write(key);
+                Write("\": ");
+                if (!value_description.empty()) {
+                    Write('"');
+                    WriteValue(value);
+                    Write(" (");
+                    Write(value_description);
+                    Write(")\"");
                 } else {
-                    out << value;
+                    WriteValue(value);
                 }
             default:
                 break;
@@ -530,7 +614,8 @@ class Printer {
     }
 
     // For printing key - string pairs (necessary because of json)
-    void PrintKeyString(std::string key, std::string value, size_t min_key_width = 0, std::string value_description = "") {
+    void PrintKeyString(util::string_view key, util::string_view value, size_t min_key_width = 0,
+                        util::string_view value_description = "") {
         switch (output_type) {
             case (OutputType::text):
             case (OutputType::html):
@@ -538,7 +623,7 @@ class Printer {
                 break;
             case (OutputType::json):
             case (OutputType::vkconfig_output):
-                PrintKeyValue(key, std::string("\"") + value + "\"", min_key_width, value_description);
+                PrintKeyValue(key, Quoted{value}, min_key_width, value_description);
                 break;
             default:
                 break;
@@ -546,12 +631,12 @@ class Printer {
     }
 
     // For printing key - string pairs (necessary because of json)
-    void PrintKeyBool(std::string key, bool value, size_t min_key_width = 0, std::string value_description = "") {
+    void PrintKeyBool(util::string_view key, bool value, size_t min_key_width = 0, util::string_view value_description = "") {
         switch (output_type) {
             case (OutputType::text):
             case (OutputType::html):
             case (OutputType::vkconfig_output):
-                PrintKeyValue(key, value ? "true" : "false", min_key_width, value_description);
+                PrintKeyValue(key, util::string_view(value ? "true" : "false"), min_key_width, value_description);
                 break;
             case (OutputType::json):
                 PrintKeyValue(key, value, min_key_width, value_description);
@@ -561,44 +646,73 @@ class Printer {
         }
     }
 
+    // For printing key - integer pairs in hex, as 0x and at least as many digits as the integer has bytes. Json keeps
+    // the number in decimal.
+    template <typename T>
+    void PrintKeyHex(util::string_view key, T value, size_t min_key_width = 0) {
+        switch (output_type) {
+            case (OutputType::text):
+            case (OutputType::html):
+                PrintKeyValue(key, Hex{static_cast<uint64_t>(value), sizeof(T), false}, min_key_width);
+                break;
+            case (OutputType::json):
+                PrintKeyValue(key, value, min_key_width);
+                break;
+            case (OutputType::vkconfig_output):
+                PrintKeyValue(key, Hex{static_cast<uint64_t>(value), sizeof(T), true}, min_key_width);
+                break;
+            default:
+                break;
+        }
+    }
+
     // print inside array
     template <typename T>
-    void PrintElement(T element, std::string value_description = "") {
+    void PrintElement(const T &element, util::string_view value_description = "") {
         switch (output_type) {
             case (OutputType::text):
-                out << std::string(static_cast<size_t>(indents), '\t') << element;
-                if (value_description != "") {
-                    out << " (" << value_description << ")";
+                WriteIndent();
+                WriteValue(element);
+                if (!value_description.empty()) {
+                    Write(" (");
+                    Write(value_description);
+                    Write(')');
                 }
-                out << "\n";
+                Write('\n');
                 break;
             case (OutputType::html):
-                out << std::string(static_cast<size_t>(indents), '\t') << "<details><summary>";
+                WriteIndent();
+                Write("<details><summary>");
                 if (set_as_type) {
                     set_as_type = false;
-                    out << "<span class='type'>" << element << "</span>";
+                    Write("<span class='type'>");
                 } else {
-                    out << "<span class='val'>" << element << "</span>";
+                    Write("<span class='val'>");
                 }
-                if (value_description != "") {
-                    out << " (<span class='val'>" << value_description << "</span>)";
+                WriteValue(element);
+                Write("</span>");
+                if (!value_description.empty()) {
+                    Write(" (<span class='val'>");
+                    Write(value_description);
+                    Write("</span>)");
                 }
-                out << "</summary></details>\n";
+                Write("</summary></details>\n");
                 break;
             case (OutputType::json):
             case (OutputType::vkconfig_output):
                 if (!is_first_item.top()) {
-                    out << ",\n";
+                    Write(",\n");
                 } else {
                     is_first_item.top() = false;
                 }
-                out << std::string(static_cast<size_t>(indents), '\t') << element;
+                WriteIndent();
+                WriteValue(element);
                 break;
             default:
                 break;
         }
     }
-    void PrintString(std::string string, std::string value_description = "") {
+    void PrintString(util::string_view string, util::string_view value_description = "") {
         switch (output_type) {
             case (OutputType::text):
             case (OutputType::html):
@@ -606,21 +720,30 @@ class Printer {
                 break;
             case (OutputType::json):
             case (OutputType::vkconfig_output):
-                PrintElement("\"" + string + "\"", value_description);
+                PrintElement(Quoted{string}, value_description);
             default:
                 break;
         }
     }
-    void PrintExtension(std::string ext_name, uint32_t revision, size_t min_width = 0) {
+    void PrintExtension(util::string_view ext_name, uint32_t revision, size_t min_width = 0) {
         switch (output_type) {
             case (OutputType::text):
-                out << std::string(static_cast<size_t>(indents), '\t') << ext_name << std::string(min_width - ext_name.size(), ' ')
-                    << " : extension revision " << revision << "\n";
+                WriteIndent();
+                Write(ext_name);
+                WriteRepeated(' ', min_width > ext_name.size() ? min_width - ext_name.size() : 0);
+                Write(" : extension revision ");
+                WriteValue(revision);
+                Write('\n');
                 break;
             case (OutputType::html):
-                out << std::string(static_cast<size_t>(indents), '\t') << "<details><summary>" << DecorateAsType(ext_name)
-                    << std::string(min_width - ext_name.size(), ' ') << " : extension revision "
-                    << DecorateAsValue(std::to_string(revision)) << "</summary></details>\n";
+                WriteIndent();
+                Write("<details><summary><span class='type'>");
+                Write(ext_name);
+                Write("</span>");
+                WriteRepeated(' ', min_width > ext_name.size() ? min_width - ext_name.size() : 0);
+                Write(" : extension revision <span class='val'>");
+                WriteValue(revision);
+                Write("</span></summary></details>\n");
                 break;
             case (OutputType::json):
                 ObjectStart("");
@@ -639,7 +762,7 @@ class Printer {
     }
     void AddNewline() {
         if (output_type == OutputType::text) {
-            out << "\n";
+            Write('\n');
         }
     }
     void IndentIncrease() {
@@ -673,6 +796,12 @@ class Printer {
     std::ostream &out;
     int indents = 0;
 
+    // Output is gathered in one large block and handed to out whenever the block fills up, instead of going through
+    // out piece by piece
+    static const size_t buffer_size = 64 * 1024;
+    std::vector<char> buffer;
+    size_t buffer_used = 0;
+
     // header, subheader
     bool set_next_header = false;
     bool set_next_subheader = false;
@@ -694,22 +823,181 @@ class Printer {
     // objects which are in an array
     int element_index = -1;  // negative one is the sentinel value
 
-    // json
-    std::stack<bool> is_first_item;  // for json: for adding a comma inbetween objects
-    std::stack<bool> is_array;       // for json: match pairs of {}'s and []'s
+    // json, kept in vectors which hold on to their storage as objects and arrays open and close
+    std::stack<bool, std::vector<bool>> is_first_item;  // for json: for adding a comma inbetween objects
+    std::stack<bool, std::vector<bool>> is_array;       // for json: match pairs of {}'s and []'s
+
+    // Passes what operator<< formats straight to Write
+    class WriteStreambuf : public std::streambuf {
+      public:
+        explicit WriteStreambuf(Printer &printer) : printer(printer) {}
+
+      protected:
+        int_type overflow(int_type c) override {
+            if (!traits_type::eq_int_type(c, traits_type::eof())) printer.Write(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+        }
+        std::streamsize xsputn(const char *data, std::streamsize size) override {
+            printer.Write(data, static_cast<size_t>(size));
+            return size;
+        }
+
+      private:
+        Printer &printer;
+    };
+
+    // for values of types the Write functions don't know, which are formatted by their operator<< into the block
+    WriteStreambuf value_streambuf{*this};
+    std::ostream value_stream{&value_streambuf};
+
+    // A string written between double quotes, for json strings
+    struct Quoted {
+        util::string_view value;
+    };
+
+    // An integer written in hex with at least min_digits digits, between double quotes if quoted
+    struct Hex {
+        uint64_t value;
+        size_t min_digits;
+        bool quoted;
+    };
 
     // utility
     void PrintHeaderUnderlines(size_t length) {
         assert(indents >= 0 && "indents must not be negative");
         assert(length <= 10000 && "length shouldn't be unreasonably large");
         if (set_next_header) {
-            out << std::string(static_cast<size_t>(indents), '\t') << std::string(length, '=') << "\n";
+            WriteIndent();
+            WriteRepeated('=', length);
+            Write('\n');
             set_next_header = false;
         } else if (set_next_subheader) {
-            out << std::string(static_cast<size_t>(indents), '\t') << std::string(length, '-') << "\n";
+            WriteIndent();
+            WriteRepeated('-', length);
+            Write('\n');
             set_next_subheader = false;
         }
     }
+
+    void Flush() {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer_used));
+        buffer_used = 0;
+    }
+
+    void Write(const char *data, size_t size) {
+        if (size > buffer.size() - buffer_used) {
+            Flush();
+            if (size > buffer.size()) {
+                out.write(data, static_cast<std::streamsize>(size));
+                return;
+            }
+        }
+        memcpy(buffer.data() + buffer_used, data, size);
+        buffer_used += size;
+    }
+    void Write(util::string_view string) { Write(string.data(), string.size()); }
+    void Write(char c) {
+        if (buffer_used == buffer.size()) Flush();
+        buffer[buffer_used++] = c;
+    }
+
+    void WriteRepeated(char c, size_t count) {
+        while (count > 0) {
+            if (buffer_used == buffer.size()) Flush();
+            const size_t chunk = std::min(count, buffer.size() - buffer_used);
+            memset(buffer.data() + buffer_used, c, chunk);
+            buffer_used += chunk;
+            count -= chunk;
+        }
+    }
+
+    // Indentation is copied from a table of tabs rather than built for every line
+    void WriteIndent() {
+        static const char indent_table[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+        const size_t table_size = sizeof(indent_table) - 1;
+        size_t count = static_cast<size_t>(indents);
+        while (count > table_size) {
+            Write(indent_table, table_size);
+            count -= table_size;
+        }
+        Write(indent_table, count);
+    }
+
+    static size_t CountDigits(uint64_t value) {
+        size_t digits = 1;
+        while (value >= 10) {
+            value /= 10;
+            digits++;
+        }
+        return digits;
+    }
+
+    void WriteUnsigned(uint64_t value) {
+        char digits[20];
+        size_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (count > 0) Write(digits[--count]);
+    }
+
+    // Values are written the way out << value would write them with its default flags
+    void WriteValue(util::string_view value) { Write(value); }
+    void WriteValue(const char *value) { Write(util::string_view(value)); }
+    void WriteValue(const Quoted &value) {
+        Write('"');
+        Write(value.value);
+        Write('"');
+    }
+    void WriteValue(const Hex &value) {
+        char digits[16];
+        size_t count = 0;
+        uint64_t remaining = value.value;
+        do {
+            digits[count++] = "0123456789abcdef"[remaining % 16];
+            remaining /= 16;
+        } while (remaining > 0);
+        if (value.quoted) Write('"');
+        Write("0x");
+        if (value.min_digits > count) WriteRepeated('0', value.min_digits - count);
+        while (count > 0) Write(digits[--count]);
+        if (value.quoted) Write('"');
+    }
+    void WriteValue(bool value) { Write(value ? '1' : '0'); }
+    void WriteValue(char value) { Write(value); }
+    void WriteValue(signed char value) { Write(static_cast<char>(value)); }
+    void WriteValue(unsigned char value) { Write(static_cast<char>(value)); }
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type WriteValue(T value) {
+        if (value < 0) {
+            Write('-');
+            WriteUnsigned(0 - static_cast<uint64_t>(value));
+        } else {
+            WriteUnsigned(static_cast<uint64_t>(value));
+        }
+    }
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type WriteValue(T value) {
+        WriteUnsigned(static_cast<uint64_t>(value));
+    }
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type WriteValue(T value) {
+        WriteValue(static_cast<typename std::underlying_type<T>::type>(value));
+    }
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type WriteValue(T value) {
+        char digits[32];
+        const int count = snprintf(digits, sizeof(digits), "%g", static_cast<double>(value));
+        if (count > 0) Write(digits, std::min(static_cast<size_t>(count), sizeof(digits) - 1));
+    }
+    template <typename T>
+    typename std::enable_if<(std::is_class<T>::value || std::is_pointer<T>::value) &&
+                            !std::is_convertible<T, util::string_view>::value>::type
+    WriteValue(const T &value) {
+        T copy = value;  // the generated operator<< take their struct by non-const reference
+        value_stream << copy;
+    }
 };
 // Purpose: When a Printer starts an object or array it will automatically indent the output. This isn't
 // always desired, requiring a manual decrease of indention. This wrapper facilitates that while also
@@ -729,8 +1017,8 @@ class IndentWrapper {
 
 class ObjectWrapper {
   public:
-    ObjectWrapper(Printer &p, std::string object_name) : p(p) { p.ObjectStart(object_name); }
-    ObjectWrapper(Printer &p, std::string object_name, size_t count_subobjects) : p(p) {
+    ObjectWrapper(Printer &p, util::string_view object_name) : p(p) { p.ObjectStart(object_name); }
+    ObjectWrapper(Printer &p, util::string_view object_name, size_t count_subobjects) : p(p) {
         p.ObjectStart(object_name, static_cast<int32_t>(count_subobjects));
     }
     ~ObjectWrapper() { p.ObjectEnd(); }
@@ -741,7 +1029,9 @@ class ObjectWrapper {
 
 class ArrayWrapper {
   public:
-    ArrayWrapper(Printer &p, std::string array_name, size_t element_count = 0) : p(p) { p.ArrayStart(array_name, element_count); }
+    ArrayWrapper(Printer &p, util::string_view array_name, size_t element_count = 0) : p(p) {
+        p.ArrayStart(array_name, element_count);
+    }
     ~ArrayWrapper() { p.ArrayEnd(); }
 
   private:
@@ -33,7 +33,7 @@
 
 void DumpExtensions(Printer &p, std::string layer_name, std::vector<VkExtensionProperties> extensions, bool do_indent) {
     std::sort(extensions.begin(), extensions.end(), [](VkExtensionProperties &a, VkExtensionProperties &b) -> int {
-        return std::string(a.extensionName) < std::string(b.extensionName);
+        return std::strcmp(a.extensionName, b.extensionName) < 0;
     });
 
     size_t max_length = 0;
@@ -351,8 +351,8 @@ void GpuDumpQueueProps(Printer &p, std::vector<SurfaceExtension> &surfaces, cons
             if (surface.name.size() > width) width = surface.name.size();
         }
         ObjectWrapper obj_present_support(p, "present support");
-        for (auto &surface : surfaces) {
-            p.PrintKeyString(surface.name, surface.supports_present ? "true" : "false", width);
+        for (size_t i = 0; i < surfaces.size(); ++i) {
+            p.PrintKeyString(surfaces[i].name, queue.surfaces_support_present[i] ? "true" : "false", width);
         }
     }
 
@@ -594,16 +594,9 @@ void GpuDevDump(Printer &p, AppGpu &gpu) {
             p.SetAsType().PrintString(VkFormatString(fmt));
         }
     } else {
-        for (auto &format : gpu.supported_format_ranges) {
-            if (gpu.FormatRangeSupported(format)) {
-                for (int32_t fmt_counter = format.first_format; fmt_counter <= format.last_format; ++fmt_counter) {
-                    VkFormat fmt = static_cast<VkFormat>(fmt_counter);
-
-                    VkFormatProperties props;
-                    gpu.inst.dll.fp_vkGetPhysicalDeviceFormatProperties(gpu.phys_device, fmt, &props);
-
-                    GpuDumpFormatProperty(p, fmt, props);
-                }
+        for (auto &format_props : gpu.format_properties) {
+            if (format_props.range_supported) {
+                GpuDumpFormatProperty(p, format_props.format, format_props.props);
             }
         }
     }
@@ -613,22 +606,60 @@ void GpuDevDump(Printer &p, AppGpu &gpu) {
 
 void GpuDevDumpJson(Printer &p, AppGpu &gpu) {
     ArrayWrapper arr(p, "ArrayOfVkFormatProperties");
-    for (auto &format : gpu.supported_format_ranges) {
-        if (gpu.FormatRangeSupported(format)) {
-            for (int32_t fmt_counter = format.first_format; fmt_counter <= format.last_format; ++fmt_counter) {
-                VkFormat fmt = static_cast<VkFormat>(fmt_counter);
+    for (auto &format_props : gpu.format_properties) {
+        if (format_props.range_supported) {
+            const VkFormatProperties &props = format_props.props;
+
+            // don't print format properties that are unsupported
+            if ((props.linearTilingFeatures || props.optimalTilingFeatures || props.bufferFeatures) == 0) continue;
+
+            GpuDumpFormatProperty(p, format_props.format, props);
+        }
+    }
+}
 
-                VkFormatProperties props;
-                gpu.inst.dll.fp_vkGetPhysicalDeviceFormatProperties(gpu.phys_device, fmt, &props);
+// Print the parameters each row of the image format matrix goes through
+void DumpImageFormatMatrixLayout(Printer &p) {
+    ObjectWrapper obj(p, "Layout");
+    p.PrintKeyString("imageType", "IMAGE_TYPE_1D, IMAGE_TYPE_2D, IMAGE_TYPE_3D");
+    p.PrintKeyString("tiling", "IMAGE_TILING_OPTIMAL, IMAGE_TILING_LINEAR");
+    p.PrintKeyString("flags", "0, MUTABLE_FORMAT, CUBE_COMPATIBLE, SPARSE_BINDING, SPARSE_BINDING | SPARSE_RESIDENCY, "
+                              "SPARSE_BINDING | SPARSE_ALIASED");
+    p.PrintKeyString("usage", "0x01 to 0xFF");
+    p.PrintKeyString("runs", "<cell count>*<record index>, or <cell count>*- for unsupported cells");
+}
 
-                // don't print format properties that are unsupported
-                if ((props.linearTilingFeatures || props.optimalTilingFeatures || props.bufferFeatures) == 0) continue;
+// Print the deduplicated records and the run-length encoded rows of a GPU's image format matrix
+void DumpImageFormatMatrix(Printer &p, AppGpu &gpu) {
+    const ImageFormatMatrix matrix = BuildImageFormatMatrix(gpu);
 
-                GpuDumpFormatProperty(p, fmt, props);
-            }
+    ObjectWrapper obj_gpu(p, "GPU" + std::to_string(gpu.id));
+    p.PrintKeyString("deviceName", gpu.props.deviceName);
+    p.PrintKeyString("driverVersion", std::to_string(gpu.props.driverVersion));
+    {
+        ObjectWrapper obj_records(p, "Records", matrix.records.size());
+        for (size_t i = 0; i < matrix.records.size(); ++i) {
+            const VkImageFormatProperties &record = matrix.records[i];
+            const std::string extent = std::to_string(record.maxExtent.width) + "x" + std::to_string(record.maxExtent.height) +
+                                       "x" + std::to_string(record.maxExtent.depth);
+            p.PrintKeyString(std::to_string(i), "maxExtent = " + extent + ", maxMipLevels = " +
+                                                    std::to_string(record.maxMipLevels) + ", maxArrayLayers = " +
+                                                    std::to_string(record.maxArrayLayers) + ", sampleCounts = " +
+                                                    to_hex_str(record.sampleCounts) + ", maxResourceSize = " +
+                                                    std::to_string(record.maxResourceSize));
+        }
+    }
+    ObjectWrapper obj_rows(p, "Formats", matrix.rows.size());
+    for (auto &row : matrix.rows) {
+        std::string runs;
+        for (auto &run : row.runs) {
+            if (!runs.empty()) runs += " ";
+            runs += std::to_string(run.length) + "*" + (run.record < 0 ? std::string("-") : std::to_string(run.record));
         }
+        p.PrintKeyString(VkFormatString(row.format), runs);
     }
 }
+
 // Print gpu info for text, html, & vkconfig_output
 // Uses a seperate function than schema-json for clarity
 void DumpGpu(Printer &p, AppGpu &gpu, bool show_tooling_info, bool show_formats) {
@@ -810,7 +841,8 @@ enum class OutputCategory {
 #if defined(VK_ENABLE_BETA_EXTENSIONS)
     portability_json,
 #endif
-    summary
+    summary,
+    image_format_matrix
 };
 
 void print_usage(const char *argv0) {
@@ -841,9 +873,15 @@ void print_usage(const char *argv0) {
     std::cout << "--show-formats      Display the format properties of each physical device.\n";
     std::cout << "                    Note: This option does not affect html or json output;\n";
     std::cout << "                    they will always print format properties.\n";
+    std::cout << "--image-format-matrix\n";
+    std::cout << "                    Query the image format properties of every format, image type,\n";
+    std::cout << "                    tiling, usage and create flags combination of each physical\n";
+    std::cout << "                    device, and print them as a run-length encoded table.\n";
     std::cout << "-o <filename>, --output<filename>\n";
     std::cout << "                    Print output to a new file whose name is specified by filename.\n";
     std::cout << "                    File will be written to the current working directory.\n";
+    std::cout << "--cache <directory> Save the output in the given directory, and print the saved output\n";
+    std::cout << "                    as long as the loader, drivers, layers and devices are unchanged.\n";
     std::cout << "\n";
 }
 
@@ -856,6 +894,8 @@ struct ParsedResults {
     bool print_to_file;
     std::string filename;  // set if explicitely given, or if vkconfig_output has a <path> argument
     std::string default_filename;
+    std::string cache_dir;         // set with --cache
+    std::string output_arguments;  // the arguments other than --cache, which select what is printed
 };
 
 util::vulkaninfo_optional<ParsedResults> parse_arguments(int argc, char **argv) {
@@ -863,6 +903,7 @@ util::vulkaninfo_optional<ParsedResults> parse_arguments(int argc, char **argv)
     results.output_category = OutputCategory::text;  // default output category
     results.default_filename = "vulkaninfo.txt";
     for (int i = 1; i < argc; ++i) {
+        const int first_arg = i;
         // A internal-use-only format for communication with the Vulkan Configurator tool
         // Usage "--vkconfig_output <path>"
         // -o can be used to specify the filename instead
@@ -907,6 +948,8 @@ util::vulkaninfo_optional<ParsedResults> parse_arguments(int argc, char **argv)
             results.show_tool_props = true;
         } else if (strcmp(argv[i], "--show-formats") == 0) {
             results.show_formats = true;
+        } else if (strcmp(argv[i], "--image-format-matrix") == 0) {
+            results.output_category = OutputCategory::image_format_matrix;
         } else if ((strcmp(argv[i], "--output") == 0 || strcmp(argv[i], "-o") == 0) && argc > (i + 1)) {
             if (argv[i + 1][0] == '-') {
                 std::cout << "-o or --output must be followed by a filename\n";
@@ -915,6 +958,10 @@ util::vulkaninfo_optional<ParsedResults> parse_arguments(int argc, char **argv)
             results.print_to_file = true;
             results.filename = argv[i + 1];
             ++i;
+        } else if (strcmp(argv[i], "--cache") == 0 && argc > (i + 1)) {
+            results.cache_dir = argv[i + 1];
+            ++i;
+            continue;
         } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
             print_usage(argv[0]);
             return {};
@@ -922,6 +969,7 @@ util::vulkaninfo_optional<ParsedResults> parse_arguments(int argc, char **argv)
             print_usage(argv[0]);
             return {};
         }
+        for (int j = first_arg; j <= i; ++j) results.output_arguments += std::string(argv[j]) + " ";
     }
     return results;
 }
@@ -997,6 +1045,16 @@ void RunPrinter(Printer &p, ParsedResults parse_data, AppInstance &instance, std
     } else if (parse_data.output_category == OutputCategory::devsim_json) {
         DumpLayers(p, instance.global_layers, gpus);
         DumpGpuJson(p, *(gpus.at(parse_data.selected_gpu).get()));
+    } else if (parse_data.output_category == OutputCategory::image_format_matrix) {
+        p.SetHeader();
+        ObjectWrapper obj(p, "Image Format Matrix");
+        IndentWrapper indent(p);
+        DumpImageFormatMatrixLayout(p);
+        p.AddNewline();
+        for (auto &gpu : gpus) {
+            DumpImageFormatMatrix(p, *(gpu.get()));
+            p.AddNewline();
+        }
     } else {
         // text, html, vkconfig_output
         p.SetHeader();
@@ -1018,6 +1076,318 @@ void RunPrinter(Printer &p, ParsedResults parse_data, AppInstance &instance, std
     }
 }
 
+// ============ Capability Cache ============= //
+
+// With --cache <dir>, the output of a run is saved along with a description of everything it depends on: the arguments,
+// the loader, the ICD and layer manifests, the libraries loaded into the process, the variables that select layers and
+// drivers, the layers and instance extensions, and the identity of each physical device. A later run with the same
+// arguments that finds the same description prints the saved output straight from the memory mapped file, without
+// creating windows or devices or querying any capabilities.
+static const char cache_magic[8] = {'V', 'K', 'I', 'C', 'A', 'C', 'H', 'E'};
+static const uint32_t cache_format_version = 1;
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t identity_size;
+    uint64_t output_size;
+};
+
+// FNV-1a, used to name the cache file after the arguments
+uint64_t HashString(const std::string &str) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : str) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string DescribeFile(const std::string &path) {
+    struct stat file_stat;
+    if (stat(path.c_str(), &file_stat) != 0) return path + " missing\n";
+    return path + " " + std::to_string(static_cast<long long>(file_stat.st_size)) + " " +
+           std::to_string(static_cast<long long>(file_stat.st_mtime)) + "\n";
+}
+
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+std::vector<std::string> SplitPathList(const char *list) {
+    std::vector<std::string> paths;
+    std::stringstream stream(list ? list : "");
+    std::string path;
+    while (std::getline(stream, path, ':')) {
+        if (!path.empty()) paths.push_back(path);
+    }
+    return paths;
+}
+
+// Lists the .json manifests of each directory in search_paths, sorted per directory. A path that is not a directory,
+// such as a manifest named directly in VK_DRIVER_FILES, is listed as is.
+std::vector<std::string> ListManifests(const std::vector<std::string> &search_paths) {
+    std::vector<std::string> manifests;
+    for (const auto &path : search_paths) {
+        DIR *dir = opendir(path.c_str());
+        if (!dir) {
+            manifests.push_back(path);
+            continue;
+        }
+        std::vector<std::string> dir_manifests;
+        while (const dirent *entry = readdir(dir)) {
+            const std::string name = entry->d_name;
+            if (name.size() > 5 && name.compare(name.size() - 5, 5, ".json") == 0) dir_manifests.push_back(path + "/" + name);
+        }
+        closedir(dir);
+        std::sort(dir_manifests.begin(), dir_manifests.end());
+        manifests.insert(manifests.end(), dir_manifests.begin(), dir_manifests.end());
+    }
+    return manifests;
+}
+
+// The manifests the loader reads from the <subdir> directories of the XDG configuration and data directories, replaced
+// by the paths in override_var and extended by the paths in add_var when those are set
+std::vector<std::string> FindManifests(const char *override_var, const char *add_var, const std::string &subdir) {
+    std::vector<std::string> search_paths;
+    const char *override_paths = override_var ? getenv(override_var) : nullptr;
+    if (override_paths) {
+        search_paths = SplitPathList(override_paths);
+    } else {
+        const char *config_dirs = getenv("XDG_CONFIG_DIRS");
+        const char *data_dirs = getenv("XDG_DATA_DIRS");
+        const char *home = getenv("HOME");
+        std::vector<std::string> bases = SplitPathList(config_dirs ? config_dirs : "/etc/xdg");
+        bases.push_back("/etc");
+        for (const auto &base : SplitPathList(data_dirs ? data_dirs : "/usr/local/share:/usr/share")) bases.push_back(base);
+        if (home) bases.push_back(std::string(home) + "/.local/share");
+        for (const auto &base : bases) search_paths.push_back(base + "/vulkan/" + subdir);
+    }
+    if (add_var) {
+        for (const auto &path : SplitPathList(getenv(add_var))) search_paths.push_back(path);
+    }
+    return ListManifests(search_paths);
+}
+
+// The ICD manifests the loader reads, from VK_DRIVER_FILES or VK_ICD_FILENAMES if set, otherwise from the icd.d
+// directories
+std::vector<std::string> FindIcdManifests() {
+    const char *override_var = getenv("VK_DRIVER_FILES") ? "VK_DRIVER_FILES" : "VK_ICD_FILENAMES";
+    return FindManifests(override_var, "VK_ADD_DRIVER_FILES", "icd.d");
+}
+
+// The library_path entries of an ICD or layer manifest, relative to the manifest if they are relative paths. A bare
+// library name is returned as is, since the dynamic linker searches for it. Layer manifests may list several layers.
+std::vector<std::string> GetManifestLibraryPaths(const std::string &manifest) {
+    std::ifstream file(manifest);
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<std::string> libraries;
+    size_t pos = contents.find("\"library_path\"");
+    while (pos != std::string::npos) {
+        const size_t colon = contents.find(':', pos);
+        const size_t start = colon == std::string::npos ? colon : contents.find('"', colon);
+        const size_t end = start == std::string::npos ? start : contents.find('"', start + 1);
+        if (end == std::string::npos) break;
+        const std::string library = contents.substr(start + 1, end - start - 1);
+        if (library.empty() || library[0] == '/' || library.find('/') == std::string::npos) {
+            libraries.push_back(library);
+        } else {
+            libraries.push_back(manifest.substr(0, manifest.rfind('/') + 1) + library);
+        }
+        pos = contents.find("\"library_path\"", end);
+    }
+    return libraries;
+}
+
+// Describes each manifest and the libraries it names. A bare library name is listed by name only; the file the dynamic
+// linker found for it is described with the loaded libraries.
+std::string DescribeManifests(const std::vector<std::string> &manifests) {
+    std::string description;
+    for (const auto &manifest : manifests) {
+        description += DescribeFile(manifest);
+        for (const auto &library : GetManifestLibraryPaths(manifest)) {
+            if (library.find('/') != std::string::npos) {
+                description += DescribeFile(library);
+            } else if (!library.empty()) {
+                description += library + "\n";
+            }
+        }
+    }
+    return description;
+}
+#endif
+
+#if defined(__linux__) || defined(__FreeBSD__)
+int AddLoadedLibrary(struct dl_phdr_info *info, size_t, void *data) {
+    if (info->dlpi_name && info->dlpi_name[0] != '\0') static_cast<std::set<std::string> *>(data)->insert(info->dlpi_name);
+    return 0;
+}
+#endif
+
+// Describes every library loaded into the process, sorted by path. Called once the instance exists and the loader has
+// loaded the drivers and layers, so the files the drivers and layers were actually loaded from are included.
+std::string DescribeLoadedLibraries() {
+    std::string description;
+#if defined(_WIN32)
+    std::set<std::wstring> libraries;
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE, 0);
+    if (snapshot != INVALID_HANDLE_VALUE) {
+        MODULEENTRY32W entry{};
+        entry.dwSize = sizeof(entry);
+        for (BOOL found = Module32FirstW(snapshot, &entry); found; found = Module32NextW(snapshot, &entry)) {
+            libraries.insert(entry.szExePath);
+        }
+        CloseHandle(snapshot);
+    }
+    for (const auto &library : libraries) {
+        const int length = WideCharToMultiByte(CP_UTF8, 0, library.c_str(), -1, nullptr, 0, nullptr, nullptr);
+        std::string path(length > 0 ? length - 1 : 0, '\0');
+        if (length > 0) WideCharToMultiByte(CP_UTF8, 0, library.c_str(), -1, &path[0], length, nullptr, nullptr);
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (!GetFileAttributesExW(library.c_str(), GetFileExInfoStandard, &attributes)) {
+            description += "library " + path + " missing\n";
+            continue;
+        }
+        const uint64_t size = (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+        const uint64_t write_time =
+            (static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+        description += "library " + path + " " + std::to_string(size) + " " + std::to_string(write_time) + "\n";
+    }
+#else
+    std::set<std::string> libraries;
+#if defined(__linux__) || defined(__FreeBSD__)
+    dl_iterate_phdr(AddLoadedLibrary, &libraries);
+#elif defined(__APPLE__)
+    for (uint32_t i = 0; i < _dyld_image_count(); ++i) {
+        const char *name = _dyld_get_image_name(i);
+        if (name) libraries.insert(name);
+    }
+#endif
+    for (const auto &library : libraries) description += "library " + DescribeFile(library);
+#endif
+    return description;
+}
+
+std::string BuildCacheIdentity(const ParsedResults &parse_data, AppInstance &inst,
+                               const std::vector<VkPhysicalDevice> &phys_devices) {
+    std::string identity = "arguments " + parse_data.output_arguments + "\n";
+    identity += "loader " + std::to_string(inst.instance_version) + "\n";
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+    Dl_info loader_info;
+    if (dladdr(reinterpret_cast<void *>(inst.dll.fp_vkCreateInstance), &loader_info) && loader_info.dli_fname) {
+        identity += DescribeFile(loader_info.dli_fname);
+    }
+    identity += DescribeManifests(FindIcdManifests());
+    identity += DescribeManifests(FindManifests("VK_IMPLICIT_LAYER_PATH", "VK_ADD_IMPLICIT_LAYER_PATH", "implicit_layer.d"));
+    identity += DescribeManifests(FindManifests("VK_LAYER_PATH", "VK_ADD_LAYER_PATH", "explicit_layer.d"));
+#endif
+    identity += DescribeLoadedLibraries();
+    // The variables that select which of the layers and drivers the loader enables
+    for (const char *var : {"VK_INSTANCE_LAYERS", "VK_LOADER_LAYERS_ENABLE", "VK_LOADER_LAYERS_DISABLE",
+                            "VK_LOADER_DRIVERS_SELECT", "VK_LOADER_DRIVERS_DISABLE"}) {
+        const char *value = getenv(var);
+        if (value) identity += std::string("env ") + var + "=" + value + "\n";
+    }
+    for (const auto &layer : inst.global_layers) {
+        identity += std::string("layer ") + layer.layer_properties.layerName + " " +
+                    std::to_string(layer.layer_properties.specVersion) + " " +
+                    std::to_string(layer.layer_properties.implementationVersion) + "\n";
+    }
+    for (const auto &extension : inst.global_extensions) {
+        identity += std::string("extension ") + extension.extensionName + " " + std::to_string(extension.specVersion) + "\n";
+    }
+    for (const auto &surface_extension : inst.surface_extensions) {
+        identity += "surface " + surface_extension.name + "\n";
+    }
+    for (const auto phys_device : phys_devices) {
+        VkPhysicalDeviceProperties props;
+        inst.dll.fp_vkGetPhysicalDeviceProperties(phys_device, &props);
+        uint8_t device_uuid[VK_UUID_SIZE] = {};
+        if (props.apiVersion >= VK_API_VERSION_1_1 &&
+            inst.CheckExtensionEnabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME)) {
+            VkPhysicalDeviceIDProperties id_props{};
+            id_props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+            VkPhysicalDeviceProperties2 props2{};
+            props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            props2.pNext = &id_props;
+            inst.ext_funcs.vkGetPhysicalDeviceProperties2KHR(phys_device, &props2);
+            memcpy(device_uuid, id_props.deviceUUID, VK_UUID_SIZE);
+        }
+        identity += std::string("device ") + props.deviceName + " " + std::to_string(props.vendorID) + " " +
+                    std::to_string(props.deviceID) + " " + std::to_string(props.driverVersion) + " " +
+                    std::to_string(props.apiVersion);
+        for (const uint8_t byte : device_uuid) identity += " " + std::to_string(byte);
+        for (const uint8_t byte : props.pipelineCacheUUID) identity += " " + std::to_string(byte);
+        identity += "\n";
+    }
+    return identity;
+}
+
+std::string GetCachePath(const ParsedResults &parse_data) {
+    return parse_data.cache_dir + "/vulkaninfo-" + std::to_string(HashString(parse_data.output_arguments)) + ".cache";
+}
+
+// Prints the output saved in the cache file if it was saved for the same identity. Returns whether it did.
+bool PrintCachedOutput(const std::string &path, const std::string &identity, std::ostream &out) {
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat file_stat;
+    void *data = MAP_FAILED;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size >= static_cast<off_t>(sizeof(CacheHeader))) {
+        data = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (data == MAP_FAILED) return false;
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    const char *bytes = static_cast<const char *>(data);
+#else
+    std::ifstream file(path, std::ios::binary);
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const size_t size = contents.size();
+    const char *bytes = contents.data();
+#endif
+    CacheHeader header{};
+    if (size >= sizeof(header)) memcpy(&header, bytes, sizeof(header));
+    const bool hit = size >= sizeof(header) && memcmp(header.magic, cache_magic, sizeof(cache_magic)) == 0 &&
+                     header.format_version == cache_format_version && header.identity_size == identity.size() &&
+                     sizeof(header) + header.identity_size + header.output_size == size &&
+                     memcmp(bytes + sizeof(header), identity.data(), identity.size()) == 0;
+    if (hit) {
+        out.write(bytes + sizeof(header) + header.identity_size, static_cast<std::streamsize>(header.output_size));
+        out.flush();
+    }
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+    munmap(data, size);
+#endif
+    return hit;
+}
+
+// Writes the cache file next to its final path and renames it into place, so concurrent runs never read half of it
+void SaveCachedOutput(const std::string &path, const std::string &identity, const std::string &output) {
+    CacheHeader header{};
+    memcpy(header.magic, cache_magic, sizeof(cache_magic));
+    header.format_version = cache_format_version;
+    header.identity_size = static_cast<uint32_t>(identity.size());
+    header.output_size = output.size();
+#ifdef _WIN32
+    const unsigned long long pid = GetCurrentProcessId();
+#else
+    const unsigned long long pid = static_cast<unsigned long long>(getpid());
+#endif
+    const std::string temp_path = path + ".tmp" + std::to_string(pid);
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file << identity << output;
+        if (!file) {
+            file.close();
+            remove(temp_path.c_str());
+            return;
+        }
+    }
+#ifdef _WIN32
+    remove(path.c_str());
+#endif
+    if (rename(temp_path.c_str(), path.c_str()) != 0) remove(temp_path.c_str());
+}
+
 #ifdef VK_USE_PLATFORM_IOS_MVK
 // On iOS, we'll call this ourselves from a parent routine in the GUI
 int vulkanInfoMain(int argc, char **argv) {
@@ -1044,6 +1414,11 @@ int main(int argc, char **argv) {
     std::ostream std_out(std::cout.rdbuf());
     std::ofstream file_out;
     std::ostream *out = &std_out;
+    // With --cache, the printer writes here, and the output is copied out and saved once it is complete
+    std::ostringstream cache_out;
+    std::string cache_path;
+    std::string cache_identity;
+    bool save_cache = false;
 
     // if any essential vulkan call fails, it throws an exception
     try {
@@ -1052,22 +1427,36 @@ int main(int argc, char **argv) {
 
         auto phys_devices = instance.FindPhysicalDevices();
 
-        std::vector<std::unique_ptr<AppSurface>> surfaces;
+        if (!parse_data.cache_dir.empty()) {
+            cache_path = GetCachePath(parse_data);
+            cache_identity = BuildCacheIdentity(parse_data, instance, phys_devices);
+            if (parse_data.print_to_file) {
+                file_out = std::ofstream(!parse_data.filename.empty() ? parse_data.filename : parse_data.default_filename);
+                out = &file_out;
+            }
+            if (PrintCachedOutput(cache_path, cache_identity, *out)) return 0;
+        }
+
+        // Windowing systems are not thread safe, so windows and surfaces are created here, before probing starts
         for (auto &surface_extension : instance.surface_extensions) {
             surface_extension.create_window(instance);
             surface_extension.surface = surface_extension.create_surface(instance);
-            for (auto &phys_device : phys_devices) {
-                surfaces.push_back(std::unique_ptr<AppSurface>(
-                    new AppSurface(instance, phys_device, surface_extension)));
-            }
         }
 
-        std::vector<std::unique_ptr<AppGpu>> gpus;
-
-        uint32_t gpu_counter = 0;
-        for (auto &phys_device : phys_devices) {
-            gpus.push_back(std::unique_ptr<AppGpu>(new AppGpu(instance, gpu_counter++, phys_device)));
-        }
+        // Each surface on each physical device, and each GPU, is probed on its own thread. Every task fills its own slot,
+        // so the surfaces and GPUs stay in enumeration order.
+        const size_t surface_count = instance.surface_extensions.size() * phys_devices.size();
+        std::vector<std::unique_ptr<AppSurface>> surfaces(surface_count);
+        std::vector<std::unique_ptr<AppGpu>> gpus(phys_devices.size());
+        ParallelFor(surface_count + gpus.size(), [&](size_t i) {
+            if (i < surface_count) {
+                surfaces[i].reset(new AppSurface(instance, phys_devices[i % phys_devices.size()],
+                                                 instance.surface_extensions[i / phys_devices.size()]));
+            } else {
+                const uint32_t gpu_index = static_cast<uint32_t>(i - surface_count);
+                gpus[gpu_index].reset(new AppGpu(instance, gpu_index, phys_devices[gpu_index]));
+            }
+        });
 
         if (parse_data.selected_gpu >= gpus.size()) {
             if (parse_data.has_selected_gpu) {
@@ -1097,13 +1486,15 @@ int main(int argc, char **argv) {
 #endif
 
         auto printer_data = get_printer_create_details(parse_data, instance, *gpus.at(parse_data.selected_gpu));
-        if (printer_data.print_to_file) {
+        if (printer_data.print_to_file && !file_out.is_open()) {
             file_out = std::ofstream(printer_data.file_name);
             out = &file_out;
         }
-        printer = std::unique_ptr<Printer>(new Printer(printer_data, *out, parse_data.selected_gpu, instance.vk_version));
+        std::ostream &printer_out = parse_data.cache_dir.empty() ? *out : cache_out;
+        printer = std::unique_ptr<Printer>(new Printer(printer_data, printer_out, parse_data.selected_gpu, instance.vk_version));
 
         RunPrinter(*(printer.get()), parse_data, instance, gpus, surfaces);
+        save_cache = !parse_data.cache_dir.empty();
 
         for (auto &surface_extension : instance.surface_extensions) {
             AppDestroySurface(instance, surface_extension.surface);
@@ -1118,6 +1509,11 @@ int main(int argc, char **argv) {
     }
     // Call the printer's destructor before the file handle gets closed
     printer.reset(nullptr);
+    if (!parse_data.cache_dir.empty()) {
+        *out << cache_out.str();
+        out->flush();
+        if (save_cache) SaveCachedOutput(cache_path, cache_identity, cache_out.str());
+    }
 
 #ifdef _WIN32
     if (parse_data.output_category == OutputCategory::text && !parse_data.print_to_file) wait_for_console_destroy();
@@ -28,13 +28,16 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <exception>
 #include <iostream>
 #include <fstream>
 #include <memory>
 #include <ostream>
 #include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include <utility>
@@ -45,6 +48,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <cstring>
+#include <sys/stat.h>
 
 #ifdef __GNUC__
 #ifndef _POSIX_C_SOURCE
@@ -61,13 +65,24 @@
 #define NOMINMAX
 #endif
 #include <windows.h>
+#include <tlhelp32.h>
 #if _MSC_VER == 1900
 #pragma warning(disable : 4800)
 #endif
 #endif  // _WIN32
 
 #if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+#include <dirent.h>
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) || defined(__FreeBSD__)
+#include <link.h>
+#elif defined(__APPLE__)
+#include <mach-o/dyld.h>
 #endif
 
 #if defined(VK_USE_PLATFORM_XLIB_KHR) || defined(VK_USE_PLATFORM_XCB_KHR)
@@ -241,6 +256,43 @@ auto GetVector(const char *func_name, F &&f, Ts &&...ts) -> std::vector<T> {
     return GetVectorInit(func_name, f, T(), ts...);
 }
 
+// True on a thread while it runs a task of ParallelFor
+inline bool &InParallelTask() {
+    static thread_local bool in_task = false;
+    return in_task;
+}
+
+// Runs task(i) for every i in [0, count) on up to one thread per core. Tasks write their results into slots of their
+// own, so callers merge them in index order and the output does not depend on scheduling. If tasks throw, the exception
+// of the lowest index is rethrown once all threads have finished. A ParallelFor called from inside a task runs its tasks
+// on the calling thread, so nesting never starts more threads than there are cores.
+template <typename F>
+void ParallelFor(size_t count, F &&task) {
+    const size_t thread_count =
+        InParallelTask() ? 1 : std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<size_t> next_index{0};
+    auto run = [&]() {
+        const bool was_in_task = InParallelTask();
+        InParallelTask() = true;
+        for (size_t i = next_index++; i < count; i = next_index++) {
+            try {
+                task(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+        InParallelTask() = was_in_task;
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < thread_count; ++i) threads.emplace_back(run);
+    run();
+    for (auto &thread : threads) thread.join();
+    for (auto &error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
 // ----------- Instance Setup ------- //
 struct VkDll {
     VkResult Initialize() {
@@ -305,6 +357,8 @@ struct VkDll {
     PFN_vkGetPhysicalDeviceProperties2 fp_vkGetPhysicalDeviceProperties2 = APPLE_FP(vkGetPhysicalDeviceProperties2);
     PFN_vkGetPhysicalDeviceFormatProperties2 fp_vkGetPhysicalDeviceFormatProperties2 =
         APPLE_FP(vkGetPhysicalDeviceFormatProperties2);
+    PFN_vkGetPhysicalDeviceImageFormatProperties2 fp_vkGetPhysicalDeviceImageFormatProperties2 =
+        APPLE_FP(vkGetPhysicalDeviceImageFormatProperties2);
     PFN_vkGetPhysicalDeviceQueueFamilyProperties2 fp_vkGetPhysicalDeviceQueueFamilyProperties2 =
         APPLE_FP(vkGetPhysicalDeviceQueueFamilyProperties2);
     PFN_vkGetPhysicalDeviceMemoryProperties2 fp_vkGetPhysicalDeviceMemoryProperties2 =
@@ -373,6 +427,7 @@ struct VkDll {
         Load(fp_vkGetPhysicalDeviceFeatures2, "vkGetPhysicalDeviceFeatures2");
         Load(fp_vkGetPhysicalDeviceProperties2, "vkGetPhysicalDeviceProperties2");
         Load(fp_vkGetPhysicalDeviceFormatProperties2, "vkGetPhysicalDeviceFormatProperties2");
+        Load(fp_vkGetPhysicalDeviceImageFormatProperties2, "vkGetPhysicalDeviceImageFormatProperties2");
         Load(fp_vkGetPhysicalDeviceQueueFamilyProperties2, "vkGetPhysicalDeviceQueueFamilyProperties2");
         Load(fp_vkGetPhysicalDeviceMemoryProperties2, "vkGetPhysicalDeviceMemoryProperties2");
         Load(fp_vkDestroySurfaceKHR, "vkDestroySurfaceKHR");
@@ -436,6 +491,7 @@ struct ExtensionFunctions {
     PFN_vkGetPhysicalDeviceSurfaceFormats2KHR vkGetPhysicalDeviceSurfaceFormats2KHR{};
     PFN_vkGetPhysicalDeviceProperties2KHR vkGetPhysicalDeviceProperties2KHR{};
     PFN_vkGetPhysicalDeviceFormatProperties2KHR vkGetPhysicalDeviceFormatProperties2KHR{};
+    PFN_vkGetPhysicalDeviceImageFormatProperties2KHR vkGetPhysicalDeviceImageFormatProperties2KHR{};
     PFN_vkGetPhysicalDeviceQueueFamilyProperties2KHR vkGetPhysicalDeviceQueueFamilyProperties2KHR{};
     PFN_vkGetPhysicalDeviceFeatures2KHR vkGetPhysicalDeviceFeatures2KHR{};
     PFN_vkGetPhysicalDeviceMemoryProperties2KHR vkGetPhysicalDeviceMemoryProperties2KHR{};
@@ -457,6 +513,7 @@ struct ExtensionFunctions {
         Load(vkGetDeviceGroupPresentCapabilitiesKHR, "vkGetDeviceGroupPresentCapabilitiesKHR");
         Load(vkGetPhysicalDeviceProperties2KHR, "vkGetPhysicalDeviceProperties2KHR");
         Load(vkGetPhysicalDeviceFormatProperties2KHR, "vkGetPhysicalDeviceFormatProperties2KHR");
+        Load(vkGetPhysicalDeviceImageFormatProperties2KHR, "vkGetPhysicalDeviceImageFormatProperties2KHR");
         Load(vkGetPhysicalDeviceQueueFamilyProperties2KHR, "vkGetPhysicalDeviceQueueFamilyProperties2KHR");
         Load(vkGetPhysicalDeviceFeatures2KHR, "vkGetPhysicalDeviceFeatures2KHR");
         Load(vkGetPhysicalDeviceMemoryProperties2KHR, "vkGetPhysicalDeviceMemoryProperties2KHR");
@@ -534,11 +591,8 @@ struct SurfaceExtension {
     VkSurfaceKHR (*create_surface)(AppInstance &) = nullptr;
     void (*destroy_window)(AppInstance &) = nullptr;
     VkSurfaceKHR surface = VK_NULL_HANDLE;
-    VkBool32 supports_present = 0;
 
-    bool operator==(const SurfaceExtension &other) {
-        return name == other.name && surface == other.surface && supports_present == other.supports_present;
-    }
+    bool operator==(const SurfaceExtension &other) { return name == other.name && surface == other.surface; }
 };
 
 struct VulkanVersion {
@@ -1390,25 +1444,36 @@ struct FormatRange {
     VkFormat last_format;
 };
 
+struct AppFormatProperties {
+    VkFormat format;
+    // Whether the format belongs to a range the instance and the GPU support
+    bool range_supported;
+    VkFormatProperties props;
+};
+
 struct AppQueueFamilyProperties {
     VkQueueFamilyProperties props;
     uint32_t queue_index;
     bool is_present_platform_agnostic = true;
     VkBool32 platforms_support_present = VK_FALSE;
+    // Present support of each of inst.surface_extensions, in the same order
+    std::vector<VkBool32> surfaces_support_present;
 
     AppQueueFamilyProperties(AppInstance &inst, VkPhysicalDevice physical_device, VkQueueFamilyProperties family_properties,
                              uint32_t queue_index)
         : props(family_properties), queue_index(queue_index) {
         for (auto &surface_ext : inst.surface_extensions) {
+            VkBool32 supports_present = VK_FALSE;
             VkResult err = inst.ext_funcs.vkGetPhysicalDeviceSurfaceSupportKHR(physical_device, queue_index, surface_ext.surface,
-                                                                               &surface_ext.supports_present);
+                                                                               &supports_present);
             if (err) THROW_VK_ERR("vkGetPhysicalDeviceSurfaceSupportKHR", err);
 
-            const bool first = (surface_ext == inst.surface_extensions.at(0));
-            if (!first && platforms_support_present != surface_ext.supports_present) {
+            const bool first = surfaces_support_present.empty();
+            if (!first && platforms_support_present != supports_present) {
                 is_present_platform_agnostic = false;
             }
-            platforms_support_present = surface_ext.supports_present;
+            platforms_support_present = supports_present;
+            surfaces_support_present.push_back(supports_present);
         }
     }
 };
@@ -1442,6 +1507,8 @@ struct AppGpu {
     std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> heapUsage;
 
     std::vector<FormatRange> supported_format_ranges;
+    // Properties of every format of supported_format_ranges, range after range, queried once for all outputs
+    std::vector<AppFormatProperties> format_properties;
 
     std::unique_ptr<phys_device_props2_chain> chain_for_phys_device_props2;
     std::unique_ptr<phys_device_mem_props2_chain> chain_for_phys_device_mem_props2;
@@ -1504,6 +1571,37 @@ struct AppGpu {
         VkResult err = inst.dll.fp_vkCreateDevice(phys_device, &device_ci, nullptr, &dev);
         if (err) THROW_VK_ERR("vkCreateDevice", err);
 
+        supported_format_ranges = {
+            {
+                // Standard formats in Vulkan 1.0
+                VK_MAKE_VERSION(1, 0, 0), NULL,
+                static_cast<VkFormat>(0),   // first core VkFormat
+                static_cast<VkFormat>(184)  // last core VkFormat
+            },
+            {
+                // YCBCR extension, standard in Vulkan 1.1
+                VK_MAKE_VERSION(1, 1, 0),
+                VK_KHR_SAMPLER_YCBCR_CONVERSION_EXTENSION_NAME,
+                VK_FORMAT_G8B8G8R8_422_UNORM,
+                VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM,
+            },
+            {
+                // PVRTC extension, not standardized
+                0,
+                VK_IMG_FORMAT_PVRTC_EXTENSION_NAME,
+                VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG,
+                VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG,
+            },
+            {
+                // ASTC extension, not standardized
+                0,
+                VK_EXT_TEXTURE_COMPRESSION_ASTC_HDR_EXTENSION_NAME,
+                VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK_EXT,
+                VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK_EXT,
+            },
+        };
+        FillFormatProperties();
+
         const std::array<VkImageTiling, 2> tilings = {VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_TILING_LINEAR};
         const std::array<VkFormat, 8> formats = {
             color_format,      VK_FORMAT_D16_UNORM,         VK_FORMAT_X8_D24_UNORM_PACK32, VK_FORMAT_D32_SFLOAT,
@@ -1517,8 +1615,7 @@ struct AppGpu {
                 ImageTypeFormatInfo image_type_format_info;
                 image_type_format_info.format = format;
 
-                VkFormatProperties fmt_props;
-                inst.dll.fp_vkGetPhysicalDeviceFormatProperties(phys_device, format, &fmt_props);
+                const VkFormatProperties fmt_props = GetFormatProperties(format);
                 if ((tiling == VK_IMAGE_TILING_OPTIMAL && fmt_props.optimalTilingFeatures == 0) ||
                     (tiling == VK_IMAGE_TILING_LINEAR && fmt_props.linearTilingFeatures == 0)) {
                     continue;
@@ -1593,36 +1690,6 @@ struct AppGpu {
             }
         }
         // TODO buffer - memory type compatibility
-
-        supported_format_ranges = {
-            {
-                // Standard formats in Vulkan 1.0
-                VK_MAKE_VERSION(1, 0, 0), NULL,
-                static_cast<VkFormat>(0),   // first core VkFormat
-                static_cast<VkFormat>(184)  // last core VkFormat
-            },
-            {
-                // YCBCR extension, standard in Vulkan 1.1
-                VK_MAKE_VERSION(1, 1, 0),
-                VK_KHR_SAMPLER_YCBCR_CONVERSION_EXTENSION_NAME,
-                VK_FORMAT_G8B8G8R8_422_UNORM,
-                VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM,
-            },
-            {
-                // PVRTC extension, not standardized
-                0,
-                VK_IMG_FORMAT_PVRTC_EXTENSION_NAME,
-                VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG,
-                VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG,
-            },
-            {
-                // ASTC extension, not standardized
-                0,
-                VK_EXT_TEXTURE_COMPRESSION_ASTC_HDR_EXTENSION_NAME,
-                VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK_EXT,
-                VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK_EXT,
-            },
-        };
     }
     ~AppGpu() {
         inst.dll.fp_vkDestroyDevice(dev, nullptr);
@@ -1658,6 +1725,46 @@ struct AppGpu {
         return false;
     }
 
+    // Queries the properties of all formats of supported_format_ranges, in parallel chunks
+    void FillFormatProperties() {
+        for (auto &format_range : supported_format_ranges) {
+            const bool range_supported = FormatRangeSupported(format_range);
+            for (int32_t fmt = format_range.first_format; fmt <= format_range.last_format; ++fmt) {
+                format_properties.push_back({static_cast<VkFormat>(fmt), range_supported, {}});
+            }
+        }
+
+        const bool use_format_properties2 = inst.CheckExtensionEnabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+        const size_t chunk_size = 64;
+        ParallelFor((format_properties.size() + chunk_size - 1) / chunk_size, [&](size_t chunk) {
+            const size_t chunk_end = std::min(format_properties.size(), (chunk + 1) * chunk_size);
+            for (size_t i = chunk * chunk_size; i < chunk_end; ++i) {
+                AppFormatProperties &format_props = format_properties[i];
+                if (use_format_properties2) {
+                    // Only VkFormatProperties is printed, so no pNext chain is queried
+                    VkFormatProperties2 props2{};
+                    props2.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2_KHR;
+                    inst.ext_funcs.vkGetPhysicalDeviceFormatProperties2KHR(phys_device, format_props.format, &props2);
+                    format_props.props = props2.formatProperties;
+                } else {
+                    inst.dll.fp_vkGetPhysicalDeviceFormatProperties(phys_device, format_props.format, &format_props.props);
+                }
+            }
+        });
+    }
+
+    // Properties of a format from format_properties, or no features if it is outside of supported_format_ranges
+    VkFormatProperties GetFormatProperties(VkFormat format) const {
+        size_t offset = 0;
+        for (auto &format_range : supported_format_ranges) {
+            if (format >= format_range.first_format && format <= format_range.last_format) {
+                return format_properties[offset + (format - format_range.first_format)].props;
+            }
+            offset += format_range.last_format - format_range.first_format + 1;
+        }
+        return VkFormatProperties{};
+    }
+
     VkPhysicalDeviceProperties GetDeviceProperties() {
         if (inst.CheckExtensionEnabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME)) {
             return props2.properties;
@@ -1698,15 +1805,145 @@ struct hash<PropFlags> {
 // Used to sort the formats into buckets by their properties.
 std::unordered_map<PropFlags, std::vector<VkFormat>> FormatPropMap(AppGpu &gpu) {
     std::unordered_map<PropFlags, std::vector<VkFormat>> map;
-    for (auto fmtRange : gpu.supported_format_ranges) {
-        for (int32_t fmt = fmtRange.first_format; fmt <= fmtRange.last_format; ++fmt) {
-            VkFormatProperties props;
-            gpu.inst.dll.fp_vkGetPhysicalDeviceFormatProperties(gpu.phys_device, static_cast<VkFormat>(fmt), &props);
+    for (auto &format_props : gpu.format_properties) {
+        const VkFormatProperties &props = format_props.props;
+        PropFlags pf = {props.linearTilingFeatures, props.optimalTilingFeatures, props.bufferFeatures};
 
-            PropFlags pf = {props.linearTilingFeatures, props.optimalTilingFeatures, props.bufferFeatures};
+        map[pf].push_back(format_props.format);
+    }
+    return map;
+}
+
+// --------- Image Format Matrix ----------//
+
+// The image parameters the matrix crosses with every format of a supported range. Usages are every non-empty
+// combination of the core usage bits, 0x01 (TRANSFER_SRC) to 0xFF (up to INPUT_ATTACHMENT), in increasing order.
+const std::array<VkImageType, 3> matrix_image_types = {VK_IMAGE_TYPE_1D, VK_IMAGE_TYPE_2D, VK_IMAGE_TYPE_3D};
+const std::array<VkImageTiling, 2> matrix_image_tilings = {VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_TILING_LINEAR};
+const std::array<VkImageCreateFlags, 6> matrix_image_create_flags = {
+    0,
+    VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT,
+    VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
+    VK_IMAGE_CREATE_SPARSE_BINDING_BIT,
+    VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT,
+    VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_ALIASED_BIT};
+const uint32_t matrix_image_usage_count = 0xFF;
+
+// Consecutive cells of a format's row that got the same result
+struct ImageFormatMatrixRun {
+    uint32_t length;
+    // Index into ImageFormatMatrix::records, or -1 if the combination is not supported
+    int32_t record;
+};
+
+// The cells of a format, ordered by type, then tiling, then create flags, then usage
+struct ImageFormatMatrixRow {
+    VkFormat format;
+    std::vector<ImageFormatMatrixRun> runs;
+};
+
+struct ImageFormatMatrix {
+    // Every distinct VkImageFormatProperties, in order of first appearance
+    std::vector<VkImageFormatProperties> records;
+    std::vector<ImageFormatMatrixRow> rows;
+};
+
+bool SameImageFormatProperties(const VkImageFormatProperties &a, const VkImageFormatProperties &b) {
+    return a.maxExtent.width == b.maxExtent.width && a.maxExtent.height == b.maxExtent.height &&
+           a.maxExtent.depth == b.maxExtent.depth && a.maxMipLevels == b.maxMipLevels && a.maxArrayLayers == b.maxArrayLayers &&
+           a.sampleCounts == b.sampleCounts && a.maxResourceSize == b.maxResourceSize;
+}
+
+// Index of props in records, which it is appended to if no record matches
+int32_t FindOrAddImageFormatRecord(std::vector<VkImageFormatProperties> &records, const VkImageFormatProperties &props) {
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (SameImageFormatProperties(records[i], props)) return static_cast<int32_t>(i);
+    }
+    records.push_back(props);
+    return static_cast<int32_t>(records.size() - 1);
+}
 
-            map[pf].push_back(static_cast<VkFormat>(fmt));
+// Queries the image format properties of every cell of the matrix, one format per task. Each task deduplicates the
+// results of its format, and the records of all formats are merged afterwards in format order, so the output does
+// not depend on how the tasks were scheduled.
+ImageFormatMatrix BuildImageFormatMatrix(AppGpu &gpu) {
+    std::vector<AppFormatProperties> formats;
+    for (auto &format_props : gpu.format_properties) {
+        if (format_props.range_supported) formats.push_back(format_props);
+    }
+    const bool use_image_format_properties2 =
+        gpu.inst.CheckExtensionEnabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+
+    std::vector<ImageFormatMatrixRow> rows(formats.size());
+    std::vector<std::vector<VkImageFormatProperties>> row_records(formats.size());
+    ParallelFor(formats.size(), [&](size_t i) {
+        ImageFormatMatrixRow &row = rows[i];
+        row.format = formats[i].format;
+        auto add_cells = [&row](uint32_t length, int32_t record) {
+            if (!row.runs.empty() && row.runs.back().record == record) {
+                row.runs.back().length += length;
+            } else {
+                row.runs.push_back({length, record});
+            }
+        };
+
+        for (const VkImageType type : matrix_image_types) {
+            for (const VkImageTiling tiling : matrix_image_tilings) {
+                const VkFormatFeatureFlags features = tiling == VK_IMAGE_TILING_OPTIMAL ? formats[i].props.optimalTilingFeatures
+                                                                                        : formats[i].props.linearTilingFeatures;
+                for (const VkImageCreateFlags flags : matrix_image_create_flags) {
+                    // No usage can be supported without any format feature for the tiling
+                    if (features == 0) {
+                        add_cells(matrix_image_usage_count, -1);
+                        continue;
+                    }
+                    for (uint32_t usage = 1; usage <= matrix_image_usage_count; ++usage) {
+                        VkImageFormatProperties props{};
+                        VkResult res;
+                        if (use_image_format_properties2) {
+                            VkPhysicalDeviceImageFormatInfo2 format_info{};
+                            format_info.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2_KHR;
+                            format_info.format = row.format;
+                            format_info.type = type;
+                            format_info.tiling = tiling;
+                            format_info.usage = usage;
+                            format_info.flags = flags;
+                            VkImageFormatProperties2 props2{};
+                            props2.sType = VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2_KHR;
+                            res = gpu.inst.ext_funcs.vkGetPhysicalDeviceImageFormatProperties2KHR(gpu.phys_device, &format_info,
+                                                                                                  &props2);
+                            props = props2.imageFormatProperties;
+                        } else {
+                            res = gpu.inst.dll.fp_vkGetPhysicalDeviceImageFormatProperties(gpu.phys_device, row.format, type,
+                                                                                           tiling, usage, flags, &props);
+                        }
+                        if (res == VK_ERROR_FORMAT_NOT_SUPPORTED) {
+                            add_cells(1, -1);
+                            continue;
+                        }
+                        if (res) {
+                            THROW_VK_ERR(use_image_format_properties2 ? "vkGetPhysicalDeviceImageFormatProperties2KHR"
+                                                                      : "vkGetPhysicalDeviceImageFormatProperties",
+                                         res);
+                        }
+                        add_cells(1, FindOrAddImageFormatRecord(row_records[i], props));
+                    }
+                }
+            }
+        }
+    });
+
+    // Distinct records of a row stay distinct once merged, so the runs only need their indices remapped
+    ImageFormatMatrix matrix;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        std::vector<int32_t> merged_indices;
+        for (auto &record : row_records[i]) {
+            merged_indices.push_back(FindOrAddImageFormatRecord(matrix.records, record));
         }
+        for (auto &run : rows[i].runs) {
+            if (run.record >= 0) run.record = merged_indices[static_cast<size_t>(run.record)];
+        }
+        matrix.rows.push_back(std::move(rows[i]));
     }
-    return map;
-}
\ No newline at end of file
+    return matrix;
+}